@@ -14,15 +14,16 @@ namespace SPH
         for (int l = SMAX(ii - 1, 0); l <= SMIN(ii + 1, int(cell_linked_list_->NumberOfCells()[0]) - 1); ++l)
             for (int m = SMAX(jj - 1, 0); m <= SMIN(jj + 1, int(cell_linked_list_->NumberOfCells()[1]) - 1); ++m)
             {
-                ListDataVector& target_particles = cell_linked_list_->getCellLists()[l][m].cell_list_data_;
-                for (const ListData& list_data : target_particles)
+                CellList& target_cell = cell_linked_list_->getCellLists()[l][m];
+                for (size_t n = 0; n != target_cell.cell_list_indexes_.size(); ++n)
                 {
-                    if (body_region_.getSignedDistance(list_data.second) < body_region_.getRegionWidth()) // outlet region particles
+                    Vecd list_position = target_cell.cell_list_positions_[n];
+                    if (body_region_.getSignedDistance(list_position) < body_region_.getRegionWidth()) // outlet region particles
                         continue;
 
                     // displacement pointing from neighboring particle to origin particle
-                    Vecd displacement = postion - list_data.second;
-                    relation_inner_(neighborhood, displacement, index_i, list_data.first);
+                    Vecd displacement = postion - list_position;
+                    relation_inner_(neighborhood, displacement, index_i, target_cell.cell_list_indexes_[n]);
                 }
             }
 
@@ -38,6 +38,16 @@ namespace SPH
 			}
 	}
 	//=================================================================================================//
+	void LevelSetDataPackage::setSaturatedKernelIntegrals()
+	{
+		for (int i = 0; i != PackageSize(); ++i)
+			for (int j = 0; j != PackageSize(); ++j)
+			{
+				kernel_weight_[i][j] = phi_[i][j] < 0.0 ? 0 : 1.0;
+				kernel_gradient_[i][j] = Vecd(0.0);
+			}
+	}
+	//=================================================================================================//
 	void LevelSetDataPackage::computeKernelIntegrals(LevelSet &level_set)
 	{
 		for (int i = 0; i != PackageSize(); ++i)
@@ -16,6 +16,7 @@ namespace SPH
 	CellList::CellList()
 	{
 		concurrent_particle_indexes_.reserve(12);
+		pending_split_dependencies_ = 0;
 	}
 	//=================================================================================================//
 	void CellLinkedList::allocateMeshDataMatrix()
@@ -25,7 +26,60 @@ namespace SPH
 	//=================================================================================================//
 	void CellLinkedList::deleteMeshDataMatrix()
 	{
+		if (cell_linked_lists_ == nullptr)
+			return;
 		Delete2dArray(cell_linked_lists_, number_of_cells_);
+		cell_linked_lists_ = nullptr;
+	}
+	//=================================================================================================//
+	CellList &CellLinkedList::CellListFromCellIndex(const Vecu &cell_index)
+	{
+		// with the sparse storage the addressed cell is known to be occupied
+		if (use_sparse_cell_storage_)
+			return *findSparseCell(transferMeshIndexTo1D(number_of_cells_, cell_index));
+		return cell_linked_lists_[cell_index[0]][cell_index[1]];
+	}
+	//=================================================================================================//
+	size_t CellLinkedList::MemoryFootprint()
+	{
+		if (use_sparse_cell_storage_)
+		{
+			size_t footprint_in_bytes = sparse_cell_pool_.size() * sizeof(CellList) +
+										sparse_cell_keys_.capacity() * sizeof(size_t) +
+										sparse_cell_slots_.capacity() * sizeof(CellList *) +
+										occupied_cell_indexes_.capacity() * sizeof(size_t);
+			for (size_t n = 0; n != sparse_cell_pool_.size(); ++n)
+			{
+				CellList &cell_list = *sparse_cell_pool_[n];
+				footprint_in_bytes += cell_list.concurrent_particle_indexes_.capacity() * sizeof(size_t);
+				footprint_in_bytes += cell_list.cell_list_indexes_.capacity() * sizeof(size_t);
+				footprint_in_bytes += cell_list.cell_list_positions_.capacity() * sizeof(Vecd);
+				footprint_in_bytes += cell_list.real_particle_indexes_.capacity() * sizeof(size_t);
+			}
+			footprint_in_bytes += (particle_cell_keys_.capacity() + particle_linear_cell_indexes_.capacity() +
+								   cell_contiguous_indexes_.capacity() +
+								   morton_cell_ranks_.capacity() + morton_rank_to_cell_.capacity()) *
+								  sizeof(size_t);
+			return footprint_in_bytes;
+		}
+
+		size_t footprint_in_bytes =
+			number_of_cells_[0] * number_of_cells_[1] * sizeof(CellList);
+		for (size_t i = 0; i != number_of_cells_[0]; ++i)
+			for (size_t j = 0; j != number_of_cells_[1]; ++j)
+			{
+				CellList &cell_list = cell_linked_lists_[i][j];
+				footprint_in_bytes += cell_list.concurrent_particle_indexes_.capacity() * sizeof(size_t);
+				footprint_in_bytes += cell_list.cell_list_indexes_.capacity() * sizeof(size_t);
+				footprint_in_bytes += cell_list.cell_list_positions_.capacity() * sizeof(Vecd);
+				footprint_in_bytes += cell_list.real_particle_indexes_.capacity() * sizeof(size_t);
+			}
+		footprint_in_bytes += (particle_cell_residency_.capacity() + particle_cell_keys_.capacity() +
+							   particle_linear_cell_indexes_.capacity() +
+							   cell_contiguous_indexes_.capacity() + morton_cell_ranks_.capacity() +
+							   morton_rank_to_cell_.capacity()) *
+							  sizeof(size_t);
+		return footprint_in_bytes;
 	}
 	//=================================================================================================//
 	void CellLinkedList::clearCellLists()
@@ -55,11 +109,13 @@ namespace SPH
 					for (size_t j = r.cols().begin(); j != r.cols().end(); ++j)
 					{
 						CellList &cell_list = cell_linked_lists_[i][j];
-						cell_list.cell_list_data_.clear();
+						cell_list.cell_list_indexes_.clear();
+						cell_list.cell_list_positions_.clear();
 						for (size_t s = 0; s != cell_list.concurrent_particle_indexes_.size(); ++s)
 						{
 							size_t particle_index = cell_list.concurrent_particle_indexes_[s];
-							cell_list.cell_list_data_.emplace_back(std::make_pair(particle_index, pos_n[particle_index]));
+							cell_list.cell_list_indexes_.emplace_back(particle_index);
+							cell_list.cell_list_positions_.emplace_back(pos_n[particle_index]);
 						}
 					}
 			},
@@ -79,12 +135,40 @@ namespace SPH
 					for (size_t j = r.cols().begin(); j != r.cols().end(); ++j)
 					{
 						CellList &cell_list = cell_linked_lists_[i][j];
+						if (SplitCellGraphExecution::Enabled())
+						{
+							cell_list.higher_level_neighbor_cells_.clear();
+							cell_list.lower_level_neighbor_cells_.clear();
+						}
 						size_t real_particles_in_cell = cell_list.concurrent_particle_indexes_.size();
 						if (real_particles_in_cell != 0)
 						{
 							for (size_t s = 0; s != real_particles_in_cell; ++s)
 								cell_list.real_particle_indexes_.push_back(cell_list.concurrent_particle_indexes_[s]);
-							split_cell_lists[transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3))].push_back(&cell_linked_lists_[i][j]);
+							size_t split_level = transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3));
+							split_cell_lists[split_level].push_back(&cell_linked_lists_[i][j]);
+							//record the neighbor-level links for the dependency-graph splitting sweep.
+							//adjacent cells always belong to different levels under the mod-3 coloring.
+							if (SplitCellGraphExecution::Enabled())
+								for (int l = -1; l <= 1; ++l)
+									for (int m = -1; m <= 1; ++m)
+									{
+										int u = (int)i + l;
+										int v = (int)j + m;
+										if ((l == 0 && m == 0) ||
+											u < 0 || u >= (int)number_of_cells_[0] ||
+											v < 0 || v >= (int)number_of_cells_[1])
+											continue;
+										CellList &neighbor_cell_list = cell_linked_lists_[u][v];
+										if (neighbor_cell_list.concurrent_particle_indexes_.size() == 0)
+											continue;
+										size_t neighbor_level =
+											transferMeshIndexTo1D(Vecu(3), Vecu(u % 3, v % 3));
+										if (neighbor_level > split_level)
+											cell_list.higher_level_neighbor_cells_.push_back(&neighbor_cell_list);
+										if (neighbor_level < split_level)
+											cell_list.lower_level_neighbor_cells_.push_back(&neighbor_cell_list);
+									}
 						}
 					}
 			},
@@ -99,8 +183,12 @@ namespace SPH
 	//=================================================================================================//
 	void CellLinkedList ::InsertACellLinkedListDataEntry(size_t particle_index, const Vecd &particle_position)
 	{
+		if (use_sparse_cell_storage_)
+			sparseCellStorageUnsupported("InsertACellLinkedListDataEntry");
 		Vecu cellpos = CellIndexFromPosition(particle_position);
-		cell_linked_lists_[cellpos[0]][cellpos[1]].cell_list_data_.emplace_back(std::make_pair(particle_index, particle_position));
+		CellList &cell_list = cell_linked_lists_[cellpos[0]][cellpos[1]];
+		cell_list.cell_list_indexes_.emplace_back(particle_index);
+		cell_list.cell_list_positions_.emplace_back(particle_position);
 	}
 	//=================================================================================================//
 	ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
@@ -116,14 +204,21 @@ namespace SPH
 		{
 			for (int m = SMAX(j - 1, 0); m <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++m)
 			{
-				ListDataVector &target_particles = cell_linked_lists_[l][m].cell_list_data_;
-				for (const ListData &list_data : target_particles)
+				CellList *target_cell_ptr =
+					use_sparse_cell_storage_
+						? findSparseCell(transferMeshIndexTo1D(number_of_cells_, Vecu(l, m)))
+						: &cell_linked_lists_[l][m];
+				if (target_cell_ptr == nullptr)
+					continue;
+				CellList &target_cell = *target_cell_ptr;
+				for (size_t n = 0; n != target_cell.cell_list_indexes_.size(); ++n)
 				{
-					Real distance = (position - list_data.second).norm();
+					Real distance = (position - target_cell.cell_list_positions_[n]).norm();
 					if (distance < min_distance)
 					{
 						min_distance = distance;
-						nearest_entry = list_data;
+						nearest_entry = std::make_pair(target_cell.cell_list_indexes_[n],
+													   target_cell.cell_list_positions_[n]);
 					}
 				}
 			}
@@ -134,6 +229,8 @@ namespace SPH
 	void CellLinkedList::
 		tagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 	{
+		if (use_sparse_cell_storage_)
+			sparseCellStorageUnsupported("tagBodyPartByCell");
 		for (int i = 0; i < (int)number_of_cells_[0]; ++i)
 			for (int j = 0; j < (int)number_of_cells_[1]; ++j)
 			{
@@ -151,9 +248,38 @@ namespace SPH
 			}
 	}
 	//=================================================================================================//
+	void CellLinkedList::
+		retagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included,
+							const BoundingBox &retagging_bounds)
+	{
+		if (use_sparse_cell_storage_)
+			sparseCellStorageUnsupported("retagBodyPartByCell");
+		// only the cells within the given bounds, inflated by the neighbor test range,
+		// can have changed their containment status
+		Vecu lower_cell = CellIndexFromPosition(retagging_bounds.first);
+		Vecu upper_cell = CellIndexFromPosition(retagging_bounds.second);
+		for (int i = SMAX(int(lower_cell[0]) - 2, 0); i <= SMIN(int(upper_cell[0]) + 2, int(number_of_cells_[0]) - 1); ++i)
+			for (int j = SMAX(int(lower_cell[1]) - 2, 0); j <= SMIN(int(upper_cell[1]) + 2, int(number_of_cells_[1]) - 1); ++j)
+			{
+				bool is_included = false;
+				for (int k = SMAX(i - 1, 0); k <= SMIN(i + 1, int(number_of_cells_[0]) - 1); ++k)
+					for (int l = SMAX(j - 1, 0); l <= SMIN(j + 1, int(number_of_cells_[1]) - 1); ++l)
+					{
+						if (check_included(CellPositionFromIndex(Vecu(k, l)), grid_spacing_))
+						{
+							is_included = true;
+						}
+					}
+				if (is_included == true)
+					cell_lists.push_back(&cell_linked_lists_[i][j]);
+			}
+	}
+	//=================================================================================================//
 	void CellLinkedList::
 		tagBodyDomainBoundingCells(StdVec<CellLists> &cell_lists, BoundingBox &body_domain_bounds, int axis)
 	{
+		if (use_sparse_cell_storage_)
+			sparseCellStorageUnsupported("tagBodyDomainBoundingCells");
 		int second_axis = SecondAxis(axis);
 		Vecu body_lower_bound_cell_ = CellIndexFromPosition(body_domain_bounds.first);
 		Vecu body_upper_bound_cell_ = CellIndexFromPosition(body_domain_bounds.second);
@@ -186,6 +312,8 @@ namespace SPH
 	void CellLinkedList::
 		tagMirrorBoundingCells(CellLists &cell_lists, BoundingBox &body_domain_bounds, int axis, bool positive)
 	{
+		if (use_sparse_cell_storage_)
+			sparseCellStorageUnsupported("tagMirrorBoundingCells");
 		int second_axis = SecondAxis(axis);
 		Vecu body_lower_bound_cell_ = CellIndexFromPosition(body_domain_bounds.first);
 		Vecu body_upper_bound_cell_ = CellIndexFromPosition(body_domain_bounds.second);
@@ -126,18 +126,29 @@ namespace SPH
 
 		DataPackageType *data_pkg = data_pkg_addrs_[i][j];
 		if (data_pkg->is_inner_pkg_)
-		{
-			for (int l = 0; l != pkg_addrs_size_; ++l)
-				for (int m = 0; m != pkg_addrs_size_; ++m)
-				{
-					std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
-					std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
-					data_pkg->assignAllPackageDataAddress(
-						Vecu(l, m),
-						data_pkg_addrs_[i + x_pair.first][j + y_pair.first],
-						Vecu(x_pair.second, y_pair.second));
-				}
-		}
+			initializePackageAddresses(data_pkg, cell_index);
+	}
+	//=================================================================================================//
+	template <class MeshFieldType, class DataPackageType>
+	void MeshWithDataPackages<MeshFieldType, DataPackageType>::
+		initializePackageAddresses(DataPackageType *data_pkg, const Vecu &cell_index)
+	{
+		int i = (int)cell_index[0];
+		int j = (int)cell_index[1];
+
+		for (int l = 0; l != pkg_addrs_size_; ++l)
+			for (int m = 0; m != pkg_addrs_size_; ++m)
+			{
+				std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
+				std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
+				// the package itself may not be registered in the address matrix yet
+				DataPackageType *src_pkg = x_pair.first == 0 && y_pair.first == 0
+											   ? data_pkg
+											   : data_pkg_addrs_[i + x_pair.first][j + y_pair.first];
+				data_pkg->assignAllPackageDataAddress(
+					Vecu(l, m), src_pkg,
+					Vecu(x_pair.second, y_pair.second));
+			}
 	}
 	//=================================================================================================//
 	template <class MeshFieldType, class DataPackageType>
@@ -180,6 +191,59 @@ namespace SPH
 									   : *pkg_data_addrs[0][0];
 	}
 	//=================================================================================================//
+	template <class MeshFieldType, class DataPackageType>
+	template <class DataType, typename PackageDataAddressType, PackageDataAddressType DataPackageType::*MemPtr>
+	void MeshWithDataPackages<MeshFieldType, DataPackageType>::
+		probeMeshBatch(const StdLargeVec<Vecd> &positions, StdLargeVec<DataType> &probed_values)
+	{
+		size_t total_queries = positions.size();
+		probed_values.resize(total_queries);
+
+		// order the queries by the linearized cell index of their data package
+		StdLargeVec<size_t> &package_keys = probe_package_keys_;
+		StdLargeVec<size_t> &query_order = probe_query_order_;
+		package_keys.resize(total_queries);
+		query_order.resize(total_queries);
+		parallel_for(
+			blocked_range<size_t>(0, total_queries),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+				{
+					Vecu grid_index = CellIndexFromPosition(positions[q]);
+					package_keys[q] = grid_index[0] * number_of_cells_[1] + grid_index[1];
+					query_order[q] = q;
+				}
+			},
+			ap);
+		parallel_sort(query_order.begin(), query_order.end(),
+					  [&](size_t a, size_t b)
+					  { return package_keys[a] < package_keys[b]; });
+
+		parallel_for(
+			blocked_range<size_t>(0, total_queries),
+			[&](const blocked_range<size_t> &r)
+			{
+				size_t resolved_key = MaxSize_t;
+				DataPackageType *data_pkg = nullptr;
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t q = query_order[n];
+					if (package_keys[q] != resolved_key)
+					{
+						resolved_key = package_keys[q];
+						Vecu grid_index = CellIndexFromPosition(positions[q]);
+						data_pkg = data_pkg_addrs_[grid_index[0]][grid_index[1]];
+					}
+					PackageDataAddressType &pkg_data_addrs = data_pkg->*MemPtr;
+					probed_values[q] = data_pkg->is_inner_pkg_
+										   ? data_pkg->DataPackageType::template probeDataPackage<DataType>(pkg_data_addrs, positions[q])
+										   : *pkg_data_addrs[0][0];
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
 }
 //=================================================================================================//
 #endif //MESH_WITH_DATA_PACKAGES_2D_HPP
\ No newline at end of file
@@ -40,23 +40,24 @@ namespace SPH
 		//=========================================================================================//
 		void ConstrainSolidBodyPartBySimBody::Update(size_t index_i, Real dt)
 		{
+			/** the station kinematics are expanded from the spatial kinematics of the
+			 * mobilized body cached in setupDynamics, so that the parallel pass does
+			 * not query the SimTK state per particle.
+			 */
 			Vecd& pos_0_i = pos_0_[index_i];
-			Vec3 rr, pos, vel, acc;
+			Vec3 rr;
 			rr(0) = pos_0_i[0] - initial_mobod_origin_location_[0];
 			rr(1) = pos_0_i[1] - initial_mobod_origin_location_[1];
 			rr(2) = 0.0;
-			mobod_.findStationLocationVelocityAndAccelerationInGround(*simbody_state_, rr, pos, vel, acc);
-			/** this is how we calculate the particle position in after transform of MBbody.
-			 * const SimTK::Rotation&  R_GB = mobod_.getBodyRotation(simbody_state);
-			 * const SimTK::Vec3&      p_GB = mobod_.getBodyOriginLocation(simbody_state);
-			 * const SimTK::Vec3 r = R_GB * rr; // re-express station vector p_BS in G (15 flops)
-			 * base_particle_data_i.pos_n_ = (p_GB + r).getSubVec<2>(0);
-			 */
+			Vec3 r = mobod_rotation_ * rr;
+			Vec3 pos = mobod_origin_location_ + r;
+			Vec3 vel = mobod_origin_velocity_ + cross(mobod_angular_velocity_, r);
+			Vec3 acc = mobod_origin_acceleration_ + cross(mobod_angular_acceleration_, r) +
+					   cross(mobod_angular_velocity_, cross(mobod_angular_velocity_, r));
 			pos_n_[index_i] = pos.getSubVec<2>(0);
 			vel_n_[index_i] = vel.getSubVec<2>(0);
 			dvel_dt_[index_i] = acc.getSubVec<2>(0);
-			n_[index_i] = (mobod_.getBodyRotation(*simbody_state_) 
-						* upgradeToVector3D(n_0_[index_i])).getSubVec<2>(0);
+			n_[index_i] = (mobod_rotation_ * upgradeToVector3D(n_0_[index_i])).getSubVec<2>(0);
 		}
 		//=========================================================================================//
 		SimTK::SpatialVec TotalForceOnSolidBodyPartForSimBody::ReduceFunction(size_t index_i, Real dt)
@@ -16,15 +16,16 @@ namespace SPH
             for (int m = SMAX(jj - 1, 0); m <= SMIN(jj + 1, int(cell_linked_list_->NumberOfCells()[1]) - 1); ++m)
                 for (int n = SMAX(kk - 1, 0); n <= SMIN(jj + 1, int(cell_linked_list_->NumberOfCells()[2] - 1)); ++n)
                 {
-                    ListDataVector& target_particles = cell_linked_list_->getCellLists()[l][m][n].cell_list_data_;
-                    for (const ListData& list_data : target_particles)
+                    CellList& target_cell = cell_linked_list_->getCellLists()[l][m][n];
+                    for (size_t num = 0; num != target_cell.cell_list_indexes_.size(); ++num)
                     {
-                        if (body_region_.getSignedDistance(list_data.second) < body_region_.getRegionWidth()) // outlet region particles
+                        Vecd list_position = target_cell.cell_list_positions_[num];
+                        if (body_region_.getSignedDistance(list_position) < body_region_.getRegionWidth()) // outlet region particles
                             continue;
 
                         // displacement pointing from neighboring particle to origin particle
-                        Vecd displacement = postion - list_data.second;
-                        relation_inner_(neighborhood, displacement, index_i, list_data.first);
+                        Vecd displacement = postion - list_position;
+                        relation_inner_(neighborhood, displacement, index_i, target_cell.cell_list_indexes_[num]);
                     }
                 }
 
@@ -39,6 +39,17 @@ namespace SPH
 				}
 	}
 	//=================================================================================================//
+	void LevelSetDataPackage::setSaturatedKernelIntegrals()
+	{
+		for (int i = 0; i != PackageSize(); ++i)
+			for (int j = 0; j != PackageSize(); ++j)
+				for (int k = 0; k != PackageSize(); ++k)
+				{
+					kernel_weight_[i][j][k] = phi_[i][j][k] < 0.0 ? 0 : 1.0;
+					kernel_gradient_[i][j][k] = Vecd(0.0);
+				}
+	}
+	//=================================================================================================//
 	void LevelSetDataPackage::computeKernelIntegrals(LevelSet &level_set)
 	{
 		for (int i = 0; i != PackageSize(); ++i)
@@ -2,6 +2,203 @@
 
 namespace SPH
 {
+	//=================================================================================================//
+	TriangleMeshAABBTree::TriangleMeshAABBTree(SimTK::ContactGeometry::TriangleMesh &triangle_mesh)
+	{
+		int number_of_faces = triangle_mesh.getNumFaces();
+		vertices_a_.resize(number_of_faces);
+		vertices_b_.resize(number_of_faces);
+		vertices_c_.resize(number_of_faces);
+		face_indexes_.resize(number_of_faces);
+		StdLargeVec<Vec3d> face_centroids(number_of_faces);
+		for (int i = 0; i != number_of_faces; ++i)
+		{
+			vertices_a_[i] = triangle_mesh.getVertexPosition(triangle_mesh.getFaceVertex(i, 0));
+			vertices_b_[i] = triangle_mesh.getVertexPosition(triangle_mesh.getFaceVertex(i, 1));
+			vertices_c_[i] = triangle_mesh.getVertexPosition(triangle_mesh.getFaceVertex(i, 2));
+			face_centroids[i] = (vertices_a_[i] + vertices_b_[i] + vertices_c_[i]) / 3.0;
+			face_indexes_[i] = i;
+		}
+
+		if (number_of_faces != 0)
+		{
+			nodes_.reserve(2 * number_of_faces / leaf_size_ + 1);
+			buildNode(0, number_of_faces, face_centroids);
+		}
+	}
+	//=================================================================================================//
+	int TriangleMeshAABBTree::buildNode(int first_face, int face_count, const StdLargeVec<Vec3d> &face_centroids)
+	{
+		int node_index = (int)nodes_.size();
+		nodes_.push_back(TreeNode());
+
+		Vec3d lower_bound(Infinity);
+		Vec3d upper_bound(-Infinity);
+		Vec3d centroid_lower_bound(Infinity);
+		Vec3d centroid_upper_bound(-Infinity);
+		for (int n = first_face; n != first_face + face_count; ++n)
+		{
+			int face = face_indexes_[n];
+			for (int j = 0; j != 3; ++j)
+			{
+				lower_bound[j] = SMIN(lower_bound[j], vertices_a_[face][j], vertices_b_[face][j], vertices_c_[face][j]);
+				upper_bound[j] = SMAX(upper_bound[j], vertices_a_[face][j], vertices_b_[face][j], vertices_c_[face][j]);
+				centroid_lower_bound[j] = SMIN(centroid_lower_bound[j], face_centroids[face][j]);
+				centroid_upper_bound[j] = SMAX(centroid_upper_bound[j], face_centroids[face][j]);
+			}
+		}
+
+		TreeNode node;
+		node.lower_bound_ = lower_bound;
+		node.upper_bound_ = upper_bound;
+		node.left_child_ = -1;
+		node.right_child_ = -1;
+		node.first_face_ = first_face;
+		node.face_count_ = face_count;
+		if (face_count > leaf_size_)
+		{
+			// median split along the longest extent of the face centroids
+			Vec3d centroid_extent = centroid_upper_bound - centroid_lower_bound;
+			int axis = 0;
+			if (centroid_extent[1] > centroid_extent[axis])
+				axis = 1;
+			if (centroid_extent[2] > centroid_extent[axis])
+				axis = 2;
+			int middle = face_count / 2;
+			std::nth_element(face_indexes_.begin() + first_face,
+							 face_indexes_.begin() + first_face + middle,
+							 face_indexes_.begin() + first_face + face_count,
+							 [&](int face_a, int face_b)
+							 { return face_centroids[face_a][axis] < face_centroids[face_b][axis]; });
+			node.left_child_ = buildNode(first_face, middle, face_centroids);
+			node.right_child_ = buildNode(first_face + middle, face_count - middle, face_centroids);
+		}
+		// assigned by index, as the node vector may have grown during the recursion
+		nodes_[node_index] = node;
+		return node_index;
+	}
+	//=================================================================================================//
+	Real TriangleMeshAABBTree::SquaredDistanceToNode(const Vec3d &probe_point, const TreeNode &node) const
+	{
+		Real distance_sqr = 0.0;
+		for (int j = 0; j != 3; ++j)
+		{
+			Real excess = SMAX(node.lower_bound_[j] - probe_point[j], probe_point[j] - node.upper_bound_[j], 0.0);
+			distance_sqr += excess * excess;
+		}
+		return distance_sqr;
+	}
+	//=================================================================================================//
+	Vec3d TriangleMeshAABBTree::
+		ClosestPointOnFace(const Vec3d &probe_point, const Vec3d &a, const Vec3d &b, const Vec3d &c)
+	{
+		// closest point by clamped barycentric coordinates, region by region
+		Vec3d ab = b - a;
+		Vec3d ac = c - a;
+		Vec3d ap = probe_point - a;
+		Real d1 = dot(ab, ap);
+		Real d2 = dot(ac, ap);
+		if (d1 <= 0.0 && d2 <= 0.0)
+			return a;
+
+		Vec3d bp = probe_point - b;
+		Real d3 = dot(ab, bp);
+		Real d4 = dot(ac, bp);
+		if (d3 >= 0.0 && d4 <= d3)
+			return b;
+
+		Real vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+			return a + ab * (d1 / (d1 - d3));
+
+		Vec3d cp = probe_point - c;
+		Real d5 = dot(ab, cp);
+		Real d6 = dot(ac, cp);
+		if (d6 >= 0.0 && d5 <= d6)
+			return c;
+
+		Real vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+			return a + ac * (d2 / (d2 - d6));
+
+		Real va = d3 * d6 - d5 * d4;
+		if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0)
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		Real denominator = 1.0 / (va + vb + vc);
+		return a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+	//=================================================================================================//
+	Vec3d TriangleMeshAABBTree::findClosestPoint(const Vec3d &probe_point, int &face_id) const
+	{
+		face_id = 0;
+		Vec3d closest_point = probe_point;
+		if (nodes_.empty())
+			return closest_point;
+
+		Real closest_distance_sqr = Infinity;
+		int node_stack[128];
+		int stack_size = 0;
+		node_stack[stack_size++] = 0;
+		while (stack_size != 0)
+		{
+			const TreeNode &node = nodes_[node_stack[--stack_size]];
+			if (SquaredDistanceToNode(probe_point, node) >= closest_distance_sqr)
+				continue;
+
+			if (node.left_child_ < 0)
+			{
+				for (int n = node.first_face_; n != node.first_face_ + node.face_count_; ++n)
+				{
+					int face = face_indexes_[n];
+					Vec3d candidate =
+						ClosestPointOnFace(probe_point, vertices_a_[face], vertices_b_[face], vertices_c_[face]);
+					Vec3d displacement = probe_point - candidate;
+					Real distance_sqr = dot(displacement, displacement);
+					if (distance_sqr < closest_distance_sqr)
+					{
+						closest_distance_sqr = distance_sqr;
+						closest_point = candidate;
+						face_id = face;
+					}
+				}
+			}
+			else
+			{
+				// descend into the nearer child first for earlier pruning
+				Real left_distance_sqr = SquaredDistanceToNode(probe_point, nodes_[node.left_child_]);
+				Real right_distance_sqr = SquaredDistanceToNode(probe_point, nodes_[node.right_child_]);
+				if (left_distance_sqr < right_distance_sqr)
+				{
+					node_stack[stack_size++] = node.right_child_;
+					node_stack[stack_size++] = node.left_child_;
+				}
+				else
+				{
+					node_stack[stack_size++] = node.left_child_;
+					node_stack[stack_size++] = node.right_child_;
+				}
+			}
+		}
+		return closest_point;
+	}
+	//=================================================================================================//
+	void TriangleMeshAABBTree::
+		findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points) const
+	{
+		closest_points.resize(probe_points.size());
+		parallel_for(
+			blocked_range<size_t>(0, probe_points.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					int face_id;
+					closest_points[i] = findClosestPoint(probe_points[i], face_id);
+				}
+			},
+			ap);
+	}
 	//=================================================================================================//
 	SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::
 		generateTriangleMesh(const SimTK::PolygonalMesh &poly_mesh)
@@ -15,6 +212,7 @@ namespace SPH
 			throw;
 		}
 		std::cout << "num of faces:" << triangle_mesh->getNumFaces() << std::endl;
+		aabb_tree_ = aabb_tree_ptr_keeper_.createPtr<TriangleMeshAABBTree>(*triangle_mesh);
 
 		return triangle_mesh;
 	}
@@ -22,12 +220,10 @@ namespace SPH
 	bool TriangleMeshShape::checkContain(const Vec3d &pnt, bool BOUNDARY_INCLUDED)
 	{
 
-		SimTK::Vec2 uv_coordinate;
-		bool inside = false;
 		int face_id;
-		Vec3d closest_pnt = triangle_mesh_->findNearestPoint(pnt, inside, face_id, uv_coordinate);
+		Vec3d closest_pnt = aabb_tree_->findClosestPoint(pnt, face_id);
 
-		StdVec<int> neighbor_face(4);
+		int neighbor_face[4];
 		neighbor_face[0] = face_id;
 		/** go throught the neighbor faces. */
 		for (int i = 1; i < 4; i++)
@@ -67,11 +263,8 @@ namespace SPH
 	//=================================================================================================//
 	Vec3d TriangleMeshShape::findClosestPoint(const Vec3d &input_pnt)
 	{
-		bool inside = false;
 		int face_id;
-		SimTK::Vec2 normal;
-		Vec3d closest_pnt;
-		closest_pnt = triangle_mesh_->findNearestPoint(input_pnt, inside, face_id, normal);
+		Vec3d closest_pnt = aabb_tree_->findClosestPoint(input_pnt, face_id);
 		if (face_id < 0 && face_id > triangle_mesh_->getNumFaces())
 		{
 			std::cout << "\n Error the nearest point is not valid" << std::endl;
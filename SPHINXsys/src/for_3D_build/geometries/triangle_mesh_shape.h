@@ -51,14 +51,52 @@ namespace fs = std::experimental::filesystem;
 
 namespace SPH
 {
+	/**
+	 * @class TriangleMeshAABBTree
+	 * @brief Axis-aligned bounding box tree over the faces of a triangle mesh.
+	 * The tree is built once per shape and answers closest-point queries in
+	 * logarithmic time, replacing the contact-geometry queries which scale
+	 * poorly for large surface meshes.
+	 */
+	class TriangleMeshAABBTree
+	{
+	public:
+		explicit TriangleMeshAABBTree(SimTK::ContactGeometry::TriangleMesh &triangle_mesh);
+		~TriangleMeshAABBTree(){};
+
+		/** the closest point on the mesh surface together with the face it lies on */
+		Vec3d findClosestPoint(const Vec3d &probe_point, int &face_id) const;
+		/** batched closest-point queries answered in parallel */
+		void findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points) const;
+
+	protected:
+		/** node of the implicit tree. The children are indexes into the node
+		 * vector, -1 marks a leaf holding a range of reordered face indexes. */
+		struct TreeNode
+		{
+			Vec3d lower_bound_, upper_bound_;
+			int left_child_, right_child_;
+			int first_face_, face_count_;
+		};
+		static const int leaf_size_ = 4; /**< maximum number of faces in a leaf. */
+		StdLargeVec<TreeNode> nodes_;
+		StdLargeVec<int> face_indexes_;							  /**< face indexes reordered during the construction. */
+		StdLargeVec<Vec3d> vertices_a_, vertices_b_, vertices_c_; /**< face corners by the original face index. */
+
+		int buildNode(int first_face, int face_count, const StdLargeVec<Vec3d> &face_centroids);
+		Real SquaredDistanceToNode(const Vec3d &probe_point, const TreeNode &node) const;
+		static Vec3d ClosestPointOnFace(const Vec3d &probe_point, const Vec3d &a, const Vec3d &b, const Vec3d &c);
+	};
+
 	class TriangleMeshShape : public Shape
 	{
 	private:
 		UniquePtrKeeper<SimTK::ContactGeometry::TriangleMesh> triangle_mesh_ptr_keeper_;
+		UniquePtrKeeper<TriangleMeshAABBTree> aabb_tree_ptr_keeper_;
 
 	public:
 		explicit TriangleMeshShape(const std::string &shape_name, const SimTK::PolygonalMesh* mesh = nullptr)
-			: Shape(shape_name), triangle_mesh_(nullptr){
+			: Shape(shape_name), triangle_mesh_(nullptr), aabb_tree_(nullptr){
                 if(mesh)
                     triangle_mesh_ = generateTriangleMesh(*mesh);
 
@@ -67,11 +105,18 @@ namespace SPH
 		virtual bool checkContain(const Vec3d &pnt, bool BOUNDARY_INCLUDED = true) override;
 		virtual Vec3d findClosestPoint(const Vec3d &input_pnt) override;
 		virtual BoundingBox findBounds() override;
+		/** batched closest-point queries on the mesh surface */
+		void findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points)
+		{
+			aabb_tree_->findClosestPoints(probe_points, closest_points);
+		};
 
 		SimTK::ContactGeometry::TriangleMesh *getTriangleMesh() { return triangle_mesh_; };
+		TriangleMeshAABBTree *getAABBTree() { return aabb_tree_; };
 
 	protected:
 		SimTK::ContactGeometry::TriangleMesh *triangle_mesh_;
+		TriangleMeshAABBTree *aabb_tree_; /**< built once with the mesh to accelerate the closest-point queries. */
 
 		//generate triangle mesh from polymesh
 		SimTK::ContactGeometry::TriangleMesh *generateTriangleMesh(const SimTK::PolygonalMesh &poly_mesh);
@@ -13,6 +13,70 @@
 
 namespace SPH
 {
+	//=================================================================================================//
+	template<typename GetNeighborRelation>
+	void CellLinkedList::scanCellForNeighbors(CellList& target_cell, size_t index_i, const Vecd& particle_position,
+			Neighborhood& neighborhood, GetNeighborRelation& get_neighbor_relation)
+	{
+		IndexVector& target_indexes = target_cell.cell_list_indexes_;
+		StdVec<Vecd>& target_positions = target_cell.cell_list_positions_;
+		for (size_t n = 0; n != target_indexes.size(); ++n)
+		{
+			//displacement pointing from neighboring particle to origin particle
+			Vecd displacement = particle_position - target_positions[n];
+			get_neighbor_relation(neighborhood, displacement, index_i, target_indexes[n]);
+		}
+	}
+	//=================================================================================================//
+	template<typename GetNeighborRelation>
+	void CellLinkedList::searchNeighborsForOneParticle(size_t index_i, const Vecd& particle_position,
+			int search_depth, Neighborhood& neighborhood, GetNeighborRelation& get_neighbor_relation)
+	{
+		Vecu target_cell_index = CellIndexFromPosition(particle_position);
+		int i = (int)target_cell_index[0];
+		int j = (int)target_cell_index[1];
+		int k = (int)target_cell_index[2];
+
+		//with the sparse storage only the occupied cells of the stencil are scanned
+		if (use_sparse_cell_storage_)
+		{
+			for (int l = SMAX(i - search_depth, 0); l <= SMIN(i + search_depth, int(number_of_cells_[0]) - 1); ++l)
+				for (int m = SMAX(j - search_depth, 0); m <= SMIN(j + search_depth, int(number_of_cells_[1]) - 1); ++m)
+					for (int q = SMAX(k - search_depth, 0); q <= SMIN(k + search_depth, int(number_of_cells_[2]) - 1); ++q)
+					{
+						CellList *target_cell = findSparseCell(transferMeshIndexTo1D(number_of_cells_, Vecu(l, m, q)));
+						if (target_cell != nullptr)
+							scanCellForNeighbors(*target_cell,
+												 index_i, particle_position, neighborhood, get_neighbor_relation);
+					}
+			return;
+		}
+
+		//for the common single-cell search depth the bounds checks are hoisted
+		//into one interior test, and the 3x3x3 stencil walk over the constant
+		//offsets is fully unrolled by the compiler
+		if (search_depth == 1 &&
+			i > 0 && i < int(number_of_cells_[0]) - 1 &&
+			j > 0 && j < int(number_of_cells_[1]) - 1 &&
+			k > 0 && k < int(number_of_cells_[2]) - 1)
+		{
+			for (int dl = -1; dl <= 1; ++dl)
+				for (int dm = -1; dm <= 1; ++dm)
+					for (int dq = -1; dq <= 1; ++dq)
+						scanCellForNeighbors(cell_linked_lists_[i + dl][j + dm][k + dq],
+											 index_i, particle_position, neighborhood, get_neighbor_relation);
+			return;
+		}
+
+		//the clamped loop for the boundary cells and deeper searches
+		for (int l = SMAX(i - search_depth, 0); l <= SMIN(i + search_depth, int(number_of_cells_[0]) - 1); ++l)
+			for (int m = SMAX(j - search_depth, 0); m <= SMIN(j + search_depth, int(number_of_cells_[1]) - 1); ++m)
+				for (int q = SMAX(k - search_depth, 0); q <= SMIN(k + search_depth, int(number_of_cells_[2]) - 1); ++q)
+				{
+					scanCellForNeighbors(cell_linked_lists_[l][m][q],
+										 index_i, particle_position, neighborhood, get_neighbor_relation);
+				}
+	}
 	//=================================================================================================//
 	template<typename GetParticleIndex, typename GetSearchDepth, typename GetNeighborRelation>
 	void CellLinkedList::searchNeighborsByParticles(size_t total_real_particles, BaseParticles& source_particles,
@@ -26,24 +90,39 @@ namespace SPH
 					size_t index_i = get_particle_index(num);
 					Vecd& particle_position = pos_n[index_i];
 					int search_depth = get_search_depth(index_i);
-					Vecu target_cell_index = CellIndexFromPosition(particle_position);
-					int i = (int)target_cell_index[0];
-					int j = (int)target_cell_index[1];
-					int k = (int)target_cell_index[2];
-
-					Neighborhood& neighborhood = particle_configuration[index_i];
-					for (int l = SMAX(i - search_depth, 0); l <= SMIN(i + search_depth, int(number_of_cells_[0]) - 1); ++l)
-						for (int m = SMAX(j - search_depth, 0); m <= SMIN(j + search_depth, int(number_of_cells_[1]) - 1); ++m)
-							for (int q = SMAX(k - search_depth, 0); q <= SMIN(k + search_depth, int(number_of_cells_[2]) - 1); ++q)
-							{
-								ListDataVector& target_particles = cell_linked_lists_[l][m][q].cell_list_data_;
-								for (const ListData& list_data : target_particles)
-								{
-									//displacement pointing from neighboring particle to origin particle
-									Vecd displacement = particle_position - list_data.second;
-									get_neighbor_relation(neighborhood, displacement, index_i, list_data.first);
-								}
-							}
+					searchNeighborsForOneParticle(index_i, particle_position, search_depth,
+						particle_configuration[index_i], get_neighbor_relation);
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	template<typename GetParticleIndex, typename GetSearchDepth, typename GetNeighborRelation>
+	void CellLinkedList::searchNeighborsByParticles(size_t total_real_particles, BaseParticles& source_particles,
+			ParticleConfiguration& particle_configuration, GetParticleIndex& get_particle_index,
+			GetSearchDepth& get_search_depth, GetNeighborRelation& get_neighbor_relation,
+			const BoundingBox& search_bounds)
+	{
+		parallel_for(blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t>& r) {
+				StdLargeVec<Vecd>& pos_n = source_particles.pos_n_;
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					size_t index_i = get_particle_index(num);
+					Vecd& particle_position = pos_n[index_i];
+					int search_depth = get_search_depth(index_i);
+
+					//the kernel support is covered by search_depth cells, so particles
+					//farther from the bounds can not find any neighbor within them
+					Real support_radius = Real(search_depth) * grid_spacing_;
+					if (particle_position[0] < search_bounds.first[0] - support_radius ||
+						particle_position[0] > search_bounds.second[0] + support_radius ||
+						particle_position[1] < search_bounds.first[1] - support_radius ||
+						particle_position[1] > search_bounds.second[1] + support_radius ||
+						particle_position[2] < search_bounds.first[2] - support_radius ||
+						particle_position[2] > search_bounds.second[2] + support_radius)
+						continue;
+
+					searchNeighborsForOneParticle(index_i, particle_position, search_depth,
+						particle_configuration[index_i], get_neighbor_relation);
 				}
 			}, ap);
 	}
@@ -39,19 +39,16 @@ namespace SPH
 		//=================================================================================================//
 		void ConstrainSolidBodyPartBySimBody::Update(size_t index_i, Real dt)
 		{
-			Vec3 rr, pos, vel, acc;
-			rr = pos_0_[index_i] - initial_mobod_origin_location_;
-			mobod_.findStationLocationVelocityAndAccelerationInGround(*simbody_state_, rr, pos, vel, acc);
-			/** this is how we calculate the particle position in after transform of MBbody.
-			 * const SimTK::Rotation&  R_GB = mobod_.getBodyRotation(simbody_state);
-			 * const SimTK::Vec3&      p_GB = mobod_.getBodyOriginLocation(simbody_state);
-			 * const SimTK::Vec3 r = R_GB * rr; // re-express station vector p_BS in G (15 flops)
-			 * base_particle_data_i.pos_n_ = (p_GB + r);
+			/** the station kinematics are expanded from the spatial kinematics of the
+			 * mobilized body cached in setupDynamics, so that the parallel pass does
+			 * not query the SimTK state per particle.
 			 */
-			pos_n_[index_i] = pos;
-			vel_n_[index_i] = vel;
-			dvel_dt_[index_i] = acc;
-			n_[index_i] = (mobod_.getBodyRotation(*simbody_state_) * n_0_[index_i]);
+			Vec3 r = mobod_rotation_ * Vec3(pos_0_[index_i] - initial_mobod_origin_location_);
+			pos_n_[index_i] = mobod_origin_location_ + r;
+			vel_n_[index_i] = mobod_origin_velocity_ + cross(mobod_angular_velocity_, r);
+			dvel_dt_[index_i] = mobod_origin_acceleration_ + cross(mobod_angular_acceleration_, r) +
+								cross(mobod_angular_velocity_, cross(mobod_angular_velocity_, r));
+			n_[index_i] = (mobod_rotation_ * n_0_[index_i]);
 		}
 		//=================================================================================================//
 		SimTK::SpatialVec TotalForceOnSolidBodyPartForSimBody
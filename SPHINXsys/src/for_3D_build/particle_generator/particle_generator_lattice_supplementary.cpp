@@ -16,41 +16,74 @@ namespace SPH
 		BaseMesh mesh(domain_bounds_, lattice_spacing_, 0);
 		Real particle_volume = lattice_spacing_ * lattice_spacing_ * lattice_spacing_;
 		Vecu number_of_lattices = mesh.NumberOfCellsFromNumberOfGridPoints(mesh.NumberOfGridPoints());
-		for (size_t i = 0; i < number_of_lattices[0]; ++i)
-			for (size_t j = 0; j < number_of_lattices[1]; ++j)
-				for (size_t k = 0; k < number_of_lattices[2]; ++k)
+		// the shape is only probed read-only, so the lattice sweep runs in
+		// parallel over blocks of lattice slabs with per-slab buffers,
+		// which are merged in order for a deterministic particle sequence
+		StdVec<StdVec<Vecd>> accepted_positions(number_of_lattices[0]);
+		parallel_for(
+			blocked_range<size_t>(0, number_of_lattices[0]),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
 				{
-					Vecd particle_position = mesh.CellPositionFromIndex(Vecu(i, j, k));
-					if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
-					{
-						if (body_shape_.checkContain(particle_position))
+					StdVec<Vecd> &slab_positions = accepted_positions[i];
+					for (size_t j = 0; j < number_of_lattices[1]; ++j)
+						for (size_t k = 0; k < number_of_lattices[2]; ++k)
 						{
-							initializePositionAndVolume(particle_position, particle_volume);
+							Vecd particle_position = mesh.CellPositionFromIndex(Vecu(i, j, k));
+							if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
+							{
+								if (body_shape_.checkContain(particle_position))
+								{
+									slab_positions.push_back(particle_position);
+								}
+							}
 						}
-					}
 				}
+			},
+			ap);
+
+		for (size_t i = 0; i < number_of_lattices[0]; ++i)
+			for (const Vecd &particle_position : accepted_positions[i])
+				initializePositionAndVolume(particle_position, particle_volume);
 	}
 	//=================================================================================================//
 	void ThickSurfaceParticleGeneratorLattice::initializeGeometricVariables()
 	{
 		// Calculate the total volume and
 		// count the number of cells inside the body volume, where we might put particles.
+		// The counting sweep only probes the shape, so it runs in parallel over
+		// blocks of lattice slabs with per-slab buffers merged in order.
 		std::unique_ptr<BaseMesh> mesh(new BaseMesh(domain_bounds_, lattice_spacing_, 0));
 		Vecu number_of_lattices = mesh->NumberOfCellsFromNumberOfGridPoints(mesh->NumberOfGridPoints());
-		for (size_t i = 0; i < number_of_lattices[0]; ++i)
-			for (size_t j = 0; j < number_of_lattices[1]; ++j)
-				for (size_t k = 0; k < number_of_lattices[2]; ++k)
+		StdVec<StdVec<Vecd>> accepted_positions(number_of_lattices[0]);
+		parallel_for(
+			blocked_range<size_t>(0, number_of_lattices[0]),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
 				{
-					Vecd particle_position = mesh->CellPositionFromIndex(Vecu(i, j, k));
-					if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
-					{
-						if (body_shape_.checkContain(particle_position))
+					StdVec<Vecd> &slab_positions = accepted_positions[i];
+					for (size_t j = 0; j < number_of_lattices[1]; ++j)
+						for (size_t k = 0; k < number_of_lattices[2]; ++k)
 						{
-							number_of_cells_++;
-							total_volume_ += lattice_spacing_ * lattice_spacing_ * lattice_spacing_;
+							Vecd particle_position = mesh->CellPositionFromIndex(Vecu(i, j, k));
+							if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
+							{
+								if (body_shape_.checkContain(particle_position))
+								{
+									slab_positions.push_back(particle_position);
+								}
+							}
 						}
-					}
 				}
+			},
+			ap);
+		for (size_t i = 0; i < number_of_lattices[0]; ++i)
+		{
+			number_of_cells_ += accepted_positions[i].size();
+			total_volume_ += accepted_positions[i].size() * lattice_spacing_ * lattice_spacing_ * lattice_spacing_;
+		}
 		Real number_of_particles = total_volume_ / avg_particle_volume_ + 0.5;
 		planned_number_of_particles_ = int(number_of_particles);
 
@@ -59,25 +92,37 @@ namespace SPH
 		if (interval <= 0)
 			interval = 1; // It has to be lager than 0.
 		// Add a particle in each interval, randomly. We will skip the last intervals if we already reach the number of particles.
+		// The random selection revisits the collected positions serially, so the rand() sequence
+		// and with it the generated particle ordering stay reproducible.
+		StdVec<Vecd> selected_positions;
 		for (size_t i = 0; i < number_of_lattices[0]; ++i)
-			for (size_t j = 0; j < number_of_lattices[1]; ++j)
-				for (size_t k = 0; k < number_of_lattices[2]; ++k)
+			for (const Vecd &particle_position : accepted_positions[i])
+			{
+				Real random_real = (Real)rand() / (RAND_MAX);
+				// If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles.
+				if (random_real <= interval && selected_positions.size() < size_t(planned_number_of_particles_))
 				{
-					Vecd particle_position = mesh->CellPositionFromIndex(Vecu(i, j, k));
-					if (body_shape_.checkNotFar(particle_position, lattice_spacing_))
-					{
-						if (body_shape_.checkContain(particle_position))
-						{
-							Real random_real = (Real)rand() / (RAND_MAX);
-							// If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles.
-							if (random_real <= interval && base_particles_->total_real_particles_ < planned_number_of_particles_)
-							{
-								initializePositionAndVolume(particle_position, avg_particle_volume_);
-								initializeSurfaceProperties(body_shape_.findNormalDirection(particle_position), global_avg_thickness_);
-							}
-						}
-					}
+					selected_positions.push_back(particle_position);
 				}
+			}
+
+		// The normal direction probes the level set read-only and dominates the
+		// generation time, so it is evaluated in parallel into a pre-sized buffer.
+		StdVec<Vecd> surface_normals(selected_positions.size());
+		parallel_for(
+			blocked_range<size_t>(0, selected_positions.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+					surface_normals[n] = body_shape_.findNormalDirection(selected_positions[n]);
+			},
+			ap);
+
+		for (size_t n = 0; n < selected_positions.size(); ++n)
+		{
+			initializePositionAndVolume(selected_positions[n], avg_particle_volume_);
+			initializeSurfaceProperties(surface_normals[n], global_avg_thickness_);
+		}
 	}
 	//=================================================================================================//
 }
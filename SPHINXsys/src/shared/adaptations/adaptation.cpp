@@ -88,6 +88,11 @@ namespace SPH
 		spacing_min_ = RefinedSpacing(spacing_ref_, local_refinement_level_);
 	}
 	//=================================================================================================//
+	void SPHAdaptation::useTabulatedKernel(int kernel_resolution)
+	{
+		kernel_ = tabulated_kernel_ptr_keeper_.createPtr<KernelTabulatedRuntime>(*kernel_, kernel_resolution);
+	}
+	//=================================================================================================//
 	UniquePtr<BaseCellLinkedList> SPHAdaptation::createCellLinkedList()
 	{
 		return makeUnique<CellLinkedList>(system_domain_bounds_, kernel_->CutOffRadius(), *sph_body_, *this);
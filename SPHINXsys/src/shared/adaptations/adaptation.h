@@ -55,6 +55,7 @@ namespace SPH
 	{
 	private:
 		UniquePtrKeeper<Kernel> kernel_ptr_keeper_;
+		UniquePtrKeeper<Kernel> tabulated_kernel_ptr_keeper_;
 
 	protected:
 		SPHBody *sph_body_;
@@ -85,6 +86,11 @@ namespace SPH
 		{
 			kernel_ = kernel_ptr_keeper_.createPtr<KernelType>(h_ref_, std::forward<ConstructorArgs>(args)...);
 		};
+		/** replace the current kernel by its tabulated counterpart, whatever
+		 * its type, so that neighbor relations created afterwards evaluate
+		 * kernel values and gradients by fused table lookup. To be called
+		 * before the body relations are constructed. */
+		void useTabulatedKernel(int kernel_resolution = 200);
 		Real MinimumSpacing() { return spacing_min_; };
 		Real MinimumSpacingRatio() { return spacing_ratio_min_; };
 		Real computeReferenceNumberDensity(Vec2d zero, Real h_ratio);
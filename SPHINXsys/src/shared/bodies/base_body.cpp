@@ -8,13 +8,14 @@
 #include "sph_system.h"
 #include "base_particles.hpp"
 #include "body_relation.h"
+#include "base_body_part.h"
 
 namespace SPH
 {
 	//=================================================================================================//
 	SPHBody::SPHBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr)
 		: body_shape_(shape_ptr_keeper_.assignPtr(shape_ptr)),
-		  sph_system_(sph_system), body_name_(body_shape_->getName()), newly_updated_(true),
+		  sph_system_(sph_system), body_name_(body_shape_->getName()), newly_updated_(true), is_static_(false),
 		  body_domain_bounds_(0, 0), is_domain_bounds_determined_(false),
 		  sph_adaptation_(sph_adaptation_ptr_keeper_.createPtr<SPHAdaptation>(this)),
 		  base_material_(nullptr), base_particles_(nullptr)
@@ -27,6 +28,31 @@ namespace SPH
 		return sph_system_.system_domain_bounds_;
 	}
 	//=================================================================================================//
+	size_t SPHBody::ParticleDataMemoryFootprint()
+	{
+		return base_particles_->ParticleDataMemoryFootprint();
+	}
+	//=================================================================================================//
+	size_t SPHBody::ConfigurationsMemoryFootprint()
+	{
+		size_t footprint_in_bytes = 0;
+		for (size_t k = 0; k != body_relations_.size(); ++k)
+			footprint_in_bytes += body_relations_[k]->MemoryFootprint();
+		return footprint_in_bytes;
+	}
+	//=================================================================================================//
+	size_t SPHBody::LevelSetMemoryFootprint()
+	{
+		LevelSetShape *level_set_shape = dynamic_cast<LevelSetShape *>(body_shape_);
+		return level_set_shape != nullptr ? level_set_shape->MemoryFootprint() : 0;
+	}
+	//=================================================================================================//
+	size_t SPHBody::TotalMemoryFootprint()
+	{
+		return ParticleDataMemoryFootprint() + ConfigurationsMemoryFootprint() +
+			   CellLinkedListMemoryFootprint() + LevelSetMemoryFootprint();
+	}
+	//=================================================================================================//
 	std::string SPHBody::getBodyName()
 	{
 		return body_name_;
@@ -101,6 +127,16 @@ namespace SPH
 		base_particles_->readParticleFromXmlForRestart(filefullpath);
 	}
 	//=================================================================================================//
+	void SPHBody::writeParticlesToBinaryForRestart(std::string &filefullpath)
+	{
+		base_particles_->writeParticlesToBinaryForRestart(filefullpath);
+	}
+	//=================================================================================================//
+	void SPHBody::readParticlesFromBinaryForRestart(std::string &filefullpath)
+	{
+		base_particles_->readParticlesFromBinaryForRestart(filefullpath);
+	}
+	//=================================================================================================//
 	void SPHBody::writeToXmlForReloadParticle(std::string &filefullpath)
 	{
 		base_particles_->writeToXmlForReloadParticle(filefullpath);
@@ -111,8 +147,19 @@ namespace SPH
 		base_particles_->readFromXmlForReloadParticle(filefullpath);
 	}
 	//=================================================================================================//
+	void SPHBody::writeToBinaryForReloadParticle(std::string &filefullpath)
+	{
+		base_particles_->writeToBinaryForReloadParticle(filefullpath);
+	}
+	//=================================================================================================//
+	void SPHBody::readFromBinaryForReloadParticle(std::string &filefullpath)
+	{
+		base_particles_->readFromBinaryForReloadParticle(filefullpath);
+	}
+	//=================================================================================================//
 	RealBody::RealBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr)
-		: SPHBody(sph_system, shape_ptr), particle_sorting_(this)
+		: SPHBody(sph_system, shape_ptr), cell_linked_list_built_(false),
+		  cell_linked_list_update_pending_(false), particle_sorting_(this)
 	{
 		sph_system.real_bodies_.push_back(this);
 		cell_linked_list_ = cell_linked_list_keeper_.movePtr(sph_adaptation_->createCellLinkedList());
@@ -127,17 +174,97 @@ namespace SPH
 		cell_linked_list_->assignBaseParticles(base_particles);
 	}
 	//=================================================================================================//
+	bool SortingCadencePolicy::checkSortingRequired(const StdLargeVec<size_t> &sequence, size_t total_real_particles)
+	{
+		if (total_real_particles < 2)
+			return false;
+
+		size_t out_of_order_count = parallel_reduce(
+			blocked_range<size_t>(0, total_real_particles - 1), size_t(0),
+			[&](const blocked_range<size_t> &r, size_t temp) -> size_t
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					if (sequence[i] > sequence[i + 1])
+						temp++;
+				}
+				return temp;
+			},
+			[](size_t x, size_t y) -> size_t
+			{ return x + y; });
+
+		return Real(out_of_order_count) > disorder_threshold_ * Real(total_real_particles);
+	}
+	//=================================================================================================//
 	void RealBody::sortParticleWithCellLinkedList()
 	{
+		finishUpdateCellLinkedList();
 		StdLargeVec<size_t> &sequence = base_particles_->sequence_;
 		size_t size = base_particles_->total_real_particles_;
 		cell_linked_list_->computingSequence(sequence);
+		if (sorting_cadence_policy_.usingAdaptiveCadence() &&
+			!sorting_cadence_policy_.checkSortingRequired(sequence, size))
+			return;
+		// snapshot the current index-to-id map, so that the body-part index
+		// lists can be remapped after the particles have changed their indexes
+		bool has_body_parts_by_particle = !body_parts_by_particle_.empty();
+		if (has_body_parts_by_particle)
+		{
+			StdLargeVec<size_t> &unsorted_id = base_particles_->unsorted_id_;
+			pre_sorting_unsorted_ids_.resize(size);
+			parallel_for(
+				blocked_range<size_t>(0, size),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						pre_sorting_unsorted_ids_[i] = unsorted_id[i];
+				},
+				ap);
+		}
 		particle_sorting_.sortingParticleData(sequence.data(), size);
+		if (has_body_parts_by_particle)
+		{
+			for (size_t i = 0; i < body_parts_by_particle_.size(); i++)
+				body_parts_by_particle_[i]->updateParticleIndexesAfterSorting(pre_sorting_unsorted_ids_);
+		}
+		cell_linked_list_->invalidateCellResidency();
+		cell_linked_list_->markCellKeySortedOrder();
+		for (size_t i = 0; i < body_relations_.size(); i++)
+		{
+			body_relations_[i]->shrinkConfigurationMemories();
+			body_relations_[i]->markConfigurationUpdated();
+		}
 	}
 	//=================================================================================================//
 	void RealBody::updateCellLinkedList()
 	{
+		//the cell linked list of a static body is frozen after the first build
+		if (is_static_ && cell_linked_list_built_)
+			return;
 		cell_linked_list_->UpdateCellLists();
+		cell_linked_list_built_ = true;
+	}
+	//=================================================================================================//
+	void RealBody::updateCellLinkedListAsync()
+	{
+		finishUpdateCellLinkedList();
+		cell_linked_list_update_pending_ = true;
+		cell_linked_list_update_task_.run([this]
+										  { updateCellLinkedList(); });
+	}
+	//=================================================================================================//
+	void RealBody::finishUpdateCellLinkedList()
+	{
+		if (cell_linked_list_update_pending_)
+		{
+			cell_linked_list_update_task_.wait();
+			cell_linked_list_update_pending_ = false;
+		}
+	}
+	//=================================================================================================//
+	size_t RealBody::CellLinkedListMemoryFootprint()
+	{
+		return cell_linked_list_->MemoryFootprint();
 	}
 	//=================================================================================================//
 }
@@ -43,6 +43,8 @@
 #include "particle_sorting.h"
 #include "all_geometries.h"
 
+#include "tbb/task_group.h"
+
 #include <string>
 
 namespace SPH
@@ -50,6 +52,7 @@ namespace SPH
 	class SPHSystem;
 	class SPHBodyRelation;
 	class BodySurface;
+	class BodyPartByParticle;
 
 	/**
 	 * @class SPHBody
@@ -77,6 +80,7 @@ namespace SPH
 		SPHSystem &sph_system_;
 		std::string body_name_;
 		bool newly_updated_; /**< whether this body is in a newly updated state */
+		bool is_static_;	 /**< whether the body particles are known not to move */
 		/** Computational domain bounds for body boundary conditions.
 		 * Note that domain bounds may be different from those of the initial body geometry. */
 		BoundingBox body_domain_bounds_;
@@ -93,8 +97,16 @@ namespace SPH
 		 * they have no interaction because they are too far.
 		 */
 		SplitCellLists split_cell_lists_;
+		/** flat per-level index ranges into the counting-sorted cell-contiguous
+		 * particle storage of the cell linked list, rebuilt together with the
+		 * split cell lists; cleared when the rebuild does not provide the
+		 * contiguous storage, upon which the splitting sweeps fall back to
+		 * the cell-pointer lists above. */
+		SplitCellIndexRanges split_cell_index_ranges_;
 
 		StdVec<SPHBodyRelation *> body_relations_; /**< all contact relations centered from this body **/
+		/** all particle-index body parts of this body, maintained under particle sorting **/
+		StdVec<BodyPartByParticle *> body_parts_by_particle_;
 
 		explicit SPHBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr);
 		virtual ~SPHBody(){};
@@ -105,9 +117,24 @@ namespace SPH
 		void setNewlyUpdated() { newly_updated_ = true; };
 		void setNotNewlyUpdated() { newly_updated_ = false; };
 		bool checkNewlyUpdated() { return newly_updated_; };
+		/** mark the body as static, e.g. a wall or fixture: its cell linked
+		 * list is frozen after the first build and pairings with other static
+		 * bodies are not searched again. wakeUp() resumes the updates. */
+		void markAsStatic() { is_static_ = true; };
+		void wakeUp() { is_static_ = false; };
+		bool isStatic() { return is_static_; };
 		void setBodyDomainBounds(const BoundingBox &body_domain_bounds);
 		BoundingBox getBodyDomainBounds();
 		BoundingBox getSPHSystemBounds();
+		/** allocated bytes of the major per-body memory consumers, itemized
+		 * for capacity planning: particle variables, the neighbor configurations
+		 * of all subscribed relations, the cell linked list and the level-set
+		 * mesh of the body shape. */
+		size_t ParticleDataMemoryFootprint();
+		size_t ConfigurationsMemoryFootprint();
+		virtual size_t CellLinkedListMemoryFootprint() { return 0; };
+		size_t LevelSetMemoryFootprint();
+		size_t TotalMemoryFootprint();
 		//----------------------------------------------------------------------
 		//		Object factory template functions
 		//----------------------------------------------------------------------
@@ -177,11 +204,46 @@ namespace SPH
 		virtual void writeSurfaceParticlesToVtuFile(std::ofstream &output_file, BodySurface &surface_particles);
 		virtual void writeParticlesToXmlForRestart(std::string &filefullpath);
 		virtual void readParticlesFromXmlForRestart(std::string &filefullpath);
+		virtual void writeParticlesToBinaryForRestart(std::string &filefullpath);
+		virtual void readParticlesFromBinaryForRestart(std::string &filefullpath);
 		virtual void writeToXmlForReloadParticle(std::string &filefullpath);
 		virtual void readFromXmlForReloadParticle(std::string &filefullpath);
+		virtual void writeToBinaryForReloadParticle(std::string &filefullpath);
+		virtual void readFromBinaryForReloadParticle(std::string &filefullpath);
 		virtual SPHBody *ThisObjectPtr() { return this; };
 	};
 
+	/**
+	 * @class SortingCadencePolicy
+	 * @brief An adaptive controller for the particle sorting cadence.
+	 * The fraction of adjacent particles out of cell-sequence order is a
+	 * cheap proxy for the memory locality of the interaction loops: it is
+	 * zero right after sorting and grows as particles drift. When switched
+	 * on, a requested sort is only admitted once the disorder exceeds the
+	 * threshold, so that the cadence adapts to the actual particle motion
+	 * instead of a hand-tuned iteration count.
+	 */
+	class SortingCadencePolicy
+	{
+	public:
+		SortingCadencePolicy() : adaptive_cadence_enabled_(false), disorder_threshold_(0.0625){};
+
+		/** let the body skip the sorts requested while the particle order
+		 * is still close to the cell-sequence order. */
+		void useAdaptiveCadence(Real disorder_threshold = 0.0625)
+		{
+			adaptive_cadence_enabled_ = true;
+			disorder_threshold_ = disorder_threshold;
+		};
+		bool usingAdaptiveCadence() { return adaptive_cadence_enabled_; };
+		/** whether the measured disorder of the given sequence asks for a sort. */
+		bool checkSortingRequired(const StdLargeVec<size_t> &sequence, size_t total_real_particles);
+
+	protected:
+		bool adaptive_cadence_enabled_;
+		Real disorder_threshold_; /**< admissible fraction of out-of-order adjacent particles. */
+	};
+
 	/**
 	 * @class RealBody
 	 * @brief Derived body with inner particle configuration or inner interactions.
@@ -192,18 +254,36 @@ namespace SPH
 	private:
 		UniquePtrKeeper<BaseCellLinkedList> cell_linked_list_keeper_;
 
+	protected:
+		bool cell_linked_list_built_; /**< whether the cell linked list has been built at least once */
+		/** snapshot of the index-to-id map taken just before a particle sort. */
+		StdLargeVec<size_t> pre_sorting_unsorted_ids_;
+		tbb::task_group cell_linked_list_update_task_;
+		bool cell_linked_list_update_pending_; /**< whether an asynchronous cell list update is in flight. */
+
 	public:
 		ParticleSorting particle_sorting_;
-		BaseCellLinkedList *cell_linked_list_; /**< Cell linked mesh of this body. */
+		SortingCadencePolicy sorting_cadence_policy_; /**< adaptive controller for the sorting cadence. */
+		BaseCellLinkedList *cell_linked_list_;		  /**< Cell linked mesh of this body. */
 
 		explicit RealBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr);
-		virtual ~RealBody(){};
+		virtual ~RealBody() noexcept { finishUpdateCellLinkedList(); };
 
 		/** This will be called in BaseParticle constructor
 		 * and is important because particles are not defined in FluidBody constructor.  */
 		virtual void assignBaseParticles(BaseParticles *base_particles) override;
 		virtual void sortParticleWithCellLinkedList();
 		virtual void updateCellLinkedList();
+		/** build the cell linked list concurrently with subsequent dynamics
+		 * that neither read the cell structures nor move the particles, e.g.
+		 * time-step initialization and the reduction-based time-step criteria.
+		 * finishUpdateCellLinkedList() must be called before anything touches
+		 * the cell linked list again, in particular before the configurations
+		 * are updated or the particles are sorted. */
+		void updateCellLinkedListAsync();
+		/** block until an asynchronous cell list update has finished */
+		void finishUpdateCellLinkedList();
+		virtual size_t CellLinkedListMemoryFootprint() override;
 		//----------------------------------------------------------------------
 		//		Object factory template functions
 		//----------------------------------------------------------------------
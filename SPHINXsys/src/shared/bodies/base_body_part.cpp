@@ -17,11 +17,48 @@ namespace SPH
 		}
 	};
 	//=================================================================================================//
+	void BodyPartByParticle::tagParticlesParallel(CheckParticleMethod &check_particle_method)
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		StdLargeVec<int> &is_tagged =
+			base_particles_->scratch_buffers_.obtainBuffer<int>("BodyPartTagging", total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					is_tagged[i] = check_particle_method(i) ? 1 : 0;
+			},
+			ap);
+		//- the cheap collection keeps the ascending particle order of the serial tagging
+		body_part_particles_.clear();
+		for (size_t i = 0; i != total_real_particles; ++i)
+			if (is_tagged[i])
+				body_part_particles_.push_back(i);
+	};
+	//=================================================================================================//
+	void BodyPartByParticle::updateParticleIndexesAfterSorting(const StdLargeVec<size_t> &pre_sorting_unsorted_ids)
+	{
+		StdLargeVec<size_t> &sorted_id = base_particles_->sorted_id_;
+		for (size_t i = 0; i != body_part_particles_.size(); ++i)
+		{
+			size_t unsorted_id = pre_sorting_unsorted_ids[body_part_particles_[i]];
+			body_part_particles_[i] = sorted_id[unsorted_id];
+		}
+		std::sort(body_part_particles_.begin(), body_part_particles_.end());
+	};
+	//=================================================================================================//
 	void BodyPartByCell::tagCells(TaggingCellMethod &tagging_cell_method)
 	{
 		cell_linked_list_->tagBodyPartByCell(body_part_cells_, tagging_cell_method);
 	}
 	//=================================================================================================//
+	void BodyPartByCell::retagCells(TaggingCellMethod &tagging_cell_method, const BoundingBox &retagging_bounds)
+	{
+		body_part_cells_.clear();
+		cell_linked_list_->retagBodyPartByCell(body_part_cells_, tagging_cell_method, retagging_bounds);
+	}
+	//=================================================================================================//
 	BodyRegionByParticle::
 		BodyRegionByParticle(SPHBody &sph_body, SharedPtr<Shape> shape_ptr)
 		: BodyPartByParticle(sph_body, shape_ptr->getName()), 
@@ -43,34 +80,74 @@ namespace SPH
 		: BodyPartByParticle(sph_body, "BodySurface"),
 		  particle_spacing_min_(sph_body.sph_adaptation_->MinimumSpacing())
 	{
-		TaggingParticleMethod tagging_particle_method = std::bind(&BodySurface::tagNearSurface, this, _1);
-		tagParticles(tagging_particle_method);
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		distance_at_last_test_.resize(total_real_particles);
+		pos_at_last_test_.resize(total_real_particles);
+		near_surface_.resize(total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					near_surface_[i] = checkNearSurface(i) ? 1 : 0;
+			},
+			ap);
+		collectNearSurfaceParticles();
 		std::cout << "Number of surface particles : " << body_part_particles_.size() << std::endl;
 	}
 	//=================================================================================================//
-	void BodySurface::tagNearSurface(size_t particle_index)
+	bool BodySurface::checkNearSurface(size_t particle_index)
 	{
 		Real phi = sph_body_->body_shape_->findSignedDistance(base_particles_->pos_n_[particle_index]);
-		if (fabs(phi) < particle_spacing_min_)
-			body_part_particles_.push_back(particle_index);
+		distance_at_last_test_[particle_index] = phi;
+		pos_at_last_test_[particle_index] = base_particles_->pos_n_[particle_index];
+		return fabs(phi) < particle_spacing_min_;
+	}
+	//=================================================================================================//
+	void BodySurface::collectNearSurfaceParticles()
+	{
+		body_part_particles_.clear();
+		for (size_t i = 0; i != near_surface_.size(); ++i)
+			if (near_surface_[i])
+				body_part_particles_.push_back(i);
+	}
+	//=================================================================================================//
+	void BodySurface::updateSurfaceParticles()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		parallel_for(
+			blocked_range<size_t>(0, near_surface_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					//- the signed distance can not have drifted by more than the
+					//- displacement since the last exact test, so the band
+					//- membership is only uncertain within this margin
+					Real displacement = (pos_n[i] - pos_at_last_test_[i]).norm();
+					Real last_distance = fabs(distance_at_last_test_[i]);
+					if (last_distance - displacement < particle_spacing_min_ &&
+						last_distance + displacement >= particle_spacing_min_)
+						near_surface_[i] = checkNearSurface(i) ? 1 : 0;
+				}
+			},
+			ap);
+		collectNearSurfaceParticles();
 	}
 	//=================================================================================================//
 	BodySurfaceLayer::BodySurfaceLayer(SPHBody &sph_body, Real layer_thickness)
 		: BodyPartByParticle(sph_body, "InnerLayers"),
 		  thickness_threshold_(sph_body.sph_adaptation_->ReferenceSpacing() * layer_thickness)
 	{
-		TaggingParticleMethod tagging_particle_method = std::bind(&BodySurfaceLayer::tagSurfaceLayer, this, _1);
-		tagParticles(tagging_particle_method);
+		CheckParticleMethod check_particle_method = std::bind(&BodySurfaceLayer::checkSurfaceLayer, this, _1);
+		tagParticlesParallel(check_particle_method);
 		std::cout << "Number of inner layers particles : " << body_part_particles_.size() << std::endl;
 	}
 	//=================================================================================================//
-	void BodySurfaceLayer::tagSurfaceLayer(size_t particle_index)
+	bool BodySurfaceLayer::checkSurfaceLayer(size_t particle_index)
 	{
 		Real distance = fabs(sph_body_->body_shape_->findSignedDistance(base_particles_->pos_n_[particle_index]));
-		if (distance < thickness_threshold_)
-		{
-			body_part_particles_.push_back(particle_index);
-		}
+		return distance < thickness_threshold_;
 	}
 	//=================================================================================================//
 	BodyRegionByCell::BodyRegionByCell(RealBody &real_body,  SharedPtr<Shape> shape_ptr)
@@ -81,6 +158,17 @@ namespace SPH
 		tagCells(tagging_cell_method);
 	};
 	//=================================================================================================//
+	void BodyRegionByCell::updateCellList(Real motion_bound)
+	{
+		// the previously tagged cells lie within the present shape bounds inflated
+		// by the motion bound, so the cells outside keep their untagged status
+		BoundingBox retagging_bounds = body_part_shape_.findBounds();
+		retagging_bounds.first -= Vecd(motion_bound);
+		retagging_bounds.second += Vecd(motion_bound);
+		TaggingCellMethod tagging_cell_method = std::bind(&BodyRegionByCell::checkNotFar, this, _1, _2);
+		retagCells(tagging_cell_method, retagging_bounds);
+	}
+	//=================================================================================================//
 	bool BodyRegionByCell::checkNotFar(Vecd cell_position, Real threshold)
 	{
 		return body_part_shape_.checkNotFar(cell_position, threshold);
@@ -68,9 +68,18 @@ namespace SPH
 
 		BodyPartByParticle(SPHBody &sph_body, const std::string &body_part_name)
 			: BodyPart(sph_body, body_part_name), base_particles_(sph_body.base_particles_),
-			  body_part_bounds_(Vecd(0), Vecd(0)), body_part_bounds_set_(false){};
+			  body_part_bounds_(Vecd(0), Vecd(0)), body_part_bounds_set_(false)
+		{
+			sph_body.body_parts_by_particle_.push_back(this);
+		};
 		virtual ~BodyPartByParticle(){};
 
+		/** remap the particle indexes after the body particles have been resorted;
+		 * the given map holds the index-to-id relation from just before the sort.
+		 * The remapped indexes are re-sorted ascending to restore streaming access
+		 * for the part iterators. */
+		void updateParticleIndexesAfterSorting(const StdLargeVec<size_t> &pre_sorting_unsorted_ids);
+
 		void setBodyPartBounds(BoundingBox bbox)
 		{
 			body_part_bounds_ = bbox;
@@ -91,6 +100,11 @@ namespace SPH
 
 		typedef std::function<void(size_t)> TaggingParticleMethod;
 		void tagParticles(TaggingParticleMethod &tagging_particle_method);
+
+		typedef std::function<bool(size_t)> CheckParticleMethod;
+		/** evaluate the check for all particles in parallel and collect the
+		 * tagged ones in ascending index order, as tagParticles() does serially */
+		void tagParticlesParallel(CheckParticleMethod &check_particle_method);
 	};
 
 	/**
@@ -110,6 +124,9 @@ namespace SPH
 		BaseCellLinkedList *cell_linked_list_;
 		typedef std::function<bool(Vecd, Real)> TaggingCellMethod;
 		void tagCells(TaggingCellMethod &tagging_cell_method);
+		/** rebuild the cell set by retesting only the cells within the given bounds,
+		 * the only region where the containment status can have changed */
+		void retagCells(TaggingCellMethod &tagging_cell_method, const BoundingBox &retagging_bounds);
 	};
 
 	/**
@@ -140,9 +157,22 @@ namespace SPH
 		explicit BodySurface(SPHBody &sph_body);
 		virtual ~BodySurface(){};
 
+		/** re-extract the surface particles after deformation. Only particles
+		 * whose band membership could have changed are re-tested: the signed
+		 * distance can not have drifted by more than the particle displacement
+		 * since its last exact evaluation, so particles far from the surface
+		 * band relative to their displacement keep their status without a
+		 * distance query. */
+		void updateSurfaceParticles();
+
 	private:
 		Real particle_spacing_min_;
-		void tagNearSurface(size_t particle_index);
+		StdLargeVec<Real> distance_at_last_test_; /**< signed distance at the last exact test */
+		StdLargeVec<Vecd> pos_at_last_test_;	  /**< position at the last exact test */
+		StdLargeVec<int> near_surface_;			  /**< current surface-band membership */
+
+		bool checkNearSurface(size_t particle_index);
+		void collectNearSurfaceParticles();
 	};
 
 	/**
@@ -157,7 +187,7 @@ namespace SPH
 
 	private:
 		Real thickness_threshold_;
-		void tagSurfaceLayer(size_t particle_index);
+		bool checkSurfaceLayer(size_t particle_index);
 	};
 
 	/**
@@ -174,6 +204,11 @@ namespace SPH
 		BodyRegionByCell(RealBody &real_body, SharedPtr<Shape> shape_ptr);
 		virtual ~BodyRegionByCell(){};
 
+		/** update the cell set after the shape has moved, retesting only the cells
+		 * within the present shape bounds inflated by the motion bound, i.e. how far
+		 * the shape can have moved since the cells were tagged the last time */
+		void updateCellList(Real motion_bound);
+
 	private:
 		bool checkNotFar(Vecd cell_position, Real threshold);
 	};
@@ -7,65 +7,535 @@
 #include "body_relation.h"
 
 #include "base_kernel.h"
+#include "kernel_quadratic.h"
 #include "base_particles.h"
 #include "base_particle_dynamics.h"
 #include "cell_linked_list.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 namespace SPH
 {
 	//=================================================================================================//
 	SPHBodyRelation::SPHBodyRelation(SPHBody &sph_body)
-		: sph_body_(&sph_body), base_particles_(sph_body.base_particles_) {}
+		: sph_body_(&sph_body), base_particles_(sph_body.base_particles_),
+		  configuration_version_(0) {}
 	//=================================================================================================//
 	BaseBodyRelationInner::BaseBodyRelationInner(RealBody &real_body)
-		: SPHBodyRelation(real_body), real_body_(&real_body)
+		: SPHBodyRelation(real_body), use_compact_configuration_(false),
+		  use_neighborhood_arena_(false), use_size_forecasting_(false),
+		  use_recomputed_pair_geometry_(false), use_kernel_gradient_(false),
+		  configuration_sealed_(false), real_body_(&real_body)
 	{
 		subscribeToBody();
 		updateConfigurationMemories();
 	}
 	//=================================================================================================//
+	void BaseBodyRelationInner::useRecomputedPairGeometry()
+	{
+		use_recomputed_pair_geometry_ = true;
+		inner_neighbor_list_.skipPairGeometry();
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::useKernelGradient()
+	{
+		use_kernel_gradient_ = true;
+		inner_neighbor_list_.packKernelGradient();
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::updateCompactConfiguration()
+	{
+		if (use_compact_configuration_)
+		{
+			inner_neighbor_list_.packConfiguration(inner_configuration_,
+												   base_particles_->total_real_particles_,
+												   compact_inner_configuration_);
+		}
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::sealConfiguration()
+	{
+		use_compact_configuration_ = true;
+		inner_neighbor_list_.packConfiguration(inner_configuration_,
+											   base_particles_->total_real_particles_,
+											   compact_inner_configuration_);
+		parallel_for(
+			blocked_range<size_t>(0, inner_configuration_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+					inner_configuration_[num].releaseStorage();
+			},
+			ap);
+		if (use_neighborhood_arena_)
+			neighborhood_arena_.release();
+		configuration_sealed_ = true;
+	}
+	//=================================================================================================//
 	void BaseBodyRelationInner::updateConfigurationMemories()
 	{
+		if (configuration_sealed_)
+			return;
 		size_t updated_size = sph_body_->base_particles_->real_particles_bound_;
-		inner_configuration_.resize(updated_size, Neighborhood());
+		if (use_neighborhood_arena_)
+		{
+			if (updated_size != inner_configuration_.size())
+			{
+				// all neighborhoods are rebuilt from a cleanly reset arena
+				// to reclaim the memory abandoned by earlier growth
+				inner_configuration_.clear();
+				neighborhood_arena_.reset();
+				inner_configuration_.resize(updated_size, Neighborhood(&neighborhood_arena_));
+			}
+		}
+		else
+		{
+			inner_configuration_.resize(updated_size, Neighborhood());
+		}
+		if (use_size_forecasting_)
+		{
+			neighbor_count_peaks_.resize(updated_size, 0);
+		}
 	}
 	//=================================================================================================//
 	void BaseBodyRelationInner::resetNeighborhoodCurrentSize()
 	{
+		// every configuration update starts here, so one guard covers all derived relations
+		if (configuration_sealed_)
+		{
+			std::cout << "\n Error: the sealed configuration of the body '"
+					  << sph_body_->getBodyName() << "' can not be updated!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		parallel_for(
+			blocked_range<size_t>(0, base_particles_->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					Neighborhood &neighborhood = inner_configuration_[num];
+					if (use_size_forecasting_)
+					{
+						// high-water mark with hysteresis: the peak follows growth
+						// at once but decays slowly, so that a transient spike
+						// does not pin the capacity forever
+						size_t &peak = neighbor_count_peaks_[num];
+						peak = SMAX(neighborhood.current_size_, peak - peak / 16);
+						size_t forecast_size = peak + peak / 8 + 4;
+						if (neighborhood.allocated_size_ < forecast_size)
+							neighborhood.reserveStorage(forecast_size, !use_recomputed_pair_geometry_,
+														use_kernel_gradient_);
+					}
+					neighborhood.current_size_ = 0;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::shrinkConfigurationMemories()
+	{
+		if (configuration_sealed_ || !use_size_forecasting_)
+			return;
+
+		if (use_neighborhood_arena_)
+		{
+			// shrinking within the arena would only abandon more chunk memory,
+			// so the arena is reset and the neighborhoods are rebuilt instead
+			size_t updated_size = sph_body_->base_particles_->real_particles_bound_;
+			inner_configuration_.clear();
+			neighborhood_arena_.reset();
+			inner_configuration_.resize(updated_size, Neighborhood(&neighborhood_arena_));
+			return;
+		}
+
 		parallel_for(
 			blocked_range<size_t>(0, base_particles_->total_real_particles_),
 			[&](const blocked_range<size_t> &r)
 			{
 				for (size_t num = r.begin(); num != r.end(); ++num)
 				{
-					inner_configuration_[num].current_size_ = 0;
+					Neighborhood &neighborhood = inner_configuration_[num];
+					size_t forecast_size = neighbor_count_peaks_[num] + neighbor_count_peaks_[num] / 8 + 4;
+					if (neighborhood.allocated_size_ > forecast_size)
+						neighborhood.shrinkStorage(forecast_size, !use_recomputed_pair_geometry_,
+												   use_kernel_gradient_);
 				}
 			},
 			ap);
 	}
 	//=================================================================================================//
+	size_t BaseBodyRelationInner::MemoryFootprint()
+	{
+		// arena-bound neighborhoods place their bytes in the chunks,
+		// so the chunks and the scattered capacities never both count
+		size_t footprint_in_bytes = neighborhood_arena_.MemoryFootprint();
+		if (!use_neighborhood_arena_)
+		{
+			for (size_t num = 0; num != inner_configuration_.size(); ++num)
+				footprint_in_bytes += inner_configuration_[num].MemoryFootprint();
+		}
+		footprint_in_bytes += inner_configuration_.capacity() * sizeof(Neighborhood);
+		footprint_in_bytes += inner_neighbor_list_.MemoryFootprint();
+		footprint_in_bytes += compact_inner_configuration_.capacity() * sizeof(CompactNeighborhood);
+		footprint_in_bytes += neighbor_count_peaks_.capacity() * sizeof(size_t);
+		return footprint_in_bytes;
+	}
+	//=================================================================================================//
+	namespace
+	{
+		void appendBytesToBuffer(std::string &buffer, const void *source, size_t bytes)
+		{
+			if (bytes > 0)
+				buffer.append(reinterpret_cast<const char *>(source), bytes);
+		}
+		//=================================================================================================//
+		bool readBytesFromBuffer(const char *&current, const char *end, void *target, size_t bytes)
+		{
+			if (current + bytes > end)
+				return false;
+			if (bytes > 0)
+				std::memcpy(target, current, bytes);
+			current += bytes;
+			return true;
+		}
+		//=================================================================================================//
+		/** a neighbor count followed by the flat neighbor arrays, i.e. the
+		 * compressed-sparse-row record of the configuration checkpoints */
+		void appendNeighborhoodToBuffer(std::string &buffer, size_t neighbor_count,
+										const size_t *j, const Real *W_ij, const Real *dW_ij,
+										const Real *r_ij, const Vecd *e_ij, const Vecd *dW_ij_e_ij,
+										bool with_pair_geometry, bool with_kernel_gradient)
+		{
+			uint64_t count = neighbor_count;
+			appendBytesToBuffer(buffer, &count, sizeof(count));
+			appendBytesToBuffer(buffer, j, neighbor_count * sizeof(size_t));
+			appendBytesToBuffer(buffer, W_ij, neighbor_count * sizeof(Real));
+			appendBytesToBuffer(buffer, dW_ij, neighbor_count * sizeof(Real));
+			if (with_pair_geometry)
+			{
+				appendBytesToBuffer(buffer, r_ij, neighbor_count * sizeof(Real));
+				appendBytesToBuffer(buffer, e_ij, neighbor_count * sizeof(Vecd));
+			}
+			if (with_kernel_gradient)
+				appendBytesToBuffer(buffer, dW_ij_e_ij, neighbor_count * sizeof(Vecd));
+		}
+		//=================================================================================================//
+		void appendParticleConfigurationToBuffer(std::string &buffer, const ParticleConfiguration &configuration,
+												 size_t total_real_particles,
+												 bool with_pair_geometry, bool with_kernel_gradient)
+		{
+			uint64_t particle_count = total_real_particles;
+			appendBytesToBuffer(buffer, &particle_count, sizeof(particle_count));
+			uint8_t layout = (with_pair_geometry ? 1 : 0) | (with_kernel_gradient ? 2 : 0);
+			appendBytesToBuffer(buffer, &layout, sizeof(layout));
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				const Neighborhood &neighborhood = configuration[i];
+				appendNeighborhoodToBuffer(buffer, neighborhood.current_size_,
+										   neighborhood.j_.data(), neighborhood.W_ij_.data(),
+										   neighborhood.dW_ij_.data(), neighborhood.r_ij_.data(),
+										   neighborhood.e_ij_.data(), neighborhood.dW_ij_e_ij_.data(),
+										   with_pair_geometry, with_kernel_gradient);
+			}
+		}
+		//=================================================================================================//
+		void appendCompactConfigurationToBuffer(std::string &buffer, const CompactParticleConfiguration &configuration,
+												size_t total_real_particles,
+												bool with_pair_geometry, bool with_kernel_gradient)
+		{
+			uint64_t particle_count = total_real_particles;
+			appendBytesToBuffer(buffer, &particle_count, sizeof(particle_count));
+			uint8_t layout = (with_pair_geometry ? 1 : 0) | (with_kernel_gradient ? 2 : 0);
+			appendBytesToBuffer(buffer, &layout, sizeof(layout));
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				const CompactNeighborhood &neighborhood = configuration[i];
+				appendNeighborhoodToBuffer(buffer, neighborhood.current_size_,
+										   neighborhood.j_, neighborhood.W_ij_, neighborhood.dW_ij_,
+										   neighborhood.r_ij_, neighborhood.e_ij_, neighborhood.dW_ij_e_ij_,
+										   with_pair_geometry, with_kernel_gradient);
+			}
+		}
+		//=================================================================================================//
+		bool readParticleConfigurationFromBuffer(const char *&current, const char *end,
+												 ParticleConfiguration &configuration,
+												 size_t total_real_particles,
+												 bool with_pair_geometry, bool with_kernel_gradient)
+		{
+			uint64_t particle_count = 0;
+			uint8_t layout = 0;
+			if (!readBytesFromBuffer(current, end, &particle_count, sizeof(particle_count)) ||
+				!readBytesFromBuffer(current, end, &layout, sizeof(layout)))
+				return false;
+			uint8_t expected_layout = (with_pair_geometry ? 1 : 0) | (with_kernel_gradient ? 2 : 0);
+			if (particle_count != total_real_particles || layout != expected_layout ||
+				configuration.size() < total_real_particles)
+				return false;
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				uint64_t neighbor_count = 0;
+				if (!readBytesFromBuffer(current, end, &neighbor_count, sizeof(neighbor_count)))
+					return false;
+				Neighborhood &neighborhood = configuration[i];
+				if (neighborhood.allocated_size_ < neighbor_count)
+					neighborhood.reserveStorage(neighbor_count, with_pair_geometry, with_kernel_gradient);
+				bool read_well =
+					readBytesFromBuffer(current, end, neighborhood.j_.data(), neighbor_count * sizeof(size_t)) &&
+					readBytesFromBuffer(current, end, neighborhood.W_ij_.data(), neighbor_count * sizeof(Real)) &&
+					readBytesFromBuffer(current, end, neighborhood.dW_ij_.data(), neighbor_count * sizeof(Real));
+				if (with_pair_geometry)
+					read_well = read_well &&
+								readBytesFromBuffer(current, end, neighborhood.r_ij_.data(), neighbor_count * sizeof(Real)) &&
+								readBytesFromBuffer(current, end, neighborhood.e_ij_.data(), neighbor_count * sizeof(Vecd));
+				if (with_kernel_gradient)
+					read_well = read_well &&
+								readBytesFromBuffer(current, end, neighborhood.dW_ij_e_ij_.data(), neighbor_count * sizeof(Vecd));
+				if (!read_well)
+					return false;
+				neighborhood.current_size_ = neighbor_count;
+			}
+			return true;
+		}
+	}
+	//=================================================================================================//
+	void BaseBodyRelationInner::writeConfigurationToBuffer(std::string &buffer)
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		if (configuration_sealed_)
+		{
+			// the scattered storage was released with the sealing,
+			// so the sealed arena views supply the data instead
+			appendCompactConfigurationToBuffer(buffer, compact_inner_configuration_, total_real_particles,
+											   !use_recomputed_pair_geometry_, use_kernel_gradient_);
+			return;
+		}
+		appendParticleConfigurationToBuffer(buffer, inner_configuration_, total_real_particles,
+											!use_recomputed_pair_geometry_, use_kernel_gradient_);
+	}
+	//=================================================================================================//
+	bool BaseBodyRelationInner::readConfigurationFromBuffer(const char *&current, const char *end)
+	{
+		if (configuration_sealed_)
+			return false;
+		updateConfigurationMemories();
+		if (!readParticleConfigurationFromBuffer(current, end, inner_configuration_,
+												 base_particles_->total_real_particles_,
+												 !use_recomputed_pair_geometry_, use_kernel_gradient_))
+			return false;
+		updateCompactConfiguration();
+		markConfigurationUpdated();
+		return true;
+	}
+	//=================================================================================================//
 	BodyRelationInner::BodyRelationInner(RealBody &real_body)
-		: BaseBodyRelationInner(real_body), get_inner_neighbor_(&real_body),
+		: BaseBodyRelationInner(real_body), use_half_configuration_(false),
+		  use_frozen_configuration_(false), frozen_configuration_built_(false),
+		  get_inner_neighbor_(&real_body), get_inner_neighbor_half_(&real_body),
 		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)) {}
 	//=================================================================================================//
+	void BodyRelationInner::useFrozenConfiguration()
+	{
+		use_frozen_configuration_ = true;
+		useCompactConfiguration();
+		real_body_->markAsStatic();
+	}
+	//=================================================================================================//
+	void BodyRelationInner::useRecomputedPairGeometry()
+	{
+		BaseBodyRelationInner::useRecomputedPairGeometry();
+		get_inner_neighbor_.skipPairGeometry();
+		get_inner_neighbor_half_.skipPairGeometry();
+	}
+	//=================================================================================================//
+	void BodyRelationInner::useKernelGradient()
+	{
+		BaseBodyRelationInner::useKernelGradient();
+		get_inner_neighbor_.storeKernelGradient();
+		get_inner_neighbor_half_.storeKernelGradient();
+	}
+	//=================================================================================================//
 	void BodyRelationInner::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		if (use_frozen_configuration_ && frozen_configuration_built_)
+			return;
+		markConfigurationUpdated();
+		resetNeighborhoodCurrentSize();
+		if (use_half_configuration_)
+		{
+			cell_linked_list_
+				->searchNeighborsByParticles(base_particles_->total_real_particles_,
+											 *base_particles_, inner_configuration_,
+											 get_particle_index_, get_single_search_depth_,
+											 get_inner_neighbor_half_);
+		}
+		else
+		{
+			cell_linked_list_
+				->searchNeighborsByParticles(base_particles_->total_real_particles_,
+											 *base_particles_, inner_configuration_,
+											 get_particle_index_, get_single_search_depth_,
+											 get_inner_neighbor_);
+		}
+		updateCompactConfiguration();
+		frozen_configuration_built_ = true;
+	}
+	//=================================================================================================//
+	bool BodyRelationInner::readConfigurationFromBuffer(const char *&current, const char *end)
+	{
+		if (!BaseBodyRelationInner::readConfigurationFromBuffer(current, end))
+			return false;
+		frozen_configuration_built_ = true;
+		return true;
+	}
+	//=================================================================================================//
+	template <class KernelType>
+	BodyRelationInnerKnownKernel<KernelType>::BodyRelationInnerKnownKernel(RealBody &real_body)
+		: BodyRelationInner(real_body), get_known_kernel_inner_neighbor_(&real_body) {}
+	//=================================================================================================//
+	template <class KernelType>
+	void BodyRelationInnerKnownKernel<KernelType>::useRecomputedPairGeometry()
+	{
+		BodyRelationInner::useRecomputedPairGeometry();
+		get_known_kernel_inner_neighbor_.skipPairGeometry();
+	}
+	//=================================================================================================//
+	template <class KernelType>
+	void BodyRelationInnerKnownKernel<KernelType>::useKernelGradient()
+	{
+		BodyRelationInner::useKernelGradient();
+		get_known_kernel_inner_neighbor_.storeKernelGradient();
+	}
+	//=================================================================================================//
+	template <class KernelType>
+	void BodyRelationInnerKnownKernel<KernelType>::updateConfiguration()
+	{
+		// the half configuration builds with its own functor and keeps the dynamic kernel calls
+		if (use_half_configuration_)
+		{
+			BodyRelationInner::updateConfiguration();
+			return;
+		}
+
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		if (use_frozen_configuration_ && frozen_configuration_built_)
+			return;
+		markConfigurationUpdated();
 		resetNeighborhoodCurrentSize();
 		cell_linked_list_
 			->searchNeighborsByParticles(base_particles_->total_real_particles_,
 										 *base_particles_, inner_configuration_,
 										 get_particle_index_, get_single_search_depth_,
-										 get_inner_neighbor_);
+										 get_known_kernel_inner_neighbor_);
+		updateCompactConfiguration();
+		frozen_configuration_built_ = true;
+	}
+	//=================================================================================================//
+	template class BodyRelationInnerKnownKernel<KernelWendlandC2>;
+	template class BodyRelationInnerKnownKernel<KernelCubicBSpline>;
+	template class BodyRelationInnerKnownKernel<KernelHyperbolic>;
+	template class BodyRelationInnerKnownKernel<KernelQuadratic>;
+	template class BodyRelationInnerKnownKernel<KernelLaguerreGauss>;
+	template class BodyRelationInnerKnownKernel<KernelTabulatedRuntime>;
+	//=================================================================================================//
+	BodyRelationInnerVerlet::BodyRelationInnerVerlet(RealBody &real_body, Real skin_distance)
+		: BaseBodyRelationInner(real_body), skin_distance_(skin_distance),
+		  configuration_built_(false),
+		  get_skin_search_depth_(real_body, DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_), skin_distance),
+		  get_inner_neighbor_with_skin_(&real_body, skin_distance),
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)) {}
+	//=================================================================================================//
+	void BodyRelationInnerVerlet::useRecomputedPairGeometry()
+	{
+		BaseBodyRelationInner::useRecomputedPairGeometry();
+		get_inner_neighbor_with_skin_.skipPairGeometry();
+	}
+	//=================================================================================================//
+	void BodyRelationInnerVerlet::useKernelGradient()
+	{
+		BaseBodyRelationInner::useKernelGradient();
+		get_inner_neighbor_with_skin_.storeKernelGradient();
+	}
+	//=================================================================================================//
+	Real BodyRelationInnerVerlet::maximumDisplacementSinceRebuild()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		return parallel_reduce(
+			blocked_range<size_t>(0, base_particles_->total_real_particles_), Real(0),
+			[&](const blocked_range<size_t> &r, Real temp) -> Real
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					temp = SMAX(temp, (pos_n[num] - pos_at_rebuild_[num]).norm());
+				}
+				return temp;
+			},
+			[](Real x, Real y) -> Real
+			{ return SMAX(x, y); });
+	}
+	//=================================================================================================//
+	void BodyRelationInnerVerlet::rebuildConfiguration()
+	{
+		resetNeighborhoodCurrentSize();
+		cell_linked_list_
+			->searchNeighborsByParticles(base_particles_->total_real_particles_,
+										 *base_particles_, inner_configuration_,
+										 get_particle_index_, get_skin_search_depth_,
+										 get_inner_neighbor_with_skin_);
+		pos_at_rebuild_.assign(base_particles_->pos_n_.begin(),
+							   base_particles_->pos_n_.begin() + base_particles_->total_real_particles_);
+		configuration_built_ = true;
+	}
+	//=================================================================================================//
+	bool BodyRelationInnerVerlet::rebuildDue()
+	{
+		return !configuration_built_ || maximumDisplacementSinceRebuild() > 0.5 * skin_distance_;
+	}
+	//=================================================================================================//
+	void BodyRelationInnerVerlet::updateConfiguration()
+	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
+		if (rebuildDue())
+		{
+			rebuildConfiguration();
+		}
+		updateCompactConfiguration();
+	}
+	//=================================================================================================//
+	void BodyRelationInnerVerlet::writeConfigurationToBuffer(std::string &buffer)
+	{
+		BaseBodyRelationInner::writeConfigurationToBuffer(buffer);
+		uint64_t position_count = pos_at_rebuild_.size();
+		appendBytesToBuffer(buffer, &position_count, sizeof(position_count));
+		appendBytesToBuffer(buffer, pos_at_rebuild_.data(), position_count * sizeof(Vecd));
+	}
+	//=================================================================================================//
+	bool BodyRelationInnerVerlet::readConfigurationFromBuffer(const char *&current, const char *end)
+	{
+		if (!BaseBodyRelationInner::readConfigurationFromBuffer(current, end))
+			return false;
+		uint64_t position_count = 0;
+		if (!readBytesFromBuffer(current, end, &position_count, sizeof(position_count)))
+			return false;
+		pos_at_rebuild_.resize(position_count);
+		if (!readBytesFromBuffer(current, end, pos_at_rebuild_.data(), position_count * sizeof(Vecd)))
+			return false;
+		configuration_built_ = true;
+		return true;
 	}
 	//=================================================================================================//
 	BodyRelationInnerVariableSmoothingLength::
 		BodyRelationInnerVariableSmoothingLength(RealBody &real_body)
 		: BaseBodyRelationInner(real_body), total_levels_(0),
-		  get_inner_neighbor_variable_smoothing_length_(&real_body)
+		  get_inner_neighbor_variable_smoothing_length_(&real_body),
+		  multi_level_cell_linked_list_(nullptr), use_level_resolved_search_(false)
 	{
-		MultilevelCellLinkedList *multi_level_cell_linked_list =
+		multi_level_cell_linked_list_ =
 			DynamicCast<MultilevelCellLinkedList>(this, real_body.cell_linked_list_);
-		cell_linked_list_levels_ = multi_level_cell_linked_list->getMeshLevels();
+		cell_linked_list_levels_ = multi_level_cell_linked_list_->getMeshLevels();
 		total_levels_ = cell_linked_list_levels_.size();
 		for (size_t l = 0; l != total_levels_; ++l)
 		{
@@ -77,7 +547,16 @@ namespace SPH
 	//=================================================================================================//
 	void BodyRelationInnerVariableSmoothingLength::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
 		resetNeighborhoodCurrentSize();
+		// the buckets exist only after the first cell list update
+		if (use_level_resolved_search_ &&
+			multi_level_cell_linked_list_->getLevelParticleBuckets().size() == total_levels_)
+		{
+			updateConfigurationLevelResolved();
+			return;
+		}
 		for (size_t l = 0; l != total_levels_; ++l)
 		{
 			cell_linked_list_levels_[l]
@@ -88,6 +567,42 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void BodyRelationInnerVariableSmoothingLength::updateConfigurationLevelResolved()
+	{
+		StdVec<IndexVector> &level_particle_buckets =
+			multi_level_cell_linked_list_->getLevelParticleBuckets();
+		for (size_t target_level = 0; target_level != total_levels_; ++target_level)
+			for (size_t source_level = 0; source_level != total_levels_; ++source_level)
+			{
+				IndexVector &bucket = level_particle_buckets[source_level];
+				if (bucket.empty())
+					continue;
+				BodyPartParticlesIndex get_bucket_particle_index(bucket);
+				SearchDepthFixed get_search_depth(level_pair_search_depths_[source_level][target_level]);
+				cell_linked_list_levels_[target_level]
+					->searchNeighborsByParticles(bucket.size(), *base_particles_, inner_configuration_,
+												 get_bucket_particle_index, get_search_depth,
+												 get_inner_neighbor_variable_smoothing_length_);
+			}
+	}
+	//=================================================================================================//
+	void BodyRelationInnerVariableSmoothingLength::useLevelResolvedSearch()
+	{
+		use_level_resolved_search_ = true;
+		level_pair_search_depths_.resize(total_levels_);
+		for (size_t source_level = 0; source_level != total_levels_; ++source_level)
+		{
+			level_pair_search_depths_[source_level].resize(total_levels_);
+			// the grid spacing of a level bounds the cutoff radius of its particles
+			Real cutoff_bound = cell_linked_list_levels_[source_level]->GridSpacing();
+			for (size_t target_level = 0; target_level != total_levels_; ++target_level)
+			{
+				level_pair_search_depths_[source_level][target_level] =
+					1 + (int)floor(cutoff_bound / cell_linked_list_levels_[target_level]->GridSpacing());
+			}
+		}
+	}
+	//=================================================================================================//
 	SolidBodyRelationSelfContact::
 		SolidBodyRelationSelfContact(RealBody &real_body)
 		: BaseBodyRelationInner(real_body),
@@ -95,7 +610,16 @@ namespace SPH
 		  body_part_particles_(body_surface_layer_.body_part_particles_),
 		  get_body_part_particle_index_(body_part_particles_),
 		  get_self_contact_neighbor_(&real_body),
-		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)) {}
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)),
+		  use_bvh_contact_search_(false), surface_bvh_(nullptr) {}
+	//=================================================================================================//
+	void SolidBodyRelationSelfContact::useBVHContactSearch()
+	{
+		use_bvh_contact_search_ = true;
+		surface_bvh_ = surface_bvh_keeper_.createPtr<ParticleBVH>(
+			base_particles_->pos_n_, body_part_particles_);
+		surface_bvh_->buildStructure();
+	}
 	//=================================================================================================//
 	void SolidBodyRelationSelfContact::resetNeighborhoodCurrentSize()
 	{
@@ -114,7 +638,34 @@ namespace SPH
 	//=================================================================================================//
 	void SolidBodyRelationSelfContact::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
 		resetNeighborhoodCurrentSize();
+		if (use_bvh_contact_search_)
+		{
+			surface_bvh_->refitBounds();
+			StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+			Real search_radius = sph_body_->sph_adaptation_->getKernel()->CutOffRadius();
+			parallel_for(
+				blocked_range<size_t>(0, body_part_particles_.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t num = r.begin(); num != r.end(); ++num)
+					{
+						size_t index_i = get_body_part_particle_index_(num);
+						Neighborhood &neighborhood = inner_configuration_[index_i];
+						surface_bvh_->queryNeighbors(
+							pos_n[index_i], search_radius,
+							[&](size_t index_j)
+							{
+								Vecd displacement = pos_n[index_i] - pos_n[index_j];
+								get_self_contact_neighbor_(neighborhood, displacement, index_i, index_j);
+							});
+					}
+				},
+				ap);
+			return;
+		}
 		size_t total_real_particles = body_part_particles_.size();
 		cell_linked_list_
 			->searchNeighborsByParticles(total_real_particles,
@@ -124,14 +675,17 @@ namespace SPH
 	}
 	//=================================================================================================//
 	BaseBodyRelationContact::BaseBodyRelationContact(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
-		: SPHBodyRelation(sph_body), contact_bodies_(contact_sph_bodies)
+		: SPHBodyRelation(sph_body), contact_pairing_built_(false),
+		  use_dynamic_contact_memory_(false), use_cached_stencils_(false),
+		  contact_bodies_(contact_sph_bodies)
 	{
 		subscribeToBody();
 		updateConfigurationMemories();
 	}
 	//=================================================================================================//
 	BaseBodyRelationContact::BaseBodyRelationContact(SPHBody &sph_body, BodyPartVector contact_body_parts)
-		: SPHBodyRelation(sph_body)
+		: SPHBodyRelation(sph_body), contact_pairing_built_(false), use_dynamic_contact_memory_(false),
+		  use_cached_stencils_(false)
 	{
 		for (size_t k = 0; k != contact_body_parts.size(); ++k)
 		{
@@ -145,16 +699,103 @@ namespace SPH
 	{
 		size_t updated_size = sph_body_->base_particles_->real_particles_bound_;
 		contact_configuration_.resize(contact_bodies_.size());
+		contact_pair_active_.resize(contact_bodies_.size(), 1);
+		cached_stencil_valid_.resize(contact_bodies_.size(), 0);
+		cached_stencil_versions_.resize(contact_bodies_.size(), MaxSize_t);
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
+			// the storage of a separated pair is only allocated back
+			// when the bodies come within interaction range again
+			if (use_dynamic_contact_memory_ && !contact_pair_active_[k])
+				continue;
 			contact_configuration_[k].resize(updated_size, Neighborhood());
 		}
 	}
 	//=================================================================================================//
+	void BaseBodyRelationContact::releaseContactPairStorage(size_t contact_index)
+	{
+		contact_pair_active_[contact_index] = 0;
+		ParticleConfiguration().swap(contact_configuration_[contact_index]);
+	}
+	//=================================================================================================//
+	void BaseBodyRelationContact::allocateContactPairStorage(size_t contact_index)
+	{
+		contact_pair_active_[contact_index] = 1;
+		contact_configuration_[contact_index]
+			.resize(sph_body_->base_particles_->real_particles_bound_, Neighborhood());
+	}
+	//=================================================================================================//
+	size_t BaseBodyRelationContact::MemoryFootprint()
+	{
+		size_t footprint_in_bytes = 0;
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+		{
+			footprint_in_bytes += contact_configuration_[k].capacity() * sizeof(Neighborhood);
+			for (size_t num = 0; num != contact_configuration_[k].size(); ++num)
+				footprint_in_bytes += contact_configuration_[k][num].MemoryFootprint();
+		}
+		return footprint_in_bytes;
+	}
+	//=================================================================================================//
+	void BaseBodyRelationContact::writeConfigurationToBuffer(std::string &buffer)
+	{
+		uint64_t contact_count = contact_configuration_.size();
+		appendBytesToBuffer(buffer, &contact_count, sizeof(contact_count));
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+		{
+			// a released pair of the dynamic contact memory records only its flag
+			uint8_t pair_active = k < contact_pair_active_.size() ? uint8_t(contact_pair_active_[k]) : uint8_t(1);
+			appendBytesToBuffer(buffer, &pair_active, sizeof(pair_active));
+			if (pair_active)
+				appendParticleConfigurationToBuffer(buffer, contact_configuration_[k],
+													total_real_particles, true, false);
+		}
+	}
+	//=================================================================================================//
+	bool BaseBodyRelationContact::readConfigurationFromBuffer(const char *&current, const char *end)
+	{
+		updateConfigurationMemories();
+		uint64_t contact_count = 0;
+		if (!readBytesFromBuffer(current, end, &contact_count, sizeof(contact_count)) ||
+			contact_count != contact_configuration_.size())
+			return false;
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		for (size_t k = 0; k != contact_configuration_.size(); ++k)
+		{
+			uint8_t pair_active = 1;
+			if (!readBytesFromBuffer(current, end, &pair_active, sizeof(pair_active)))
+				return false;
+			if (!pair_active)
+			{
+				if (use_dynamic_contact_memory_)
+					releaseContactPairStorage(k);
+				continue;
+			}
+			if (!readParticleConfigurationFromBuffer(current, end, contact_configuration_[k],
+													 total_real_particles, true, false))
+				return false;
+		}
+		contact_pairing_built_ = true;
+		markConfigurationUpdated();
+		return true;
+	}
+	//=================================================================================================//
+	bool BaseBodyRelationContact::frozenContactPairing(size_t contact_index)
+	{
+		return contact_pairing_built_ && sph_body_->isStatic() && contact_bodies_[contact_index]->isStatic();
+	}
+	//=================================================================================================//
 	void BaseBodyRelationContact::resetNeighborhoodCurrentSize()
 	{
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
+			if (frozenContactPairing(k))
+				continue;
+			if (use_dynamic_contact_memory_ && !contact_pair_active_[k])
+				continue;
+			if (use_cached_stencils_ && cached_stencil_valid_[k])
+				continue;
 			parallel_for(
 				blocked_range<size_t>(0, base_particles_->total_real_particles_),
 				[&](const blocked_range<size_t> &r)
@@ -182,6 +823,7 @@ namespace SPH
 	//=================================================================================================//
 	void BodyRelationContact::initialization()
 	{
+		use_bounds_pruning_ = false;
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
 			CellLinkedList *target_cell_linked_list =
@@ -194,25 +836,225 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	namespace
+	{
+		/** axis-aligned bounds of the real particles of a body */
+		BoundingBox particleBounds(BaseParticles *particles)
+		{
+			StdLargeVec<Vecd> &pos_n = particles->pos_n_;
+			BoundingBox initial_bounds(Vecd(Infinity), Vecd(-Infinity));
+			return parallel_reduce(
+				blocked_range<size_t>(0, particles->total_real_particles_), initial_bounds,
+				[&](const blocked_range<size_t> &r, BoundingBox temp) -> BoundingBox
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						for (int d = 0; d != temp.first.size(); ++d)
+						{
+							temp.first[d] = SMIN(temp.first[d], pos_n[i][d]);
+							temp.second[d] = SMAX(temp.second[d], pos_n[i][d]);
+						}
+					}
+					return temp;
+				},
+				[](BoundingBox x, BoundingBox y) -> BoundingBox
+				{
+					for (int d = 0; d != x.first.size(); ++d)
+					{
+						x.first[d] = SMIN(x.first[d], y.first[d]);
+						x.second[d] = SMAX(x.second[d], y.second[d]);
+					}
+					return x;
+				});
+		}
+
+		/** the same bounds over a listed subset of the particles */
+		BoundingBox particleBounds(BaseParticles *particles, const IndexVector &particle_indexes)
+		{
+			StdLargeVec<Vecd> &pos_n = particles->pos_n_;
+			BoundingBox initial_bounds(Vecd(Infinity), Vecd(-Infinity));
+			return parallel_reduce(
+				blocked_range<size_t>(0, particle_indexes.size()), initial_bounds,
+				[&](const blocked_range<size_t> &r, BoundingBox temp) -> BoundingBox
+				{
+					for (size_t num = r.begin(); num != r.end(); ++num)
+					{
+						Vecd &position = pos_n[particle_indexes[num]];
+						for (int d = 0; d != temp.first.size(); ++d)
+						{
+							temp.first[d] = SMIN(temp.first[d], position[d]);
+							temp.second[d] = SMAX(temp.second[d], position[d]);
+						}
+					}
+					return temp;
+				},
+				[](BoundingBox x, BoundingBox y) -> BoundingBox
+				{
+					for (int d = 0; d != x.first.size(); ++d)
+					{
+						x.first[d] = SMIN(x.first[d], y.first[d]);
+						x.second[d] = SMAX(x.second[d], y.second[d]);
+					}
+					return x;
+				});
+		}
+	}
+	//=================================================================================================//
+	BoundingBox BodyRelationContact::contactBodyBounds(size_t contact_index)
+	{
+		return particleBounds(contact_bodies_[contact_index]->base_particles_);
+	}
+	//=================================================================================================//
+	bool BodyRelationContact::checkContactPairProximity(size_t contact_index)
+	{
+		BoundingBox source_bounds = particleBounds(base_particles_);
+		BoundingBox contact_bounds = contactBodyBounds(contact_index);
+		// the kernel support is covered by search_depth cells on the target mesh,
+		// so bounds separated beyond this margin can not produce any contact pair
+		Real support_radius = Real(get_search_depths_[contact_index]->search_depth_) *
+							  target_cell_linked_lists_[contact_index]->GridSpacing();
+		for (int d = 0; d != source_bounds.first.size(); ++d)
+		{
+			if (source_bounds.second[d] + support_radius < contact_bounds.first[d] ||
+				contact_bounds.second[d] + support_radius < source_bounds.first[d])
+				return false;
+		}
+		return true;
+	}
+	//=================================================================================================//
+	void BodyRelationContact::revalidateCachedStencils()
+	{
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			size_t update_version = target_cell_linked_lists_[k]->UpdateVersion();
+			cached_stencil_valid_[k] = cached_stencil_versions_[k] == update_version ? 1 : 0;
+			cached_stencil_versions_[k] = update_version;
+		}
+	}
+	//=================================================================================================//
 	void BodyRelationContact::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
+		if (use_cached_stencils_)
+			revalidateCachedStencils();
 		resetNeighborhoodCurrentSize();
 		size_t total_real_particles = base_particles_->total_real_particles_;
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
+			if (frozenContactPairing(k))
+				continue;
+
+			if (use_cached_stencils_ && cached_stencil_valid_[k])
+				continue;
+
+			if (use_dynamic_contact_memory_)
+			{
+				if (!checkContactPairProximity(k))
+				{
+					if (contact_pair_active_[k])
+						releaseContactPairStorage(k);
+					continue;
+				}
+				if (!contact_pair_active_[k])
+					allocateContactPairStorage(k);
+			}
+
+			if (use_bounds_pruning_)
+			{
+				BoundingBox search_bounds = contactBodyBounds(k);
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(total_real_particles,
+												 *base_particles_, contact_configuration_[k],
+												 get_particle_index_, *get_search_depths_[k],
+												 *get_contact_neighbors_[k], search_bounds);
+				continue;
+			}
+
 			target_cell_linked_lists_[k]
 				->searchNeighborsByParticles(total_real_particles,
 											 *base_particles_, contact_configuration_[k],
 											 get_particle_index_, *get_search_depths_[k],
 											 *get_contact_neighbors_[k]);
 		}
+		contact_pairing_built_ = true;
+	}
+	//=================================================================================================//
+	template <class KernelType>
+	BodyRelationContactKnownKernel<KernelType>::
+		BodyRelationContactKnownKernel(SPHBody &sph_body, RealBodyVector contact_bodies)
+		: BodyRelationContact(sph_body, contact_bodies)
+	{
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			get_known_kernel_contact_neighbors_.push_back(
+				known_kernel_contact_ptr_vector_keeper_
+					.template createPtr<NeighborRelationContactKnownKernel<KernelType>>(sph_body_, contact_bodies_[k]));
+		}
+	}
+	//=================================================================================================//
+	template <class KernelType>
+	void BodyRelationContactKnownKernel<KernelType>::updateConfiguration()
+	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
+		if (use_cached_stencils_)
+			revalidateCachedStencils();
+		resetNeighborhoodCurrentSize();
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			if (frozenContactPairing(k))
+				continue;
+
+			if (use_cached_stencils_ && cached_stencil_valid_[k])
+				continue;
+
+			if (use_dynamic_contact_memory_)
+			{
+				if (!checkContactPairProximity(k))
+				{
+					if (contact_pair_active_[k])
+						releaseContactPairStorage(k);
+					continue;
+				}
+				if (!contact_pair_active_[k])
+					allocateContactPairStorage(k);
+			}
+
+			if (use_bounds_pruning_)
+			{
+				BoundingBox search_bounds = contactBodyBounds(k);
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(total_real_particles,
+												 *base_particles_, contact_configuration_[k],
+												 get_particle_index_, *get_search_depths_[k],
+												 *get_known_kernel_contact_neighbors_[k], search_bounds);
+				continue;
+			}
+
+			target_cell_linked_lists_[k]
+				->searchNeighborsByParticles(total_real_particles,
+											 *base_particles_, contact_configuration_[k],
+											 get_particle_index_, *get_search_depths_[k],
+											 *get_known_kernel_contact_neighbors_[k]);
+		}
+		contact_pairing_built_ = true;
 	}
 	//=================================================================================================//
+	template class BodyRelationContactKnownKernel<KernelWendlandC2>;
+	template class BodyRelationContactKnownKernel<KernelCubicBSpline>;
+	template class BodyRelationContactKnownKernel<KernelHyperbolic>;
+	template class BodyRelationContactKnownKernel<KernelQuadratic>;
+	template class BodyRelationContactKnownKernel<KernelLaguerreGauss>;
+	template class BodyRelationContactKnownKernel<KernelTabulatedRuntime>;
+	//=================================================================================================//
 	SolidBodyRelationContact::SolidBodyRelationContact(SPHBody &sph_body, RealBodyVector contact_bodies)
 		: BaseBodyRelationContact(sph_body, contact_bodies),
 		  body_surface_layer_(shape_surface_ptr_keeper_.createPtr<BodySurfaceLayer>(sph_body)),
 		  body_part_particles_(body_surface_layer_->body_part_particles_),
-		  get_body_part_particle_index_(body_part_particles_)
+		  get_body_part_particle_index_(body_part_particles_),
+		  use_bvh_contact_search_(false)
 	{
 		initialization();
 	}
@@ -223,11 +1065,30 @@ namespace SPH
 		: BaseBodyRelationContact(*solid_body_relation_self_contact.real_body_, contact_bodies),
 		  body_surface_layer_(&solid_body_relation_self_contact.body_surface_layer_),
 		  body_part_particles_(body_surface_layer_->body_part_particles_),
-		  get_body_part_particle_index_(body_part_particles_)
+		  get_body_part_particle_index_(body_part_particles_),
+		  use_bvh_contact_search_(false)
 	{
 		initialization();
 	}
 	//=================================================================================================//
+	void SolidBodyRelationContact::useBVHContactSearch()
+	{
+		use_bvh_contact_search_ = true;
+		contact_candidate_particles_.resize(contact_bodies_.size());
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			BaseParticles *contact_particles = contact_bodies_[k]->base_particles_;
+			IndexVector &candidate_particles = contact_candidate_particles_[k];
+			candidate_particles.resize(contact_particles->total_real_particles_);
+			for (size_t i = 0; i != candidate_particles.size(); ++i)
+				candidate_particles[i] = i;
+			contact_bvhs_.push_back(
+				contact_bvh_ptr_vector_keeper_.createPtr<ParticleBVH>(
+					contact_particles->pos_n_, candidate_particles));
+			contact_bvhs_.back()->buildStructure();
+		}
+	}
+	//=================================================================================================//
 	void SolidBodyRelationContact::resetNeighborhoodCurrentSize()
 	{
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
@@ -260,22 +1121,257 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void SolidBodyRelationContact::searchContactBodyNeighbors(size_t contact_index)
+	{
+		target_cell_linked_lists_[contact_index]
+			->searchNeighborsByParticles(body_part_particles_.size(),
+										 *base_particles_, contact_configuration_[contact_index],
+										 get_body_part_particle_index_, *get_search_depths_[contact_index],
+										 *get_contact_neighbors_[contact_index]);
+	}
+	//=================================================================================================//
+	void SolidBodyRelationContact::
+		searchContactBodyNeighbors(size_t contact_index, const BoundingBox &search_bounds)
+	{
+		target_cell_linked_lists_[contact_index]
+			->searchNeighborsByParticles(body_part_particles_.size(),
+										 *base_particles_, contact_configuration_[contact_index],
+										 get_body_part_particle_index_, *get_search_depths_[contact_index],
+										 *get_contact_neighbors_[contact_index], search_bounds);
+	}
+	//=================================================================================================//
+	void SolidBodyRelationContact::searchContactBodyNeighborsByBVH(size_t contact_index)
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		contact_bvhs_[contact_index]->refitBounds();
+		StdLargeVec<Vecd> &contact_pos_n = contact_bodies_[contact_index]->base_particles_->pos_n_;
+		NeighborRelationContact &get_contact_neighbor = *get_contact_neighbors_[contact_index];
+		SearchDepthMultiResolution &get_search_depth = *get_search_depths_[contact_index];
+		Real target_grid_spacing = target_cell_linked_lists_[contact_index]->GridSpacing();
+		parallel_for(
+			blocked_range<size_t>(0, body_part_particles_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					size_t index_i = get_body_part_particle_index_(num);
+					Neighborhood &neighborhood = contact_configuration_[contact_index][index_i];
+					// the same support as covered by the cell search depth
+					Real search_radius = Real(get_search_depth(index_i)) * target_grid_spacing;
+					contact_bvhs_[contact_index]->queryNeighbors(
+						pos_n[index_i], search_radius,
+						[&](size_t index_j)
+						{
+							Vecd displacement = pos_n[index_i] - contact_pos_n[index_j];
+							get_contact_neighbor(neighborhood, displacement, index_i, index_j);
+						});
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
 	void SolidBodyRelationContact::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
 		resetNeighborhoodCurrentSize();
-		size_t total_real_particles = body_part_particles_.size();
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
-			target_cell_linked_lists_[k]
-				->searchNeighborsByParticles(total_real_particles,
-											 *base_particles_, contact_configuration_[k],
-											 get_body_part_particle_index_, *get_search_depths_[k],
-											 *get_contact_neighbors_[k]);
+			use_bvh_contact_search_
+				? searchContactBodyNeighborsByBVH(k)
+				: searchContactBodyNeighbors(k);
+		}
+	}
+	//=================================================================================================//
+	void SolidBodyRelationContact::
+		updateConfigurationForCandidates(const StdVec<int> &contact_is_candidate,
+										 const StdVec<BoundingBox> &search_bounds)
+	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
+		resetNeighborhoodCurrentSize();
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			if (!contact_is_candidate[k])
+				continue;
+			use_bvh_contact_search_
+				? searchContactBodyNeighborsByBVH(k)
+				: searchContactBodyNeighbors(k, search_bounds[k]);
+		}
+	}
+	//=================================================================================================//
+	size_t SolidContactBroadphase::findBodyOccupancy(SPHBody *body, IndexVector *surface_particles)
+	{
+		// the surface layers of a body hold the same particles, so the relations
+		// owning separate layer objects of one body share a single record
+		for (size_t n = 0; n != body_occupancies_.size(); ++n)
+		{
+			if (body_occupancies_[n].body_ == body &&
+				(body_occupancies_[n].surface_particles_ == nullptr) == (surface_particles == nullptr))
+				return n;
+		}
+		BodyOccupancy body_occupancy;
+		body_occupancy.body_ = body;
+		body_occupancy.surface_particles_ = surface_particles;
+		body_occupancies_.push_back(body_occupancy);
+		return body_occupancies_.size() - 1;
+	}
+	//=================================================================================================//
+	void SolidContactBroadphase::
+		buildSharedCoarseGrid(const BoundingBox &union_bounds, Real reference_cutoff_radius)
+	{
+		// the occupancy spread by one cell must cover the largest contact search
+		// radius; the resolution is halved until the grid stays moderate in size
+		size_t maximum_coarse_cells = 262144;
+		Real coarse_cell_size = 2.0 * reference_cutoff_radius;
+		while (true)
+		{
+			coarse_mesh_ = BaseMesh(union_bounds, coarse_cell_size, 1);
+			number_of_coarse_cells_ =
+				coarse_mesh_.NumberOfCellsFromNumberOfGridPoints(coarse_mesh_.NumberOfGridPoints());
+			total_coarse_cells_ = 1;
+			for (int d = 0; d != Dimensions; ++d)
+				total_coarse_cells_ *= number_of_coarse_cells_[d];
+			if (total_coarse_cells_ <= maximum_coarse_cells)
+				break;
+			coarse_cell_size *= 2.0;
+		}
+		cell_marks_.assign(total_coarse_cells_, 0);
+	}
+	//=================================================================================================//
+	void SolidContactBroadphase::rasterizeBodyOccupancy(BodyOccupancy &body_occupancy)
+	{
+		BaseParticles *particles = body_occupancy.body_->base_particles_;
+		StdLargeVec<Vecd> &pos_n = particles->pos_n_;
+		IndexVector *surface_particles = body_occupancy.surface_particles_;
+		IndexVector &occupied_cells = body_occupancy.occupied_cells_;
+		occupied_cells.clear();
+		size_t number_of_particles = surface_particles == nullptr
+										 ? particles->total_real_particles_
+										 : surface_particles->size();
+		for (size_t num = 0; num != number_of_particles; ++num)
+		{
+			size_t index_i = surface_particles == nullptr ? num : (*surface_particles)[num];
+			size_t cell_index = coarse_mesh_.transferMeshIndexTo1D(
+				number_of_coarse_cells_, coarse_mesh_.CellIndexFromPosition(pos_n[index_i]));
+			if (!cell_marks_[cell_index])
+			{
+				cell_marks_[cell_index] = 1;
+				occupied_cells.push_back(cell_index);
+			}
+		}
+		// spread the occupancy to the neighboring cells, clearing the scratch marks
+		body_occupancy.spread_occupancy_.assign(total_coarse_cells_, 0);
+		size_t number_of_neighbor_offsets = powerN(3, Dimensions);
+		for (size_t n = 0; n != occupied_cells.size(); ++n)
+		{
+			Vecu cell_index = coarse_mesh_.transfer1DtoMeshIndex(number_of_coarse_cells_, occupied_cells[n]);
+			for (size_t offset = 0; offset != number_of_neighbor_offsets; ++offset)
+			{
+				Vecu neighbor_index(0);
+				bool within_grid = true;
+				size_t remainder = offset;
+				for (int d = 0; d != Dimensions; ++d)
+				{
+					int shifted_index = int(cell_index[d]) + int(remainder % 3) - 1;
+					remainder /= 3;
+					if (shifted_index < 0 || shifted_index >= int(number_of_coarse_cells_[d]))
+					{
+						within_grid = false;
+						break;
+					}
+					neighbor_index[d] = size_t(shifted_index);
+				}
+				if (within_grid)
+					body_occupancy.spread_occupancy_[coarse_mesh_.transferMeshIndexTo1D(
+						number_of_coarse_cells_, neighbor_index)] = 1;
+			}
+			cell_marks_[occupied_cells[n]] = 0;
+		}
+	}
+	//=================================================================================================//
+	bool SolidContactBroadphase::checkOccupancyOverlap(BodyOccupancy &source, BodyOccupancy &target)
+	{
+		IndexVector &target_occupied_cells = target.occupied_cells_;
+		for (size_t n = 0; n != target_occupied_cells.size(); ++n)
+		{
+			if (source.spread_occupancy_[target_occupied_cells[n]])
+				return true;
+		}
+		return false;
+	}
+	//=================================================================================================//
+	void SolidContactBroadphase::
+		updateConfigurations(const StdVec<SolidBodyRelationContact *> &contact_relations)
+	{
+		if (contact_relations.empty())
+			return;
+
+		// the record of every body taking part in one of the relations,
+		// the source bodies represented by their contact surface layers
+		StdVec<size_t> source_records(contact_relations.size());
+		StdVec<IndexVector> target_records(contact_relations.size());
+		for (size_t n = 0; n != contact_relations.size(); ++n)
+		{
+			SolidBodyRelationContact *relation = contact_relations[n];
+			source_records[n] = findBodyOccupancy(
+				relation->sph_body_, &relation->body_surface_layer_->body_part_particles_);
+			for (size_t k = 0; k != relation->contact_bodies_.size(); ++k)
+				target_records[n].push_back(findBodyOccupancy(relation->contact_bodies_[k], nullptr));
+		}
+
+		// one pass over the bodies: current bounds and shared-grid occupancies
+		Real reference_cutoff_radius = 0.0;
+		BoundingBox union_bounds(Vecd(Infinity), Vecd(-Infinity));
+		for (size_t n = 0; n != body_occupancies_.size(); ++n)
+		{
+			BodyOccupancy &body_occupancy = body_occupancies_[n];
+			reference_cutoff_radius = SMAX(
+				reference_cutoff_radius,
+				body_occupancy.body_->sph_adaptation_->getKernel()->CutOffRadius());
+			BaseParticles *particles = body_occupancy.body_->base_particles_;
+			body_occupancy.bounds_ = body_occupancy.surface_particles_ == nullptr
+										 ? particleBounds(particles)
+										 : particleBounds(particles, *body_occupancy.surface_particles_);
+			for (int d = 0; d != union_bounds.first.size(); ++d)
+			{
+				union_bounds.first[d] = SMIN(union_bounds.first[d], body_occupancy.bounds_.first[d]);
+				union_bounds.second[d] = SMAX(union_bounds.second[d], body_occupancy.bounds_.second[d]);
+			}
+		}
+		buildSharedCoarseGrid(union_bounds, reference_cutoff_radius);
+		for (size_t n = 0; n != body_occupancies_.size(); ++n)
+			rasterizeBodyOccupancy(body_occupancies_[n]);
+
+		// the candidate narrowphase updates of the relations
+		for (size_t n = 0; n != contact_relations.size(); ++n)
+		{
+			BodyOccupancy &source = body_occupancies_[source_records[n]];
+			size_t number_of_contacts = target_records[n].size();
+			StdVec<int> contact_is_candidate(number_of_contacts);
+			StdVec<BoundingBox> search_bounds(number_of_contacts);
+			for (size_t k = 0; k != number_of_contacts; ++k)
+			{
+				BodyOccupancy &target = body_occupancies_[target_records[n][k]];
+				contact_is_candidate[k] = checkOccupancyOverlap(source, target) ? 1 : 0;
+				// the bounds overlap of the pair; the bounded search itself adds
+				// the kernel support of the surface particles as margin
+				BoundingBox overlap_bounds = source.bounds_;
+				for (int d = 0; d != overlap_bounds.first.size(); ++d)
+				{
+					overlap_bounds.first[d] = SMAX(overlap_bounds.first[d], target.bounds_.first[d]);
+					overlap_bounds.second[d] = SMIN(overlap_bounds.second[d], target.bounds_.second[d]);
+				}
+				search_bounds[k] = overlap_bounds;
+			}
+			contact_relations[n]->updateConfigurationForCandidates(contact_is_candidate, search_bounds);
 		}
 	}
 	//=================================================================================================//
 	void TreeBodyRelationInner::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
 		generative_tree_.buildParticleConfiguration(inner_configuration_);
 	}
 	//=================================================================================================//
@@ -286,17 +1382,78 @@ namespace SPH
 	{
 	}
 	//=================================================================================================//
+	void BodyPartRelationContact::resetNeighborhoodCurrentSize()
+	{
+		// only the neighborhoods of the part particles are ever filled,
+		// so only those need to be reset
+		for (size_t k = 0; k != contact_bodies_.size(); ++k)
+		{
+			if (frozenContactPairing(k))
+				continue;
+			if (use_dynamic_contact_memory_ && !contact_pair_active_[k])
+				continue;
+			if (use_cached_stencils_ && cached_stencil_valid_[k])
+				continue;
+			parallel_for(
+				blocked_range<size_t>(0, body_part_particles_.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t num = r.begin(); num != r.end(); ++num)
+					{
+						size_t index_i = get_body_part_particle_index_(num);
+						contact_configuration_[k][index_i].current_size_ = 0;
+					}
+				},
+				ap);
+		}
+	}
+	//=================================================================================================//
 	void BodyPartRelationContact::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
+		if (use_cached_stencils_)
+			revalidateCachedStencils();
+		resetNeighborhoodCurrentSize();
 		size_t number_of_particles = body_part_particles_.size();
 		for (size_t k = 0; k != contact_bodies_.size(); ++k)
 		{
+			if (frozenContactPairing(k))
+				continue;
+
+			if (use_cached_stencils_ && cached_stencil_valid_[k])
+				continue;
+
+			if (use_dynamic_contact_memory_)
+			{
+				if (!checkContactPairProximity(k))
+				{
+					if (contact_pair_active_[k])
+						releaseContactPairStorage(k);
+					continue;
+				}
+				if (!contact_pair_active_[k])
+					allocateContactPairStorage(k);
+			}
+
+			if (use_bounds_pruning_)
+			{
+				BoundingBox search_bounds = contactBodyBounds(k);
+				target_cell_linked_lists_[k]
+					->searchNeighborsByParticles(number_of_particles,
+												 *base_particles_, contact_configuration_[k],
+												 get_body_part_particle_index_, *get_search_depths_[k],
+												 *get_contact_neighbors_[k], search_bounds);
+				continue;
+			}
+
 			target_cell_linked_lists_[k]
 				->searchNeighborsByParticles(number_of_particles,
 											 *base_particles_, contact_configuration_[k],
 											 get_body_part_particle_index_, *get_search_depths_[k],
 											 *get_contact_neighbors_[k]);
 		}
+		contact_pairing_built_ = true;
 	}
 	//=================================================================================================//
 	BodyRelationContactToBodyPart::BodyRelationContactToBodyPart(RealBody &real_body, BodyPartVector contact_body_parts)
@@ -312,6 +1469,8 @@ namespace SPH
 	//=================================================================================================//
 	void BodyRelationContactToBodyPart::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		markConfigurationUpdated();
 		size_t number_of_particles = base_particles_->total_real_particles_;
 		for (size_t k = 0; k != contact_body_parts_.size(); ++k)
 		{
@@ -330,7 +1489,8 @@ namespace SPH
 		  contact_relation_(contact_relation),
 		  contact_bodies_(contact_relation_.contact_bodies_),
 		  inner_configuration_(inner_relation_.inner_configuration_),
-		  contact_configuration_(contact_relation_.contact_configuration_)
+		  contact_configuration_(contact_relation_.contact_configuration_),
+		  use_combined_update_(false), combined_inner_relation_(nullptr), combined_contact_relation_(nullptr)
 	{
 		updateConfigurationMemories();
 	}
@@ -342,7 +1502,8 @@ namespace SPH
 								.createRef<BodyRelationContact>(real_body, contact_bodies)),
 		  contact_bodies_(contact_relation_.contact_bodies_),
 		  inner_configuration_(inner_relation_.inner_configuration_),
-		  contact_configuration_(contact_relation_.contact_configuration_)
+		  contact_configuration_(contact_relation_.contact_configuration_),
+		  use_combined_update_(false), combined_inner_relation_(nullptr), combined_contact_relation_(nullptr)
 	{
 		updateConfigurationMemories();
 	}
@@ -355,7 +1516,8 @@ namespace SPH
 			  DynamicCast<RealBody>(this, *sph_body_), contact_bodies)),
 		  contact_bodies_(contact_relation_.contact_bodies_),
 		  inner_configuration_(inner_relation_.inner_configuration_),
-		  contact_configuration_(contact_relation_.contact_configuration_)
+		  contact_configuration_(contact_relation_.contact_configuration_),
+		  use_combined_update_(false), combined_inner_relation_(nullptr), combined_contact_relation_(nullptr)
 	{
 		updateConfigurationMemories();
 	}
@@ -367,11 +1529,27 @@ namespace SPH
 								.createRef<BodyRelationContactToBodyPart>(real_body, contact_body_parts)),
 		  contact_bodies_(contact_relation_.contact_bodies_),
 		  inner_configuration_(inner_relation_.inner_configuration_),
-		  contact_configuration_(contact_relation_.contact_configuration_)
+		  contact_configuration_(contact_relation_.contact_configuration_),
+		  use_combined_update_(false), combined_inner_relation_(nullptr), combined_contact_relation_(nullptr)
 	{
 		updateConfigurationMemories();
 	}
 	//=================================================================================================//
+	void ComplexBodyRelation::useCombinedConfigurationUpdate()
+	{
+		if (typeid(inner_relation_) != typeid(BodyRelationInner) ||
+			typeid(contact_relation_) != typeid(BodyRelationContact))
+		{
+			std::cout << "\n Error: the combined configuration update is only applicable "
+					  << "to the plain inner and contact relations!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		combined_inner_relation_ = DynamicCast<BodyRelationInner>(this, &inner_relation_);
+		combined_contact_relation_ = DynamicCast<BodyRelationContact>(this, &contact_relation_);
+		use_combined_update_ = true;
+	}
+	//=================================================================================================//
 	void ComplexBodyRelation::updateConfigurationMemories()
 	{
 		inner_relation_.updateConfigurationMemories();
@@ -380,8 +1558,87 @@ namespace SPH
 	//=================================================================================================//
 	void ComplexBodyRelation::updateConfiguration()
 	{
+		TraceEventScope trace_scope(typeid(*this), "configuration", sph_body_->getBodyName());
+		if (use_combined_update_)
+		{
+			updateCombinedConfiguration();
+			return;
+		}
 		inner_relation_.updateConfiguration();
 		contact_relation_.updateConfiguration();
 	}
 	//=================================================================================================//
+	void ComplexBodyRelation::updateCombinedConfiguration()
+	{
+		BodyRelationInner *inner_relation = combined_inner_relation_;
+		BodyRelationContact *contact_relation = combined_contact_relation_;
+
+		bool update_inner = !(inner_relation->use_frozen_configuration_ &&
+							  inner_relation->frozen_configuration_built_);
+		if (update_inner)
+		{
+			inner_relation->markConfigurationUpdated();
+			inner_relation->resetNeighborhoodCurrentSize();
+		}
+		contact_relation->markConfigurationUpdated();
+		contact_relation->resetNeighborhoodCurrentSize();
+
+		StdVec<size_t> active_contacts;
+		for (size_t k = 0; k != contact_relation->contact_bodies_.size(); ++k)
+		{
+			if (!contact_relation->frozenContactPairing(k))
+				active_contacts.push_back(k);
+		}
+
+		BaseParticles *base_particles = sph_body_->base_particles_;
+		StdLargeVec<Vecd> &pos_n = base_particles->pos_n_;
+		parallel_for(
+			blocked_range<size_t>(0, base_particles->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t num = r.begin(); num != r.end(); ++num)
+				{
+					size_t index_i = inner_relation->get_particle_index_(num);
+					Vecd &particle_position = pos_n[index_i];
+
+					if (update_inner)
+					{
+						int search_depth = inner_relation->get_single_search_depth_(index_i);
+						if (inner_relation->use_half_configuration_)
+						{
+							inner_relation->cell_linked_list_
+								->searchNeighborsForOneParticle(index_i, particle_position, search_depth,
+																inner_configuration_[index_i],
+																inner_relation->get_inner_neighbor_half_);
+						}
+						else
+						{
+							inner_relation->cell_linked_list_
+								->searchNeighborsForOneParticle(index_i, particle_position, search_depth,
+																inner_configuration_[index_i],
+																inner_relation->get_inner_neighbor_);
+						}
+					}
+
+					for (size_t n = 0; n != active_contacts.size(); ++n)
+					{
+						size_t k = active_contacts[n];
+						int search_depth = (*contact_relation->get_search_depths_[k])(index_i);
+						contact_relation->target_cell_linked_lists_[k]
+							->searchNeighborsForOneParticle(index_i, particle_position, search_depth,
+															contact_configuration_[k][index_i],
+															*contact_relation->get_contact_neighbors_[k]);
+					}
+				}
+			},
+			ap);
+
+		if (update_inner)
+		{
+			inner_relation->updateCompactConfiguration();
+			inner_relation->frozen_configuration_built_ = true;
+		}
+		contact_relation->contact_pairing_built_ = true;
+	}
+	//=================================================================================================//
 }
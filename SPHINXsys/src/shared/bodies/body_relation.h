@@ -34,6 +34,7 @@
 #include "complex_body.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
+#include "particle_bvh.h"
 #include "neighbor_relation.h"
 #include "base_geometry.h"
 
@@ -60,7 +61,21 @@ namespace SPH
 		int operator()(size_t particle_index) const { return 1; };
 	};
 
-	/** @brief a small functor for obtaining search depth across resolution 
+	/** a small functor for obtaining search depth for an enlarged cutoff radius */
+	struct SearchDepthWithSkin
+	{
+		int search_depth_;
+		SearchDepthWithSkin(SPHBody &sph_body, CellLinkedList *cell_linked_list, Real skin_distance)
+			: search_depth_(1)
+		{
+			Real inv_grid_spacing_ = 1.0 / cell_linked_list->GridSpacing();
+			Kernel *kernel_ = sph_body.sph_adaptation_->getKernel();
+			search_depth_ = 1 + (int)floor((kernel_->CutOffRadius() + skin_distance) * inv_grid_spacing_);
+		};
+		int operator()(size_t particle_index) const { return search_depth_; };
+	};
+
+	/** @brief a small functor for obtaining search depth across resolution
 	 * @details Note that the search depth is defined on the target cell linked list.
 	 */
 	struct SearchDepthMultiResolution
@@ -76,7 +91,18 @@ namespace SPH
 		int operator()(size_t particle_index) const { return search_depth_; };
 	};
 
-	/** @brief a small functor for obtaining search depth for variable smoothing length 
+	/** @brief a small functor returning a fixed search depth
+	 * @details used by the level-resolved multiresolution search,
+	 * where the depth on the target cell linked list is precomputed per level pair.
+	 */
+	struct SearchDepthFixed
+	{
+		int search_depth_;
+		explicit SearchDepthFixed(int search_depth) : search_depth_(search_depth){};
+		int operator()(size_t particle_index) const { return search_depth_; };
+	};
+
+	/** @brief a small functor for obtaining search depth for variable smoothing length
 	 * @details Note that the search depth is defined on the target cell linked list.
 	 */
 	struct SearchDepthVariableSmoothingLength
@@ -110,6 +136,27 @@ namespace SPH
 		void subscribeToBody() { sph_body_->body_relations_.push_back(this); };
 		virtual void updateConfigurationMemories() = 0;
 		virtual void updateConfiguration() = 0;
+		/** release over-allocated configuration memories, called on particle sorting. */
+		virtual void shrinkConfigurationMemories(){};
+		/** version counting the configuration rebuilds and particle sortings,
+		 * so that products derived from the configuration can be cached
+		 * and invalidated by comparing against it. */
+		size_t ConfigurationVersion() { return configuration_version_; };
+		void markConfigurationUpdated() { configuration_version_++; };
+		/** allocated bytes of the neighbor configuration storage,
+		 * for memory accounting. */
+		virtual size_t MemoryFootprint() { return 0; };
+		/** serialize the built neighbor configuration for the extended
+		 * restart checkpoints. Relations without support write nothing
+		 * and are rebuilt on resume instead. */
+		virtual void writeConfigurationToBuffer(std::string &buffer){};
+		/** restore the neighbor configuration from an extended restart
+		 * checkpoint, returning false when the recorded layout does not
+		 * match this relation. */
+		virtual bool readConfigurationFromBuffer(const char *&current, const char *end) { return false; };
+
+	protected:
+		size_t configuration_version_;
 	};
 
 	/**
@@ -119,16 +166,92 @@ namespace SPH
 	class BaseBodyRelationInner : public SPHBodyRelation
 	{
 	protected:
+		bool use_compact_configuration_;	/**< whether the compressed-sparse-row storage is maintained. */
+		bool use_neighborhood_arena_;		/**< whether the neighborhoods allocate from the chunked arena. */
+		bool use_size_forecasting_;			/**< whether the neighborhood sizes are forecast and pre-reserved. */
+		bool use_recomputed_pair_geometry_; /**< whether r_ij_ and e_ij_ are left out of the neighbor storage. */
+		bool use_kernel_gradient_;			/**< whether dW_ij_ * e_ij_ is precomputed into the neighbor storage. */
+		bool configuration_sealed_;			/**< whether the configuration is pinned to the sealed arena. */
+		NeighborhoodArena neighborhood_arena_;
+		StdLargeVec<size_t> neighbor_count_peaks_; /**< per-particle neighbor-count high-water marks with hysteresis. */
+
 		virtual void resetNeighborhoodCurrentSize();
+		/** pack the scattered neighborhoods into the flat arena after a configuration update. */
+		void updateCompactConfiguration();
 
 	public:
 		RealBody *real_body_;
 		ParticleConfiguration inner_configuration_; /**< inner configuration for the neighbor relations. */
+		CompactNeighborList inner_neighbor_list_;	/**< flat arena storage of the inner configuration. */
+		CompactParticleConfiguration compact_inner_configuration_; /**< per-particle views into the arena. */
 
 		explicit BaseBodyRelationInner(RealBody &real_body);
 		virtual ~BaseBodyRelationInner(){};
 
+		/** switch on the compressed-sparse-row storage mode. */
+		void useCompactConfiguration() { use_compact_configuration_ = true; };
+		bool usingCompactConfiguration() { return use_compact_configuration_; };
+		/** switch the flat storage to the fixed-stride (ELLPACK) layout: the
+		 * rows are padded with zero-weight self pairs to one common stride, a
+		 * multiple of eight, so that the interaction loops, e.g. the stress
+		 * relaxation and the deformation gradient summation of solids, sweep
+		 * equally long and equally spaced rows which vectorize across the
+		 * pair dimension. Worthwhile for near-uniform neighbor counts, as of
+		 * lattice-relaxed total-Lagrangian solids; when the padded fraction
+		 * of the entries would exceed the given limit, the packing falls
+		 * back to the compressed-sparse-row layout automatically. */
+		void useFixedStrideConfiguration(Real padding_waste_limit = 0.2)
+		{
+			use_compact_configuration_ = true;
+			inner_neighbor_list_.useFixedStride(padding_waste_limit);
+		};
+		/** switch to neighborhoods storing only the neighbor index and the
+		 * kernel weights. The pair distance and direction are recomputed from
+		 * the particle positions in the interaction loops through a
+		 * RecomputingNeighborhood view, trading a few operations per pair for
+		 * about 40% less neighbor memory. Only supported by the
+		 * constant-resolution inner relations. */
+		virtual void useRecomputedPairGeometry();
+		bool usingRecomputedPairGeometry() { return use_recomputed_pair_geometry_; };
+		/** switch to neighborhoods additionally storing the kernel gradient
+		 * vector dW_ij_ * e_ij_, precomputed at the configuration build. The
+		 * interaction passes consuming the built configuration, typically
+		 * several per build, then read the gradient directly instead of
+		 * forming the product per pair, trading build-time work and one more
+		 * stored vector per pair for lighter interaction loops. Only
+		 * supported by the constant-resolution inner relations. */
+		virtual void useKernelGradient();
+		bool usingKernelGradient() { return use_kernel_gradient_; };
+		/** let the neighborhoods chunk-allocate their storage from the
+		 * per-relation arena instead of the global allocator. */
+		void useNeighborhoodArena()
+		{
+			use_neighborhood_arena_ = true;
+			inner_configuration_.clear();
+			updateConfigurationMemories();
+		};
+		/** pre-reserve the neighborhoods from forecast neighbor counts,
+		 * so that the steady-state configuration build does not allocate. */
+		void useSizeForecasting()
+		{
+			use_size_forecasting_ = true;
+			updateConfigurationMemories();
+		};
+
+		/** seal the configuration after the initial build, for relations built
+		 * exactly once from the reference configuration, e.g. the inner relations
+		 * of total-Lagrangian solids. The neighborhoods are packed into one
+		 * contiguous compressed-sparse-row block, the scattered per-particle
+		 * vectors release their memory together with their growth slack, and
+		 * any later configuration update is rejected as an error. */
+		void sealConfiguration();
+		bool sealedConfiguration() { return configuration_sealed_; };
+
 		virtual void updateConfigurationMemories() override;
+		virtual void shrinkConfigurationMemories() override;
+		virtual size_t MemoryFootprint() override;
+		virtual void writeConfigurationToBuffer(std::string &buffer) override;
+		virtual bool readConfigurationFromBuffer(const char *&current, const char *end) override;
 	};
 
 	/**
@@ -138,16 +261,98 @@ namespace SPH
 	class BodyRelationInner : public BaseBodyRelationInner
 	{
 	protected:
+		friend class ComplexBodyRelation;
+		bool use_half_configuration_; /**< whether each pair is stored only once. */
+		bool use_frozen_configuration_;	  /**< whether the configuration is built exactly once. */
+		bool frozen_configuration_built_; /**< whether the frozen configuration has been built. */
 		SPHBodyParticlesIndex get_particle_index_;
 		SearchDepthSingleResolution get_single_search_depth_;
 		NeighborRelationInner get_inner_neighbor_;
+		NeighborRelationInnerHalf get_inner_neighbor_half_;
 		CellLinkedList *cell_linked_list_;
 
 	public:
 		explicit BodyRelationInner(RealBody &real_body);
 		virtual ~BodyRelationInner(){};
 
+		/** switch to half neighbor lists exploiting pairwise symmetry.
+		 * The interactions using this relation must scatter to both particles
+		 * and be iterated with the splitting scheme to stay race free. */
+		void useHalfConfiguration() { use_half_configuration_ = true; };
+
+		/** freeze the configuration after the first build, for schemes whose
+		 * particles never move, e.g. the Eulerian solvers. The topology and
+		 * kernel values are packed into the compressed-sparse-row storage,
+		 * the body is marked static so its cell linked list is also frozen,
+		 * and all later configuration updates return immediately. */
+		void useFrozenConfiguration();
+
+		virtual void useRecomputedPairGeometry() override;
+		virtual void useKernelGradient() override;
 		virtual void updateConfiguration() override;
+		/** the frozen configuration counts as built when restored */
+		virtual bool readConfigurationFromBuffer(const char *&current, const char *end) override;
+	};
+
+	/**
+	 * @class BodyRelationInnerKnownKernel
+	 * @brief The inner relation with the concrete kernel type known at compile
+	 * time, removing the per-pair virtual kernel calls of the configuration
+	 * update. The body must use the matching kernel type; instantiations are
+	 * provided for the kernel classes of the library.
+	 */
+	template <class KernelType>
+	class BodyRelationInnerKnownKernel : public BodyRelationInner
+	{
+	protected:
+		NeighborRelationInnerKnownKernel<KernelType> get_known_kernel_inner_neighbor_;
+
+	public:
+		explicit BodyRelationInnerKnownKernel(RealBody &real_body);
+		virtual ~BodyRelationInnerKnownKernel(){};
+
+		virtual void useRecomputedPairGeometry() override;
+		virtual void useKernelGradient() override;
+		virtual void updateConfiguration() override;
+	};
+
+	/**
+	 * @class BodyRelationInnerVerlet
+	 * @brief The inner relation with a Verlet list.
+	 * The neighborhoods are built with an enlarged cutoff radius and only rebuilt
+	 * after the maximum particle displacement exceeds half of the skin distance,
+	 * so that slowly-deforming bodies skip most configuration updates.
+	 */
+	class BodyRelationInnerVerlet : public BaseBodyRelationInner
+	{
+	protected:
+		Real skin_distance_;
+		bool configuration_built_;
+		StdLargeVec<Vecd> pos_at_rebuild_; /**< particle positions at the last rebuild. */
+		SPHBodyParticlesIndex get_particle_index_;
+		SearchDepthWithSkin get_skin_search_depth_;
+		NeighborRelationInnerWithSkin get_inner_neighbor_with_skin_;
+		CellLinkedList *cell_linked_list_;
+
+		/** reduce for the maximum particle displacement since the last rebuild. */
+		Real maximumDisplacementSinceRebuild();
+		void rebuildConfiguration();
+
+	public:
+		BodyRelationInnerVerlet(RealBody &real_body, Real skin_distance);
+		virtual ~BodyRelationInnerVerlet(){};
+
+		/** whether the next updateConfiguration() will rebuild the neighborhoods,
+		 * so that updates of the underlying cell linked list can be skipped too. */
+		bool rebuildDue();
+
+		virtual void useRecomputedPairGeometry() override;
+		virtual void useKernelGradient() override;
+		virtual void updateConfiguration() override;
+		/** the positions of the last rebuild travel with the configuration,
+		 * so the rebuild criterion stays meaningful after a resume */
+		virtual void writeConfigurationToBuffer(std::string &buffer) override;
+		virtual bool readConfigurationFromBuffer(const char *&current, const char *end) override;
 	};
 
 	/**
@@ -165,12 +370,28 @@ namespace SPH
 		StdVec<SearchDepthVariableSmoothingLength *> get_multi_level_search_depth_;
 		NeighborRelationInnerVariableSmoothingLength get_inner_neighbor_variable_smoothing_length_;
 		StdVec<CellLinkedList *> cell_linked_list_levels_;
+		MultilevelCellLinkedList *multi_level_cell_linked_list_;
+		/** whether the search sweeps the per-level particle buckets of the
+		 * multilevel cell linked list with precomputed level-pair search depths */
+		bool use_level_resolved_search_;
+		/** search depth on each target level for particles resolved to each source level */
+		StdVec<StdVec<int>> level_pair_search_depths_;
+
+		void updateConfigurationLevelResolved();
 
 	public:
 		explicit BodyRelationInnerVariableSmoothingLength(RealBody &real_body);
 		virtual ~BodyRelationInnerVariableSmoothingLength(){};
 
 		virtual void updateConfiguration() override;
+
+		/** switch the configuration update from sweeping all particles once per
+		 * mesh level with a per-particle search depth to sweeping the per-level
+		 * particle buckets with a search depth precomputed per level pair.
+		 * The precomputed depth bounds the per-particle one from the level grid
+		 * spacing, and superfluous candidate cells are rejected by the kernel
+		 * cutoff as before. */
+		void useLevelResolvedSearch();
 	};
 
 	/**
@@ -179,6 +400,9 @@ namespace SPH
 	 */
 	class SolidBodyRelationSelfContact : public BaseBodyRelationInner
 	{
+	private:
+		UniquePtrKeeper<ParticleBVH> surface_bvh_keeper_;
+
 	public:
 		BodySurfaceLayer body_surface_layer_;
 
@@ -187,12 +411,19 @@ namespace SPH
 
 		virtual void updateConfiguration() override;
 
+		/** switch the self-contact search from the cell linked list over the
+		 * full body to a BVH built over the surface layer particles, which
+		 * is only refitted to the current positions in each update. */
+		void useBVHContactSearch();
+
 	protected:
 		IndexVector &body_part_particles_;
 		BodyPartParticlesIndex get_body_part_particle_index_;
 		SearchDepthSingleResolution get_single_search_depth_;
 		NeighborRelationSelfContact get_self_contact_neighbor_;
 		CellLinkedList *cell_linked_list_;
+		bool use_bvh_contact_search_;
+		ParticleBVH *surface_bvh_;
 
 		virtual void resetNeighborhoodCurrentSize() override;
 	};
@@ -211,7 +442,20 @@ namespace SPH
 		StdVec<CellLinkedList *> target_cell_linked_lists_;
 		StdVec<SearchDepthMultiResolution *> get_search_depths_;
 		StdVec<NeighborRelationContact *> get_contact_neighbors_;
-
+		bool contact_pairing_built_;	  /**< whether the contact configuration has been built at least once */
+		bool use_dynamic_contact_memory_; /**< whether the per-pair storage follows the proximity of the bodies. */
+		StdVec<int> contact_pair_active_; /**< whether each pair is in proximity, its storage released otherwise. */
+		bool use_cached_stencils_;		  /**< whether the neighborhoods are reused as cached interpolation stencils. */
+		StdVec<int> cached_stencil_valid_;		 /**< whether the cached stencil of each pair is still current. */
+		StdVec<size_t> cached_stencil_versions_; /**< cell list update version each stencil was built against. */
+
+		/** the pairing with a contact body can not change when both bodies
+		 * are static, so it is frozen once built */
+		bool frozenContactPairing(size_t contact_index);
+		/** release the neighborhood storage of a pair when the bodies separate */
+		void releaseContactPairStorage(size_t contact_index);
+		/** allocate the neighborhood storage of a pair back when the bodies approach */
+		void allocateContactPairStorage(size_t contact_index);
 		virtual void resetNeighborhoodCurrentSize();
 
 	public:
@@ -223,6 +467,9 @@ namespace SPH
 		virtual ~BaseBodyRelationContact(){};
 
 		virtual void updateConfigurationMemories() override;
+		virtual size_t MemoryFootprint() override;
+		virtual void writeConfigurationToBuffer(std::string &buffer) override;
+		virtual bool readConfigurationFromBuffer(const char *&current, const char *end) override;
 	};
 
 	/**
@@ -232,14 +479,66 @@ namespace SPH
 	class BodyRelationContact : public BaseBodyRelationContact
 	{
 	protected:
+		friend class ComplexBodyRelation;
 		SPHBodyParticlesIndex get_particle_index_;
+		bool use_bounds_pruning_;
 
 		void initialization();
+		/** bounding box of a contact body's particles, computed each update */
+		BoundingBox contactBodyBounds(size_t contact_index);
+		/** check the cached stencils against the cell list update versions of
+		 * the contact bodies and mark the pending rebuilds as the fresh ones */
+		void revalidateCachedStencils();
+		/** whether the bounds of the two bodies are within interaction range,
+		 * using the same conservative margin as the bounds pruning */
+		bool checkContactPairProximity(size_t contact_index);
 
 	public:
 		BodyRelationContact(SPHBody &sph_body, RealBodyVector contact_bodies);
 		BodyRelationContact(SPHBody &sph_body, BodyPartVector contact_body_parts);
 		virtual ~BodyRelationContact(){};
+		/** switch on pruning the contact search by body bounds overlap:
+		 * source particles whose kernel support lies outside the contact
+		 * body's bounding box can not have contact neighbors and are skipped. */
+		void useBoundsPruning() { use_bounds_pruning_ = true; };
+		/** allocate the neighborhood storage of a contact pair only when the
+		 * bounding boxes of the two bodies first come within interaction range,
+		 * and release it again when the bodies separate, so that an assembly
+		 * with many potential but rarely touching pairs does not carry the
+		 * per-pair configuration memory and update cost up front. */
+		void useDynamicContactMemory() { use_dynamic_contact_memory_ = true; };
+		/** switch on reusing the contact neighborhoods as cached interpolation
+		 * stencils: the pairing with a contact body is only rebuilt after the
+		 * cell linked list of that body has been rebuilt, so observations at a
+		 * higher cadence than the cell list updates keep the previous neighbor
+		 * ids and kernel weights. Meant for observer bodies at fixed positions,
+		 * whose stencils only change when the observed configuration does. */
+		void useCachedStencils() { use_cached_stencils_ = true; };
+		virtual void updateConfiguration() override;
+	};
+
+	/**
+	 * @class BodyRelationContactKnownKernel
+	 * @brief The contact relation with the concrete type of the per-pair
+	 * resolved kernels known at compile time, removing the per-pair virtual
+	 * kernel calls of the configuration update. The kernel resolved for each
+	 * contact pair at construction, the coarser one of the two bodies, must
+	 * be of the matching kernel type; instantiations are provided for the
+	 * kernel classes of the library.
+	 */
+	template <class KernelType>
+	class BodyRelationContactKnownKernel : public BodyRelationContact
+	{
+	private:
+		UniquePtrKeepers<NeighborRelationContactKnownKernel<KernelType>> known_kernel_contact_ptr_vector_keeper_;
+
+	protected:
+		StdVec<NeighborRelationContactKnownKernel<KernelType> *> get_known_kernel_contact_neighbors_;
+
+	public:
+		BodyRelationContactKnownKernel(SPHBody &sph_body, RealBodyVector contact_bodies);
+		virtual ~BodyRelationContactKnownKernel(){};
+
 		virtual void updateConfiguration() override;
 	};
 
@@ -251,6 +550,7 @@ namespace SPH
 	{
 	private:
 		UniquePtrKeeper<BodySurfaceLayer> shape_surface_ptr_keeper_;
+		UniquePtrKeepers<ParticleBVH> contact_bvh_ptr_vector_keeper_;
 
 	public:
 		BodySurfaceLayer *body_surface_layer_;
@@ -262,13 +562,84 @@ namespace SPH
 		virtual ~SolidBodyRelationContact(){};
 
 		virtual void updateConfiguration() override;
+		/** update the configuration against broadphase candidates only: the
+		 * contact bodies flagged out keep empty neighborhoods, and the cell
+		 * list searches are restricted to the given per-pair overlap bounds. */
+		void updateConfigurationForCandidates(const StdVec<int> &contact_is_candidate,
+											  const StdVec<BoundingBox> &search_bounds);
+
+		/** switch the contact candidate generation from the cell linked lists
+		 * of the contact bodies to BVHs over their particles, which are only
+		 * refitted to the current positions in each update. */
+		void useBVHContactSearch();
 
 	protected:
 		IndexVector &body_part_particles_;
 		BodyPartParticlesIndex get_body_part_particle_index_;
+		bool use_bvh_contact_search_;
+		StdVec<ParticleBVH *> contact_bvhs_;
+		StdVec<IndexVector> contact_candidate_particles_;
 
 		void initialization();
 		virtual void resetNeighborhoodCurrentSize() override;
+		/** narrowphase search against one contact body by its cell linked list */
+		void searchContactBodyNeighbors(size_t contact_index);
+		/** the same search restricted to given bounds: surface particles whose
+		 * kernel support lies outside the bounds are skipped */
+		void searchContactBodyNeighbors(size_t contact_index, const BoundingBox &search_bounds);
+		/** narrowphase search against one contact body by its refitted BVH */
+		void searchContactBodyNeighborsByBVH(size_t contact_index);
+	};
+
+	/**
+	 * @class SolidContactBroadphase
+	 * @brief A broadphase shared by the solid contact relations of a multi-body
+	 * assembly. Each update rasterizes the particles of every body taking part
+	 * in one of the given relations onto one shared coarse grid in a single
+	 * pass over the bodies; a contact pair only reaches its narrowphase search
+	 * when the grid occupancy of one body overlaps the spread occupancy of the
+	 * other, and the search is then restricted to the bounds overlap of the
+	 * pair. An all-pairs setup thus pays one pass over the bodies plus the
+	 * searches of the actually interacting pairs, instead of one full search
+	 * sweep per pair. The coarse cell size is no less than twice the largest
+	 * kernel cut-off of the bodies, so spreading the occupancy by one cell
+	 * covers every per-pair contact search radius conservatively.
+	 */
+	class SolidContactBroadphase
+	{
+	public:
+		SolidContactBroadphase() : total_coarse_cells_(0){};
+		~SolidContactBroadphase(){};
+
+		/** the shared-grid pass over the bodies of the given relations,
+		 * followed by the candidate narrowphase updates of each relation */
+		void updateConfigurations(const StdVec<SolidBodyRelationContact *> &contact_relations);
+
+	protected:
+		/** shared-grid summary of the particles of one body or body surface */
+		struct BodyOccupancy
+		{
+			SPHBody *body_;
+			IndexVector *surface_particles_; /**< all particles take part when nullptr */
+			BoundingBox bounds_;
+			IndexVector occupied_cells_;
+			StdVec<int> spread_occupancy_; /**< occupancy spread to the neighboring cells */
+		};
+		StdVec<BodyOccupancy> body_occupancies_; /**< reused as scratch between updates */
+		BaseMesh coarse_mesh_;					 /**< the shared coarse grid of this update */
+		Vecu number_of_coarse_cells_;
+		size_t total_coarse_cells_;
+		StdVec<int> cell_marks_; /**< rasterization scratch, zeroed outside the marked cells */
+
+		/** the record of a body, registering it on first appearance */
+		size_t findBodyOccupancy(SPHBody *body, IndexVector *surface_particles);
+		/** size the shared grid over the union bounds of the registered bodies */
+		void buildSharedCoarseGrid(const BoundingBox &union_bounds, Real reference_cutoff_radius);
+		/** occupied cell list and spread occupancy of one body on the shared grid */
+		void rasterizeBodyOccupancy(BodyOccupancy &body_occupancy);
+		/** whether any occupied cell of the target falls into the spread occupancy
+		 * of the source, so that the pair can have contact neighbors */
+		bool checkOccupancyOverlap(BodyOccupancy &source, BodyOccupancy &target);
 	};
 
 	/**
@@ -291,7 +662,10 @@ namespace SPH
 
 	/**
 	 * @class BodyPartRelationContact
-	 * @brief The relation between a Body part with a SPH body. 
+	 * @brief The relation between a Body part with a SPH body.
+	 * Both the neighborhood reset and the contact search are scoped to the
+	 * particles of the body part, so that the configuration update cost
+	 * scales with the part size instead of the whole body.
 	 */
 	class BodyPartRelationContact : public BodyRelationContact
 	{
@@ -304,6 +678,9 @@ namespace SPH
 		virtual ~BodyPartRelationContact(){};
 
 		virtual void updateConfiguration() override;
+
+	protected:
+		virtual void resetNeighborhoodCurrentSize() override;
 	};
 
 	/**
@@ -350,8 +727,26 @@ namespace SPH
 		ComplexBodyRelation(RealBody &real_body, BodyPartVector contact_body_parts);
 		virtual ~ComplexBodyRelation(){};
 
+		/** update the inner and all contact configurations in one shared sweep
+		 * over the body's particles: for each particle, the neighborhoods of
+		 * all member relations are built back to back, so the particle loop
+		 * and the particle positions are streamed only once instead of once
+		 * per relation. Only the plain inner and contact relations are supported. */
+		void useCombinedConfigurationUpdate();
+
 		virtual void updateConfigurationMemories() override;
 		virtual void updateConfiguration() override;
+		virtual size_t MemoryFootprint() override
+		{
+			return inner_relation_.MemoryFootprint() + contact_relation_.MemoryFootprint();
+		};
+
+	protected:
+		bool use_combined_update_; /**< whether all member relations are updated in one shared sweep. */
+		BodyRelationInner *combined_inner_relation_;
+		BodyRelationContact *combined_contact_relation_;
+
+		void updateCombinedConfiguration();
 	};
 }
 #endif //BODY_RELATION_H
\ No newline at end of file
@@ -22,6 +22,36 @@ namespace SPH
 	//=================================================================================================//
 	void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_configuration)
 	{
+		/** The admissible neighbors are determined by the static tree topology,
+		 * so their indices are collected only once. Each update then re-evaluates
+		 * the pair geometry only, in parallel over the particles. */
+		if (topology_neighbor_ids_.empty())
+			cacheTopologyNeighborIds();
+
+		const StdLargeVec<Vecd> &pos_n_ = base_particles_->pos_n_;
+		NeighborRelationInner neighbor_relation_inner(this);
+		parallel_for(
+			blocked_range<size_t>(0, topology_neighbor_ids_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t particle_id = r.begin(); particle_id != r.end(); ++particle_id)
+				{
+					Neighborhood &neighborhood = particle_configuration[particle_id];
+					neighborhood.current_size_ = 0;
+					const IndexVector &neighboring_ids = topology_neighbor_ids_[particle_id];
+					for (size_t n = 0; n != neighboring_ids.size(); ++n)
+					{
+						Vecd displacement = pos_n_[particle_id] - pos_n_[neighboring_ids[n]];
+						neighbor_relation_inner(neighborhood, displacement, particle_id, neighboring_ids[n]);
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void TreeBody::cacheTopologyNeighborIds()
+	{
+		topology_neighbor_ids_.resize(base_particles_->total_real_particles_);
 		/** First branch
 		 * Note that the first branch has only one particle.
 		 * Find the neighbors in child branch, the first branch only have one child, id = 1.
@@ -30,15 +60,7 @@ namespace SPH
 		std::vector<size_t> neighboring_ids;
 		neighboring_ids.push_back(branches_[1]->inner_particles_[0]);
 		neighboring_ids.push_back(branches_[1]->inner_particles_[1]);
-		/** Build configuration. */
-		const StdLargeVec<Vecd> &pos_n_ =  base_particles_->pos_n_;
-		NeighborRelationInner neighbor_relation_inner(this);
-		for (size_t n = 0; n != neighboring_ids.size(); ++n)
-		{
-			Vecd displacement = pos_n_[particle_id] - pos_n_[neighboring_ids[n]];
-			Neighborhood &neighborhood = particle_configuration[particle_id];
-			neighbor_relation_inner(neighborhood, displacement, particle_id, neighboring_ids[n]);
-		}
+		topology_neighbor_ids_[particle_id] = neighboring_ids;
 		/** Second branch. 
 		 * The second branch has special parent branch, branch 0, consisting only one point.
 		 * The child branch are two normal branch. 
@@ -99,14 +121,9 @@ namespace SPH
 				}
 			}
 
-			for (size_t n = 0; n != neighboring_ids.size(); ++n)
-			{
-				Vecd displacement = pos_n_[particle_id] - pos_n_[neighboring_ids[n]];
-				Neighborhood &neighborhood = particle_configuration[particle_id];
-				neighbor_relation_inner(neighborhood, displacement, particle_id, neighboring_ids[n]);
-			}
+			topology_neighbor_ids_[particle_id] = neighboring_ids;
 		}
-		/** Other branches. 
+		/** Other branches.
 		 * They are may normal branch (fully growed, has child and parent) or non-fully growed branch
 		 */
 		for (size_t branch_idx = 2; branch_idx != branches_.size(); ++branch_idx)
@@ -170,12 +187,7 @@ namespace SPH
 						}
 					}
 
-					for (size_t n = 0; n != neighboring_ids.size(); ++n)
-					{
-						Vecd displacement = pos_n_[particle_id] - pos_n_[neighboring_ids[n]];
-						Neighborhood &neighborhood = particle_configuration[particle_id];
-						neighbor_relation_inner(neighborhood, displacement, particle_id, neighboring_ids[n]);
-					}
+					topology_neighbor_ids_[particle_id] = neighboring_ids;
 				}
 			}
 			else
@@ -207,12 +219,7 @@ namespace SPH
 					if (i + 2 < num_ele)
 						neighboring_ids.push_back(particle_id + 2);
 
-					for (size_t n = 0; n != neighboring_ids.size(); ++n)
-					{
-						Vecd displacement = pos_n_[particle_id] - pos_n_[neighboring_ids[n]];
-						Neighborhood &neighborhood = particle_configuration[particle_id];
-						neighbor_relation_inner(neighborhood, displacement, particle_id, neighboring_ids[n]);
-					}
+					topology_neighbor_ids_[particle_id] = neighboring_ids;
 				}
 			}
 		}
@@ -69,6 +69,9 @@ namespace SPH
 	public:
 		StdVec<Branch *> branches_;	   /**< Container of all branches */
 		IndexVector branch_locations_; /**< in which branch are the particles located */
+		/** neighbor indices admissible by the tree topology for each particle,
+		 * cached at the first configuration build as the topology is static */
+		StdVec<IndexVector> topology_neighbor_ids_;
 		size_t last_branch_id_;
 		Branch *root_;
 
@@ -84,6 +87,11 @@ namespace SPH
 
 		virtual void buildParticleConfiguration(ParticleConfiguration &particle_configuration) override;
 		size_t ContainerSize() { return branches_.size(); };
+
+	protected:
+		/** walk the branches once and collect the topology-determined
+		 * neighbor indices of each particle */
+		void cacheTopologyNeighborIds();
 	};
 
 	/**
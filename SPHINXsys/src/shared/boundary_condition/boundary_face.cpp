@@ -85,10 +85,10 @@ namespace SPH
         setupDynamics(dt);
         for (size_t i = 0; i != bound_cells_.size(); ++i)
         {
-            ListDataVector &cell_list_data = bound_cells_[i]->cell_list_data_;
-            for (size_t num = 0; num < cell_list_data.size(); ++num)
+            IndexVector &cell_list_indexes = bound_cells_[i]->cell_list_indexes_;
+            for (size_t num = 0; num < cell_list_indexes.size(); ++num)
             {
-                size_t particle_index = cell_list_data[num].first;
+                size_t particle_index = cell_list_indexes[num];
                 particle_functor_(particle_index, dt);
             }
         }
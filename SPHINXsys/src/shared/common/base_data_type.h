@@ -295,7 +295,13 @@ namespace SPH
 	using Vec3u = SVec<3, size_t>;
 
 	// float point number
+	// the single-precision build halves the footprint of particle data
+	// for bandwidth-bound interaction loops
+#ifdef SPHINXSYS_USE_FLOAT
+	using Real = float;
+#else
 	using Real = SimTK::Real;
+#endif
 
 	// useful float point constants s
 	const Real Pi = Real(M_PI);
@@ -304,9 +310,21 @@ namespace SPH
 	using SimTK::TinyReal;
 	constexpr size_t MaxSize_t = std::numeric_limits<size_t>::max();
 
+#ifdef SPHINXSYS_USE_FLOAT
+	// vector with float point number
+	using Vec2d = SimTK::Vec<2, float>;
+	using UnpaddedVec3d = SimTK::Vec<3, float>;
+
+	// small matrix with float point number
+	using Mat2d = SimTK::Mat<2, 2, float>;
+	using Mat3d = SimTK::Mat<3, 3, float>;
+	// small symmetric matrix with float point number
+	using SymMat2d = SimTK::SymMat<2, float>;
+	using SymMat3d = SimTK::SymMat<3, float>;
+#else
 	// vector with float point number
 	using Vec2d = SimTK::Vec2;
-	using Vec3d = SimTK::Vec3;
+	using UnpaddedVec3d = SimTK::Vec3;
 
 	// small matrix with float point number
 	using Mat2d = SimTK::Mat22;
@@ -314,6 +332,34 @@ namespace SPH
 	// small symmetric matrix with float point number
 	using SymMat2d = SimTK::SymMat22;
 	using SymMat3d = SimTK::SymMat33;
+#endif
+
+#ifdef SPHINXSYS_PADDED_VEC3
+	// the padded build extends the three-component vector by an unused
+	// fourth lane to a full SIMD lane (32 bytes, or 16 in the
+	// single-precision build), so that arrays of particle vectors are
+	// lane aligned and the vector loads of the interaction loops do not
+	// split. The padded type keeps the full interface of the vector it
+	// derives from; the two-component vector of the 2D build is lane
+	// aligned as it is.
+	class alignas(4 * sizeof(Real)) PaddedVec3d : public UnpaddedVec3d
+	{
+	public:
+		using UnpaddedVec3d::UnpaddedVec3d;
+		using UnpaddedVec3d::operator=;
+		PaddedVec3d(){};
+		PaddedVec3d(const UnpaddedVec3d &source) : UnpaddedVec3d(source){};
+		PaddedVec3d &operator=(const UnpaddedVec3d &source)
+		{
+			UnpaddedVec3d::operator=(source);
+			return *this;
+		};
+	};
+	using Vec3d = PaddedVec3d;
+#else
+	using Vec3d = UnpaddedVec3d;
+#endif
+
 
 	// type trait for particle data type index
 	template <typename T>
@@ -54,6 +54,31 @@ namespace SPH {
 		ASCII
 	};
 
+	/**
+	 * @class ImageMemoryMapping
+	 * @brief A static switch to map the raw image data from the file instead of
+	 * reading it upfront. The pages are read on demand when the probes touch
+	 * them, so a large distance map is neither double-buffered nor waited on
+	 * as a whole before the body generation starts. The mapped image is probed
+	 * with trilinear interpolation and its value range is not scanned.
+	 * Not available on Windows, where the image is read as before.
+	 */
+	class ImageMemoryMapping
+	{
+	public:
+		static void switchOn() { enabled() = true; };
+		static void switchOff() { enabled() = false; };
+		static bool Enabled() { return enabled(); };
+
+	private:
+		// kept in a function-local static because the image classes are header-only
+		static bool &enabled()
+		{
+			static bool memory_mapping_enabled = false;
+			return memory_mapping_enabled;
+		};
+	};
+
 	template <typename T, int nDims>
 	class ImageMHD
 	{
@@ -150,8 +175,11 @@ namespace SPH {
 		Real min_value_;
 		Real max_value_;
 		T *data_;
+		bool memory_mapped_;
+		size_t mapped_bytes_;
 
 		std::vector<int> findNeighbors(const Vec3d& input_pnt, Vec3i& this_cell);
+		Real probeTrilinear(const Vec3d& input_pnt);
 		Vec3d computeGradientAtCell(int i);
 		Vec3d computeNormalAtCell(int i);
 		T getValueAtCell(int i);
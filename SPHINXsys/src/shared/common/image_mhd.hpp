@@ -35,6 +35,13 @@
 #include "image_mhd.h"
 #include "boost/algorithm/string.hpp"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace SPH {
 
 	template<typename T, int nDims>
@@ -58,7 +65,9 @@ namespace SPH {
 		elementDataFile_(""),
 		min_value_(Infinity),
 		max_value_(-Infinity),
-		data_(nullptr)
+		data_(nullptr),
+		memory_mapped_(false),
+		mapped_bytes_(0)
 	{
 		//- read mhd file
 		std::ifstream dataFile(full_path_to_file, std::ifstream::in);
@@ -117,7 +126,8 @@ namespace SPH {
 						height_ = dimSize_[1];
 						depth_ = dimSize_[2];
 						size_ = width_ * height_*depth_;
-						if(data_ == nullptr)
+						//- the upfront buffer is not needed when the raw data is mapped
+						if(data_ == nullptr && !ImageMemoryMapping::Enabled())
 							data_ = new T[dimSize_[0] * dimSize_[1] * dimSize_[2]];
 					}
 					else if (elements[0].compare("ElementDataFile") == 0)
@@ -135,23 +145,61 @@ namespace SPH {
 		std::cout << "offset: " << offset_ << std::endl;
 		std::cout << "transformMatrix: " << transformMatrix_ << std::endl;
 
-		//- read raw file
-		std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
+		//- map the raw file instead of reading it when switched on
+#ifndef _WIN32
+		if (ImageMemoryMapping::Enabled())
+		{
+			int raw_file = open(file_path_to_raw_file.c_str(), O_RDONLY);
+			if (raw_file != -1)
+			{
+				struct stat raw_file_status;
+				mapped_bytes_ = sizeof(T) * size_;
+				if (fstat(raw_file, &raw_file_status) == 0 &&
+					raw_file_status.st_size >= off_t(mapped_bytes_))
+				{
+					void *mapping = mmap(nullptr, mapped_bytes_, PROT_READ, MAP_PRIVATE, raw_file, 0);
+					if (mapping != MAP_FAILED)
+					{
+						data_ = static_cast<T *>(mapping);
+						memory_mapped_ = true;
+						//- the pages are only read when a probe touches them, so the
+						//- value range is not scanned; points away from the image are
+						//- treated as one image diagonal away from the surface
+						Real diagonal = Vec3d(width_ * elementSpacing_[0],
+											  height_ * elementSpacing_[1],
+											  depth_ * elementSpacing_[2]).norm();
+						min_value_ = -diagonal;
+						max_value_ = diagonal;
+					}
+				}
+				//- the mapping keeps its own reference to the file
+				close(raw_file);
+			}
+		}
+#endif //_WIN32
 
-		if (dataFileRaw.is_open())
+		//- read raw file
+		if (!memory_mapped_)
 		{
-			dataFileRaw.read((char*)data_, sizeof(T)*size_);
-			T distance = 0;
-			for(int index = 0; index<size_; index++)
+			if (data_ == nullptr)
+				data_ = new T[size_];
+			std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
+
+			if (dataFileRaw.is_open())
 			{
-				distance = data_[index];
-				data_[index] = distance;
-				//std::cout <<index <<" "<< distance << '\n';
-				if (distance < min_value_) min_value_ = distance;
-				if (distance > max_value_) max_value_ = distance;
+				dataFileRaw.read((char*)data_, sizeof(T)*size_);
+				T distance = 0;
+				for(int index = 0; index<size_; index++)
+				{
+					distance = data_[index];
+					data_[index] = distance;
+					//std::cout <<index <<" "<< distance << '\n';
+					if (distance < min_value_) min_value_ = distance;
+					if (distance > max_value_) max_value_ = distance;
+				}
 			}
+			dataFileRaw.close();
 		}
-		dataFileRaw.close();
 
 		//write(std::string("sphere-binary"),ASCII);
 	}
@@ -176,9 +224,11 @@ namespace SPH {
 		elementDataFile_(""),
 		min_value_(Infinity),
 		max_value_(-Infinity),
-		data_(nullptr)
+		data_(nullptr),
+		memory_mapped_(false),
+		mapped_bytes_(0)
 	{
-		if(data_ == nullptr) 
+		if(data_ == nullptr)
 			data_ = new float[size_];
 
 		Vec3d center(0.5*width_, 0.5*height_, 0.5*depth_);
@@ -205,8 +255,18 @@ namespace SPH {
 	{
 		if (data_)
 		{
-			delete data_;
-			data_ = nullptr;
+#ifndef _WIN32
+			if (memory_mapped_)
+			{
+				munmap(static_cast<void *>(data_), mapped_bytes_);
+				data_ = nullptr;
+			}
+#endif //_WIN32
+			if (data_)
+			{
+				delete data_;
+				data_ = nullptr;
+			}
 		}
 	}
 
@@ -414,9 +474,42 @@ namespace SPH {
 		return BoundingBox(lower_bound, upper_bound);
 	}
 
+	template<typename T, int nDims>
+	Real ImageMHD<T, nDims>::probeTrilinear(const Vec3d& input_pnt)
+	{
+		Vec3d image_coord = transformMatrix_.invert()*(input_pnt - offset_);
+
+		int x = int(floor(image_coord[0]));
+		int y = int(floor(image_coord[1]));
+		int z = int(floor(image_coord[2]));
+		//- points away from the image are treated as far away from the surface
+		if (x < 0 || x > width_ - 2 || y < 0 || y > height_ - 2 || z < 0 || z > depth_ - 2)
+			return max_value_;
+
+		Real fx = image_coord[0] - Real(x);
+		Real fy = image_coord[1] - Real(y);
+		Real fz = image_coord[2] - Real(z);
+
+		//- gather only the eight corner values around the point
+		int slice_size = width_ * height_;
+		int index = z * slice_size + y * width_ + x;
+		Real c00 = data_[index] * (1.0 - fx) + data_[index + 1] * fx;
+		Real c10 = data_[index + width_] * (1.0 - fx) + data_[index + width_ + 1] * fx;
+		Real c01 = data_[index + slice_size] * (1.0 - fx) + data_[index + slice_size + 1] * fx;
+		Real c11 = data_[index + slice_size + width_] * (1.0 - fx) + data_[index + slice_size + width_ + 1] * fx;
+
+		Real c0 = c00 * (1.0 - fy) + c10 * fy;
+		Real c1 = c01 * (1.0 - fy) + c11 * fy;
+		return c0 * (1.0 - fz) + c1 * fz;
+	}
+	//=================================================================================================//
 	template<typename T, int nDims>
 	Real ImageMHD<T, nDims>::findValueAtPoint(const Vec3d& input_pnt)
 	{
+		//- trilinear fast path over the mapped buffer
+		if (memory_mapped_)
+			return probeTrilinear(input_pnt);
+
 		Vec3i this_cell;
 		std::vector<int> neighbors = findNeighbors(input_pnt, this_cell);
 		double weight_sum = 0.0;
@@ -36,17 +36,101 @@
 #include "tbb/cache_aligned_allocator.h"
 
 #include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__) && !defined(SPHINXSYS_DISABLE_HUGE_PAGES)
+#include <sys/mman.h>
+#endif
 
 using namespace tbb;
 static tbb::affinity_partitioner ap;
+static tbb::static_partitioner static_ap;
 
 namespace SPH {
 
 	template <typename T>
 	using LargeVec = tbb::concurrent_vector<T>;
 
+	/** Allocation policy of the large particle-data arrays: the alignment
+	 * matches the widest vector registers, so that the bulk arrays can be
+	 * loaded with aligned SIMD instructions, and, on Linux, blocks of two
+	 * megabytes and more are mapped with a transparent huge page hint to
+	 * reduce the TLB pressure of the interaction loops. Defining
+	 * SPHINXSYS_DISABLE_HUGE_PAGES switches the huge page backing off. */
+	static const std::size_t large_data_alignment = 64;
+	static const std::size_t large_data_huge_page_size = std::size_t(1) << 21;
+
+	/**
+	 * @class LargeDataAllocator
+	 * @brief Aligned allocator of the large particle-data arrays.
+	 */
+	template <typename T>
+	class LargeDataAllocator
+	{
+	public:
+		typedef T value_type;
+
+		LargeDataAllocator() = default;
+		template <typename U>
+		LargeDataAllocator(const LargeDataAllocator<U> &) {};
+
+		T *allocate(std::size_t n)
+		{
+			std::size_t bytes = n * sizeof(T);
+#if defined(__linux__) && !defined(SPHINXSYS_DISABLE_HUGE_PAGES)
+			if (bytes >= large_data_huge_page_size)
+			{
+				std::size_t mapped_bytes = mappedBytes(bytes);
+				void *memory = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+									MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (memory == MAP_FAILED)
+					throw std::bad_alloc();
+				madvise(memory, mapped_bytes, MADV_HUGEPAGE);
+				return static_cast<T *>(memory);
+			}
+#endif
+			// over-allocate and stash the raw pointer just below the aligned block
+			void *raw = std::malloc(bytes + large_data_alignment + sizeof(void *));
+			if (raw == nullptr)
+				throw std::bad_alloc();
+			std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *) +
+									  large_data_alignment - 1) &
+									 ~(std::uintptr_t)(large_data_alignment - 1);
+			reinterpret_cast<void **>(aligned)[-1] = raw;
+			return reinterpret_cast<T *>(aligned);
+		};
+
+		void deallocate(T *p, std::size_t n)
+		{
+			std::size_t bytes = n * sizeof(T);
+#if defined(__linux__) && !defined(SPHINXSYS_DISABLE_HUGE_PAGES)
+			if (bytes >= large_data_huge_page_size)
+			{
+				munmap(p, mappedBytes(bytes));
+				return;
+			}
+#endif
+			std::free(reinterpret_cast<void **>(p)[-1]);
+		};
+
+	private:
+#if defined(__linux__) && !defined(SPHINXSYS_DISABLE_HUGE_PAGES)
+		static std::size_t mappedBytes(std::size_t bytes)
+		{
+			return (bytes + large_data_huge_page_size - 1) & ~(large_data_huge_page_size - 1);
+		};
+#endif
+	};
+
+	template <typename T, typename U>
+	bool operator==(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return true; };
+	template <typename T, typename U>
+	bool operator!=(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return false; };
+
 	template <typename T>
-	using StdLargeVec = std::vector<T, cache_aligned_allocator<T>>;
+	using StdLargeVec = std::vector<T, LargeDataAllocator<T>>;
 
 	template <typename T>
 	using StdVec = std::vector<T>;
@@ -0,0 +1,115 @@
+/**
+ * @file 	loop_tuning.cpp
+ * @author	Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#include "loop_tuning.h"
+#include "base_data_package.h"
+
+#include <fstream>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+//=============================================================================================//
+namespace SPH
+{
+	bool LoopTuning::tuning_enabled_ = false;
+
+	namespace
+	{
+		//tuning constants from the micro-benchmarks: the number of measuring
+		//invocations, the invocation wall time under which the fork/join
+		//overhead dominates and the loop runs serially, and the targeted
+		//wall time of one parallel grain
+		constexpr size_t tuning_sample_count = 4;
+		constexpr double serial_execution_seconds = 30.0e-6;
+		constexpr double target_grain_seconds = 20.0e-6;
+	}
+	//=============================================================================================//
+	std::string DemangledName(const std::type_info &type)
+	{
+#ifdef __GNUC__
+		int status = 0;
+		char *demangled_name = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+		std::string name = status == 0 ? demangled_name : type.name();
+		std::free(demangled_name);
+		return name;
+#else
+		return type.name();
+#endif
+	}
+	//=============================================================================================//
+	std::map<std::string, LoopTuning::TunedParameters> &LoopTuning::PersistedParameters()
+	{
+		static std::map<std::string, TunedParameters> persisted_parameters;
+		return persisted_parameters;
+	}
+	//=============================================================================================//
+	void LoopTuning::writeToFile(const std::string &filefullpath)
+	{
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+		for (auto &key_and_parameters : PersistedParameters())
+		{
+			out_file << key_and_parameters.second.grain_size_ << " "
+					 << key_and_parameters.second.serial_preferred_ << " "
+					 << key_and_parameters.first << "\n";
+		}
+		out_file.close();
+	}
+	//=============================================================================================//
+	void LoopTuning::readFromFile(const std::string &filefullpath)
+	{
+		std::ifstream in_file(filefullpath.c_str());
+		TunedParameters parameters;
+		while (in_file >> parameters.grain_size_ >> parameters.serial_preferred_)
+		{
+			in_file.get(); //the space separating the decision from its key
+			std::string key;
+			std::getline(in_file, key);
+			PersistedParameters()[key] = parameters;
+		}
+		in_file.close();
+	}
+	//=============================================================================================//
+	void LoopTuner::assignPersistenceKey(const std::type_info &owner_type,
+										 const char *loop_name, size_t loop_size)
+	{
+		persistence_key_ = DemangledName(owner_type) + " " + loop_name + " " + std::to_string(loop_size);
+		auto persisted = LoopTuning::PersistedParameters().find(persistence_key_);
+		if (persisted != LoopTuning::PersistedParameters().end())
+		{
+			grain_size_ = persisted->second.grain_size_;
+			serial_preferred_ = persisted->second.serial_preferred_ != 0;
+			tuned_ = true;
+		}
+	}
+	//=============================================================================================//
+	void LoopTuner::recordSample(size_t loop_size, double seconds)
+	{
+		sample_count_++;
+		accumulated_items_ += loop_size;
+		accumulated_seconds_ += seconds;
+		if (sample_count_ < tuning_sample_count)
+			return;
+
+		double seconds_per_invocation = accumulated_seconds_ / (double)sample_count_;
+		double seconds_per_item = accumulated_seconds_ / ((double)accumulated_items_ + TinyReal);
+		size_t mean_loop_size = accumulated_items_ / sample_count_;
+		serial_preferred_ = seconds_per_invocation < serial_execution_seconds;
+		//the grain spans the targeted wall time, bounded so that the range
+		//still splits into enough grains to keep all workers busy
+		grain_size_ = SMIN(SMAX((size_t)(target_grain_seconds / (seconds_per_item + TinyReal)), (size_t)1),
+						   SMAX(mean_loop_size / 8, (size_t)1));
+		tuned_ = true;
+
+		if (Keyed())
+		{
+			LoopTuning::TunedParameters parameters;
+			parameters.grain_size_ = grain_size_;
+			parameters.serial_preferred_ = serial_preferred_ ? 1 : 0;
+			LoopTuning::PersistedParameters()[persistence_key_] = parameters;
+		}
+	}
+	//=============================================================================================//
+}
+//=============================================================================================//
@@ -0,0 +1,98 @@
+/**
+ * @file 	loop_tuning.h
+ * @brief 	Auto-tuning of the grain sizes of the parallel loops. The tuner is
+ * placed with the basic data structures, below both the mesh and the particle
+ * dynamics layers, so that the particle, reduce and mesh package iterators
+ * can all take their grain from it.
+ * @author	Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+
+#ifndef LOOP_TUNING_H
+#define LOOP_TUNING_H
+
+#include <map>
+#include <string>
+#include <typeinfo>
+
+namespace SPH
+{
+	/** the human-readable name of a type, falling back on the raw name
+	 * when the demangling is not available */
+	std::string DemangledName(const std::type_info &type);
+
+	/**
+	 * @class LoopTuning
+	 * @brief Switch for the auto-tuned grain sizes of the parallel loops.
+	 * When switched on, each tuned loop measures its cost on the early
+	 * invocations and then locks in a grain size for the blocked range, or a
+	 * serial execution when the loop is too small to amortize the parallel
+	 * fork/join overhead. The tuned decisions can be written to and read from
+	 * a parameter file, so that a later run on the same case starts with the
+	 * tuned values instead of the measuring invocations.
+	 */
+	class LoopTuning
+	{
+	public:
+		static void switchOn() { tuning_enabled_ = true; };
+		static void switchOff() { tuning_enabled_ = false; };
+		static bool Enabled() { return tuning_enabled_; };
+
+		/** the locked-in decision for one loop */
+		struct TunedParameters
+		{
+			size_t grain_size_;
+			int serial_preferred_;
+		};
+		/** the tuned decisions published for or adopted from a parameter file,
+		 * keyed by the owner type, the loop name and the loop size */
+		static std::map<std::string, TunedParameters> &PersistedParameters();
+		/** write all persisted decisions, one loop per line */
+		static void writeToFile(const std::string &filefullpath);
+		/** read previously written decisions. Loops matching a read entry
+		 * adopt it and skip their measuring invocations. */
+		static void readFromFile(const std::string &filefullpath);
+
+	private:
+		static bool tuning_enabled_;
+	};
+
+	/**
+	 * @class LoopTuner
+	 * @brief The per-loop record of the auto-tuning: it accumulates the
+	 * measured cost of the early invocations of one parallel loop and then
+	 * locks in the grain size and the serial-execution decision for all
+	 * following invocations. One tuner serves one loop of one owner
+	 * instance, since the per-item cost differs between, e.g., the
+	 * interaction and the update loop of the same particle dynamics.
+	 */
+	class LoopTuner
+	{
+	public:
+		LoopTuner()
+			: tuned_(false), serial_preferred_(false), grain_size_(1),
+			  sample_count_(0), accumulated_items_(0), accumulated_seconds_(0.0){};
+
+		bool Tuned() { return tuned_; };
+		bool SerialPreferred() { return serial_preferred_; };
+		size_t GrainSize() { return grain_size_; };
+		bool Keyed() { return !persistence_key_.empty(); };
+
+		/** key this tuner for the persistence of its decision, adopting an
+		 * already persisted decision under the same key when one is present */
+		void assignPersistenceKey(const std::type_info &owner_type,
+								  const char *loop_name, size_t loop_size);
+		/** accumulate one measured invocation and lock in the decision
+		 * once enough samples have been collected */
+		void recordSample(size_t loop_size, double seconds);
+
+	private:
+		bool tuned_;
+		bool serial_preferred_;
+		size_t grain_size_;
+		size_t sample_count_;
+		size_t accumulated_items_;
+		double accumulated_seconds_;
+		std::string persistence_key_;
+	};
+}
+#endif // LOOP_TUNING_H
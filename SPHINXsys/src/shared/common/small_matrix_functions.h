@@ -0,0 +1,160 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file small_matrix_functions.h
+* @brief Unrolled small-matrix operations for the hot solid-dynamics kernels.
+* @details The SimTK matrix operators are convenient but opaque to the
+* vectorizer. The functions here provide the same products, inverses and the
+* polar rotation as fully unrolled straight-line code, so that the compiler
+* can keep the operands in registers and emit SIMD instructions. The fast
+* versions are selected at compile time by the SPHINXSYS_FAST_SMALL_MATRIX
+* definition, otherwise they simply forward to the SimTK operators.
+* @author	Chi Zhang and Xiangyu Hu
+*/
+
+#ifndef SMALL_MATRIX_FUNCTIONS_H
+#define SMALL_MATRIX_FUNCTIONS_H
+
+#include "data_type.h"
+
+namespace SPH
+{
+#ifdef SPHINXSYS_FAST_SMALL_MATRIX
+	//----------------------------------------------------------------------
+	//	unrolled implementations without branches or hidden loops
+	//----------------------------------------------------------------------
+	inline Mat2d fastMatrixProduct(const Mat2d &matrix_a, const Mat2d &matrix_b)
+	{
+		Mat2d product(0.0);
+		product[0][0] = matrix_a[0][0] * matrix_b[0][0] + matrix_a[0][1] * matrix_b[1][0];
+		product[0][1] = matrix_a[0][0] * matrix_b[0][1] + matrix_a[0][1] * matrix_b[1][1];
+		product[1][0] = matrix_a[1][0] * matrix_b[0][0] + matrix_a[1][1] * matrix_b[1][0];
+		product[1][1] = matrix_a[1][0] * matrix_b[0][1] + matrix_a[1][1] * matrix_b[1][1];
+		return product;
+	};
+
+	inline Mat3d fastMatrixProduct(const Mat3d &matrix_a, const Mat3d &matrix_b)
+	{
+		Mat3d product(0.0);
+		for (int i = 0; i != 3; ++i)
+		{
+			product[i][0] = matrix_a[i][0] * matrix_b[0][0] + matrix_a[i][1] * matrix_b[1][0] + matrix_a[i][2] * matrix_b[2][0];
+			product[i][1] = matrix_a[i][0] * matrix_b[0][1] + matrix_a[i][1] * matrix_b[1][1] + matrix_a[i][2] * matrix_b[2][1];
+			product[i][2] = matrix_a[i][0] * matrix_b[0][2] + matrix_a[i][1] * matrix_b[1][2] + matrix_a[i][2] * matrix_b[2][2];
+		}
+		return product;
+	};
+
+	inline Vec2d fastMatrixVectorProduct(const Mat2d &matrix, const Vec2d &vector)
+	{
+		return Vec2d(matrix[0][0] * vector[0] + matrix[0][1] * vector[1],
+					 matrix[1][0] * vector[0] + matrix[1][1] * vector[1]);
+	};
+
+	inline Vec3d fastMatrixVectorProduct(const Mat3d &matrix, const Vec3d &vector)
+	{
+		return Vec3d(matrix[0][0] * vector[0] + matrix[0][1] * vector[1] + matrix[0][2] * vector[2],
+					 matrix[1][0] * vector[0] + matrix[1][1] * vector[1] + matrix[1][2] * vector[2],
+					 matrix[2][0] * vector[0] + matrix[2][1] * vector[1] + matrix[2][2] * vector[2]);
+	};
+
+	inline Mat2d fastInverse(const Mat2d &matrix)
+	{
+		Real one_over_determinant =
+			1.0 / (matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0]);
+		Mat2d inverse(0.0);
+		inverse[0][0] = matrix[1][1] * one_over_determinant;
+		inverse[0][1] = -matrix[0][1] * one_over_determinant;
+		inverse[1][0] = -matrix[1][0] * one_over_determinant;
+		inverse[1][1] = matrix[0][0] * one_over_determinant;
+		return inverse;
+	};
+
+	inline Mat3d fastInverse(const Mat3d &matrix)
+	{
+		Real cofactor_00 = matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1];
+		Real cofactor_01 = matrix[1][2] * matrix[2][0] - matrix[1][0] * matrix[2][2];
+		Real cofactor_02 = matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0];
+		Real one_over_determinant =
+			1.0 / (matrix[0][0] * cofactor_00 + matrix[0][1] * cofactor_01 + matrix[0][2] * cofactor_02);
+		Mat3d inverse(0.0);
+		inverse[0][0] = cofactor_00 * one_over_determinant;
+		inverse[1][0] = cofactor_01 * one_over_determinant;
+		inverse[2][0] = cofactor_02 * one_over_determinant;
+		inverse[0][1] = (matrix[0][2] * matrix[2][1] - matrix[0][1] * matrix[2][2]) * one_over_determinant;
+		inverse[1][1] = (matrix[0][0] * matrix[2][2] - matrix[0][2] * matrix[2][0]) * one_over_determinant;
+		inverse[2][1] = (matrix[0][1] * matrix[2][0] - matrix[0][0] * matrix[2][1]) * one_over_determinant;
+		inverse[0][2] = (matrix[0][1] * matrix[1][2] - matrix[0][2] * matrix[1][1]) * one_over_determinant;
+		inverse[1][2] = (matrix[0][2] * matrix[1][0] - matrix[0][0] * matrix[1][2]) * one_over_determinant;
+		inverse[2][2] = (matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0]) * one_over_determinant;
+		return inverse;
+	};
+#else
+	//----------------------------------------------------------------------
+	//	reference implementations forwarding to the SimTK operators
+	//----------------------------------------------------------------------
+	inline Mat2d fastMatrixProduct(const Mat2d &matrix_a, const Mat2d &matrix_b) { return matrix_a * matrix_b; };
+	inline Mat3d fastMatrixProduct(const Mat3d &matrix_a, const Mat3d &matrix_b) { return matrix_a * matrix_b; };
+	inline Vec2d fastMatrixVectorProduct(const Mat2d &matrix, const Vec2d &vector) { return matrix * vector; };
+	inline Vec3d fastMatrixVectorProduct(const Mat3d &matrix, const Vec3d &vector) { return matrix * vector; };
+	inline Mat2d fastInverse(const Mat2d &matrix) { return SimTK::inverse(matrix); };
+	inline Mat3d fastInverse(const Mat3d &matrix) { return SimTK::inverse(matrix); };
+#endif
+
+	/** the rotation factor of the polar decomposition F = R U, obtained by
+	 * the Newton iteration R <- (R + R^-T) / 2 starting from F itself. */
+	inline Mat2d fastPolarRotation(const Mat2d &deformation)
+	{
+		Mat2d rotation = deformation;
+		for (int iteration = 0; iteration != 20; ++iteration)
+		{
+			Mat2d updated_rotation = 0.5 * (rotation + ~fastInverse(rotation));
+			Real residual = 0.0;
+			for (int i = 0; i != 2; ++i)
+				for (int j = 0; j != 2; ++j)
+					residual += ABS(updated_rotation[i][j] - rotation[i][j]);
+			rotation = updated_rotation;
+			if (residual < Eps)
+				break;
+		}
+		return rotation;
+	};
+
+	inline Mat3d fastPolarRotation(const Mat3d &deformation)
+	{
+		Mat3d rotation = deformation;
+		for (int iteration = 0; iteration != 20; ++iteration)
+		{
+			Mat3d updated_rotation = 0.5 * (rotation + ~fastInverse(rotation));
+			Real residual = 0.0;
+			for (int i = 0; i != 3; ++i)
+				for (int j = 0; j != 3; ++j)
+					residual += ABS(updated_rotation[i][j] - rotation[i][j]);
+			rotation = updated_rotation;
+			if (residual < Eps)
+				break;
+		}
+		return rotation;
+	};
+}
+#endif // SMALL_MATRIX_FUNCTIONS_H
@@ -67,6 +67,26 @@ namespace SPH
 	using ConcurrentCellLists = LargeVec<CellList *>;
 	/** Split cell list for split algorithms. */
 	using SplitCellLists = StdVec<ConcurrentCellLists>;
+	/** Contiguous particle-index range as the pair of first entry and one past the last entry. */
+	using IndexRange = std::pair<size_t, size_t>;
+	/** Flat alternative of the split cell lists: for each split level the index
+	 * ranges of its cells into a cell-contiguous particle-index array, so that
+	 * a splitting level is swept by streaming scans of one flat array instead
+	 * of chasing cell pointers. Only filled by cell list rebuilds which provide
+	 * the contiguous storage. */
+	struct SplitCellIndexRanges
+	{
+		StdVec<StdVec<IndexRange>> level_ranges_;
+		/** the cell-contiguous particle indexes the ranges refer to */
+		StdLargeVec<size_t> *cell_contiguous_indexes_ = nullptr;
+
+		bool Filled() const { return cell_contiguous_indexes_ != nullptr; };
+		void clear()
+		{
+			level_ranges_.clear();
+			cell_contiguous_indexes_ = nullptr;
+		};
+	};
 	/** Pair of point and volume. */
 	using PositionsVolumes = StdVec<std::pair<Vecd, Real>>;
 
@@ -89,6 +109,69 @@ namespace SPH
 		}
 	};
 
+	/** sum the allocated bytes of all variables of one data type,
+	 * for memory accounting */
+	template <typename VariableType>
+	struct sumParticleDataFootprint
+	{
+		void operator()(ParticleData &particle_data, size_t *footprint_in_bytes) const
+		{
+			constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+			for (StdLargeVec<VariableType> *variable : std::get<type_index>(particle_data))
+				*footprint_in_bytes += variable->capacity() * sizeof(VariableType);
+		};
+	};
+
+	/**
+	 * @class ScratchBufferRegistry
+	 * @brief Named reusable buffers for non-persistent intermediate data,
+	 * in the style of the registered particle variables, but not taking part
+	 * in sorting, restart or state output. A buffer is created at its first
+	 * request and retains its high-water size afterwards, so that dynamics
+	 * obtaining their temporaries here do not allocate on each execution.
+	 */
+	class ScratchBufferRegistry
+	{
+	public:
+		ScratchBufferRegistry(){};
+		~ScratchBufferRegistry(){};
+
+		/** obtain the named buffer with at least the given size */
+		template <typename VariableType>
+		StdLargeVec<VariableType> &obtainBuffer(const std::string &buffer_name, size_t buffer_size)
+		{
+			constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+			std::map<std::string, size_t> &buffer_map = buffer_maps_[type_index];
+			StdVec<StdLargeVec<VariableType> *> &buffers = std::get<type_index>(buffer_data_);
+			if (buffer_map.find(buffer_name) == buffer_map.end())
+			{
+				SharedPtr<StdLargeVec<VariableType>> new_buffer = makeShared<StdLargeVec<VariableType>>();
+				buffer_map.insert(make_pair(buffer_name, buffers.size()));
+				buffers.push_back(new_buffer.get());
+				buffer_keeper_.push_back(new_buffer);
+			}
+
+			StdLargeVec<VariableType> &buffer = *buffers[buffer_map[buffer_name]];
+			if (buffer.size() < buffer_size)
+				buffer.resize(buffer_size);
+			return buffer;
+		};
+
+		/** allocated bytes of all buffers, for memory accounting */
+		size_t MemoryFootprint()
+		{
+			size_t footprint_in_bytes = 0;
+			ParticleDataOperation<sumParticleDataFootprint> sum_footprint;
+			sum_footprint(buffer_data_, &footprint_in_bytes);
+			return footprint_in_bytes;
+		};
+
+	protected:
+		ParticleData buffer_data_;				/**< the buffers ordered by their data type. */
+		ParticleDataMap buffer_maps_;			/**< maps from buffer names to the indexes within each type. */
+		StdVec<SharedPtr<void>> buffer_keeper_; /**< type-erased ownership of the buffers. */
+	};
+
 	template <typename VariableType>
 	struct swapParticleDataValue
 	{
@@ -105,6 +188,44 @@ namespace SPH
 		};
 	};
 	
+	template <typename VariableType>
+	struct gatherParticleDataValue
+	{
+		void operator()(ParticleData &particle_data, const StdLargeVec<size_t> &index_mapping,
+						size_t total_size, ScratchBufferRegistry &scratch_buffers) const
+		{
+			constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+
+			StdVec<StdLargeVec<VariableType> *> variables = std::get<type_index>(particle_data);
+			StdLargeVec<VariableType> &gathered_values =
+				scratch_buffers.obtainBuffer<VariableType>("SortingGatheredValues", total_size);
+			for (size_t i = 0; i != variables.size(); ++i)
+			{
+				StdLargeVec<VariableType> &variable = *variables[i];
+				parallel_for(
+					blocked_range<size_t>(0, total_size),
+					[&](const blocked_range<size_t> &r)
+					{
+						for (size_t index = r.begin(); index != r.end(); ++index)
+						{
+							gathered_values[index] = variable[index_mapping[index]];
+						}
+					},
+					ap);
+				parallel_for(
+					blocked_range<size_t>(0, total_size),
+					[&](const blocked_range<size_t> &r)
+					{
+						for (size_t index = r.begin(); index != r.end(); ++index)
+						{
+							variable[index] = gathered_values[index];
+						}
+					},
+					ap);
+			}
+		};
+	};
+
 	/** operation by looping or going through a particle data map */
 	template <typename VariableType>
 	struct loopParticleDataMap
@@ -397,6 +397,18 @@ namespace SPH
 		return {sorted_values[0], sorted_values[1], sorted_values[2]};
 	}
 	//=================================================================================================//
+	Real getVorticityFromVelocityGradient(const Mat2d& velocity_gradient)
+	{
+		return velocity_gradient(1, 0) - velocity_gradient(0, 1);
+	}
+	//=================================================================================================//
+	Vec3d getVorticityFromVelocityGradient(const Mat3d& velocity_gradient)
+	{
+		return Vec3d(velocity_gradient(2, 1) - velocity_gradient(1, 2),
+					 velocity_gradient(0, 2) - velocity_gradient(2, 0),
+					 velocity_gradient(1, 0) - velocity_gradient(0, 1));
+	}
+	//=================================================================================================//
 	Real MinimumDimension(const BoundingBox &bbox)
 	{
 		return getMinAbsoluteElement(bbox.second - bbox.first);
@@ -100,6 +100,12 @@ namespace SPH {
 	Vec2d getPrincipalValuesFromMatrix(const Mat2d& A);
 	Vec3d getPrincipalValuesFromMatrix(const Mat3d& A);
 
+	/** vorticity, i.e. the curl of the velocity, from the velocity gradient tensor
+	 * with the convention that element (i, j) is the derivative of velocity
+	 * component i along direction j */
+	Real getVorticityFromVelocityGradient(const Mat2d& velocity_gradient);
+	Vec3d getVorticityFromVelocityGradient(const Mat3d& velocity_gradient);
+
 	/** obtain minimum dimension of a bounding box */
 	Real MinimumDimension(const BoundingBox &bbox);
 }
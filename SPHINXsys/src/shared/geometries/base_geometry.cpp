@@ -4,6 +4,9 @@
  */
 
 #include "base_geometry.h"
+
+#include <algorithm>
+
 namespace SPH
 {
 	//=================================================================================================//
@@ -39,6 +42,27 @@ namespace SPH
 		return is_contain ? direction_to_surface : -1.0 * direction_to_surface;
 	}
 	//=================================================================================================//
+	void Shape::checkContainBatch(const StdVec<Vecd> &pnts, StdVec<int> &contain_flags, bool BOUNDARY_INCLUDED)
+	{
+		contain_flags.resize(pnts.size());
+		for (size_t index = 0; index != pnts.size(); ++index)
+			contain_flags[index] = checkContain(pnts[index], BOUNDARY_INCLUDED) ? 1 : 0;
+	}
+	//=================================================================================================//
+	void Shape::findClosestPointBatch(const StdVec<Vecd> &input_pnts, StdVec<Vecd> &closest_points)
+	{
+		closest_points.resize(input_pnts.size());
+		for (size_t index = 0; index != input_pnts.size(); ++index)
+			closest_points[index] = findClosestPoint(input_pnts[index]);
+	}
+	//=================================================================================================//
+	void Shape::findSignedDistanceBatch(const StdVec<Vecd> &input_pnts, StdVec<Real> &signed_distances)
+	{
+		signed_distances.resize(input_pnts.size());
+		for (size_t index = 0; index != input_pnts.size(); ++index)
+			signed_distances[index] = findSignedDistance(input_pnts[index]);
+	}
+	//=================================================================================================//
 	bool BinaryShapes::isValid()
 	{
 		return  shapes_and_ops_.size() == 0 ? false : true;
@@ -62,8 +86,86 @@ namespace SPH
 		return BoundingBox(lower_bound, upper_bound);
 	}
 	//=================================================================================================//
+	void BinaryShapes::useBoundsScreening()
+	{
+		screened_shapes_.resize(shapes_and_ops_.size());
+		for (size_t index = 0; index != shapes_and_ops_.size(); ++index)
+		{
+			ScreenedShape &screened_shape = screened_shapes_[index];
+			screened_shape.shape_ = shapes_and_ops_[index].first;
+			screened_shape.op_ = shapes_and_ops_[index].second;
+			if (screened_shape.op_ != ShapeBooleanOps::add && screened_shape.op_ != ShapeBooleanOps::sub)
+			{
+				std::cout << "\n FAILURE: the boolean operation is not applicable!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				throw;
+			}
+			screened_shape.bounds_ = screened_shape.shape_->findBounds();
+			// a few probes at the center of the bounds rank the per-query cost
+			Vecd probe_point = 0.5 * (screened_shape.bounds_.first + screened_shape.bounds_.second);
+			tick_count start_time = tick_count::now();
+			for (size_t n = 0; n != 8; ++n)
+				screened_shape.shape_->checkContain(probe_point);
+			screened_shape.query_cost_ = (tick_count::now() - start_time).seconds();
+		}
+		// additions commute with each other, as do subtractions, but not across an
+		// operation change, so the cost ordering is restricted to runs of equal
+		// boolean operation to preserve the declared chain semantics
+		size_t run_begin = 0;
+		while (run_begin != screened_shapes_.size())
+		{
+			size_t run_end = run_begin + 1;
+			while (run_end != screened_shapes_.size() &&
+				   screened_shapes_[run_end].op_ == screened_shapes_[run_begin].op_)
+				++run_end;
+			std::stable_sort(screened_shapes_.begin() + run_begin, screened_shapes_.begin() + run_end,
+							 [](const ScreenedShape &a, const ScreenedShape &b)
+							 { return a.query_cost_ < b.query_cost_; });
+			run_begin = run_end;
+		}
+		query_cache_valid_ = true;
+	}
+	//=================================================================================================//
+	bool BinaryShapes::checkContainScreened(const Vecd &pnt)
+	{
+		bool exist = false;
+
+		for (size_t index = 0; index != screened_shapes_.size(); ++index)
+		{
+			const ScreenedShape &screened_shape = screened_shapes_[index];
+			// a point outside the cached bounds can not be inside the sub-shape, so
+			// both an addition and a subtraction leave the running result unchanged
+			bool within_bounds = true;
+			for (int j = 0; j != Dimensions; ++j)
+				if (pnt[j] < screened_shape.bounds_.first[j] || pnt[j] > screened_shape.bounds_.second[j])
+				{
+					within_bounds = false;
+					break;
+				}
+			if (!within_bounds)
+				continue;
+
+			if (screened_shape.op_ == ShapeBooleanOps::add)
+			{
+				// an addition can not change an already contained point
+				if (!exist)
+					exist = screened_shape.shape_->checkContain(pnt);
+			}
+			else
+			{
+				// a subtraction only acts on contained points
+				if (exist)
+					exist = !screened_shape.shape_->checkContain(pnt);
+			}
+		}
+		return exist;
+	}
+	//=================================================================================================//
 	bool BinaryShapes::checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED)
 	{
+		if (query_cache_valid_)
+			return checkContainScreened(pnt);
+
 		bool exist = false;
 		bool inside = false;
 
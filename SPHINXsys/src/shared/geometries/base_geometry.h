@@ -78,6 +78,15 @@ namespace SPH
 		/** Normal direction point toward outside of the complex shape. */
 		virtual Vecd findNormalDirection(const Vecd &input_pnt);
 
+		/** batched forms of the point queries: all points of a batch are handled
+		 * in one call, so that shapes which share work between the points, e.g.
+		 * a common coordinate transformation, amortize it over the batch.
+		 * The default implementations forward to the point-wise queries.
+		 * The output containers are resized to the batch size. */
+		virtual void checkContainBatch(const StdVec<Vecd> &pnts, StdVec<int> &contain_flags, bool BOUNDARY_INCLUDED = true);
+		virtual void findClosestPointBatch(const StdVec<Vecd> &input_pnts, StdVec<Vecd> &closest_points);
+		virtual void findSignedDistanceBatch(const StdVec<Vecd> &input_pnts, StdVec<Real> &signed_distances);
+
 	protected:
 		std::string name_;
 	};
@@ -93,8 +102,8 @@ namespace SPH
 	class BinaryShapes : public Shape
 	{
 	public:
-		BinaryShapes() : Shape("BinaryShapes"){};
-		explicit BinaryShapes(const std::string &shapes_name) : Shape(shapes_name){};
+		BinaryShapes() : Shape("BinaryShapes"), query_cache_valid_(false){};
+		explicit BinaryShapes(const std::string &shapes_name) : Shape(shapes_name), query_cache_valid_(false){};
 		virtual ~BinaryShapes(){};
 
 		template <class ShapeType, typename... Args>
@@ -103,6 +112,7 @@ namespace SPH
 			Shape *shape = shapes_ptr_keeper_.createPtr<ShapeType>(std::forward<Args>(args)...);
 			ShapeAndOp shape_and_op(shape, ShapeBooleanOps::add);
 			shapes_and_ops_.push_back(shape_and_op);
+			query_cache_valid_ = false;
 		};
 
 		template <class ShapeType, typename... Args>
@@ -111,6 +121,7 @@ namespace SPH
 			Shape *shape = shapes_ptr_keeper_.createPtr<ShapeType>(std::forward<Args>(args)...);
 			ShapeAndOp shape_and_op(shape, ShapeBooleanOps::sub);
 			shapes_and_ops_.push_back(shape_and_op);
+			query_cache_valid_ = false;
 		};
 
 		virtual bool isValid() override;
@@ -120,10 +131,30 @@ namespace SPH
 		Shape *getShapeByName(const std::string &shape_name);
 		ShapeAndOp *getShapeAndOpByName(const std::string &shape_name);
 		size_t getShapeIndexByName(const std::string &shape_name);
+		/** cache the bounding box of every sub-shape so that containment queries
+		 * can skip sub-shapes which can not change the result, and order runs of
+		 * equal boolean operation by measured query cost so that cheap shapes,
+		 * e.g. boxes, decide before expensive ones, e.g. triangle meshes, are
+		 * consulted. To be called after the last sub-shape has been defined;
+		 * modifying the shape list afterwards falls back to the plain sweep. */
+		void useBoundsScreening();
+		bool usingBoundsScreening() { return query_cache_valid_; };
 
 	protected:
 		UniquePtrKeepers<Shape> shapes_ptr_keeper_;
 		StdVec<ShapeAndOp> shapes_and_ops_;
+		/** a sub-shape with its boolean operation, cached bounds and measured query cost */
+		struct ScreenedShape
+		{
+			Shape *shape_;
+			ShapeBooleanOps op_;
+			BoundingBox bounds_;
+			Real query_cost_;
+		};
+		bool query_cache_valid_;
+		StdVec<ScreenedShape> screened_shapes_;
+
+		bool checkContainScreened(const Vecd &pnt);
 	};
 
 	/**
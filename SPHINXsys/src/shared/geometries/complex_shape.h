@@ -51,6 +51,7 @@ namespace SPH
 			LevelSetShape *level_set_shape = shapes_ptr_keeper_[index].createPtr<LevelSetShape>(
 				sph_body, *shapes_and_ops_[index].first, std::forward<ConstructorArgs>(args)...);
 			shapes_and_ops_[index].first = level_set_shape;
+			query_cache_valid_ = false;
 			return level_set_shape;
 		};
 	};
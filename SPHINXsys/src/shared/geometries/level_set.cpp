@@ -7,8 +7,21 @@
 #include "adaptation.h"
 #include "mesh_with_data_packages.hpp"
 
+#include <sstream>
+/** Macro for APPLE compilers*/
+#ifdef __APPLE__
+#include <boost/filesystem.hpp>
+namespace fs = boost::filesystem;
+#else
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#endif
+
 namespace SPH
 {
+	//=================================================================================================//
+	bool NarrowBandLevelSet::switched_on_ = false;
+	int NarrowBandLevelSet::band_width_ = 4;
 	//=================================================================================================//
 	LevelSetDataPackage::
 		LevelSetDataPackage() : BaseDataPackage<4, 6>(), is_core_pkg_(false) {}
@@ -65,26 +78,159 @@ namespace SPH
 		: MeshWithDataPackages<BaseLevelSet, LevelSetDataPackage>(tentative_bounds, data_spacing, buffer_size,
 																  shape, sph_adaptation),
 		  global_h_ratio_(sph_adaptation.ReferenceSpacing() / data_spacing),
-		  kernel_(*sph_adaptation.getKernel())
+		  kernel_(*sph_adaptation.getKernel()),
+		  use_narrow_band_(false), band_width_(0),
+		  coarse_spacing_(0.0), band_distance_(0.0), number_of_coarse_nodes_(0)
 	{
 		Real far_field_distance = grid_spacing_ * (Real)buffer_width_;
 		initializeASingularDataPackage(-far_field_distance);
 		initializeASingularDataPackage(far_field_distance);
+		// the level set is static after construction, so its packages
+		// are always compacted into the contiguous Z-order slab
+		useSlabAllocation();
 	}
 	//=================================================================================================//
 	LevelSet::LevelSet(BoundingBox tentative_bounds, Real data_spacing,
 					   Shape &shape, SPHAdaptation &sph_adaptation)
 		: LevelSet(tentative_bounds, data_spacing, 4, shape, sph_adaptation)
 	{
-		MeshFunctor initialize_data_in_a_cell = std::bind(&LevelSet::initializeDataInACell, this, _1, _2);
+		if (NarrowBandLevelSet::isSwitchedOn())
+		{
+			use_narrow_band_ = true;
+			band_width_ = SMAX(NarrowBandLevelSet::BandWidth(), 2);
+			initializeCoarseLevelSet();
+		}
+
+		size_t shape_signature = generateShapeSignature();
+		std::string cache_filefullpath = CacheFilePath(shape_signature);
+		if (readCacheFile(cache_filefullpath, shape_signature))
+			return;
+
+		MeshFunctor initialize_data_in_a_cell =
+			use_narrow_band_
+				? MeshFunctor(std::bind(&LevelSet::initializeDataInACellNarrowBand, this, _1, _2))
+				: MeshFunctor(std::bind(&LevelSet::initializeDataInACell, this, _1, _2));
 		MeshIterator_parallel(Vecu(0), number_of_cells_, initialize_data_in_a_cell);
 		finishDataPackages();
+		writeCacheFile(cache_filefullpath, shape_signature);
+	}
+	//=================================================================================================//
+	void LevelSet::initializeCoarseLevelSet()
+	{
+		coarse_spacing_ = (Real)band_width_ * grid_spacing_;
+		// the band covers band_width_ cells on both sides of the zero level plus
+		// one coarse spacing as margin for the interpolation error of the scan
+		band_distance_ = (Real)band_width_ * grid_spacing_ + coarse_spacing_;
+		size_t total_number_of_nodes = 1;
+		for (int k = 0; k != Vecd(0).size(); ++k)
+		{
+			number_of_coarse_nodes_[k] = number_of_cells_[k] / (size_t)band_width_ + 2;
+			total_number_of_nodes *= number_of_coarse_nodes_[k];
+		}
+		coarse_phi_.resize(total_number_of_nodes);
+		MeshFunctor initialize_a_coarse_node = std::bind(&LevelSet::initializeACoarseNode, this, _1, _2);
+		MeshIterator_parallel(Vecu(0), number_of_coarse_nodes_, initialize_a_coarse_node);
+	}
+	//=================================================================================================//
+	void LevelSet::initializeACoarseNode(const Vecu &node_index, Real dt)
+	{
+		Vecd node_position(0);
+		for (int k = 0; k != node_position.size(); ++k)
+			node_position[k] = mesh_lower_bound_[k] + (Real)node_index[k] * coarse_spacing_;
+		coarse_phi_[CoarseNodeLinearIndex(node_index)] = shape_.findSignedDistance(node_position);
+	}
+	//=================================================================================================//
+	size_t LevelSet::CoarseNodeLinearIndex(const Vecu &node_index)
+	{
+		size_t linear_index = node_index[0];
+		for (int k = 1; k != Vecd(0).size(); ++k)
+			linear_index = linear_index * number_of_coarse_nodes_[k] + node_index[k];
+		return linear_index;
+	}
+	//=================================================================================================//
+	Real LevelSet::probeCoarseLevelSet(const Vecd &position)
+	{
+		int dimension = position.size();
+		Vecu base_node(0);
+		Vecd alpha(0);
+		for (int k = 0; k != dimension; ++k)
+		{
+			Real normalized = (position[k] - mesh_lower_bound_[k]) / coarse_spacing_;
+			int node = SMIN(SMAX((int)floor(normalized), 0), (int)number_of_coarse_nodes_[k] - 2);
+			base_node[k] = (size_t)node;
+			alpha[k] = SMIN(SMAX(normalized - (Real)node, Real(0)), Real(1));
+		}
+
+		Real probed_value = 0.0;
+		for (int corner = 0; corner != (1 << dimension); ++corner)
+		{
+			Real weight = 1.0;
+			Vecu corner_node = base_node;
+			for (int k = 0; k != dimension; ++k)
+			{
+				if (corner >> k & 1)
+				{
+					corner_node[k]++;
+					weight *= alpha[k];
+				}
+				else
+				{
+					weight *= 1.0 - alpha[k];
+				}
+			}
+			probed_value += weight * coarse_phi_[CoarseNodeLinearIndex(corner_node)];
+		}
+		return probed_value;
+	}
+	//=================================================================================================//
+	void LevelSet::initializeDataInACellNarrowBand(const Vecu &cell_index, Real dt)
+	{
+		Vecd cell_position = CellPositionFromIndex(cell_index);
+		Real coarse_phi = probeCoarseLevelSet(cell_position);
+		if (fabs(coarse_phi) < band_distance_)
+		{
+			initializeDataInACell(cell_index, dt);
+			return;
+		}
+		// the far field never consults the geometry, its sign comes from the coarse scan
+		LevelSetDataPackage *singular_data_pkg =
+			coarse_phi < 0.0 ? singular_data_pkgs_addrs_[0] : singular_data_pkgs_addrs_[1];
+		assignDataPackageAddress(cell_index, singular_data_pkg);
+	}
+	//=================================================================================================//
+	bool LevelSet::growBandAt(const Vecu &cell_index)
+	{
+		// packages adjacent to the mesh bound can not resolve their neighbor addresses
+		for (int k = 0; k != Vecd(0).size(); ++k)
+			if (cell_index[k] < 1 || cell_index[k] + 2 > number_of_cells_[k])
+				return false;
+
+		std::lock_guard<std::mutex> lock(band_growth_mutex_);
+		if (DataPackageFromCellIndex(cell_index)->is_inner_pkg_)
+			return true; // grown by a concurrent probe already
+
+		LevelSetDataPackage &new_data_pkg = *data_pkg_pool_.malloc_concurrent();
+		Vecd cell_position = CellPositionFromIndex(cell_index);
+		new_data_pkg.initializePackageGeometry(GridPositionFromCellPosition(cell_position), data_spacing_);
+		new_data_pkg.initializeBasicData(shape_);
+		new_data_pkg.pkg_index_ = cell_index;
+		new_data_pkg.is_inner_pkg_ = true;
+		initializePackageAddresses(&new_data_pkg, cell_index);
+		new_data_pkg.computeLevelSetGradient();
+		// the band cell is outside the kernel support of the zero level
+		new_data_pkg.setSaturatedKernelIntegrals();
+		// the package is published only after it is complete, concurrent probes
+		// read either the former singular entry or the finished package
+		assignDataPackageAddress(cell_index, &new_data_pkg);
+		return true;
 	}
 	//=================================================================================================//
 	void LevelSet::finishDataPackages()
 	{
 		MeshFunctor tag_a_cell_inner_pkg = std::bind(&LevelSet::tagACellIsInnerPackage, this, _1, _2);
 		MeshIterator_parallel(Vecu(0), number_of_cells_, tag_a_cell_inner_pkg);
+		if (use_slab_allocation_)
+			compactDataPackages();
 		MeshFunctor initial_address_in_a_cell = std::bind(&LevelSet::initializeAddressesInACell, this, _1, _2);
 		MeshIterator_parallel(Vecu(0), number_of_cells_, initial_address_in_a_cell);
 		updateLevelSetGradient();
@@ -96,6 +242,28 @@ namespace SPH
 		initializePackageAddressesInACell(cell_index);
 	}
 	//=================================================================================================//
+	void LevelSet::compactDataPackages()
+	{
+		// the core packages not tagged as inner ones live in the memory pool too,
+		// so they are appended behind the inner packages before the relocation
+		StdVec<LevelSetDataPackage *> scattered_pkgs(inner_data_pkgs_.begin(), inner_data_pkgs_.end());
+		for (size_t n = 0; n != core_data_pkgs_.size(); ++n)
+		{
+			if (!core_data_pkgs_[n]->is_inner_pkg_)
+				scattered_pkgs.push_back(core_data_pkgs_[n]);
+		}
+		inner_data_pkgs_.clear();
+		core_data_pkgs_.clear();
+		compactDataPackagesIntoSlab(scattered_pkgs,
+									[&](LevelSetDataPackage *relocated_pkg)
+									{
+										if (relocated_pkg->is_inner_pkg_)
+											inner_data_pkgs_.push_back(relocated_pkg);
+										if (relocated_pkg->is_core_pkg_)
+											core_data_pkgs_.push_back(relocated_pkg);
+									});
+	}
+	//=================================================================================================//
 	void LevelSet::updateLevelSetGradient()
 	{
 		PackageFunctor<void, LevelSetDataPackage> update_none_normalized_normal_diraction =
@@ -133,10 +301,98 @@ namespace SPH
 	//=================================================================================================//
 	Real LevelSet::probeSignedDistance(const Vecd &position)
 	{
+		if (use_narrow_band_)
+		{
+			Vecu cell_index = CellIndexFromPosition(position);
+			if (!DataPackageFromCellIndex(cell_index)->is_inner_pkg_)
+			{
+				Real coarse_phi = probeCoarseLevelSet(position);
+				if (fabs(coarse_phi) >= band_distance_ || !growBandAt(cell_index))
+					return coarse_phi;
+			}
+		}
 		return probeMesh<Real, LevelSetDataPackage::PackageDataAddress<Real>,
 						 &LevelSetDataPackage::phi_addrs_>(position);
 	}
 	//=================================================================================================//
+	void BaseLevelSet::probeSignedDistances(const StdLargeVec<Vecd> &positions, StdLargeVec<Real> &signed_distances)
+	{
+		signed_distances.resize(positions.size());
+		parallel_for(
+			blocked_range<size_t>(0, positions.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+					signed_distances[q] = probeSignedDistance(positions[q]);
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void BaseLevelSet::probeLevelSetGradients(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &gradients)
+	{
+		gradients.resize(positions.size());
+		parallel_for(
+			blocked_range<size_t>(0, positions.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+					gradients[q] = probeLevelSetGradient(positions[q]);
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void BaseLevelSet::probeNormalDirections(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &normal_directions)
+	{
+		normal_directions.resize(positions.size());
+		parallel_for(
+			blocked_range<size_t>(0, positions.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+					normal_directions[q] = probeNormalDirection(positions[q]);
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void LevelSet::probeSignedDistances(const StdLargeVec<Vecd> &positions, StdLargeVec<Real> &signed_distances)
+	{
+		// the narrow band answers per position, for the coarse fallback and the lazy growth
+		if (use_narrow_band_)
+		{
+			BaseLevelSet::probeSignedDistances(positions, signed_distances);
+			return;
+		}
+		probeMeshBatch<Real, LevelSetDataPackage::PackageDataAddress<Real>,
+					   &LevelSetDataPackage::phi_addrs_>(positions, signed_distances);
+	}
+	//=================================================================================================//
+	void LevelSet::probeLevelSetGradients(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &gradients)
+	{
+		probeMeshBatch<Vecd, LevelSetDataPackage::PackageDataAddress<Vecd>,
+					   &LevelSetDataPackage::phi_gradient_addrs_>(positions, gradients);
+	}
+	//=================================================================================================//
+	void LevelSet::probeNormalDirections(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &normal_directions)
+	{
+		// the gradients are answered in data-package order, only the rare
+		// degenerate entries fall back on the jittering per-position probe
+		probeLevelSetGradients(positions, normal_directions);
+		Real threshold = 1.0e-2 * data_spacing_;
+		parallel_for(
+			blocked_range<size_t>(0, positions.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+				{
+					Vecd gradient = normal_directions[q];
+					normal_directions[q] = gradient.norm() < threshold
+											   ? probeNormalDirection(positions[q])
+											   : gradient.normalize();
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
 	Real LevelSet::probeKernelIntegral(const Vecd &position, Real h_ratio)
 	{
 		return probeMesh<Real, LevelSetDataPackage::PackageDataAddress<Real>,
@@ -171,8 +427,10 @@ namespace SPH
 	{
 		PackageFunctor<void, LevelSetDataPackage> reinitialize_levelset =
 			std::bind(&LevelSet::stepReinitializationForAPackage, this, _1, _2);
+		if (LoopTuning::Enabled() && !reinitialize_loop_tuner_.Keyed())
+			reinitialize_loop_tuner_.assignPersistenceKey(typeid(*this), "reinitialize", inner_data_pkgs_.size());
 		for (size_t i = 0; i < 50; ++i)
-			PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, reinitialize_levelset);
+			PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, reinitialize_levelset, reinitialize_loop_tuner_);
 	}
 	//=================================================================================================//
 	void LevelSet::markNearInterface(Real small_shift_factor)
@@ -219,9 +477,7 @@ namespace SPH
 	//=================================================================================================//
 	LevelSetDataPackage *LevelSet::createDataPackage(const Vecu &cell_index, const Vecd &cell_position)
 	{
-		mutex_my_pool.lock();
-		LevelSetDataPackage &new_data_pkg = *data_pkg_pool_.malloc();
-		mutex_my_pool.unlock();
+		LevelSetDataPackage &new_data_pkg = *data_pkg_pool_.malloc_concurrent();
 		Vecd pkg_lower_bound = GridPositionFromCellPosition(cell_position);
 		new_data_pkg.initializePackageGeometry(pkg_lower_bound, data_spacing_);
 		new_data_pkg.initializeBasicData(shape_);
@@ -272,6 +528,190 @@ namespace SPH
 		}
 	}
 	//=============================================================================================//
+	size_t LevelSet::generateShapeSignature()
+	{
+		// fingerprint the shape by probing its signed distance at a fixed
+		// pseudo-random point set within its bounds, and mix in the data
+		// spacing, so that the signature is stable for unchanged geometries
+		// and differs between resolutions
+		BoundingBox bounds = shape_.findBounds();
+		uint64_t signature = 14695981039346656037ULL;
+		uint64_t state = 88172645463325252ULL;
+		auto hashBytes = [&signature](const void *data, size_t size)
+		{
+			const unsigned char *bytes = static_cast<const unsigned char *>(data);
+			for (size_t b = 0; b != size; ++b)
+			{
+				signature ^= bytes[b];
+				signature *= 1099511628211ULL;
+			}
+		};
+		for (int n = 0; n != 128; ++n)
+		{
+			Vecd probe_point(0);
+			for (int k = 0; k != probe_point.size(); ++k)
+			{
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				Real alpha = (Real)(state % 1048576) / (Real)1048576;
+				probe_point[k] = bounds.first[k] + alpha * (bounds.second[k] - bounds.first[k]);
+			}
+			Real signed_distance = shape_.findSignedDistance(probe_point);
+			hashBytes(&signed_distance, sizeof(signed_distance));
+		}
+		hashBytes(&data_spacing_, sizeof(data_spacing_));
+		// narrow band constructions cache a different far field
+		if (use_narrow_band_)
+			hashBytes(&band_width_, sizeof(band_width_));
+		return signature;
+	}
+	//=============================================================================================//
+	std::string LevelSet::CacheFilePath(size_t shape_signature)
+	{
+		std::string cache_folder = "./reload";
+		if (!fs::exists(cache_folder))
+		{
+			fs::create_directory(cache_folder);
+		}
+		std::ostringstream file_name;
+		file_name << cache_folder << "/" << Name() << "_" << shape_.getName()
+				  << "_" << std::hex << (uint64_t)shape_signature << "_lsc.bin";
+		return file_name.str();
+	}
+	//=============================================================================================//
+	bool LevelSet::readCacheFile(const std::string &filefullpath, size_t shape_signature)
+	{
+		if (!fs::exists(filefullpath))
+			return false;
+
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+		uint32_t version = 0;
+		uint64_t signature = 0;
+		uint32_t dimensions = 0;
+		uint32_t package_size = 0;
+		Real data_spacing = 0;
+		in_file.read(reinterpret_cast<char *>(&version), sizeof(version));
+		in_file.read(reinterpret_cast<char *>(&signature), sizeof(signature));
+		in_file.read(reinterpret_cast<char *>(&dimensions), sizeof(dimensions));
+		in_file.read(reinterpret_cast<char *>(&package_size), sizeof(package_size));
+		in_file.read(reinterpret_cast<char *>(&data_spacing), sizeof(data_spacing));
+		if (!in_file.good() || version != (uint32_t)cache_file_version_ || signature != shape_signature ||
+			dimensions != (uint32_t)Vecd(0).size() || package_size != (uint32_t)pkg_size_ ||
+			data_spacing != data_spacing_)
+			return false;
+		size_t total_number_of_cells = 1;
+		for (int k = 0; k != Vecd(0).size(); ++k)
+		{
+			uint64_t cells = 0;
+			in_file.read(reinterpret_cast<char *>(&cells), sizeof(cells));
+			if (cells != number_of_cells_[k])
+				return false;
+			total_number_of_cells *= number_of_cells_[k];
+		}
+
+		std::cout << "\n Reloading level set of " << shape_.getName()
+				  << " from the cache file:" << filefullpath << std::endl;
+		for (size_t i = 0; i != total_number_of_cells; ++i)
+		{
+			Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, i);
+			uint8_t cell_tag = 0;
+			in_file.read(reinterpret_cast<char *>(&cell_tag), sizeof(cell_tag));
+			if (cell_tag < 2)
+			{
+				assignDataPackageAddress(cell_index, singular_data_pkgs_addrs_[cell_tag]);
+				continue;
+			}
+
+			LevelSetDataPackage &new_data_pkg = *data_pkg_pool_.malloc();
+			Vecd cell_position = CellPositionFromIndex(cell_index);
+			new_data_pkg.initializePackageGeometry(GridPositionFromCellPosition(cell_position), data_spacing_);
+			uint8_t is_core_pkg = 0;
+			uint8_t is_inner_pkg = 0;
+			in_file.read(reinterpret_cast<char *>(&is_core_pkg), sizeof(is_core_pkg));
+			in_file.read(reinterpret_cast<char *>(&is_inner_pkg), sizeof(is_inner_pkg));
+			in_file.read(reinterpret_cast<char *>(&new_data_pkg.phi_), sizeof(new_data_pkg.phi_));
+			in_file.read(reinterpret_cast<char *>(&new_data_pkg.phi_gradient_), sizeof(new_data_pkg.phi_gradient_));
+			in_file.read(reinterpret_cast<char *>(&new_data_pkg.kernel_weight_), sizeof(new_data_pkg.kernel_weight_));
+			in_file.read(reinterpret_cast<char *>(&new_data_pkg.kernel_gradient_), sizeof(new_data_pkg.kernel_gradient_));
+			in_file.read(reinterpret_cast<char *>(&new_data_pkg.near_interface_id_), sizeof(new_data_pkg.near_interface_id_));
+			new_data_pkg.pkg_index_ = cell_index;
+			new_data_pkg.is_core_pkg_ = is_core_pkg != 0;
+			new_data_pkg.is_inner_pkg_ = is_inner_pkg != 0;
+			assignDataPackageAddress(cell_index, &new_data_pkg);
+			if (new_data_pkg.is_core_pkg_)
+				core_data_pkgs_.push_back(&new_data_pkg);
+			if (new_data_pkg.is_inner_pkg_)
+				inner_data_pkgs_.push_back(&new_data_pkg);
+		}
+		if (!in_file.good())
+		{
+			std::cout << "\n Error: the level set cache file:" << filefullpath << " is corrupted" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		in_file.close();
+
+		if (use_slab_allocation_)
+			compactDataPackages();
+
+		// the cached data already contains the gradients and kernel integrals,
+		// only the package addresses need to be rebuilt
+		MeshFunctor initial_address_in_a_cell = std::bind(&LevelSet::initializeAddressesInACell, this, _1, _2);
+		MeshIterator_parallel(Vecu(0), number_of_cells_, initial_address_in_a_cell);
+		return true;
+	}
+	//=============================================================================================//
+	void LevelSet::writeCacheFile(const std::string &filefullpath, size_t shape_signature)
+	{
+		if (fs::exists(filefullpath))
+		{
+			fs::remove(filefullpath);
+		}
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+		uint32_t version = cache_file_version_;
+		uint64_t signature = shape_signature;
+		uint32_t dimensions = Vecd(0).size();
+		uint32_t package_size = pkg_size_;
+		out_file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+		out_file.write(reinterpret_cast<const char *>(&signature), sizeof(signature));
+		out_file.write(reinterpret_cast<const char *>(&dimensions), sizeof(dimensions));
+		out_file.write(reinterpret_cast<const char *>(&package_size), sizeof(package_size));
+		out_file.write(reinterpret_cast<const char *>(&data_spacing_), sizeof(data_spacing_));
+		size_t total_number_of_cells = 1;
+		for (int k = 0; k != Vecd(0).size(); ++k)
+		{
+			uint64_t cells = number_of_cells_[k];
+			out_file.write(reinterpret_cast<const char *>(&cells), sizeof(cells));
+			total_number_of_cells *= number_of_cells_[k];
+		}
+
+		for (size_t i = 0; i != total_number_of_cells; ++i)
+		{
+			Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, i);
+			LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(cell_index);
+			if (data_pkg == singular_data_pkgs_addrs_[0] || data_pkg == singular_data_pkgs_addrs_[1])
+			{
+				uint8_t cell_tag = data_pkg == singular_data_pkgs_addrs_[0] ? 0 : 1;
+				out_file.write(reinterpret_cast<const char *>(&cell_tag), sizeof(cell_tag));
+				continue;
+			}
+
+			uint8_t cell_tag = 2;
+			uint8_t is_core_pkg = data_pkg->is_core_pkg_ ? 1 : 0;
+			uint8_t is_inner_pkg = data_pkg->is_inner_pkg_ ? 1 : 0;
+			out_file.write(reinterpret_cast<const char *>(&cell_tag), sizeof(cell_tag));
+			out_file.write(reinterpret_cast<const char *>(&is_core_pkg), sizeof(is_core_pkg));
+			out_file.write(reinterpret_cast<const char *>(&is_inner_pkg), sizeof(is_inner_pkg));
+			out_file.write(reinterpret_cast<const char *>(&data_pkg->phi_), sizeof(data_pkg->phi_));
+			out_file.write(reinterpret_cast<const char *>(&data_pkg->phi_gradient_), sizeof(data_pkg->phi_gradient_));
+			out_file.write(reinterpret_cast<const char *>(&data_pkg->kernel_weight_), sizeof(data_pkg->kernel_weight_));
+			out_file.write(reinterpret_cast<const char *>(&data_pkg->kernel_gradient_), sizeof(data_pkg->kernel_gradient_));
+			out_file.write(reinterpret_cast<const char *>(&data_pkg->near_interface_id_), sizeof(data_pkg->near_interface_id_));
+		}
+		out_file.close();
+	}
+	//=============================================================================================//
 	RefinedLevelSet::RefinedLevelSet(BoundingBox tentative_bounds, LevelSet &coarse_level_set,
 									 Shape &shape, SPHAdaptation &sph_adaptation)
 		: RefinedMesh(tentative_bounds, coarse_level_set, 4, shape, sph_adaptation)
@@ -306,7 +746,50 @@ namespace SPH
 		MultilevelLevelSet(BoundingBox tentative_bounds, Real reference_data_spacing,
 						   size_t total_levels, Shape &shape, SPHAdaptation &sph_adaptation)
 		: MultilevelMesh<BaseLevelSet, LevelSet, RefinedLevelSet>(tentative_bounds, reference_data_spacing,
-																  total_levels, shape, sph_adaptation) {}
+																  total_levels, shape, sph_adaptation),
+		  use_level_dispatch_cache_(false) {}
+	//=================================================================================================//
+	void MultilevelLevelSet::useLevelDispatchCache()
+	{
+		updateLevelOwnershipMasks();
+		use_level_dispatch_cache_ = true;
+	}
+	//=================================================================================================//
+	void MultilevelLevelSet::updateLevelOwnershipMasks()
+	{
+		Vecu number_of_coarsest_cells = mesh_levels_[0]->NumberOfCells();
+		size_t total_number_of_cells =
+			mesh_levels_[0]->transferMeshIndexTo1D(number_of_coarsest_cells, number_of_coarsest_cells - Vecu(1)) + 1;
+		level_ownership_masks_.assign(total_number_of_cells, 0u);
+
+		for (size_t level = 0; level != total_levels_; ++level)
+		{
+			ConcurrentVector<LevelSetDataPackage *> &core_data_pkgs = mesh_levels_[level]->core_data_pkgs_;
+			Vecd half_extent = Vecd(0.5 * mesh_levels_[level]->GridSpacing());
+			for (size_t n = 0; n != core_data_pkgs.size(); ++n)
+			{
+				Vecd cell_position = mesh_levels_[level]->CellPositionFromIndex(core_data_pkgs[n]->pkg_index_);
+				/** a package cell may straddle coarsest cells when the mesh buffers of
+				 * the levels are not aligned, so all overlapped cells are marked. */
+				Vecu lower_cell_index = mesh_levels_[0]->CellIndexFromPosition(cell_position - half_extent);
+				Vecu upper_cell_index = mesh_levels_[0]->CellIndexFromPosition(cell_position + half_extent);
+				Vecu cell_index = lower_cell_index;
+				while (true)
+				{
+					level_ownership_masks_[mesh_levels_[0]->transferMeshIndexTo1D(number_of_coarsest_cells, cell_index)] |= 1u << level;
+					int axis = 0;
+					while (axis != Dimensions && cell_index[axis] == upper_cell_index[axis])
+					{
+						cell_index[axis] = lower_cell_index[axis];
+						++axis;
+					}
+					if (axis == Dimensions)
+						break;
+					++cell_index[axis];
+				}
+			}
+		}
+	}
 	//=================================================================================================//
 	size_t MultilevelLevelSet::getMeshLevel(Real h_ratio)
 	{
@@ -323,6 +806,8 @@ namespace SPH
 	void MultilevelLevelSet::cleanInterface(Real small_shift_factor)
 	{
 		mesh_levels_.back()->cleanInterface(small_shift_factor);
+		if (use_level_dispatch_cache_)
+			updateLevelOwnershipMasks(); /** the core packages may have moved. */
 	}
 	//=============================================================================================//
 	Real MultilevelLevelSet::probeSignedDistance(const Vecd &position)
@@ -342,6 +827,17 @@ namespace SPH
 	//=============================================================================================//
 	size_t MultilevelLevelSet::getProbeLevel(const Vecd &position)
 	{
+		if (use_level_dispatch_cache_)
+		{
+			unsigned int ownership_mask = level_ownership_masks_[mesh_levels_[0]->transferMeshIndexTo1D(
+				mesh_levels_[0]->NumberOfCells(), mesh_levels_[0]->CellIndexFromPosition(position))];
+			for (size_t level = total_levels_; level != 0; --level)
+				if ((ownership_mask & (1u << (level - 1))) &&
+					mesh_levels_[level - 1]->isWithinCorePackage(position))
+					return level - 1; // only the levels owning the region are consulted
+			return 0;
+		}
+
 		for (size_t level = total_levels_; level != 0; --level)
 			if (mesh_levels_[level - 1]->isWithinCorePackage(position))
 				return level - 1; // jump out of the loop!
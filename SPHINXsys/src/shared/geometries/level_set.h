@@ -71,6 +71,9 @@ namespace SPH
 		void initializeSingularDataAddress();
 		void assignAllPackageDataAddress(Vecu addrs_index, LevelSetDataPackage *src_pkg, Vecu data_index);
 		void initializeBasicData(Shape &shape);
+		/** fill the kernel integrals with their saturated far-from-interface
+		 * values, for packages outside the kernel support of the zero level. */
+		void setSaturatedKernelIntegrals();
 		void computeKernelIntegrals(LevelSet &level_set);
 		void computeLevelSetGradient();
 		void stepReinitialization();
@@ -94,6 +97,11 @@ namespace SPH
 		virtual Vecd probeLevelSetGradient(const Vecd& position) = 0;
 		virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
 		virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
+		/** batched probes for arrays of positions. The default implementations
+		 * fall back on the per-position probes. */
+		virtual void probeSignedDistances(const StdLargeVec<Vecd> &positions, StdLargeVec<Real> &signed_distances);
+		virtual void probeLevelSetGradients(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &gradients);
+		virtual void probeNormalDirections(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &normal_directions);
 
 	protected:
 		Shape &shape_; /**< the geometry is described by the level set. */
@@ -103,6 +111,34 @@ namespace SPH
 		Real computeHeaviside(Real phi, Real half_width);
 	};
 
+	/**
+	 * @class NarrowBandLevelSet
+	 * @brief Switch for constructing level sets in a narrow band around the
+	 * zero level. The signed distance of the shape is then evaluated exactly
+	 * only within the given number of mesh cells of the interface, guided by
+	 * a coarse pre-scan of the domain, while far-field probes are answered by
+	 * interpolating the coarse scan and the band grows lazily where probes
+	 * land inside it. For large domains with expensive geometries, e.g. hull
+	 * surfaces, this removes almost all of the full-domain evaluation cost.
+	 * To be switched on before the body with the level set shape is defined.
+	 */
+	class NarrowBandLevelSet
+	{
+	public:
+		static void switchOn(int band_width = 4)
+		{
+			switched_on_ = true;
+			band_width_ = band_width;
+		};
+		static void switchOff() { switched_on_ = false; };
+		static bool isSwitchedOn() { return switched_on_; };
+		static int BandWidth() { return band_width_; };
+
+	private:
+		static bool switched_on_;
+		static int band_width_;
+	};
+
 	/**
 	 * @class LevelSet
 	 * @brief Mesh with level set data as packages.
@@ -120,7 +156,8 @@ namespace SPH
 		//this constructor only initialize far field
 		LevelSet(BoundingBox tentative_bounds, Real data_spacing, size_t buffer_size,
 					   Shape &shape, SPHAdaptation &sph_adaptation);
-		//this constructor generate inner packages too
+		//this constructor generate inner packages too,
+		//reloading them from the on-disk cache when the geometry is unchanged
 		LevelSet(BoundingBox tentative_bounds, Real data_spacing,
 				 Shape &shape, SPHAdaptation &sph_adaptation);
 		virtual ~LevelSet(){};
@@ -132,6 +169,9 @@ namespace SPH
 		virtual Vecd probeLevelSetGradient(const Vecd& position) override;
 		virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
 		virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+		virtual void probeSignedDistances(const StdLargeVec<Vecd> &positions, StdLargeVec<Real> &signed_distances) override;
+		virtual void probeLevelSetGradients(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &gradients) override;
+		virtual void probeNormalDirections(const StdLargeVec<Vecd> &positions, StdLargeVec<Vecd> &normal_directions) override;
 		virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
 		bool isWithinCorePackage(Vecd position);
 		Real computeKernelIntegral(const Vecd &position);
@@ -139,8 +179,33 @@ namespace SPH
 
 	protected:
 		Kernel &kernel_;
+		//----------------------------------------------------------------------
+		//	Narrow band mode, see NarrowBandLevelSet.
+		//----------------------------------------------------------------------
+		bool use_narrow_band_;			   /**< whether the level set is confined to a band near the interface. */
+		int band_width_;				   /**< half width of the band in mesh cells. */
+		Real coarse_spacing_;			   /**< node spacing of the coarse fallback lattice. */
+		Real band_distance_;			   /**< band half width plus the coarse interpolation margin. */
+		Vecu number_of_coarse_nodes_;	   /**< nodes of the coarse fallback lattice per direction. */
+		StdLargeVec<Real> coarse_phi_;	   /**< signed distances on the coarse fallback lattice. */
+		std::mutex band_growth_mutex_;	   /**< serializes the lazy growth of the band. */
+
+		/** evaluate the shape on the coarse fallback lattice. */
+		void initializeCoarseLevelSet();
+		void initializeACoarseNode(const Vecu &node_index, Real dt);
+		size_t CoarseNodeLinearIndex(const Vecu &node_index);
+		/** multi-linear interpolation of the coarse fallback lattice. */
+		Real probeCoarseLevelSet(const Vecd &position);
+		/** initialize a cell exactly within the band and from the coarse scan beyond it. */
+		void initializeDataInACellNarrowBand(const Vecu &cell_index, Real dt);
+		/** materialize the exact data package of a probed cell within the band,
+		 * returns false close to the mesh bound where packages can not live. */
+		bool growBandAt(const Vecu &cell_index);
 
 		void finishDataPackages();
+		/** relocate the core and inner packages into the contiguous Z-order slab */
+		void compactDataPackages();
+		LoopTuner reinitialize_loop_tuner_; /**< grain of the repeatedly swept reinitialization loop */
 		void reinitializeLevelSet();
 		void markNearInterface(Real small_shift_factor);
 		void redistanceInterface();
@@ -156,6 +221,13 @@ namespace SPH
 		void initializeDataInACell(const Vecu &cell_index, Real dt);
 		void initializeAddressesInACell(const Vecu &cell_index, Real dt);
 		void tagACellIsInnerPackage(const Vecu &cell_index, Real dt);
+		/** versioned on-disk cache of the constructed level set, keyed on a
+		 * shape signature and the data resolution, for fast startups */
+		static constexpr int cache_file_version_ = 1;
+		size_t generateShapeSignature();
+		std::string CacheFilePath(size_t shape_signature);
+		bool readCacheFile(const std::string &filefullpath, size_t shape_signature);
+		void writeCacheFile(const std::string &filefullpath, size_t shape_signature);
 	};
 
 	/**
@@ -192,9 +264,22 @@ namespace SPH
 		virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
 		virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
 
+		/** cache, for every cell of the coarsest mesh, which levels hold core
+		 * packages within it, so that a probe only consults the levels which
+		 * can own its position and the far field dispatches to the coarsest
+		 * level without scanning any level at all. The inherited batched
+		 * probes dispatch through the cached ownership as well.
+		 * To be called after the level set has been constructed; the cache is
+		 * rebuilt when the interface is cleaned. */
+		void useLevelDispatchCache();
+
 	protected:
 		inline size_t getProbeLevel(const Vecd &position);
 		inline size_t getMeshLevel(Real h_ratio);
+
+		bool use_level_dispatch_cache_;				 /**< whether the level ownership of the probes is cached. */
+		StdVec<unsigned int> level_ownership_masks_; /**< a bit per level with core packages in each coarsest-mesh cell. */
+		void updateLevelOwnershipMasks();
 	};
 }
 #endif //LEVEL_SET_H
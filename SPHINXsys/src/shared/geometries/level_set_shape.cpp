@@ -49,6 +49,31 @@ namespace SPH
 		return level_set_->probeSignedDistance(input_pnt);
 	}
 	//=================================================================================================//
+	void LevelSetShape::findSignedDistances(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<Real> &signed_distances)
+	{
+		level_set_->probeSignedDistances(input_pnts, signed_distances);
+	}
+	//=================================================================================================//
+	void LevelSetShape::findNormalDirections(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<Vecd> &normal_directions)
+	{
+		level_set_->probeNormalDirections(input_pnts, normal_directions);
+	}
+	//=================================================================================================//
+	void LevelSetShape::checkContains(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<int> &contain_flags)
+	{
+		StdLargeVec<Real> signed_distances;
+		level_set_->probeSignedDistances(input_pnts, signed_distances);
+		contain_flags.resize(input_pnts.size());
+		parallel_for(
+			blocked_range<size_t>(0, input_pnts.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t q = r.begin(); q != r.end(); ++q)
+					contain_flags[q] = signed_distances[q] < 0.0 ? 1 : 0;
+			},
+			ap);
+	}
+	//=================================================================================================//
 	Vecd LevelSetShape::findNormalDirection(const Vecd &input_pnt)
 	{
 		return level_set_->probeNormalDirection(input_pnt);
@@ -61,11 +61,20 @@ namespace SPH
 		virtual Real findSignedDistance(const Vecd &input_pnt) override;
 		virtual Vecd findNormalDirection(const Vecd &input_pnt) override;
 
+		/** batched queries for arrays of positions, answered in the order of
+		 * the underlying level set data packages so that the mesh walks are
+		 * amortized over all queries landing in the same package. */
+		void findSignedDistances(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<Real> &signed_distances);
+		void checkContains(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<int> &contain_flags);
+		void findNormalDirections(const StdLargeVec<Vecd> &input_pnts, StdLargeVec<Vecd> &normal_directions);
+
 		virtual Vecd findLevelSetGradient(const Vecd &input_pnt);
 		virtual Real computeKernelIntegral(const Vecd &input_pnt, Real h_ratio = 1.0);
 		virtual Vecd computeKernelGradientIntegral(const Vecd &input_pnt, Real h_ratio = 1.0);
 		LevelSetShape *cleanLevelSet(Real small_shift_factor = 1.0);
 		void writeLevelSet(SPHBody &sph_body);
+		/** allocated bytes of the level-set mesh, for memory accounting. */
+		size_t MemoryFootprint() { return level_set_->MemoryFootprint(); };
 
 	protected:
 		BoundingBox bounding_box_;
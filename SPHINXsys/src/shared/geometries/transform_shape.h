@@ -72,6 +72,40 @@ namespace SPH
             return transformd_.xformFrameVecToBase(normal_direction_origin);
         };
 
+        /** batched queries: the inverse transformation is applied to the whole batch
+         * in one flat loop, which the compiler can vectorize across the points, and
+         * the base shape queries are bound statically, so the per-point virtual hop
+         * of the point-wise interface is paid once per batch instead. */
+        virtual void checkContainBatch(const StdVec<Vecd> &pnts, StdVec<int> &contain_flags, bool BOUNDARY_INCLUDED = true) override
+        {
+            StdVec<Vecd> pnts_origin(pnts.size());
+            for (size_t index = 0; index != pnts.size(); ++index)
+                pnts_origin[index] = transformd_.shiftBaseStationToFrame(pnts[index]);
+            contain_flags.resize(pnts.size());
+            for (size_t index = 0; index != pnts.size(); ++index)
+                contain_flags[index] = BaseShapeType::checkContain(pnts_origin[index]) ? 1 : 0;
+        };
+        virtual void findClosestPointBatch(const StdVec<Vecd> &input_pnts, StdVec<Vecd> &closest_points) override
+        {
+            StdVec<Vecd> input_pnts_origin(input_pnts.size());
+            for (size_t index = 0; index != input_pnts.size(); ++index)
+                input_pnts_origin[index] = transformd_.shiftBaseStationToFrame(input_pnts[index]);
+            closest_points.resize(input_pnts.size());
+            for (size_t index = 0; index != input_pnts.size(); ++index)
+                closest_points[index] = BaseShapeType::findClosestPoint(input_pnts_origin[index]);
+            for (size_t index = 0; index != closest_points.size(); ++index)
+                closest_points[index] = transformd_.shiftFrameStationToBase(closest_points[index]);
+        };
+        virtual void findSignedDistanceBatch(const StdVec<Vecd> &input_pnts, StdVec<Real> &signed_distances) override
+        {
+            StdVec<Vecd> input_pnts_origin(input_pnts.size());
+            for (size_t index = 0; index != input_pnts.size(); ++index)
+                input_pnts_origin[index] = transformd_.shiftBaseStationToFrame(input_pnts[index]);
+            signed_distances.resize(input_pnts.size());
+            for (size_t index = 0; index != input_pnts.size(); ++index)
+                signed_distances[index] = BaseShapeType::findSignedDistance(input_pnts_origin[index]);
+        };
+
     protected:
         Transformd transformd_;
     };
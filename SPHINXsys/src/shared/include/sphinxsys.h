@@ -34,6 +34,8 @@ capabilities. **/
 #include "all_geometries.h"
 #include "all_bodies.h"
 #include "sph_system.h"
+#include "time_stepping_driver.h"
+#include "local_time_stepping.h"
 #include "all_materials.h"
 #include "all_physical_dynamics.h"
 #include "all_simbody.h"
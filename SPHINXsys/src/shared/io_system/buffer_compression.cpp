@@ -0,0 +1,325 @@
+/**
+ * @file 	buffer_compression.cpp
+ * @brief 	Implementation of the chunked parallel buffer compression.
+ */
+
+#include "buffer_compression.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace SPH
+{
+	namespace buffer_compression
+	{
+		namespace
+		{
+			/** eight bytes so that the magic can not collide with the
+			 * particle count which heads a plain checkpoint buffer */
+			const char container_magic[8] = {'S', 'P', 'H', 'Z', 'C', 'M', 'P', '1'};
+			const size_t chunk_size = size_t(1) << 20;
+			const size_t hash_bits = 15;
+			//=========================================================================================//
+			uint32_t read32(const char *p)
+			{
+				uint32_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			//=========================================================================================//
+			uint32_t hashOf(uint32_t value)
+			{
+				return (value * 2654435761u) >> (32 - hash_bits);
+			}
+			//=========================================================================================//
+			void appendUint64(std::string &out, uint64_t value)
+			{
+				out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+			}
+			//=========================================================================================//
+			uint64_t readUint64(const char *p)
+			{
+				uint64_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			//=========================================================================================//
+			/** lengths beyond the token nibble continue as a run of 255-bytes */
+			void appendExtendedLength(std::string &out, size_t length)
+			{
+				while (length >= 255)
+				{
+					out.push_back((char)255);
+					length -= 255;
+				}
+				out.push_back((char)length);
+			}
+			//=========================================================================================//
+			/** a sequence is a token holding the literal and match length nibbles,
+			 * the literals, and, except for the closing literal-only sequence,
+			 * a 16 bit match offset; the match length nibble counts above the
+			 * minimum match length of four bytes */
+			void appendSequence(std::string &out, const char *literals, size_t literal_length,
+								size_t match_length_above_minimum, size_t offset)
+			{
+				size_t literal_nibble = literal_length < 15 ? literal_length : 15;
+				size_t match_nibble = match_length_above_minimum < 15 ? match_length_above_minimum : 15;
+				out.push_back((char)((literal_nibble << 4) | match_nibble));
+				if (literal_nibble == 15)
+					appendExtendedLength(out, literal_length - 15);
+				out.append(literals, literal_length);
+				if (offset != 0)
+				{
+					out.push_back((char)(offset & 0xff));
+					out.push_back((char)((offset >> 8) & 0xff));
+					if (match_nibble == 15)
+						appendExtendedLength(out, match_length_above_minimum - 15);
+				}
+			}
+			//=========================================================================================//
+			/** greedy LZ compression of one chunk with hash chains over the
+			 * four byte sequences; returns false when the chunk does not shrink */
+			bool compressChunk(const char *src, size_t n, int compression_level, std::string &out)
+			{
+				out.clear();
+				if (n < 16)
+					return false;
+				out.reserve(n);
+
+				std::vector<int> head(size_t(1) << hash_bits, -1);
+				std::vector<int> chain(n, -1);
+				size_t max_probes = size_t(1) << std::min(compression_level, 9);
+
+				const size_t match_limit = n - 5;  // the closing bytes stay literals
+				const size_t search_limit = n - 12; // no match starts near the chunk end
+				size_t anchor = 0;
+				size_t pos = 0;
+				while (pos < search_limit)
+				{
+					uint32_t hash = hashOf(read32(src + pos));
+					size_t best_length = 0;
+					size_t best_offset = 0;
+					int candidate = head[hash];
+					size_t probes = max_probes;
+					while (candidate >= 0 && probes-- != 0)
+					{
+						size_t offset = pos - (size_t)candidate;
+						if (offset > 65535)
+							break; // older candidates are even farther away
+						if (read32(src + candidate) == read32(src + pos))
+						{
+							size_t length = 4;
+							while (pos + length < match_limit && src[candidate + length] == src[pos + length])
+								++length;
+							if (length > best_length)
+							{
+								best_length = length;
+								best_offset = offset;
+							}
+						}
+						candidate = chain[candidate];
+					}
+
+					if (best_length != 0)
+					{
+						appendSequence(out, src + anchor, pos - anchor, best_length - 4, best_offset);
+						size_t match_end = pos + best_length;
+						while (pos < match_end && pos < search_limit)
+						{
+							uint32_t skipped_hash = hashOf(read32(src + pos));
+							chain[pos] = head[skipped_hash];
+							head[skipped_hash] = (int)pos;
+							++pos;
+						}
+						pos = match_end;
+						anchor = match_end;
+						if (out.size() >= n)
+							return false; // incompressible data
+					}
+					else
+					{
+						chain[pos] = head[hash];
+						head[hash] = (int)pos;
+						++pos;
+					}
+				}
+				appendSequence(out, src + anchor, n - anchor, 0, 0);
+				return out.size() < n;
+			}
+			//=========================================================================================//
+			bool decompressChunk(const char *src, size_t n, char *dst, size_t raw_size)
+			{
+				size_t ip = 0;
+				size_t op = 0;
+				while (ip < n)
+				{
+					unsigned char token = (unsigned char)src[ip++];
+					size_t literal_length = token >> 4;
+					if (literal_length == 15)
+					{
+						unsigned char step;
+						do
+						{
+							if (ip >= n)
+								return false;
+							step = (unsigned char)src[ip++];
+							literal_length += step;
+						} while (step == 255);
+					}
+					if (ip + literal_length > n || op + literal_length > raw_size)
+						return false;
+					std::memcpy(dst + op, src + ip, literal_length);
+					ip += literal_length;
+					op += literal_length;
+					if (ip == n)
+						break; // the closing sequence carries literals only
+
+					if (ip + 2 > n)
+						return false;
+					size_t offset = (size_t)(unsigned char)src[ip] | ((size_t)(unsigned char)src[ip + 1] << 8);
+					ip += 2;
+					size_t match_length = token & 15;
+					if (match_length == 15)
+					{
+						unsigned char step;
+						do
+						{
+							if (ip >= n)
+								return false;
+							step = (unsigned char)src[ip++];
+							match_length += step;
+						} while (step == 255);
+					}
+					match_length += 4;
+					if (offset == 0 || offset > op || op + match_length > raw_size)
+						return false;
+					// byte-wise copy as the match may overlap its own output
+					const char *match = dst + op - offset;
+					for (size_t k = 0; k != match_length; ++k)
+						dst[op + k] = match[k];
+					op += match_length;
+				}
+				return op == raw_size;
+			}
+		}
+		//=============================================================================================//
+		bool isCompressed(const std::string &buffer)
+		{
+			return buffer.size() >= sizeof(container_magic) &&
+				   std::memcmp(buffer.data(), container_magic, sizeof(container_magic)) == 0;
+		}
+		//=============================================================================================//
+		std::string compress(const std::string &raw_buffer, int compression_level)
+		{
+			size_t chunk_count = (raw_buffer.size() + chunk_size - 1) / chunk_size;
+			std::vector<std::string> compressed_chunks(chunk_count);
+			std::vector<char> chunk_is_compressed(chunk_count, 0);
+			tbb::parallel_for(size_t(0), chunk_count,
+							  [&](size_t k)
+							  {
+								  const char *chunk = raw_buffer.data() + k * chunk_size;
+								  size_t length = std::min(chunk_size, raw_buffer.size() - k * chunk_size);
+								  chunk_is_compressed[k] =
+									  compressChunk(chunk, length, compression_level, compressed_chunks[k]) ? 1 : 0;
+							  });
+
+			std::string container;
+			container.append(container_magic, sizeof(container_magic));
+			appendUint64(container, raw_buffer.size());
+			appendUint64(container, chunk_size);
+			for (size_t k = 0; k != chunk_count; ++k)
+			{
+				size_t raw_length = std::min(chunk_size, raw_buffer.size() - k * chunk_size);
+				container.push_back(chunk_is_compressed[k]);
+				if (chunk_is_compressed[k])
+				{
+					appendUint64(container, compressed_chunks[k].size());
+					container.append(compressed_chunks[k]);
+				}
+				else
+				{
+					appendUint64(container, raw_length);
+					container.append(raw_buffer.data() + k * chunk_size, raw_length);
+				}
+			}
+			return container;
+		}
+		//=============================================================================================//
+		std::string decompress(const std::string &compressed_buffer)
+		{
+			const size_t header_size = sizeof(container_magic) + 2 * sizeof(uint64_t);
+			if (!isCompressed(compressed_buffer) || compressed_buffer.size() < header_size)
+			{
+				std::cout << "\n Error: the buffer is not a compressed container" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			const char *data = compressed_buffer.data();
+			uint64_t raw_size = readUint64(data + sizeof(container_magic));
+			uint64_t stored_chunk_size = readUint64(data + sizeof(container_magic) + sizeof(uint64_t));
+			size_t chunk_count = stored_chunk_size == 0 ? 0 : size_t((raw_size + stored_chunk_size - 1) / stored_chunk_size);
+
+			// locate the chunks first so that they are decompressed in parallel
+			std::vector<size_t> chunk_offsets(chunk_count);
+			std::vector<size_t> chunk_lengths(chunk_count);
+			std::vector<char> chunk_is_compressed(chunk_count);
+			size_t offset = header_size;
+			for (size_t k = 0; k != chunk_count; ++k)
+			{
+				if (offset + 1 + sizeof(uint64_t) > compressed_buffer.size())
+				{
+					std::cout << "\n Error: the compressed container is truncated" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+				chunk_is_compressed[k] = data[offset];
+				chunk_lengths[k] = (size_t)readUint64(data + offset + 1);
+				chunk_offsets[k] = offset + 1 + sizeof(uint64_t);
+				offset = chunk_offsets[k] + chunk_lengths[k];
+			}
+			if (offset > compressed_buffer.size())
+			{
+				std::cout << "\n Error: the compressed container is truncated" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			std::string raw_buffer((size_t)raw_size, '\0');
+			std::atomic<bool> corrupted(false);
+			tbb::parallel_for(size_t(0), chunk_count,
+							  [&](size_t k)
+							  {
+								  char *dst = &raw_buffer[0] + k * stored_chunk_size;
+								  size_t raw_length = std::min((size_t)stored_chunk_size, (size_t)raw_size - k * (size_t)stored_chunk_size);
+								  if (chunk_is_compressed[k])
+								  {
+									  if (!decompressChunk(data + chunk_offsets[k], chunk_lengths[k], dst, raw_length))
+										  corrupted = true;
+								  }
+								  else if (chunk_lengths[k] == raw_length)
+								  {
+									  std::memcpy(dst, data + chunk_offsets[k], raw_length);
+								  }
+								  else
+								  {
+									  corrupted = true;
+								  }
+							  });
+			if (corrupted)
+			{
+				std::cout << "\n Error: the compressed container is corrupted" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			return raw_buffer;
+		}
+		//=============================================================================================//
+	}
+}
@@ -0,0 +1,53 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+ * @file 	buffer_compression.h
+ * @brief 	Transparent compression of in-memory binary buffers, used for
+ * 			the checkpoint files so that their bandwidth footprint on the
+ * 			filesystem is reduced. The buffer is split into fixed-size
+ * 			chunks which are compressed independently in parallel with a
+ * 			dependency-free byte-oriented LZ codec. Chunks which do not
+ * 			shrink are stored verbatim, so compression never grows the
+ * 			payload by more than the small container header.
+ */
+
+#ifndef BUFFER_COMPRESSION_H
+#define BUFFER_COMPRESSION_H
+
+#include <string>
+
+namespace SPH
+{
+	namespace buffer_compression
+	{
+		/** whether the buffer starts with the compressed-container magic,
+		 * so that readers handle compressed and plain files transparently */
+		bool isCompressed(const std::string &buffer);
+		/** compress the buffer into a self-describing container;
+		 * the compression level in [1, 9] tunes the match search effort */
+		std::string compress(const std::string &raw_buffer, int compression_level);
+		/** restore the raw buffer from a container produced by compress() */
+		std::string decompress(const std::string &compressed_buffer);
+	}
+}
+#endif //BUFFER_COMPRESSION_H
@@ -6,9 +6,13 @@
 
 #include "in_output.h"
 #include "all_bodies.h"
+#include "body_relation.h"
+#include "buffer_compression.h"
 #include "level_set.h"
 #include "sph_system.h"
 
+#include <cstdint>
+
 namespace
 {
     /**
@@ -22,6 +26,70 @@ namespace
 		s_time << std::setw(max_string_width) << std::setfill('0') << value;
 		return s_time.str();
 	}
+
+	/**
+	 * @brief Staging buffer for the appended data section of a vtp file.
+	 * Each array is prefixed with its byte count as required by the
+	 * VTK raw appended data encoding.
+	 */
+	class AppendedDataBuffer
+	{
+	public:
+		/** the offset to be referenced by the next DataArray header */
+		size_t Offset() { return data_.size(); };
+
+		template <typename T>
+		void append(const std::vector<T> &values)
+		{
+			uint64_t byte_count = values.size() * sizeof(T);
+			const char *count_bytes = reinterpret_cast<const char *>(&byte_count);
+			data_.insert(data_.end(), count_bytes, count_bytes + sizeof(uint64_t));
+			const char *value_bytes = reinterpret_cast<const char *>(values.data());
+			data_.insert(data_.end(), value_bytes, value_bytes + byte_count);
+		};
+
+		void writeTo(std::ofstream &out_file)
+		{
+			out_file << "  <AppendedData encoding=\"raw\">\n   _";
+			out_file.write(data_.data(), data_.size());
+			out_file << "\n  </AppendedData>\n";
+		};
+
+	private:
+		std::vector<char> data_;
+	};
+
+	/** round the mantissa to the 11 bits of IEEE half precision, so that the
+	 * low bits of the stored single precision value become zero and the
+	 * arrays shrink accordingly under downstream compression */
+	float roundToHalfPrecision(double value)
+	{
+		int exponent;
+		double mantissa = std::frexp(value, &exponent);
+		return (float)std::ldexp(std::round(std::ldexp(mantissa, 11)), exponent - 11);
+	}
+
+	/** the encoding chosen for the named variable, single precision if none */
+	/** bulk-load a binary checkpoint file and decompress it transparently
+	 * when it carries the compressed-container magic */
+	std::string loadConfigurationCheckpoint(const std::string &filefullpath)
+	{
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+		in_file.seekg(0, std::ios::end);
+		std::string buffer((size_t)in_file.tellg(), '\0');
+		in_file.seekg(0, std::ios::beg);
+		in_file.read(&buffer[0], buffer.size());
+		in_file.close();
+		if (SPH::buffer_compression::isCompressed(buffer))
+			buffer = SPH::buffer_compression::decompress(buffer);
+		return buffer;
+	}
+
+	int encodingOfVariable(const std::map<std::string, int> &variable_encodings, const std::string &variable_name)
+	{
+		std::map<std::string, int>::const_iterator chosen = variable_encodings.find(variable_name);
+		return chosen != variable_encodings.end() ? chosen->second : 0;
+	}
 }
 namespace SPH
 {
@@ -29,7 +97,8 @@ namespace SPH
 	InOutput::InOutput(SPHSystem &sph_system, bool delete_output)
 		: sph_system_(sph_system),
 		  input_folder_("./input"), output_folder_("./output"),
-		  restart_folder_("./restart"), reload_folder_("./reload")
+		  restart_folder_("./restart"), reload_folder_("./reload"),
+		  restart_compression_level_(0)
 	{
 		if (!fs::exists(input_folder_))
 		{
@@ -46,6 +115,11 @@ namespace SPH
 			fs::create_directory(restart_folder_);
 		}
 
+		if (!fs::exists(reload_folder_))
+		{
+			fs::create_directory(reload_folder_);
+		}
+
 		if (sph_system.restart_step_ == 0)
 		{
 			fs::remove_all(restart_folder_);
@@ -67,6 +141,23 @@ namespace SPH
 		return parameterization_io_ptr_keeper_.createRef<ParameterizationIO>(input_folder_);
 	}
 	//=============================================================================================//
+	void InOutput::writeTraceEventsToJson()
+	{
+		TraceEventRecording::writeToJsonFile(output_folder_ + "/trace_events_" + restart_step_ + ".json");
+	}
+	//=============================================================================================//
+	void InOutput::writeLoopTuningParameters()
+	{
+		//without the restart step in the name, so that a restarted or repeated
+		//run finds the decisions of the previous one
+		LoopTuning::writeToFile(output_folder_ + "/loop_tuning.dat");
+	}
+	//=============================================================================================//
+	void InOutput::readLoopTuningParameters()
+	{
+		LoopTuning::readFromFile(output_folder_ + "/loop_tuning.dat");
+	}
+	//=============================================================================================//
 	void PltEngine::
 		writeAQuantityHeader(std::ofstream &out_file, const Real &quantity, const std::string &quantity_name)
 	{
@@ -93,40 +184,1016 @@ namespace SPH
 			out_file << std::fixed << std::setprecision(9) << quantity[i] << "   ";
 	}
 	//=============================================================================================//
+	SimulationStatusRecording::SimulationStatusRecording(InOutput &in_output, Real rewrite_interval_seconds)
+		: in_output_(in_output),
+		  status_file_path_(in_output.output_folder_ + "/simulation_status.json"),
+		  rewrite_interval_seconds_(rewrite_interval_seconds),
+		  last_rewrite_time_(tbb::tick_count::now()),
+		  last_rewrite_step_(0), current_step_(0) {}
+	//=============================================================================================//
+	void SimulationStatusRecording::publishQuantity(const std::string &name, Real value)
+	{
+		for (size_t i = 0; i != published_quantities_.size(); ++i)
+		{
+			if (published_quantities_[i].first == name)
+			{
+				published_quantities_[i].second = value;
+				return;
+			}
+		}
+		published_quantities_.push_back(std::make_pair(name, value));
+	}
+	//=============================================================================================//
+	void SimulationStatusRecording::recordStep(size_t step_number)
+	{
+		current_step_ = step_number;
+		if ((tbb::tick_count::now() - last_rewrite_time_).seconds() < rewrite_interval_seconds_)
+			return;
+		writeStatusFile();
+	}
+	//=============================================================================================//
+	void SimulationStatusRecording::writeStatusFile()
+	{
+		tbb::tick_count rewrite_time = tbb::tick_count::now();
+		Real seconds_since_last_rewrite = (rewrite_time - last_rewrite_time_).seconds();
+		Real steps_per_second = Real(current_step_ - last_rewrite_step_) / seconds_since_last_rewrite;
+
+		// a watcher must never see a partially written status,
+		// so write into a scratch file and rename over the old one
+		std::string scratch_file_path = status_file_path_ + ".tmp";
+		std::ofstream out_file(scratch_file_path.c_str(), std::ios::trunc);
+		out_file << "{\n";
+		out_file << " \"step\": " << current_step_ << ",\n";
+		out_file << " \"physical_time\": " << std::setprecision(9) << GlobalStaticVariables::physical_time_ << ",\n";
+		out_file << " \"steps_per_second\": " << steps_per_second << ",\n";
+
+		out_file << " \"quantities\": {";
+		for (size_t i = 0; i != published_quantities_.size(); ++i)
+		{
+			out_file << (i == 0 ? "\n" : ",\n");
+			out_file << "  \"" << published_quantities_[i].first << "\": " << published_quantities_[i].second;
+		}
+		out_file << "\n },\n";
+
+		out_file << " \"memory_bytes\": {";
+		SPHBodyVector &real_bodies = in_output_.sph_system_.real_bodies_;
+		for (size_t i = 0; i != real_bodies.size(); ++i)
+		{
+			out_file << (i == 0 ? "\n" : ",\n");
+			out_file << "  \"" << real_bodies[i]->getBodyName() << "\": "
+					 << real_bodies[i]->base_particles_->ParticleDataMemoryFootprint() +
+							real_bodies[i]->CellLinkedListMemoryFootprint();
+		}
+		out_file << "\n },\n";
+
+		out_file << " \"dynamics_seconds\": {";
+		StdVec<ParticleDynamicsTiming *> &timings = ParticleDynamicsTiming::RegisteredTimings();
+		for (size_t i = 0; i != timings.size(); ++i)
+		{
+			out_file << (i == 0 ? "\n" : ",\n");
+			out_file << "  \"" << timings[i]->name_ << "\": " << timings[i]->accumulated_seconds_;
+		}
+		out_file << "\n }\n";
+		out_file << "}\n";
+		out_file.close();
+
+		fs::rename(scratch_file_path, status_file_path_);
+		last_rewrite_time_ = rewrite_time;
+		last_rewrite_step_ = current_step_;
+	}
+	//=============================================================================================//
 	std::string BodyStatesIO::convertPhysicalTimeToString(Real convertPhysicalTimeToStream)
 	{
 		int i_time = int(GlobalStaticVariables::physical_time_ * 1.0e6);
 		return padValueWithZeros(i_time);
 	}
 	//=============================================================================================//
+	void ParticleDataSnapshot::takeSnapshot(SPHBody *body, const ParticleVariableList &variables_to_write)
+	{
+		newly_updated_ = body->checkNewlyUpdated();
+		body->setNotNewlyUpdated();
+		if (!newly_updated_)
+			return;
+
+		BaseParticles *base_particles = body->base_particles_;
+		body_name_ = body->getBodyName();
+		total_real_particles_ = base_particles->total_real_particles_;
+
+		//compute the derived particle variables selected for writing
+		base_particles->computeDerivedVariables(variables_to_write);
+
+		pos_n_.assign(base_particles->pos_n_.begin(), base_particles->pos_n_.begin() + total_real_particles_);
+		unsorted_id_.assign(base_particles->unsorted_id_.begin(), base_particles->unsorted_id_.begin() + total_real_particles_);
+
+		ParticleData &all_particle_data = base_particles->all_particle_data_;
+
+		scalar_variables_.resize(variables_to_write[0].size());
+		for (size_t l = 0; l != variables_to_write[0].size(); ++l)
+		{
+			StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data)[variables_to_write[0][l].second]);
+			scalar_variables_[l].first = variables_to_write[0][l].first;
+			scalar_variables_[l].second.assign(variable.begin(), variable.begin() + total_real_particles_);
+		}
+
+		vector_variables_.resize(variables_to_write[1].size());
+		for (size_t l = 0; l != variables_to_write[1].size(); ++l)
+		{
+			StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data)[variables_to_write[1][l].second]);
+			vector_variables_[l].first = variables_to_write[1][l].first;
+			vector_variables_[l].second.assign(variable.begin(), variable.begin() + total_real_particles_);
+		}
+
+		matrix_variables_.resize(variables_to_write[2].size());
+		for (size_t l = 0; l != variables_to_write[2].size(); ++l)
+		{
+			StdLargeVec<Matd> &variable = *(std::get<2>(all_particle_data)[variables_to_write[2][l].second]);
+			matrix_variables_[l].first = variables_to_write[2][l].first;
+			matrix_variables_[l].second.assign(variable.begin(), variable.begin() + total_real_particles_);
+		}
+
+		integer_variables_.resize(variables_to_write[3].size());
+		for (size_t l = 0; l != variables_to_write[3].size(); ++l)
+		{
+			StdLargeVec<int> &variable = *(std::get<3>(all_particle_data)[variables_to_write[3][l].second]);
+			integer_variables_[l].first = variables_to_write[3][l].first;
+			integer_variables_[l].second.assign(variable.begin(), variable.begin() + total_real_particles_);
+		}
+	}
+	//=============================================================================================//
+	void ParticleDataSnapshot::writeToVtpFile(std::ofstream &out_file) const
+	{
+		//begin of the XML file
+		out_file << "<?xml version=\"1.0\"?>\n";
+		out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+		out_file << " <PolyData>\n";
+
+		out_file << "  <Piece Name =\"" << body_name_ << "\" NumberOfPoints=\"" << total_real_particles_ << "\" NumberOfVerts=\"" << total_real_particles_ << "\">\n";
+
+		// write current/final particle positions first
+		out_file << "   <Points>\n";
+		out_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles_; ++i)
+		{
+			Vec3d particle_position = upgradeToVector3D(pos_n_[i]);
+			out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+		out_file << "   </Points>\n";
+
+		// write header of particles data
+		out_file << "   <PointData  Vectors=\"vector\">\n";
+
+		// write sorted particles ID
+		out_file << "    <DataArray Name=\"SortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles_; ++i)
+		{
+			out_file << i << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+
+		// write unsorted particles ID
+		out_file << "    <DataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles_; ++i)
+		{
+			out_file << unsorted_id_[i] << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+
+		// write matrices
+		for (const std::pair<std::string, StdLargeVec<Matd>> &name_variable : matrix_variables_)
+		{
+			const StdLargeVec<Matd> &variable = name_variable.second;
+			out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"Float32\"  NumberOfComponents=\"9\" Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_real_particles_; ++i)
+			{
+				Mat3d matrix_value = upgradeToMatrix3D(variable[i]);
+				for (int k = 0; k != 3; ++k)
+				{
+					Vec3d col_vector = matrix_value.col(k);
+					out_file << std::fixed << std::setprecision(9) << col_vector[0] << " " << col_vector[1] << " " << col_vector[2] << " ";
+				}
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+		}
+
+		// write vectors
+		for (const std::pair<std::string, StdLargeVec<Vecd>> &name_variable : vector_variables_)
+		{
+			const StdLargeVec<Vecd> &variable = name_variable.second;
+			int encoding = encodingOfVariable(variable_encodings_, name_variable.first);
+			if (encoding == BodyStatesRecording::EncodeFixedPoint16)
+			{
+				Real lower_bound = Infinity;
+				Real upper_bound = -Infinity;
+				for (size_t i = 0; i != total_real_particles_; ++i)
+				{
+					Vec3d vector_value = upgradeToVector3D(variable[i]);
+					for (int k = 0; k != 3; ++k)
+					{
+						lower_bound = SMIN(lower_bound, vector_value[k]);
+						upper_bound = SMAX(upper_bound, vector_value[k]);
+					}
+				}
+				Real spacing = SMAX((upper_bound - lower_bound) / Real(65535), TinyReal);
+				out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"UInt16\"  NumberOfComponents=\"3\""
+						 << " RangeMinimum=\"" << lower_bound << "\" RangeSpacing=\"" << spacing << "\" Format=\"ascii\">\n";
+				out_file << "    ";
+				for (size_t i = 0; i != total_real_particles_; ++i)
+				{
+					Vec3d vector_value = upgradeToVector3D(variable[i]);
+					for (int k = 0; k != 3; ++k)
+						out_file << (int)round((vector_value[k] - lower_bound) / spacing) << " ";
+				}
+				out_file << std::endl;
+				out_file << "    </DataArray>\n";
+				continue;
+			}
+
+			out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_real_particles_; ++i)
+			{
+				Vec3d vector_value = upgradeToVector3D(variable[i]);
+				if (encoding == BodyStatesRecording::EncodeFloat16)
+				{
+					out_file << std::defaultfloat << std::setprecision(4) << roundToHalfPrecision(vector_value[0]) << " "
+							 << roundToHalfPrecision(vector_value[1]) << " " << roundToHalfPrecision(vector_value[2]) << " ";
+					continue;
+				}
+				out_file << std::fixed << std::setprecision(9) << vector_value[0] << " " << vector_value[1] << " " << vector_value[2] << " ";
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+		}
+
+		// write scalars
+		for (const std::pair<std::string, StdLargeVec<Real>> &name_variable : scalar_variables_)
+		{
+			const StdLargeVec<Real> &variable = name_variable.second;
+			int encoding = encodingOfVariable(variable_encodings_, name_variable.first);
+			if (encoding == BodyStatesRecording::EncodeFixedPoint16)
+			{
+				Real lower_bound = Infinity;
+				Real upper_bound = -Infinity;
+				for (size_t i = 0; i != total_real_particles_; ++i)
+				{
+					lower_bound = SMIN(lower_bound, variable[i]);
+					upper_bound = SMAX(upper_bound, variable[i]);
+				}
+				Real spacing = SMAX((upper_bound - lower_bound) / Real(65535), TinyReal);
+				out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"UInt16\""
+						 << " RangeMinimum=\"" << lower_bound << "\" RangeSpacing=\"" << spacing << "\" Format=\"ascii\">\n";
+				out_file << "    ";
+				for (size_t i = 0; i != total_real_particles_; ++i)
+				{
+					out_file << (int)round((variable[i] - lower_bound) / spacing) << " ";
+				}
+				out_file << std::endl;
+				out_file << "    </DataArray>\n";
+				continue;
+			}
+
+			out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"Float32\" Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_real_particles_; ++i)
+			{
+				if (encoding == BodyStatesRecording::EncodeFloat16)
+				{
+					out_file << std::defaultfloat << std::setprecision(4) << roundToHalfPrecision(variable[i]) << " ";
+					continue;
+				}
+				out_file << std::fixed << std::setprecision(9) << variable[i] << " ";
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+		}
+
+		// write integers
+		for (const std::pair<std::string, StdLargeVec<int>> &name_variable : integer_variables_)
+		{
+			const StdLargeVec<int> &variable = name_variable.second;
+			out_file << "    <DataArray Name=\"" << name_variable.first << "\" type=\"Int32\" Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_real_particles_; ++i)
+			{
+				out_file << std::fixed << std::setprecision(9) << variable[i] << " ";
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+		}
+
+		out_file << "   </PointData>\n";
+
+		//write empty cells
+		out_file << "   <Verts>\n";
+		out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles_; ++i)
+		{
+			out_file << i << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+		out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles_; ++i)
+		{
+			out_file << i + 1 << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+		out_file << "   </Verts>\n";
+
+		out_file << "  </Piece>\n";
+
+		out_file << " </PolyData>\n";
+		out_file << "</VTKFile>\n";
+	}
+	//=============================================================================================//
+	BodyStatesRecording::~BodyStatesRecording()
+	{
+		if (io_thread_.joinable())
+		{
+			finishAsynchronousWriting();
+			{
+				std::lock_guard<std::mutex> lock(io_mutex_);
+				terminate_io_thread_ = true;
+			}
+			io_condition_.notify_all();
+			io_thread_.join();
+		}
+	}
+	//=============================================================================================//
 	void BodyStatesRecording::writeToFile(size_t iteration_step)
     {
-        writeWithFileName(padValueWithZeros(iteration_step));
+        dispatchWriting(padValueWithZeros(iteration_step));
     };
+	//=============================================================================================//
+	void BodyStatesRecording::useAsynchronousWriting()
+	{
+		asynchronous_writing_ = true;
+		if (!io_thread_.joinable())
+		{
+			io_thread_ = std::thread(&BodyStatesRecording::ioThreadWorker, this);
+		}
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::finishAsynchronousWriting()
+	{
+		std::unique_lock<std::mutex> lock(io_mutex_);
+		io_condition_.wait(lock, [&]
+						   { return job_buffer_ < 0 && writing_buffer_ < 0; });
+	}
+	//=============================================================================================//
+	ParticleVariableList BodyStatesRecording::getVariablesToWrite(SPHBody *body)
+	{
+		BaseParticles *base_particles = body->base_particles_;
+		return use_selected_variables_
+				   ? base_particles->findVariablesByName(selected_variable_names_)
+				   : base_particles->variables_to_write_;
+	}
+	//=============================================================================================//
+	namespace
+	{
+		Real maximumParticleSpeed(BaseParticles &particles)
+		{
+			StdLargeVec<Vecd> &vel_n = particles.vel_n_;
+			return parallel_reduce(
+				blocked_range<size_t>(0, particles.total_real_particles_), Real(0),
+				[&](const blocked_range<size_t> &r, Real temp) -> Real
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						temp = SMAX(temp, vel_n[i].norm());
+					return temp;
+				},
+				[](Real x, Real y) -> Real
+				{ return SMAX(x, y); });
+		}
+	}
+	//=============================================================================================//
+	bool BodyStatesRecording::changeExceedsThresholds()
+	{
+		if (calls_since_last_write_ < min_write_interval_)
+			return false;
+		if (calls_since_last_write_ >= max_write_interval_)
+			return true;
+		// the first triggered call seeds the baselines with a dump
+		if (max_speed_at_last_write_.size() != bodies_.size())
+			return true;
+
+		constexpr int int_index = ParticleDataTypeIndex<int>::value;
+		for (size_t b = 0; b != bodies_.size(); ++b)
+		{
+			BaseParticles *particles = bodies_[b]->base_particles_;
+			Real max_speed = maximumParticleSpeed(*particles);
+			if (ABS(max_speed - max_speed_at_last_write_[b]) >
+				velocity_change_ratio_ * (max_speed_at_last_write_[b] + TinyReal))
+				return true;
+
+			if (particles->all_variable_maps_[int_index].count("SurfaceIndicator"))
+			{
+				StdLargeVec<int> &indicator = *particles->getVariableByName<int>("SurfaceIndicator");
+				StdVec<int> &baseline = indicator_at_last_write_[b];
+				size_t total_real_particles = particles->total_real_particles_;
+				// the particle count changed since the last dump, e.g. by an emitter
+				if (baseline.size() != total_real_particles)
+					return true;
+				size_t flipped = parallel_reduce(
+					blocked_range<size_t>(0, total_real_particles), size_t(0),
+					[&](const blocked_range<size_t> &r, size_t temp) -> size_t
+					{
+						for (size_t i = r.begin(); i != r.end(); ++i)
+						{
+							if (indicator[i] != baseline[i])
+								temp++;
+						}
+						return temp;
+					},
+					[](size_t x, size_t y) -> size_t
+					{ return x + y; });
+				if (Real(flipped) > indicator_change_ratio_ * Real(total_real_particles))
+					return true;
+			}
+		}
+		return false;
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::refreshChangeBaselines()
+	{
+		constexpr int int_index = ParticleDataTypeIndex<int>::value;
+		max_speed_at_last_write_.resize(bodies_.size());
+		indicator_at_last_write_.resize(bodies_.size());
+		for (size_t b = 0; b != bodies_.size(); ++b)
+		{
+			BaseParticles *particles = bodies_[b]->base_particles_;
+			max_speed_at_last_write_[b] = maximumParticleSpeed(*particles);
+			if (particles->all_variable_maps_[int_index].count("SurfaceIndicator"))
+			{
+				StdLargeVec<int> &indicator = *particles->getVariableByName<int>("SurfaceIndicator");
+				indicator_at_last_write_[b].assign(
+					indicator.begin(), indicator.begin() + particles->total_real_particles_);
+			}
+			else
+			{
+				indicator_at_last_write_[b].clear();
+			}
+		}
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::dispatchWriting(const std::string &sequence)
+	{
+		// recorders with different cadences can share the same output loop
+		write_call_count_++;
+		if ((write_call_count_ - 1) % write_interval_ != 0)
+			return;
+
+		// the change metrics decide whether this call actually dumps
+		if (change_triggered_writing_)
+		{
+			calls_since_last_write_++;
+			if (!changeExceedsThresholds())
+				return;
+			refreshChangeBaselines();
+			calls_since_last_write_ = 0;
+		}
+
+		if (!asynchronous_writing_)
+		{
+			TraceEventScope trace_scope(typeid(*this), "io");
+			writeWithFileName(sequence);
+			return;
+		}
+
+		// the scope covers the wait for a free buffer and the snapshot,
+		// i.e. the time the solver loop is held up by this recorder
+		TraceEventScope trace_scope(typeid(*this), "io", "snapshot");
+		{
+			// wait until the filling buffer is neither pending nor being written
+			std::unique_lock<std::mutex> lock(io_mutex_);
+			io_condition_.wait(lock, [&]
+							   { return job_buffer_ < 0 && writing_buffer_ != filling_buffer_; });
+		}
+
+		StdVec<ParticleDataSnapshot> &snapshots = snapshot_buffers_[filling_buffer_];
+		snapshots.resize(bodies_.size());
+		for (size_t i = 0; i != bodies_.size(); ++i)
+		{
+			snapshots[i].takeSnapshot(bodies_[i], getVariablesToWrite(bodies_[i]));
+			snapshots[i].variable_encodings_ = variable_encodings_;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(io_mutex_);
+			job_buffer_ = filling_buffer_;
+			job_sequence_ = sequence;
+			filling_buffer_ = (filling_buffer_ + 1) % 2;
+		}
+		io_condition_.notify_all();
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::ioThreadWorker()
+	{
+		for (;;)
+		{
+			std::string sequence;
+			int buffer = -1;
+			{
+				std::unique_lock<std::mutex> lock(io_mutex_);
+				io_condition_.wait(lock, [&]
+								   { return job_buffer_ >= 0 || terminate_io_thread_; });
+				if (job_buffer_ < 0)
+					return;
+				buffer = job_buffer_;
+				sequence = job_sequence_;
+				writing_buffer_ = buffer;
+				job_buffer_ = -1;
+			}
+			io_condition_.notify_all();
+
+			{
+				TraceEventScope trace_scope(typeid(*this), "io", "asynchronous write");
+				writeSnapshotsWithFileName(snapshot_buffers_[buffer], sequence);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(io_mutex_);
+				writing_buffer_ = -1;
+			}
+			io_condition_.notify_all();
+		}
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence)
+	{
+		std::cout << "\n Error: the body states recorder does not support asynchronous writing!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=============================================================================================//
+	void BodyStatesRecording::forEachBodyWritingJob(size_t number_of_jobs, const std::function<void(size_t)> &writing_job)
+	{
+		if (io_concurrency_ > 1 && number_of_jobs > 1)
+		{
+			// each body formats and writes in its own task,
+			// bounded by the concurrency budget of this recorder
+			tbb::task_arena io_arena(int(SMIN(io_concurrency_, number_of_jobs)));
+			io_arena.execute(
+				[&]
+				{
+					parallel_for(
+						blocked_range<size_t>(0, number_of_jobs, 1),
+						[&](const blocked_range<size_t> &r)
+						{
+							for (size_t k = r.begin(); k != r.end(); ++k)
+								writing_job(k);
+						},
+						simple_partitioner());
+				});
+			return;
+		}
+
+		for (size_t k = 0; k != number_of_jobs; ++k)
+			writing_job(k);
+	}
 	//=============================================================================================//
 	void BodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
 	{
+		forEachBodyWritingJob(
+			bodies_.size(),
+			[&](size_t k)
+			{
+				SPHBody *body = bodies_[k];
+				if (body->checkNewlyUpdated())
+					writeVtpFileForBody(body, sequence);
+				body->setNotNewlyUpdated();
+			});
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToVtp::writeVtpFileForBody(SPHBody *body, const std::string &sequence)
+	{
+		//TODO: we can short the file name by without using SPHBody
+		std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body->getBodyName() + "_" + sequence + ".vtp";
+		if (fs::exists(filefullpath))
+		{
+			fs::remove(filefullpath);
+		}
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+
+		if (write_binary_)
+		{
+			writeBinaryVtpFile(out_file, body);
+			out_file.close();
+			return;
+		}
+
+		//begin of the XML file
+		out_file << "<?xml version=\"1.0\"?>\n";
+		out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+		out_file << " <PolyData>\n";
+
+		BaseParticles *base_particles = body->base_particles_;
+		size_t total_real_particles = base_particles->total_real_particles_;
+		out_file << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_real_particles << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+		ParticleVariableList variables_to_write = getVariablesToWrite(body);
+		base_particles->writeParticlesToVtk(out_file, variables_to_write);
+
+		out_file << "   </PointData>\n";
+
+		//write empty cells
+		out_file << "   <Verts>\n";
+		out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			out_file << i << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+		out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+		out_file << "    ";
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			out_file << i + 1 << " ";
+		}
+		out_file << std::endl;
+		out_file << "    </DataArray>\n";
+		out_file << "   </Verts>\n";
+
+		out_file << "  </Piece>\n";
+
+		out_file << " </PolyData>\n";
+		out_file << "</VTKFile>\n";
+
+		out_file.close();
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToVtp::writeBinaryVtpFile(std::ofstream &out_file, SPHBody *body)
+	{
+		BaseParticles *base_particles = body->base_particles_;
+		size_t total_real_particles = base_particles->total_real_particles_;
+
+		//compute the derived particle variables selected for writing
+		base_particles->computeDerivedVariables(base_particles->variables_to_write_);
+
+		AppendedDataBuffer appended_data;
+		std::vector<float> float_buffer;
+		std::vector<int32_t> int_buffer;
+
+		//begin of the XML file
+		out_file << "<?xml version=\"1.0\"?>\n";
+		out_file << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+		out_file << " <PolyData>\n";
+		out_file << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_real_particles << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+		// write current/final particle positions first
+		float_buffer.resize(total_real_particles * 3);
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			Vec3d particle_position = upgradeToVector3D(base_particles->pos_n_[i]);
+			float_buffer[i * 3] = (float)particle_position[0];
+			float_buffer[i * 3 + 1] = (float)particle_position[1];
+			float_buffer[i * 3 + 2] = (float)particle_position[2];
+		}
+		out_file << "   <Points>\n";
+		out_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+		appended_data.append(float_buffer);
+		out_file << "   </Points>\n";
+
+		// write header of particles data
+		out_file << "   <PointData  Vectors=\"vector\">\n";
+
+		// write sorted particles ID
+		int_buffer.resize(total_real_particles);
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			int_buffer[i] = (int32_t)i;
+		}
+		out_file << "    <DataArray Name=\"SortedParticle_ID\" type=\"Int32\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+		appended_data.append(int_buffer);
+
+		// write unsorted particles ID
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			int_buffer[i] = (int32_t)base_particles->unsorted_id_[i];
+		}
+		out_file << "    <DataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+		appended_data.append(int_buffer);
+
+		ParticleVariableList variables_to_write = getVariablesToWrite(body);
+		ParticleData &all_particle_data = base_particles->all_particle_data_;
+
+		// write matrices
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[2])
+		{
+			StdLargeVec<Matd> &variable = *(std::get<2>(all_particle_data)[name_index.second]);
+			float_buffer.resize(total_real_particles * 9);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				Mat3d matrix_value = upgradeToMatrix3D(variable[i]);
+				for (int k = 0; k != 3; ++k)
+				{
+					Vec3d col_vector = matrix_value.col(k);
+					float_buffer[i * 9 + k * 3] = (float)col_vector[0];
+					float_buffer[i * 9 + k * 3 + 1] = (float)col_vector[1];
+					float_buffer[i * 9 + k * 3 + 2] = (float)col_vector[2];
+				}
+			}
+			out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"Float32\"  NumberOfComponents=\"9\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+			appended_data.append(float_buffer);
+		}
+
+		// write vectors
+		std::vector<uint16_t> code_buffer;
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[1])
+		{
+			StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data)[name_index.second]);
+			int encoding = encodingOfVariable(variable_encodings_, name_index.first);
+			if (encoding == EncodeFixedPoint16)
+			{
+				Real lower_bound = Infinity;
+				Real upper_bound = -Infinity;
+				for (size_t i = 0; i != total_real_particles; ++i)
+				{
+					Vec3d vector_value = upgradeToVector3D(variable[i]);
+					for (int k = 0; k != 3; ++k)
+					{
+						lower_bound = SMIN(lower_bound, vector_value[k]);
+						upper_bound = SMAX(upper_bound, vector_value[k]);
+					}
+				}
+				Real spacing = SMAX((upper_bound - lower_bound) / Real(65535), TinyReal);
+				code_buffer.resize(total_real_particles * 3);
+				for (size_t i = 0; i != total_real_particles; ++i)
+				{
+					Vec3d vector_value = upgradeToVector3D(variable[i]);
+					for (int k = 0; k != 3; ++k)
+						code_buffer[i * 3 + k] = (uint16_t)round((vector_value[k] - lower_bound) / spacing);
+				}
+				out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"UInt16\"  NumberOfComponents=\"3\""
+						 << " RangeMinimum=\"" << lower_bound << "\" RangeSpacing=\"" << spacing
+						 << "\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+				appended_data.append(code_buffer);
+				continue;
+			}
+
+			float_buffer.resize(total_real_particles * 3);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				Vec3d vector_value = upgradeToVector3D(variable[i]);
+				if (encoding == EncodeFloat16)
+				{
+					float_buffer[i * 3] = roundToHalfPrecision(vector_value[0]);
+					float_buffer[i * 3 + 1] = roundToHalfPrecision(vector_value[1]);
+					float_buffer[i * 3 + 2] = roundToHalfPrecision(vector_value[2]);
+					continue;
+				}
+				float_buffer[i * 3] = (float)vector_value[0];
+				float_buffer[i * 3 + 1] = (float)vector_value[1];
+				float_buffer[i * 3 + 2] = (float)vector_value[2];
+			}
+			out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"Float32\"  NumberOfComponents=\"3\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+			appended_data.append(float_buffer);
+		}
+
+		// write scalars
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[0])
+		{
+			StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data)[name_index.second]);
+			int encoding = encodingOfVariable(variable_encodings_, name_index.first);
+			if (encoding == EncodeFixedPoint16)
+			{
+				Real lower_bound = Infinity;
+				Real upper_bound = -Infinity;
+				for (size_t i = 0; i != total_real_particles; ++i)
+				{
+					lower_bound = SMIN(lower_bound, variable[i]);
+					upper_bound = SMAX(upper_bound, variable[i]);
+				}
+				Real spacing = SMAX((upper_bound - lower_bound) / Real(65535), TinyReal);
+				code_buffer.resize(total_real_particles);
+				for (size_t i = 0; i != total_real_particles; ++i)
+				{
+					code_buffer[i] = (uint16_t)round((variable[i] - lower_bound) / spacing);
+				}
+				out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"UInt16\""
+						 << " RangeMinimum=\"" << lower_bound << "\" RangeSpacing=\"" << spacing
+						 << "\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+				appended_data.append(code_buffer);
+				continue;
+			}
+
+			float_buffer.resize(total_real_particles);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				if (encoding == EncodeFloat16)
+				{
+					float_buffer[i] = roundToHalfPrecision(variable[i]);
+					continue;
+				}
+				float_buffer[i] = (float)variable[i];
+			}
+			out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"Float32\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+			appended_data.append(float_buffer);
+		}
+
+		// write integers
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[3])
+		{
+			StdLargeVec<int> &variable = *(std::get<3>(all_particle_data)[name_index.second]);
+			int_buffer.resize(total_real_particles);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				int_buffer[i] = (int32_t)variable[i];
+			}
+			out_file << "    <DataArray Name=\"" << name_index.first << "\" type=\"Int32\" format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+			appended_data.append(int_buffer);
+		}
+
+		out_file << "   </PointData>\n";
+
+		//write empty cells
+		int_buffer.resize(total_real_particles);
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			int_buffer[i] = (int32_t)i;
+		}
+		out_file << "   <Verts>\n";
+		out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+		appended_data.append(int_buffer);
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			int_buffer[i] = (int32_t)(i + 1);
+		}
+		out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  format=\"appended\" offset=\"" << appended_data.Offset() << "\"/>\n";
+		appended_data.append(int_buffer);
+		out_file << "   </Verts>\n";
+
+		out_file << "  </Piece>\n";
+
+		out_file << " </PolyData>\n";
+		appended_data.writeTo(out_file);
+		out_file << "</VTKFile>\n";
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToVtp::writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence)
+	{
+		forEachBodyWritingJob(
+			snapshots.size(),
+			[&](size_t k)
+			{
+				ParticleDataSnapshot &snapshot = snapshots[k];
+				if (snapshot.newly_updated_)
+				{
+					std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + snapshot.body_name_ + "_" + sequence + ".vtp";
+					if (fs::exists(filefullpath))
+					{
+						fs::remove(filefullpath);
+					}
+					std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+					snapshot.writeToVtpFile(out_file);
+					out_file.close();
+				}
+			});
+	}
+	//=============================================================================================//
+	void BodyRegionStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
+	{
+		SPHBody *body = body_;
+		if (body->checkNewlyUpdated())
+		{
+			// collect the particles currently residing in the cells of the region,
+			// so that no per-particle containment test is carried out
+			IndexVector region_particles;
+			CellLists &body_part_cells = body_part_->body_part_cells_;
+			for (size_t i = 0; i != body_part_cells.size(); ++i)
+			{
+				IndexVector &cell_list_indexes = body_part_cells[i]->cell_list_indexes_;
+				for (size_t num = 0; num != cell_list_indexes.size(); ++num)
+				{
+					region_particles.push_back(cell_list_indexes[num]);
+				}
+			}
+
+			std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body->getBodyName() +
+									   "_" + body_part_->BodyPartName() + "_" + sequence + ".vtp";
+			if (fs::exists(filefullpath))
+			{
+				fs::remove(filefullpath);
+			}
+			std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+
+			//begin of the XML file
+			out_file << "<?xml version=\"1.0\"?>\n";
+			out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+			out_file << " <PolyData>\n";
+
+			BaseParticles *base_particles = body->base_particles_;
+			size_t total_region_particles = region_particles.size();
+			out_file << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_region_particles << "\" NumberOfVerts=\"" << total_region_particles << "\">\n";
+
+			ParticleVariableList variables_to_write = getVariablesToWrite(body);
+			base_particles->writeParticlesToVtk(out_file, variables_to_write, region_particles);
+
+			out_file << "   </PointData>\n";
+
+			//write empty cells
+			out_file << "   <Verts>\n";
+			out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_region_particles; ++i)
+			{
+				out_file << i << " ";
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+			out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+			out_file << "    ";
+			for (size_t i = 0; i != total_region_particles; ++i)
+			{
+				out_file << i + 1 << " ";
+			}
+			out_file << std::endl;
+			out_file << "    </DataArray>\n";
+			out_file << "   </Verts>\n";
+
+			out_file << "  </Piece>\n";
+
+			out_file << " </PolyData>\n";
+			out_file << "</VTKFile>\n";
+
+			out_file.close();
+		}
+		body->setNotNewlyUpdated();
+	}
+	//=============================================================================================//
+	IndexVector PreviewStatesRecordingToVtp::collectPreviewParticles(SPHBody *body)
+	{
+		IndexVector preview_particles;
+		SplitCellLists &split_cell_lists = body->split_cell_lists_;
+		for (size_t k = 0; k != split_cell_lists.size(); ++k)
+		{
+			ConcurrentCellLists &cell_lists = split_cell_lists[k];
+			for (size_t l = 0; l != cell_lists.size(); ++l)
+			{
+				IndexVector &cell_list_indexes = cell_lists[l]->cell_list_indexes_;
+				if (cell_list_indexes.size() != 0)
+					preview_particles.push_back(cell_list_indexes[0]);
+			}
+		}
+
+		// bodies without cell lists fall back to a fixed-stride subsample
+		if (preview_particles.empty())
+		{
+			size_t total_real_particles = body->base_particles_->total_real_particles_;
+			for (size_t i = 0; i < total_real_particles; i += 64)
+				preview_particles.push_back(i);
+		}
+		return preview_particles;
+	}
+	//=============================================================================================//
+	void PreviewStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
+	{
+		preview_write_count_++;
+		if (full_dump_interval_ != 0 && preview_write_count_ % full_dump_interval_ == 0)
+		{
+			BodyStatesRecordingToVtp::writeWithFileName(sequence);
+			return;
+		}
+
 		for (SPHBody *body : bodies_)
 		{
 			if (body->checkNewlyUpdated())
 			{
-				//TODO: we can short the file name by without using SPHBody
-				std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body->getBodyName() + "_" + sequence + ".vtp";
+				IndexVector preview_particles = collectPreviewParticles(body);
+
+				std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body->getBodyName() +
+										   "_preview_" + sequence + ".vtp";
 				if (fs::exists(filefullpath))
 				{
 					fs::remove(filefullpath);
 				}
 				std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+
 				//begin of the XML file
 				out_file << "<?xml version=\"1.0\"?>\n";
 				out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
 				out_file << " <PolyData>\n";
 
 				BaseParticles *base_particles = body->base_particles_;
-				size_t total_real_particles = base_particles->total_real_particles_;
-				out_file << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_real_particles << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+				size_t total_preview_particles = preview_particles.size();
+				out_file << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_preview_particles << "\" NumberOfVerts=\"" << total_preview_particles << "\">\n";
 
-				body->writeParticlesToVtpFile(out_file);
+				ParticleVariableList variables_to_write = getVariablesToWrite(body);
+				base_particles->writeParticlesToVtk(out_file, variables_to_write, preview_particles);
 
 				out_file << "   </PointData>\n";
 
@@ -134,7 +1201,7 @@ namespace SPH
 				out_file << "   <Verts>\n";
 				out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
 				out_file << "    ";
-				for (size_t i = 0; i != total_real_particles; ++i)
+				for (size_t i = 0; i != total_preview_particles; ++i)
 				{
 					out_file << i << " ";
 				}
@@ -142,7 +1209,7 @@ namespace SPH
 				out_file << "    </DataArray>\n";
 				out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
 				out_file << "    ";
-				for (size_t i = 0; i != total_real_particles; ++i)
+				for (size_t i = 0; i != total_preview_particles; ++i)
 				{
 					out_file << i + 1 << " ";
 				}
@@ -157,59 +1224,286 @@ namespace SPH
 
 				out_file.close();
 			}
-			body->setNotNewlyUpdated();
+			body->setNotNewlyUpdated();
+		}
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToVtpString::writeWithFileName(const std::string& sequence)
+	{
+		for (SPHBody *body : bodies_)
+		{
+			if (body->checkNewlyUpdated())
+			{
+				const auto& vtuName = body->getBodyName() + "_" + sequence + ".vtu";
+				std::stringstream sstream;
+				//begin of the XML file
+				writeVtu(sstream, body);
+				_vtuData[vtuName] = sstream.str();
+			}
+			body->setNotNewlyUpdated();
+		}
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToVtpString::writeVtu(std::ostream& stream, SPHBody* body) const
+	{
+		stream << "<?xml version=\"1.0\"?>\n";
+		stream << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+		stream << " <UnstructuredGrid>\n";
+
+		BaseParticles* base_particles = body->base_particles_;
+		size_t total_real_particles = base_particles->total_real_particles_;
+		stream << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_real_particles << "\" NumberOfCells=\"0\">\n";
+
+		body->writeParticlesToVtuFile(stream);
+
+		stream << "   </PointData>\n";
+
+		//write empty cells
+		stream << "   <Cells>\n";
+		stream << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+		stream << "    </DataArray>\n";
+		stream << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+		stream << "    </DataArray>\n";
+		stream << "    <DataArray type=\"types\"  Name=\"offsets\"  Format=\"ascii\">\n";
+		stream << "    </DataArray>\n";
+		stream << "   </Cells>\n";
+
+		stream << "  </Piece>\n";
+
+		stream << " </UnstructuredGrid>\n";
+		stream << "</VTKFile>\n";
+	}
+	//=============================================================================================//
+	const VtuStringData& BodyStatesRecordingToVtpString::GetVtuData() const
+	{
+		return _vtuData;
+	}
+	//=============================================================================================//
+	std::ofstream &BodyStatesRecordingToTimeSeries::timeSeriesStream(const std::string &body_name)
+	{
+		UniquePtr<std::ofstream> &stream_keeper = data_streams_[body_name];
+		if (!stream_keeper)
+		{
+			std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body_name + "_TimeSeries.dat";
+			if (fs::exists(filefullpath))
+			{
+				fs::remove(filefullpath);
+			}
+			stream_keeper = makeUnique<std::ofstream>(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+			// the format header: magic, layout version, dimension and scalar width
+			stream_keeper->write("SPHTS", 5);
+			uint32_t header[3] = {1, (uint32_t)Dimensions, (uint32_t)sizeof(float)};
+			stream_keeper->write(reinterpret_cast<const char *>(header), sizeof(header));
+		}
+		return *stream_keeper;
+	}
+	//=============================================================================================//
+	std::ofstream &BodyStatesRecordingToTimeSeries::indexStream(const std::string &body_name)
+	{
+		UniquePtr<std::ofstream> &stream_keeper = index_streams_[body_name];
+		if (!stream_keeper)
+		{
+			std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body_name + "_TimeSeries.idx";
+			if (fs::exists(filefullpath))
+			{
+				fs::remove(filefullpath);
+			}
+			stream_keeper = makeUnique<std::ofstream>(filefullpath.c_str(), std::ios::trunc);
+		}
+		return *stream_keeper;
+	}
+	//=============================================================================================//
+	void BodyStatesRecordingToTimeSeries::appendSnapshot(const ParticleDataSnapshot &snapshot, const std::string &sequence)
+	{
+		std::ofstream &data_file = timeSeriesStream(snapshot.body_name_);
+		size_t block_offset = (size_t)data_file.tellp();
+		size_t total_real_particles = snapshot.total_real_particles_;
+
+		// the step block header: the particle count and the number of variable blocks
+		uint64_t particle_count = (uint64_t)total_real_particles;
+		uint32_t variable_blocks = (uint32_t)(2 + snapshot.scalar_variables_.size() +
+											  snapshot.vector_variables_.size() +
+											  snapshot.matrix_variables_.size() +
+											  snapshot.integer_variables_.size());
+		data_file.write(reinterpret_cast<const char *>(&particle_count), sizeof(particle_count));
+		data_file.write(reinterpret_cast<const char *>(&variable_blocks), sizeof(variable_blocks));
+
+		// each variable block: the name, a type code (0 float, 1 int32, 2 uint64)
+		// and the component count, followed by the packed values
+		auto writeBlockHeader = [&](const std::string &name, uint32_t type_code, uint32_t components)
+		{
+			uint32_t name_size = (uint32_t)name.size();
+			data_file.write(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+			data_file.write(name.data(), name_size);
+			data_file.write(reinterpret_cast<const char *>(&type_code), sizeof(type_code));
+			data_file.write(reinterpret_cast<const char *>(&components), sizeof(components));
+		};
+		std::vector<float> float_buffer;
+		auto writeFloatBuffer = [&]
+		{
+			data_file.write(reinterpret_cast<const char *>(float_buffer.data()),
+							float_buffer.size() * sizeof(float));
+		};
+
+		writeBlockHeader("Position", 0, (uint32_t)Dimensions);
+		float_buffer.resize(total_real_particles * Dimensions);
+		for (size_t i = 0; i != total_real_particles; ++i)
+			for (int d = 0; d != Dimensions; ++d)
+				float_buffer[i * Dimensions + d] = (float)snapshot.pos_n_[i][d];
+		writeFloatBuffer();
+
+		writeBlockHeader("UnsortedParticle_ID", 2, 1);
+		std::vector<uint64_t> id_buffer(total_real_particles);
+		for (size_t i = 0; i != total_real_particles; ++i)
+			id_buffer[i] = (uint64_t)snapshot.unsorted_id_[i];
+		data_file.write(reinterpret_cast<const char *>(id_buffer.data()),
+						id_buffer.size() * sizeof(uint64_t));
+
+		for (const std::pair<std::string, StdLargeVec<Real>> &name_variable : snapshot.scalar_variables_)
+		{
+			writeBlockHeader(name_variable.first, 0, 1);
+			float_buffer.resize(total_real_particles);
+			for (size_t i = 0; i != total_real_particles; ++i)
+				float_buffer[i] = (float)name_variable.second[i];
+			writeFloatBuffer();
+		}
+
+		for (const std::pair<std::string, StdLargeVec<Vecd>> &name_variable : snapshot.vector_variables_)
+		{
+			writeBlockHeader(name_variable.first, 0, (uint32_t)Dimensions);
+			float_buffer.resize(total_real_particles * Dimensions);
+			for (size_t i = 0; i != total_real_particles; ++i)
+				for (int d = 0; d != Dimensions; ++d)
+					float_buffer[i * Dimensions + d] = (float)name_variable.second[i][d];
+			writeFloatBuffer();
+		}
+
+		// matrices are upgraded to 9 components as in the vtp outputs
+		for (const std::pair<std::string, StdLargeVec<Matd>> &name_variable : snapshot.matrix_variables_)
+		{
+			writeBlockHeader(name_variable.first, 0, 9);
+			float_buffer.resize(total_real_particles * 9);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				Mat3d matrix_value = upgradeToMatrix3D(name_variable.second[i]);
+				for (int k = 0; k != 3; ++k)
+				{
+					Vec3d col_vector = matrix_value.col(k);
+					for (int d = 0; d != 3; ++d)
+						float_buffer[i * 9 + k * 3 + d] = (float)col_vector[d];
+				}
+			}
+			writeFloatBuffer();
 		}
+
+		for (const std::pair<std::string, StdLargeVec<int>> &name_variable : snapshot.integer_variables_)
+		{
+			writeBlockHeader(name_variable.first, 1, 1);
+			std::vector<int32_t> int_buffer(total_real_particles);
+			for (size_t i = 0; i != total_real_particles; ++i)
+				int_buffer[i] = (int32_t)name_variable.second[i];
+			data_file.write(reinterpret_cast<const char *>(int_buffer.data()),
+							int_buffer.size() * sizeof(int32_t));
+		}
+		data_file.flush();
+
+		// one index line per appended step makes the series seekable
+		std::ofstream &index_file = indexStream(snapshot.body_name_);
+		index_file << sequence << " " << block_offset << " " << total_real_particles << "\n";
+		index_file.flush();
 	}
 	//=============================================================================================//
-	void BodyStatesRecordingToVtpString::writeWithFileName(const std::string& sequence)
+	void BodyStatesRecordingToTimeSeries::writeWithFileName(const std::string &sequence)
 	{
 		for (SPHBody *body : bodies_)
 		{
 			if (body->checkNewlyUpdated())
 			{
-				const auto& vtuName = body->getBodyName() + "_" + sequence + ".vtu";
-				std::stringstream sstream;
-				//begin of the XML file
-				writeVtu(sstream, body);
-				_vtuData[vtuName] = sstream.str();
+				ParticleDataSnapshot snapshot;
+				snapshot.takeSnapshot(body, getVariablesToWrite(body));
+				appendSnapshot(snapshot, sequence);
 			}
-			body->setNotNewlyUpdated();
 		}
 	}
 	//=============================================================================================//
-	void BodyStatesRecordingToVtpString::writeVtu(std::ostream& stream, SPHBody* body) const
+	void BodyStatesRecordingToTimeSeries::writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence)
 	{
-		stream << "<?xml version=\"1.0\"?>\n";
-		stream << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
-		stream << " <UnstructuredGrid>\n";
-
-		BaseParticles* base_particles = body->base_particles_;
-		size_t total_real_particles = base_particles->total_real_particles_;
-		stream << "  <Piece Name =\"" << body->getBodyName() << "\" NumberOfPoints=\"" << total_real_particles << "\" NumberOfCells=\"0\">\n";
-
-		body->writeParticlesToVtuFile(stream);
-
-		stream << "   </PointData>\n";
+		for (ParticleDataSnapshot &snapshot : snapshots)
+		{
+			if (snapshot.newly_updated_)
+			{
+				appendSnapshot(snapshot, sequence);
+			}
+		}
+	}
+	//=============================================================================================//
+	/** gather the zero-copy view of one registered variable of a body. */
+	struct AppendAParticleVariableView
+	{
+		StdVec<ParticleVariableView> &views_;
+		const std::string &body_name_;
+		size_t total_real_particles_;
+		AppendAParticleVariableView(StdVec<ParticleVariableView> &views,
+									const std::string &body_name, size_t total_real_particles)
+			: views_(views), body_name_(body_name), total_real_particles_(total_real_particles){};
 
-		//write empty cells
-		stream << "   <Cells>\n";
-		stream << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
-		stream << "    </DataArray>\n";
-		stream << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
-		stream << "    </DataArray>\n";
-		stream << "    <DataArray type=\"types\"  Name=\"offsets\"  Format=\"ascii\">\n";
-		stream << "    </DataArray>\n";
-		stream << "   </Cells>\n";
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+		{
+			ParticleVariableView view;
+			view.body_name_ = body_name_;
+			view.variable_name_ = variable_name;
+			view.type_index_ = ParticleDataTypeIndex<VariableType>::value;
+			view.value_size_ = sizeof(VariableType);
+			view.total_real_particles_ = total_real_particles_;
+			view.data_ = variable.data();
+			views_.push_back(view);
+		};
+	};
+	//=================================================================================================//
+	void BodyStatesProcessingInSitu::writeWithFileName(const std::string &sequence)
+	{
+		if (write_count_++ % trigger_cadence_ != 0)
+			return;
 
-		stream << "  </Piece>\n";
+		StdVec<ParticleVariableView> views;
+		for (SPHBody *body : bodies_)
+		{
+			BaseParticles *base_particles = body->base_particles_;
+			AppendAParticleVariableView append_variable_view(
+				views, body->getBodyName(), base_particles->total_real_particles_);
+			ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+			loop_variable_namelist(base_particles->all_particle_data_,
+								   base_particles->variables_to_write_, append_variable_view);
+			body->setNotNewlyUpdated();
+		}
 
-		stream << " </UnstructuredGrid>\n";
-		stream << "</VTKFile>\n";
+		for (size_t k = 0; k != processors_.size(); ++k)
+			processors_[k](sequence, views);
+	}
+	//=================================================================================================//
+	/** primitives of the Tecplot binary format. */
+	static void writeAnInt32(std::ofstream &out_file, int32_t value)
+	{
+		out_file.write(reinterpret_cast<const char *>(&value), sizeof(value));
 	}
 	//=============================================================================================//
-	const VtuStringData& BodyStatesRecordingToVtpString::GetVtuData() const
+	static void writeAFloat32(std::ofstream &out_file, float value)
 	{
-		return _vtuData;
+		out_file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	//=============================================================================================//
+	static void writeAFloat64(std::ofstream &out_file, double value)
+	{
+		out_file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	//=============================================================================================//
+	/** a string is encoded as one int32 per character, terminated by zero. */
+	static void writeATecplotString(std::ofstream &out_file, const std::string &value)
+	{
+		for (size_t k = 0; k != value.size(); ++k)
+			writeAnInt32(out_file, (int32_t)value[k]);
+		writeAnInt32(out_file, 0);
 	}
 	//=============================================================================================//
 	void BodyStatesRecordingToPlt::writeWithFileName(const std::string &sequence)
@@ -223,18 +1517,159 @@ namespace SPH
 				{
 					fs::remove(filefullpath);
 				}
-				std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
-
-				//begin of the plt file writing
-
-				body->writeParticlesToPltFile(out_file);
 
-				out_file.close();
+				if (write_binary_)
+				{
+					std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+					writeBinaryPltFile(out_file, body);
+					out_file.close();
+				}
+				else
+				{
+					std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+					body->writeParticlesToPltFile(out_file);
+					out_file.close();
+				}
 			}
 			body->setNotNewlyUpdated();
 		}
 	}
 	//=============================================================================================//
+	void BodyStatesRecordingToPlt::writeBinaryPltFile(std::ofstream &out_file, SPHBody *body)
+	{
+		BaseParticles *base_particles = body->base_particles_;
+		size_t total_real_particles = base_particles->total_real_particles_;
+
+		//compute the derived particle variables selected for writing
+		base_particles->computeDerivedVariables(base_particles->variables_to_write_);
+
+		ParticleVariableList &variables_to_write = base_particles->variables_to_write_;
+		ParticleData &all_particle_data = base_particles->all_particle_data_;
+
+		// gather the variables in the order of the text writer as packed
+		// single precision columns, one bulk write per column
+		StdVec<std::string> variable_names = {"x", "y", "z", "ID"};
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[3])
+		{
+			variable_names.push_back(name_index.first);
+		};
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[1])
+		{
+			variable_names.push_back(name_index.first + "_x");
+			variable_names.push_back(name_index.first + "_y");
+			variable_names.push_back(name_index.first + "_z");
+		};
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[0])
+		{
+			variable_names.push_back(name_index.first);
+		};
+
+		StdVec<std::vector<float>> data_columns(variable_names.size());
+		for (size_t l = 0; l != data_columns.size(); ++l)
+		{
+			data_columns[l].resize(total_real_particles);
+		};
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			Vec3d particle_position = upgradeToVector3D(base_particles->pos_n_[i]);
+			data_columns[0][i] = (float)particle_position[0];
+			data_columns[1][i] = (float)particle_position[1];
+			data_columns[2][i] = (float)particle_position[2];
+			data_columns[3][i] = (float)i;
+		};
+		size_t column = 4;
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[3])
+		{
+			StdLargeVec<int> &variable = *(std::get<3>(all_particle_data)[name_index.second]);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				data_columns[column][i] = (float)variable[i];
+			}
+			column++;
+		};
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[1])
+		{
+			StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data)[name_index.second]);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				Vec3d vector_value = upgradeToVector3D(variable[i]);
+				data_columns[column][i] = (float)vector_value[0];
+				data_columns[column + 1][i] = (float)vector_value[1];
+				data_columns[column + 2][i] = (float)vector_value[2];
+			}
+			column += 3;
+		};
+		for (std::pair<std::string, size_t> &name_index : variables_to_write[0])
+		{
+			StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data)[name_index.second]);
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				data_columns[column][i] = (float)variable[i];
+			}
+			column++;
+		};
+
+		//header section
+		out_file.write("#!TDV112", 8);
+		writeAnInt32(out_file, 1); //byte order magic
+		writeAnInt32(out_file, 0); //full data file
+		writeATecplotString(out_file, body->getBodyName());
+		writeAnInt32(out_file, (int32_t)variable_names.size());
+		for (size_t l = 0; l != variable_names.size(); ++l)
+		{
+			writeATecplotString(out_file, variable_names[l]);
+		};
+
+		//zone header
+		writeAFloat32(out_file, 299.0f); //zone marker
+		writeATecplotString(out_file, body->getBodyName());
+		writeAnInt32(out_file, -1);									   //no parent zone
+		writeAnInt32(out_file, -1);									   //static strand
+		writeAFloat64(out_file, GlobalStaticVariables::physical_time_); //solution time
+		writeAnInt32(out_file, -1);									   //not used
+		writeAnInt32(out_file, 0);									   //ordered zone
+		writeAnInt32(out_file, 0);									   //block data packing
+		writeAnInt32(out_file, 0);									   //variable location not specified
+		writeAnInt32(out_file, 0);									   //no raw face neighbors
+		writeAnInt32(out_file, 0);									   //no user defined face connections
+		writeAnInt32(out_file, (int32_t)total_real_particles);		   //IMax
+		writeAnInt32(out_file, 1);									   //JMax
+		writeAnInt32(out_file, 1);									   //KMax
+		writeAnInt32(out_file, 0);									   //no auxiliary data
+		writeAFloat32(out_file, 357.0f);							   //end of header marker
+
+		//data section
+		writeAFloat32(out_file, 299.0f); //zone marker
+		for (size_t l = 0; l != variable_names.size(); ++l)
+		{
+			writeAnInt32(out_file, 1); //single precision data
+		};
+		writeAnInt32(out_file, 0);	//no passive variables
+		writeAnInt32(out_file, 0);	//no variable sharing
+		writeAnInt32(out_file, -1); //no shared connectivity
+		for (size_t l = 0; l != data_columns.size(); ++l)
+		{
+			float column_min = 0.0f;
+			float column_max = 0.0f;
+			if (total_real_particles != 0)
+			{
+				column_min = column_max = data_columns[l][0];
+				for (size_t i = 1; i != total_real_particles; ++i)
+				{
+					column_min = SMIN(column_min, data_columns[l][i]);
+					column_max = SMAX(column_max, data_columns[l][i]);
+				}
+			}
+			writeAFloat64(out_file, (double)column_min);
+			writeAFloat64(out_file, (double)column_max);
+		};
+		for (size_t l = 0; l != data_columns.size(); ++l)
+		{
+			out_file.write(reinterpret_cast<const char *>(data_columns[l].data()),
+						   data_columns[l].size() * sizeof(float));
+		};
+	}
+	//=============================================================================================//
 	WriteToVtpIfVelocityOutOfBound::
 		WriteToVtpIfVelocityOutOfBound(InOutput &in_output, SPHBodyVector bodies, Real velocity_bound)
 		: BodyStatesRecordingToVtp(in_output, bodies), out_of_bound_(false)
@@ -263,25 +1698,136 @@ namespace SPH
 		: BodyStatesRecording(in_output, body), mesh_field_(mesh_field)
 	{
 		filefullpath_ = in_output_.output_folder_ + "/" + body.getBodyName() + "_" + mesh_field_->Name() + ".dat";
+		out_file_.open(filefullpath_.c_str(), std::ios::app);
 	}
 	//=============================================================================================//
 	void MeshRecordingToPlt::writeWithFileName(const std::string &sequence)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
-		mesh_field_->writeMeshFieldToPlt(out_file);
+		mesh_field_->writeMeshFieldToPlt(out_file_);
+		out_file_.flush();
+	}
+	//=============================================================================================//
+	ObservedQuantitiesRecording::
+		ObservedQuantitiesRecording(InOutput &in_output, BaseBodyRelationContact &contact_relation)
+		: BodyStatesRecording(in_output, *contact_relation.sph_body_),
+		  observer_dynamics::ObservingQuantities(contact_relation),
+		  observer_(contact_relation.sph_body_),
+		  observer_particles_(observer_->base_particles_),
+		  body_name_(contact_relation.sph_body_->getBodyName()),
+		  header_written_(false)
+	{
+		filefullpath_output_ = in_output_.output_folder_ + "/" + body_name_ +
+							   "_observed_" + in_output_.restart_step_ + ".bin";
+	}
+	//=============================================================================================//
+	ObservedQuantitiesRecording::~ObservedQuantitiesRecording() noexcept
+	{
+		flushRecords();
+		flush_tasks_.wait();
+	}
+	//=============================================================================================//
+	void ObservedQuantitiesRecording::writeHeader()
+	{
+		std::ofstream out_file(filefullpath_output_.c_str(), std::ios::trunc | std::ios::binary);
+		uint64_t observe_points = observer_particles_->total_real_particles_;
+		uint64_t quantity_count = observed_quantities_.size();
+		out_file.write(reinterpret_cast<const char *>(&observe_points), sizeof(observe_points));
+		out_file.write(reinterpret_cast<const char *>(&quantity_count), sizeof(quantity_count));
+		for (size_t q = 0; q != observed_quantities_.size(); ++q)
+		{
+			const std::string &variable_name = observed_quantities_[q]->variable_name_;
+			uint64_t name_length = variable_name.size();
+			uint64_t column_width = observed_quantities_[q]->ColumnWidth();
+			out_file.write(reinterpret_cast<const char *>(&name_length), sizeof(name_length));
+			out_file.write(variable_name.data(), name_length);
+			out_file.write(reinterpret_cast<const char *>(&column_width), sizeof(column_width));
+		}
 		out_file.close();
 	}
 	//=============================================================================================//
-	ReloadParticleIO::ReloadParticleIO(InOutput &in_output, SPHBodyVector bodies) : BodyStatesIO(in_output, bodies)
+	void ObservedQuantitiesRecording::writeWithFileName(const std::string &sequence)
 	{
-		if (!fs::exists(in_output.reload_folder_))
+		this->parallel_exec();
+		if (!header_written_)
 		{
-			fs::create_directory(in_output.reload_folder_);
+			writeHeader();
+			header_written_ = true;
 		}
-
+		pending_records_.push_back(GlobalStaticVariables::physical_time_);
+		for (size_t q = 0; q != observed_quantities_.size(); ++q)
+		{
+			for (size_t i = 0; i != observer_particles_->total_real_particles_; ++i)
+			{
+				observed_quantities_[q]->appendColumns(i, pending_records_);
+			}
+		}
+		flushRecords();
+	}
+	//=============================================================================================//
+	void ObservedQuantitiesRecording::flushRecords()
+	{
+		//the previous flush must have finished before its buffer is reused
+		flush_tasks_.wait();
+		flushing_records_.swap(pending_records_);
+		pending_records_.clear();
+		std::string filefullpath = filefullpath_output_;
+		StdVec<Real> *records = &flushing_records_;
+		flush_tasks_.run(
+			[filefullpath, records]
+			{
+				std::ofstream out_file(filefullpath.c_str(), std::ios::app | std::ios::binary);
+				out_file.write(reinterpret_cast<const char *>(records->data()), records->size() * sizeof(Real));
+				out_file.close();
+			});
+	}
+	//=============================================================================================//
+	MemoryFootprintRecording::
+		MemoryFootprintRecording(InOutput &in_output, SPHBodyVector bodies)
+		: BodyStatesIO(in_output, bodies)
+	{
+		filefullpath_output_ = in_output_.output_folder_ + "/memory_footprint_" + in_output_.restart_step_ + ".dat";
+		out_file_.open(filefullpath_output_.c_str(), std::ios::app);
+		out_file_ << "\"run_time\""
+				  << "   "
+				  << "\"body_name\""
+				  << "   "
+				  << "\"particle_data_bytes\""
+				  << "   "
+				  << "\"configuration_bytes\""
+				  << "   "
+				  << "\"cell_linked_list_bytes\""
+				  << "   "
+				  << "\"level_set_bytes\""
+				  << "   "
+				  << "\"total_bytes\""
+				  << "\n";
+		out_file_.flush();
+	}
+	//=============================================================================================//
+	void MemoryFootprintRecording::writeToFile(size_t iteration_step)
+	{
+		for (size_t k = 0; k != bodies_.size(); ++k)
+		{
+			SPHBody *body = bodies_[k];
+			out_file_ << GlobalStaticVariables::physical_time_ << "   "
+					  << body->getBodyName() << "   "
+					  << body->ParticleDataMemoryFootprint() << "   "
+					  << body->ConfigurationsMemoryFootprint() << "   "
+					  << body->CellLinkedListMemoryFootprint() << "   "
+					  << body->LevelSetMemoryFootprint() << "   "
+					  << body->TotalMemoryFootprint() << "\n";
+		}
+		out_file_.flush();
+	}
+	//=============================================================================================//
+	ReloadParticleIO::ReloadParticleIO(InOutput &in_output, SPHBodyVector bodies) : BodyStatesIO(in_output, bodies)
+	{
 		std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_paths_),
 					   [&](SPHBody *body) -> std::string
 					   { return in_output.reload_folder_ + "/" + body->getBodyName() + "_rld.xml"; });
+		std::transform(bodies.begin(), bodies.end(), std::back_inserter(binary_file_paths_),
+					   [&](SPHBody *body) -> std::string
+					   { return in_output.reload_folder_ + "/" + body->getBodyName() + "_rld.bin"; });
 	};
 	//=============================================================================================//
 	ReloadParticleIO::ReloadParticleIO(InOutput &in_output, SPHBodyVector bodies,
@@ -290,6 +1836,9 @@ namespace SPH
 		std::transform(given_body_names.begin(), given_body_names.end(), file_paths_.begin(),
 					   [&](const std::string &body_name) -> std::string
 					   { return in_output.reload_folder_ + "/" + body_name + "_rld.xml"; });
+		std::transform(given_body_names.begin(), given_body_names.end(), binary_file_paths_.begin(),
+					   [&](const std::string &body_name) -> std::string
+					   { return in_output.reload_folder_ + "/" + body_name + "_rld.bin"; });
 	}
 	//=============================================================================================//
 	void ReloadParticleIO::writeToFile(size_t iteration_step)
@@ -297,12 +1846,18 @@ namespace SPH
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
 			std::string filefullpath = file_paths_[i];
+			std::string binary_filefullpath = binary_file_paths_[i];
 
 			if (fs::exists(filefullpath))
 			{
 				fs::remove(filefullpath);
 			}
+			if (fs::exists(binary_filefullpath))
+			{
+				fs::remove(binary_filefullpath);
+			}
 			bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+			bodies_[i]->writeToBinaryForReloadParticle(binary_filefullpath);
 		}
 	}
 	//=============================================================================================//
@@ -312,6 +1867,13 @@ namespace SPH
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
 			std::string filefullpath = file_paths_[i];
+			std::string binary_filefullpath = binary_file_paths_[i];
+
+			if (fs::exists(binary_filefullpath))
+			{
+				bodies_[i]->readFromBinaryForReloadParticle(binary_filefullpath);
+				continue;
+			}
 
 			if (!fs::exists(filefullpath))
 			{
@@ -325,15 +1887,107 @@ namespace SPH
 	}
 	//=============================================================================================//
 	RestartIO::RestartIO(InOutput &in_output, SPHBodyVector bodies)
-		: BodyStatesIO(in_output, bodies), overall_file_path_(in_output.restart_folder_ + "/Restart_time_")
+		: BodyStatesIO(in_output, bodies), overall_file_path_(in_output.restart_folder_ + "/Restart_time_"),
+		  use_delta_checkpoints_(false), full_checkpoint_interval_(1),
+		  checkpoint_count_(0), last_full_step_(0),
+		  use_configuration_checkpoints_(false), configurations_restored_(false),
+		  asynchronous_writing_(false), job_pending_(false), terminate_io_thread_(false)
 	{
 		std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_paths_),
 					   [&](SPHBody *body) -> std::string
 					   { return in_output.restart_folder_ + "/SPHBody_" + body->getBodyName() + "_rst_"; });
+		last_full_snapshots_.resize(bodies.size());
+	}
+	//=============================================================================================//
+	RestartIO::~RestartIO()
+	{
+		if (io_thread_.joinable())
+		{
+			finishAsynchronousWriting();
+			{
+				std::lock_guard<std::mutex> lock(io_mutex_);
+				terminate_io_thread_ = true;
+			}
+			io_condition_.notify_all();
+			io_thread_.join();
+		}
+	}
+	//=============================================================================================//
+	void RestartIO::useAsynchronousWriting()
+	{
+		asynchronous_writing_ = true;
+		if (!io_thread_.joinable())
+		{
+			io_thread_ = std::thread(&RestartIO::ioThreadWorker, this);
+		}
+	}
+	//=============================================================================================//
+	void RestartIO::finishAsynchronousWriting()
+	{
+		if (!asynchronous_writing_)
+			return;
+		std::unique_lock<std::mutex> lock(io_mutex_);
+		io_condition_.wait(lock, [&]
+						   { return !job_pending_; });
+	}
+	//=============================================================================================//
+	void RestartIO::writeBufferToFile(const std::string &buffer, const std::string &filefullpath)
+	{
+		if (fs::exists(filefullpath))
+		{
+			fs::remove(filefullpath);
+		}
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+		if (in_output_.restart_compression_level_ > 0)
+		{
+			// the chunks compress in parallel, and with asynchronous writing
+			// the whole compression rides on the I/O thread
+			std::string compressed =
+				buffer_compression::compress(buffer, in_output_.restart_compression_level_);
+			out_file.write(compressed.data(), compressed.size());
+		}
+		else
+		{
+			out_file.write(buffer.data(), buffer.size());
+		}
+		out_file.close();
+	}
+	//=============================================================================================//
+	void RestartIO::ioThreadWorker()
+	{
+		for (;;)
+		{
+			StdVec<std::string> buffers;
+			StdVec<std::string> file_paths;
+			{
+				std::unique_lock<std::mutex> lock(io_mutex_);
+				io_condition_.wait(lock, [&]
+								   { return job_pending_ || terminate_io_thread_; });
+				if (!job_pending_)
+					return;
+				buffers = std::move(job_buffers_);
+				file_paths = std::move(job_file_paths_);
+			}
+
+			for (size_t i = 0; i < file_paths.size(); ++i)
+				writeBufferToFile(buffers[i], file_paths[i]);
+
+			{
+				std::lock_guard<std::mutex> lock(io_mutex_);
+				job_pending_ = false;
+			}
+			io_condition_.notify_all();
+		}
 	}
 	//=============================================================================================//
 	void RestartIO::writeToFile(size_t iteration_step)
 	{
+		checkpoint_count_++;
+		bool full_checkpoint = !use_delta_checkpoints_ ||
+							   (checkpoint_count_ - 1) % full_checkpoint_interval_ == 0;
+		if (full_checkpoint)
+			last_full_step_ = iteration_step;
+
 		std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(iteration_step) + ".dat";
 		if (fs::exists(overall_filefullpath))
 		{
@@ -341,18 +1995,54 @@ namespace SPH
 		}
 		std::ofstream out_file(overall_filefullpath.c_str(), std::ios::app);
 		out_file << std::fixed << std::setprecision(9) << GlobalStaticVariables::physical_time_ << "   \n";
+		out_file << last_full_step_ << "   \n";
 		out_file.close();
 
+		// the in-memory serialization is the only work on the simulation thread
+		StdVec<std::string> buffers(bodies_.size());
+		StdVec<std::string> file_paths(bodies_.size());
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
-			std::string filefullpath = file_paths_[i] + padValueWithZeros(iteration_step) + ".xml";
+			std::string extension = full_checkpoint ? ".rst" : ".drst";
+			file_paths[i] = file_paths_[i] + padValueWithZeros(iteration_step) + extension;
+			BaseParticles *base_particles = bodies_[i]->base_particles_;
+			if (full_checkpoint)
+			{
+				base_particles->writeParticlesToBufferForRestart(buffers[i]);
+				last_full_snapshots_[i] = buffers[i];
+			}
+			else
+			{
+				base_particles->writeParticleDeltaToBufferForRestart(buffers[i], last_full_snapshots_[i]);
+			}
+		}
 
-			if (fs::exists(filefullpath))
+		// the extended checkpoints add the neighbor configurations of each body
+		if (use_configuration_checkpoints_ && full_checkpoint)
+		{
+			for (size_t i = 0; i < bodies_.size(); ++i)
 			{
-				fs::remove(filefullpath);
+				std::string buffer;
+				writeConfigurationsToBuffer(bodies_[i], buffer);
+				buffers.push_back(std::move(buffer));
+				file_paths.push_back(file_paths_[i] + padValueWithZeros(iteration_step) + ".cfg");
 			}
-			bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
 		}
+
+		if (asynchronous_writing_)
+		{
+			std::unique_lock<std::mutex> lock(io_mutex_);
+			io_condition_.wait(lock, [&]
+							   { return !job_pending_; });
+			job_buffers_ = std::move(buffers);
+			job_file_paths_ = std::move(file_paths);
+			job_pending_ = true;
+			io_condition_.notify_all();
+			return;
+		}
+
+		for (size_t i = 0; i < bodies_.size(); ++i)
+			writeBufferToFile(buffers[i], file_paths[i]);
 	}
 	//=============================================================================================//
 	Real RestartIO::readRestartTime(size_t restart_step)
@@ -373,20 +2063,154 @@ namespace SPH
 		return restart_time;
 	}
 	//=============================================================================================//
+	size_t RestartIO::readFullCheckpointStep(size_t restart_step)
+	{
+		std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(restart_step) + ".dat";
+		if (!fs::exists(overall_filefullpath))
+		{
+			std::cout << "\n Error: the input file:" << overall_filefullpath << " is not exists" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		Real restart_time;
+		size_t full_checkpoint_step = restart_step;
+		std::ifstream in_file(overall_filefullpath.c_str());
+		in_file >> restart_time >> full_checkpoint_step;
+		in_file.close();
+
+		return full_checkpoint_step;
+	}
+	//=============================================================================================//
 	void RestartIO::readFromFile(size_t restart_step)
 	{
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
-			std::string filefullpath = file_paths_[i] + padValueWithZeros(restart_step) + ".xml";
+			std::string filefullpath = file_paths_[i] + padValueWithZeros(restart_step) + ".rst";
+			if (fs::exists(filefullpath))
+			{
+				bodies_[i]->readParticlesFromBinaryForRestart(filefullpath);
+				continue;
+			}
 
-			if (!fs::exists(filefullpath))
+			std::string delta_filefullpath = file_paths_[i] + padValueWithZeros(restart_step) + ".drst";
+			if (!fs::exists(delta_filefullpath))
 			{
 				std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
 				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
 				exit(1);
 			}
 
-			bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+			// a delta checkpoint is applied on top of its recorded full checkpoint
+			std::string full_filefullpath =
+				file_paths_[i] + padValueWithZeros(readFullCheckpointStep(restart_step)) + ".rst";
+			bodies_[i]->base_particles_->readParticlesFromDeltaBinaryForRestart(full_filefullpath, delta_filefullpath);
+		}
+
+		configurations_restored_ = false;
+		if (!use_configuration_checkpoints_)
+			return;
+
+		// delta checkpoints and files from runs without the extended option
+		// carry no configurations, so the resume falls back to the rebuild
+		for (size_t i = 0; i < bodies_.size(); ++i)
+		{
+			if (!fs::exists(file_paths_[i] + padValueWithZeros(restart_step) + ".cfg"))
+				return;
+		}
+
+		// the cell lists follow from the restored positions in a cheap linear pass
+		for (size_t i = 0; i < bodies_.size(); ++i)
+			DynamicCast<RealBody>(this, bodies_[i])->updateCellLinkedList();
+
+		for (size_t i = 0; i < bodies_.size(); ++i)
+			readConfigurationsFromFile(bodies_[i], file_paths_[i] + padValueWithZeros(restart_step) + ".cfg");
+		configurations_restored_ = true;
+	}
+	//=============================================================================================//
+	void RestartIO::writeConfigurationsToBuffer(SPHBody *body, std::string &buffer)
+	{
+		uint32_t format_version = 1;
+		uint32_t real_bytes = sizeof(Real);
+		uint32_t vecd_bytes = sizeof(Vecd);
+		buffer.append(reinterpret_cast<const char *>(&format_version), sizeof(format_version));
+		buffer.append(reinterpret_cast<const char *>(&real_bytes), sizeof(real_bytes));
+		buffer.append(reinterpret_cast<const char *>(&vecd_bytes), sizeof(vecd_bytes));
+		uint64_t total_real_particles = body->base_particles_->total_real_particles_;
+		buffer.append(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		uint64_t relation_count = body->body_relations_.size();
+		buffer.append(reinterpret_cast<const char *>(&relation_count), sizeof(relation_count));
+		for (size_t n = 0; n != body->body_relations_.size(); ++n)
+		{
+			SPHBodyRelation *relation = body->body_relations_[n];
+			std::string type_name = typeid(*relation).name();
+			uint64_t name_length = type_name.size();
+			buffer.append(reinterpret_cast<const char *>(&name_length), sizeof(name_length));
+			buffer.append(type_name);
+			std::string payload;
+			relation->writeConfigurationToBuffer(payload);
+			uint64_t payload_size = payload.size();
+			buffer.append(reinterpret_cast<const char *>(&payload_size), sizeof(payload_size));
+			buffer.append(payload);
+		}
+	}
+	//=============================================================================================//
+	void RestartIO::readConfigurationsFromFile(SPHBody *body, const std::string &filefullpath)
+	{
+		std::string buffer = loadConfigurationCheckpoint(filefullpath);
+		const char *current = buffer.data();
+		const char *end = buffer.data() + buffer.size();
+		auto read_bytes = [&](void *target, size_t bytes) -> bool
+		{
+			if (current + bytes > end)
+				return false;
+			memcpy(target, current, bytes);
+			current += bytes;
+			return true;
+		};
+
+		uint32_t format_version = 0, real_bytes = 0, vecd_bytes = 0;
+		uint64_t total_real_particles = 0, relation_count = 0;
+		bool validated = read_bytes(&format_version, sizeof(format_version)) &&
+						 read_bytes(&real_bytes, sizeof(real_bytes)) &&
+						 read_bytes(&vecd_bytes, sizeof(vecd_bytes)) &&
+						 read_bytes(&total_real_particles, sizeof(total_real_particles)) &&
+						 read_bytes(&relation_count, sizeof(relation_count)) &&
+						 format_version == 1 &&
+						 real_bytes == sizeof(Real) && vecd_bytes == sizeof(Vecd) &&
+						 total_real_particles == body->base_particles_->total_real_particles_ &&
+						 relation_count == body->body_relations_.size();
+
+		for (size_t n = 0; validated && n != body->body_relations_.size(); ++n)
+		{
+			SPHBodyRelation *relation = body->body_relations_[n];
+			uint64_t name_length = 0;
+			validated = read_bytes(&name_length, sizeof(name_length)) &&
+						current + name_length <= end;
+			if (!validated)
+				break;
+			std::string recorded_name(current, name_length);
+			current += name_length;
+			uint64_t payload_size = 0;
+			validated = recorded_name == typeid(*relation).name() &&
+						read_bytes(&payload_size, sizeof(payload_size)) &&
+						current + payload_size <= end;
+			if (!validated)
+				break;
+			const char *payload_end = current + payload_size;
+			// a relation without serialization support recorded nothing
+			// and is left for the normal rebuild
+			if (payload_size > 0)
+				validated = relation->readConfigurationFromBuffer(current, payload_end) &&
+							current == payload_end;
+			current = payload_end;
+		}
+
+		if (!validated)
+		{
+			std::cout << "\n Error: the configuration checkpoint " << filefullpath
+					  << " does not match the present simulation setup" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
 		}
 	}
 	//=============================================================================================//
@@ -395,33 +2219,64 @@ namespace SPH
 		: WriteSimBodyStates<SimTK::MobilizedBody::Pin>(in_output, integ, pinbody),
 		filefullpath_(in_output_.output_folder_ + "/mb_pinbody_data.dat")
 	{
-		std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
+		out_file_.open(filefullpath_.c_str(), std::ios::app);
 
-		out_file << "\"time\""
-				 << "   ";
-		out_file << "  "
-				 << "angles"
-				 << " ";
-		out_file << "  "
-				 << "angle_rates"
-				 << " ";
-		out_file << "\n";
+		out_file_ << "\"time\""
+				  << "   ";
+		out_file_ << "  "
+				  << "angles"
+				  << " ";
+		out_file_ << "  "
+				  << "angle_rates"
+				  << " ";
+		out_file_ << "\n";
 
-		out_file.close();
+		out_file_.flush();
 	};
 	//=============================================================================================//
 	void WriteSimBodyPinData::writeToFile(size_t iteration_step)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
-		out_file << GlobalStaticVariables::physical_time_ << "   ";
+		out_file_ << GlobalStaticVariables::physical_time_ << "   ";
 		const SimTK::State &state = integ_.getState();
 
-		out_file << "  " << mobody_.getAngle(state) << "  " << mobody_.getRate(state) << "  ";
+		out_file_ << "  " << mobody_.getAngle(state) << "  " << mobody_.getRate(state) << "  ";
 
-		out_file << "\n";
-		out_file.close();
+		out_file_ << "\n";
+		out_file_.flush();
 	};
 	//=================================================================================================//
+	DynamicsTimingRecording::DynamicsTimingRecording(InOutput &in_output)
+		: filefullpath_(in_output.output_folder_ + "/dynamics_timing.dat") {}
+	//=================================================================================================//
+	void DynamicsTimingRecording::writeToFile(size_t iteration_step)
+	{
+		StdVec<ParticleDynamicsTiming *> timings = ParticleDynamicsTiming::RegisteredTimings();
+		std::sort(timings.begin(), timings.end(),
+				  [](ParticleDynamicsTiming *a, ParticleDynamicsTiming *b)
+				  { return a->accumulated_seconds_ > b->accumulated_seconds_; });
+
+		std::ofstream out_file(filefullpath_.c_str(), std::ios::trunc);
+		out_file << "wall_time(s)"
+				 << "   "
+				 << "calls"
+				 << "   "
+				 << "particles_processed"
+				 << "   "
+				 << "time_per_call(s)"
+				 << "   "
+				 << "dynamics"
+				 << "\n";
+		for (ParticleDynamicsTiming *timing : timings)
+		{
+			out_file << timing->accumulated_seconds_ << "   "
+					 << timing->call_count_ << "   "
+					 << timing->particles_processed_ << "   "
+					 << timing->accumulated_seconds_ / (double)timing->call_count_ << "   "
+					 << timing->name_ << "\n";
+		}
+		out_file.close();
+	}
+	//=================================================================================================//
 	ReloadMaterialParameterIO::ReloadMaterialParameterIO(InOutput &in_output, BaseMaterial *base_material)
 		: in_output_(in_output), base_material_(base_material),
 		  file_path_(in_output.reload_folder_ + "/Material_" + base_material->LocalParametersName() + "_rld.xml") {}
@@ -433,12 +2288,6 @@ namespace SPH
 	//=================================================================================================//
 	void ReloadMaterialParameterIO::writeToFile(size_t iteration_step)
 	{
-		std::string reload_material_folder = in_output_.reload_folder_;
-		if (!fs::exists(reload_material_folder))
-		{
-			fs::create_directory(reload_material_folder);
-		}
-
 		if (fs::exists(file_path_))
 		{
 			fs::remove(file_path_);
@@ -38,6 +38,9 @@
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 /** Macro for APPLE compilers*/
 #ifdef __APPLE__
 #include <boost/filesystem.hpp>
@@ -77,10 +80,69 @@ namespace SPH
 		std::string restart_folder_;
 		std::string reload_folder_;
 		std::string restart_step_;
+		int restart_compression_level_; /**< 0 leaves the checkpoint files uncompressed. */
+
+		/** compress the binary checkpoint files transparently before they
+		 * reach the filesystem; reading detects compressed files by their
+		 * magic, so restarting works with and without the switch */
+		void useCompressedRestartFiles(int compression_level = 3)
+		{
+			restart_compression_level_ = SMAX(SMIN(compression_level, 9), 1);
+		};
+
+		/** dump the trace events recorded since TraceEventRecording was
+		 * switched on as a chrome://tracing JSON file in the output folder
+		 * and clear the recording */
+		void writeTraceEventsToJson();
+
+		/** write the loop decisions locked in by LoopTuning to the output
+		 * folder, typically at the end of the run */
+		void writeLoopTuningParameters();
+		/** adopt the loop decisions of a previous run, so that the tuned
+		 * loops skip their measuring invocations */
+		void readLoopTuningParameters();
 
 		ParameterizationIO &defineParameterizationIO();
 	};
 
+	/**
+	 * @class SimulationStatusRecording
+	 * @brief Live telemetry of a long run: a small machine-readable status
+	 * file in the output folder, rewritten atomically at a wall-clock
+	 * interval from the stepping driver. It publishes the step number, the
+	 * physical time, the stepping rate, the quantities published by the
+	 * driver, e.g. the current time-step criteria, the memory counters of
+	 * all real bodies and, when ParticleDynamicsTiming is switched on, the
+	 * accumulated per-dynamics timings, so that a collapsing time step or a
+	 * load imbalance is visible while the run continues. Off-interval calls
+	 * only read the clock and cost nothing.
+	 */
+	class SimulationStatusRecording
+	{
+	public:
+		explicit SimulationStatusRecording(InOutput &in_output, Real rewrite_interval_seconds = 10.0);
+		virtual ~SimulationStatusRecording(){};
+
+		/** publish a named quantity, e.g. a time-step criterion,
+		 * with the next status rewrite */
+		void publishQuantity(const std::string &name, Real value);
+		/** to be called once per outer step; rewrites the status file
+		 * when the rewrite interval has passed */
+		void recordStep(size_t step_number);
+
+	protected:
+		InOutput &in_output_;
+		std::string status_file_path_;
+		Real rewrite_interval_seconds_;
+		tbb::tick_count last_rewrite_time_;
+		size_t last_rewrite_step_;  /**< step number at the previous rewrite, for the stepping rate. */
+		size_t current_step_;
+		StdVec<std::pair<std::string, Real>> published_quantities_;
+
+		/** rewrite the status file, atomically through a rename */
+		void writeStatusFile();
+	};
+
 	/**
 	 * @class PltEngine
 	 * @brief The base class which defines Tecplot file related operation.
@@ -118,6 +180,35 @@ namespace SPH
 		virtual ~BodyStatesIO(){};
 	};
 
+	/**
+	 * @class ParticleDataSnapshot
+	 * @brief copy of the particle variables to write of a body
+	 * so that formatting and file writing can be carried out on an I/O thread
+	 * while the simulation continues to modify the particle data.
+	 */
+	class ParticleDataSnapshot
+	{
+	public:
+		ParticleDataSnapshot() : newly_updated_(false), total_real_particles_(0){};
+		~ParticleDataSnapshot(){};
+
+		bool newly_updated_;
+		std::string body_name_;
+		size_t total_real_particles_;
+		std::map<std::string, int> variable_encodings_; /**< the per-variable output encodings of the recorder. */
+		StdLargeVec<Vecd> pos_n_;
+		StdLargeVec<size_t> unsorted_id_;
+		StdVec<std::pair<std::string, StdLargeVec<Real>>> scalar_variables_;
+		StdVec<std::pair<std::string, StdLargeVec<Vecd>>> vector_variables_;
+		StdVec<std::pair<std::string, StdLargeVec<Matd>>> matrix_variables_;
+		StdVec<std::pair<std::string, StdLargeVec<int>>> integer_variables_;
+
+		/** copy the given variables from the body, called on the simulation thread */
+		void takeSnapshot(SPHBody *body, const ParticleVariableList &variables_to_write);
+		/** write the snapshot in vtp format, called on the I/O thread */
+		void writeToVtpFile(std::ofstream &output_file) const;
+	};
+
 	/**
 	 * @class BodyStatesRecording
 	 * @brief base class for write body states.
@@ -126,22 +217,145 @@ namespace SPH
 	{
 	public:
 		BodyStatesRecording(InOutput &in_output, SPHBody &body)
-			: BodyStatesIO(in_output, body){};
+			: BodyStatesIO(in_output, body), use_selected_variables_(false),
+			  write_interval_(1), write_call_count_(0),
+			  change_triggered_writing_(false), velocity_change_ratio_(0.1),
+			  indicator_change_ratio_(0.01), min_write_interval_(1),
+			  max_write_interval_(100), calls_since_last_write_(0),
+			  io_concurrency_(1), asynchronous_writing_(false), filling_buffer_(0),
+			  job_buffer_(-1), writing_buffer_(-1), terminate_io_thread_(false){};
 		BodyStatesRecording(InOutput &in_output, SPHBodyVector bodies)
-			: BodyStatesIO(in_output, bodies){};
-		virtual ~BodyStatesRecording(){};
+			: BodyStatesIO(in_output, bodies), use_selected_variables_(false),
+			  write_interval_(1), write_call_count_(0),
+			  change_triggered_writing_(false), velocity_change_ratio_(0.1),
+			  indicator_change_ratio_(0.01), min_write_interval_(1),
+			  max_write_interval_(100), calls_since_last_write_(0),
+			  io_concurrency_(1), asynchronous_writing_(false), filling_buffer_(0),
+			  job_buffer_(-1), writing_buffer_(-1), terminate_io_thread_(false){};
+		virtual ~BodyStatesRecording();
 
 		/** write with filename indicated by physical time */
 		void writeToFile()
 		{
-			writeWithFileName(convertPhysicalTimeToString(GlobalStaticVariables::physical_time_));
+			dispatchWriting(convertPhysicalTimeToString(GlobalStaticVariables::physical_time_));
 		};
 
 		/** write with filename indicated by iteration step */
 		virtual void writeToFile(size_t iteration_step);
 
+		/** restrict this recorder to the named variables, resolved against all
+		 * registered variables of each body, so that a cheap high-rate monitoring
+		 * stream does not pay for the full set of variables to write.
+		 * position and particle ids are always written. */
+		void selectVariablesToWrite(const StdVec<std::string> &variable_names)
+		{
+			selected_variable_names_ = variable_names;
+			use_selected_variables_ = true;
+		};
+
+		/** write only at every given number of calls, so that recorders with
+		 * different cadences can share the same output loop */
+		void setWriteInterval(size_t write_interval) { write_interval_ = write_interval; };
+
+		/** write on change instead of on a fixed cadence: each write call
+		 * evaluates cheap change metrics — the relative change of the maximum
+		 * particle speed and, for bodies carrying the SurfaceIndicator
+		 * variable, the fraction of particles whose indicator flipped since
+		 * the last dump — and a file is only written when a metric exceeds
+		 * its threshold. The interval bounds are given in write calls: the
+		 * minimum suppresses dump bursts during violent transients and the
+		 * maximum guarantees coverage of quiescent phases. */
+		void useChangeTriggeredWriting(Real velocity_change_ratio = 0.1, Real indicator_change_ratio = 0.01,
+									   size_t min_write_interval = 1, size_t max_write_interval = 100)
+		{
+			change_triggered_writing_ = true;
+			velocity_change_ratio_ = velocity_change_ratio;
+			indicator_change_ratio_ = indicator_change_ratio;
+			min_write_interval_ = min_write_interval;
+			max_write_interval_ = max_write_interval;
+		};
+
+		/** per-variable output encodings, trading output precision for dump volume */
+		enum VariableEncoding
+		{
+			EncodeFloat32 = 0, /**< single precision, the default. */
+			EncodeFloat16,	   /**< mantissa rounded to half precision, stored as Float32. */
+			EncodeFixedPoint16 /**< 16-bit fixed point codes with range metadata. */
+		};
+		/** choose the output encoding of the named scalar or vector variable.
+		 * Visualization rarely needs full precision: EncodeFloat16 zeroes the
+		 * low mantissa bits so the arrays shrink drastically under downstream
+		 * compression, and EncodeFixedPoint16 halves the stored bytes outright
+		 * by writing 16-bit codes, with the range recorded in the RangeMinimum
+		 * and RangeSpacing attributes of the data array; the codes remain
+		 * monotonic in the value, so color mapping works directly. Applies to
+		 * the binary vtp format and the snapshots of asynchronous writing. */
+		void setVariableEncoding(const std::string &variable_name, VariableEncoding encoding)
+		{
+			variable_encodings_[variable_name] = encoding;
+		};
+
+		/** format and write the bodies of a dump concurrently, each body in
+		 * its own task, bounded by the given concurrency budget. The bodies
+		 * format independently, so a multi-body dump completes in roughly
+		 * the time of its largest single body. Combines with asynchronous
+		 * writing, where the tasks then run within the I/O thread's job. */
+		void useConcurrentBodyWriting(size_t io_concurrency = 4)
+		{
+			io_concurrency_ = SMAX(io_concurrency, size_t(1));
+		};
+
+		/** snapshot the particle data into a double buffer and hand
+		 * formatting and file writing to a dedicated I/O thread */
+		void useAsynchronousWriting();
+		/** block until the I/O thread has written all pending snapshots */
+		void finishAsynchronousWriting();
+
 	protected:
+		StdVec<std::string> selected_variable_names_; /**< the variable selection of this recorder. */
+		bool use_selected_variables_;
+		size_t write_interval_;	  /**< write at every this number of calls. */
+		size_t write_call_count_; /**< the number of write calls received so far. */
+		std::map<std::string, int> variable_encodings_; /**< the chosen encoding of each encoded variable. */
+		bool change_triggered_writing_;					/**< write on change metrics instead of a fixed cadence. */
+		Real velocity_change_ratio_;					/**< relative maximum-speed change triggering a dump. */
+		Real indicator_change_ratio_;					/**< surface-indicator flip fraction triggering a dump. */
+		size_t min_write_interval_;						/**< write calls to suppress after a dump. */
+		size_t max_write_interval_;						/**< write calls after which a dump is forced. */
+		size_t calls_since_last_write_;					/**< write calls since the last actual dump. */
+		size_t io_concurrency_;							/**< the number of bodies formatted and written concurrently. */
+		StdVec<Real> max_speed_at_last_write_;			/**< per-body baseline of the velocity metric. */
+		StdVec<StdVec<int>> indicator_at_last_write_;	/**< per-body baseline of the surface indicator. */
+
+		/** whether the change metrics or the interval bounds demand a dump */
+		bool changeExceedsThresholds();
+		/** reset the change baselines to the state being dumped */
+		void refreshChangeBaselines();
+
 		virtual void writeWithFileName(const std::string &sequence) = 0;
+		/** write the snapshots of all bodies, called on the I/O thread */
+		virtual void writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence);
+		/** run the given per-body writing job for the given number of bodies,
+		 * concurrently within the concurrency budget when one is set */
+		void forEachBodyWritingJob(size_t number_of_jobs, const std::function<void(size_t)> &writing_job);
+		/** write directly or snapshot and delegate to the I/O thread */
+		void dispatchWriting(const std::string &sequence);
+		/** the variable list this recorder writes for a body */
+		ParticleVariableList getVariablesToWrite(SPHBody *body);
+
+	private:
+		bool asynchronous_writing_;
+		StdVec<ParticleDataSnapshot> snapshot_buffers_[2];
+		int filling_buffer_;  /**< buffer the next snapshot goes into. */
+		int job_buffer_;	  /**< buffer handed over to the I/O thread, -1 if none. */
+		int writing_buffer_;  /**< buffer the I/O thread is writing, -1 if none. */
+		std::string job_sequence_;
+		bool terminate_io_thread_;
+		std::thread io_thread_;
+		std::mutex io_mutex_;
+		std::condition_variable io_condition_;
+
+		void ioThreadWorker();
 	};
 
 	/**
@@ -203,15 +417,75 @@ namespace SPH
 	{
 	public:
 		BodyStatesRecordingToVtp(InOutput &in_output, SPHBody &body)
-			: BodyStatesRecording(in_output, body){};
+			: BodyStatesRecording(in_output, body), write_binary_(false){};
 		BodyStatesRecordingToVtp(InOutput &in_output, SPHBodyVector bodies)
-			: BodyStatesRecording(in_output, bodies){};
+			: BodyStatesRecording(in_output, bodies), write_binary_(false){};
 		virtual ~BodyStatesRecordingToVtp(){};
 
+		/** write the particle data as raw appended binary data arrays
+		 * instead of ascii, which is both smaller and much faster to format */
+		void useBinaryFormat() { write_binary_ = true; };
+
+	protected:
+		bool write_binary_;
+
+		virtual void writeWithFileName(const std::string &sequence) override;
+		virtual void writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence) override;
+		/** format and write the vtp file of one body, independent of the other bodies */
+		void writeVtpFileForBody(SPHBody *body, const std::string &sequence);
+		void writeBinaryVtpFile(std::ofstream &out_file, SPHBody *body);
+	};
+
+	/**
+	 * @class BodyRegionStatesRecordingToVtp
+	 * @brief  Write files for the particles within a region of interest only.
+	 * The region is given as a body part by cells, so the contained particles
+	 * are collected from the tagged cells of the cell linked list instead of
+	 * testing every particle against the region shape.
+	 */
+	class BodyRegionStatesRecordingToVtp : public BodyStatesRecording
+	{
+	public:
+		BodyRegionStatesRecordingToVtp(InOutput &in_output, BodyPartByCell &body_part)
+			: BodyStatesRecording(in_output, *body_part.getSPHBody()), body_part_(&body_part){};
+		virtual ~BodyRegionStatesRecordingToVtp(){};
+
 	protected:
+		BodyPartByCell *body_part_;
+
 		virtual void writeWithFileName(const std::string &sequence) override;
 	};
 
+	/**
+	 * @class PreviewStatesRecordingToVtp
+	 * @brief  Write a deterministic spatial subsample of the body states for
+	 * near-real-time monitoring: the first listed particle of every occupied
+	 * cell of the cell linked list, which preserves the spatial coverage of
+	 * the flow field at a small fraction of the particles and of the I/O
+	 * cost. At every given number of preview writes a full dump is written
+	 * instead, so that the detailed states remain available at a low cadence.
+	 * Bodies without cell lists fall back to a fixed-stride subsample.
+	 */
+	class PreviewStatesRecordingToVtp : public BodyStatesRecordingToVtp
+	{
+	public:
+		PreviewStatesRecordingToVtp(InOutput &in_output, SPHBody &body, size_t full_dump_interval = 64)
+			: BodyStatesRecordingToVtp(in_output, body),
+			  full_dump_interval_(full_dump_interval), preview_write_count_(0){};
+		PreviewStatesRecordingToVtp(InOutput &in_output, SPHBodyVector bodies, size_t full_dump_interval = 64)
+			: BodyStatesRecordingToVtp(in_output, bodies),
+			  full_dump_interval_(full_dump_interval), preview_write_count_(0){};
+		virtual ~PreviewStatesRecordingToVtp(){};
+
+	protected:
+		size_t full_dump_interval_;	 /**< preview writes between two full dumps, 0 disables the full dumps. */
+		size_t preview_write_count_; /**< the number of writes dispatched so far. */
+
+		virtual void writeWithFileName(const std::string &sequence) override;
+		/** the first listed particle of every occupied cell of the body */
+		IndexVector collectPreviewParticles(SPHBody *body);
+	};
+
 	/**
 	 * @class BodyStatesRecordingToVtpString
 	 * @brief  Write strings for bodies
@@ -239,6 +513,87 @@ namespace SPH
 		VtuStringData _vtuData;
 	};
 
+	/**
+	 * @class BodyStatesRecordingToTimeSeries
+	 * @brief  Append the states of all time steps to one streaming time-series
+	 * file per body instead of writing one file per body and step, which
+	 * floods parallel filesystems with metadata operations in long campaigns.
+	 * Every step appends one binary block of the written variables to
+	 * SPHBody_<name>_TimeSeries.dat, and one ascii line with the sequence,
+	 * the byte offset and the particle count of the block to the matching
+	 * .idx file, so that any step can be located with a single seek.
+	 * The streams stay open across the appends, and the blocks are equally
+	 * written by the I/O thread under the asynchronous writing.
+	 */
+	class BodyStatesRecordingToTimeSeries : public BodyStatesRecording
+	{
+	public:
+		BodyStatesRecordingToTimeSeries(InOutput &in_output, SPHBody &body)
+			: BodyStatesRecording(in_output, body){};
+		BodyStatesRecordingToTimeSeries(InOutput &in_output, SPHBodyVector bodies)
+			: BodyStatesRecording(in_output, bodies){};
+		virtual ~BodyStatesRecordingToTimeSeries(){};
+
+	protected:
+		std::map<std::string, UniquePtr<std::ofstream>> data_streams_;	/**< the open time-series file of each body. */
+		std::map<std::string, UniquePtr<std::ofstream>> index_streams_; /**< the open step-index file of each body. */
+
+		virtual void writeWithFileName(const std::string &sequence) override;
+		virtual void writeSnapshotsWithFileName(StdVec<ParticleDataSnapshot> &snapshots, const std::string &sequence) override;
+		/** append one snapshot as a binary step block and register it in the index */
+		void appendSnapshot(const ParticleDataSnapshot &snapshot, const std::string &sequence);
+		/** the open files of the named body, created with the format header on first use */
+		std::ofstream &timeSeriesStream(const std::string &body_name);
+		std::ofstream &indexStream(const std::string &body_name);
+	};
+
+	/**
+	 * @struct ParticleVariableView
+	 * @brief A zero-copy view of one registered particle variable.
+	 * The data pointer refers to the live particle storage and is
+	 * only valid during the in-situ callback it is handed to.
+	 */
+	struct ParticleVariableView
+	{
+		std::string body_name_;
+		std::string variable_name_;
+		int type_index_;			  /**< ParticleDataTypeIndex of the variable type. */
+		size_t value_size_;			  /**< size of one value in bytes. */
+		size_t total_real_particles_; /**< the number of values behind the pointer. */
+		const void *data_;			  /**< the value of the first real particle. */
+	};
+
+	/**
+	 * @class BodyStatesProcessingInSitu
+	 * @brief Hand the registered output variables of the bodies to in-situ
+	 * processors as zero-copy views instead of serializing them, so that a
+	 * co-processing pipeline, e.g. a Catalyst or ParaView adapter set up by
+	 * the application, consumes the live particle data without extra copies
+	 * or files. The processors are invoked synchronously every
+	 * trigger_cadence recordings; the particle data must not be modified
+	 * before they return.
+	 */
+	class BodyStatesProcessingInSitu : public BodyStatesRecording
+	{
+	public:
+		/** processor called with the recording sequence and the variable views. */
+		using InSituProcessor = std::function<void(const std::string &, const StdVec<ParticleVariableView> &)>;
+
+		BodyStatesProcessingInSitu(InOutput &in_output, SPHBodyVector bodies, size_t trigger_cadence = 1)
+			: BodyStatesRecording(in_output, bodies),
+			  trigger_cadence_(SMAX(trigger_cadence, size_t(1))), write_count_(0){};
+		virtual ~BodyStatesProcessingInSitu(){};
+
+		void addProcessor(const InSituProcessor &processor) { processors_.push_back(processor); };
+
+	protected:
+		size_t trigger_cadence_; /**< invoke the processors every so many recordings. */
+		size_t write_count_;
+		StdVec<InSituProcessor> processors_;
+
+		virtual void writeWithFileName(const std::string &sequence) override;
+	};
+
 	/**
 	 * @class BodyStatesRecordingToPlt
 	 * @brief  Write files for bodies
@@ -248,13 +603,19 @@ namespace SPH
 	{
 	public:
 		BodyStatesRecordingToPlt(InOutput &in_output, SPHBody &body)
-			: BodyStatesRecording(in_output, body){};
+			: BodyStatesRecording(in_output, body), write_binary_(false){};
 		BodyStatesRecordingToPlt(InOutput &in_output, SPHBodyVector bodies)
-			: BodyStatesRecording(in_output, bodies){};
+			: BodyStatesRecording(in_output, bodies), write_binary_(false){};
 		virtual ~BodyStatesRecordingToPlt(){};
 
+		/** switch to the Tecplot binary format, writing the particle data
+		 * as packed single precision arrays instead of formatted text. */
+		void useBinaryFormat() { write_binary_ = true; };
+
 	protected:
+		bool write_binary_;
 		virtual void writeWithFileName(const std::string &sequence) override;
+		void writeBinaryPltFile(std::ofstream &out_file, SPHBody *body);
 	};
 
 	/**
@@ -284,6 +645,7 @@ namespace SPH
 	{
 	protected:
 		std::string filefullpath_;
+		std::ofstream out_file_; /**< persistent stream, kept open over the recording cadence. */
 		BaseMeshField *mesh_field_;
 		virtual void writeWithFileName(const std::string &sequence) override;
 
@@ -307,6 +669,7 @@ namespace SPH
 		std::string body_name_;
 		const std::string quantity_name_;
 		std::string filefullpath_output_;
+		std::ofstream out_file_; /**< persistent stream, kept open over the observation cadence. */
 
 	public:
 		VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
@@ -322,33 +685,63 @@ namespace SPH
 		{
 			/** Output for .dat file. */
 			filefullpath_output_ = in_output_.output_folder_ + "/" + body_name_ + "_" + quantity_name + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << "run_time"
-					 << "   ";
+			out_file_.open(filefullpath_output_.c_str(), std::ios::app);
+			out_file_ << "run_time"
+					  << "   ";
 			for (size_t i = 0; i != base_particles_->total_real_particles_; ++i)
 			{
 				std::string quantity_name_i = quantity_name + "[" + std::to_string(i) + "]";
-				plt_engine_.writeAQuantityHeader(out_file, (*this->interpolated_quantities_)[i], quantity_name_i);
+				plt_engine_.writeAQuantityHeader(out_file_, (*this->interpolated_quantities_)[i], quantity_name_i);
 			}
-			out_file << "\n";
-			out_file.close();
+			out_file_ << "\n";
+			out_file_.flush();
 		};
 		virtual ~ObservedQuantityRecording(){};
 
 		virtual void writeWithFileName(const std::string &sequence) override
 		{
 			this->parallel_exec();
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << GlobalStaticVariables::physical_time_ << "   ";
+			out_file_ << GlobalStaticVariables::physical_time_ << "   ";
 			for (size_t i = 0; i != base_particles_->total_real_particles_; ++i)
 			{
-				plt_engine_.writeAQuantity(out_file, (*this->interpolated_quantities_)[i]);
+				plt_engine_.writeAQuantity(out_file_, (*this->interpolated_quantities_)[i]);
 			}
-			out_file << "\n";
-			out_file.close();
+			out_file_ << "\n";
+			out_file_.flush();
 		};
 	};
 
+	/**
+	 * @class ObservedQuantitiesRecording
+	 * @brief Batched observer recording: all registered quantities of an
+	 * observer body are interpolated in one contact-configuration traversal
+	 * and appended to a binary columnar log flushed asynchronously.
+	 * The log starts with the number of observe points and, per quantity,
+	 * its name and column width; each record holds the physical time
+	 * followed by the columns of all quantities for all observe points.
+	 */
+	class ObservedQuantitiesRecording : public BodyStatesRecording,
+										public observer_dynamics::ObservingQuantities
+	{
+	protected:
+		SPHBody *observer_;
+		BaseParticles *observer_particles_;
+		std::string body_name_;
+		std::string filefullpath_output_;
+		bool header_written_;
+		StdVec<Real> pending_records_;
+		StdVec<Real> flushing_records_;
+		tbb::task_group flush_tasks_;
+
+		void writeHeader();
+		void flushRecords();
+		virtual void writeWithFileName(const std::string &sequence) override;
+
+	public:
+		ObservedQuantitiesRecording(InOutput &in_output, BaseBodyRelationContact &contact_relation);
+		virtual ~ObservedQuantitiesRecording() noexcept;
+	};
+
 	/**
 	 * @class BodyReducedQuantityRecording
 	 * @brief write reduced quantity of a body
@@ -363,6 +756,7 @@ namespace SPH
 		std::string body_name_;
 		const std::string quantity_name_;
 		std::string filefullpath_output_;
+		std::ofstream out_file_; /**< persistent stream, kept open over the recording cadence. */
 
 	public:
 		/*< deduce variable type from reduce method. */
@@ -378,33 +772,56 @@ namespace SPH
 		{
 			/** output for .dat file. */
 			filefullpath_output_ = in_output_.output_folder_ + "/" + body_name_ + "_" + quantity_name_ + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << "\"run_time\""
-					 << "   ";
-			plt_engine_.writeAQuantityHeader(out_file, reduce_method_.InitialReference(), quantity_name_);
-			out_file << "\n";
-			out_file.close();
+			out_file_.open(filefullpath_output_.c_str(), std::ios::app);
+			out_file_ << "\"run_time\""
+					  << "   ";
+			plt_engine_.writeAQuantityHeader(out_file_, reduce_method_.InitialReference(), quantity_name_);
+			out_file_ << "\n";
+			out_file_.flush();
 		};
 		virtual ~BodyReducedQuantityRecording(){};
 
 		virtual void writeToFile(size_t iteration_step = 0)
 		{
-			std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-			out_file << GlobalStaticVariables::physical_time_ << "   ";
-			plt_engine_.writeAQuantity(out_file, reduce_method_.parallel_exec());
-			out_file << "\n";
-			out_file.close();
+			out_file_ << GlobalStaticVariables::physical_time_ << "   ";
+			plt_engine_.writeAQuantity(out_file_, reduce_method_.parallel_exec());
+			out_file_ << "\n";
+			out_file_.flush();
 		};
 	};
 
+	/**
+	 * @class MemoryFootprintRecording
+	 * @brief write the allocated bytes of the major memory consumers of each
+	 * body, itemized by subsystem: particle variables, the neighbor
+	 * configurations of all subscribed relations, the cell linked list and
+	 * the level-set mesh of the body shape. One line is appended per body
+	 * and call, so the growth of each consumer can be followed over a run
+	 * for capacity planning.
+	 */
+	class MemoryFootprintRecording : public BodyStatesIO
+	{
+	protected:
+		std::string filefullpath_output_;
+		std::ofstream out_file_; /**< persistent stream, kept open over the recording cadence. */
+
+	public:
+		MemoryFootprintRecording(InOutput &in_output, SPHBodyVector bodies);
+		virtual ~MemoryFootprintRecording(){};
+
+		virtual void writeToFile(size_t iteration_step = 0);
+	};
+
 	/**
 	 * @class ReloadParticleIO
-	 * @brief Write the reload particles file in XML format.
+	 * @brief Write the reload particles file in binary and XML format.
+	 * Reading prefers the binary file and falls back to XML.
 	 */
 	class ReloadParticleIO : public BodyStatesIO
 	{
 	protected:
 		StdVec<std::string> file_paths_;
+		StdVec<std::string> binary_file_paths_;
 
 	public:
 		ReloadParticleIO(InOutput &in_output, SPHBodyVector bodies);
@@ -417,19 +834,59 @@ namespace SPH
 
 	/**
 	 * @class RestartIO
-	 * @brief Write the restart file in XML format.
+	 * @brief Write and read the restart checkpoints in binary format.
 	 */
 	class RestartIO : public BodyStatesIO
 	{
 	protected:
 		std::string overall_file_path_;
 		StdVec<std::string> file_paths_;
+		bool use_delta_checkpoints_;
+		size_t full_checkpoint_interval_;
+		size_t checkpoint_count_; /**< the number of checkpoints written so far. */
+		size_t last_full_step_;	  /**< iteration step of the last full checkpoint. */
+		StdVec<std::string> last_full_snapshots_; /**< serialized last full checkpoint of each body. */
+		bool use_configuration_checkpoints_;	  /**< whether the neighbor configurations are checkpointed too. */
+		bool configurations_restored_;			  /**< whether the last read also restored the configurations. */
 
 		Real readRestartTime(size_t restart_step);
+		/** the full-checkpoint step recorded in the overall file of the given step */
+		size_t readFullCheckpointStep(size_t restart_step);
+		/** serialize the neighbor configurations of a body with a layout header */
+		void writeConfigurationsToBuffer(SPHBody *body, std::string &buffer);
+		/** restore the neighbor configurations of a body, exits on a stale checkpoint */
+		void readConfigurationsFromFile(SPHBody *body, const std::string &filefullpath);
 
 	public:
 		RestartIO(InOutput &in_output, SPHBodyVector bodies);
-		virtual ~RestartIO(){};
+		virtual ~RestartIO();
+
+		/** write every given number of checkpoints as a full checkpoint and the
+		 * ones in between as deltas holding only the variables which changed
+		 * since the last full checkpoint, so that, e.g., the reference
+		 * configuration data of solids is not dumped over and over */
+		void useDeltaCheckpoints(size_t full_checkpoint_interval)
+		{
+			use_delta_checkpoints_ = true;
+			full_checkpoint_interval_ = SMAX(full_checkpoint_interval, size_t(1));
+		};
+		/** additionally write the built neighbor configurations of the bodies
+		 * at every full checkpoint, so that a resumed run restores them
+		 * instead of rebuilding them from scratch. On reading, the cell
+		 * linked lists are refreshed from the restored positions, which is
+		 * a cheap linear pass, and the recorded relation layouts are
+		 * validated against the present setup. The driver checks
+		 * configurationsRestored() after readFromFile() and skips the
+		 * initial configuration build when it returns true. */
+		void useConfigurationCheckpoints() { use_configuration_checkpoints_ = true; };
+		/** whether the last readFromFile() also restored the neighbor configurations */
+		bool configurationsRestored() { return configurations_restored_; };
+		/** snapshot the restart variables into memory buffers and hand the
+		 * file writing to a dedicated I/O thread, so that initiating a
+		 * checkpoint only costs the in-memory serialization */
+		void useAsynchronousWriting();
+		/** block until the I/O thread has written the pending checkpoint */
+		void finishAsynchronousWriting();
 
 		virtual void writeToFile(size_t iteration_step = 0);
 		virtual void readFromFile(size_t iteration_step = 0);
@@ -438,6 +895,19 @@ namespace SPH
 			readFromFile(restart_step);
 			return readRestartTime(restart_step);
 		};
+
+	private:
+		bool asynchronous_writing_;
+		StdVec<std::string> job_buffers_;	 /**< serialized checkpoint handed to the I/O thread. */
+		StdVec<std::string> job_file_paths_; /**< destination files of the handed-over checkpoint. */
+		bool job_pending_;
+		bool terminate_io_thread_;
+		std::thread io_thread_;
+		std::mutex io_mutex_;
+		std::condition_variable io_condition_;
+
+		void writeBufferToFile(const std::string &buffer, const std::string &filefullpath);
+		void ioThreadWorker();
 	};
 
 	/**
@@ -448,6 +918,7 @@ namespace SPH
 	{
 	protected:
 		std::string filefullpath_;
+		std::ofstream out_file_; /**< persistent stream, kept open over the recording cadence. */
 
 	public:
 		WriteSimBodyPinData(InOutput &in_output, SimTK::RungeKuttaMersonIntegrator &integ, SimTK::MobilizedBody::Pin &pinbody);
@@ -455,6 +926,25 @@ namespace SPH
 		virtual void writeToFile(size_t iteration_step = 0) override;
 	};
 
+	/**
+	 * @class DynamicsTimingRecording
+	 * @brief Write the summary of the per-dynamics timing surface,
+	 * sorted by accumulated wall time, so that the hot dynamics of a
+	 * simulation are found without manual timers in the case code.
+	 * The timing surface is switched on by ParticleDynamicsTiming::switchOn().
+	 */
+	class DynamicsTimingRecording
+	{
+	protected:
+		std::string filefullpath_;
+
+	public:
+		explicit DynamicsTimingRecording(InOutput &in_output);
+		virtual ~DynamicsTimingRecording(){};
+
+		virtual void writeToFile(size_t iteration_step = 0);
+	};
+
 	/**
 	 * @class ReloadMaterialParameterIO
 	 * @brief For write  and read material property.
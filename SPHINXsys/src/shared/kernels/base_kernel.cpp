@@ -154,6 +154,26 @@ namespace SPH
 		return factor_d2W_3D_ * d2W_3D(q) * h_factor_d2W_3D_(h_ratio);
 	}
 	//=================================================================================================//
+	void Kernel::W_batch(size_t batch_size, const Real *r_ij, Real *W) const
+	{
+		Real factor_W = Dimensions == 2 ? factor_W_2D_ : factor_W_3D_;
+		for (size_t n = 0; n != batch_size; ++n)
+		{
+			Real q = r_ij[n] * inv_h_;
+			W[n] = factor_W * (Dimensions == 2 ? W_2D(q) : W_3D(q));
+		}
+	}
+	//=================================================================================================//
+	void Kernel::dW_batch(size_t batch_size, const Real *r_ij, Real *dW) const
+	{
+		Real factor_dW = Dimensions == 2 ? factor_dW_2D_ : factor_dW_3D_;
+		for (size_t n = 0; n != batch_size; ++n)
+		{
+			Real q = r_ij[n] * inv_h_;
+			dW[n] = factor_dW * (Dimensions == 2 ? dW_2D(q) : dW_3D(q));
+		}
+	}
+	//=================================================================================================//
 	void Kernel::reduceOnce()
 	{
 		factor_W_3D_ = factor_W_2D_;
@@ -84,6 +84,8 @@ namespace SPH
 		/**< non-dimensional size of the kernel, generally 2.0 **/
 		virtual Real KernelSize() const { return 2.0; };
 		Real CutOffRadius() const { return cutoff_radius_ref_; };
+		/** squared cut off radius for candidate tests without square root */
+		Real CutOffRadiusSqr() const { return cutoff_radius_ref_ * cutoff_radius_ref_; };
 		Real FactorW1D() const { return factor_W_1D_; };
 		Real FactorW2D() const { return factor_W_2D_; };
 		Real FactorW3D() const { return factor_W_3D_; };
@@ -135,6 +137,20 @@ namespace SPH
 		virtual Real d2W_2D(const Real q) const = 0;
 		virtual Real d2W_3D(const Real q) const = 0;
 
+		//----------------------------------------------------------------------
+		//		Below is the batch evaluation interface working on contiguous
+		//		arrays of particle distances in the build dimension.
+		//		The base implementation amortizes the virtual dispatch of the
+		//		reduced kernel function over the batch. Kernels with simple
+		//		polynomial forms override it with a branch-free loop which
+		//		the compiler can auto-vectorize.
+		//----------------------------------------------------------------------
+	public:
+		/** Evaluates the kernel values for a batch of particle distances. */
+		virtual void W_batch(size_t batch_size, const Real *r_ij, Real *W) const;
+		/** Evaluates the kernel derivatives for a batch of particle distances. */
+		virtual void dW_batch(size_t batch_size, const Real *r_ij, Real *dW) const;
+
 	 //----------------------------------------------------------------------
 	 //		Below are for variable smoothing length.
 	 //		Note that we input the ratio between the reference smoothing length
@@ -159,6 +175,7 @@ namespace SPH
 
 	public:
 		Real CutOffRadius(Real h_ratio) const { return cutoff_radius_ref_ / h_ratio; };
+		Real CutOffRadiusSqr(Real h_ratio) const { return cutoff_radius_ref_ * cutoff_radius_ref_ / (h_ratio * h_ratio); };
 
 		Real W(const Real& h_ratio, const Real& r_ij, const Real& displacement) const;
 		Real W(const Real& h_ratio, const Real& r_ij, const Vec2d& displacement) const;
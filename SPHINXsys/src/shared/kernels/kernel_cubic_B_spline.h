@@ -42,7 +42,7 @@ namespace SPH
 	 * @class Kernel Cubic B_Spline
 	 * @brief Kernel Cubic B_Spline
 	 */
-	class KernelCubicBSpline : public Kernel
+	class KernelCubicBSpline final : public Kernel
 	{
 	public:
 		explicit KernelCubicBSpline(Real h);
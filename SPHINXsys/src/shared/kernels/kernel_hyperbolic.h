@@ -44,7 +44,7 @@ namespace SPH
 	 * @class KernelHyperbolic
 	 * @brief Kernel from Yang el al.
 	 */
-	class KernelHyperbolic : public Kernel
+	class KernelHyperbolic final : public Kernel
 	{
 	public:
 		KernelHyperbolic(Real h);
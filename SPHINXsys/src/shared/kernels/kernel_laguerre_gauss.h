@@ -42,7 +42,7 @@ namespace SPH
 	 * @class Kernel Laguerre Gauss
 	 * @brief Kernel Laguerre Gauss
 	 */
-	class KernelLaguerreGauss : public Kernel
+	class KernelLaguerreGauss final : public Kernel
 	{
 	public:
 		KernelLaguerreGauss(Real h);
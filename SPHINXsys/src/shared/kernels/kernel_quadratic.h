@@ -44,7 +44,7 @@ namespace SPH
 	 * @class KernelQuadratic
 	 * @brief Kernel from Yang el al.
 	 */
-	class KernelQuadratic : public Kernel
+	class KernelQuadratic final : public Kernel
 	{
 	public:
 		KernelQuadratic(Real h);
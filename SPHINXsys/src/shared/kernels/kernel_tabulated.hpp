@@ -15,7 +15,7 @@
 namespace SPH
 {
 	template <class KernelType>
-	class KernelTabulated : public Kernel
+	class KernelTabulated final : public Kernel
 	{
 	protected:
 		KernelType original_kernel_;
@@ -141,5 +141,86 @@ namespace SPH
 		return InterpolationCubic(d2w_3d, q);
 	}
 	//=================================================================================================//
+
+	/**
+	 * @class KernelTabulatedRuntime
+	 * @brief Tabulated counterpart of an already constructed kernel, so that
+	 * any kernel a body uses can be tabulated without knowing its type at
+	 * compile time. The kernel value and its first derivative are stored
+	 * interleaved in cache-aligned padded tables, so that the value and
+	 * gradient lookups of one particle pair share their cache lines.
+	 * The rarely used second derivatives delegate to the original kernel.
+	 */
+	class KernelTabulatedRuntime final : public Kernel
+	{
+	protected:
+		Kernel &original_kernel_;
+		int kernel_resolution_;
+		Real dq_, delta_q_0_, delta_q_1_, delta_q_2_, delta_q_3_;
+		/** entry 2*i holds W and entry 2*i+1 holds dW of sample point i */
+		StdLargeVec<Real> w_dw_1d_, w_dw_2d_, w_dw_3d_;
+
+		/** interpolation function, Four-point Lagrangian interpolation
+		 * on the interleaved tables. */
+		Real InterpolationCubic(const StdLargeVec<Real> &data, Real q, int offset) const
+		{
+			int location = (int)floor(q / dq_);
+			int i = location + 1;
+			Real fraction_1 = q - Real(location) * dq_; // fraction_1 correspond to i
+			Real fraction_0 = fraction_1 + dq_;			// fraction_0 correspond to i-1
+			Real fraction_2 = fraction_1 - dq_;			// fraction_2 correspond to i+1
+			Real fraction_3 = fraction_1 - 2 * dq_;		// fraction_3 correspond to i+2
+
+			return ((fraction_1 * fraction_2 * fraction_3) / delta_q_0_ * data[2 * (i - 1) + offset] +
+					(fraction_0 * fraction_2 * fraction_3) / delta_q_1_ * data[2 * i + offset] +
+					(fraction_0 * fraction_1 * fraction_3) / delta_q_2_ * data[2 * (i + 1) + offset] +
+					(fraction_0 * fraction_1 * fraction_2) / delta_q_3_ * data[2 * (i + 2) + offset]);
+		};
+
+	public:
+		explicit KernelTabulatedRuntime(Kernel &original_kernel, int kernel_resolution)
+			: Kernel(original_kernel.SmoothingLength(), "KernelTabulatedRuntime"),
+			  original_kernel_(original_kernel), kernel_resolution_(kernel_resolution)
+		{
+			factor_W_1D_ = original_kernel_.FactorW1D();
+			factor_W_2D_ = original_kernel_.FactorW2D();
+			factor_W_3D_ = original_kernel_.FactorW3D();
+
+			dq_ = KernelSize() / Real(kernel_resolution_);
+			for (int i = 0; i < kernel_resolution_ + 4; i++)
+			{
+				Real q = Real(i - 1) * dq_;
+				w_dw_1d_.push_back(original_kernel_.W_1D(q));
+				w_dw_1d_.push_back(original_kernel_.dW_1D(q));
+				w_dw_2d_.push_back(original_kernel_.W_2D(q));
+				w_dw_2d_.push_back(original_kernel_.dW_2D(q));
+				w_dw_3d_.push_back(original_kernel_.W_3D(q));
+				w_dw_3d_.push_back(original_kernel_.dW_3D(q));
+			}
+
+			delta_q_0_ = (-1.0 * dq_) * (-2.0 * dq_) * (-3.0 * dq_);
+			delta_q_1_ = dq_ * (-1.0 * dq_) * (-2.0 * dq_);
+			delta_q_2_ = (2.0 * dq_) * dq_ * (-1.0 * dq_);
+			delta_q_3_ = (3.0 * dq_) * (2.0 * dq_) * dq_;
+
+			setDerivativeParameters();
+		};
+		virtual ~KernelTabulatedRuntime(){};
+
+		virtual Real KernelSize() const override { return original_kernel_.KernelSize(); };
+
+		virtual Real W_1D(const Real q) const override { return InterpolationCubic(w_dw_1d_, q, 0); };
+		virtual Real W_2D(const Real q) const override { return InterpolationCubic(w_dw_2d_, q, 0); };
+		virtual Real W_3D(const Real q) const override { return InterpolationCubic(w_dw_3d_, q, 0); };
+
+		virtual Real dW_1D(const Real q) const override { return InterpolationCubic(w_dw_1d_, q, 1); };
+		virtual Real dW_2D(const Real q) const override { return InterpolationCubic(w_dw_2d_, q, 1); };
+		virtual Real dW_3D(const Real q) const override { return InterpolationCubic(w_dw_3d_, q, 1); };
+
+		virtual Real d2W_1D(const Real q) const override { return original_kernel_.d2W_1D(q); };
+		virtual Real d2W_2D(const Real q) const override { return original_kernel_.d2W_2D(q); };
+		virtual Real d2W_3D(const Real q) const override { return original_kernel_.d2W_3D(q); };
+	};
+	//=================================================================================================//
 }
 #endif // KERNEL_TABULATED_HPP
\ No newline at end of file
@@ -48,6 +48,29 @@ namespace SPH
 		return dW_2D(q);
 	}
 	//=================================================================================================//
+	void KernelWendlandC2::W_batch(size_t batch_size, const Real *r_ij, Real *W) const
+	{
+		Real factor_W = Dimensions == 2 ? factor_W_2D_ : factor_W_3D_;
+		for (size_t n = 0; n != batch_size; ++n)
+		{
+			Real q = r_ij[n] * inv_h_;
+			Real s = 1.0 - 0.5 * q;
+			Real s2 = s * s;
+			W[n] = factor_W * s2 * s2 * (1.0 + 2.0 * q);
+		}
+	}
+	//=================================================================================================//
+	void KernelWendlandC2::dW_batch(size_t batch_size, const Real *r_ij, Real *dW) const
+	{
+		Real factor_dW = Dimensions == 2 ? factor_dW_2D_ : factor_dW_3D_;
+		for (size_t n = 0; n != batch_size; ++n)
+		{
+			Real q = r_ij[n] * inv_h_;
+			Real s = q - 2.0;
+			dW[n] = factor_dW * 0.625 * s * s * s * q;
+		}
+	}
+	//=================================================================================================//
 	Real KernelWendlandC2::d2W_1D(const Real q) const
 	{
 		return 1.25 * powerN(q - 2.0, 2) * (2.0 * q - 1.0);
@@ -42,7 +42,7 @@ namespace SPH
 	 * @class KernelWendlandC2
 	 * @brief Kernel WendlandC2
 	 */
-	class KernelWendlandC2 : public Kernel
+	class KernelWendlandC2 final : public Kernel
 	{
 	public:
 		explicit KernelWendlandC2(Real h);
@@ -60,6 +60,10 @@ namespace SPH
 		virtual Real d2W_1D(const Real q) const override;
 		virtual Real d2W_2D(const Real q) const override;
 		virtual Real d2W_3D(const Real q) const override;
+
+		/** branch-free batch evaluation which the compiler can auto-vectorize */
+		virtual void W_batch(size_t batch_size, const Real *r_ij, Real *W) const override;
+		virtual void dW_batch(size_t batch_size, const Real *r_ij, Real *dW) const override;
 	};
 }
 #endif //KERNEL_WENLAND_C2_H
\ No newline at end of file
@@ -15,6 +15,11 @@ namespace SPH
 		base_particles_ = base_particles;
 	}
 	//=================================================================================================//
+	void BaseMaterial::registerLocalParametersAsSortable()
+	{
+		base_particles_->registerSortableVariables(reload_local_parameters_);
+	}
+	//=================================================================================================//
 	void BaseMaterial::writeToXmlForReloadLocalParameters(const std::string &filefullpath)
 	{
 		std::cout << "\n Material properties writing. " << std::endl;
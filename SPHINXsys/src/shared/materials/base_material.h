@@ -59,6 +59,11 @@ namespace SPH
 		XmlEngine reload_material_xml_engine_;
 		ParticleVariableList reload_local_parameters_;
 
+		/** register all listed local parameters as sortable, so that particle
+		 * sorting keeps their access aligned with the particle memory order in
+		 * the interaction loops. Called after the local registration. */
+		void registerLocalParametersAsSortable();
+
 	public:
 		explicit BaseMaterial(Real rho0)
 			: material_type_name_("BaseMaterial"),
@@ -104,6 +109,9 @@ namespace SPH
 		virtual Real getPressure(Real rho, Real rho_e) { return getPressure(rho); };
 		virtual Real DensityFromPressure(Real p) = 0;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) = 0;
+		/** whether the sound speed is independent of the local state,
+		 * so that solvers may cache it once instead of querying per pair */
+		virtual bool isSoundSpeedConstant() { return false; };
 		virtual Fluid *ThisObjectPtr() override { return this; };
 	};
 
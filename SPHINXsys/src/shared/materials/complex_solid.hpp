@@ -27,6 +27,8 @@ namespace SPH
 	{
 		this->base_particles_
 			->template registerAVariable(active_contraction_stress_, "ActiveContractionStress");
+		this->base_particles_
+			->template registerASortableVariable<Real>("ActiveContractionStress");
 	}
 	//=============================================================================================//
 	template <class MuscleType>
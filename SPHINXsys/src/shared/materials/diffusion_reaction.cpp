@@ -29,6 +29,7 @@ namespace SPH
 	{
 		base_particles_->registerAVariable(local_bias_direction_, "Fiber");
 		base_particles_->addAVariableNameToList<Vecd>(reload_local_parameters_, "Fiber");
+		registerLocalParametersAsSortable();
 	}
 	//=================================================================================================//
 	void LocalDirectionalDiffusion::readFromXmlForLocalParameters(const std::string &filefullpath)
@@ -295,6 +295,7 @@ namespace SPH
 		base_particles_->registerAVariable(local_s0_, "Sheet");
 		base_particles_->addAVariableNameToList<Vecd>(reload_local_parameters_, "Fiber");
 		base_particles_->addAVariableNameToList<Vecd>(reload_local_parameters_, "Sheet");
+		registerLocalParametersAsSortable();
 	}
 	//=================================================================================================//
 	void LocallyOrthotropicMuscle::readFromXmlForLocalParameters(const std::string &filefullpath)
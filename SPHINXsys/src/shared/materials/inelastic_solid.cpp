@@ -16,6 +16,8 @@ namespace SPH
 		base_particles_->registerAVariable(hardening_parameter_, "HardeningParameter");
 		base_particles_->addAVariableToRestart<Matd>("InversePlasticRightCauchyStrain");
 		base_particles_->addAVariableToRestart<Real>("HardeningParameter");
+		base_particles_->registerASortableVariable<Matd>("InversePlasticRightCauchyStrain");
+		base_particles_->registerASortableVariable<Real>("HardeningParameter");
 	}
 	//=================================================================================================//
 	void HardeningPlasticSolid::assignBaseParticles(BaseParticles *base_particles)
@@ -49,4 +51,28 @@ namespace SPH
 		return (deviatoric_PK + VolumetricKirchhoff(SimTK::det(F)) * Matd(1.0)) * inverse_F_T;
 	}
 	//=================================================================================================//
+	Matd BranchlessHardeningPlasticSolid::PlasticConstitutiveRelation(const Matd &F, size_t index_i, Real dt)
+	{
+		Matd be = F * inverse_plastic_strain_[index_i] * (~F);
+		Matd normalized_be = be * pow(SimTK::det(be), -one_over_dimensions_);
+		Real normalized_be_isentropic = normalized_be.trace() * one_over_dimensions_;
+		Matd deviatoric_PK = DeviatoricKirchhoff(normalized_be - normalized_be_isentropic * Matd(1.0));
+		Real deviatoric_PK_norm = deviatoric_PK.norm();
+		Real trial_function = deviatoric_PK_norm -
+							  sqrt_2_over_3_ * (hardening_modulus_ * hardening_parameter_[index_i] + yield_stress_);
+		// the relaxation increment is clamped at zero instead of branching on yield,
+		// so that un-yielded particles recover the elastic result on the same path
+		Real renormalized_shear_modulus = normalized_be_isentropic * G0_;
+		Real relax_increment = 0.5 * SMAX(trial_function, Real(0)) / (renormalized_shear_modulus + hardening_modulus_ / 3.0);
+		hardening_parameter_[index_i] += sqrt_2_over_3_ * relax_increment;
+		deviatoric_PK -= 2.0 * renormalized_shear_modulus * relax_increment * deviatoric_PK / (deviatoric_PK_norm + TinyReal);
+		Matd relaxed_be = deviatoric_PK / G0_ + normalized_be_isentropic;
+		normalized_be = relaxed_be * pow(SimTK::det(relaxed_be), -one_over_dimensions_);
+		Matd inverse_F = SimTK::inverse(F);
+		Matd inverse_F_T = ~inverse_F;
+		inverse_plastic_strain_[index_i] = inverse_F * normalized_be * inverse_F_T;
+
+		return (deviatoric_PK + VolumetricKirchhoff(SimTK::det(F)) * Matd(1.0)) * inverse_F_T;
+	}
+	//=================================================================================================//
 }
@@ -93,4 +93,30 @@ namespace SPH
 
 		virtual HardeningPlasticSolid *ThisObjectPtr() override { return this; };
 	};
+
+	/**
+	 * @class BranchlessHardeningPlasticSolid
+	 * @brief The hardening plastic solid with a branchless return mapping.
+	 * Instead of branching on the yield condition, the relaxation increment is
+	 * clamped at zero, so that yielded and un-yielded particles take the same
+	 * arithmetic path and the update vectorizes when inlined into a particle
+	 * loop with the material known at compile time. Preferable when a large
+	 * and unpredictable fraction of the particles yields; for mostly elastic
+	 * loading the branching HardeningPlasticSolid does less work per particle.
+	 */
+	class BranchlessHardeningPlasticSolid : public HardeningPlasticSolid
+	{
+	public:
+		explicit BranchlessHardeningPlasticSolid(Real rho0, Real youngs_modulus, Real poisson_ratio, Real yield_stress, Real hardening_modulus)
+			: HardeningPlasticSolid(rho0, youngs_modulus, poisson_ratio, yield_stress, hardening_modulus)
+		{
+			material_type_name_ = "BranchlessHardeningPlasticSolid";
+		};
+		virtual ~BranchlessHardeningPlasticSolid(){};
+
+		/** compute the stress through defoemation, and plastic relaxation. */
+		virtual Matd PlasticConstitutiveRelation(const Matd &deformation, size_t index_i, Real dt = 0.0) override;
+
+		virtual BranchlessHardeningPlasticSolid *ThisObjectPtr() override { return this; };
+	};
 }
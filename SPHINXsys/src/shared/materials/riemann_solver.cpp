@@ -11,71 +11,6 @@
 
 namespace SPH
 {
-	//=================================================================================================//
-	Real NoRiemannSolver::
-		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		return (state_i.p_ * state_j.rho_ + state_j.p_ * state_i.rho_) / (state_i.rho_ + state_j.rho_);
-	}
-	//=================================================================================================//
-	Vecd NoRiemannSolver::
-		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_);
-	}
-	//=================================================================================================//
-	void BaseAcousticRiemannSolver::
-		prepareSolver(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij,
-					  Real &ul, Real &ur, Real &rhol_cl, Real &rhor_cr)
-	{
-		ul = dot(-e_ij, state_i.vel_);
-		ur = dot(-e_ij, state_j.vel_);
-		rhol_cl = fluid_i_.getSoundSpeed(state_i.p_, state_i.rho_) * state_i.rho_;
-		rhor_cr = fluid_j_.getSoundSpeed(state_j.p_, state_j.rho_) * state_j.rho_;
-	}
-	//=================================================================================================//
-	Real AcousticRiemannSolver::
-		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		Real ul, ur, rhol_cl, rhor_cr;
-		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
-
-		Real clr = (rhol_cl + rhor_cr) / (state_i.rho_ + state_j.rho_);
-		return (rhol_cl * state_j.p_ + rhor_cr * state_i.p_ +
-				rhol_cl * rhor_cr * (ul - ur) * SMIN(3.0 * SMAX((ul - ur) / clr, 0.0), 1.0)) /
-			   (rhol_cl + rhor_cr);
-	}
-	//=================================================================================================//
-	Vecd AcousticRiemannSolver::
-		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		Real ul, ur, rhol_cl, rhor_cr;
-		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
-
-		Real u_star = (rhol_cl * ul + rhor_cr * ur + state_i.p_ - state_j.p_) / (rhol_cl + rhor_cr);
-		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_) -
-			   e_ij * (u_star - (ul * state_i.rho_ + ur * state_j.rho_) / (state_i.rho_ + state_j.rho_));
-	}
-	//=================================================================================================//
-	Real DissipativeRiemannSolver::
-		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		Real ul, ur, rhol_cl, rhor_cr;
-		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
-
-		return (rhol_cl * state_j.p_ + rhor_cr * state_i.p_ + rhol_cl * rhor_cr * (ul - ur)) / (rhol_cl + rhor_cr);
-	}
-	//=================================================================================================//
-	Vecd DissipativeRiemannSolver::
-		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
-	{
-		Real ul, ur, rhol_cl, rhor_cr;
-		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
-
-		Real u_star = (rhol_cl * ul + rhor_cr * ur + state_i.p_ - state_j.p_) / (rhol_cl + rhor_cr);
-		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_) -
-			   e_ij * (u_star - (ul * state_i.rho_ + ur * state_j.rho_) / (state_i.rho_ + state_j.rho_));
-	}
 	//=================================================================================================//
 	FluidState HLLCRiemannSolverInWeaklyCompressibleFluid::
 		getInterfaceState(const FluidState& state_i, const FluidState& state_j, const Vecd& e_ij)
@@ -213,6 +148,42 @@ namespace SPH
 		return interface_state;
 	}
 	//=================================================================================================//
+	void HLLCRiemannSolver::getInterfaceStates(CompressibleFluidStateBlock &block)
+	{
+		for (size_t b = 0; b != block.size_; ++b)
+		{
+			Real ul = dot(-block.e_ij_[b], block.vel_l_[b]);
+			Real ur = dot(-block.e_ij_[b], block.vel_r_[b]);
+			Real c_l = compressible_fluid_i_.CompressibleFluid::getSoundSpeed(block.p_l_[b], block.rho_l_[b]);
+			Real c_r = compressible_fluid_j_.CompressibleFluid::getSoundSpeed(block.p_r_[b], block.rho_r_[b]);
+			Real s_l = ul - c_l;
+			Real s_r = ur + c_r;
+			Real s_star = (block.rho_r_[b] * ur * (s_r - ur) + block.rho_l_[b] * ul * (ul - s_l) + block.p_l_[b] - block.p_r_[b]) /
+						  (block.rho_r_[b] * (s_r - ur) + block.rho_l_[b] * (ul - s_l));
+
+			/** the candidates of all wave-speed regions, evaluated unconditionally
+			 * so that the selection below remains free of data-dependent branches. */
+			Real p_middle = block.p_l_[b] + block.rho_l_[b] * (s_l - ul) * (s_star - ul);
+			Vecd v_middle_l = block.vel_l_[b] - block.e_ij_[b] * (s_star - ul);
+			Vecd v_middle_r = block.vel_r_[b] - block.e_ij_[b] * (s_star - ur);
+			Real rho_middle_l = block.rho_l_[b] * (s_l - ul) / (s_l - s_star);
+			Real rho_middle_r = block.rho_r_[b] * (s_r - ur) / (s_r - s_star);
+			Real energy_middle_l = rho_middle_l * (block.E_l_[b] / block.rho_l_[b] + (s_star - ul) * (s_star + block.p_l_[b] / block.rho_l_[b] / (s_l - ul)));
+			Real energy_middle_r = rho_middle_r * (block.E_r_[b] / block.rho_r_[b] + (s_star - ur) * (s_star + block.p_r_[b] / block.rho_r_[b] / (s_r - ur)));
+
+			/** region selection as chains of conditional moves, reproducing the
+			 * last-assignment-wins ordering of the scalar solver above. */
+			bool left = 0.0 < s_l;
+			bool middle_left = s_l <= 0.0 && 0.0 <= s_star;
+			bool middle_right = s_star <= 0.0 && 0.0 <= s_r;
+			bool right = s_r < 0.0;
+			block.p_star_[b] = right ? block.p_r_[b] : middle_right ? p_middle : middle_left ? p_middle : left ? block.p_l_[b] : 0.0;
+			block.vel_star_[b] = right ? block.vel_r_[b] : middle_right ? v_middle_r : middle_left ? v_middle_l : left ? block.vel_l_[b] : Vecd(0);
+			block.rho_star_[b] = right ? block.rho_r_[b] : middle_right ? rho_middle_r : middle_left ? rho_middle_l : left ? block.rho_l_[b] : 0.0;
+			block.E_star_[b] = right ? block.E_r_[b] : middle_right ? energy_middle_r : middle_left ? energy_middle_l : left ? block.E_l_[b] : 0.0;
+		}
+	}
+	//=================================================================================================//
 	CompressibleFluidState HLLCWithLimiterRiemannSolver::
 		getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij)
 	{
@@ -271,4 +242,45 @@ namespace SPH
 		return interface_state;
 	}
 	//=================================================================================================//
+	void HLLCWithLimiterRiemannSolver::getInterfaceStates(CompressibleFluidStateBlock &block)
+	{
+		for (size_t b = 0; b != block.size_; ++b)
+		{
+			Real ul = dot(-block.e_ij_[b], block.vel_l_[b]);
+			Real ur = dot(-block.e_ij_[b], block.vel_r_[b]);
+			Real c_l = compressible_fluid_i_.CompressibleFluid::getSoundSpeed(block.p_l_[b], block.rho_l_[b]);
+			Real c_r = compressible_fluid_j_.CompressibleFluid::getSoundSpeed(block.p_r_[b], block.rho_r_[b]);
+			Real s_l = ul - c_l;
+			Real s_r = ur + c_r;
+			Real s_star = (block.rho_r_[b] * ur * (s_r - ur) + block.rho_l_[b] * ul * (ul - s_l) + block.p_l_[b] - block.p_r_[b]) /
+						  (block.rho_r_[b] * (s_r - ur) + block.rho_l_[b] * (ul - s_l));
+
+			/** the candidates of all wave-speed regions, evaluated unconditionally
+			 * so that the selection below remains free of data-dependent branches.
+			 * The limiter itself is pure min/max arithmetic already. */
+			Real rho_ave = 2 * block.rho_l_[b] * block.rho_r_[b] / (block.rho_l_[b] + block.rho_r_[b]);
+			Real rho_cl = block.rho_l_[b] * c_l;
+			Real rho_cr = block.rho_r_[b] * c_r;
+			Real rho_clr = (rho_cl * block.rho_l_[b] + rho_cr * block.rho_r_[b]) / (block.rho_l_[b] + block.rho_r_[b]);
+			Real p_middle = 0.5 * (block.p_l_[b] + block.p_r_[b]) + 0.5 * (SMIN(3.0 * SMAX(rho_ave * (ul - ur), 0.0), rho_clr) * (ul - ur) + s_star * (rho_cr - rho_cl));
+			Vecd v_middle_l = block.vel_l_[b] - block.e_ij_[b] * (s_star - ul);
+			Vecd v_middle_r = block.vel_r_[b] - block.e_ij_[b] * (s_star - ur);
+			Real rho_middle_l = block.rho_l_[b] * (s_l - ul) / (s_l - s_star);
+			Real rho_middle_r = block.rho_r_[b] * (s_r - ur) / (s_r - s_star);
+			Real energy_middle_l = rho_middle_l * (block.E_l_[b] / block.rho_l_[b] + (s_star - ul) * (s_star + block.p_l_[b] / block.rho_l_[b] / (s_l - ul)));
+			Real energy_middle_r = rho_middle_r * (block.E_r_[b] / block.rho_r_[b] + (s_star - ur) * (s_star + block.p_r_[b] / block.rho_r_[b] / (s_r - ur)));
+
+			/** region selection as chains of conditional moves, reproducing the
+			 * last-assignment-wins ordering of the scalar solver above. */
+			bool left = 0.0 < s_l;
+			bool middle_left = s_l <= 0.0 && 0.0 <= s_star;
+			bool middle_right = s_star <= 0.0 && 0.0 <= s_r;
+			bool right = s_r < 0.0;
+			block.p_star_[b] = right ? block.p_r_[b] : middle_right ? p_middle : middle_left ? p_middle : left ? block.p_l_[b] : 0.0;
+			block.vel_star_[b] = right ? block.vel_r_[b] : middle_right ? v_middle_r : middle_left ? v_middle_l : left ? block.vel_l_[b] : Vecd(0);
+			block.rho_star_[b] = right ? block.rho_r_[b] : middle_right ? rho_middle_r : middle_left ? rho_middle_l : left ? block.rho_l_[b] : 0.0;
+			block.E_star_[b] = right ? block.E_r_[b] : middle_right ? energy_middle_r : middle_left ? energy_middle_l : left ? block.E_l_[b] : 0.0;
+		}
+	}
+	//=================================================================================================//
 }
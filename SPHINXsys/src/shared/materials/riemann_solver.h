@@ -30,6 +30,7 @@
 #define RIEMANN_SOLVER_H
 
 #include "base_data_package.h"
+#include "base_material.h"
 
 namespace SPH
 {
@@ -48,26 +49,63 @@ namespace SPH
 			: FluidState(rho, vel, p), E_(E){};
 	};
 
+	/**
+	 * @struct CompressibleFluidStateBlock
+	 * @brief Fixed-capacity structure-of-arrays scratch holding the left and right
+	 * states of one block of interacting pairs together with the resolved interface
+	 * states. Interaction loops gather neighbor states into the block and evaluate
+	 * the fluxes of the whole block in one sweep, so that the flux arithmetic runs
+	 * over contiguous arrays instead of scattered per-pair structures.
+	 */
+	struct CompressibleFluidStateBlock
+	{
+		static constexpr size_t capacity_ = 32;
+		size_t size_; /**< number of pairs gathered into the block */
+
+		Real rho_l_[capacity_], p_l_[capacity_], E_l_[capacity_];
+		Real rho_r_[capacity_], p_r_[capacity_], E_r_[capacity_];
+		Vecd vel_l_[capacity_], vel_r_[capacity_], e_ij_[capacity_];
+
+		Real rho_star_[capacity_], p_star_[capacity_], E_star_[capacity_];
+		Vecd vel_star_[capacity_];
+
+		CompressibleFluidStateBlock() : size_(0){};
+	};
+
 	class Fluid;
 	class CompressibleFluid;
 
+	/**
+	 * The weakly compressible solvers below are defined inline so that they fully
+	 * inline into the pair loops of the relaxation schemes templated on the solver
+	 * type. Their limiters are pure min/max arithmetic, so the resulting loops
+	 * compile without data-dependent branches.
+	 */
 	class NoRiemannSolver
 	{
 		Fluid &fluid_l_, &fluid_r_;
 
 	public:
 		NoRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : fluid_l_(fluid_i), fluid_r_(fluid_j){};
-		Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
-		Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
 	};
 
 	class BaseAcousticRiemannSolver
 	{
 	protected:
 		Fluid &fluid_i_, &fluid_j_;
+		/** sound speeds resolved once at construction when both equations of
+		 * state report them constant, e.g. for weakly compressible phase pairs,
+		 * so the pair loops read plain scalars instead of virtual getters */
+		bool constant_sound_speeds_;
+		Real c_i_, c_j_;
 
 	public:
-		BaseAcousticRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : fluid_i_(fluid_i), fluid_j_(fluid_j){};
+		BaseAcousticRiemannSolver(Fluid &fluid_i, Fluid &fluid_j)
+			: fluid_i_(fluid_i), fluid_j_(fluid_j),
+			  constant_sound_speeds_(fluid_i.isSoundSpeedConstant() && fluid_j.isSoundSpeedConstant()),
+			  c_i_(fluid_i.getSoundSpeed()), c_j_(fluid_j.getSoundSpeed()){};
 		inline void prepareSolver(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i,
 								  Real &ul, Real &ur, Real &rhol_cl, Real &rhor_cr);
 	};
@@ -75,17 +113,93 @@ namespace SPH
 	{
 	public:
 		AcousticRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : BaseAcousticRiemannSolver(fluid_i, fluid_j){};
-		Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
-		Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
 	};
 
 	class DissipativeRiemannSolver : public BaseAcousticRiemannSolver
 	{
 	public:
 		DissipativeRiemannSolver(Fluid &fluid_i, Fluid &fluid_j) : BaseAcousticRiemannSolver(fluid_i, fluid_j){};
-		Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
-		Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Real getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
+		inline Vecd getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &direction_to_i);
 	};
+	//=================================================================================================//
+	inline Real NoRiemannSolver::
+		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		return (state_i.p_ * state_j.rho_ + state_j.p_ * state_i.rho_) / (state_i.rho_ + state_j.rho_);
+	}
+	//=================================================================================================//
+	inline Vecd NoRiemannSolver::
+		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_);
+	}
+	//=================================================================================================//
+	inline void BaseAcousticRiemannSolver::
+		prepareSolver(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij,
+					  Real &ul, Real &ur, Real &rhol_cl, Real &rhor_cr)
+	{
+		ul = dot(-e_ij, state_i.vel_);
+		ur = dot(-e_ij, state_j.vel_);
+		/** the uniform flag hoists out of the pair loops after inlining */
+		if (constant_sound_speeds_)
+		{
+			rhol_cl = c_i_ * state_i.rho_;
+			rhor_cr = c_j_ * state_j.rho_;
+		}
+		else
+		{
+			rhol_cl = fluid_i_.getSoundSpeed(state_i.p_, state_i.rho_) * state_i.rho_;
+			rhor_cr = fluid_j_.getSoundSpeed(state_j.p_, state_j.rho_) * state_j.rho_;
+		}
+	}
+	//=================================================================================================//
+	inline Real AcousticRiemannSolver::
+		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		Real ul, ur, rhol_cl, rhor_cr;
+		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
+
+		/** the limiter as branch-free min/max arithmetic. */
+		Real clr = (rhol_cl + rhor_cr) / (state_i.rho_ + state_j.rho_);
+		return (rhol_cl * state_j.p_ + rhor_cr * state_i.p_ +
+				rhol_cl * rhor_cr * (ul - ur) * SMIN(3.0 * SMAX((ul - ur) / clr, 0.0), 1.0)) /
+			   (rhol_cl + rhor_cr);
+	}
+	//=================================================================================================//
+	inline Vecd AcousticRiemannSolver::
+		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		Real ul, ur, rhol_cl, rhor_cr;
+		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
+
+		Real u_star = (rhol_cl * ul + rhor_cr * ur + state_i.p_ - state_j.p_) / (rhol_cl + rhor_cr);
+		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_) -
+			   e_ij * (u_star - (ul * state_i.rho_ + ur * state_j.rho_) / (state_i.rho_ + state_j.rho_));
+	}
+	//=================================================================================================//
+	inline Real DissipativeRiemannSolver::
+		getPStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		Real ul, ur, rhol_cl, rhor_cr;
+		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
+
+		return (rhol_cl * state_j.p_ + rhor_cr * state_i.p_ + rhol_cl * rhor_cr * (ul - ur)) / (rhol_cl + rhor_cr);
+	}
+	//=================================================================================================//
+	inline Vecd DissipativeRiemannSolver::
+		getVStar(const FluidState &state_i, const FluidState &state_j, const Vecd &e_ij)
+	{
+		Real ul, ur, rhol_cl, rhor_cr;
+		prepareSolver(state_i, state_j, e_ij, ul, ur, rhol_cl, rhor_cr);
+
+		Real u_star = (rhol_cl * ul + rhor_cr * ur + state_i.p_ - state_j.p_) / (rhol_cl + rhor_cr);
+		return (state_i.vel_ * state_i.rho_ + state_j.vel_ * state_j.rho_) / (state_i.rho_ + state_j.rho_) -
+			   e_ij * (u_star - (ul * state_i.rho_ + ur * state_j.rho_) / (state_i.rho_ + state_j.rho_));
+	}
+	//=================================================================================================//
 
 	class HLLCRiemannSolverInWeaklyCompressibleFluid
 	{
@@ -115,6 +229,10 @@ namespace SPH
 		HLLCRiemannSolver(CompressibleFluid &compressible_fluid_i, CompressibleFluid &compressible_fluid_j)
 			: compressible_fluid_i_(compressible_fluid_i), compressible_fluid_j_(compressible_fluid_j){};
 		CompressibleFluidState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &direction_to_i);
+		/** resolve the interface states of a whole pair block in one sweep,
+		 * with the wave-speed regions selected arithmetically instead of branching
+		 * and the ideal-gas sound speed bound statically. */
+		void getInterfaceStates(CompressibleFluidStateBlock &block);
 	};
 
 	class HLLCWithLimiterRiemannSolver
@@ -125,6 +243,8 @@ namespace SPH
 		HLLCWithLimiterRiemannSolver(CompressibleFluid &compressible_fluid_i, CompressibleFluid &compressible_fluid_j)
 			: compressible_fluid_i_(compressible_fluid_i), compressible_fluid_j_(compressible_fluid_j){};
 		CompressibleFluidState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &direction_to_i);
+		/** blocked counterpart of getInterfaceState, see HLLCRiemannSolver. */
+		void getInterfaceStates(CompressibleFluidStateBlock &block);
 	};
 }
 
@@ -55,6 +55,7 @@ namespace SPH
 		virtual Real getPressure(Real rho) override;
 		virtual Real DensityFromPressure(Real p) override;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) override;
+		virtual bool isSoundSpeedConstant() override { return true; };
 		virtual WeaklyCompressibleFluid *ThisObjectPtr() override { return this; };
 	};
 
@@ -104,6 +105,7 @@ namespace SPH
 		virtual Real getPressure(Real rho) override;
 		virtual Real DensityFromPressure(Real p) override;
 		virtual Real getSoundSpeed(Real p = 0.0, Real rho = 1.0) override;
+		virtual bool isSoundSpeedConstant() override { return false; };
 	};
 
 	/**
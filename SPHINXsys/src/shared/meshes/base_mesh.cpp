@@ -74,6 +74,30 @@ namespace SPH
 		return x;
 	}
 	//=================================================================================================//
+	void BaseMesh::transferMeshIndexesToMortonRanks(const Vecu &number_of_mesh_indexes,
+													StdLargeVec<size_t> &morton_ranks,
+													StdLargeVec<size_t> &rank_to_mesh_index)
+	{
+		size_t total_number_of_indexes =
+			transferMeshIndexTo1D(number_of_mesh_indexes, number_of_mesh_indexes - Vecu(1)) + 1;
+
+		StdLargeVec<size_t> morton_codes(total_number_of_indexes);
+		rank_to_mesh_index.resize(total_number_of_indexes);
+		for (size_t i = 0; i != total_number_of_indexes; ++i)
+		{
+			morton_codes[i] =
+				transferMeshIndexToMortonOrder(transfer1DtoMeshIndex(number_of_mesh_indexes, i));
+			rank_to_mesh_index[i] = i;
+		}
+		std::sort(rank_to_mesh_index.begin(), rank_to_mesh_index.end(),
+				  [&](size_t a, size_t b)
+				  { return morton_codes[a] < morton_codes[b]; });
+
+		morton_ranks.resize(total_number_of_indexes);
+		for (size_t rank = 0; rank != total_number_of_indexes; ++rank)
+			morton_ranks[rank_to_mesh_index[rank]] = rank;
+	}
+	//=================================================================================================//
 	Mesh::Mesh(BoundingBox tentative_bounds, Real grid_spacing, size_t buffer_width)
 		: BaseMesh(tentative_bounds, grid_spacing, buffer_width),
 		  buffer_width_(buffer_width),
@@ -94,6 +94,12 @@ namespace SPH
 		size_t MortonCode(const size_t &i);
 		/** This function converts mesh index into a Morton order. */
 		size_t transferMeshIndexToMortonOrder(const Vecu &mesh_index);
+		/** This function fills, for every linear mesh index in lexicographic
+		 * storage order, its dense rank along the Morton order, together with
+		 * the inverse permutation mapping each rank back to the linear index. */
+		void transferMeshIndexesToMortonRanks(const Vecu &number_of_mesh_indexes,
+											  StdLargeVec<size_t> &morton_ranks,
+											  StdLargeVec<size_t> &rank_to_mesh_index);
 	};
 
 	/**
@@ -137,6 +143,8 @@ namespace SPH
 		std::string Name() { return name_; };
 		/** output mesh data for Tecplot visualization */
 		virtual void writeMeshFieldToPlt(std::ofstream &output_file) = 0;
+		/** allocated bytes of the mesh field storage, for memory accounting. */
+		virtual size_t MemoryFootprint() { return 0; };
 	};
 
 	/**
@@ -205,6 +213,16 @@ namespace SPH
 				mesh_levels_[l]->writeMeshFieldToPlt(output_file);
 			}
 		}
+
+		virtual size_t MemoryFootprint() override
+		{
+			size_t footprint_in_bytes = 0;
+			for (size_t l = 0; l != total_levels_; ++l)
+			{
+				footprint_in_bytes += mesh_levels_[l]->MemoryFootprint();
+			}
+			return footprint_in_bytes;
+		}
 	};
 }
 #endif //BASE_MESH_H
\ No newline at end of file
@@ -17,7 +17,9 @@ namespace SPH
 		BaseCellLinkedList(SPHBody &sph_body, SPHAdaptation &sph_adaptation)
 		: BaseMeshField("CellLinkedList"),
 		  sph_body_(sph_body), kernel_(*sph_adaptation.getKernel()), 
-		  base_particles_(nullptr) {}
+		  base_particles_(nullptr), update_version_(0) {}
+	//=================================================================================================//
+	bool SplitCellGraphExecution::graph_execution_enabled_ = false;
 	//=================================================================================================//
 	void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 	{
@@ -27,28 +29,536 @@ namespace SPH
 	//=================================================================================================//
 	CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
 								   SPHBody &sph_body, SPHAdaptation &sph_adaptation)
-		: BaseCellLinkedList(sph_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2)
+		: BaseCellLinkedList(sph_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+		  use_incremental_update_(false), use_counting_sort_insertion_(false),
+		  sorted_order_hint_(false), use_morton_cell_ordering_(false),
+		  use_sparse_cell_storage_(false)
 	{
 		allocateMeshDataMatrix();
 	}
 	//=================================================================================================//
 	void CellLinkedList::UpdateCellLists()
 	{
-		clearCellLists();
+		update_version_++;
+		// the flat split ranges are only valid for a fresh counting-sort
+		// rebuild, which refills them below
+		sph_body_.split_cell_index_ranges_.clear();
+		size_t total_real_particles = base_particles_->total_real_particles_;
+
+		// the one position-to-cell transform per particle of this update,
+		// which all the rebuild strategies below consume
+		updateParticleLinearCellIndexes();
+
+		// the incremental update moves particles within the dense matrix,
+		// while the sparse hash is reassigned at every rebuild
+		if (use_incremental_update_ && !use_sparse_cell_storage_ &&
+			particle_cell_residency_.size() == total_real_particles &&
+			updateCellListsIncrementally())
+		{
+			UpdateCellListData();
+			return;
+		}
+
+		// right after a cell-key sort the cell contents are implicit in the
+		// particle order, from which one scan derives the cell ranges
+		bool derived_from_sorted_order = false;
+		if (sorted_order_hint_)
+		{
+			sorted_order_hint_ = false;
+			derived_from_sorted_order = updateCellListsFromSortedOrder();
+		}
+
+		if (!derived_from_sorted_order)
+		{
+			if (!use_sparse_cell_storage_)
+				clearCellLists();
+			if (use_counting_sort_insertion_)
+			{
+				updateCellListsByCountingSort();
+			}
+			else
+			{
+				parallel_for(
+					blocked_range<size_t>(0, total_real_particles),
+					[&](const blocked_range<size_t> &r)
+					{
+						for (size_t i = r.begin(); i != r.end(); ++i)
+						{
+							CellList &cell_list = CellListFromCellIndex(
+								transfer1DtoMeshIndex(number_of_cells_, particle_linear_cell_indexes_[i]));
+							cell_list.concurrent_particle_indexes_.emplace_back(i);
+						}
+					},
+					ap);
+			}
+		}
+		if (use_incremental_update_)
+			recordCellResidency();
+		if (use_sparse_cell_storage_)
+		{
+			updateSparseCellListData();
+			updateSparseSplitCellLists(sph_body_.split_cell_lists_);
+		}
+		else
+		{
+			UpdateCellListData();
+			updateSplitCellLists(sph_body_.split_cell_lists_);
+		}
+	}
+	//=================================================================================================//
+	void CellLinkedList::updateParticleLinearCellIndexes()
+	{
 		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
 		size_t total_real_particles = base_particles_->total_real_particles_;
+		particle_linear_cell_indexes_.resize(total_real_particles);
 		parallel_for(
 			blocked_range<size_t>(0, total_real_particles),
 			[&](const blocked_range<size_t> &r)
 			{
 				for (size_t i = r.begin(); i != r.end(); ++i)
 				{
-					insertACellLinkedParticleIndex(i, pos_n[i]);
+					particle_linear_cell_indexes_[i] =
+						transferMeshIndexTo1D(number_of_cells_, CellIndexFromPosition(pos_n[i]));
 				}
 			},
 			ap);
-		UpdateCellListData();
-		updateSplitCellLists(sph_body_.split_cell_lists_);
+	}
+	//=================================================================================================//
+	void CellLinkedList::updateCellListsByCountingSort()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		size_t total_number_of_cells =
+			transferMeshIndexTo1D(number_of_cells_, number_of_cells_ - Vecu(1)) + 1;
+
+		particle_cell_keys_.resize(total_real_particles);
+		cell_contiguous_indexes_.resize(total_real_particles);
+
+		if (use_morton_cell_ordering_ && morton_cell_ranks_.empty())
+			transferMeshIndexesToMortonRanks(number_of_cells_, morton_cell_ranks_, morton_rank_to_cell_);
+
+		// first pass: count the particles landing in each cell
+		StdVec<std::atomic<size_t>> cell_entries(total_number_of_cells);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t linear_cell_index = particle_linear_cell_indexes_[i];
+					particle_cell_keys_[i] = use_morton_cell_ordering_
+												 ? morton_cell_ranks_[linear_cell_index]
+												 : linear_cell_index;
+					cell_entries[particle_cell_keys_[i]].fetch_add(1, std::memory_order_relaxed);
+				}
+			},
+			ap);
+
+		// exclusive prefix sum turning the counts into the first entry of each cell
+		StdLargeVec<size_t> cell_offsets(total_number_of_cells);
+		size_t running_offset = 0;
+		for (size_t n = 0; n != total_number_of_cells; ++n)
+		{
+			cell_offsets[n] = running_offset;
+			running_offset += cell_entries[n].load(std::memory_order_relaxed);
+			cell_entries[n].store(cell_offsets[n], std::memory_order_relaxed);
+		}
+
+		// with the sparse storage the occupied cells are known from the counts,
+		// so the hash is rebuilt serially before the parallel fill below
+		if (use_sparse_cell_storage_)
+		{
+			occupied_cell_indexes_.clear();
+			for (size_t n = 0; n != total_number_of_cells; ++n)
+			{
+				size_t first_entry = cell_offsets[n];
+				size_t last_entry =
+					n + 1 != total_number_of_cells ? cell_offsets[n + 1] : total_real_particles;
+				if (first_entry != last_entry)
+					occupied_cell_indexes_.push_back(use_morton_cell_ordering_ ? morton_rank_to_cell_[n] : n);
+			}
+			rehashSparseCells();
+		}
+
+		// second pass: lock-free scatter into the flat cell-contiguous array
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t entry =
+						cell_entries[particle_cell_keys_[i]].fetch_add(1, std::memory_order_relaxed);
+					cell_contiguous_indexes_[entry] = i;
+				}
+			},
+			ap);
+
+		// fill each cell list from its contiguous segment, one thread per cell
+		parallel_for(
+			blocked_range<size_t>(0, total_number_of_cells),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t first_entry = cell_offsets[n];
+					size_t last_entry =
+						n + 1 != total_number_of_cells ? cell_offsets[n + 1] : total_real_particles;
+					if (first_entry == last_entry)
+						continue;
+					size_t linear_cell_index = use_morton_cell_ordering_ ? morton_rank_to_cell_[n] : n;
+					CellList &cell_list =
+						CellListFromCellIndex(transfer1DtoMeshIndex(number_of_cells_, linear_cell_index));
+					for (size_t entry = first_entry; entry != last_entry; ++entry)
+						cell_list.concurrent_particle_indexes_.emplace_back(cell_contiguous_indexes_[entry]);
+				}
+			},
+			ap);
+
+		// rebuild the flat split ranges in O(cells): each non-empty cell
+		// contributes its contiguous segment to its mod-3 split level, so that
+		// the splitting sweeps stream the flat index array level by level
+		SplitCellIndexRanges &split_ranges = sph_body_.split_cell_index_ranges_;
+		split_ranges.level_ranges_.clear();
+		split_ranges.level_ranges_.resize(sph_body_.split_cell_lists_.size());
+		for (size_t n = 0; n != total_number_of_cells; ++n)
+		{
+			size_t first_entry = cell_offsets[n];
+			size_t last_entry =
+				n + 1 != total_number_of_cells ? cell_offsets[n + 1] : total_real_particles;
+			if (first_entry == last_entry)
+				continue;
+			size_t linear_cell_index = use_morton_cell_ordering_ ? morton_rank_to_cell_[n] : n;
+			Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, linear_cell_index);
+			Vecu level_index(0);
+			for (int axis = 0; axis != Dimensions; ++axis)
+				level_index[axis] = cell_index[axis] % 3;
+			split_ranges.level_ranges_[transferMeshIndexTo1D(Vecu(3), level_index)]
+				.push_back(IndexRange(first_entry, last_entry));
+		}
+		split_ranges.cell_contiguous_indexes_ = &cell_contiguous_indexes_;
+	}
+	//=================================================================================================//
+	bool CellLinkedList::updateCellListsFromSortedOrder()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		if (total_real_particles == 0)
+			return false;
+
+		// recompute the sort keys from the fresh cell indexes and verify that the
+		// sorted order still holds, which guards against position updates between
+		// the sort and this update
+		particle_cell_keys_.resize(total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					particle_cell_keys_[i] = transferMeshIndexToMortonOrder(
+						transfer1DtoMeshIndex(number_of_cells_, particle_linear_cell_indexes_[i]));
+				}
+			},
+			ap);
+		std::atomic<size_t> disorder_count{0};
+		parallel_for(
+			blocked_range<size_t>(1, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					if (particle_cell_keys_[i - 1] > particle_cell_keys_[i])
+						disorder_count.fetch_add(1, std::memory_order_relaxed);
+				}
+			},
+			ap);
+		if (disorder_count.load(std::memory_order_relaxed) != 0)
+			return false;
+
+		// one scan over the sorted keys gives the contiguous range of each cell
+		IndexVector run_cell_indexes;
+		StdVec<IndexRange> run_ranges;
+		size_t run_begin = 0;
+		for (size_t i = 1; i <= total_real_particles; ++i)
+		{
+			if (i == total_real_particles || particle_cell_keys_[i] != particle_cell_keys_[run_begin])
+			{
+				run_cell_indexes.push_back(particle_linear_cell_indexes_[run_begin]);
+				run_ranges.push_back(IndexRange(run_begin, i));
+				run_begin = i;
+			}
+		}
+
+		// the sorted order is already cell contiguous, so the flat index
+		// array for the splitting sweeps is the identity
+		cell_contiguous_indexes_.resize(total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					cell_contiguous_indexes_[i] = i;
+			},
+			ap);
+
+		if (use_sparse_cell_storage_)
+		{
+			occupied_cell_indexes_.assign(run_cell_indexes.begin(), run_cell_indexes.end());
+			rehashSparseCells();
+		}
+		else
+		{
+			clearCellLists();
+		}
+
+		// fill each cell list from its contiguous range, one thread per occupied cell
+		parallel_for(
+			blocked_range<size_t>(0, run_ranges.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					CellList &cell_list =
+						CellListFromCellIndex(transfer1DtoMeshIndex(number_of_cells_, run_cell_indexes[n]));
+					for (size_t entry = run_ranges[n].first; entry != run_ranges[n].second; ++entry)
+						cell_list.concurrent_particle_indexes_.emplace_back(entry);
+				}
+			},
+			ap);
+
+		// the flat split ranges per mod-3 level, as after a counting-sort rebuild
+		SplitCellIndexRanges &split_ranges = sph_body_.split_cell_index_ranges_;
+		split_ranges.level_ranges_.clear();
+		split_ranges.level_ranges_.resize(sph_body_.split_cell_lists_.size());
+		for (size_t n = 0; n != run_ranges.size(); ++n)
+		{
+			Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, run_cell_indexes[n]);
+			Vecu level_index(0);
+			for (int axis = 0; axis != Dimensions; ++axis)
+				level_index[axis] = cell_index[axis] % 3;
+			split_ranges.level_ranges_[transferMeshIndexTo1D(Vecu(3), level_index)]
+				.push_back(run_ranges[n]);
+		}
+		split_ranges.cell_contiguous_indexes_ = &cell_contiguous_indexes_;
+		return true;
+	}
+	//=================================================================================================//
+	void CellLinkedList::useSparseCellStorage()
+	{
+		use_sparse_cell_storage_ = true;
+		use_counting_sort_insertion_ = true;
+		// the dense cell matrix is released; deleteMeshDataMatrix()
+		// guards against the second call from the destructor
+		deleteMeshDataMatrix();
+	}
+	//=================================================================================================//
+	size_t CellLinkedList::firstSparseSlot(size_t linear_cell_index) const
+	{
+		// Fibonacci hashing spreads the linear cell indexes over the
+		// power-of-two table, whose size is a power of two by construction
+		return (linear_cell_index * 0x9E3779B97F4A7C15ull) & (sparse_cell_keys_.size() - 1);
+	}
+	//=================================================================================================//
+	CellList *CellLinkedList::findSparseCell(size_t linear_cell_index)
+	{
+		if (sparse_cell_keys_.empty())
+			return nullptr;
+		size_t slot = firstSparseSlot(linear_cell_index);
+		while (sparse_cell_keys_[slot] != MaxSize_t)
+		{
+			if (sparse_cell_keys_[slot] == linear_cell_index)
+				return sparse_cell_slots_[slot];
+			slot = (slot + 1) & (sparse_cell_keys_.size() - 1);
+		}
+		return nullptr;
+	}
+	//=================================================================================================//
+	void CellLinkedList::rehashSparseCells()
+	{
+		// size the table to keep it at most half full, so that the
+		// linear probes stay short
+		size_t table_size = 64;
+		while (table_size < 2 * occupied_cell_indexes_.size())
+			table_size *= 2;
+		sparse_cell_keys_.assign(table_size, MaxSize_t);
+		sparse_cell_slots_.assign(table_size, nullptr);
+		for (size_t n = 0; n != occupied_cell_indexes_.size(); ++n)
+		{
+			if (n == sparse_cell_pool_.size())
+				sparse_cell_pool_.push_back(makeUnique<CellList>());
+			CellList *cell_list = sparse_cell_pool_[n].get();
+			cell_list->concurrent_particle_indexes_.clear();
+			cell_list->cell_list_indexes_.clear();
+			cell_list->cell_list_positions_.clear();
+			cell_list->real_particle_indexes_.clear();
+			size_t slot = firstSparseSlot(occupied_cell_indexes_[n]);
+			while (sparse_cell_keys_[slot] != MaxSize_t)
+				slot = (slot + 1) & (table_size - 1);
+			sparse_cell_keys_[slot] = occupied_cell_indexes_[n];
+			sparse_cell_slots_[slot] = cell_list;
+		}
+	}
+	//=================================================================================================//
+	void CellLinkedList::updateSparseCellListData()
+	{
+		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
+		parallel_for(
+			blocked_range<size_t>(0, occupied_cell_indexes_.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					CellList &cell_list = *findSparseCell(occupied_cell_indexes_[n]);
+					for (size_t s = 0; s != cell_list.concurrent_particle_indexes_.size(); ++s)
+					{
+						size_t particle_index = cell_list.concurrent_particle_indexes_[s];
+						cell_list.cell_list_indexes_.emplace_back(particle_index);
+						cell_list.cell_list_positions_.emplace_back(pos_n[particle_index]);
+					}
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void CellLinkedList::updateSparseSplitCellLists(SplitCellLists &split_cell_lists)
+	{
+		clearSplitCellLists(split_cell_lists);
+		size_t number_of_level_offsets = powerN(size_t(3), Dimensions);
+		for (size_t n = 0; n != occupied_cell_indexes_.size(); ++n)
+		{
+			size_t linear_cell_index = occupied_cell_indexes_[n];
+			CellList *cell_list = findSparseCell(linear_cell_index);
+			for (size_t s = 0; s != cell_list->concurrent_particle_indexes_.size(); ++s)
+				cell_list->real_particle_indexes_.push_back(cell_list->concurrent_particle_indexes_[s]);
+
+			Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, linear_cell_index);
+			Vecu level_index(0);
+			for (int axis = 0; axis != Dimensions; ++axis)
+				level_index[axis] = cell_index[axis] % 3;
+			size_t split_level = transferMeshIndexTo1D(Vecu(3), level_index);
+			split_cell_lists[split_level].push_back(cell_list);
+
+			//record the neighbor-level links for the dependency-graph splitting sweep
+			if (SplitCellGraphExecution::Enabled())
+			{
+				cell_list->higher_level_neighbor_cells_.clear();
+				cell_list->lower_level_neighbor_cells_.clear();
+				for (size_t offset = 0; offset != number_of_level_offsets; ++offset)
+				{
+					Vecu offset_index = transfer1DtoMeshIndex(Vecu(3), offset);
+					bool is_center = true;
+					bool is_outside = false;
+					Vecu neighbor_index(0);
+					for (int axis = 0; axis != Dimensions; ++axis)
+					{
+						int coordinate = (int)cell_index[axis] + (int)offset_index[axis] - 1;
+						if (coordinate != (int)cell_index[axis])
+							is_center = false;
+						if (coordinate < 0 || coordinate >= (int)number_of_cells_[axis])
+							is_outside = true;
+						else
+							neighbor_index[axis] = coordinate;
+					}
+					if (is_center || is_outside)
+						continue;
+					CellList *neighbor_cell =
+						findSparseCell(transferMeshIndexTo1D(number_of_cells_, neighbor_index));
+					if (neighbor_cell == nullptr)
+						continue;
+					Vecu neighbor_level_index(0);
+					for (int axis = 0; axis != Dimensions; ++axis)
+						neighbor_level_index[axis] = neighbor_index[axis] % 3;
+					size_t neighbor_level = transferMeshIndexTo1D(Vecu(3), neighbor_level_index);
+					if (neighbor_level > split_level)
+						cell_list->higher_level_neighbor_cells_.push_back(neighbor_cell);
+					if (neighbor_level < split_level)
+						cell_list->lower_level_neighbor_cells_.push_back(neighbor_cell);
+				}
+			}
+		}
+	}
+	//=================================================================================================//
+	void CellLinkedList::sparseCellStorageUnsupported(const std::string &caller)
+	{
+		std::cout << "\n Error: " << caller << " keeps persistent cell pointers, "
+				  << "which the sparse cell storage reassigns at every rebuild!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
+	void CellLinkedList::recordCellResidency()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		particle_cell_residency_.resize(total_real_particles);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					particle_cell_residency_[i] = particle_linear_cell_indexes_[i];
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	bool CellLinkedList::updateCellListsIncrementally()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+
+		ConcurrentIndexVector moved_particles;
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					if (particle_linear_cell_indexes_[i] != particle_cell_residency_[i])
+						moved_particles.push_back(i);
+				}
+			},
+			ap);
+
+		StdVec<CellList *> touched_cells;
+		for (size_t n = 0; n != moved_particles.size(); ++n)
+		{
+			size_t i = moved_particles[n];
+			CellList &previous_cell =
+				CellListFromCellIndex(transfer1DtoMeshIndex(number_of_cells_, particle_cell_residency_[i]));
+			CellList &target_cell =
+				CellListFromCellIndex(transfer1DtoMeshIndex(number_of_cells_, particle_linear_cell_indexes_[i]));
+			// a move which empties a cell or occupies an empty one changes
+			// the split cell lists, which only a full rebuild refreshes
+			if (previous_cell.concurrent_particle_indexes_.size() == 1 ||
+				target_cell.concurrent_particle_indexes_.size() == 0)
+				return false;
+
+			ConcurrentIndexVector &previous_indexes = previous_cell.concurrent_particle_indexes_;
+			for (size_t s = 0; s != previous_indexes.size(); ++s)
+			{
+				if (previous_indexes[s] == i)
+				{
+					previous_indexes[s] = previous_indexes[previous_indexes.size() - 1];
+					previous_indexes.resize(previous_indexes.size() - 1);
+					break;
+				}
+			}
+			target_cell.concurrent_particle_indexes_.push_back(i);
+			particle_cell_residency_[i] = particle_linear_cell_indexes_[i];
+
+			if (std::find(touched_cells.begin(), touched_cells.end(), &previous_cell) == touched_cells.end())
+				touched_cells.push_back(&previous_cell);
+			if (std::find(touched_cells.begin(), touched_cells.end(), &target_cell) == touched_cells.end())
+				touched_cells.push_back(&target_cell);
+		}
+
+		// refresh the real particle indexes of the touched cells only
+		for (CellList *cell : touched_cells)
+		{
+			cell->real_particle_indexes_.clear();
+			for (size_t s = 0; s != cell->concurrent_particle_indexes_.size(); ++s)
+				cell->real_particle_indexes_.push_back(cell->concurrent_particle_indexes_[s]);
+		}
+		return true;
 	}
 	//=================================================================================================//
 	void CellLinkedList::assignBaseParticles(BaseParticles *base_particles)
@@ -60,13 +570,20 @@ namespace SPH
 	{
 		StdLargeVec<Vecd> &positions = base_particles_->pos_n_;
 		size_t total_real_particles = base_particles_->total_real_particles_;
+		// the cell indexes cached at the last update describe the same
+		// configuration the cell lists hold, so they are reused as long as
+		// the particle order has not changed since
+		bool use_cached_cell_indexes = particle_linear_cell_indexes_.size() == total_real_particles;
 		parallel_for(
 			blocked_range<size_t>(0, total_real_particles),
 			[&](const blocked_range<size_t> &r)
 			{
 				for (size_t i = r.begin(); i != r.end(); ++i)
 				{
-					sequence[i] = transferMeshIndexToMortonOrder(CellIndexFromPosition(positions[i]));
+					sequence[i] = use_cached_cell_indexes
+									  ? transferMeshIndexToMortonOrder(transfer1DtoMeshIndex(
+											number_of_cells_, particle_linear_cell_indexes_[i]))
+									  : transferMeshIndexToMortonOrder(CellIndexFromPosition(positions[i]));
 				}
 			},
 			ap);
@@ -91,17 +608,83 @@ namespace SPH
 		return 999; // means an error in level searching
 	};
 	//=================================================================================================//
+	void MultilevelCellLinkedList::updateParticleLevels()
+	{
+		size_t total_real_particles = base_particles_->total_real_particles_;
+		particle_levels_.resize(total_real_particles);
+		level_particle_buckets_.resize(total_levels_);
+
+		// first pass: resolve the level of each particle and count the bucket sizes
+		StdVec<std::atomic<size_t>> level_entries(total_levels_);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t level = getMeshLevel(kernel_.CutOffRadius(h_ratio_[i]));
+					particle_levels_[i] = level;
+					level_entries[level].fetch_add(1, std::memory_order_relaxed);
+				}
+			},
+			ap);
+
+		for (size_t level = 0; level != total_levels_; ++level)
+		{
+			level_particle_buckets_[level].resize(level_entries[level].load(std::memory_order_relaxed));
+			level_entries[level].store(0, std::memory_order_relaxed);
+		}
+
+		// second pass: lock-free scatter of the particle indexes into their buckets
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t level = particle_levels_[i];
+					size_t entry = level_entries[level].fetch_add(1, std::memory_order_relaxed);
+					level_particle_buckets_[level][entry] = i;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void MultilevelCellLinkedList::invalidateCellResidency()
+	{
+		particle_levels_.clear();
+		for (size_t level = 0; level != total_levels_; ++level)
+			mesh_levels_[level]->invalidateCellResidency();
+	}
+	//=================================================================================================//
+	size_t MultilevelCellLinkedList::MemoryFootprint()
+	{
+		size_t footprint_in_bytes = 0;
+		for (size_t level = 0; level != total_levels_; ++level)
+			footprint_in_bytes += mesh_levels_[level]->MemoryFootprint();
+		footprint_in_bytes += particle_levels_.capacity() * sizeof(size_t);
+		for (size_t level = 0; level != level_particle_buckets_.size(); ++level)
+			footprint_in_bytes += level_particle_buckets_[level].capacity() * sizeof(size_t);
+		return footprint_in_bytes;
+	}
+	//=================================================================================================//
 	void MultilevelCellLinkedList::
 		insertACellLinkedParticleIndex(size_t particle_index, const Vecd &particle_position)
 	{
-		size_t level = getMeshLevel(kernel_.CutOffRadius(h_ratio_[particle_index]));
+		// the level record is valid for callers after the cell list update,
+		// e.g. the periodic conditions, and rebuilt with the cell lists otherwise
+		size_t level = particle_index < particle_levels_.size()
+						   ? particle_levels_[particle_index]
+						   : getMeshLevel(kernel_.CutOffRadius(h_ratio_[particle_index]));
 		mesh_levels_[level]->insertACellLinkedParticleIndex(particle_index, particle_position);
 	}
 	//=================================================================================================//
 	void MultilevelCellLinkedList::
 		InsertACellLinkedListDataEntry(size_t particle_index, const Vecd &particle_position)
 	{
-		size_t level = getMeshLevel(kernel_.CutOffRadius(h_ratio_[particle_index]));
+		size_t level = particle_index < particle_levels_.size()
+						   ? particle_levels_[particle_index]
+						   : getMeshLevel(kernel_.CutOffRadius(h_ratio_[particle_index]));
 		mesh_levels_[level]->InsertACellLinkedListDataEntry(particle_index, particle_position);
 	}
 	//=================================================================================================//
@@ -116,22 +699,29 @@ namespace SPH
 	//=================================================================================================//
 	void MultilevelCellLinkedList::UpdateCellLists()
 	{
+		update_version_++;
 		for (size_t level = 0; level != total_levels_; ++level)
 			mesh_levels_[level]->clearCellLists();
 
 		StdLargeVec<Vecd> &pos_n = base_particles_->pos_n_;
-		size_t total_real_particles = base_particles_->total_real_particles_;
-		// rebuild the corresponding particle list.
-		parallel_for(
-			blocked_range<size_t>(0, total_real_particles),
-			[&](const blocked_range<size_t> &r)
-			{
-				for (size_t i = r.begin(); i != r.end(); ++i)
+		updateParticleLevels();
+		// rebuild each level's particle list by a direct scatter of its bucket
+		for (size_t level = 0; level != total_levels_; ++level)
+		{
+			IndexVector &bucket = level_particle_buckets_[level];
+			CellLinkedList *mesh_level = mesh_levels_[level];
+			parallel_for(
+				blocked_range<size_t>(0, bucket.size()),
+				[&](const blocked_range<size_t> &r)
 				{
-					insertACellLinkedParticleIndex(i, pos_n[i]);
-				}
-			},
-			ap);
+					for (size_t n = r.begin(); n != r.end(); ++n)
+					{
+						size_t i = bucket[n];
+						mesh_level->insertACellLinkedParticleIndex(i, pos_n[i]);
+					}
+				},
+				ap);
+		}
 
 		for (size_t level = 0; level != total_levels_; ++level)
 			mesh_levels_[level]->UpdateCellListData();
@@ -147,4 +737,14 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void MultilevelCellLinkedList::
+		retagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included,
+							const BoundingBox &retagging_bounds)
+	{
+		for (size_t l = 0; l != total_levels_; ++l)
+		{
+			mesh_levels_[l]->retagBodyPartByCell(cell_lists, check_included, retagging_bounds);
+		}
+	}
+	//=================================================================================================//
 }
@@ -36,6 +36,8 @@
 #include "base_mesh.h"
 #include "neighbor_relation.h"
 
+#include <atomic>
+
 namespace SPH
 {
 
@@ -44,6 +46,26 @@ namespace SPH
 	class BaseParticles;
 	class Kernel;
 	class SPHAdaptation;
+	/**
+	 * @class SplitCellGraphExecution
+	 * @brief Switch the parallel splitting sweeps from the level-by-level
+	 * execution with a global barrier between levels to a dependency-graph
+	 * execution, in which a cell becomes ready as soon as its neighboring
+	 * cells in the preceding levels have been processed and ready cells
+	 * are stolen across levels. When switched on, the cell linked list
+	 * additionally records the neighbor-level links for each cell.
+	 */
+	class SplitCellGraphExecution
+	{
+	public:
+		static void switchOn() { graph_execution_enabled_ = true; };
+		static void switchOff() { graph_execution_enabled_ = false; };
+		static bool Enabled() { return graph_execution_enabled_; };
+
+	private:
+		static bool graph_execution_enabled_;
+	};
+
 	/**
 	 * @class CellList
 	 * @brief The linked list for one cell
@@ -53,10 +75,19 @@ namespace SPH
 	public:
 		/** using concurrent vectors due to writing conflicts when building the list */
 		ConcurrentIndexVector concurrent_particle_indexes_;
-		/** non-concurrent cell linked list rewritten for building neighbor list */
-		ListDataVector cell_list_data_;
+		/** non-concurrent cell linked list rewritten for building neighbor list,
+		 * kept as parallel index and position arrays so that the candidate
+		 * filtering of the neighbor search streams pure position data. */
+		IndexVector cell_list_indexes_;
+		StdVec<Vecd> cell_list_positions_;
 		/** the index vector for real particles. */
 		IndexVector real_particle_indexes_;
+		/** non-empty neighbor cells in the following and preceding split levels,
+		 * only maintained for the dependency-graph splitting sweep */
+		StdVec<CellList *> higher_level_neighbor_cells_;
+		StdVec<CellList *> lower_level_neighbor_cells_;
+		/** remaining unprocessed neighbor levels during a splitting sweep */
+		std::atomic<size_t> pending_split_dependencies_;
 
 		CellList();
 		~CellList(){};
@@ -72,6 +103,7 @@ namespace SPH
 		SPHBody &sph_body_;
 		Kernel &kernel_;
 		BaseParticles *base_particles_;
+		size_t update_version_;
 
 		/** clear split cell lists in this mesh*/
 		virtual void clearSplitCellLists(SplitCellLists &split_cell_lists);
@@ -89,6 +121,16 @@ namespace SPH
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() = 0;
+		/** version counting the cell list rebuilds, so that products derived
+		 * from the cell lists, e.g. cached interpolation stencils, can check
+		 * cheaply whether they are still current */
+		size_t UpdateVersion() { return update_version_; };
+		/** invalidate recorded cell residency when particle indices change, e.g. by sorting */
+		virtual void invalidateCellResidency(){};
+		/** inform the cell linked list that the particle arrays have just been
+		 * reordered by the cell-key sort, so that the next update can derive
+		 * the cell contents from the sorted order */
+		virtual void markCellKeySortedOrder(){};
 		/** Insert a cell-linked_list entry to the concurrent index list. */
 		virtual void insertACellLinkedParticleIndex(size_t particle_index, const Vecd &particle_position) = 0;
 		/** Insert a cell-linked_list entry of the index and particle position pair. */
@@ -99,6 +141,10 @@ namespace SPH
 		virtual void computingSequence(StdLargeVec<size_t> &sequence) = 0;
 		/** Tag body part by cell, call by body part */
 		virtual void tagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) = 0;
+		/** Retag body part by cell restricted to the given bounds, the only region
+		 * where the containment status can have changed, called by moving body parts */
+		virtual void retagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included,
+										 const BoundingBox &retagging_bounds) = 0;
 		/** Tag domain bounding cells in an axis direction, called by domain bounding classes */
 		virtual void tagBodyDomainBoundingCells(StdVec<CellLists> &cell_lists, BoundingBox &body_domain_bounds, int axis) = 0;
 		/** Tag mirror bounding cells, called by mirror boundary condition */
@@ -116,8 +162,78 @@ namespace SPH
 		/** The array for of mesh cells, i.e. mesh data.
 		 * Within each cell, a list is saved with the indexes of particles.*/
 		MeshDataMatrix<CellList> cell_linked_lists_;
+		/** whether only the particles whose cell changed are moved in the update */
+		bool use_incremental_update_;
+		/** linear cell index in which each particle currently resides,
+		 * only maintained for the incremental update. */
+		StdLargeVec<size_t> particle_cell_residency_;
+		/** whether the cell lists are rebuilt by a two-pass counting sort */
+		bool use_counting_sort_insertion_;
+		/** whether the particle arrays have just been cell-key sorted,
+		 * set by the particle sorting and consumed by the next update */
+		bool sorted_order_hint_;
+		/** linear cell index of each particle during a counting-sort rebuild */
+		StdLargeVec<size_t> particle_cell_keys_;
+		/** linear cell index of each particle, computed in one pass per update
+		 * and consumed by the insertion, the incremental move detection, the
+		 * residency record and the sorting sequence; cleared when the particle
+		 * order changes so that consumers fall back to the position transform */
+		StdLargeVec<size_t> particle_linear_cell_indexes_;
+		/** flat cell-contiguous particle index array built by the counting sort */
+		StdLargeVec<size_t> cell_contiguous_indexes_;
+		/** whether the counting-sort keys follow the Morton order of the cells */
+		bool use_morton_cell_ordering_;
+		/** whether the occupied cells are stored in an open-addressed hash
+		 * instead of the dense cell matrix spanning the system bounds */
+		bool use_sparse_cell_storage_;
+		/** open-addressed hash of the occupied cells: the linear cell indexes
+		 * as keys, MaxSize_t marking an empty slot, and the matching cell lists */
+		StdLargeVec<size_t> sparse_cell_keys_;
+		StdLargeVec<CellList *> sparse_cell_slots_;
+		/** linear indexes of the occupied cells for iterating them directly */
+		IndexVector occupied_cell_indexes_;
+		/** pooled cell lists reassigned to the occupied cells at every rebuild */
+		StdVec<UniquePtr<CellList>> sparse_cell_pool_;
+		/** dense Morton rank of each linear cell index and its inverse permutation,
+		 * built once since the mesh extent is fixed after construction. */
+		StdLargeVec<size_t> morton_cell_ranks_;
+		StdLargeVec<size_t> morton_rank_to_cell_;
 
 		virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+		/** access the cell list of a mesh cell, implemented dimension dependently */
+		CellList &CellListFromCellIndex(const Vecu &cell_index);
+		/** the one position-to-cell transform per particle of an update */
+		void updateParticleLinearCellIndexes();
+		/** record the cell residency of all particles after a full rebuild */
+		void recordCellResidency();
+		/** move only the particles whose cell index changed since the last update.
+		 * returns false when a move empties or newly occupies a cell,
+		 * so that the split cell lists are refreshed by a full rebuild. */
+		bool updateCellListsIncrementally();
+		/** rebuild the cell lists by a counting sort: a parallel count per cell,
+		 * a prefix sum over the cells and a lock-free parallel scatter into a
+		 * flat cell-contiguous index array, from which each cell list is
+		 * filled without write conflicts. */
+		void updateCellListsByCountingSort();
+		/** derive the cell lists from a cell-key sorted particle order, where
+		 * cell occupancy is implicit: one scan over the recomputed sort keys
+		 * gives the contiguous particle range of each cell without any
+		 * scatter. Returns false when the order does not hold any more. */
+		bool updateCellListsFromSortedOrder();
+		/** hash slot probed first for a linear cell index */
+		size_t firstSparseSlot(size_t linear_cell_index) const;
+		/** the cell list of an occupied cell, nullptr when the cell is empty */
+		CellList *findSparseCell(size_t linear_cell_index);
+		/** rebuild the hash over the current occupied cells from the pool,
+		 * clearing the reassigned cell lists for refilling. serial. */
+		void rehashSparseCells();
+		/** counterpart of UpdateCellListData over the occupied cells only */
+		void updateSparseCellListData();
+		/** counterpart of updateSplitCellLists over the occupied cells only */
+		void updateSparseSplitCellLists(SplitCellLists &split_cell_lists);
+		/** exit with an error for callers keeping persistent cell pointers,
+		 * which the sparse storage reassigns at every rebuild */
+		void sparseCellStorageUnsupported(const std::string &caller);
 
 	public:
 		CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
@@ -136,9 +252,69 @@ namespace SPH
 		virtual ListData findNearestListDataEntry(const Vecd &position) override;
 		virtual void computingSequence(StdLargeVec<size_t> &sequence) override;
 		virtual void tagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
+		virtual void retagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included,
+										 const BoundingBox &retagging_bounds) override;
 		virtual void tagBodyDomainBoundingCells(StdVec<CellLists> &cell_lists, BoundingBox &body_domain_bounds, int axis) override;
 		virtual void tagMirrorBoundingCells(CellLists &cell_lists, BoundingBox &body_domain_bounds, int axis, bool positive) override;
 		virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
+		/** allocated bytes of the cell lists and the cell-residency records. */
+		virtual size_t MemoryFootprint() override;
+
+		/** switch to incremental updating, which tracks the cell residency of
+		 * each particle and only moves those whose cell index changed.
+		 * The residency record is rebuilt from scratch when the particle
+		 * number changes or after particle sorting. */
+		void useIncrementalUpdate() { use_incremental_update_ = true; };
+		virtual void invalidateCellResidency() override
+		{
+			particle_cell_residency_.clear();
+			particle_linear_cell_indexes_.clear();
+		};
+		virtual void markCellKeySortedOrder() override { sorted_order_hint_ = true; };
+
+		/** the per-particle linear cell indexes cached at the last update,
+		 * empty when the particle order has changed since */
+		StdLargeVec<size_t> &ParticleLinearCellIndexes() { return particle_linear_cell_indexes_; };
+
+		/** switch the cell list rebuild from concurrent push_back insertion,
+		 * which contends on the internal locks of the concurrent vectors,
+		 * to a lock-free two-pass counting sort. */
+		void useCountingSortInsertion() { use_counting_sort_insertion_ = true; };
+
+		/** switch the counting-sort rebuild from lexicographic to Morton/Z-order
+		 * cell keys, the same curve the particle sorting sequence follows, so
+		 * that the cell offset metadata and the flat cell-contiguous index
+		 * array stream in the order the sorted particles are visited.
+		 * Implies the counting-sort insertion. */
+		void useMortonCellOrdering()
+		{
+			use_morton_cell_ordering_ = true;
+			use_counting_sort_insertion_ = true;
+		};
+
+		/** switch the cell storage from the dense matrix spanning the system
+		 * bounds to an open-addressed hash of the occupied cells only, for
+		 * domains where the particles fill a small fraction of the bounds,
+		 * e.g. sprays and jets. Implies the counting-sort insertion, whose
+		 * per-cell counts provide the occupied cells in one scan. Cell-tagged
+		 * body parts and the domain or mirror bounding conditions keep
+		 * persistent cell pointers and thus still require the dense storage. */
+		void useSparseCellStorage();
+
+		/** stream the entries of one cell against the origin particle */
+		template <typename GetNeighborRelation>
+		void scanCellForNeighbors(CellList &target_cell, size_t index_i, const Vecd &particle_position,
+								  Neighborhood &neighborhood, GetNeighborRelation &get_neighbor_relation);
+
+		/** search the neighbors of a single origin particle, so that several
+		 * relations sharing the source particles can be built in one sweep.
+		 * For the common single-cell search depth, interior cells walk a
+		 * compile-time stencil with the bounds checks hoisted into one
+		 * interior test; only the boundary cells take the clamped loop. */
+		template <typename GetNeighborRelation>
+		void searchNeighborsForOneParticle(size_t index_i, const Vecd &particle_position,
+										   int search_depth, Neighborhood &neighborhood,
+										   GetNeighborRelation &get_neighbor_relation);
 
 		/** generalized particle search algorithm */
 		template <typename GetParticleIndex, typename GetSearchDepth, typename GetNeighborRelation>
@@ -146,6 +322,14 @@ namespace SPH
 										ParticleConfiguration &particle_configuration, GetParticleIndex &get_particle_index,
 										GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation);
 
+		/** generalized particle search algorithm restricted to given search bounds:
+		 * source particles whose kernel support lies outside the bounds are skipped */
+		template <typename GetParticleIndex, typename GetSearchDepth, typename GetNeighborRelation>
+		void searchNeighborsByParticles(size_t total_real_particles, BaseParticles &source_particles,
+										ParticleConfiguration &particle_configuration, GetParticleIndex &get_particle_index,
+										GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation,
+										const BoundingBox &search_bounds);
+
 		/** generalized particle search algorithm for searching body part */
 		template <typename GetParticleIndex, typename GetSearchDepth, typename GetNeighborRelation, typename PartParticleCheck>
 		void searchNeighborPartsByParticles(size_t total_real_particles, BaseParticles &source_particles,
@@ -165,9 +349,18 @@ namespace SPH
 	{
 	protected:
 		StdLargeVec<Real> &h_ratio_;
+		/** mesh level in which each particle currently resides,
+		 * rebuilt together with the cell lists and invalidated by particle sorting */
+		StdLargeVec<size_t> particle_levels_;
+		/** particle indexes bucketed by mesh level, so that the cell list insertion
+		 * and the level-resolved neighbor search sweep each level by a direct
+		 * indexed scatter instead of resolving the level per particle */
+		StdVec<IndexVector> level_particle_buckets_;
 		virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override{};
 		/** determine mesh level from particle cutoff radius */
 		inline size_t getMeshLevel(Real particle_cutoff_radius);
+		/** resolve the mesh level of all particles in one sweep and bucket them by level */
+		void updateParticleLevels();
 
 	public:
 		MultilevelCellLinkedList(BoundingBox tentative_bounds, Real reference_grid_spacing,
@@ -176,13 +369,20 @@ namespace SPH
 
 		virtual void assignBaseParticles(BaseParticles *base_particles) override;
 		virtual void UpdateCellLists() override;
+		virtual void invalidateCellResidency() override;
+		/** particle indexes bucketed by mesh level, rebuilt with the cell lists */
+		StdVec<IndexVector> &getLevelParticleBuckets() { return level_particle_buckets_; };
 		void insertACellLinkedParticleIndex(size_t particle_index, const Vecd &particle_position) override;
 		void InsertACellLinkedListDataEntry(size_t particle_index, const Vecd &particle_position) override;
 		virtual ListData findNearestListDataEntry(const Vecd &position) override { return ListData(0, Vecd(0)); };
 		virtual void computingSequence(StdLargeVec<size_t> &sequence) override{};
 		virtual void tagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
+		virtual void retagBodyPartByCell(CellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included,
+										 const BoundingBox &retagging_bounds) override;
 		virtual void tagBodyDomainBoundingCells(StdVec<CellLists> &cell_lists, BoundingBox &body_domain_bounds, int axis) override{};
 		virtual void tagMirrorBoundingCells(CellLists &cell_lists, BoundingBox &body_domain_bounds, int axis, bool positive) override{};
+		/** allocated bytes of all mesh levels and the particle-level records. */
+		virtual size_t MemoryFootprint() override;
 	};
 }
 #endif //MESH_CELL_LINKED_LIST_H
\ No newline at end of file
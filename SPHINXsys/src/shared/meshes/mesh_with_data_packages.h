@@ -32,6 +32,7 @@
 
 #include "base_mesh.h"
 #include "my_memory_pool.h"
+#include "loop_tuning.h"
 
 #include <fstream>
 #include <algorithm>
@@ -70,6 +71,46 @@ namespace SPH
 			},
 			ap);
 	};
+	/** Iterator on a collection of mesh data packages. parallel computing
+	 * with the grain size and the serial-execution decision taken from the
+	 * given loop tuner. The tuner measures the default parallel path until
+	 * its decision is locked in. */
+	template <class DataPackageType>
+	void PackageIterator_parallel(ConcurrentVector<DataPackageType *> &data_pkgs,
+								  PackageFunctor<void, DataPackageType> &pkg_functor,
+								  LoopTuner &loop_tuner, Real dt = 0.0)
+	{
+		if (!LoopTuning::Enabled())
+		{
+			PackageIterator_parallel(data_pkgs, pkg_functor, dt);
+			return;
+		}
+
+		if (!loop_tuner.Tuned())
+		{
+			tick_count start_time = tick_count::now();
+			PackageIterator_parallel(data_pkgs, pkg_functor, dt);
+			loop_tuner.recordSample(data_pkgs.size(), (tick_count::now() - start_time).seconds());
+			return;
+		}
+
+		if (loop_tuner.SerialPreferred())
+		{
+			PackageIterator(data_pkgs, pkg_functor, dt);
+			return;
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, data_pkgs.size(), loop_tuner.GrainSize()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					pkg_functor(data_pkgs[i], dt);
+				}
+			},
+			ap);
+	};
 	/** Package iterator for reducing. sequential computing. */
 	template <class ReturnType, typename ReduceOperation, class DataPackageType>
 	ReturnType ReducePackageIterator(ConcurrentVector<DataPackageType *> &data_pkgs, ReturnType temp,
@@ -199,7 +240,7 @@ namespace SPH
 		explicit MeshWithDataPackages(BoundingBox tentative_bounds, Real data_spacing, size_t buffer_size, Args &&...args)
 			: MeshFieldType(std::forward<Args>(args)...),
 			  Mesh(tentative_bounds, DataPackageType().PackageSize() * data_spacing, buffer_size),
-			  data_spacing_(data_spacing),
+			  data_spacing_(data_spacing), use_slab_allocation_(false),
 			  global_mesh_(this->mesh_lower_bound_ + Vecd(data_spacing) * 0.5, data_spacing, this->number_of_cells_ * pkg_size_)
 		{
 			allocateMeshDataMatrix();
@@ -209,22 +250,49 @@ namespace SPH
 		void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
 		void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
 
+		/** allocated bytes of the package pool and the package address mesh. */
+		virtual size_t MemoryFootprint() override
+		{
+			size_t number_of_addresses = 1;
+			for (int axis = 0; axis != Dimensions; ++axis)
+				number_of_addresses *= number_of_cells_[axis];
+			return size_t(data_pkg_pool_.capicity()) * sizeof(DataPackageType) +
+				   number_of_addresses * sizeof(DataPackageType *);
+		};
+
 		/** This function probe a mesh value */
 		template <class DataType, typename PackageDataAddressType, PackageDataAddressType DataPackageType::*MemPtr>
 		DataType probeMesh(const Vecd &position);
+		/** This function probes mesh values for an array of positions.
+		 * The queries are answered in the order of their data packages,
+		 * so that the package address is resolved once per package and
+		 * the probes stream through each package instead of walking the
+		 * package matrix for every position. */
+		template <class DataType, typename PackageDataAddressType, PackageDataAddressType DataPackageType::*MemPtr>
+		void probeMeshBatch(const StdLargeVec<Vecd> &positions, StdLargeVec<DataType> &probed_values);
 		virtual Real DataSpacing() override { return data_spacing_; };
+		/** switch on the slab allocation mode, in which the data packages of this mesh
+		 * are relocated from the memory pool into one contiguous slab along the Z-order
+		 * curve after they have been created, so that packages which are close in space
+		 * are also close in memory when probes cross the package boundaries. */
+		void useSlabAllocation() { use_slab_allocation_ = true; };
 
 	protected:
 		Real data_spacing_;													  /**< spacing of data in the data packages*/
+		bool use_slab_allocation_;											  /**< whether the data packages are compacted into a contiguous slab. */
 		const int pkg_size_ = DataPackageType().PackageSize();				  /**< the size of the data package matrix*/
 		const int pkg_addrs_buffer_ = DataPackageType().AddressBufferWidth(); /**< the size of address buffer, a value less than the package size. */
 		const int pkg_operations_ = pkg_size_ + pkg_addrs_buffer_;			  /**< the size of operation loops. */
 		const int pkg_addrs_size_ = pkg_size_ + 2 * pkg_addrs_buffer_;		  /**< the size of address matrix in the data packages. */
-		std::mutex mutex_my_pool;											  /**< mutex exclusion for memory pool */
 		BaseMesh global_mesh_;												  /**< the mesh for the locations of all possible data points. */
 		/** Singular data packages. prodvied for far field condition with usually only two values.
 		 * For example, when level set is considered. The first value for inner farfield and second for outer far field */
 		StdVec<DataPackageType *> singular_data_pkgs_addrs_;
+		StdLargeVec<DataPackageType> data_pkg_slab_; /**< the compacted data packages in Z-order, replacing the pool entries. */
+		/** reusable buffers of the batched probes, retaining their high-water
+		 * sizes so that repeated batches do not allocate */
+		StdLargeVec<size_t> probe_package_keys_;
+		StdLargeVec<size_t> probe_query_order_;
 
 		template <typename... ConstructorArgs>
 		void initializeASingularDataPackage(ConstructorArgs &&...args)
@@ -235,12 +303,42 @@ namespace SPH
 			singular_data_pkgs_addrs_.push_back(new_data_pkg);
 		};
 
+		/** Relocate the given scattered pool-allocated data packages into one
+		 * contiguous slab sorted along the Z-order (Morton) curve of their cell
+		 * indexes and redirect the package address matrix to the slab entries.
+		 * The recording functor re-registers each relocated package with the
+		 * derived class, whose previously recorded package pointers are all
+		 * invalidated. It therefore must be called after all packages of the
+		 * mesh have been created but before the package data addresses are
+		 * initialized, since those record raw pointers into the neighboring
+		 * packages. The freed pool entries remain in the pool for reuse. */
+		void compactDataPackagesIntoSlab(StdVec<DataPackageType *> &scattered_pkgs,
+										 const std::function<void(DataPackageType *)> &record_relocated_pkg)
+		{
+			std::sort(scattered_pkgs.begin(), scattered_pkgs.end(),
+					  [&](DataPackageType *pkg_a, DataPackageType *pkg_b)
+					  { return this->transferMeshIndexToMortonOrder(pkg_a->pkg_index_) <
+							   this->transferMeshIndexToMortonOrder(pkg_b->pkg_index_); });
+			data_pkg_slab_.resize(scattered_pkgs.size());
+			for (size_t n = 0; n != scattered_pkgs.size(); ++n)
+			{
+				data_pkg_slab_[n] = *scattered_pkgs[n];
+				data_pkg_pool_.free(scattered_pkgs[n]);
+				assignDataPackageAddress(data_pkg_slab_[n].pkg_index_, &data_pkg_slab_[n]);
+				record_relocated_pkg(&data_pkg_slab_[n]);
+			}
+		};
+
 		void assignDataPackageAddress(const Vecu &cell_index, DataPackageType *data_pkg);
 		DataPackageType *DataPackageFromCellIndex(const Vecu &cell_index);
 		/** This function find the value of data from its index from global mesh. */
 		template <typename DataType, typename PackageDataType, PackageDataType DataPackageType::*MemPtr>
 		DataType DataValueFromGlobalIndex(const Vecu &global_grid_index);
 		void initializePackageAddressesInACell(const Vecu &cell_index);
+		/** initialize the address matrix of a given package which is not yet
+		 * registered in the package address matrix, so that it can be built
+		 * completely before being published to concurrent probes. */
+		void initializePackageAddresses(DataPackageType *data_pkg, const Vecu &cell_index);
 		/** find related cell index and data index for a data package address matrix */
 		std::pair<int, int> CellShiftAndDataIndex(int data_addrs_index_component)
 		{
@@ -7,6 +7,7 @@
 #include "tbb/enumerable_thread_specific.h"
 
 #include <list>
+#include <mutex>
 
 using namespace tbb;
 //-------------------------------------------------------------------------------------------------
@@ -26,6 +27,11 @@ class MyMemoryPool {
 #endif
 	std::list<T*> free_list;									//list of all free nodes
 
+	static const size_t batch_size_ = 16;						//nodes moved between a thread cache and the shared pool at once
+	typedef std::list<T*> LocalFreeList;
+	tbb::enumerable_thread_specific<LocalFreeList> local_free_lists_;	//thread-local caches of free nodes
+	std::mutex pool_mutex_;										//protects the shared lists of the concurrent interface
+
 public:
 
 	//constructor
@@ -57,12 +63,51 @@ public:
 	{
 		free_list.push_back(ptr);
 	};
+	//prepare an available node from the calling thread's cache,
+	//refilling the cache from the shared pool in one batch so that
+	//concurrent allocations do not serialize on the pool lock
+	T* malloc_concurrent()
+	{
+		LocalFreeList& local_free_list = local_free_lists_.local();
+		if (local_free_list.empty()) {
+			std::lock_guard<std::mutex> lock(pool_mutex_);
+			for (size_t n = 0; n != batch_size_; ++n) {
+				if (free_list.empty()) {
+					data_list.push_back(sample);
+					local_free_list.push_back(&data_list.back());
+				}
+				else
+				{
+					local_free_list.push_back(free_list.front());
+					free_list.pop_front();
+				}
+			}
+		}
+		T* result = local_free_list.front();
+		local_free_list.pop_front();
+		return result;
+	};
+	//relinquish an unused node to the calling thread's cache,
+	//returning one batch to the shared pool when the cache overfills
+	void free_concurrent(T* ptr)
+	{
+		LocalFreeList& local_free_list = local_free_lists_.local();
+		local_free_list.push_back(ptr);
+		if (local_free_list.size() > 2 * batch_size_) {
+			std::lock_guard<std::mutex> lock(pool_mutex_);
+			for (size_t n = 0; n != batch_size_; ++n) {
+				free_list.push_back(local_free_list.front());
+				local_free_list.pop_front();
+			}
+		}
+	};
 	//return the total number of nodes allocated
 	int capicity()
 	{
 		return data_list.size();
 	};
-	//return the number of current available nodes
+	//return the number of current available nodes,
+	//not counting the ones cached in the thread-local lists
 	int available_node()
 	{
 		return free_list.size();
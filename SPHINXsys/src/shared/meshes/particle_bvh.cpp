@@ -0,0 +1,94 @@
+/**
+ * @file 	particle_bvh.cpp
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#include "particle_bvh.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	void ParticleBVH::buildStructure()
+	{
+		ordered_particles_.resize(candidate_particles_.size());
+		std::copy(candidate_particles_.begin(), candidate_particles_.end(), ordered_particles_.begin());
+		nodes_.clear();
+		if (!ordered_particles_.empty())
+			buildANode(0, ordered_particles_.size());
+	}
+	//=================================================================================================//
+	size_t ParticleBVH::buildANode(size_t first_entry, size_t last_entry)
+	{
+		size_t node_index = nodes_.size();
+		nodes_.push_back(BVHNode());
+		nodes_[node_index].first_entry_ = first_entry;
+		nodes_[node_index].last_entry_ = last_entry;
+		nodes_[node_index].left_child_ = MaxSize_t;
+		nodes_[node_index].right_child_ = MaxSize_t;
+		fitBoundsToParticles(nodes_[node_index]);
+
+		if (last_entry - first_entry > leaf_capacity_)
+		{
+			// split at the median along the widest extent of the bounds
+			Vecd extent = nodes_[node_index].upper_bound_ - nodes_[node_index].lower_bound_;
+			int split_axis = 0;
+			for (int axis = 1; axis != Dimensions; ++axis)
+				if (extent[axis] > extent[split_axis])
+					split_axis = axis;
+			size_t median_entry = first_entry + (last_entry - first_entry) / 2;
+			std::nth_element(ordered_particles_.begin() + first_entry,
+							 ordered_particles_.begin() + median_entry,
+							 ordered_particles_.begin() + last_entry,
+							 [&](size_t a, size_t b)
+							 { return pos_n_[a][split_axis] < pos_n_[b][split_axis]; });
+			// the recursions may reallocate the nodes, so no reference is kept across them
+			size_t left_child = buildANode(first_entry, median_entry);
+			size_t right_child = buildANode(median_entry, last_entry);
+			nodes_[node_index].left_child_ = left_child;
+			nodes_[node_index].right_child_ = right_child;
+		}
+		return node_index;
+	}
+	//=================================================================================================//
+	void ParticleBVH::refitBounds()
+	{
+		// children always follow their parent, so the reverse order
+		// refits every child before the parent using it
+		for (size_t n = nodes_.size(); n != 0; --n)
+		{
+			BVHNode &node = nodes_[n - 1];
+			if (node.left_child_ == MaxSize_t)
+			{
+				fitBoundsToParticles(node);
+			}
+			else
+			{
+				const BVHNode &left_child = nodes_[node.left_child_];
+				const BVHNode &right_child = nodes_[node.right_child_];
+				for (int axis = 0; axis != Dimensions; ++axis)
+				{
+					node.lower_bound_[axis] = SMIN(left_child.lower_bound_[axis], right_child.lower_bound_[axis]);
+					node.upper_bound_[axis] = SMAX(left_child.upper_bound_[axis], right_child.upper_bound_[axis]);
+				}
+			}
+		}
+	}
+	//=================================================================================================//
+	void ParticleBVH::fitBoundsToParticles(BVHNode &node)
+	{
+		Vecd lower_bound(Infinity);
+		Vecd upper_bound(-Infinity);
+		for (size_t entry = node.first_entry_; entry != node.last_entry_; ++entry)
+		{
+			const Vecd &position = pos_n_[ordered_particles_[entry]];
+			for (int axis = 0; axis != Dimensions; ++axis)
+			{
+				lower_bound[axis] = SMIN(lower_bound[axis], position[axis]);
+				upper_bound[axis] = SMAX(upper_bound[axis], position[axis]);
+			}
+		}
+		node.lower_bound_ = lower_bound;
+		node.upper_bound_ = upper_bound;
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,127 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+* @file particle_bvh.h
+* @brief A bounding volume hierarchy over a set of particles for radius
+* queries in contact search, where the cell linked list degrades for thin
+* folded geometries because spatially near cells are filled with materially
+* far particles.
+* @author	Chi Zhang and Xiangyu Hu
+*/
+
+#ifndef PARTICLE_BVH_H
+#define PARTICLE_BVH_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <algorithm>
+
+namespace SPH
+{
+	/**
+	 * @class ParticleBVH
+	 * @brief A binary bounding volume hierarchy over a set of candidate
+	 * particles. The tree topology is built once by median splits along
+	 * the widest bound extent, afterwards only the node bounds are
+	 * refitted to the current particle positions in each update.
+	 * The traversal cost of a radius query depends on the spatial extent
+	 * of the visited leaves only, so the hierarchy stays efficient where
+	 * the cell linked list does not.
+	 */
+	class ParticleBVH
+	{
+	public:
+		ParticleBVH(StdLargeVec<Vecd> &pos_n, const IndexVector &candidate_particles,
+					size_t leaf_capacity = 8)
+			: pos_n_(pos_n), candidate_particles_(candidate_particles),
+			  leaf_capacity_(leaf_capacity){};
+		~ParticleBVH(){};
+
+		/** build the tree topology by recursive median splits */
+		void buildStructure();
+		/** fit the node bounds to the current particle positions
+		 * without changing the tree topology */
+		void refitBounds();
+		/** visit all candidate particles within the search radius around a position */
+		template <typename VisitParticle>
+		void queryNeighbors(const Vecd &position, Real search_radius,
+							const VisitParticle &visit_particle) const
+		{
+			if (nodes_.empty())
+				return;
+
+			Real squared_radius = search_radius * search_radius;
+			size_t node_stack[64];
+			size_t stack_size = 0;
+			node_stack[stack_size++] = 0;
+			while (stack_size != 0)
+			{
+				const BVHNode &node = nodes_[node_stack[--stack_size]];
+				// squared distance from the query position to the node bounds
+				Real squared_distance = 0.0;
+				for (int axis = 0; axis != Dimensions; ++axis)
+				{
+					Real excess = SMAX(node.lower_bound_[axis] - position[axis],
+									   position[axis] - node.upper_bound_[axis]);
+					if (excess > 0.0)
+						squared_distance += excess * excess;
+				}
+				if (squared_distance > squared_radius)
+					continue;
+
+				if (node.left_child_ == MaxSize_t)
+				{
+					for (size_t entry = node.first_entry_; entry != node.last_entry_; ++entry)
+						visit_particle(ordered_particles_[entry]);
+				}
+				else
+				{
+					node_stack[stack_size++] = node.left_child_;
+					node_stack[stack_size++] = node.right_child_;
+				}
+			}
+		};
+
+	protected:
+		struct BVHNode
+		{
+			Vecd lower_bound_, upper_bound_;
+			size_t first_entry_, last_entry_;	/**< entry range in the ordered particles */
+			size_t left_child_, right_child_; /**< MaxSize_t for leaf nodes */
+		};
+
+		StdLargeVec<Vecd> &pos_n_;
+		const IndexVector &candidate_particles_;
+		/** candidate particle indexes reordered by the median splits,
+		 * so that each leaf owns a contiguous range */
+		IndexVector ordered_particles_;
+		StdVec<BVHNode> nodes_; /**< children always follow their parent */
+		size_t leaf_capacity_;
+
+		/** create the node for an entry range and split it recursively */
+		size_t buildANode(size_t first_entry, size_t last_entry);
+		void fitBoundsToParticles(BVHNode &node);
+	};
+}
+#endif //PARTICLE_BVH_H
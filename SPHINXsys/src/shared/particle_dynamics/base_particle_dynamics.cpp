@@ -4,10 +4,105 @@
  */
 #include "base_particle_dynamics.h"
 #include "cell_linked_list.h"
+
+#include <mutex>
+#include <fstream>
+#include <iomanip>
 //=============================================================================================//
 namespace SPH
 {
 	Real GlobalStaticVariables::physical_time_ = 0.0;
+	bool ParticleDynamicsTiming::timing_enabled_ = false;
+	bool TraceEventRecording::recording_enabled_ = false;
+	tick_count TraceEventRecording::session_start_;
+	bool StaticParticlePartition::static_partition_enabled_ = false;
+	size_t SmallBodySerialFastPath::particle_threshold_ = 0;
+	bool DeterministicReduce::deterministic_reduce_enabled_ = false;
+	size_t DeterministicReduce::block_size_ = 1024;
+	//=============================================================================================//
+	tbb::task_arena &particleExecutionArena()
+	{
+		static tbb::task_arena execution_arena;
+		return execution_arena;
+	}
+	//=============================================================================================//
+	StdVec<ParticleDynamicsTiming *> &ParticleDynamicsTiming::RegisteredTimings()
+	{
+		static StdVec<ParticleDynamicsTiming *> registered_timings;
+		return registered_timings;
+	}
+	//=============================================================================================//
+	void ParticleDynamicsTiming::record(const std::type_info &dynamics_type, double seconds, size_t particles)
+	{
+		if (name_.empty())
+		{
+			name_ = DemangledName(dynamics_type);
+			// dynamics in a task group may register concurrently
+			static std::mutex registry_mutex;
+			std::lock_guard<std::mutex> lock(registry_mutex);
+			RegisteredTimings().push_back(this);
+		}
+		call_count_++;
+		particles_processed_ += particles;
+		accumulated_seconds_ += seconds;
+	}
+	//=============================================================================================//
+	tbb::enumerable_thread_specific<StdVec<TraceEventRecording::TraceEvent>> &TraceEventRecording::ThreadEvents()
+	{
+		static tbb::enumerable_thread_specific<StdVec<TraceEvent>> thread_events;
+		return thread_events;
+	}
+	//=============================================================================================//
+	void TraceEventRecording::switchOn()
+	{
+		session_start_ = tick_count::now();
+		recording_enabled_ = true;
+	}
+	//=============================================================================================//
+	void TraceEventRecording::recordEvent(const std::type_info *scope_type, const std::string &name,
+										  const char *category, const tick_count &start_time,
+										  const tick_count &end_time)
+	{
+		TraceEvent event;
+		event.scope_type_ = scope_type;
+		event.name_ = name;
+		event.category_ = category;
+		event.start_seconds_ = (start_time - session_start_).seconds();
+		event.duration_seconds_ = (end_time - start_time).seconds();
+		ThreadEvents().local().push_back(event);
+	}
+	//=============================================================================================//
+	void TraceEventRecording::writeToJsonFile(const std::string &filefullpath)
+	{
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+		out_file << std::fixed << std::setprecision(3);
+		out_file << "{\"traceEvents\":[";
+		bool first_event = true;
+		size_t thread_number = 0;
+		for (StdVec<TraceEvent> &events : ThreadEvents())
+		{
+			for (size_t n = 0; n != events.size(); ++n)
+			{
+				TraceEvent &event = events[n];
+				std::string name = event.scope_type_ != nullptr
+									   ? DemangledName(*event.scope_type_)
+									   : std::string();
+				if (!event.name_.empty())
+					name = name.empty() ? event.name_ : name + " " + event.name_;
+				out_file << (first_event ? "\n" : ",\n");
+				first_event = false;
+				out_file << "{\"name\":\"" << name
+						 << "\",\"cat\":\"" << event.category_
+						 << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_number
+						 << ",\"ts\":" << event.start_seconds_ * 1.0e6
+						 << ",\"dur\":" << event.duration_seconds_ * 1.0e6 << "}";
+			}
+			events.clear();
+			thread_number++;
+		}
+		out_file << "\n]}\n";
+		out_file.close();
+	}
 	//=============================================================================================//
 	void ParticleIterator(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt)
 	{
@@ -17,12 +112,66 @@ namespace SPH
 	//=============================================================================================//
 	void ParticleIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt)
 	{
-		parallel_for(blocked_range<size_t>(0, total_real_particles),
-			[&](const blocked_range<size_t>& r) {
-			for (size_t i = r.begin(); i < r.end(); ++i) {
-				particle_functor(i, dt);
+		if (total_real_particles <= SmallBodySerialFastPath::Threshold())
+		{
+			ParticleIterator(total_real_particles, particle_functor, dt);
+			return;
+		}
+
+		particleExecutionArena().execute([&]
+		{
+			if (StaticParticlePartition::Enabled())
+			{
+				parallel_for(blocked_range<size_t>(0, total_real_particles),
+					[&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i < r.end(); ++i) {
+						particle_functor(i, dt);
+					}
+				}, static_ap);
+				return;
 			}
-		}, ap);
+
+			parallel_for(blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i < r.end(); ++i) {
+					particle_functor(i, dt);
+				}
+			}, ap);
+		});
+	}
+	//=============================================================================================//
+	void ParticleIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor,
+								   LoopTuner &loop_tuner, Real dt)
+	{
+		if (!LoopTuning::Enabled())
+		{
+			ParticleIterator_parallel(total_real_particles, particle_functor, dt);
+			return;
+		}
+
+		if (!loop_tuner.Tuned())
+		{
+			tick_count start_time = tick_count::now();
+			ParticleIterator_parallel(total_real_particles, particle_functor, dt);
+			loop_tuner.recordSample(total_real_particles, (tick_count::now() - start_time).seconds());
+			return;
+		}
+
+		if (loop_tuner.SerialPreferred())
+		{
+			ParticleIterator(total_real_particles, particle_functor, dt);
+			return;
+		}
+
+		particleExecutionArena().execute([&]
+		{
+			parallel_for(blocked_range<size_t>(0, total_real_particles, loop_tuner.GrainSize()),
+				[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i < r.end(); ++i) {
+					particle_functor(i, dt);
+				}
+			}, ap);
+		});
 	}
 	//=================================================================================================//
 	void ParticleIteratorSplittingSweep(SplitCellLists& split_cell_lists,
@@ -61,6 +210,87 @@ namespace SPH
 	void ParticleIteratorSplittingSweep_parallel(SplitCellLists& split_cell_lists,
 		const ParticleFunctor &particle_functor, Real dt)
 	{
+		if (SplitCellGraphExecution::Enabled())
+		{
+			Real dt2 = dt * 0.5;
+			task_group sweep_tasks;
+
+			//forward sweeping: a cell becomes ready once its non-empty neighbors
+			//in the preceding split levels have been processed, so that ready
+			//cells are stolen across levels instead of waiting at a barrier
+			std::function<void(CellList *)> process_cell_forward = [&](CellList *cell_list)
+			{
+				IndexVector &particle_indexes = cell_list->real_particle_indexes_;
+				for (size_t i = 0; i != particle_indexes.size(); ++i)
+				{
+					particle_functor(particle_indexes[i], dt2);
+				}
+				for (size_t n = 0; n != cell_list->higher_level_neighbor_cells_.size(); ++n)
+				{
+					CellList *dependent_cell = cell_list->higher_level_neighbor_cells_[n];
+					if (dependent_cell->pending_split_dependencies_.fetch_sub(1) == 1)
+						sweep_tasks.run([&process_cell_forward, dependent_cell]
+										{ process_cell_forward(dependent_cell); });
+				}
+			};
+			for (size_t k = 0; k != split_cell_lists.size(); ++k)
+			{
+				ConcurrentCellLists &cell_lists = split_cell_lists[k];
+				for (size_t l = 0; l != cell_lists.size(); ++l)
+					cell_lists[l]->pending_split_dependencies_ = cell_lists[l]->lower_level_neighbor_cells_.size();
+			}
+			for (size_t k = 0; k != split_cell_lists.size(); ++k)
+			{
+				ConcurrentCellLists &cell_lists = split_cell_lists[k];
+				//seeding on the static property: cells without lower-level neighbors
+				//are never spawned by a finishing task, so no cell is spawned twice
+				for (size_t l = 0; l != cell_lists.size(); ++l)
+					if (cell_lists[l]->lower_level_neighbor_cells_.empty())
+					{
+						CellList *ready_cell = cell_lists[l];
+						sweep_tasks.run([&process_cell_forward, ready_cell]
+										{ process_cell_forward(ready_cell); });
+					}
+			}
+			sweep_tasks.wait();
+
+			//backward sweeping with the dependency directions reversed
+			std::function<void(CellList *)> process_cell_backward = [&](CellList *cell_list)
+			{
+				IndexVector &particle_indexes = cell_list->real_particle_indexes_;
+				for (size_t i = particle_indexes.size(); i != 0; --i)
+				{
+					particle_functor(particle_indexes[i - 1], dt2);
+				}
+				for (size_t n = 0; n != cell_list->lower_level_neighbor_cells_.size(); ++n)
+				{
+					CellList *dependent_cell = cell_list->lower_level_neighbor_cells_[n];
+					if (dependent_cell->pending_split_dependencies_.fetch_sub(1) == 1)
+						sweep_tasks.run([&process_cell_backward, dependent_cell]
+										{ process_cell_backward(dependent_cell); });
+				}
+			};
+			for (size_t k = 0; k != split_cell_lists.size(); ++k)
+			{
+				ConcurrentCellLists &cell_lists = split_cell_lists[k];
+				for (size_t l = 0; l != cell_lists.size(); ++l)
+					cell_lists[l]->pending_split_dependencies_ = cell_lists[l]->higher_level_neighbor_cells_.size();
+			}
+			for (size_t k = 0; k != split_cell_lists.size(); ++k)
+			{
+				ConcurrentCellLists &cell_lists = split_cell_lists[k];
+				for (size_t l = 0; l != cell_lists.size(); ++l)
+					if (cell_lists[l]->higher_level_neighbor_cells_.empty())
+					{
+						CellList *ready_cell = cell_lists[l];
+						sweep_tasks.run([&process_cell_backward, ready_cell]
+										{ process_cell_backward(ready_cell); });
+					}
+			}
+			sweep_tasks.wait();
+			return;
+		}
+
 		Real dt2 = dt * 0.5;
 		//forward sweeping
 		for (size_t k = 0; k != split_cell_lists.size(); ++k) {
@@ -95,5 +325,143 @@ namespace SPH
 		}
 	}
 	//=============================================================================================//
+	void ParticleIteratorSplittingSweep(SplitCellIndexRanges &split_cell_index_ranges,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		StdLargeVec<size_t> &contiguous_indexes = *split_cell_index_ranges.cell_contiguous_indexes_;
+		StdVec<StdVec<IndexRange>> &level_ranges = split_cell_index_ranges.level_ranges_;
+		Real dt2 = dt * 0.5;
+		//forward sweeping
+		for (size_t k = 0; k != level_ranges.size(); ++k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k];
+			for (size_t l = 0; l != cell_ranges.size(); ++l)
+			{
+				for (size_t entry = cell_ranges[l].first; entry != cell_ranges[l].second; ++entry)
+				{
+					particle_functor(contiguous_indexes[entry], dt2);
+				}
+			}
+		}
+
+		//backward sweeping
+		for (size_t k = level_ranges.size(); k != 0; --k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k - 1];
+			for (size_t l = 0; l != cell_ranges.size(); ++l)
+			{
+				for (size_t entry = cell_ranges[l].second; entry != cell_ranges[l].first; --entry)
+				{
+					particle_functor(contiguous_indexes[entry - 1], dt2);
+				}
+			}
+		}
+	}
+	//=============================================================================================//
+	void ParticleIteratorSplittingSweep_parallel(SplitCellIndexRanges &split_cell_index_ranges,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		StdLargeVec<size_t> &contiguous_indexes = *split_cell_index_ranges.cell_contiguous_indexes_;
+		StdVec<StdVec<IndexRange>> &level_ranges = split_cell_index_ranges.level_ranges_;
+		Real dt2 = dt * 0.5;
+		//forward sweeping
+		for (size_t k = 0; k != level_ranges.size(); ++k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k];
+			parallel_for(blocked_range<size_t>(0, cell_ranges.size()),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t l = r.begin(); l < r.end(); ++l) {
+						for (size_t entry = cell_ranges[l].first; entry != cell_ranges[l].second; ++entry)
+						{
+							particle_functor(contiguous_indexes[entry], dt2);
+						}
+					}
+				}, ap);
+		}
+
+		//backward sweeping
+		for (size_t k = level_ranges.size(); k != 0; --k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k - 1];
+			parallel_for(blocked_range<size_t>(0, cell_ranges.size()),
+				[&](const blocked_range<size_t>& r) {
+				for (size_t l = r.begin(); l < r.end(); ++l) {
+					for (size_t entry = cell_ranges[l].second; entry != cell_ranges[l].first; --entry)
+					{
+						particle_functor(contiguous_indexes[entry - 1], dt2);
+					}
+				}
+			}, ap);
+		}
+	}
+	//=============================================================================================//
+	void ParticleIteratorColoredSweep(SplitCellLists &split_cell_lists,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		for (size_t k = 0; k != split_cell_lists.size(); ++k) {
+			ConcurrentCellLists &cell_lists = split_cell_lists[k];
+			for (size_t l = 0; l != cell_lists.size(); ++l)
+			{
+				IndexVector &particle_indexes
+					= cell_lists[l]->real_particle_indexes_;
+				for (size_t i = 0; i != particle_indexes.size(); ++i)
+				{
+					particle_functor(particle_indexes[i], dt);
+				}
+			}
+		}
+	}
+	//=============================================================================================//
+	void ParticleIteratorColoredSweep_parallel(SplitCellLists &split_cell_lists,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		for (size_t k = 0; k != split_cell_lists.size(); ++k) {
+			ConcurrentCellLists &cell_lists = split_cell_lists[k];
+			parallel_for(blocked_range<size_t>(0, cell_lists.size()),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t l = r.begin(); l < r.end(); ++l) {
+						IndexVector &particle_indexes
+							= cell_lists[l]->real_particle_indexes_;
+						for (size_t i = 0; i < particle_indexes.size(); ++i)
+						{
+							particle_functor(particle_indexes[i], dt);
+						}
+					}
+				}, ap);
+		}
+	}
+	//=============================================================================================//
+	void ParticleIteratorColoredSweep(SplitCellIndexRanges &split_cell_index_ranges,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		StdLargeVec<size_t> &contiguous_indexes = *split_cell_index_ranges.cell_contiguous_indexes_;
+		StdVec<StdVec<IndexRange>> &level_ranges = split_cell_index_ranges.level_ranges_;
+		for (size_t k = 0; k != level_ranges.size(); ++k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k];
+			for (size_t l = 0; l != cell_ranges.size(); ++l)
+			{
+				for (size_t entry = cell_ranges[l].first; entry != cell_ranges[l].second; ++entry)
+				{
+					particle_functor(contiguous_indexes[entry], dt);
+				}
+			}
+		}
+	}
+	//=============================================================================================//
+	void ParticleIteratorColoredSweep_parallel(SplitCellIndexRanges &split_cell_index_ranges,
+		const ParticleFunctor &particle_functor, Real dt)
+	{
+		StdLargeVec<size_t> &contiguous_indexes = *split_cell_index_ranges.cell_contiguous_indexes_;
+		StdVec<StdVec<IndexRange>> &level_ranges = split_cell_index_ranges.level_ranges_;
+		for (size_t k = 0; k != level_ranges.size(); ++k) {
+			StdVec<IndexRange> &cell_ranges = level_ranges[k];
+			parallel_for(blocked_range<size_t>(0, cell_ranges.size()),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t l = r.begin(); l < r.end(); ++l) {
+						for (size_t entry = cell_ranges[l].first; entry != cell_ranges[l].second; ++entry)
+						{
+							particle_functor(contiguous_indexes[entry], dt);
+						}
+					}
+				}, ap);
+		}
+	}
+	//=============================================================================================//
 }
 //=============================================================================================//
\ No newline at end of file
@@ -36,8 +36,10 @@
 #include "neighbor_relation.h"
 #include "body_relation.h"
 #include "base_body.h"
+#include "loop_tuning.h"
 
 #include <functional>
+#include <typeinfo>
 
 using namespace std::placeholders;
 
@@ -45,6 +47,72 @@ namespace SPH
 {
 
 
+	/**
+	 * @class StaticParticlePartition
+	 * @brief Switch the parallel particle iterators from the affinity
+	 * partitioner to statically partitioned sub-ranges. Each worker thread
+	 * then processes the same index sub-range step after step, so that the
+	 * particle data it touches stays in its local caches and, together with
+	 * a matching memory placement policy, on its own NUMA node.
+	 */
+	class StaticParticlePartition
+	{
+	public:
+		static void switchOn() { static_partition_enabled_ = true; };
+		static void switchOff() { static_partition_enabled_ = false; };
+		static bool Enabled() { return static_partition_enabled_; };
+
+	private:
+		static bool static_partition_enabled_;
+	};
+
+	/** The persistent task arena in which all particle dynamics execute.
+	 * One explicitly held arena is reused across all parallel_exec() calls,
+	 * instead of entering the implicit arena anew for every dynamics.
+	 * The arena initializes lazily under the thread budget imposed by the
+	 * global control of SPHSystem. */
+	tbb::task_arena &particleExecutionArena();
+
+	/**
+	 * @class SmallBodySerialFastPath
+	 * @brief Run the parallel particle iterators serially for bodies with
+	 * fewer particles than a threshold, below which the parallel fork/join
+	 * overhead exceeds the useful work. Switched off by default;
+	 * a typical threshold is obtained from the micro-benchmarks.
+	 */
+	class SmallBodySerialFastPath
+	{
+	public:
+		static void setThreshold(size_t particle_threshold) { particle_threshold_ = particle_threshold; };
+		static size_t Threshold() { return particle_threshold_; };
+
+	private:
+		static size_t particle_threshold_;
+	};
+
+	/**
+	 * @class DeterministicReduce
+	 * @brief Switch the parallel reduce iterators from the non-deterministic
+	 * combine order of the work stealing scheduler to a tree combine over
+	 * fixed block boundaries: the particle range is cut into blocks of a
+	 * fixed size independent of the number of threads, the blocks are
+	 * reduced in parallel and their results are combined in block order.
+	 * The floating point result is then bitwise identical from run to run.
+	 */
+	class DeterministicReduce
+	{
+	public:
+		static void switchOn() { deterministic_reduce_enabled_ = true; };
+		static void switchOff() { deterministic_reduce_enabled_ = false; };
+		static bool Enabled() { return deterministic_reduce_enabled_; };
+		static void setBlockSize(size_t block_size) { block_size_ = block_size; };
+		static size_t BlockSize() { return block_size_; };
+
+	private:
+		static bool deterministic_reduce_enabled_;
+		static size_t block_size_;
+	};
+
 	/** Functor for operation on particles. */
 	typedef std::function<void(size_t, Real)> ParticleFunctor;
 	/** Functors for reducing operation on particles. */
@@ -55,6 +123,102 @@ namespace SPH
 	void ParticleIterator(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt = 0.0);
 	/** Iterators for particle functors. parallel computing. */
 	void ParticleIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors. parallel computing with the grain size
+	 * and the serial-execution decision taken from the given loop tuner. */
+	void ParticleIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor,
+								   LoopTuner &loop_tuner, Real dt = 0.0);
+
+	/** Statically dispatched iterators so that the per-particle call
+	 * can be inlined into the loop body. sequential computing. */
+	template <typename LocalDynamicsFunction>
+	void ParticleIterator(size_t total_real_particles, const LocalDynamicsFunction &local_dynamics_function, Real dt = 0.0)
+	{
+		for (size_t i = 0; i < total_real_particles; ++i)
+			local_dynamics_function(i, dt);
+	}
+	/** Statically dispatched iterators so that the per-particle call
+	 * can be inlined into the loop body. parallel computing. */
+	template <typename LocalDynamicsFunction>
+	void ParticleIterator_parallel(size_t total_real_particles, const LocalDynamicsFunction &local_dynamics_function, Real dt = 0.0)
+	{
+		if (total_real_particles <= SmallBodySerialFastPath::Threshold())
+		{
+			ParticleIterator(total_real_particles, local_dynamics_function, dt);
+			return;
+		}
+
+		particleExecutionArena().execute(
+			[&]
+			{
+				if (StaticParticlePartition::Enabled())
+				{
+					parallel_for(
+						blocked_range<size_t>(0, total_real_particles),
+						[&](const blocked_range<size_t> &r)
+						{
+							for (size_t i = r.begin(); i < r.end(); ++i)
+							{
+								local_dynamics_function(i, dt);
+							}
+						},
+						static_ap);
+					return;
+				}
+
+				parallel_for(
+					blocked_range<size_t>(0, total_real_particles),
+					[&](const blocked_range<size_t> &r)
+					{
+						for (size_t i = r.begin(); i < r.end(); ++i)
+						{
+							local_dynamics_function(i, dt);
+						}
+					},
+					ap);
+			});
+	}
+	/** Statically dispatched iterators with the grain size and the
+	 * serial-execution decision taken from the given loop tuner. The tuner
+	 * measures the default parallel path until its decision is locked in. */
+	template <typename LocalDynamicsFunction>
+	void ParticleIterator_parallel(size_t total_real_particles, const LocalDynamicsFunction &local_dynamics_function,
+								   LoopTuner &loop_tuner, Real dt = 0.0)
+	{
+		if (!LoopTuning::Enabled())
+		{
+			ParticleIterator_parallel(total_real_particles, local_dynamics_function, dt);
+			return;
+		}
+
+		if (!loop_tuner.Tuned())
+		{
+			tick_count start_time = tick_count::now();
+			ParticleIterator_parallel(total_real_particles, local_dynamics_function, dt);
+			loop_tuner.recordSample(total_real_particles, (tick_count::now() - start_time).seconds());
+			return;
+		}
+
+		if (loop_tuner.SerialPreferred())
+		{
+			ParticleIterator(total_real_particles, local_dynamics_function, dt);
+			return;
+		}
+
+		particleExecutionArena().execute(
+			[&]
+			{
+				parallel_for(
+					blocked_range<size_t>(0, total_real_particles, loop_tuner.GrainSize()),
+					[&](const blocked_range<size_t> &r)
+					{
+						for (size_t i = r.begin(); i < r.end(); ++i)
+						{
+							local_dynamics_function(i, dt);
+						}
+					},
+					ap);
+			});
+	}
 
 	/** Iterators for reduce functors. sequential computing. */
 	template <class ReturnType, typename ReduceOperation>
@@ -72,11 +236,51 @@ namespace SPH
 	void ParticleIteratorSplittingSweep_parallel(SplitCellLists &split_cell_lists,
 												 const ParticleFunctor &particle_functor, Real dt = 0.0);
 
-	/** A Functor for Summation */
+	/** Splitting sweep over the flat per-level index ranges, which streams one
+	 * cell-contiguous index array instead of chasing cell pointers. sequential computing. */
+	void ParticleIteratorSplittingSweep(SplitCellIndexRanges &split_cell_index_ranges,
+										const ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Splitting sweep over the flat per-level index ranges. parallel computing. */
+	void ParticleIteratorSplittingSweep_parallel(SplitCellIndexRanges &split_cell_index_ranges,
+												 const ParticleFunctor &particle_functor, Real dt = 0.0);
+
+	/** Single sweep over the split cell levels, visiting each particle once
+	 * with the full time step. Cells of the same level are farther apart than
+	 * the cell spacing, so scattered writes to neighbors are race free.
+	 * sequential computing. */
+	void ParticleIteratorColoredSweep(SplitCellLists &split_cell_lists,
+									  const ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Single sweep over the split cell levels. parallel computing. */
+	void ParticleIteratorColoredSweep_parallel(SplitCellLists &split_cell_lists,
+											   const ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Single sweep over the flat per-level index ranges. sequential computing. */
+	void ParticleIteratorColoredSweep(SplitCellIndexRanges &split_cell_index_ranges,
+									  const ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Single sweep over the flat per-level index ranges. parallel computing. */
+	void ParticleIteratorColoredSweep_parallel(SplitCellIndexRanges &split_cell_index_ranges,
+											   const ParticleFunctor &particle_functor, Real dt = 0.0);
+
+	/** Accumulation type for reduce iterators. Scalar sums are carried out
+	 * in double precision also for the single-precision build,
+	 * where accumulation error matters. */
+	template <class ReturnType>
+	struct ReduceAccumulation
+	{
+		using Type = ReturnType;
+	};
+	template <>
+	struct ReduceAccumulation<float>
+	{
+		using Type = double;
+	};
+
+	/** A Functor for Summation,
+	 * generic in the first argument so that a higher precision accumulator is kept. */
 	template <class ReturnType>
 	struct ReduceSum
 	{
-		ReturnType operator()(const ReturnType &x, const ReturnType &y) const { return x + y; };
+		template <class AccumulationType, class ValueType>
+		AccumulationType operator()(const AccumulationType &x, const ValueType &y) const { return x + y; };
 	};
 	/** A Functor for Maximum */
 	struct ReduceMax
@@ -121,6 +325,135 @@ namespace SPH
 		};
 	};
 
+	/** Statically dispatched reduce iterators so that the per-particle
+	 * reduce function can be inlined into the loop body. sequential computing. */
+	template <class ReturnType, typename ReduceOperation, typename LocalReduceFunction>
+	ReturnType ReduceIterator(size_t total_real_particles, ReturnType temp,
+							  const LocalReduceFunction &local_reduce_function,
+							  ReduceOperation &reduce_operation, Real dt = 0.0)
+	{
+		typename ReduceAccumulation<ReturnType>::Type accumulation = temp;
+		for (size_t i = 0; i < total_real_particles; ++i)
+		{
+			accumulation = reduce_operation(accumulation, local_reduce_function(i, dt));
+		}
+		return ReturnType(accumulation);
+	}
+	/** Statically dispatched reduce iterators so that the per-particle
+	 * reduce function can be inlined into the loop body. parallel computing.
+	 * When the deterministic mode is switched on, the combine follows
+	 * fixed block boundaries and the result is reproducible from run to run. */
+	template <class ReturnType, typename ReduceOperation, typename LocalReduceFunction>
+	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
+									   const LocalReduceFunction &local_reduce_function,
+									   ReduceOperation &reduce_operation, Real dt = 0.0)
+	{
+		if (total_real_particles <= SmallBodySerialFastPath::Threshold())
+			return ReduceIterator(total_real_particles, temp, local_reduce_function, reduce_operation, dt);
+
+		using AccumulationType = typename ReduceAccumulation<ReturnType>::Type;
+
+		if (DeterministicReduce::Enabled())
+		{
+			size_t block_size = DeterministicReduce::BlockSize();
+			size_t number_of_blocks = (total_real_particles + block_size - 1) / block_size;
+			StdVec<AccumulationType> block_results(number_of_blocks, AccumulationType(temp));
+			particleExecutionArena().execute(
+				[&]
+				{
+					parallel_for(
+						blocked_range<size_t>(0, number_of_blocks),
+						[&](const blocked_range<size_t> &r)
+						{
+							for (size_t block = r.begin(); block != r.end(); ++block)
+							{
+								AccumulationType temp0(temp);
+								size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+								for (size_t i = block * block_size; i != block_end; ++i)
+								{
+									temp0 = reduce_operation(temp0, local_reduce_function(i, dt));
+								}
+								block_results[block] = temp0;
+							}
+						},
+						ap);
+				});
+			AccumulationType accumulation(temp);
+			for (size_t block = 0; block != number_of_blocks; ++block)
+			{
+				accumulation = reduce_operation(accumulation, block_results[block]);
+			}
+			return ReturnType(accumulation);
+		}
+
+		AccumulationType accumulation(temp);
+		particleExecutionArena().execute(
+			[&]
+			{
+				accumulation = parallel_reduce(
+					blocked_range<size_t>(0, total_real_particles),
+					AccumulationType(temp), [&](const blocked_range<size_t> &r, AccumulationType temp0) -> AccumulationType
+					{
+						for (size_t i = r.begin(); i != r.end(); ++i)
+						{
+							temp0 = reduce_operation(temp0, local_reduce_function(i, dt));
+						}
+						return temp0;
+					},
+					[&](AccumulationType x, AccumulationType y) -> AccumulationType
+					{
+						return reduce_operation(x, y);
+					});
+			});
+		return ReturnType(accumulation);
+	}
+	/** Statically dispatched reduce iterators with the grain size and the
+	 * serial-execution decision taken from the given loop tuner. The tuner
+	 * measures the default parallel path until its decision is locked in.
+	 * The deterministic mode takes precedence over the tuning, since its
+	 * fixed block boundaries already imply the grain. */
+	template <class ReturnType, typename ReduceOperation, typename LocalReduceFunction>
+	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
+									   const LocalReduceFunction &local_reduce_function,
+									   ReduceOperation &reduce_operation, LoopTuner &loop_tuner, Real dt = 0.0)
+	{
+		if (!LoopTuning::Enabled() || DeterministicReduce::Enabled())
+			return ReduceIterator_parallel(total_real_particles, temp, local_reduce_function, reduce_operation, dt);
+
+		if (!loop_tuner.Tuned())
+		{
+			tick_count start_time = tick_count::now();
+			ReturnType result = ReduceIterator_parallel(total_real_particles, temp, local_reduce_function, reduce_operation, dt);
+			loop_tuner.recordSample(total_real_particles, (tick_count::now() - start_time).seconds());
+			return result;
+		}
+
+		if (loop_tuner.SerialPreferred())
+			return ReduceIterator(total_real_particles, temp, local_reduce_function, reduce_operation, dt);
+
+		using AccumulationType = typename ReduceAccumulation<ReturnType>::Type;
+		AccumulationType accumulation(temp);
+		particleExecutionArena().execute(
+			[&]
+			{
+				accumulation = parallel_reduce(
+					blocked_range<size_t>(0, total_real_particles, loop_tuner.GrainSize()),
+					AccumulationType(temp), [&](const blocked_range<size_t> &r, AccumulationType temp0) -> AccumulationType
+					{
+						for (size_t i = r.begin(); i != r.end(); ++i)
+						{
+							temp0 = reduce_operation(temp0, local_reduce_function(i, dt));
+						}
+						return temp0;
+					},
+					[&](AccumulationType x, AccumulationType y) -> AccumulationType
+					{
+						return reduce_operation(x, y);
+					});
+			});
+		return ReturnType(accumulation);
+	}
+
 	/**
 	 * @class GlobalStaticVariables
 	 * @brief A place to put all global variables
@@ -135,6 +468,114 @@ namespace SPH
 		static Real physical_time_;
 	};
 
+	/**
+	 * @class ParticleDynamicsTiming
+	 * @brief Accumulated wall-clock timing record of one particle dynamics
+	 * instance, collected in a global registry for the summary report.
+	 * The timing surface is switched off by default and then costs nothing
+	 * in the execution of the dynamics.
+	 */
+	class ParticleDynamicsTiming
+	{
+	public:
+		std::string name_;			  /**< demangled type name of the dynamics */
+		size_t call_count_;			  /**< number of executions */
+		size_t particles_processed_;  /**< total real particles over all executions */
+		double accumulated_seconds_;  /**< accumulated wall time of all executions */
+
+		ParticleDynamicsTiming()
+			: call_count_(0), particles_processed_(0), accumulated_seconds_(0.0){};
+
+		/** accumulate one execution, registering this record at the first call */
+		void record(const std::type_info &dynamics_type, double seconds, size_t particles);
+
+		static void switchOn() { timing_enabled_ = true; };
+		static void switchOff() { timing_enabled_ = false; };
+		static bool Enabled() { return timing_enabled_; };
+		/** the global registry of all records which have accumulated executions */
+		static StdVec<ParticleDynamicsTiming *> &RegisteredTimings();
+
+	private:
+		static bool timing_enabled_;
+	};
+
+	/**
+	 * @class TraceEventRecording
+	 * @brief Timeline recording of the instrumented execution scopes:
+	 * dynamics executions, configuration updates and state output.
+	 * Each scope is stored as one complete event with its wall-clock begin
+	 * and duration, collected per thread and exported in the chrome://tracing
+	 * JSON format, so that the overlap and the stalls between the phases,
+	 * e.g. between the I/O thread and the solver, can be inspected on a
+	 * timeline. The recording is switched off by default and then costs
+	 * nothing in the instrumented scopes.
+	 */
+	class TraceEventRecording
+	{
+	public:
+		struct TraceEvent
+		{
+			const std::type_info *scope_type_; /**< type of the instrumented scope, demangled at the export */
+			std::string name_;				   /**< scope name, appended to the type name when both are given */
+			const char *category_;
+			double start_seconds_;
+			double duration_seconds_;
+		};
+
+		/** start the recording, timing all events from this call */
+		static void switchOn();
+		static void switchOff() { recording_enabled_ = false; };
+		static bool Enabled() { return recording_enabled_; };
+
+		/** append one complete event spanning the given ticks */
+		static void recordEvent(const std::type_info *scope_type, const std::string &name,
+								const char *category, const tick_count &start_time,
+								const tick_count &end_time);
+		/** write all recorded events in the chrome://tracing JSON format
+		 * and clear the recording */
+		static void writeToJsonFile(const std::string &filefullpath);
+
+	private:
+		static bool recording_enabled_;
+		static tick_count session_start_;
+		/** per-thread event buffers, merged at the export */
+		static tbb::enumerable_thread_specific<StdVec<TraceEvent>> &ThreadEvents();
+	};
+
+	/**
+	 * @class TraceEventScope
+	 * @brief A helper recording one complete trace event spanning its own
+	 * lifetime, placed at the top of an instrumented scope.
+	 */
+	class TraceEventScope
+	{
+	public:
+		TraceEventScope(const std::type_info &scope_type, const char *category,
+						const std::string &name = "")
+			: scope_type_(&scope_type), category_(category),
+			  enabled_(TraceEventRecording::Enabled())
+		{
+			if (enabled_)
+			{
+				name_ = name;
+				start_time_ = tick_count::now();
+			}
+		};
+		~TraceEventScope()
+		{
+			if (enabled_)
+				TraceEventRecording::recordEvent(scope_type_, name_, category_,
+												 start_time_, tick_count::now());
+		};
+
+	private:
+		const std::type_info *scope_type_;
+		const char *category_;
+		bool enabled_; /**< whether the recording was on when the scope was entered */
+		std::string name_;
+		tick_count start_time_;
+	};
+
 	/**
 	* @class ParticleDynamics
 	* @brief The base class for all particle dynamics
@@ -158,10 +599,35 @@ namespace SPH
 		SPHBody *sph_body_;
 		SPHAdaptation *sph_adaptation_;
 		BaseParticles *base_particles_;
+		ParticleDynamicsTiming timing_; /**< accumulated wall-clock timing of this instance */
+		LoopTuner loop_tuner_;			/**< auto-tuned grain size of the main particle loop */
 
 		void setBodyUpdated() { sph_body_->setNewlyUpdated(); };
 		/** the function for set global parameters for the particle dynamics */
 		virtual void setupDynamics(Real dt = 0.0){};
+		/** key the given loop tuner, by the dynamics type and the loop name,
+		 * for the persistence of its tuned decision */
+		LoopTuner &keyedLoopTuner(LoopTuner &loop_tuner, const char *loop_name, size_t loop_size)
+		{
+			if (LoopTuning::Enabled() && !loop_tuner.Keyed())
+				loop_tuner.assignPersistenceKey(typeid(*this), loop_name, loop_size);
+			return loop_tuner;
+		};
+		/** accumulate the timing and the trace event of one execution
+		 * when the respective recording surface is switched on */
+		void recordExecutionTiming(const tick_count &start_time)
+		{
+			if (ParticleDynamicsTiming::Enabled() || TraceEventRecording::Enabled())
+			{
+				tick_count end_time = tick_count::now();
+				if (ParticleDynamicsTiming::Enabled())
+					timing_.record(typeid(*this), (end_time - start_time).seconds(),
+								   base_particles_->total_real_particles_);
+				if (TraceEventRecording::Enabled())
+					TraceEventRecording::recordEvent(&typeid(*this), "", "dynamics",
+													 start_time, end_time);
+			}
+		};
 	};
 
 	/**
@@ -218,12 +684,19 @@ namespace SPH
 	public:
 		explicit DataDelegateInner(BaseBodyRelationInner &body_inner_relation)
 			: BaseDataDelegateType(*body_inner_relation.sph_body_),
-			  inner_configuration_(body_inner_relation.inner_configuration_){};
+			  inner_configuration_(body_inner_relation.inner_configuration_),
+			  compact_inner_configuration_(body_inner_relation.compact_inner_configuration_),
+			  inner_relation_(&body_inner_relation){};
 		virtual ~DataDelegateInner(){};
 
 	protected:
 		/** inner configuration of the designated body */
 		ParticleConfiguration &inner_configuration_;
+		/** views into the compressed-sparse-row storage of the inner configuration,
+		 * only valid when the relation maintains the compact storage. */
+		CompactParticleConfiguration &compact_inner_configuration_;
+		/** the relation providing the inner configuration. */
+		BaseBodyRelationInner *inner_relation_;
 	};
 
 	/**
@@ -43,31 +43,50 @@ namespace SPH
 	ReturnType ReduceIterator(size_t total_real_particles, ReturnType temp,
 							  ReduceFunctor<ReturnType> &reduce_functor, ReduceOperation &reduce_operation, Real dt)
 	{
+		typename ReduceAccumulation<ReturnType>::Type accumulation = temp;
 		for (size_t i = 0; i < total_real_particles; ++i)
 		{
-			temp = reduce_operation(temp, reduce_functor(i, dt));
+			accumulation = reduce_operation(accumulation, reduce_functor(i, dt));
 		}
-		return temp;
+		return ReturnType(accumulation);
 	}
 	//=================================================================================================//
 	template <class ReturnType, typename ReduceOperation>
 	ReturnType ReduceIterator_parallel(size_t total_real_particles, ReturnType temp,
 									   ReduceFunctor<ReturnType> &reduce_functor, ReduceOperation &reduce_operation, Real dt)
 	{
-		return parallel_reduce(
-			blocked_range<size_t>(0, total_real_particles),
-			temp, [&](const blocked_range<size_t> &r, ReturnType temp0) -> ReturnType
-			{
-				for (size_t i = r.begin(); i != r.end(); ++i)
-				{
-					temp0 = reduce_operation(temp0, reduce_functor(i, dt));
-				}
-				return temp0;
-			},
-			[&](ReturnType x, ReturnType y) -> ReturnType
+		if (total_real_particles <= SmallBodySerialFastPath::Threshold())
+			return ReduceIterator(total_real_particles, temp, reduce_functor, reduce_operation, dt);
+
+		// delegate to the fixed-block tree combine for run-to-run reproducibility
+		if (DeterministicReduce::Enabled())
+			return ReduceIterator_parallel(
+				total_real_particles, temp,
+				[&](size_t i, Real dt_i)
+				{ return reduce_functor(i, dt_i); },
+				reduce_operation, dt);
+
+		using AccumulationType = typename ReduceAccumulation<ReturnType>::Type;
+		AccumulationType accumulation(temp);
+		particleExecutionArena().execute(
+			[&]
 			{
-				return reduce_operation(x, y);
+				accumulation = parallel_reduce(
+					blocked_range<size_t>(0, total_real_particles),
+					AccumulationType(temp), [&](const blocked_range<size_t> &r, AccumulationType temp0) -> AccumulationType
+					{
+						for (size_t i = r.begin(); i != r.end(); ++i)
+						{
+							temp0 = reduce_operation(temp0, reduce_functor(i, dt));
+						}
+						return temp0;
+					},
+					[&](AccumulationType x, AccumulationType y) -> AccumulationType
+					{
+						return reduce_operation(x, y);
+					});
 			});
+		return ReturnType(accumulation);
 	}
 	//=================================================================================================//
 	template <class ParticleDynamicsInnerType, class ContactDataType>
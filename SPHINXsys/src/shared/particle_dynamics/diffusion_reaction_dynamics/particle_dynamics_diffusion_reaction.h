@@ -109,8 +109,12 @@ namespace SPH
 		StdVec<StdLargeVec<Real>> &species_n_;
 		StdVec<StdLargeVec<Real>> &diffusion_dt_;
 		StdLargeVec<Real> &Vol_;
+		/** whether the neighbor species values are read from the blocked mirror */
+		bool use_blocked_species_;
 
 	protected:
+		/** refresh the blocked species mirror when the particles use it */
+		virtual void setupDynamics(Real dt = 0.0) override;
 		void initializeDiffusionChangeRate(size_t particle_i);
 		void getDiffusionChangeRate(size_t particle_i, size_t particle_j, Vecd &e_ij, Real surface_area_ij);
 		virtual void updateSpeciesDiffusion(size_t particle_i, Real dt);
@@ -223,6 +227,44 @@ namespace SPH
 		virtual void parallel_exec(Real dt = 0.0) override;
 	};
 
+	/**
+	 * @class RelaxationOfAllDiffusionSpeciesImplicit
+	 * @brief Diffusion relaxation of all species by a backward-Euler step
+	 * solved with a matrix-free conjugate gradient over the inner-relation
+	 * neighborhoods. The step size is then not limited by the diffusion
+	 * stability criterion and can follow the reaction time scale instead.
+	 */
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	class RelaxationOfAllDiffusionSpeciesImplicit
+		: public ParticleDynamics<void>,
+		  public DiffusionReactionInnerData<BodyType, BaseParticlesType, BaseMaterialType>
+	{
+		StdVec<BaseDiffusion *> species_diffusion_;
+		StdVec<StdLargeVec<Real>> &species_n_;
+		StdLargeVec<Real> &Vol_;
+
+		/** work vectors of the conjugate gradient iteration */
+		StdLargeVec<Real> solution_, residual_, search_direction_, operator_product_;
+
+		/** apply (I - dt * L) to input, with L the discrete diffusion operator */
+		void applyImplicitOperator(size_t m, Real dt, const StdLargeVec<Real> &input, StdLargeVec<Real> &output);
+		Real dotProduct(const StdLargeVec<Real> &vector_a, const StdLargeVec<Real> &vector_b);
+		void solveImplicitDiffusion(size_t m, Real dt);
+
+	protected:
+		size_t max_iterations_;
+		Real relative_residual_tolerance_;
+
+	public:
+		explicit RelaxationOfAllDiffusionSpeciesImplicit(BaseBodyRelationInner &inner_relation,
+														 size_t max_iterations = 100,
+														 Real relative_residual_tolerance = 1.0e-6);
+		virtual ~RelaxationOfAllDiffusionSpeciesImplicit(){};
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override { exec(dt); };
+	};
+
 	struct UpdateAReactionSpecies
 	{
 		Real operator()(Real input, Real production_rate, Real loss_rate, Real dt) const
@@ -34,12 +34,22 @@ namespace SPH
 		: InteractionDynamicsWithUpdate(*inner_relation.sph_body_),
 		  DiffusionReactionInnerData<BodyType, BaseParticlesType, BaseMaterialType>(inner_relation),
 		  species_n_(this->particles_->species_n_),
-		  diffusion_dt_(this->particles_->diffusion_dt_), Vol_(this->particles_->Vol_)
+		  diffusion_dt_(this->particles_->diffusion_dt_), Vol_(this->particles_->Vol_),
+		  use_blocked_species_(false)
 	{
 		species_diffusion_ = this->material_->SpeciesDiffusion();
 	}
 	//=================================================================================================//
 	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	void RelaxationOfAllDiffussionSpeciesInner<BodyType, BaseParticlesType, BaseMaterialType>::
+		setupDynamics(Real dt)
+	{
+		use_blocked_species_ = this->particles_->usingBlockedSpeciesLayout();
+		if (use_blocked_species_)
+			this->particles_->gatherBlockedSpecies();
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
 	void RelaxationOfAllDiffussionSpeciesInner<BodyType, BaseParticlesType, BaseMaterialType>::
 		initializeDiffusionChangeRate(size_t particle_i)
 	{
@@ -57,7 +67,11 @@ namespace SPH
 		{
 			Real diff_coff_ij = species_diffusion_[m]->getInterParticleDiffusionCoff(particle_i, particle_j, e_ij);
 			size_t l = species_diffusion_[m]->gradient_species_index_;
-			Real phi_ij = species_n_[l][particle_i] - species_n_[l][particle_j];
+			// the blocked mirror keeps all species of the neighbor in one cache line
+			Real species_j = use_blocked_species_
+								 ? this->particles_->BlockedSpeciesValue(l, particle_j)
+								 : species_n_[l][particle_j];
+			Real phi_ij = species_n_[l][particle_i] - species_j;
 			diffusion_dt_[m][particle_i] += diff_coff_ij * phi_ij * surface_area_ij;
 		}
 	}
@@ -254,6 +268,154 @@ namespace SPH
 	}
 	//=================================================================================================//
 	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	RelaxationOfAllDiffusionSpeciesImplicit<BodyType, BaseParticlesType, BaseMaterialType>::
+		RelaxationOfAllDiffusionSpeciesImplicit(BaseBodyRelationInner &inner_relation,
+												size_t max_iterations, Real relative_residual_tolerance)
+		: ParticleDynamics<void>(*inner_relation.sph_body_),
+		  DiffusionReactionInnerData<BodyType, BaseParticlesType, BaseMaterialType>(inner_relation),
+		  species_n_(this->particles_->species_n_), Vol_(this->particles_->Vol_),
+		  max_iterations_(max_iterations), relative_residual_tolerance_(relative_residual_tolerance)
+	{
+		species_diffusion_ = this->material_->SpeciesDiffusion();
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	void RelaxationOfAllDiffusionSpeciesImplicit<BodyType, BaseParticlesType, BaseMaterialType>::
+		applyImplicitOperator(size_t m, Real dt, const StdLargeVec<Real> &input, StdLargeVec<Real> &output)
+	{
+		DiffusionReactionParticles<BaseParticlesType> *particles = this->particles_;
+		parallel_for(
+			blocked_range<size_t>(0, particles->total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					Real change_rate = 0.0;
+					Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+					for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+					{
+						size_t index_j = inner_neighborhood.j_[n];
+						Real dW_ij_ = inner_neighborhood.dW_ij_[n];
+						Real r_ij_ = inner_neighborhood.r_ij_[n];
+						Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+						const Vecd &grad_ij = particles->getKernelGradient(index_i, index_j, dW_ij_, e_ij);
+						Real area_ij = 2.0 * Vol_[index_j] * dot(grad_ij, e_ij) / r_ij_;
+						Real diff_coff_ij =
+							species_diffusion_[m]->getInterParticleDiffusionCoff(index_i, index_j, e_ij);
+						change_rate += diff_coff_ij * (input[index_i] - input[index_j]) * area_ij;
+					}
+					output[index_i] = input[index_i] - dt * change_rate;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	Real RelaxationOfAllDiffusionSpeciesImplicit<BodyType, BaseParticlesType, BaseMaterialType>::
+		dotProduct(const StdLargeVec<Real> &vector_a, const StdLargeVec<Real> &vector_b)
+	{
+		return parallel_reduce(
+			blocked_range<size_t>(0, this->particles_->total_real_particles_), Real(0),
+			[&](const blocked_range<size_t> &r, Real sum) -> Real
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					sum += vector_a[i] * vector_b[i];
+				return sum;
+			},
+			[](Real x, Real y) -> Real
+			{ return x + y; });
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	void RelaxationOfAllDiffusionSpeciesImplicit<BodyType, BaseParticlesType, BaseMaterialType>::
+		solveImplicitDiffusion(size_t m, Real dt)
+	{
+		size_t k = species_diffusion_[m]->diffusion_species_index_;
+		StdLargeVec<Real> &phi_n = species_n_[k];
+		size_t total_real_particles = this->particles_->total_real_particles_;
+
+		solution_.resize(total_real_particles);
+		residual_.resize(total_real_particles);
+		search_direction_.resize(total_real_particles);
+		operator_product_.resize(total_real_particles);
+
+		// the explicit value is the initial guess
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					solution_[i] = phi_n[i];
+			},
+			ap);
+		applyImplicitOperator(m, dt, solution_, operator_product_);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					residual_[i] = phi_n[i] - operator_product_[i];
+					search_direction_[i] = residual_[i];
+				}
+			},
+			ap);
+
+		Real residual_norm_squared = dotProduct(residual_, residual_);
+		Real converged_norm_squared =
+			relative_residual_tolerance_ * relative_residual_tolerance_ *
+			(dotProduct(phi_n, phi_n) + TinyReal);
+		size_t iteration = 0;
+		while (residual_norm_squared > converged_norm_squared && iteration != max_iterations_)
+		{
+			applyImplicitOperator(m, dt, search_direction_, operator_product_);
+			Real alpha = residual_norm_squared /
+						 (dotProduct(search_direction_, operator_product_) + TinyReal);
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						solution_[i] += alpha * search_direction_[i];
+						residual_[i] -= alpha * operator_product_[i];
+					}
+				},
+				ap);
+			Real new_residual_norm_squared = dotProduct(residual_, residual_);
+			Real beta = new_residual_norm_squared / (residual_norm_squared + TinyReal);
+			residual_norm_squared = new_residual_norm_squared;
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						search_direction_[i] = residual_[i] + beta * search_direction_[i];
+				},
+				ap);
+			iteration++;
+		}
+
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					phi_n[i] = solution_[i];
+			},
+			ap);
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
+	void RelaxationOfAllDiffusionSpeciesImplicit<BodyType, BaseParticlesType, BaseMaterialType>::
+		exec(Real dt)
+	{
+		for (size_t m = 0; m < species_diffusion_.size(); ++m)
+			solveImplicitDiffusion(m, dt);
+	}
+	//=================================================================================================//
+	template <class BodyType, class BaseParticlesType, class BaseMaterialType>
 	RelaxationOfAllReactionsForward<BodyType, BaseParticlesType, BaseMaterialType>::
 		RelaxationOfAllReactionsForward(BodyType &body)
 		: ParticleDynamicsSimple(body),
@@ -133,6 +133,35 @@ namespace SPH
 		virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 	};
 
+	/**
+	 * @class DampingCellBlockedInner
+	 * @brief A quantity damping solved cell by cell. The pair system of each
+	 * cell is gathered once into compact local arrays and relaxed to
+	 * convergence, with couplings to particles outside the cell frozen at
+	 * their current values, i.e. a block method with exact cell blocks and
+	 * Jacobi-style coupling across cells. The gathered system stays in cache
+	 * over all inner iterations and tolerates larger damping steps than the
+	 * pair-by-pair sweeps. The sweep over the split cell levels keeps
+	 * concurrently processed cells farther apart than the kernel support,
+	 * so the cell-local updates are race free.
+	 */
+	template <typename VariableType>
+	class DampingCellBlockedInner : public DampingPairwiseInner<VariableType>
+	{
+	public:
+		DampingCellBlockedInner(BaseBodyRelationInner &inner_relation, const std::string &variable_name, Real eta);
+		virtual ~DampingCellBlockedInner(){};
+		void setInnerIterations(size_t inner_iterations) { inner_iterations_ = inner_iterations; };
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+
+	protected:
+		size_t inner_iterations_; /**< relaxation sweeps over each cell-local system */
+
+		void solveCellSystem(CellList *cell_list, Real dt);
+	};
+
 	template <typename VariableType>
 	class DampingPairwiseComplex : public DampingPairwiseInner<VariableType>, public DissipationDataContact
 	{
@@ -211,6 +240,7 @@ namespace SPH
 	{
 	protected:
 		Real random_ratio_;
+		size_t random_sequence_index_; /**< counts the draws so that the choice sequence is reproducible */
 		bool RandomChoice();
 
 	public:
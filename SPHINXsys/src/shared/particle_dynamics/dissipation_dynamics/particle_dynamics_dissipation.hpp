@@ -9,6 +9,8 @@
 
 #include "particle_dynamics_dissipation.h"
 
+#include "cell_linked_list.h"
+
 namespace SPH
 {
 	//=================================================================================================//
@@ -255,6 +257,153 @@ namespace SPH
 	}
 	//=================================================================================================//
 	template <typename VariableType>
+	DampingCellBlockedInner<VariableType>::
+		DampingCellBlockedInner(BaseBodyRelationInner &inner_relation,
+								const std::string &variable_name, Real eta)
+		: DampingPairwiseInner<VariableType>(inner_relation, variable_name, eta),
+		  inner_iterations_(20) {}
+	//=================================================================================================//
+	template <typename VariableType>
+	void DampingCellBlockedInner<VariableType>::solveCellSystem(CellList *cell_list, Real dt)
+	{
+		IndexVector &cell_indexes = cell_list->real_particle_indexes_;
+		size_t local_size = cell_indexes.size();
+		if (local_size == 0)
+			return;
+
+		// gather the implicit system of the cell: for every particle the damping
+		// couplings, where neighbors inside the cell enter by local index and
+		// neighbors outside the cell are frozen at their current values,
+		// which folds them into the constant term of the equation
+		StdVec<VariableType> iterate_values(local_size, VariableType(0));
+		StdVec<VariableType> constant_terms(local_size, VariableType(0));
+		StdVec<Real> diagonals(local_size, 0.0);
+		StdVec<size_t> coupling_offsets(local_size + 1, 0);
+		StdVec<Real> coupling_strengths;
+		StdVec<size_t> coupling_local_indexes;
+		for (size_t a = 0; a != local_size; ++a)
+		{
+			size_t index_i = cell_indexes[a];
+			Real Vol_i = this->Vol_[index_i];
+			iterate_values[a] = this->variable_[index_i];
+			constant_terms[a] = this->mass_[index_i] * this->variable_[index_i];
+			diagonals[a] = this->mass_[index_i];
+			Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				// the kernel derivative is negative, so the coupling is positive
+				Real coupling = -this->eta_ * inner_neighborhood.dW_ij_[n] *
+								Vol_i * this->Vol_[index_j] * dt / inner_neighborhood.r_ij_[n];
+				diagonals[a] += coupling;
+
+				size_t local_j = MaxSize_t;
+				for (size_t b = 0; b != local_size; ++b)
+					if (cell_indexes[b] == index_j)
+					{
+						local_j = b;
+						break;
+					}
+				if (local_j != MaxSize_t)
+				{
+					coupling_strengths.push_back(coupling);
+					coupling_local_indexes.push_back(local_j);
+				}
+				else
+				{
+					constant_terms[a] += coupling * this->variable_[index_j];
+				}
+			}
+			coupling_offsets[a + 1] = coupling_strengths.size();
+		}
+
+		// the system is strictly diagonally dominant, so the relaxation sweeps
+		// converge to the exact cell-local implicit solution
+		for (size_t sweep = 0; sweep != inner_iterations_; ++sweep)
+			for (size_t a = 0; a != local_size; ++a)
+			{
+				VariableType numerator = constant_terms[a];
+				for (size_t c = coupling_offsets[a]; c != coupling_offsets[a + 1]; ++c)
+					numerator += coupling_strengths[c] * iterate_values[coupling_local_indexes[c]];
+				iterate_values[a] = numerator / diagonals[a];
+			}
+
+		for (size_t a = 0; a != local_size; ++a)
+			this->variable_[cell_indexes[a]] = iterate_values[a];
+	}
+	//=================================================================================================//
+	template <typename VariableType>
+	void DampingCellBlockedInner<VariableType>::exec(Real dt)
+	{
+		tick_count start_time = tick_count::now();
+		this->setBodyUpdated();
+		this->setupDynamics(dt);
+		for (size_t k = 0; k < this->pre_processes_.size(); ++k)
+			this->pre_processes_[k]->exec(dt);
+		Real dt2 = dt * 0.5;
+		// forward sweeping
+		for (size_t k = 0; k != this->split_cell_lists_.size(); ++k)
+		{
+			ConcurrentCellLists &cell_lists = this->split_cell_lists_[k];
+			for (size_t l = 0; l != cell_lists.size(); ++l)
+				solveCellSystem(cell_lists[l], dt2);
+		}
+		// backward sweeping
+		for (size_t k = this->split_cell_lists_.size(); k != 0; --k)
+		{
+			ConcurrentCellLists &cell_lists = this->split_cell_lists_[k - 1];
+			for (size_t l = cell_lists.size(); l != 0; --l)
+				solveCellSystem(cell_lists[l - 1], dt2);
+		}
+		for (size_t k = 0; k < this->post_processes_.size(); ++k)
+			this->post_processes_[k]->exec(dt);
+		this->recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	template <typename VariableType>
+	void DampingCellBlockedInner<VariableType>::parallel_exec(Real dt)
+	{
+		tick_count start_time = tick_count::now();
+		this->setBodyUpdated();
+		this->setupDynamics(dt);
+		for (size_t k = 0; k < this->pre_processes_.size(); ++k)
+			this->pre_processes_[k]->parallel_exec(dt);
+		Real dt2 = dt * 0.5;
+		// the cells of one split level are farther apart than the kernel
+		// support, so their local systems neither write nor read each other
+		// and the levels can be relaxed cell-parallel
+		// forward sweeping
+		for (size_t k = 0; k != this->split_cell_lists_.size(); ++k)
+		{
+			ConcurrentCellLists &cell_lists = this->split_cell_lists_[k];
+			parallel_for(
+				blocked_range<size_t>(0, cell_lists.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t l = r.begin(); l != r.end(); ++l)
+						solveCellSystem(cell_lists[l], dt2);
+				},
+				ap);
+		}
+		// backward sweeping
+		for (size_t k = this->split_cell_lists_.size(); k != 0; --k)
+		{
+			ConcurrentCellLists &cell_lists = this->split_cell_lists_[k - 1];
+			parallel_for(
+				blocked_range<size_t>(0, cell_lists.size()),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t l = r.begin(); l != r.end(); ++l)
+						solveCellSystem(cell_lists[l], dt2);
+				},
+				ap);
+		}
+		for (size_t k = 0; k < this->post_processes_.size(); ++k)
+			this->post_processes_[k]->parallel_exec(dt);
+		this->recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	template <typename VariableType>
 	DampingPairwiseComplex<VariableType>::DampingPairwiseComplex(BaseBodyRelationInner &inner_relation,
 																 BaseBodyRelationContact &contact_relation, const std::string &variable_name, Real eta)
 		: DampingPairwiseInner<VariableType>(inner_relation, variable_name, eta),
@@ -437,7 +586,8 @@ namespace SPH
 	template <typename... ConstructorArgs>
 	DampingWithRandomChoice<DampingAlgorithmType>::
 		DampingWithRandomChoice(Real random_ratio, ConstructorArgs &&...args)
-		: DampingAlgorithmType(std::forward<ConstructorArgs>(args)...), random_ratio_(random_ratio) 
+		: DampingAlgorithmType(std::forward<ConstructorArgs>(args)...), random_ratio_(random_ratio),
+		  random_sequence_index_(0)
 	{
 		this->eta_ /= random_ratio;
 	}
@@ -445,7 +595,14 @@ namespace SPH
 	template <class DampingAlgorithmType>
 	bool DampingWithRandomChoice<DampingAlgorithmType>::RandomChoice()
 	{
-		return ((double)rand() / (RAND_MAX)) < random_ratio_ ? true : false;
+		// counter-based random number obtained by hashing the draw counter,
+		// which decouples the choice sequence from the shared library random state
+		// so that the same sequence is reproduced in every run
+		uint64_t state = uint64_t(random_sequence_index_++) + 0x9e3779b97f4a7c15ULL;
+		state = (state ^ (state >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		state = (state ^ (state >> 27)) * 0x94d049bb133111ebULL;
+		state = state ^ (state >> 31);
+		return (double)(state >> 11) / (double)(1ULL << 53) < random_ratio_ ? true : false;
 	}
 	//=================================================================================================//
 	template <class DampingAlgorithmType>
@@ -26,47 +26,37 @@ namespace SPH
 	Real ElectroPhysiologyReaction::
 		getProductionActiveContractionStress(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real voltage_dim = species[voltage_][particle_i] * 100.0 - 80.0;
-		Real factor = 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
-		return factor * k_a_ * (voltage_dim + 80.0);
+		return ProductionRateActiveContractionStress(species[voltage_][particle_i]);
 	}
 	//=================================================================================================//
 	Real ElectroPhysiologyReaction::
 		getLossRateActiveContractionStress(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real voltage_dim = species[voltage_][particle_i] * 100.0 - 80.0;
-		return 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
+		return LossRateActiveContractionStress(species[voltage_][particle_i]);
 	}
 	//=================================================================================================//
 	Real AlievPanfilowModel::
 		getProductionRateIonicCurrent(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real voltage = species[voltage_][particle_i];
-		return -k_ * voltage * (voltage * voltage - a_ * voltage - voltage) / c_m_;
+		return ProductionRateIonicCurrent(species[voltage_][particle_i]);
 	}
 	//=================================================================================================//
 	Real AlievPanfilowModel::
 		getLossRateIonicCurrent(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real gate_variable = species[gate_variable_][particle_i];
-		return (k_ * a_ + gate_variable) / c_m_;
+		return LossRateIonicCurrent(species[gate_variable_][particle_i]);
 	}
 	//=================================================================================================//
 	Real AlievPanfilowModel::
 		getProductionRateGateVariable(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real voltage = species[voltage_][particle_i];
-		Real gate_variable = species[gate_variable_][particle_i];
-		Real temp = epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
-		return -temp * k_ * voltage * (voltage - b_ - 1.0);
+		return ProductionRateGateVariable(species[voltage_][particle_i], species[gate_variable_][particle_i]);
 	}
 	//=================================================================================================//
 	Real AlievPanfilowModel::
 		getLossRateGateVariable(StdVec<StdLargeVec<Real>> &species, size_t particle_i)
 	{
-		Real voltage = species[voltage_][particle_i];
-		Real gate_variable = species[gate_variable_][particle_i];
-		return epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
+		return LossRateGateVariable(species[voltage_][particle_i], species[gate_variable_][particle_i]);
 	}
 	//=================================================================================================//
 	MonoFieldElectroPhysiology::
@@ -63,6 +63,24 @@ namespace SPH
 		virtual ~ElectroPhysiologyReaction(){};
 
 		void initializeElectroPhysiologyReaction();
+
+		size_t VoltageIndex() { return voltage_; };
+		size_t GateVariableIndex() { return gate_variable_; };
+		size_t ActiveContractionStressIndex() { return active_contraction_stress_; };
+
+		/** rate evaluations from local species values, inlined by the
+		 * compile-time-specialized reaction integration */
+		Real ProductionRateActiveContractionStress(Real voltage) const
+		{
+			Real voltage_dim = voltage * 100.0 - 80.0;
+			Real factor = 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
+			return factor * k_a_ * (voltage_dim + 80.0);
+		};
+		Real LossRateActiveContractionStress(Real voltage) const
+		{
+			Real voltage_dim = voltage * 100.0 - 80.0;
+			return 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
+		};
 	};
 
 	/**
@@ -90,6 +108,26 @@ namespace SPH
 			reaction_model_ = "AlievPanfilowModel";
 		};
 		virtual ~AlievPanfilowModel(){};
+
+		/** rate evaluations from local species values, inlined by the
+		 * compile-time-specialized reaction integration */
+		Real ProductionRateIonicCurrent(Real voltage) const
+		{
+			return -k_ * voltage * (voltage * voltage - a_ * voltage - voltage) / c_m_;
+		};
+		Real LossRateIonicCurrent(Real gate_variable) const
+		{
+			return (k_ * a_ + gate_variable) / c_m_;
+		};
+		Real ProductionRateGateVariable(Real voltage, Real gate_variable) const
+		{
+			Real temp = epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
+			return -temp * k_ * voltage * (voltage - b_ - 1.0);
+		};
+		Real LossRateGateVariable(Real voltage, Real gate_variable) const
+		{
+			return epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
+		};
 	};
 
 	/**
@@ -208,6 +246,20 @@ namespace SPH
 				: RelaxationOfAllDiffusionSpeciesRK2(complex_relation){};
 			virtual ~ElectroPhysiologyDiffusionRelaxationComplex(){};
 		};
+		/**
+		 * @class ElectroPhysiologyDiffusionRelaxationImplicit
+		 * @brief Solve the diffusion of the trans-membrane potential by a
+		 * backward-Euler step with a matrix-free conjugate gradient, so the
+		 * step size is not limited by the diffusion stability criterion.
+		 */
+		class ElectroPhysiologyDiffusionRelaxationImplicit
+			: public RelaxationOfAllDiffusionSpeciesImplicit<RealBody, SolidParticles, Solid>
+		{
+		public:
+			explicit ElectroPhysiologyDiffusionRelaxationImplicit(BaseBodyRelationInner &inner_relation)
+				: RelaxationOfAllDiffusionSpeciesImplicit(inner_relation){};
+			virtual ~ElectroPhysiologyDiffusionRelaxationImplicit(){};
+		};
 		/**
 		 * @class ElectroPhysiologyReactionRelaxationForward
 		 * @brief Solve the reaction ODE equation of trans-membrane potential
@@ -234,6 +286,127 @@ namespace SPH
 				: RelaxationOfAllReactionsBackward<RealBody, SolidParticles, Solid>(real_body){};
 			virtual ~ElectroPhysiologyReactionRelaxationBackward(){};
 		};
+		/**
+		 * @class ElectroPhysiologyReactionRelaxationKnownModel
+		 * @brief Reaction integration with the reaction model resolved at
+		 * compile time. The rate evaluations are inlined into a single sweep
+		 * over particle blocks with all species values kept local, so that
+		 * the compiler can vectorize across the particles instead of calling
+		 * the virtual rate functions per species per particle. The forward
+		 * and the backward splitting sweeps only differ in the species order
+		 * and reproduce the generic relaxation classes exactly.
+		 */
+		template <class ReactionModelType>
+		class ElectroPhysiologyReactionRelaxationKnownModel
+			: public ParticleDynamicsSimple,
+			  public ElectroPhysiologyDataDelegateSimple
+		{
+			ReactionModelType *typed_reaction_model_;
+			StdVec<StdLargeVec<Real>> &species_n_;
+			UpdateAReactionSpecies updateAReactionSpecies;
+
+		protected:
+			bool forward_sweep_;
+
+			void updateRange(size_t range_begin, size_t range_end, Real dt)
+			{
+				ReactionModelType *model = typed_reaction_model_;
+				StdLargeVec<Real> &voltage_n = species_n_[model->VoltageIndex()];
+				StdLargeVec<Real> &gate_variable_n = species_n_[model->GateVariableIndex()];
+				StdLargeVec<Real> &stress_n = species_n_[model->ActiveContractionStressIndex()];
+
+				if (forward_sweep_)
+				{
+					for (size_t i = range_begin; i != range_end; ++i)
+					{
+						Real voltage = voltage_n[i];
+						Real gate_variable = gate_variable_n[i];
+						voltage = updateAReactionSpecies(voltage, model->ProductionRateIonicCurrent(voltage),
+														 model->LossRateIonicCurrent(gate_variable), dt);
+						gate_variable = updateAReactionSpecies(gate_variable,
+															   model->ProductionRateGateVariable(voltage, gate_variable),
+															   model->LossRateGateVariable(voltage, gate_variable), dt);
+						stress_n[i] = updateAReactionSpecies(stress_n[i],
+															 model->ProductionRateActiveContractionStress(voltage),
+															 model->LossRateActiveContractionStress(voltage), dt);
+						voltage_n[i] = voltage;
+						gate_variable_n[i] = gate_variable;
+					}
+				}
+				else
+				{
+					for (size_t i = range_begin; i != range_end; ++i)
+					{
+						Real voltage = voltage_n[i];
+						Real gate_variable = gate_variable_n[i];
+						stress_n[i] = updateAReactionSpecies(stress_n[i],
+															 model->ProductionRateActiveContractionStress(voltage),
+															 model->LossRateActiveContractionStress(voltage), dt);
+						gate_variable = updateAReactionSpecies(gate_variable,
+															   model->ProductionRateGateVariable(voltage, gate_variable),
+															   model->LossRateGateVariable(voltage, gate_variable), dt);
+						voltage = updateAReactionSpecies(voltage, model->ProductionRateIonicCurrent(voltage),
+														 model->LossRateIonicCurrent(gate_variable), dt);
+						voltage_n[i] = voltage;
+						gate_variable_n[i] = gate_variable;
+					}
+				}
+			};
+
+		public:
+			ElectroPhysiologyReactionRelaxationKnownModel(RealBody &real_body, bool forward_sweep)
+				: ParticleDynamicsSimple(real_body),
+				  ElectroPhysiologyDataDelegateSimple(real_body),
+				  species_n_(this->particles_->species_n_), forward_sweep_(forward_sweep)
+			{
+				typed_reaction_model_ =
+					DynamicCast<ReactionModelType>(this, this->material_->SpeciesReaction());
+			};
+			virtual ~ElectroPhysiologyReactionRelaxationKnownModel(){};
+
+			virtual void exec(Real dt = 0.0) override
+			{
+				setupDynamics(dt);
+				updateRange(0, this->particles_->total_real_particles_, dt);
+			};
+			virtual void parallel_exec(Real dt = 0.0) override
+			{
+				setupDynamics(dt);
+				parallel_for(
+					blocked_range<size_t>(0, this->particles_->total_real_particles_),
+					[&](const blocked_range<size_t> &r)
+					{
+						updateRange(r.begin(), r.end(), dt);
+					},
+					ap);
+			};
+		};
+		/**
+		 * @class ElectroPhysiologyReactionRelaxationForwardKnownModel
+		 * @brief the forward splitting sweep with a compile-time reaction model
+		 */
+		template <class ReactionModelType>
+		class ElectroPhysiologyReactionRelaxationForwardKnownModel
+			: public ElectroPhysiologyReactionRelaxationKnownModel<ReactionModelType>
+		{
+		public:
+			explicit ElectroPhysiologyReactionRelaxationForwardKnownModel(RealBody &real_body)
+				: ElectroPhysiologyReactionRelaxationKnownModel<ReactionModelType>(real_body, true){};
+			virtual ~ElectroPhysiologyReactionRelaxationForwardKnownModel(){};
+		};
+		/**
+		 * @class ElectroPhysiologyReactionRelaxationBackwardKnownModel
+		 * @brief the backward splitting sweep with a compile-time reaction model
+		 */
+		template <class ReactionModelType>
+		class ElectroPhysiologyReactionRelaxationBackwardKnownModel
+			: public ElectroPhysiologyReactionRelaxationKnownModel<ReactionModelType>
+		{
+		public:
+			explicit ElectroPhysiologyReactionRelaxationBackwardKnownModel(RealBody &real_body)
+				: ElectroPhysiologyReactionRelaxationKnownModel<ReactionModelType>(real_body, false){};
+			virtual ~ElectroPhysiologyReactionRelaxationBackwardKnownModel(){};
+		};
 		/**
 		 * @class ApplyStimulusCurrents
 		 * @brief Apply specific stimulus currents
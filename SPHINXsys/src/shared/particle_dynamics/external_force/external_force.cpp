@@ -7,6 +7,15 @@
 namespace SPH {
 //=================================================================================================//
 	ExternalForce::ExternalForce() {}
+//=================================================================================================//
+	void ExternalForce::InducedAccelerationBlock(const Vecd* positions, Vecd* accelerations, size_t span_size)
+	{
+		for (size_t i = 0; i != span_size; ++i)
+		{
+			Vecd position = positions[i];
+			accelerations[i] = InducedAcceleration(position);
+		}
+	}
 //=================================================================================================//
 	Gravity::Gravity(Vecd global_acceleration, Vecd reference_position)
 		: ExternalForce(), global_acceleration_(global_acceleration),
@@ -17,6 +26,12 @@ namespace SPH {
 		return global_acceleration_;
 	}
 	//=================================================================================================//
+	void Gravity::InducedAccelerationBlock(const Vecd* positions, Vecd* accelerations, size_t span_size)
+	{
+		for (size_t i = 0; i != span_size; ++i)
+			accelerations[i] = global_acceleration_;
+	}
+	//=================================================================================================//
 	Real Gravity::getPotential(Vecd& position)
 	{
 		return dot(InducedAcceleration(position), zero_potential_reference_ - position);
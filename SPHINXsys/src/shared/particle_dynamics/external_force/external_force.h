@@ -46,6 +46,12 @@ namespace SPH {
 		virtual ~ExternalForce() {};
 		/** This function can be used for runtime control of external force. */
 		virtual Vecd InducedAcceleration(Vecd& position) = 0;
+		/** Block evaluation: the accelerations of a contiguous span of positions
+		 * are written in one call, so the virtual dispatch is paid once per span.
+		 * The default forwards to the per-position interface; position-independent
+		 * or purely arithmetic fields override it with a plain loop the compiler
+		 * can vectorize across the particles. */
+		virtual void InducedAccelerationBlock(const Vecd* positions, Vecd* accelerations, size_t span_size);
 	};
 
 	/**
@@ -63,6 +69,8 @@ namespace SPH {
 
 		/** This function can be used for runtime control of external force. */
 		virtual Vecd InducedAcceleration(Vecd& position) override;
+		/** Uniform gravity ignores the positions, the block reduces to a plain fill. */
+		virtual void InducedAccelerationBlock(const Vecd* positions, Vecd* accelerations, size_t span_size) override;
 		Real getPotential(Vecd& position);
 	};
 }
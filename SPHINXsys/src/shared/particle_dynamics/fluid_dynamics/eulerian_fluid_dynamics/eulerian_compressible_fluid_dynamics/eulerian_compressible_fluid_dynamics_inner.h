@@ -171,6 +171,29 @@ namespace SPH
 		using PressureRelaxationHLLCRiemannInner = BasePressureRelaxationInner<HLLCRiemannSolver>;
 		using PressureRelaxationHLLCWithLimiterRiemannInner = BasePressureRelaxationInner<HLLCWithLimiterRiemannSolver>;
 
+		/**
+		 * @class BasePressureRelaxationBlockedInner
+		 * @brief Pressure relaxation evaluating the Riemann fluxes block-wise:
+		 * the neighbor states are gathered into a fixed-size structure-of-arrays
+		 * scratch and the interface states of the whole block are resolved in one
+		 * branch-minimized sweep by the blocked solver kernel. Best combined with
+		 * a frozen compact-storage relation, where the neighbor lists of
+		 * consecutive particles are contiguous in memory.
+		 */
+		template <class RiemannSolverType>
+		class BasePressureRelaxationBlockedInner : public BasePressureRelaxationInner<RiemannSolverType>
+		{
+		public:
+			explicit BasePressureRelaxationBlockedInner(BaseBodyRelationInner &inner_relation)
+				: BasePressureRelaxationInner<RiemannSolverType>(inner_relation){};
+			virtual ~BasePressureRelaxationBlockedInner(){};
+
+		protected:
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+		using PressureRelaxationHLLCRiemannBlockedInner = BasePressureRelaxationBlockedInner<HLLCRiemannSolver>;
+		using PressureRelaxationHLLCWithLimiterRiemannBlockedInner = BasePressureRelaxationBlockedInner<HLLCWithLimiterRiemannSolver>;
+
 		/**
 		 * @class BaseDensityAndEnergyRelaxation
 		 * @brief Abstract base class for all density relaxation schemes
@@ -203,5 +226,24 @@ namespace SPH
 		};
 		using DensityAndEnergyRelaxationHLLCRiemannInner = BaseDensityAndEnergyRelaxationInner<HLLCRiemannSolver>;
 		using DensityAndEnergyRelaxationHLLCWithLimiterRiemannInner = BaseDensityAndEnergyRelaxationInner<HLLCWithLimiterRiemannSolver>;
+
+		/**
+		 * @class BaseDensityAndEnergyRelaxationBlockedInner
+		 * @brief Density and energy relaxation evaluating the Riemann fluxes
+		 * block-wise, see BasePressureRelaxationBlockedInner.
+		 */
+		template <class RiemannSolverType>
+		class BaseDensityAndEnergyRelaxationBlockedInner : public BaseDensityAndEnergyRelaxationInner<RiemannSolverType>
+		{
+		public:
+			explicit BaseDensityAndEnergyRelaxationBlockedInner(BaseBodyRelationInner &inner_relation)
+				: BaseDensityAndEnergyRelaxationInner<RiemannSolverType>(inner_relation){};
+			virtual ~BaseDensityAndEnergyRelaxationBlockedInner(){};
+
+		protected:
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+		using DensityAndEnergyRelaxationHLLCRiemannBlockedInner = BaseDensityAndEnergyRelaxationBlockedInner<HLLCRiemannSolver>;
+		using DensityAndEnergyRelaxationHLLCWithLimiterRiemannBlockedInner = BaseDensityAndEnergyRelaxationBlockedInner<HLLCWithLimiterRiemannSolver>;
 	}
 }
@@ -46,6 +46,44 @@ namespace SPH
 		}
 		//=================================================================================================//
 		template <class RiemannSolverType>
+		void BasePressureRelaxationBlockedInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			Real rho_i = this->rho_n_[index_i];
+			Real p_i = this->p_[index_i];
+			Real E_i = this->E_[index_i];
+			const Vecd &vel_i = this->vel_n_[index_i];
+			Vecd momentum_change_rate = this->dmom_dt_prior_[index_i];
+			Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+			CompressibleFluidStateBlock block;
+			for (size_t block_start = 0; block_start < inner_neighborhood.current_size_; block_start += block.capacity_)
+			{
+				block.size_ = SMIN(inner_neighborhood.current_size_ - block_start, block.capacity_);
+				for (size_t b = 0; b != block.size_; ++b)
+				{
+					size_t index_j = inner_neighborhood.j_[block_start + b];
+					block.rho_l_[b] = rho_i;
+					block.p_l_[b] = p_i;
+					block.E_l_[b] = E_i;
+					block.vel_l_[b] = vel_i;
+					block.rho_r_[b] = this->rho_n_[index_j];
+					block.p_r_[b] = this->p_[index_j];
+					block.E_r_[b] = this->E_[index_j];
+					block.vel_r_[b] = this->vel_n_[index_j];
+					block.e_ij_[b] = inner_neighborhood.e_ij_[block_start + b];
+				}
+				this->riemann_solver_.getInterfaceStates(block);
+				for (size_t b = 0; b != block.size_; ++b)
+				{
+					size_t index_j = inner_neighborhood.j_[block_start + b];
+					Real dW_ij = inner_neighborhood.dW_ij_[block_start + b];
+					momentum_change_rate -= 2.0 * this->Vol_[index_j] *
+											(SimTK::outer(block.rho_star_[b] * block.vel_star_[b], block.vel_star_[b]) + block.p_star_[b] * Matd(1.0)) * block.e_ij_[b] * dW_ij;
+				}
+			}
+			this->dmom_dt_[index_i] = momentum_change_rate;
+		}
+		//=================================================================================================//
+		template <class RiemannSolverType>
 		BaseDensityAndEnergyRelaxationInner<RiemannSolverType>::
 			BaseDensityAndEnergyRelaxationInner(BaseBodyRelationInner &inner_relation)
 			: BaseDensityAndEnergyRelaxation(inner_relation),
@@ -79,6 +117,47 @@ namespace SPH
 			dE_dt_[index_i] = energy_change_rate;
 		};
 		//=================================================================================================//
+		template <class RiemannSolverType>
+		void BaseDensityAndEnergyRelaxationBlockedInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			Real rho_i = this->rho_n_[index_i];
+			Real p_i = this->p_[index_i];
+			Real E_i = this->E_[index_i];
+			const Vecd &vel_i = this->vel_n_[index_i];
+			Real density_change_rate = 0.0;
+			Real energy_change_rate = this->dE_dt_prior_[index_i];
+			Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+			CompressibleFluidStateBlock block;
+			for (size_t block_start = 0; block_start < inner_neighborhood.current_size_; block_start += block.capacity_)
+			{
+				block.size_ = SMIN(inner_neighborhood.current_size_ - block_start, block.capacity_);
+				for (size_t b = 0; b != block.size_; ++b)
+				{
+					size_t index_j = inner_neighborhood.j_[block_start + b];
+					block.rho_l_[b] = rho_i;
+					block.p_l_[b] = p_i;
+					block.E_l_[b] = E_i;
+					block.vel_l_[b] = vel_i;
+					block.rho_r_[b] = this->rho_n_[index_j];
+					block.p_r_[b] = this->p_[index_j];
+					block.E_r_[b] = this->E_[index_j];
+					block.vel_r_[b] = this->vel_n_[index_j];
+					block.e_ij_[b] = inner_neighborhood.e_ij_[block_start + b];
+				}
+				this->riemann_solver_.getInterfaceStates(block);
+				for (size_t b = 0; b != block.size_; ++b)
+				{
+					size_t index_j = inner_neighborhood.j_[block_start + b];
+					Real dW_ij = inner_neighborhood.dW_ij_[block_start + b];
+					density_change_rate -= 2.0 * this->Vol_[index_j] * dot(block.rho_star_[b] * block.vel_star_[b], block.e_ij_[b]) * dW_ij;
+					energy_change_rate -= 2.0 * this->Vol_[index_j] *
+										  dot(block.E_star_[b] * block.vel_star_[b] + block.p_star_[b] * block.vel_star_[b], block.e_ij_[b]) * dW_ij;
+				}
+			}
+			this->drho_dt_[index_i] = density_change_rate;
+			this->dE_dt_[index_i] = energy_change_rate;
+		};
+		//=================================================================================================//
 	}
 	//=================================================================================================//
 }
@@ -45,13 +45,42 @@ namespace SPH
 			: PartDynamicsByCell(fluid_body, near_surface), FluidDataSimple(fluid_body),
 			  rho0_(particles_->rho0_), inv_sigma0_(1.0 / particles_->sigma0_),
 			  mass_(particles_->mass_), rho_sum_(particles_->rho_sum_), pos_n_(particles_->pos_n_),
-			  level_set_shape_(&near_surface.level_set_shape_) {}
+			  level_set_shape_(&near_surface.level_set_shape_),
+			  use_cached_probes_(false), cache_tolerance_(0) {}
+		//=================================================================================================//
+		void StaticConfinementDensity::useCachedProbes(Real tolerance_ratio)
+		{
+			use_cached_probes_ = true;
+			cache_tolerance_ = tolerance_ratio * sph_adaptation_->ReferenceSpacing();
+			if (cached_kernel_integral_.empty())
+			{
+				//the infinite initial probe position invalidates every first use
+				particles_->registerAVariable(cached_probe_pos_, "ConfinementIntegralProbePosition", Vecd(Infinity));
+				particles_->registerAVariable(cached_kernel_integral_, "ConfinementKernelIntegral");
+				particles_->registerASortableVariable<Vecd>("ConfinementIntegralProbePosition");
+				particles_->registerASortableVariable<Real>("ConfinementKernelIntegral");
+			}
+		}
+		//=================================================================================================//
+		Real StaticConfinementDensity::cachedKernelIntegral(size_t index_i)
+		{
+			//the wall never moves, so the cached probe stays valid until
+			//the particle has moved beyond the displacement bound
+			if ((pos_n_[index_i] - cached_probe_pos_[index_i]).norm() > cache_tolerance_)
+			{
+				cached_kernel_integral_[index_i] = level_set_shape_->computeKernelIntegral(pos_n_[index_i]);
+				cached_probe_pos_[index_i] = pos_n_[index_i];
+			}
+			return cached_kernel_integral_[index_i];
+		}
 		//=================================================================================================//
 		void StaticConfinementDensity::Update(size_t index_i, Real dt)
 		{
 			Real inv_Vol_0_i = rho0_ / mass_[index_i];
-			rho_sum_[index_i] +=
-				level_set_shape_->computeKernelIntegral(pos_n_[index_i]) * inv_Vol_0_i * rho0_ * inv_sigma0_;
+			Real kernel_integral = use_cached_probes_
+									   ? cachedKernelIntegral(index_i)
+									   : level_set_shape_->computeKernelIntegral(pos_n_[index_i]);
+			rho_sum_[index_i] += kernel_integral * inv_Vol_0_i * rho0_ * inv_sigma0_;
 		}
 		//=================================================================================================//
 		StaticConfinementPressureRelaxation::
@@ -61,11 +90,40 @@ namespace SPH
 			  pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_),
 			  dvel_dt_(particles_->dvel_dt_),
 			  level_set_shape_(&near_surface.level_set_shape_),
-			  riemann_solver_(*material_, *material_) {}
+			  riemann_solver_(*material_, *material_),
+			  use_cached_probes_(false), cache_tolerance_(0) {}
+		//=================================================================================================//
+		void StaticConfinementPressureRelaxation::useCachedProbes(Real tolerance_ratio)
+		{
+			use_cached_probes_ = true;
+			cache_tolerance_ = tolerance_ratio * sph_adaptation_->ReferenceSpacing();
+			if (cached_kernel_gradient_.empty())
+			{
+				//the infinite initial probe position invalidates every first use
+				particles_->registerAVariable(cached_probe_pos_, "ConfinementPressureProbePosition", Vecd(Infinity));
+				particles_->registerAVariable(cached_kernel_gradient_, "ConfinementPressureKernelGradient");
+				particles_->registerASortableVariable<Vecd>("ConfinementPressureProbePosition");
+				particles_->registerASortableVariable<Vecd>("ConfinementPressureKernelGradient");
+			}
+		}
+		//=================================================================================================//
+		Vecd StaticConfinementPressureRelaxation::cachedKernelGradientIntegral(size_t index_i)
+		{
+			//the wall never moves, so the cached probe stays valid until
+			//the particle has moved beyond the displacement bound
+			if ((pos_n_[index_i] - cached_probe_pos_[index_i]).norm() > cache_tolerance_)
+			{
+				cached_kernel_gradient_[index_i] = level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
+				cached_probe_pos_[index_i] = pos_n_[index_i];
+			}
+			return cached_kernel_gradient_[index_i];
+		}
 		//=================================================================================================//
 		void StaticConfinementPressureRelaxation::Update(size_t index_i, Real dt)
 		{
-			Vecd kernel_gradient = level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
+			Vecd kernel_gradient = use_cached_probes_
+									   ? cachedKernelGradientIntegral(index_i)
+									   : level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
 			Vecd normal_to_fluid = -kernel_gradient / (kernel_gradient.norm() + TinyReal);
 
 			FluidState state(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
@@ -83,11 +141,40 @@ namespace SPH
 			  rho_n_(particles_->rho_n_), p_(particles_->p_), drho_dt_(particles_->drho_dt_),
 			  pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_),
 			  level_set_shape_(&near_surface.level_set_shape_),
-			  riemann_solver_(*material_, *material_) {}
+			  riemann_solver_(*material_, *material_),
+			  use_cached_probes_(false), cache_tolerance_(0) {}
+		//=================================================================================================//
+		void StaticConfinementDensityRelaxation::useCachedProbes(Real tolerance_ratio)
+		{
+			use_cached_probes_ = true;
+			cache_tolerance_ = tolerance_ratio * sph_adaptation_->ReferenceSpacing();
+			if (cached_kernel_gradient_.empty())
+			{
+				//the infinite initial probe position invalidates every first use
+				particles_->registerAVariable(cached_probe_pos_, "ConfinementDensityProbePosition", Vecd(Infinity));
+				particles_->registerAVariable(cached_kernel_gradient_, "ConfinementDensityKernelGradient");
+				particles_->registerASortableVariable<Vecd>("ConfinementDensityProbePosition");
+				particles_->registerASortableVariable<Vecd>("ConfinementDensityKernelGradient");
+			}
+		}
+		//=================================================================================================//
+		Vecd StaticConfinementDensityRelaxation::cachedKernelGradientIntegral(size_t index_i)
+		{
+			//the wall never moves, so the cached probe stays valid until
+			//the particle has moved beyond the displacement bound
+			if ((pos_n_[index_i] - cached_probe_pos_[index_i]).norm() > cache_tolerance_)
+			{
+				cached_kernel_gradient_[index_i] = level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
+				cached_probe_pos_[index_i] = pos_n_[index_i];
+			}
+			return cached_kernel_gradient_[index_i];
+		}
 		//=================================================================================================//
 		void StaticConfinementDensityRelaxation::Update(size_t index_i, Real dt)
 		{
-			Vecd kernel_gradient = level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
+			Vecd kernel_gradient = use_cached_probes_
+									   ? cachedKernelGradientIntegral(index_i)
+									   : level_set_shape_->computeKernelGradientIntegral(pos_n_[index_i]);
 			Vecd normal_to_fluid = -kernel_gradient / (kernel_gradient.norm() + TinyReal);
 
 			FluidState state(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
@@ -103,6 +190,13 @@ namespace SPH
 			: density_summation_(fluid_body, near_surface), pressure_relaxation_(fluid_body, near_surface),
 			  density_relaxation_(fluid_body, near_surface) {}
 		//=================================================================================================//
+		void StaticConfinement::useCachedProbes(Real tolerance_ratio)
+		{
+			density_summation_.useCachedProbes(tolerance_ratio);
+			pressure_relaxation_.useCachedProbes(tolerance_ratio);
+			density_relaxation_.useCachedProbes(tolerance_ratio);
+		}
+		//=================================================================================================//
 		EmitterInflowCondition::
 			EmitterInflowCondition(FluidBody &fluid_body, BodyPartByParticle &body_part)
 			: PartSimpleDynamicsByParticle(fluid_body, body_part), FluidDataSimple(fluid_body),
@@ -123,7 +217,8 @@ namespace SPH
 			: PartSimpleDynamicsByParticle(fluid_body, body_part), FluidDataSimple(fluid_body),
 			  pos_n_(particles_->pos_n_), rho_n_(particles_->rho_n_), p_(particles_->p_),
 			  axis_(axis_direction), periodic_translation_(0), body_buffer_width_(body_buffer_width),
-			  body_part_bounds_(body_part.body_part_shape_.findBounds())
+			  body_part_bounds_(body_part.body_part_shape_.findBounds()),
+			  reserved_real_particles_(0), reused_recycled_slots_(0), recycled_slots_snapshot_(0)
 		{
 			periodic_translation_[axis_] = body_part_bounds_.second[axis_] - body_part_bounds_.first[axis_];
 
@@ -135,22 +230,52 @@ namespace SPH
 									   : std::bind(&EmitterInflowInjecting::checkLowerBound, this, _1, _2);
 		}
 		//=================================================================================================//
+		void EmitterInflowInjecting::exec(Real dt)
+		{
+			recycled_slots_snapshot_ = particles_->NumberOfRecycledSlots();
+			reused_recycled_slots_ = 0;
+			reserved_real_particles_ = particles_->total_real_particles_;
+			PartSimpleDynamicsByParticle::exec(dt);
+			particles_->total_real_particles_ = reserved_real_particles_;
+			particles_->dropReusedRecycledSlots(SMIN(size_t(reused_recycled_slots_), recycled_slots_snapshot_));
+		}
+		//=================================================================================================//
+		void EmitterInflowInjecting::parallel_exec(Real dt)
+		{
+			recycled_slots_snapshot_ = particles_->NumberOfRecycledSlots();
+			reused_recycled_slots_ = 0;
+			reserved_real_particles_ = particles_->total_real_particles_;
+			PartSimpleDynamicsByParticle::parallel_exec(dt);
+			particles_->total_real_particles_ = reserved_real_particles_;
+			particles_->dropReusedRecycledSlots(SMIN(size_t(reused_recycled_slots_), recycled_slots_snapshot_));
+		}
+		//=================================================================================================//
+		size_t EmitterInflowInjecting::reserveABufferParticle()
+		{
+			// reuse a recycled outflow slot first, so that steady outflow and
+			// inflow exchange slots without growing the real particle range
+			size_t recycled_n = reused_recycled_slots_.fetch_add(1);
+			if (recycled_n < recycled_slots_snapshot_)
+				return particles_->RecycledParticleSlot(recycled_n);
+
+			size_t new_particle_index = reserved_real_particles_.fetch_add(1);
+			if (new_particle_index >= particles_->real_particles_bound_)
+			{
+				std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
+						  << "Not enough body buffer particles! Exit the code."
+						  << "\n";
+				exit(0);
+			}
+			return new_particle_index;
+		}
+		//=================================================================================================//
 		void EmitterInflowInjecting::checkUpperBound(size_t unsorted_index_i, Real dt)
 		{
 			size_t sorted_index_i = sorted_id_[unsorted_index_i];
 			if (pos_n_[sorted_index_i][axis_] > body_part_bounds_.second[axis_])
 			{
-				if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
-				{
-					std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
-							  << "Not enough body buffer particles! Exit the code."
-							  << "\n";
-					exit(0);
-				}
-				/** Buffer Particle state copied from real particle. */
-				particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-				/** Realize the buffer particle by increasing the number of real particle in the body.  */
-				particles_->total_real_particles_ += 1;
+				/** Buffer Particle state copied from real particle into the reserved slot. */
+				particles_->copyFromAnotherParticle(reserveABufferParticle(), sorted_index_i);
 				/** Periodic bounding. */
 				pos_n_[sorted_index_i][axis_] -= periodic_translation_[axis_];
 				rho_n_[sorted_index_i] = material_->ReferenceDensity();
@@ -163,17 +288,8 @@ namespace SPH
 			size_t sorted_index_i = sorted_id_[unsorted_index_i];
 			if (pos_n_[sorted_index_i][axis_] < body_part_bounds_.first[axis_])
 			{
-				if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
-				{
-					std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
-							  << "Not enough body buffer particles! Exit the code."
-							  << "\n";
-					exit(0);
-				}
-				/** Buffer Particle state copied from real particle. */
-				particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-				/** Realize the buffer particle by increasing the number of real particle in the body.  */
-				particles_->total_real_particles_ += 1;
+				/** Buffer Particle state copied from real particle into the reserved slot. */
+				particles_->copyFromAnotherParticle(reserveABufferParticle(), sorted_index_i);
 				pos_n_[sorted_index_i][axis_] += periodic_translation_[axis_];
 			}
 		}
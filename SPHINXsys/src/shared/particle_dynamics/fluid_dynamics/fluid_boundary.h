@@ -32,6 +32,8 @@
 
 #include "fluid_dynamics_inner.h"
 
+#include <atomic>
+
 namespace SPH
 {
     namespace fluid_dynamics
@@ -69,6 +71,84 @@ namespace SPH
             virtual ~InflowBoundaryCondition(){};
         };
 
+        /**
+         * @class InflowBoundaryConditionBatched
+         * @brief Inflow condition with the velocity profile supplied as a
+         * compile-time functor instead of the getTargetVelocity virtual.
+         * The profile provides Vecd operator()(const Vecd &position, const
+         * Vecd &velocity) const and is inlined into a plain loop streaming
+         * whole index blocks of the tagged cells, so that purely arithmetic
+         * profiles, e.g. parabolic inlets or wave makers, vectorize instead
+         * of paying a virtual dispatch per inlet particle per acoustic step.
+         */
+        template <class TargetVelocityProfile>
+        class InflowBoundaryConditionBatched : public PartDynamicsByCell, public FluidDataSimple
+        {
+        public:
+            InflowBoundaryConditionBatched(FluidBody &fluid_body, BodyPartByCell &body_part,
+                                           TargetVelocityProfile profile)
+                : PartDynamicsByCell(fluid_body, body_part), FluidDataSimple(fluid_body),
+                  pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_),
+                  relaxation_rate_(1.0), profile_(profile){};
+            virtual ~InflowBoundaryConditionBatched(){};
+
+            /** a rate below one relaxes toward the profile instead of imposing it,
+             * matching the behavior of FlowRelaxationBuffer */
+            void setRelaxationRate(Real relaxation_rate) { relaxation_rate_ = relaxation_rate; };
+
+            virtual void exec(Real dt = 0.0) override
+            {
+                setBodyUpdated();
+                this->setupDynamics(dt);
+                for (size_t i = 0; i != body_part_cells_.size(); ++i)
+                    applyToCell(*body_part_cells_[i]);
+            };
+            virtual void parallel_exec(Real dt = 0.0) override
+            {
+                setBodyUpdated();
+                this->setupDynamics(dt);
+                parallel_for(
+                    blocked_range<size_t>(0, body_part_cells_.size()),
+                    [&](const blocked_range<size_t> &r)
+                    {
+                        for (size_t i = r.begin(); i != r.end(); ++i)
+                            applyToCell(*body_part_cells_[i]);
+                    },
+                    ap);
+            };
+
+        protected:
+            StdLargeVec<Vecd> &pos_n_, &vel_n_;
+            Real relaxation_rate_;
+            TargetVelocityProfile profile_;
+
+            /** the whole index block of a cell streams through the inlined profile */
+            void applyToCell(CellList &cell)
+            {
+                IndexVector &indexes = cell.cell_list_indexes_;
+                for (size_t num = 0; num != indexes.size(); ++num)
+                {
+                    size_t index_i = indexes[num];
+                    vel_n_[index_i] +=
+                        relaxation_rate_ * (profile_(pos_n_[index_i], vel_n_[index_i]) - vel_n_[index_i]);
+                }
+            };
+            virtual void Update(size_t index_i, Real dt = 0.0) override
+            {
+                vel_n_[index_i] +=
+                    relaxation_rate_ * (profile_(pos_n_[index_i], vel_n_[index_i]) - vel_n_[index_i]);
+            };
+        };
+
+        /** deduce the profile type of a batched inflow condition, e.g. from a lambda */
+        template <class TargetVelocityProfile>
+        InflowBoundaryConditionBatched<TargetVelocityProfile>
+        makeInflowBoundaryConditionBatched(FluidBody &fluid_body, BodyPartByCell &body_part,
+                                           TargetVelocityProfile profile)
+        {
+            return InflowBoundaryConditionBatched<TargetVelocityProfile>(fluid_body, body_part, profile);
+        }
+
         /**
          * @class DampingBoundaryCondition
          * @brief damping boundary condition which relaxes
@@ -98,12 +178,25 @@ namespace SPH
             StaticConfinementDensity(FluidBody &fluid_body, NearShapeSurface &near_surface);
             virtual ~StaticConfinementDensity(){};
 
+            /** cache the level-set probe per particle and reuse it until the
+             * particle has moved more than the given fraction of the reference
+             * spacing since the probe, as the confining wall never moves.
+             * Particles lingering near the wall then skip almost all probes. */
+            void useCachedProbes(Real tolerance_ratio = 0.05);
+            bool usingCachedProbes() { return use_cached_probes_; };
+
         protected:
             Real rho0_, inv_sigma0_;
             StdLargeVec<Real> &mass_, &rho_sum_;
             StdLargeVec<Vecd> &pos_n_;
             LevelSetShape *level_set_shape_;
+            bool use_cached_probes_; /**< whether the probes are cached per particle. */
+            Real cache_tolerance_;   /**< displacement bound of cache validity. */
+            StdLargeVec<Vecd> cached_probe_pos_;       /**< position of the last probe of each particle. */
+            StdLargeVec<Real> cached_kernel_integral_; /**< kernel integral of the last probe. */
 
+            /** the cached kernel integral, refreshed when the displacement bound is exceeded */
+            Real cachedKernelIntegral(size_t index_i);
             virtual void Update(size_t index_i, Real dt = 0.0) override;
         };
 
@@ -117,12 +210,22 @@ namespace SPH
             StaticConfinementPressureRelaxation(FluidBody &fluid_body, NearShapeSurface &near_surface);
             virtual ~StaticConfinementPressureRelaxation(){};
 
+            /** cache the level-set probe per particle, see StaticConfinementDensity */
+            void useCachedProbes(Real tolerance_ratio = 0.05);
+            bool usingCachedProbes() { return use_cached_probes_; };
+
         protected:
             StdLargeVec<Real> &rho_n_, &p_;
             StdLargeVec<Vecd> &pos_n_, &vel_n_, &dvel_dt_;
             LevelSetShape *level_set_shape_;
             AcousticRiemannSolver riemann_solver_;
+            bool use_cached_probes_; /**< whether the probes are cached per particle. */
+            Real cache_tolerance_;   /**< displacement bound of cache validity. */
+            StdLargeVec<Vecd> cached_probe_pos_;      /**< position of the last probe of each particle. */
+            StdLargeVec<Vecd> cached_kernel_gradient_; /**< kernel gradient integral of the last probe. */
 
+            /** the cached kernel gradient integral, refreshed when the displacement bound is exceeded */
+            Vecd cachedKernelGradientIntegral(size_t index_i);
             virtual void Update(size_t index_i, Real dt = 0.0) override;
         };
 
@@ -136,12 +239,22 @@ namespace SPH
             StaticConfinementDensityRelaxation(FluidBody &fluid_body, NearShapeSurface &near_surface);
             virtual ~StaticConfinementDensityRelaxation(){};
 
+            /** cache the level-set probe per particle, see StaticConfinementDensity */
+            void useCachedProbes(Real tolerance_ratio = 0.05);
+            bool usingCachedProbes() { return use_cached_probes_; };
+
         protected:
             StdLargeVec<Real> &rho_n_, &p_, &drho_dt_;
             StdLargeVec<Vecd> &pos_n_, &vel_n_;
             LevelSetShape *level_set_shape_;
             AcousticRiemannSolver riemann_solver_;
+            bool use_cached_probes_; /**< whether the probes are cached per particle. */
+            Real cache_tolerance_;   /**< displacement bound of cache validity. */
+            StdLargeVec<Vecd> cached_probe_pos_;      /**< position of the last probe of each particle. */
+            StdLargeVec<Vecd> cached_kernel_gradient_; /**< kernel gradient integral of the last probe. */
 
+            /** the cached kernel gradient integral, refreshed when the displacement bound is exceeded */
+            Vecd cachedKernelGradientIntegral(size_t index_i);
             virtual void Update(size_t index_i, Real dt = 0.0) override;
         };
 
@@ -158,6 +271,9 @@ namespace SPH
 
             StaticConfinement(FluidBody &fluid_body, NearShapeSurface &near_surface);
             virtual ~StaticConfinement(){};
+
+            /** enable the per-particle probe caches of all three conditions */
+            void useCachedProbes(Real tolerance_ratio = 0.05);
         };
 
         /**
@@ -186,6 +302,13 @@ namespace SPH
         /**
          * @class EmitterInflowInjecting
          * @brief Inject particles into the computational domain.
+         * The injection runs in parallel: each crossing particle atomically
+         * reserves a slot from the pre-allocated buffer particles and then
+         * initializes it independently, while the total number of real
+         * particles is only published after the sweep.
+         * Slots recycled by an outflow boundary are reused before the real
+         * particle range is extended, so that steady outflow and inflow
+         * exchange slots without moving any live particle.
          */
         class EmitterInflowInjecting : public PartSimpleDynamicsByParticle, public FluidDataSimple
         {
@@ -194,8 +317,8 @@ namespace SPH
                                             size_t body_buffer_width, int axis_direction, bool positive);
             virtual ~EmitterInflowInjecting(){};
 
-            /** This class is only implemented in sequential due to memory conflicts. */
-            virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+            virtual void exec(Real dt = 0.0) override;
+            virtual void parallel_exec(Real dt = 0.0) override;
 
         protected:
             StdLargeVec<Vecd> &pos_n_;
@@ -204,7 +327,13 @@ namespace SPH
             Vecd periodic_translation_;
             size_t body_buffer_width_;
             BoundingBox body_part_bounds_;
+            /** next free slot among the pre-allocated buffer particles */
+            std::atomic<size_t> reserved_real_particles_;
+            /** next recycled outflow slot to be reused within the sweep */
+            std::atomic<size_t> reused_recycled_slots_;
+            size_t recycled_slots_snapshot_; /**< number of recycled slots when the sweep started. */
 
+            size_t reserveABufferParticle();
             virtual void checkLowerBound(size_t unsorted_index_i, Real dt = 0.0);
             virtual void checkUpperBound(size_t unsorted_index_i, Real dt = 0.0);
             ParticleFunctor checking_bound_;
@@ -5,6 +5,7 @@
 
 #include "fluid_dynamics_inner.h"
 #include "fluid_dynamics_inner.hpp"
+#include "general_dynamics.h"
 
 namespace SPH
 {
@@ -23,13 +24,25 @@ namespace SPH
 			  Vol_(particles_->Vol_), rho_n_(particles_->rho_n_), mass_(particles_->mass_),
 			  rho_sum_(particles_->rho_sum_),
 			  W0_(sph_adaptation_->getKernel()->W0(Vecd(0))),
-			  rho0_(particles_->rho0_), inv_sigma0_(1.0 / particles_->sigma0_) {}
+			  rho0_(particles_->rho0_), inv_sigma0_(1.0 / particles_->sigma0_)
+		{
+			// the update only consumes the own summation result,
+			// so it can run in the same particle sweep as the interaction
+			useFusedUpdate();
+		}
 		//=================================================================================================//
 		void DensitySummationInner::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? summationInteraction(index_i, compact_inner_configuration_[index_i])
+				: summationInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void DensitySummationInner::summationInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			/** Inner interaction. */
 			Real sigma = W0_;
-			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 				sigma += inner_neighborhood.W_ij_[n];
 
@@ -49,25 +62,55 @@ namespace SPH
 			  vel_n_(particles_->vel_n_),
 			  dvel_dt_prior_(particles_->dvel_dt_prior_),
 			  mu_(material_->ReferenceViscosity()),
-			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()) {}
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()),
+			  prior_gravity_(nullptr) {}
+		//=================================================================================================//
+		void ViscousAccelerationInner::fuseTimeStepInitialization(TimeStepInitialization &time_step_initialization)
+		{
+			prior_gravity_ = time_step_initialization.getGravity();
+			time_step_initialization.skipPriorAccelerationUpdate();
+		}
 		//=================================================================================================//
 		void ViscousAccelerationInner::Interaction(size_t index_i, Real dt)
+		{
+			if (inner_relation_->usingRecomputedPairGeometry())
+			{
+				StdLargeVec<Vecd> &pos_n = particles_->pos_n_;
+				inner_relation_->usingCompactConfiguration()
+					? viscousInteraction(index_i, RecomputingNeighborhood<CompactNeighborhood>(
+													  compact_inner_configuration_[index_i], pos_n, pos_n[index_i]))
+					: viscousInteraction(index_i, RecomputingNeighborhood<Neighborhood>(
+													  inner_configuration_[index_i], pos_n, pos_n[index_i]));
+				return;
+			}
+			inner_relation_->usingCompactConfiguration()
+				? viscousInteraction(index_i, compact_inner_configuration_[index_i])
+				: viscousInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void ViscousAccelerationInner::viscousInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			Real rho_i = rho_n_[index_i];
 			const Vecd &vel_i = vel_n_[index_i];
 
 			Vecd acceleration(0), vel_derivative(0);
-			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, Vol_);
 
 				//viscous force
 				vel_derivative = (vel_i - vel_n_[index_j]) / (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
 				acceleration += 2.0 * mu_ * vel_derivative * Vol_[index_j] * inner_neighborhood.dW_ij_[n] / rho_i;
 			}
 
-			dvel_dt_prior_[index_i] += acceleration;
+			//- with a fused time step initialization the prior acceleration is
+			//- set here instead of in a separate sweep
+			dvel_dt_prior_[index_i] = prior_gravity_
+										  ? prior_gravity_->InducedAcceleration(particles_->pos_n_[index_i]) + acceleration
+										  : dvel_dt_prior_[index_i] + acceleration;
 		}
 		//=================================================================================================//
 		void AngularConservativeViscousAccelerationInner::Interaction(size_t index_i, Real dt)
@@ -90,7 +133,276 @@ namespace SPH
 				acceleration += eta_ij * Vol_[index_j] / rho_i * inner_neighborhood.dW_ij_[n] * e_ij;
 			}
 
-			dvel_dt_prior_[index_i] += acceleration;
+			dvel_dt_prior_[index_i] = prior_gravity_
+										  ? prior_gravity_->InducedAcceleration(particles_->pos_n_[index_i]) + acceleration
+										  : dvel_dt_prior_[index_i] + acceleration;
+		}
+		//=================================================================================================//
+		VelocityGradientInner::VelocityGradientInner(BaseBodyRelationInner &inner_relation)
+			: InteractionDynamics(*inner_relation.sph_body_),
+			  FluidDataInner(inner_relation),
+			  Vol_(particles_->Vol_), vel_n_(particles_->vel_n_),
+			  evaluated_(false), evaluation_time_(0.0), evaluated_configuration_version_(0)
+		{
+			particles_->registerAVariable(vel_grad_, "VelocityGradient");
+		}
+		//=================================================================================================//
+		bool VelocityGradientInner::upToDate()
+		{
+			if (evaluated_ &&
+				evaluation_time_ == GlobalStaticVariables::physical_time_ &&
+				evaluated_configuration_version_ == inner_relation_->ConfigurationVersion())
+				return true;
+
+			evaluated_ = true;
+			evaluation_time_ = GlobalStaticVariables::physical_time_;
+			evaluated_configuration_version_ = inner_relation_->ConfigurationVersion();
+			return false;
+		}
+		//=================================================================================================//
+		void VelocityGradientInner::exec(Real dt)
+		{
+			if (upToDate())
+				return;
+			InteractionDynamics::exec(dt);
+		}
+		//=================================================================================================//
+		void VelocityGradientInner::parallel_exec(Real dt)
+		{
+			if (upToDate())
+				return;
+			InteractionDynamics::parallel_exec(dt);
+		}
+		//=================================================================================================//
+		void VelocityGradientInner::Interaction(size_t index_i, Real dt)
+		{
+			if (inner_relation_->usingKernelGradient())
+			{
+				inner_relation_->usingCompactConfiguration()
+					? gradientInteraction(index_i, compact_inner_configuration_[index_i])
+					: gradientInteraction(index_i, inner_configuration_[index_i]);
+				return;
+			}
+
+			const Vecd &vel_i = vel_n_[index_i];
+
+			Matd vel_grad(0);
+			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
+				vel_grad -= Vol_[index_j] * SimTK::outer(vel_i - vel_n_[index_j], nablaW_ij);
+			}
+
+			vel_grad_[index_i] = vel_grad;
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void VelocityGradientInner::gradientInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
+		{
+			const Vecd &vel_i = vel_n_[index_i];
+
+			Matd vel_grad(0);
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				const Vecd &nablaW_ij = inner_neighborhood.dW_ij_e_ij_[n];
+				vel_grad -= Vol_[index_j] * SimTK::outer(vel_i - vel_n_[index_j], nablaW_ij);
+			}
+
+			vel_grad_[index_i] = vel_grad;
+		}
+		//=================================================================================================//
+		ViscousAccelerationFromVelocityGradientInner::
+			ViscousAccelerationFromVelocityGradientInner(BaseBodyRelationInner &inner_relation,
+														 VelocityGradientInner &velocity_gradient)
+			: ViscousAccelerationInner(inner_relation),
+			  velocity_gradient_(velocity_gradient),
+			  vel_grad_(*particles_->getVariableByName<Matd>("VelocityGradient")) {}
+		//=================================================================================================//
+		void ViscousAccelerationFromVelocityGradientInner::exec(Real dt)
+		{
+			velocity_gradient_.exec(dt);
+			InteractionDynamics::exec(dt);
+		}
+		//=================================================================================================//
+		void ViscousAccelerationFromVelocityGradientInner::parallel_exec(Real dt)
+		{
+			velocity_gradient_.parallel_exec(dt);
+			InteractionDynamics::parallel_exec(dt);
+		}
+		//=================================================================================================//
+		void ViscousAccelerationFromVelocityGradientInner::Interaction(size_t index_i, Real dt)
+		{
+			if (inner_relation_->usingKernelGradient())
+			{
+				inner_relation_->usingCompactConfiguration()
+					? stressDivergenceInteraction(index_i, compact_inner_configuration_[index_i])
+					: stressDivergenceInteraction(index_i, inner_configuration_[index_i]);
+				return;
+			}
+
+			Real rho_i = rho_n_[index_i];
+			Matd shear_stress_i = mu_ * (vel_grad_[index_i] + ~vel_grad_[index_i]);
+
+			Vecd acceleration(0);
+			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
+
+				//divergence of the shear stress
+				Matd shear_stress_j = mu_ * (vel_grad_[index_j] + ~vel_grad_[index_j]);
+				acceleration += (shear_stress_i + shear_stress_j) * nablaW_ij * Vol_[index_j] / rho_i;
+			}
+
+			dvel_dt_prior_[index_i] = prior_gravity_
+										  ? prior_gravity_->InducedAcceleration(particles_->pos_n_[index_i]) + acceleration
+										  : dvel_dt_prior_[index_i] + acceleration;
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void ViscousAccelerationFromVelocityGradientInner::
+			stressDivergenceInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
+		{
+			Real rho_i = rho_n_[index_i];
+			Matd shear_stress_i = mu_ * (vel_grad_[index_i] + ~vel_grad_[index_i]);
+
+			Vecd acceleration(0);
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				const Vecd &nablaW_ij = inner_neighborhood.dW_ij_e_ij_[n];
+
+				//divergence of the shear stress
+				Matd shear_stress_j = mu_ * (vel_grad_[index_j] + ~vel_grad_[index_j]);
+				acceleration += (shear_stress_i + shear_stress_j) * nablaW_ij * Vol_[index_j] / rho_i;
+			}
+
+			dvel_dt_prior_[index_i] = prior_gravity_
+										  ? prior_gravity_->InducedAcceleration(particles_->pos_n_[index_i]) + acceleration
+										  : dvel_dt_prior_[index_i] + acceleration;
+		}
+		//=================================================================================================//
+		ImplicitViscousRelaxationInner::
+			ImplicitViscousRelaxationInner(BaseBodyRelationInner &inner_relation,
+										   size_t max_iterations, Real relative_tolerance)
+			: InteractionDynamics(*inner_relation.sph_body_),
+			  FluidDataInner(inner_relation),
+			  mu_(material_->ReferenceViscosity()),
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()),
+			  max_iterations_(max_iterations), relative_tolerance_(relative_tolerance),
+			  last_iteration_count_(0),
+			  Vol_(particles_->Vol_), rho_n_(particles_->rho_n_),
+			  vel_n_(particles_->vel_n_),
+			  vel_iterate_(nullptr), vel_update_(nullptr) {}
+		//=================================================================================================//
+		Real ImplicitViscousRelaxationInner::jacobiRowUpdate(size_t index_i, Real dt)
+		{
+			Real rho_i = rho_n_[index_i];
+			const StdLargeVec<Vecd> &iterate = *vel_iterate_;
+
+			//- accumulate the off-diagonal contributions and the diagonal of the
+			//- row of (I - dt * L) without assembling the matrix
+			Vecd weighted_sum(0);
+			Real diagonal = 1.0;
+			Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				Real coefficient = 2.0 * dt * mu_ * Vol_[index_j] * inner_neighborhood.dW_ij_[n] /
+								   (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_) / rho_i;
+				diagonal -= coefficient;
+				weighted_sum -= coefficient * iterate[index_j];
+			}
+
+			Vecd updated_velocity = (vel_n_[index_i] + weighted_sum) / diagonal;
+			(*vel_update_)[index_i] = updated_velocity;
+			return (updated_velocity - iterate[index_i]).norm();
+		}
+		//=================================================================================================//
+		void ImplicitViscousRelaxationInner::Interaction(size_t index_i, Real dt)
+		{
+			jacobiRowUpdate(index_i, dt);
+		}
+		//=================================================================================================//
+		void ImplicitViscousRelaxationInner::exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			vel_iterate_ = &base_particles_->scratch_buffers_.obtainBuffer<Vecd>("ImplicitViscousIterate", total_real_particles);
+			vel_update_ = &base_particles_->scratch_buffers_.obtainBuffer<Vecd>("ImplicitViscousUpdate", total_real_particles);
+
+			Real velocity_scale = 0.0;
+			for (size_t i = 0; i != total_real_particles; ++i)
+			{
+				(*vel_iterate_)[i] = vel_n_[i];
+				velocity_scale = SMAX(velocity_scale, vel_n_[i].norm());
+			}
+
+			last_iteration_count_ = 0;
+			while (last_iteration_count_ != max_iterations_)
+			{
+				Real residual = 0.0;
+				for (size_t i = 0; i != total_real_particles; ++i)
+					residual = SMAX(residual, jacobiRowUpdate(i, dt));
+				std::swap(vel_iterate_, vel_update_);
+				++last_iteration_count_;
+				if (residual <= relative_tolerance_ * (velocity_scale + TinyReal))
+					break;
+			}
+
+			for (size_t i = 0; i != total_real_particles; ++i)
+				vel_n_[i] = (*vel_iterate_)[i];
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
+		void ImplicitViscousRelaxationInner::parallel_exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			vel_iterate_ = &base_particles_->scratch_buffers_.obtainBuffer<Vecd>("ImplicitViscousIterate", total_real_particles);
+			vel_update_ = &base_particles_->scratch_buffers_.obtainBuffer<Vecd>("ImplicitViscousUpdate", total_real_particles);
+
+			ReduceMax reduce_max;
+			Real velocity_scale = ReduceIterator_parallel(
+				total_real_particles, Real(0),
+				[&](size_t index_i, Real local_dt) -> Real
+				{
+					(*vel_iterate_)[index_i] = vel_n_[index_i];
+					return vel_n_[index_i].norm();
+				},
+				reduce_max, dt);
+
+			last_iteration_count_ = 0;
+			while (last_iteration_count_ != max_iterations_)
+			{
+				Real residual = ReduceIterator_parallel(
+					total_real_particles, Real(0),
+					[&](size_t index_i, Real local_dt) -> Real
+					{ return jacobiRowUpdate(index_i, local_dt); },
+					reduce_max, dt);
+				std::swap(vel_iterate_, vel_update_);
+				++last_iteration_count_;
+				if (residual <= relative_tolerance_ * (velocity_scale + TinyReal))
+					break;
+			}
+
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						vel_n_[i] = (*vel_iterate_)[i];
+				},
+				ap);
+			recordExecutionTiming(start_time);
 		}
 		//=================================================================================================//
 		TransportVelocityCorrectionInner::
@@ -110,6 +422,14 @@ namespace SPH
 		//=================================================================================================//
 		void TransportVelocityCorrectionInner::Interaction(size_t index_i, Real dt)
 		{
+			if (inner_relation_->usingKernelGradient())
+			{
+				inner_relation_->usingCompactConfiguration()
+					? correctionInteraction(index_i, compact_inner_configuration_[index_i], dt)
+					: correctionInteraction(index_i, inner_configuration_[index_i], dt);
+				return;
+			}
+
 			Real rho_i = rho_n_[index_i];
 
 			Vecd acceleration_trans(0);
@@ -127,15 +447,82 @@ namespace SPH
 				pos_n_[index_i] += acceleration_trans * dt * dt * 0.5;
 		}
 		//=================================================================================================//
+		template <class NeighborhoodType>
+		void TransportVelocityCorrectionInner::
+			correctionInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood, Real dt)
+		{
+			Real rho_i = rho_n_[index_i];
+
+			Vecd acceleration_trans(0);
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				const Vecd &nablaW_ij = inner_neighborhood.dW_ij_e_ij_[n];
+
+				//acceleration for transport velocity
+				acceleration_trans -= 2.0 * p_background_ * Vol_[index_j] * nablaW_ij / rho_i;
+			}
+
+			if (surface_indicator_[index_i] == 0)
+				pos_n_[index_i] += acceleration_trans * dt * dt * 0.5;
+		}
+		//=================================================================================================//
+		/** maximum acceleration magnitude over all real particles, used to bound
+		 * how fast a cached maximum speed can grow between full reductions */
+		static Real maxAccelerationNorm(FluidParticles *particles)
+		{
+			StdLargeVec<Vecd> &dvel_dt = particles->dvel_dt_;
+			StdLargeVec<Vecd> &dvel_dt_prior = particles->dvel_dt_prior_;
+			return parallel_reduce(
+				blocked_range<size_t>(0, particles->total_real_particles_), Real(0),
+				[&](const blocked_range<size_t> &r, Real temp) -> Real
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						temp = SMAX(temp, (dvel_dt[i] + dvel_dt_prior[i]).norm());
+					}
+					return temp;
+				},
+				[](Real x, Real y) -> Real
+				{ return SMAX(x, y); });
+		}
+		//=================================================================================================//
 		AcousticTimeStepSize::AcousticTimeStepSize(FluidBody &fluid_body)
 			: ParticleDynamicsReduce<Real, ReduceMax>(fluid_body),
 			  FluidDataSimple(fluid_body), rho_n_(particles_->rho_n_),
 			  p_(particles_->p_), vel_n_(particles_->vel_n_),
-			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength())
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()),
+			  use_lazy_evaluation_(false), lazy_tolerance_(0.05),
+			  evaluated_signal_speed_max_(0.0), evaluated_acceleration_max_(0.0),
+			  evaluation_time_(-1.0)
 		{
 			initial_reference_ = 0.0;
 		}
 		//=================================================================================================//
+		Real AcousticTimeStepSize::parallel_exec(Real dt)
+		{
+			if (!use_lazy_evaluation_)
+				return ParticleDynamicsReduce<Real, ReduceMax>::parallel_exec(dt);
+
+			//the signal speed can grow at most with the maximum acceleration, and for the
+			//weakly compressible equation of state the sound speed is essentially constant,
+			//so the bounded value stays conservative within the tolerance
+			Real signal_speed_bound = evaluated_signal_speed_max_ +
+									  evaluated_acceleration_max_ * (physical_time_ - evaluation_time_);
+			if (evaluation_time_ >= 0.0 &&
+				signal_speed_bound <= (1.0 + lazy_tolerance_) * evaluated_signal_speed_max_)
+			{
+				particles_->signal_speed_max_ = signal_speed_bound;
+				return 0.6 * smoothing_length_ / (signal_speed_bound + TinyReal);
+			}
+
+			Real time_step_size = ParticleDynamicsReduce<Real, ReduceMax>::parallel_exec(dt);
+			evaluated_signal_speed_max_ = particles_->signal_speed_max_;
+			evaluated_acceleration_max_ = maxAccelerationNorm(particles_);
+			evaluation_time_ = physical_time_;
+			return time_step_size;
+		}
+		//=================================================================================================//
 		Real AcousticTimeStepSize::ReduceFunction(size_t index_i, Real dt)
 		{
 			return material_->getSoundSpeed(p_[index_i], rho_n_[index_i]) + vel_n_[index_i].norm();
@@ -152,7 +539,10 @@ namespace SPH
 		AdvectionTimeStepSize::AdvectionTimeStepSize(FluidBody &fluid_body, Real U_max)
 			: ParticleDynamicsReduce<Real, ReduceMax>(fluid_body),
 			  FluidDataSimple(fluid_body), vel_n_(particles_->vel_n_),
-			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength())
+			  smoothing_length_(sph_adaptation_->ReferenceSmoothingLength()),
+			  use_lazy_evaluation_(false), lazy_tolerance_(0.05),
+			  evaluated_speed_max_(0.0), evaluated_acceleration_max_(0.0),
+			  evaluation_time_(-1.0)
 		{
 			Real rho_0 = material_->ReferenceDensity();
 			Real mu = material_->ReferenceViscosity();
@@ -161,6 +551,27 @@ namespace SPH
 			initial_reference_ = u_max * u_max;
 		}
 		//=================================================================================================//
+		Real AdvectionTimeStepSize::parallel_exec(Real dt)
+		{
+			if (!use_lazy_evaluation_)
+				return ParticleDynamicsReduce<Real, ReduceMax>::parallel_exec(dt);
+
+			Real speed_bound = evaluated_speed_max_ +
+							   evaluated_acceleration_max_ * (physical_time_ - evaluation_time_);
+			if (evaluation_time_ >= 0.0 &&
+				speed_bound <= (1.0 + lazy_tolerance_) * evaluated_speed_max_)
+			{
+				particles_->speed_max_ = speed_bound;
+				return 0.25 * smoothing_length_ / (speed_bound + TinyReal);
+			}
+
+			Real time_step_size = ParticleDynamicsReduce<Real, ReduceMax>::parallel_exec(dt);
+			evaluated_speed_max_ = particles_->speed_max_;
+			evaluated_acceleration_max_ = maxAccelerationNorm(particles_);
+			evaluation_time_ = physical_time_;
+			return time_step_size;
+		}
+		//=================================================================================================//
 		Real AdvectionTimeStepSize::ReduceFunction(size_t index_i, Real dt)
 		{
 			return vel_n_[index_i].normSqr();
@@ -208,6 +619,180 @@ namespace SPH
 			vorticity_[index_i] = vorticity;
 		}
 		//=================================================================================================//
+		AsynchronousVorticityInner::AsynchronousVorticityInner(BaseBodyRelationInner &inner_relation)
+			: VorticityInner(inner_relation), snapshot_particle_count_(0),
+			  job_pending_(false), terminate_worker_thread_(false) {}
+		//=================================================================================================//
+		AsynchronousVorticityInner::~AsynchronousVorticityInner()
+		{
+			if (worker_thread_.joinable())
+			{
+				finishAsynchronousComputation();
+				{
+					std::lock_guard<std::mutex> lock(worker_mutex_);
+					terminate_worker_thread_ = true;
+				}
+				worker_condition_.notify_all();
+				worker_thread_.join();
+			}
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::exec(Real dt)
+		{
+			dispatchComputation(dt);
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::parallel_exec(Real dt)
+		{
+			dispatchComputation(dt);
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::dispatchComputation(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			if (!worker_thread_.joinable())
+				worker_thread_ = std::thread(&AsynchronousVorticityInner::workerThreadLoop, this);
+			finishAsynchronousComputation();
+			takeSnapshot();
+			{
+				std::lock_guard<std::mutex> lock(worker_mutex_);
+				job_pending_ = true;
+			}
+			worker_condition_.notify_all();
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::finishAsynchronousComputation()
+		{
+			if (!worker_thread_.joinable())
+				return;
+
+			std::unique_lock<std::mutex> lock(worker_mutex_);
+			worker_condition_.wait(lock, [&]
+								   { return !job_pending_; });
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::takeSnapshot()
+		{
+			size_t total_real_particles = particles_->total_real_particles_;
+			snapshot_particle_count_ = total_real_particles;
+			vel_snapshot_.resize(total_real_particles);
+			Vol_snapshot_.resize(total_real_particles);
+			offsets_snapshot_.resize(total_real_particles + 1);
+
+			bool compact_configuration = inner_relation_->usingCompactConfiguration();
+			offsets_snapshot_[0] = 0;
+			for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+			{
+				size_t current_size = compact_configuration
+										  ? compact_inner_configuration_[index_i].current_size_
+										  : inner_configuration_[index_i].current_size_;
+				offsets_snapshot_[index_i + 1] = offsets_snapshot_[index_i] + current_size;
+			}
+			size_t total_neighbors = offsets_snapshot_[total_real_particles];
+			j_snapshot_.resize(total_neighbors);
+			dW_ij_snapshot_.resize(total_neighbors);
+			displacement_snapshot_.resize(total_neighbors);
+
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real)
+				{
+					vel_snapshot_[index_i] = vel_n_[index_i];
+					Vol_snapshot_[index_i] = Vol_[index_i];
+					size_t offset = offsets_snapshot_[index_i];
+					if (compact_configuration)
+					{
+						const CompactNeighborhood &inner_neighborhood = compact_inner_configuration_[index_i];
+						for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+						{
+							j_snapshot_[offset + n] = inner_neighborhood.j_[n];
+							dW_ij_snapshot_[offset + n] = inner_neighborhood.dW_ij_[n];
+							displacement_snapshot_[offset + n] = inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
+						}
+					}
+					else
+					{
+						const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+						for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+						{
+							j_snapshot_[offset + n] = inner_neighborhood.j_[n];
+							dW_ij_snapshot_[offset + n] = inner_neighborhood.dW_ij_[n];
+							displacement_snapshot_[offset + n] = inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
+						}
+					}
+				});
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::computeFromSnapshot()
+		{
+			/** serial on the worker thread, so that the concurrently running
+			 * simulation steps keep the thread pool for themselves. */
+			for (size_t index_i = 0; index_i != snapshot_particle_count_; ++index_i)
+			{
+				const Vecd &vel_i = vel_snapshot_[index_i];
+
+				AngularVecd vorticity(0);
+				for (size_t n = offsets_snapshot_[index_i]; n != offsets_snapshot_[index_i + 1]; ++n)
+				{
+					size_t index_j = j_snapshot_[n];
+					Vecd vel_diff = vel_i - vel_snapshot_[index_j];
+					vorticity += SimTK::cross(vel_diff, displacement_snapshot_[n]) * Vol_snapshot_[index_j] * dW_ij_snapshot_[n];
+				}
+
+				vorticity_[index_i] = vorticity;
+			}
+		}
+		//=================================================================================================//
+		void AsynchronousVorticityInner::workerThreadLoop()
+		{
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(worker_mutex_);
+					worker_condition_.wait(lock, [&]
+										   { return job_pending_ || terminate_worker_thread_; });
+					if (!job_pending_)
+						return;
+				}
+				computeFromSnapshot();
+				{
+					std::lock_guard<std::mutex> lock(worker_mutex_);
+					job_pending_ = false;
+				}
+				worker_condition_.notify_all();
+			}
+		}
+		//=================================================================================================//
+		VorticityFromVelocityGradient::
+			VorticityFromVelocityGradient(FluidBody &fluid_body, VelocityGradientInner &velocity_gradient)
+			: ParticleDynamicsSimple(fluid_body), FluidDataSimple(fluid_body),
+			  velocity_gradient_(velocity_gradient),
+			  vel_grad_(*particles_->getVariableByName<Matd>("VelocityGradient"))
+		{
+			particles_->registerAVariable(vorticity_, "VorticityFromVelocityGradient");
+			particles_->addAVariableToWrite<AngularVecd>("VorticityFromVelocityGradient");
+		}
+		//=================================================================================================//
+		void VorticityFromVelocityGradient::exec(Real dt)
+		{
+			velocity_gradient_.exec(dt);
+			ParticleDynamicsSimple::exec(dt);
+		}
+		//=================================================================================================//
+		void VorticityFromVelocityGradient::parallel_exec(Real dt)
+		{
+			velocity_gradient_.parallel_exec(dt);
+			ParticleDynamicsSimple::parallel_exec(dt);
+		}
+		//=================================================================================================//
+		void VorticityFromVelocityGradient::Update(size_t index_i, Real dt)
+		{
+			vorticity_[index_i] = getVorticityFromVelocityGradient(vel_grad_[index_i]);
+		}
+		//=================================================================================================//
 		BaseRelaxation::BaseRelaxation(BaseBodyRelationInner &inner_relation)
 			: ParticleDynamics1Level(*inner_relation.sph_body_),
 			  FluidDataInner(inner_relation),
@@ -38,9 +38,15 @@
 #include "fluid_particles.h"
 #include "weakly_compressible_fluid.h"
 #include "riemann_solver.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace SPH
 {
+	class Gravity;
+	class TimeStepInitialization;
+
 	namespace fluid_dynamics
 	{
 		typedef DataDelegateSimple<FluidBody, FluidParticles, Fluid> FluidDataSimple;
@@ -78,6 +84,10 @@ namespace SPH
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 			virtual Real ReinitializedDensity(Real rho_sum, Real rho_0, Real rho_n) { return rho_sum; };
+			/** the interaction body templated over the neighborhood view so that the scattered
+			 * and the compressed-sparse-row storages share one implementation. */
+			template <class NeighborhoodType>
+			void summationInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 
 		/**
@@ -90,13 +100,22 @@ namespace SPH
 			explicit ViscousAccelerationInner(BaseBodyRelationInner &inner_relation);
 			virtual ~ViscousAccelerationInner(){};
 
+			/** fold the prior acceleration initialization of the given
+			 * TimeStepInitialization into this interaction pass, so its separate
+			 * sweep over the acceleration array is saved. This pass must then be
+			 * the first dynamics of the step touching the prior acceleration. */
+			void fuseTimeStepInitialization(TimeStepInitialization &time_step_initialization);
+
 		protected:
 			Real mu_;
 			Real smoothing_length_;
 			StdLargeVec<Real> &Vol_, &rho_n_, &p_;
 			StdLargeVec<Vecd> &vel_n_, &dvel_dt_prior_;
+			Gravity *prior_gravity_;
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void viscousInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 
 		/**
@@ -115,6 +134,117 @@ namespace SPH
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class VelocityGradientInner
+		 * @brief compute the velocity gradient tensor into the registered variable
+		 * "VelocityGradient", with the convention that element (i, j) is the
+		 * derivative of velocity component i along direction j. The tensor is a
+		 * shared intermediate: several dynamics re-derive velocity-difference
+		 * terms of the same mathematical object, and consuming the registered
+		 * variable instead saves their neighborhood sweeps. The evaluation is
+		 * cached, so repeated executions within one step, e.g. triggered by
+		 * several consumers, perform the sweep only once; the cache is keyed
+		 * on the physical time and the configuration version, as the velocity
+		 * only advances together with these in the stepping loops.
+		 */
+		class VelocityGradientInner : public InteractionDynamics, public FluidDataInner
+		{
+		public:
+			explicit VelocityGradientInner(BaseBodyRelationInner &inner_relation);
+			virtual ~VelocityGradientInner(){};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
+		protected:
+			StdLargeVec<Real> &Vol_;
+			StdLargeVec<Vecd> &vel_n_;
+			StdLargeVec<Matd> vel_grad_;
+			bool evaluated_;
+			Real evaluation_time_;
+			size_t evaluated_configuration_version_;
+
+			/** check the cache and mark the pending evaluation as the fresh one */
+			bool upToDate();
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			/** the interaction body reading the kernel gradient vectors
+			 * precomputed at the configuration build. */
+			template <class NeighborhoodType>
+			void gradientInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
+		};
+
+		/**
+		 * @class ViscousAccelerationFromVelocityGradientInner
+		 * @brief the viscosity force induced acceleration as the divergence of the
+		 * shear stress built from the shared velocity gradient. Note that this is
+		 * a different discretization than the pairwise velocity-derivative form of
+		 * ViscousAccelerationInner: a second derivative can not be read off the
+		 * first-order gradient directly, so the stress divergence takes its own
+		 * sweep, which pays off when the gradient serves further consumers.
+		 */
+		class ViscousAccelerationFromVelocityGradientInner : public ViscousAccelerationInner
+		{
+		public:
+			ViscousAccelerationFromVelocityGradientInner(BaseBodyRelationInner &inner_relation,
+														 VelocityGradientInner &velocity_gradient);
+			virtual ~ViscousAccelerationFromVelocityGradientInner(){};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
+		protected:
+			VelocityGradientInner &velocity_gradient_;
+			StdLargeVec<Matd> &vel_grad_;
+
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			/** the interaction body reading the kernel gradient vectors
+			 * precomputed at the configuration build. */
+			template <class NeighborhoodType>
+			void stressDivergenceInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
+		};
+
+		/**
+		 * @class ImplicitViscousRelaxationInner
+		 * @brief matrix-free backward-Euler step of the viscous diffusion.
+		 * The linear system (I - dt * L) v^{n+1} = v^n, with L the viscous
+		 * operator over the inner-relation neighborhoods, is solved by Jacobi
+		 * iterations in which one matrix application is a plain interaction
+		 * sweep, so no matrix is ever assembled. The system is strictly
+		 * diagonally dominant for any time step, so the iteration converges
+		 * and the step is unconditionally stable. It updates the velocity
+		 * directly and replaces ViscousAccelerationInner, allowing
+		 * high-viscosity cases to advance with the time step of
+		 * AdvectionTimeStepSizeForImplicitViscosity instead of obeying
+		 * the explicit viscous limit.
+		 */
+		class ImplicitViscousRelaxationInner : public InteractionDynamics, public FluidDataInner
+		{
+		public:
+			explicit ImplicitViscousRelaxationInner(BaseBodyRelationInner &inner_relation,
+													size_t max_iterations = 50, Real relative_tolerance = 1.0e-6);
+			virtual ~ImplicitViscousRelaxationInner(){};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+			/** number of Jacobi iterations taken by the last linear solve */
+			size_t LastIterationCount() { return last_iteration_count_; };
+
+		protected:
+			Real mu_;
+			Real smoothing_length_;
+			size_t max_iterations_;
+			Real relative_tolerance_;
+			size_t last_iteration_count_;
+			StdLargeVec<Real> &Vol_, &rho_n_;
+			StdLargeVec<Vecd> &vel_n_;
+			StdLargeVec<Vecd> *vel_iterate_, *vel_update_; /**< double-buffered iterates of the linear solve */
+
+			/** one Jacobi row update, reading the current iterate and writing
+			 * the updated one; returns the norm of the iterate change. */
+			Real jacobiRowUpdate(size_t index_i, Real dt);
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		 * @class TransportVelocityCorrectionInner
 		 * @brief transport velocity correction
@@ -133,6 +263,10 @@ namespace SPH
 
 			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			/** the interaction body reading the kernel gradient vectors
+			 * precomputed at the configuration build. */
+			template <class NeighborhoodType>
+			void correctionInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood, Real dt);
 		};
 
 		/**
@@ -145,10 +279,20 @@ namespace SPH
 			explicit AcousticTimeStepSize(FluidBody &fluid_body);
 			virtual ~AcousticTimeStepSize(){};
 
+			/** switch on the lazy evaluation mode: the cached maximum signal speed is reused,
+			 * inflated by an acceleration-based growth bound, and the full reduction is only
+			 * rerun when the bound exceeds the tolerance. The mode acts on parallel_exec();
+			 * exec() always performs the full reduction. */
+			void useLazyEvaluation() { use_lazy_evaluation_ = true; };
+			virtual Real parallel_exec(Real dt = 0.0) override;
+
 		protected:
 			StdLargeVec<Real> &rho_n_, &p_;
 			StdLargeVec<Vecd> &vel_n_;
 			Real smoothing_length_;
+			bool use_lazy_evaluation_;
+			Real lazy_tolerance_;
+			Real evaluated_signal_speed_max_, evaluated_acceleration_max_, evaluation_time_;
 			Real ReduceFunction(size_t index_i, Real dt = 0.0) override;
 			Real OutputResult(Real reduced_value) override;
 		};
@@ -163,9 +307,16 @@ namespace SPH
 			explicit AdvectionTimeStepSize(FluidBody &fluid_body, Real U_max);
 			virtual ~AdvectionTimeStepSize(){};
 
+			/** switch on the lazy evaluation mode, as for AcousticTimeStepSize. */
+			void useLazyEvaluation() { use_lazy_evaluation_ = true; };
+			virtual Real parallel_exec(Real dt = 0.0) override;
+
 		protected:
 			Real smoothing_length_;
 			StdLargeVec<Vecd> &vel_n_;
+			bool use_lazy_evaluation_;
+			Real lazy_tolerance_;
+			Real evaluated_speed_max_, evaluated_acceleration_max_, evaluation_time_;
 			Real ReduceFunction(size_t index_i, Real dt = 0.0) override;
 			Real OutputResult(Real reduced_value) override;
 		};
@@ -198,6 +349,73 @@ namespace SPH
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class AsynchronousVorticityInner
+		 * @brief the vorticity computed on a dedicated worker thread concurrently
+		 * with the following simulation steps. The execution only snapshots the
+		 * velocities, volumes and the neighbor configuration and hands the
+		 * neighborhood sweep to the worker, so the step loop is not stalled by
+		 * this diagnostic at output cadence. finishAsynchronousComputation() must
+		 * be called before the vorticity is consumed, e.g. by a recorder.
+		 */
+		class AsynchronousVorticityInner : public VorticityInner
+		{
+		public:
+			explicit AsynchronousVorticityInner(BaseBodyRelationInner &inner_relation);
+			virtual ~AsynchronousVorticityInner();
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+			/** block until the worker thread has finished the pending computation */
+			void finishAsynchronousComputation();
+
+		protected:
+			StdLargeVec<Vecd> vel_snapshot_;
+			StdLargeVec<Real> Vol_snapshot_;
+			/** the configuration snapshot in compressed-sparse-row form. */
+			StdLargeVec<size_t> offsets_snapshot_;
+			StdLargeVec<size_t> j_snapshot_;
+			StdLargeVec<Real> dW_ij_snapshot_;
+			StdLargeVec<Vecd> displacement_snapshot_;
+			size_t snapshot_particle_count_;
+
+			void takeSnapshot();
+			void computeFromSnapshot();
+
+		private:
+			bool job_pending_;
+			bool terminate_worker_thread_;
+			std::thread worker_thread_;
+			std::mutex worker_mutex_;
+			std::condition_variable worker_condition_;
+
+			void dispatchComputation(Real dt);
+			void workerThreadLoop();
+		};
+
+		/**
+		 * @class VorticityFromVelocityGradient
+		 * @brief compute vorticity as the curl of the shared velocity gradient.
+		 * The neighborhood sweep of VorticityInner is replaced by a per-particle
+		 * read of the registered "VelocityGradient" variable, so the vorticity
+		 * comes at no sweep of its own when the gradient serves other dynamics.
+		 */
+		class VorticityFromVelocityGradient : public ParticleDynamicsSimple, public FluidDataSimple
+		{
+		public:
+			VorticityFromVelocityGradient(FluidBody &fluid_body, VelocityGradientInner &velocity_gradient);
+			virtual ~VorticityFromVelocityGradient(){};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
+		protected:
+			VelocityGradientInner &velocity_gradient_;
+			StdLargeVec<Matd> &vel_grad_;
+			StdLargeVec<AngularVecd> vorticity_;
+			virtual void Update(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		 * @class BaseRelaxation
 		 * @brief Pure abstract base class for all fluid relaxation schemes
@@ -244,6 +462,8 @@ namespace SPH
 
 		protected:
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void pressureInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 		using PressureRelaxationInner = BasePressureRelaxationInner<NoRiemannSolver>;
 		/** define the mostly used pressure relaxation scheme using Riemann solver */
@@ -279,6 +499,8 @@ namespace SPH
 
 		protected:
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void densityInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 		using DensityRelaxationInner = BaseDensityRelaxationInner<NoRiemannSolver>;
 		/** define the mostly used density relaxation scheme using Riemann solver */
@@ -21,15 +21,36 @@ namespace SPH
 		//=================================================================================================//
 		template <class RiemannSolverType>
 		void BasePressureRelaxationInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			if (inner_relation_->usingRecomputedPairGeometry())
+			{
+				inner_relation_->usingCompactConfiguration()
+					? pressureInteraction(index_i, RecomputingNeighborhood<CompactNeighborhood>(
+													   compact_inner_configuration_[index_i], pos_n_, pos_n_[index_i]))
+					: pressureInteraction(index_i, RecomputingNeighborhood<Neighborhood>(
+													   inner_configuration_[index_i], pos_n_, pos_n_[index_i]));
+				return;
+			}
+			inner_relation_->usingCompactConfiguration()
+				? pressureInteraction(index_i, compact_inner_configuration_[index_i])
+				: pressureInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class RiemannSolverType>
+		template <class NeighborhoodType>
+		void BasePressureRelaxationInner<RiemannSolverType>::
+			pressureInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
 			Vecd acceleration = dvel_dt_prior_[index_i];
-			Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, rho_n_);
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, p_);
 				Real dW_ij = inner_neighborhood.dW_ij_[n];
-				Vecd &e_ij = inner_neighborhood.e_ij_[n];
+				const Vecd &e_ij = inner_neighborhood.e_ij_[n];
 
 				FluidState state_j(rho_n_[index_j], vel_n_[index_j], p_[index_j]);
 				Real p_star = riemann_solver_.getPStar(state_i, state_j, e_ij);
@@ -45,14 +66,35 @@ namespace SPH
 		//=================================================================================================//
 		template <class RiemannSolverType>
 		void BaseDensityRelaxationInner<RiemannSolverType>::Interaction(size_t index_i, Real dt)
+		{
+			if (inner_relation_->usingRecomputedPairGeometry())
+			{
+				inner_relation_->usingCompactConfiguration()
+					? densityInteraction(index_i, RecomputingNeighborhood<CompactNeighborhood>(
+													  compact_inner_configuration_[index_i], pos_n_, pos_n_[index_i]))
+					: densityInteraction(index_i, RecomputingNeighborhood<Neighborhood>(
+													  inner_configuration_[index_i], pos_n_, pos_n_[index_i]));
+				return;
+			}
+			inner_relation_->usingCompactConfiguration()
+				? densityInteraction(index_i, compact_inner_configuration_[index_i])
+				: densityInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class RiemannSolverType>
+		template <class NeighborhoodType>
+		void BaseDensityRelaxationInner<RiemannSolverType>::
+			densityInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			FluidState state_i(rho_n_[index_i], vel_n_[index_i], p_[index_i]);
 			Real density_change_rate = 0.0;
-			Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
-				Vecd &e_ij = inner_neighborhood.e_ij_[n];
+				prefetchGatheredData(inner_neighborhood, n, rho_n_);
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, p_);
+				const Vecd &e_ij = inner_neighborhood.e_ij_[n];
 				Real dW_ij = inner_neighborhood.dW_ij_[n];
 
 				FluidState state_j(rho_n_[index_j], vel_n_[index_j], p_[index_j]);
@@ -27,6 +27,8 @@ namespace SPH
 			{
 				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
 				contact_vel_n_.push_back(&(contact_particles_[k]->vel_n_));
+				Real mu_j = contact_material_[k]->ReferenceViscosity();
+				contact_mu_ij_.push_back(2.0 * mu_ * mu_j / (mu_ + mu_j));
 			}
 		}
 		//=================================================================================================//
@@ -45,7 +47,7 @@ namespace SPH
 			Vecd acceleration(0), vel_derivative(0);
 			for (size_t k = 0; k < this->contact_configuration_.size(); ++k)
 			{
-				Real mu_j = this->contact_material_[k]->ReferenceViscosity();
+				Real mu_ij = this->contact_mu_ij_[k];
 				StdLargeVec<Real> &Vol_k = *(this->contact_Vol_[k]);
 				StdLargeVec<Vecd> &vel_k = *(this->contact_vel_n_[k]);
 				Neighborhood &contact_neighborhood = (*this->contact_configuration_[k])[index_i];
@@ -56,7 +58,6 @@ namespace SPH
 
 					vel_derivative = 2.0 * (vel_i - vel_k[index_j]) /
 									 (r_ij + 0.01 * this->smoothing_length_);
-					Real mu_ij = 2.0 * this->mu_ * mu_j / (this->mu_ + mu_j);
 					acceleration += 2.0 * mu_ij * vel_derivative *
 									contact_neighborhood.dW_ij_[n] * Vol_k[index_j] / rho_i;
 				}
@@ -78,6 +79,7 @@ namespace SPH
 			{
 				Real rho0_k = contact_particles_[k]->rho0_;
 				contact_rho0_.push_back(rho0_k);
+				contact_rho0_ij_.push_back(rho0_ / (rho0_ + rho0_k));
 				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
 			}
 		}
@@ -90,14 +92,13 @@ namespace SPH
 			{
 				for (size_t k = 0; k < contact_configuration_.size(); ++k)
 				{
-					Real rho0_k = contact_rho0_[k];
+					Real rho_ij = contact_rho0_ij_[k];
 					StdLargeVec<Real> &contact_vol_k = *(contact_Vol_[k]);
 					Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						size_t index_j = contact_neighborhood.j_[n];
 						/** Norm of interface.*/
-						Real rho_ij = rho0_ / (rho0_ + rho0_k);
 						Real area_ij = (vol_i * vol_i +
 										contact_vol_k[index_j] * contact_vol_k[index_j]) *
 									   contact_neighborhood.dW_ij_[n];
@@ -54,6 +54,9 @@ namespace SPH
 		protected:
 			StdVec<StdLargeVec<Real>*> contact_Vol_;
 			StdVec<StdLargeVec<Vecd>*> contact_vel_n_;
+			/** harmonic average of the two phase viscosities,
+			 * a constant per phase pair resolved at construction */
+			StdVec<Real> contact_mu_ij_;
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
@@ -141,6 +144,9 @@ namespace SPH
 		protected:
 			Real rho0_;
 			StdVec<Real> contact_rho0_;
+			/** density fraction of this phase in each phase pair,
+			 * a constant resolved at construction */
+			StdVec<Real> contact_rho0_ij_;
 			StdLargeVec<Real>& Vol_, & pos_div_;
 			StdLargeVec<int>& surface_indicator_;
 			StdLargeVec<Vecd> color_grad_, surface_norm_;
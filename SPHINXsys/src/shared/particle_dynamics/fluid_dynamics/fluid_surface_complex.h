@@ -64,6 +64,37 @@ namespace SPH
 		/** the case with free stream */
 		using DensitySummationFreeStreamComplex = DensitySummation<DensitySummationFreeStreamInner>;
 
+		/** the member dynamics of the fused free-surface density summation,
+		 * constructed before the combining base class. */
+		struct FreeSurfaceDensitySummationPair
+		{
+			FreeSurfaceIndicationComplex free_surface_indication_;
+			DensitySummationFreeSurfaceComplex density_summation_;
+
+			FreeSurfaceDensitySummationPair(ComplexBodyRelation &complex_relation, Real thereshold)
+				: free_surface_indication_(complex_relation, thereshold),
+				  density_summation_(complex_relation){};
+		};
+
+		/**
+		* @class DensitySummationFreeSurfaceFusedComplex
+		* @brief the free-surface indication and the density summation with
+		* free-surface correction carried out in one neighborhood sweep, so
+		* that the position and mass arrays are streamed from memory once
+		* instead of once per pass. The free-stream variant can not be fused
+		* this way, as its density update reads the surface indicators of the
+		* neighboring particles while the fused update is still writing them.
+		*/
+		class DensitySummationFreeSurfaceFusedComplex
+			: public FreeSurfaceDensitySummationPair, public CombinedInteractionDynamicsWithUpdate
+		{
+		public:
+			explicit DensitySummationFreeSurfaceFusedComplex(ComplexBodyRelation &complex_relation, Real thereshold = 0.75)
+				: FreeSurfaceDensitySummationPair(complex_relation, thereshold),
+				  CombinedInteractionDynamicsWithUpdate(free_surface_indication_, density_summation_){};
+			virtual ~DensitySummationFreeSurfaceFusedComplex(){};
+		};
+
 		/**
 		* @class ColorFunctionGradientComplex
 		* @brief indicate the particles near the free fluid surface.
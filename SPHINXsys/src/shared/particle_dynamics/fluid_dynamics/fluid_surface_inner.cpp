@@ -18,13 +18,104 @@ namespace SPH
               thereshold_by_dimensions_(thereshold * (Real)Dimensions),
               Vol_(particles_->Vol_),
               surface_indicator_(particles_->surface_indicator_),
-              smoothing_length_(inner_relation.sph_body_->sph_adaptation_->ReferenceSmoothingLength())
+              smoothing_length_(inner_relation.sph_body_->sph_adaptation_->ReferenceSmoothingLength()),
+              pos_n_(particles_->pos_n_), cell_linked_list_(nullptr),
+              use_incremental_indication_(false), full_sweep_(true),
+              full_refresh_interval_(0), sweeps_since_full_refresh_(0)
         {
             particles_->registerAVariable(pos_div_, "PositionDivergence");
         }
         //=================================================================================================//
+        void FreeSurfaceIndicationInner::useIncrementalIndication(size_t full_refresh_interval)
+        {
+            cell_linked_list_ = dynamic_cast<CellLinkedList *>(body_->cell_linked_list_);
+            if (cell_linked_list_ == nullptr)
+            {
+                std::cout << "\n Error: incremental free-surface indication requires a single-level cell linked list!" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+            use_incremental_indication_ = true;
+            full_refresh_interval_ = full_refresh_interval;
+            /** the out-of-band particles retain their indication state across
+             * sweeps, so it has to follow them through particle sorting. */
+            particles_->registerASortableVariable<int>("SurfaceIndicator");
+            particles_->registerASortableVariable<Real>("PositionDivergence");
+            /** the first sweep is a full one so that the cell tags get accumulated. */
+            sweeps_since_full_refresh_ = full_refresh_interval;
+            Vecu number_of_cells = cell_linked_list_->NumberOfCells();
+            size_t total_number_of_cells = number_of_cells[0];
+            for (int axis = 1; axis != Dimensions; ++axis)
+                total_number_of_cells *= number_of_cells[axis];
+            surface_cell_tags_.resize(total_number_of_cells, 0);
+            band_cell_tags_.resize(total_number_of_cells, 0);
+        }
+        //=================================================================================================//
+        void FreeSurfaceIndicationInner::setupDynamics(Real dt)
+        {
+            if (!use_incremental_indication_)
+                return;
+
+            full_sweep_ = sweeps_since_full_refresh_ >= full_refresh_interval_;
+            sweeps_since_full_refresh_ = full_sweep_ ? 1 : sweeps_since_full_refresh_ + 1;
+            if (!full_sweep_)
+            {
+                /** dilate the surface cells of the previous sweep by one cell ring. */
+                std::fill(band_cell_tags_.begin(), band_cell_tags_.end(), 0);
+                Vecu number_of_cells = cell_linked_list_->NumberOfCells();
+                size_t number_of_neighbor_cells = 1;
+                for (int axis = 0; axis != Dimensions; ++axis)
+                    number_of_neighbor_cells *= 3;
+                for (size_t l = 0; l != surface_cell_tags_.size(); ++l)
+                {
+                    if (surface_cell_tags_[l] == 0)
+                        continue;
+                    Vecu cell_index = cell_linked_list_->transfer1DtoMeshIndex(number_of_cells, l);
+                    for (size_t s = 0; s != number_of_neighbor_cells; ++s)
+                    {
+                        Vecu neighbor_index = cell_index;
+                        size_t offset_code = s;
+                        bool within_mesh = true;
+                        for (int axis = 0; axis != Dimensions; ++axis)
+                        {
+                            int shifted = int(cell_index[axis]) + int(offset_code % 3) - 1;
+                            offset_code /= 3;
+                            if (shifted < 0 || shifted >= int(number_of_cells[axis]))
+                            {
+                                within_mesh = false;
+                                break;
+                            }
+                            neighbor_index[axis] = size_t(shifted);
+                        }
+                        if (within_mesh)
+                            band_cell_tags_[cell_linked_list_->transferMeshIndexTo1D(number_of_cells, neighbor_index)] = 1;
+                    }
+                }
+            }
+            /** the surface cells are re-accumulated during the update sweep. */
+            std::fill(surface_cell_tags_.begin(), surface_cell_tags_.end(), 0);
+        }
+        //=================================================================================================//
+        bool FreeSurfaceIndicationInner::withinSurfaceBand(size_t index_i)
+        {
+            Vecu cell_index = cell_linked_list_->CellIndexFromPosition(pos_n_[index_i]);
+            return band_cell_tags_[cell_linked_list_->transferMeshIndexTo1D(
+                       cell_linked_list_->NumberOfCells(), cell_index)] != 0;
+        }
+        //=================================================================================================//
+        void FreeSurfaceIndicationInner::tagSurfaceCell(size_t index_i)
+        {
+            Vecu cell_index = cell_linked_list_->CellIndexFromPosition(pos_n_[index_i]);
+            /** concurrent writes all store the same value, so no synchronization is needed. */
+            surface_cell_tags_[cell_linked_list_->transferMeshIndexTo1D(
+                cell_linked_list_->NumberOfCells(), cell_index)] = 1;
+        }
+        //=================================================================================================//
         void FreeSurfaceIndicationInner::Interaction(size_t index_i, Real dt)
         {
+            if (!full_sweep_ && !withinSurfaceBand(index_i))
+                return;
+
             Real pos_div = 0.0;
             const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
             for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -36,6 +127,9 @@ namespace SPH
         //=================================================================================================//
         void FreeSurfaceIndicationInner::Update(size_t index_i, Real dt)
         {
+            if (!full_sweep_ && !withinSurfaceBand(index_i))
+                return;
+
             bool is_free_surface = pos_div_[index_i] < thereshold_by_dimensions_ ? true : false;
 
             const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
@@ -50,6 +144,8 @@ namespace SPH
                 }
             }
             surface_indicator_[index_i] = is_free_surface ? 1 : 0;
+            if (use_incremental_indication_ && is_free_surface)
+                tagSurfaceCell(index_i);
         }
         //=================================================================================================//
         void DensitySummationFreeStreamInner::Update(size_t index_i, Real dt)
@@ -206,6 +302,121 @@ namespace SPH
             dvel_dt_prior_[index_i] -= acceleration / mass_[index_i];
         }
         //=================================================================================================//
+        SurfaceTensionPipelineInner::SurfaceTensionPipelineInner(BaseBodyRelationInner &inner_relation, Real gamma)
+            : InteractionDynamics(*inner_relation.sph_body_), FluidDataInner(inner_relation),
+              thereshold_by_dimensions_((0.75 * (Real)Dimensions)), gamma_(gamma),
+              Vol_(particles_->Vol_), mass_(particles_->mass_),
+              dvel_dt_prior_(particles_->dvel_dt_prior_),
+              surface_indicator_(particles_->surface_indicator_),
+              pos_div_(*particles_->getVariableByName<Real>("PositionDivergence")),
+              functor_gradient_(std::bind(&SurfaceTensionPipelineInner::GradientInteraction, this, _1, _2)),
+              functor_interpolation_(std::bind(&SurfaceTensionPipelineInner::InterpolationInteraction, this, _1, _2))
+        {
+            particles_->registerAVariable(color_grad_, "ColorGradient");
+            particles_->registerAVariable(surface_norm_, "SurfaceNormal");
+        }
+        //=================================================================================================//
+        SurfaceTensionPipelineInner::SurfaceTensionPipelineInner(BaseBodyRelationInner &inner_relation)
+            : SurfaceTensionPipelineInner(inner_relation, 1.0) {}
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::collectSurfaceParticles()
+        {
+            surface_particle_indices_.clear();
+            size_t total_real_particles = particles_->total_real_particles_;
+            for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+            {
+                if (surface_indicator_[index_i] == 1)
+                    surface_particle_indices_.push_back(index_i);
+            }
+        }
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::GradientInteraction(size_t index_i, Real dt)
+        {
+            Vecd gradient(0);
+            const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+            if (pos_div_[index_i] < thereshold_by_dimensions_)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    gradient -= inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n] * Vol_[index_j];
+                }
+            }
+            color_grad_[index_i] = gradient;
+            surface_norm_[index_i] = gradient / (gradient.norm() + TinyReal);
+        }
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::InterpolationInteraction(size_t index_i, Real dt)
+        {
+            Vecd grad(0);
+            Real weight(0);
+            Real total_weight(0);
+            if (pos_div_[index_i] > thereshold_by_dimensions_)
+            {
+                Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    if (surface_indicator_[index_j] == 1 && pos_div_[index_j] < thereshold_by_dimensions_)
+                    {
+                        weight = inner_neighborhood.W_ij_[n] * Vol_[index_j];
+                        grad += weight * color_grad_[index_j];
+                        total_weight += weight;
+                    }
+                }
+                Vecd grad_norm = grad / (total_weight + TinyReal);
+                color_grad_[index_i] = grad_norm;
+                surface_norm_[index_i] = grad_norm / (grad_norm.norm() + TinyReal);
+            }
+        }
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::Interaction(size_t index_i, Real dt)
+        {
+            Vecd n_i = surface_norm_[index_i];
+            Real curvature(0.0);
+            Real renormalized_curvature(0);
+            Real pos_div(0);
+            Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = inner_neighborhood.j_[n];
+                if (surface_indicator_[index_j] == 1)
+                {
+                    Vecd n_j = surface_norm_[index_j];
+                    Vecd n_ij = n_i - n_j;
+                    curvature -= inner_neighborhood.dW_ij_[n] * Vol_[index_j] * dot(n_ij, inner_neighborhood.e_ij_[n]);
+                    pos_div -= inner_neighborhood.dW_ij_[n] * inner_neighborhood.r_ij_[n] * Vol_[index_j];
+                }
+            }
+            renormalized_curvature = (Real)Dimensions * curvature / ABS(pos_div + TinyReal);
+            Vecd acceleration = gamma_ * renormalized_curvature * color_grad_[index_i] * Vol_[index_i];
+            dvel_dt_prior_[index_i] -= acceleration / mass_[index_i];
+        }
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::exec(Real dt)
+        {
+            tick_count start_time = tick_count::now();
+            setBodyUpdated();
+            setupDynamics(dt);
+            collectSurfaceParticles();
+            PartIteratorByParticle(surface_particle_indices_, functor_gradient_, dt);
+            PartIteratorByParticle(surface_particle_indices_, functor_interpolation_, dt);
+            PartIteratorByParticle(surface_particle_indices_, functor_interaction_, dt);
+            recordExecutionTiming(start_time);
+        }
+        //=================================================================================================//
+        void SurfaceTensionPipelineInner::parallel_exec(Real dt)
+        {
+            tick_count start_time = tick_count::now();
+            setBodyUpdated();
+            setupDynamics(dt);
+            collectSurfaceParticles();
+            PartIteratorByParticle_parallel(surface_particle_indices_, functor_gradient_, dt);
+            PartIteratorByParticle_parallel(surface_particle_indices_, functor_interpolation_, dt);
+            PartIteratorByParticle_parallel(surface_particle_indices_, functor_interaction_, dt);
+            recordExecutionTiming(start_time);
+        }
+        //=================================================================================================//
     }
     //=================================================================================================//
 }
@@ -51,15 +51,39 @@ namespace SPH
 			explicit FreeSurfaceIndicationInner(BaseBodyRelationInner &inner_relation, Real thereshold = 0.75);
 			virtual ~FreeSurfaceIndicationInner(){};
 
+			/**
+			 * Re-evaluate the indicator only for particles within a band of the
+			 * previous free surface, tracked by cell tags on the cell linked list:
+			 * cells which contained a surface particle in the previous sweep,
+			 * dilated by one cell ring. Particles outside the band keep their
+			 * indicator and position divergence, which is admissible because the
+			 * surface moves less than one cell width between two indications.
+			 * A full sweep every full_refresh_interval executions guards against
+			 * surfaces appearing in the bulk, e.g. from entrapped air.
+			 */
+			void useIncrementalIndication(size_t full_refresh_interval = 100);
+			bool usingIncrementalIndication() { return use_incremental_indication_; };
+
 		protected:
 			Real thereshold_by_dimensions_;
 			StdLargeVec<Real> &Vol_;
 			StdLargeVec<int> &surface_indicator_;
 			StdLargeVec<Real> pos_div_;
 			Real smoothing_length_;
+			StdLargeVec<Vecd> &pos_n_;
+			CellLinkedList *cell_linked_list_; /**< cell geometry for the surface-band tags */
+			bool use_incremental_indication_;
+			bool full_sweep_;				   /**< whether the present sweep covers all particles */
+			size_t full_refresh_interval_;
+			size_t sweeps_since_full_refresh_;
+			StdVec<int> surface_cell_tags_;	   /**< cells containing a surface particle after the last sweep */
+			StdVec<int> band_cell_tags_;	   /**< the surface cells dilated by one cell ring */
 
+			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
+			bool withinSurfaceBand(size_t index_i);
+			void tagSurfaceCell(size_t index_i);
 		};
 
 		/**
@@ -231,6 +255,47 @@ namespace SPH
 
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
+
+		/**
+		 * @class SurfaceTensionPipelineInner
+		 * @brief The color-function gradient, its interpolation correction and the
+		 * surface-tension acceleration carried out by one dynamics, with all three
+		 * particle loops restricted to the particles presently indicated as surface.
+		 * The stages can not share a single sweep, because the correction reads the
+		 * gradients of neighboring particles and the acceleration their corrected
+		 * normals, so one barrier remains between consecutive stages.
+		 * Skipping the bulk particles is exact: the gradient is only computed where
+		 * the position divergence is below the threshold, which implies a surface
+		 * particle, and the acceleration of a bulk particle vanishes identically.
+		 */
+		class SurfaceTensionPipelineInner : public InteractionDynamics, public FluidDataInner
+		{
+		public:
+			SurfaceTensionPipelineInner(BaseBodyRelationInner &inner_relation, Real gamma);
+			explicit SurfaceTensionPipelineInner(BaseBodyRelationInner &inner_relation);
+			virtual ~SurfaceTensionPipelineInner(){};
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
+		protected:
+			Real thereshold_by_dimensions_;
+			Real gamma_;
+			StdLargeVec<Real> &Vol_, &mass_;
+			StdLargeVec<Vecd> &dvel_dt_prior_;
+			StdLargeVec<int> &surface_indicator_;
+			StdLargeVec<Vecd> color_grad_;
+			StdLargeVec<Vecd> surface_norm_;
+			StdLargeVec<Real> &pos_div_;
+			IndexVector surface_particle_indices_;
+			ParticleFunctor functor_gradient_;
+			ParticleFunctor functor_interpolation_;
+
+			void collectSurfaceParticles();
+			void GradientInteraction(size_t index_i, Real dt = 0.0);
+			void InterpolationInteraction(size_t index_i, Real dt = 0.0);
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
 	}
 }
 #endif //FLUID_SURFACE_INNER_H
\ No newline at end of file
@@ -6,3 +6,5 @@ general dynamics used in SPHinXsys.
 
 #include "general_dynamics.h"
 #include "general_bounding.h"
+#include "particle_activity_gating.h"
+#include "particle_refinement.h"
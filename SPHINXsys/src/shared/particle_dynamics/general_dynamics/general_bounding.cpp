@@ -116,18 +116,24 @@ namespace SPH
 		CellLists &lower_bound_cells = bound_cells_[0];
 		for (size_t i = 0; i != lower_bound_cells.size(); ++i)
 		{
-			ListDataVector &cell_list_data = lower_bound_cells[i]->cell_list_data_;
-			for (size_t num = 0; num < cell_list_data.size(); ++num)
-				checkLowerBound(cell_list_data[num], dt);
+			CellList &cell_list = *lower_bound_cells[i];
+			for (size_t num = 0; num < cell_list.cell_list_indexes_.size(); ++num)
+			{
+				ListData list_data(cell_list.cell_list_indexes_[num], cell_list.cell_list_positions_[num]);
+				checkLowerBound(list_data, dt);
+			}
 		}
 
 		// check upper bound
 		CellLists &upper_bound_cells = bound_cells_[1];
 		for (size_t i = 0; i != upper_bound_cells.size(); ++i)
 		{
-			ListDataVector &cell_list_data = upper_bound_cells[i]->cell_list_data_;
-			for (size_t num = 0; num < cell_list_data.size(); ++num)
-				checkUpperBound(cell_list_data[num], dt);
+			CellList &cell_list = *upper_bound_cells[i];
+			for (size_t num = 0; num < cell_list.cell_list_indexes_.size(); ++num)
+			{
+				ListData list_data(cell_list.cell_list_indexes_[num], cell_list.cell_list_positions_[num]);
+				checkUpperBound(list_data, dt);
+			}
 		}
 	}
 	//=================================================================================================//
@@ -170,6 +176,13 @@ namespace SPH
 	void OpenBoundaryConditionInAxisDirection ::
 		ParticleTypeTransfer::checkLowerBound(size_t index_i, Real dt)
 	{
+		if (recycle_departed_particles_)
+		{
+			if (pos_n_[index_i][axis_] < body_domain_bounds_.first[axis_])
+				particles_->recycleAParticle(index_i);
+			return;
+		}
+
 		while (index_i < particles_->total_real_particles_ && pos_n_[index_i][axis_] < body_domain_bounds_.first[axis_])
 		{
 			particles_->switchToBufferParticle(index_i);
@@ -179,6 +192,13 @@ namespace SPH
 	void OpenBoundaryConditionInAxisDirection ::
 		ParticleTypeTransfer::checkUpperBound(size_t index_i, Real dt)
 	{
+		if (recycle_departed_particles_)
+		{
+			if (pos_n_[index_i][axis_] > body_domain_bounds_.second[axis_])
+				particles_->recycleAParticle(index_i);
+			return;
+		}
+
 		while (index_i < particles_->total_real_particles_ && pos_n_[index_i][axis_] > body_domain_bounds_.second[axis_])
 		{
 			particles_->switchToBufferParticle(index_i);
@@ -206,13 +226,31 @@ namespace SPH
 			for (size_t num = 0; num < particle_indexes.size(); ++num)
 				checking_bound_(particle_indexes[num], dt);
 		}
+
+		// only resolve the recycled slots when the fragmentation degrades
+		// the iteration efficiency, otherwise leave them for reuse
+		if (recycle_departed_particles_ &&
+			Real(particles_->NumberOfRecycledSlots()) >
+				max_fragmentation_ratio_ * Real(particles_->total_real_particles_))
+			particles_->compactRecycledParticleSlots();
 	}
 	//=================================================================================================//
 	void PeriodicConditionInAxisDirectionUsingGhostParticles::
 		CreatPeriodicGhostParticles::setupDynamics(Real dt)
 	{
+		size_t number_of_ghosts_last_step = 0;
 		for (size_t i = 0; i != ghost_particles_.size(); ++i)
-			ghost_particles_[i].clear();
+		{
+			number_of_ghosts_last_step += ghost_particles_[i].size();
+			if (use_ghost_pool_)
+				ghost_sources_[i].clear();
+			else
+				ghost_particles_[i].clear();
+		}
+		/* the ghost population is nearly the same between advection steps, so keeping
+		   the head room from the previous step recreates the ghosts without growing
+		   the particle arrays one entry at a time. */
+		particles_->reserveParticleCapacity(particles_->real_particles_bound_ + number_of_ghosts_last_step);
 	}
 	//=================================================================================================//
 	void PeriodicConditionInAxisDirectionUsingGhostParticles::
@@ -222,6 +260,11 @@ namespace SPH
 		if (particle_position[axis_] > body_domain_bounds_.first[axis_] &&
 			particle_position[axis_] < (body_domain_bounds_.first[axis_] + cut_off_radius_max_))
 		{
+			if (use_ghost_pool_)
+			{
+				ghost_sources_[0].push_back(index_i);
+				return;
+			}
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_[0].push_back(expected_particle_index);
 			Vecd translated_position = particle_position + periodic_translation_;
@@ -237,6 +280,11 @@ namespace SPH
 		if (particle_position[axis_] < body_domain_bounds_.second[axis_] &&
 			particle_position[axis_] > (body_domain_bounds_.second[axis_] - cut_off_radius_max_))
 		{
+			if (use_ghost_pool_)
+			{
+				ghost_sources_[1].push_back(index_i);
+				return;
+			}
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_[1].push_back(expected_particle_index);
 			Vecd translated_position = particle_position - periodic_translation_;
@@ -245,6 +293,56 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void PeriodicConditionInAxisDirectionUsingGhostParticles::
+		CreatPeriodicGhostParticles::exec(Real dt)
+	{
+		PeriodicBounding::exec(dt);
+		if (use_ghost_pool_)
+			populateGhostPool(dt);
+	}
+	//=================================================================================================//
+	void PeriodicConditionInAxisDirectionUsingGhostParticles::
+		CreatPeriodicGhostParticles::populateGhostPool(Real dt)
+	{
+		size_t lower_ghosts = ghost_sources_[0].size();
+		size_t total_ghosts = lower_ghosts + ghost_sources_[1].size();
+		size_t first_slot = particles_->claimGhostParticles(total_ghosts);
+
+		/* the pooled slots are claimed contiguously in a stable order, so each
+		   ghost keeps its slot as long as the ghost population is unchanged */
+		for (size_t i = 0; i != ghost_particles_.size(); ++i)
+			ghost_particles_[i].clear();
+		for (size_t n = 0; n != total_ghosts; ++n)
+			ghost_particles_[n < lower_ghosts ? 0 : 1].push_back(first_slot + n);
+
+		StdLargeVec<size_t> &sorted_id = particles_->sorted_id_;
+		parallel_for(
+			blocked_range<size_t>(0, total_ghosts),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t source_index = n < lower_ghosts
+											  ? ghost_sources_[0][n]
+											  : ghost_sources_[1][n - lower_ghosts];
+					particles_->copyFromAnotherParticle(first_slot + n, source_index);
+					/** For a ghost particle, its sorted id is that of corresponding real particle. */
+					sorted_id[first_slot + n] = source_index;
+				}
+			},
+			ap);
+
+		// the cell list data is not concurrent, so the entries are inserted sequentially
+		for (size_t n = 0; n != total_ghosts; ++n)
+		{
+			size_t ghost_index = first_slot + n;
+			Vecd translated_position = n < lower_ghosts
+										   ? pos_n_[ghost_index] + periodic_translation_
+										   : pos_n_[ghost_index] - periodic_translation_;
+			cell_linked_list_->InsertACellLinkedListDataEntry(ghost_index, translated_position);
+		}
+	}
+	//=================================================================================================//
 	void PeriodicConditionInAxisDirectionUsingGhostParticles::
 		UpdatePeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 	{
@@ -311,7 +409,8 @@ namespace SPH
 	MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::
 		CreatingGhostParticles(IndexVector &ghost_particles,
 							   CellLists &bound_cells, RealBody &real_body, int axis_direction, bool positive)
-		: MirrorBounding(bound_cells, real_body, axis_direction, positive), ghost_particles_(ghost_particles) {}
+		: MirrorBounding(bound_cells, real_body, axis_direction, positive),
+		  ghost_particles_(ghost_particles), positive_(positive), use_ghost_pool_(false) {}
 	//=================================================================================================//
 	MirrorBoundaryConditionInAxisDirection::UpdatingGhostStates::
 		UpdatingGhostStates(IndexVector &ghost_particles, CellLists &bound_cells,
@@ -351,9 +450,9 @@ namespace SPH
 		setupDynamics(dt);
 		for (size_t i = 0; i != bound_cells_.size(); ++i)
 		{
-			ListDataVector &list_data = bound_cells_[i]->cell_list_data_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				checking_bound_(list_data[num].first, dt);
+			IndexVector &cell_list_indexes = bound_cells_[i]->cell_list_indexes_;
+			for (size_t num = 0; num < cell_list_indexes.size(); ++num)
+				checking_bound_(cell_list_indexes[num], dt);
 		}
 	}
 	//=================================================================================================//
@@ -366,9 +465,9 @@ namespace SPH
 			{
 				for (size_t i = r.begin(); i < r.end(); ++i)
 				{
-					ListDataVector &list_data = bound_cells_[i]->cell_list_data_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						checking_bound_(list_data[num].first, dt);
+					IndexVector &cell_list_indexes = bound_cells_[i]->cell_list_indexes_;
+					for (size_t num = 0; num < cell_list_indexes.size(); ++num)
+						checking_bound_(cell_list_indexes[num], dt);
 				}
 			},
 			ap);
@@ -380,6 +479,11 @@ namespace SPH
 		if (particle_position[axis_] > body_domain_bounds_.first[axis_] &&
 			particle_position[axis_] < (body_domain_bounds_.first[axis_] + cut_off_radius_max_))
 		{
+			if (use_ghost_pool_)
+			{
+				ghost_sources_.push_back(index_i);
+				return;
+			}
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_.push_back(expected_particle_index);
 			/** mirror boundary condition */
@@ -396,6 +500,11 @@ namespace SPH
 		if (particle_position[axis_] < body_domain_bounds_.second[axis_] &&
 			particle_position[axis_] > (body_domain_bounds_.second[axis_] - cut_off_radius_max_))
 		{
+			if (use_ghost_pool_)
+			{
+				ghost_sources_.push_back(index_i);
+				return;
+			}
 			size_t expected_particle_index = particles_->insertAGhostParticle(index_i);
 			ghost_particles_.push_back(expected_particle_index);
 			/** mirror boundary condition */
@@ -406,6 +515,47 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::exec(Real dt)
+	{
+		MirrorBounding::exec(dt);
+		if (use_ghost_pool_)
+			populateGhostPool(dt);
+	}
+	//=================================================================================================//
+	void MirrorBoundaryConditionInAxisDirection::CreatingGhostParticles::populateGhostPool(Real dt)
+	{
+		size_t total_ghosts = ghost_sources_.size();
+		size_t first_slot = particles_->claimGhostParticles(total_ghosts);
+		Vecd mirror_bound = positive_ ? body_domain_bounds_.second : body_domain_bounds_.first;
+
+		/* the pooled slots are claimed contiguously in a stable order, so each
+		   ghost keeps its slot as long as the ghost population is unchanged */
+		ghost_particles_.clear();
+		for (size_t n = 0; n != total_ghosts; ++n)
+			ghost_particles_.push_back(first_slot + n);
+
+		StdLargeVec<size_t> &sorted_id = particles_->sorted_id_;
+		parallel_for(
+			blocked_range<size_t>(0, total_ghosts),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t n = r.begin(); n != r.end(); ++n)
+				{
+					size_t ghost_index = first_slot + n;
+					particles_->copyFromAnotherParticle(ghost_index, ghost_sources_[n]);
+					/** For a ghost particle, its sorted id is that of corresponding real particle. */
+					sorted_id[ghost_index] = ghost_sources_[n];
+					/** mirror boundary condition */
+					mirrorInAxisDirection(ghost_index, mirror_bound, axis_);
+				}
+			},
+			ap);
+
+		// the cell list data is not concurrent, so the entries are inserted sequentially
+		for (size_t n = 0; n != total_ghosts; ++n)
+			cell_linked_list_->InsertACellLinkedListDataEntry(first_slot + n, pos_n_[first_slot + n]);
+	}
+	//=================================================================================================//
 	void MirrorBoundaryConditionInAxisDirection::UpdatingGhostStates::checkLowerBound(size_t index_i, Real dt)
 	{
 		particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
@@ -173,19 +173,36 @@ namespace SPH
 		protected:
 			StdVec<CellLists> &bound_cells_;
 			ParticleFunctor checking_bound_;
+			bool recycle_departed_particles_; /**< whether departed particles enter the free list. */
+			Real max_fragmentation_ratio_;	  /**< admissible fraction of recycled slots among the real particles. */
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0);
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0);
 
 		public:
 			ParticleTypeTransfer(StdVec<CellLists> &bound_cells, RealBody &real_body, int axis_direction, bool positive)
 				: BoundingInAxisDirection(real_body, axis_direction),
-				  bound_cells_(bound_cells)
+				  bound_cells_(bound_cells),
+				  recycle_departed_particles_(false), max_fragmentation_ratio_(0.05)
 			{
 				checking_bound_ = positive ? std::bind(&OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::checkUpperBound, this, _1, _2)
 										   : std::bind(&OpenBoundaryConditionInAxisDirection::ParticleTypeTransfer::checkLowerBound, this, _1, _2);
 			};
 			virtual ~ParticleTypeTransfer(){};
 
+			/** recycle departed particles into a free list instead of removing them
+			 * immediately, so that an injection, e.g. EmitterInflowInjecting, reuses
+			 * the slots without any live particle being moved. The departed particles
+			 * keep their last state beyond the open boundary until their slot is
+			 * resolved, which is confined to the sacrificial outflow region. The
+			 * free list is compacted in a batch only when the holes exceed the
+			 * given fraction of the real particles. */
+			void useSlotRecycling(Real max_fragmentation_ratio = 0.05)
+			{
+				recycle_departed_particles_ = true;
+				max_fragmentation_ratio_ = max_fragmentation_ratio;
+			};
+			bool usingSlotRecycling() { return recycle_departed_particles_; };
+
 			/** This class is only implemented in sequential due to memory conflicts.
 			* Because the cell list data is not concurrent vector.
 			*/
@@ -223,21 +240,34 @@ namespace SPH
 		{
 		protected:
 			StdVec<IndexVector> &ghost_particles_;
+			/** whether the ghosts live in stable pooled slots updated in place */
+			bool use_ghost_pool_;
+			/** source real particle of each ghost gathered by the bounding sweep,
+			 * consumed by the pooled creation pass */
+			StdVec<IndexVector> ghost_sources_;
 			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+			/** claim pooled ghost slots for the gathered sources and refill
+			 * them by a parallel in-place copy pass */
+			void populateGhostPool(Real dt);
 
 		public:
 			CreatPeriodicGhostParticles(Vecd &periodic_translation, StdVec<CellLists> &bound_cells,
 										StdVec<IndexVector> &ghost_particles, RealBody &real_body, int axis_direction)
 				: PeriodicBounding(periodic_translation, bound_cells, real_body, axis_direction),
-				  ghost_particles_(ghost_particles){};
+				  ghost_particles_(ghost_particles), use_ghost_pool_(false)
+			{
+				ghost_sources_.resize(2);
+			};
 			virtual ~CreatPeriodicGhostParticles(){};
 
+			virtual void exec(Real dt = 0.0) override;
 			/** This class is only implemented in sequential due to memory conflicts.
 			 * Because creating ghost particle allocate memory.
 			 */
 			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			void useGhostPool() { use_ghost_pool_ = true; };
 		};
 
 		/**
@@ -274,6 +304,12 @@ namespace SPH
 
 		virtual ~PeriodicConditionInAxisDirectionUsingGhostParticles(){};
 
+		/** switch the ghost creation to persistent pooled slots: the bounding sweep
+		 * only gathers the ghost sources, the pooled slots are refilled by a parallel
+		 * in-place copy pass, and the particle data is compacted only when the
+		 * ghost count shrinks substantially. */
+		void usePersistentGhostPool() { ghost_creation_.useGhostPool(); };
+
 		PeriodicBounding bounding_;
 		CreatPeriodicGhostParticles ghost_creation_;
 		UpdatePeriodicGhostParticles ghost_update_;
@@ -317,16 +353,32 @@ namespace SPH
 		{
 		protected:
 			IndexVector &ghost_particles_;
-			virtual void setupDynamics(Real dt = 0.0) override { ghost_particles_.clear(); };
+			bool positive_;
+			/** whether the ghosts live in stable pooled slots updated in place */
+			bool use_ghost_pool_;
+			/** source real particle of each ghost gathered by the bounding sweep */
+			IndexVector ghost_sources_;
+			virtual void setupDynamics(Real dt = 0.0) override
+			{
+				if (use_ghost_pool_)
+					ghost_sources_.clear();
+				else
+					ghost_particles_.clear();
+			};
 			virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
 			virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+			/** claim pooled ghost slots for the gathered sources and refill
+			 * them by a parallel in-place copy pass */
+			void populateGhostPool(Real dt);
 
 		public:
 			CreatingGhostParticles(IndexVector &ghost_particles, CellLists &bound_cells,
 								   RealBody &real_body, int axis_direction, bool positive);
 			virtual ~CreatingGhostParticles(){};
+			virtual void exec(Real dt = 0.0) override;
 			/** This class is only implemented in sequential due to memory conflicts. */
 			virtual void parallel_exec(Real dt = 0.0) override { exec(); };
+			void useGhostPool() { use_ghost_pool_ = true; };
 		};
 
 		/**
@@ -358,6 +410,10 @@ namespace SPH
 		MirrorBoundaryConditionInAxisDirection(RealBody &real_body, int axis_direction, bool positive);
 		virtual ~MirrorBoundaryConditionInAxisDirection(){};
 
+		/** switch the ghost creation to persistent pooled slots, see the
+		 * periodic-with-ghost counterpart for the details. */
+		void usePersistentGhostPool() { creating_ghost_particles_.useGhostPool(); };
+
 		virtual void exec(Real dt = 0.0) override{};
 		virtual void parallel_exec(Real dt = 0.0) override{};
 	};
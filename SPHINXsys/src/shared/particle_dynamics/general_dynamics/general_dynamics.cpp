@@ -11,18 +11,60 @@ namespace SPH
 	TimeStepInitialization::TimeStepInitialization(SPHBody &sph_body)
 		: ParticleDynamicsSimple(sph_body), GeneralDataDelegateSimple(sph_body),
 		  pos_n_(particles_->pos_n_), dvel_dt_prior_(particles_->dvel_dt_prior_),
-		  gravity_(gravity_ptr_keeper_.createPtr<Gravity>(Vecd(0))) {}
+		  gravity_(gravity_ptr_keeper_.createPtr<Gravity>(Vecd(0))),
+		  prior_acceleration_fused_(false) {}
 	//=================================================================================================//
 	TimeStepInitialization ::TimeStepInitialization(SPHBody &sph_body, Gravity &gravity)
 		: ParticleDynamicsSimple(sph_body), GeneralDataDelegateSimple(sph_body),
 		  pos_n_(particles_->pos_n_), dvel_dt_prior_(particles_->dvel_dt_prior_),
-		  gravity_(&gravity) {}
+		  gravity_(&gravity),
+		  prior_acceleration_fused_(false) {}
 	//=================================================================================================//
 	void TimeStepInitialization::setupDynamics(Real dt)
 	{
 		particles_->total_ghost_particles_ = 0;
 	}
 	//=================================================================================================//
+	void TimeStepInitialization::exec(Real dt)
+	{
+		if (prior_acceleration_fused_)
+		{
+			setBodyUpdated();
+			setupDynamics(dt);
+			return;
+		}
+		tick_count start_time = tick_count::now();
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t total_real_particles = particles_->total_real_particles_;
+		gravity_->InducedAccelerationBlock(pos_n_.data(), dvel_dt_prior_.data(), total_real_particles);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void TimeStepInitialization::parallel_exec(Real dt)
+	{
+		if (prior_acceleration_fused_)
+		{
+			setBodyUpdated();
+			setupDynamics(dt);
+			return;
+		}
+		tick_count start_time = tick_count::now();
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t total_real_particles = particles_->total_real_particles_;
+		/** the prior accelerations are evaluated span by span, one virtual call each */
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				gravity_->InducedAccelerationBlock(pos_n_.data() + r.begin(),
+												   dvel_dt_prior_.data() + r.begin(), r.end() - r.begin());
+			},
+			ap);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
 	void TimeStepInitialization::Update(size_t index_i, Real dt)
 	{
 		dvel_dt_prior_[index_i] = gravity_->InducedAcceleration(pos_n_[index_i]);
@@ -62,13 +62,90 @@ namespace SPH
 		TimeStepInitialization(SPHBody &sph_body, Gravity &gravity);
 		virtual ~TimeStepInitialization(){};
 
+		/** The prior acceleration update is folded into a first interaction pass
+		 * of the step, e.g. by ViscousAccelerationInner::fuseTimeStepInitialization().
+		 * Only the ghost particle reset of this dynamics remains, so the full
+		 * sweep over the acceleration array is saved. The fused pass must be the
+		 * first dynamics of the step touching the prior acceleration. */
+		void skipPriorAccelerationUpdate() { prior_acceleration_fused_ = true; };
+		Gravity *getGravity() { return gravity_; };
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+
 	protected:
 		StdLargeVec<Vecd> &pos_n_, &dvel_dt_prior_;
 		Gravity *gravity_;
+		bool prior_acceleration_fused_;
 		virtual void setupDynamics(Real dt = 0.0) override;
 		virtual void Update(size_t index_i, Real dt = 0.0) override;
 	};
 
+	/**
+	 * @class TimeStepInitializationBatched
+	 * @brief Time step initialization with the acceleration field supplied as a
+	 * compile-time functor instead of the Gravity virtual. The field provides
+	 * Vecd operator()(const Vecd &position) const and is inlined into a plain
+	 * loop over the particle spans, so purely arithmetic fields, e.g. wave
+	 * makers or rotating frames, vectorize across the particles.
+	 */
+	template <class AccelerationField>
+	class TimeStepInitializationBatched
+		: public ParticleDynamicsSimple,
+		  public GeneralDataDelegateSimple
+	{
+	public:
+		TimeStepInitializationBatched(SPHBody &sph_body, AccelerationField acceleration_field)
+			: ParticleDynamicsSimple(sph_body), GeneralDataDelegateSimple(sph_body),
+			  pos_n_(particles_->pos_n_), dvel_dt_prior_(particles_->dvel_dt_prior_),
+			  acceleration_field_(acceleration_field){};
+		virtual ~TimeStepInitializationBatched(){};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = particles_->total_real_particles_;
+			for (size_t i = 0; i != total_real_particles; ++i)
+				dvel_dt_prior_[i] = acceleration_field_(pos_n_[i]);
+			recordExecutionTiming(start_time);
+		};
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = particles_->total_real_particles_;
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						dvel_dt_prior_[i] = acceleration_field_(pos_n_[i]);
+				},
+				ap);
+			recordExecutionTiming(start_time);
+		};
+
+	protected:
+		StdLargeVec<Vecd> &pos_n_, &dvel_dt_prior_;
+		AccelerationField acceleration_field_;
+		virtual void setupDynamics(Real dt = 0.0) override { particles_->total_ghost_particles_ = 0; };
+		virtual void Update(size_t index_i, Real dt = 0.0) override
+		{
+			dvel_dt_prior_[index_i] = acceleration_field_(pos_n_[index_i]);
+		};
+	};
+
+	/** deduce the field type of a batched time step initialization, e.g. from a lambda */
+	template <class AccelerationField>
+	TimeStepInitializationBatched<AccelerationField>
+	makeTimeStepInitializationBatched(SPHBody &sph_body, AccelerationField acceleration_field)
+	{
+		return TimeStepInitializationBatched<AccelerationField>(sph_body, acceleration_field);
+	}
+
 	/**
 	 * @class RandomizeParticlePosition
 	 * @brief Randomize the initial particle position
@@ -0,0 +1,165 @@
+/**
+ * @file 	particle_activity_gating.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#include "particle_activity_gating.h"
+
+#include "base_body.h"
+#include "base_particles.hpp"
+
+namespace SPH
+{
+	//=================================================================================================//
+	ParticleActivityGating::
+		ParticleActivityGating(RealBody &real_body, Real velocity_change_threshold,
+							   Real density_change_threshold, size_t inactive_step_interval)
+		: GeneralDataDelegateSimple(real_body),
+		  cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.cell_linked_list_)),
+		  velocity_change_threshold_(velocity_change_threshold),
+		  density_change_threshold_(density_change_threshold),
+		  inactive_step_interval_(inactive_step_interval),
+		  all_particles_active_(true)
+	{
+		particles_->registerAVariable(vel_at_refresh_, "GatingVelocityAtRefresh");
+		particles_->registerAVariable(rho_at_refresh_, "GatingDensityAtRefresh");
+		particles_->registerASortableVariable<Vecd>("GatingVelocityAtRefresh");
+		particles_->registerASortableVariable<Real>("GatingDensityAtRefresh");
+	}
+	//=================================================================================================//
+	void ParticleActivityGating::updateActivity()
+	{
+		size_t total_real_particles = particles_->total_real_particles_;
+		Vecu number_of_cells = cell_linked_list_->NumberOfCells();
+		size_t total_cells =
+			cell_linked_list_->transferMeshIndexTo1D(number_of_cells, number_of_cells - Vecu(1)) + 1;
+		if (cell_changed_.size() != total_cells)
+		{
+			cell_changed_.resize(total_cells);
+			cell_active_.resize(total_cells);
+			cell_active_buffer_.resize(total_cells);
+			// expired countdowns force a refresh of all cells on the first update
+			cell_refresh_countdown_.assign(total_cells, 0);
+		}
+		particle_cell_keys_.resize(total_real_particles);
+
+		StdLargeVec<Vecd> &pos_n = particles_->pos_n_;
+		StdLargeVec<Vecd> &vel_n = particles_->vel_n_;
+		StdLargeVec<Real> &rho_n = particles_->rho_n_;
+
+		/** mark the cells with particles beyond the change thresholds.
+		 * concurrent marks of the same cell all write one, so the race is benign. */
+		StdLargeVec<size_t> &cached_cell_indexes = cell_linked_list_->ParticleLinearCellIndexes();
+		bool use_cached_cell_indexes = cached_cell_indexes.size() == total_real_particles;
+		std::fill(cell_changed_.begin(), cell_changed_.end(), char(0));
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t cell_key = use_cached_cell_indexes
+										  ? cached_cell_indexes[i]
+										  : cell_linked_list_->transferMeshIndexTo1D(
+												number_of_cells, cell_linked_list_->CellIndexFromPosition(pos_n[i]));
+					particle_cell_keys_[i] = cell_key;
+					if ((vel_n[i] - vel_at_refresh_[i]).norm() > velocity_change_threshold_ ||
+						ABS(rho_n[i] - rho_at_refresh_[i]) > density_change_threshold_)
+					{
+						cell_changed_[cell_key] = 1;
+					}
+				}
+			},
+			ap);
+
+		/** quiescent cells are still refreshed at the reduced frequency */
+		parallel_for(
+			blocked_range<size_t>(0, total_cells),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t c = r.begin(); c != r.end(); ++c)
+				{
+					cell_active_[c] = cell_refresh_countdown_[c] == 0 ? 1 : cell_changed_[c];
+				}
+			},
+			ap);
+
+		dilateActiveCells(number_of_cells, total_cells);
+
+		parallel_for(
+			blocked_range<size_t>(0, total_cells),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t c = r.begin(); c != r.end(); ++c)
+				{
+					cell_refresh_countdown_[c] = cell_active_[c] != 0
+													 ? inactive_step_interval_
+													 : cell_refresh_countdown_[c] - 1;
+				}
+			},
+			ap);
+
+		/** snapshots of inactive particles stay valid because they are not integrated */
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					if (cell_active_[particle_cell_keys_[i]] != 0)
+					{
+						vel_at_refresh_[i] = vel_n[i];
+						rho_at_refresh_[i] = rho_n[i];
+					}
+				}
+			},
+			ap);
+
+		active_particles_.clear();
+		active_particles_.reserve(total_real_particles);
+		for (size_t i = 0; i != total_real_particles; ++i)
+		{
+			if (cell_active_[particle_cell_keys_[i]] != 0)
+				active_particles_.push_back(i);
+		}
+		all_particles_active_ = active_particles_.size() == total_real_particles;
+	}
+	//=================================================================================================//
+	void ParticleActivityGating::dilateActiveCells(const Vecu &number_of_cells, size_t total_cells)
+	{
+		for (int axis = 0; axis != Dimensions; ++axis)
+		{
+			size_t stride = 1;
+			for (int k = axis + 1; k != Dimensions; ++k)
+				stride *= number_of_cells[k];
+			size_t extent = number_of_cells[axis];
+			parallel_for(
+				blocked_range<size_t>(0, total_cells),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t c = r.begin(); c != r.end(); ++c)
+					{
+						size_t coordinate = (c / stride) % extent;
+						char active = cell_active_[c];
+						if (active == 0 && coordinate > 0)
+							active = cell_active_[c - stride];
+						if (active == 0 && coordinate + 1 < extent)
+							active = cell_active_[c + stride];
+						cell_active_buffer_[c] = active;
+					}
+				},
+				ap);
+			cell_active_.swap(cell_active_buffer_);
+		}
+	}
+	//=================================================================================================//
+	Real ParticleActivityGating::ActiveFraction()
+	{
+		size_t total_real_particles = particles_->total_real_particles_;
+		return total_real_particles != 0
+				   ? Real(active_particles_.size()) / Real(total_real_particles)
+				   : 1.0;
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
@@ -0,0 +1,91 @@
+/* -------------------------------------------------------------------------*
+ *								SPHinXsys									*
+ * --------------------------------------------------------------------------*
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+ * (smoothed particle hydrodynamics), a meshless computational method using	*
+ * particle discretization.													*
+ *																			*
+ * SPHinXsys is partially funded by German Research Foundation				*
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+ * and HU1527/12-1.															*
+ *                                                                           *
+ * Portions copyright (c) 2017-2020 Technical University of Munich and		*
+ * the authors' affiliations.												*
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * --------------------------------------------------------------------------*/
+/**
+ * @file 	particle_activity_gating.h
+ * @brief 	Activity gating of quiescent far-field regions on the cell linked list.
+ * @details	The activity of each cell is judged from the velocity and density
+ *			change of its particles since their last refresh. Inactive cells are
+ *			refreshed only at a reduced frequency and their particles can be
+ *			skipped in interaction sweeps by index-list filtering, while a
+ *			conservative one-ring wake-up propagation to the neighboring cells
+ *			keeps arriving disturbances resolved.
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#ifndef PARTICLE_ACTIVITY_GATING_H
+#define PARTICLE_ACTIVITY_GATING_H
+
+#include "general_dynamics.h"
+#include "cell_linked_list.h"
+
+namespace SPH
+{
+	class RealBody;
+
+	/**
+	 * @class ParticleActivityGating
+	 * @brief gate the particles of a body by the activity of their cells.
+	 * A cell is considered changed when a particle in it has changed its
+	 * velocity or density beyond the given thresholds since the last refresh,
+	 * or when its refresh countdown has expired, so that quiescent regions are
+	 * still stepped at the reduced frequency of one in inactive_step_interval
+	 * steps. Changed cells are dilated by one cell ring in all directions
+	 * before activation: since the kernel support does not exceed the cell
+	 * spacing, a disturbance reaches an inactive cell only after first
+	 * activating one of its neighbors, so the propagation is conservative.
+	 * The gating is opt-in per dynamics, see InteractionDynamics::gateByActivity().
+	 */
+	class ParticleActivityGating : public GeneralDataDelegateSimple
+	{
+	public:
+		ParticleActivityGating(RealBody &real_body, Real velocity_change_threshold,
+							   Real density_change_threshold, size_t inactive_step_interval = 8);
+		virtual ~ParticleActivityGating(){};
+
+		/** re-evaluate the cell activity, propagate the wake-up to neighboring
+		 * cells and rebuild the active particle list. To be called once per
+		 * advection step after the cell linked list has been updated. */
+		void updateActivity();
+		/** the indexes of the particles in active cells */
+		IndexVector &ActiveParticles() { return active_particles_; };
+		bool allParticlesActive() { return all_particles_active_; };
+		/** the fraction of currently active particles, e.g. for monitoring */
+		Real ActiveFraction();
+
+	protected:
+		CellLinkedList *cell_linked_list_;
+		Real velocity_change_threshold_, density_change_threshold_;
+		size_t inactive_step_interval_;
+		StdLargeVec<Vecd> vel_at_refresh_; /**< velocity at the last refresh of the cell. */
+		StdLargeVec<Real> rho_at_refresh_; /**< density at the last refresh of the cell. */
+		StdLargeVec<size_t> particle_cell_keys_;
+		StdLargeVec<char> cell_changed_, cell_active_, cell_active_buffer_;
+		StdLargeVec<size_t> cell_refresh_countdown_;
+		IndexVector active_particles_;
+		bool all_particles_active_;
+
+		/** one-ring dilation of the active cells, separably along each axis */
+		void dilateActiveCells(const Vecu &number_of_cells, size_t total_cells);
+	};
+}
+#endif // PARTICLE_ACTIVITY_GATING_H
@@ -0,0 +1,145 @@
+/**
+ * @file 	particle_refinement.cpp
+ * @author	Chi ZHang and Xiangyu Hu
+ */
+
+#include "particle_refinement.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	ParticleRefinement::ParticleRefinement(RealBody &real_body, RefinementIndicator refinement_indicator,
+										   size_t particle_buffer_size)
+		: ParticleDynamics<void>(real_body), GeneralDataDelegateSimple(real_body),
+		  adaptation_(DynamicCast<ParticleWithLocalRefinement>(this, real_body.sph_adaptation_)),
+		  h_ratio_(adaptation_->h_ratio_),
+		  Vol_(particles_->Vol_), rho_n_(particles_->rho_n_), mass_(particles_->mass_),
+		  pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_),
+		  refinement_indicator_(refinement_indicator),
+		  spacing_ref_(adaptation_->ReferenceSpacing()),
+		  refined_h_ratio_(adaptation_->ReferenceSpacing() / adaptation_->MinimumSpacing()),
+		  split_h_ratio_factor_(pow(2.0, 1.0 / (Real)Dimensions))
+	{
+		particles_->addBufferParticles(particle_buffer_size);
+		sph_body_->allocateConfigurationMemoriesForBufferParticles();
+	}
+	//=================================================================================================//
+	ParticleRefinement::ParticleRefinement(RealBody &real_body, Shape &refinement_region,
+										   size_t particle_buffer_size)
+		: ParticleRefinement(real_body, RefinementIndicator(), particle_buffer_size)
+	{
+		refinement_indicator_ = [this, &refinement_region](size_t index_i)
+		{ return refinement_region.checkContain(pos_n_[index_i]); };
+	}
+	//=================================================================================================//
+	void ParticleRefinement::exec(Real dt)
+	{
+		tick_count start_time = tick_count::now();
+		setBodyUpdated();
+		splitInRefinedRegion();
+		mergeInCoarseRegion();
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void ParticleRefinement::splitInRefinedRegion()
+	{
+		// daughters are appended behind this bound and are not split again in this pass
+		size_t total_real_particles = particles_->total_real_particles_;
+		for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		{
+			if (h_ratio_[index_i] < 0.999 * refined_h_ratio_ && refinement_indicator_(index_i))
+				splitAParticle(index_i);
+		}
+	}
+	//=================================================================================================//
+	void ParticleRefinement::splitAParticle(size_t index_i)
+	{
+		if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
+		{
+			std::cout << "\n Error: not enough buffer particles for particle splitting!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		size_t daughter_index = particles_->total_real_particles_;
+		particles_->copyFromAnotherParticle(daughter_index, index_i);
+		particles_->total_real_particles_ += 1;
+
+		// each daughter carries half of the mass and volume,
+		// so the local spacing shrinks by the binary split factor
+		mass_[index_i] *= 0.5;
+		mass_[daughter_index] = mass_[index_i];
+		Vol_[index_i] *= 0.5;
+		Vol_[daughter_index] = Vol_[index_i];
+		h_ratio_[index_i] *= split_h_ratio_factor_;
+		h_ratio_[daughter_index] = h_ratio_[index_i];
+
+		// separate along the velocity direction when moving, otherwise along x,
+		// keeping the centroid and the momentum of the mother particle
+		Vecd direction(0);
+		Real vel_norm = vel_n_[index_i].norm();
+		if (vel_norm > TinyReal)
+		{
+			direction = vel_n_[index_i] / vel_norm;
+		}
+		else
+		{
+			direction[0] = 1.0;
+		}
+		Vecd offset = 0.25 * spacing_ref_ / h_ratio_[index_i] * direction;
+		pos_n_[index_i] -= offset;
+		pos_n_[daughter_index] += offset;
+	}
+	//=================================================================================================//
+	void ParticleRefinement::mergeInCoarseRegion()
+	{
+		// the pairing walks the cell-sequence-sorted particle order,
+		// so consecutive merging candidates are spatial neighbors
+		size_t previous_candidate = MaxSize_t;
+		IndexVector removed_partners;
+		size_t total_real_particles = particles_->total_real_particles_;
+		for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		{
+			if (h_ratio_[index_i] < 1.001 || refinement_indicator_(index_i))
+				continue;
+
+			if (previous_candidate == MaxSize_t)
+			{
+				previous_candidate = index_i;
+				continue;
+			}
+
+			Real merge_distance = 0.6 * spacing_ref_ *
+								  (1.0 / h_ratio_[previous_candidate] + 1.0 / h_ratio_[index_i]);
+			if ((pos_n_[index_i] - pos_n_[previous_candidate]).norm() < merge_distance)
+			{
+				mergeParticlePair(previous_candidate, index_i);
+				removed_partners.push_back(index_i);
+				previous_candidate = MaxSize_t;
+			}
+			else
+			{
+				previous_candidate = index_i;
+			}
+		}
+
+		// releasing in descending index order, so that the tail particles
+		// moved into the freed slots never sit below a pending removal
+		for (size_t n = removed_partners.size(); n != 0; --n)
+			particles_->switchToBufferParticle(removed_partners[n - 1]);
+	}
+	//=================================================================================================//
+	void ParticleRefinement::mergeParticlePair(size_t index_i, size_t index_j)
+	{
+		Real total_mass = mass_[index_i] + mass_[index_j];
+		Real lumped_fraction = mass_[index_i] / total_mass;
+		pos_n_[index_i] = lumped_fraction * pos_n_[index_i] + (1.0 - lumped_fraction) * pos_n_[index_j];
+		vel_n_[index_i] = lumped_fraction * vel_n_[index_i] + (1.0 - lumped_fraction) * vel_n_[index_j];
+		// the local spacing grows with the cubic (square) root of the lumped mass
+		h_ratio_[index_i] *= pow(lumped_fraction, 1.0 / (Real)Dimensions);
+		Vol_[index_i] += Vol_[index_j];
+		rho_n_[index_i] = total_mass / Vol_[index_i];
+		mass_[index_i] = total_mass;
+	}
+	//=================================================================================================//
+}
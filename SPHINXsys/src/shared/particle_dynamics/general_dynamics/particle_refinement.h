@@ -0,0 +1,87 @@
+/* -------------------------------------------------------------------------*
+ *								SPHinXsys									*
+ * --------------------------------------------------------------------------*
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+ * (smoothed particle hydrodynamics), a meshless computational method using	*
+ * particle discretization.													*
+ *																			*
+ * SPHinXsys is partially funded by German Research Foundation				*
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+ * and HU1527/12-1.															*
+ *                                                                           *
+ * Portions copyright (c) 2017-2020 Technical University of Munich and		*
+ * the authors' affiliations.												*
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * --------------------------------------------------------------------------*/
+/**
+ * @file 	particle_refinement.h
+ * @brief 	Dynamic particle splitting and merging for adaptive resolution.
+ * @author	Chi ZHang and Xiangyu Hu
+ */
+
+#ifndef PARTICLE_REFINEMENT_H
+#define PARTICLE_REFINEMENT_H
+
+#include "general_dynamics.h"
+#include "adaptation.h"
+
+namespace SPH
+{
+	/**
+	 * @class ParticleRefinement
+	 * @brief Dynamic particle splitting and merging driver for bodies with
+	 * local refinement. Particles within the refinement region, given either
+	 * as a shape or as a user error indicator, are split binarily until the
+	 * minimum spacing of the adaptation is reached, and fine particles which
+	 * left the region are merged pairwise back towards the reference spacing.
+	 * Splitting halves mass and volume and places the two daughters
+	 * symmetrically around the mother, merging lumps mass, momentum and
+	 * volume into the centroid, so both operations are conservative.
+	 * The binary splits spread a full refinement over several calls, which
+	 * keeps the added particles and the configuration growth balanced across
+	 * the steps. Merge partners are taken from the cell-sequence-sorted
+	 * particle order, so no neighbor search is needed, and the driver should
+	 * therefore run right after particle sorting. The cell linked list and
+	 * all configurations of the body must be updated after each call.
+	 */
+	class ParticleRefinement : public ParticleDynamics<void>, public GeneralDataDelegateSimple
+	{
+	public:
+		typedef std::function<bool(size_t)> RefinementIndicator;
+
+		/** refinement region given by an error indicator on the particle index */
+		ParticleRefinement(RealBody &real_body, RefinementIndicator refinement_indicator,
+						   size_t particle_buffer_size);
+		/** refinement region given by a shape containing the particle positions */
+		ParticleRefinement(RealBody &real_body, Shape &refinement_region,
+						   size_t particle_buffer_size);
+		virtual ~ParticleRefinement(){};
+
+		virtual void exec(Real dt = 0.0) override;
+		/** This class is only implemented in sequential due to structural array edits. */
+		virtual void parallel_exec(Real dt = 0.0) override { exec(dt); };
+
+	protected:
+		ParticleWithLocalRefinement *adaptation_;
+		StdLargeVec<Real> &h_ratio_;
+		StdLargeVec<Real> &Vol_, &rho_n_, &mass_;
+		StdLargeVec<Vecd> &pos_n_, &vel_n_;
+		RefinementIndicator refinement_indicator_;
+		Real spacing_ref_;			/**< reference particle spacing of the body. */
+		Real refined_h_ratio_;		/**< smoothing length ratio at full refinement. */
+		Real split_h_ratio_factor_; /**< growth of the smoothing length ratio per binary split. */
+
+		void splitInRefinedRegion();
+		void splitAParticle(size_t index_i);
+		void mergeInCoarseRegion();
+		void mergeParticlePair(size_t index_i, size_t index_j);
+	};
+}
+#endif // PARTICLE_REFINEMENT_H
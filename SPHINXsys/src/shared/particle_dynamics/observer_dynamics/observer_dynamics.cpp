@@ -13,6 +13,34 @@ namespace SPH
 //=================================================================================================//
 	namespace observer_dynamics
 	{
+		//=================================================================================================//
+		ObservingQuantities::ObservingQuantities(BaseBodyRelationContact &contact_relation)
+			: InteractionDynamics(*contact_relation.sph_body_),
+			  InterpolationContactData(contact_relation)
+		{
+			for (size_t k = 0; k != contact_particles_.size(); ++k)
+			{
+				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
+			}
+		}
+		//=================================================================================================//
+		void ObservingQuantities::Interaction(size_t index_i, Real dt)
+		{
+			Real ttl_weight(0);
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				StdLargeVec<Real> &Vol_k = *(contact_Vol_[k]);
+				Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+				{
+					ttl_weight += contact_neighborhood.W_ij_[n] * Vol_k[contact_neighborhood.j_[n]];
+				}
+			}
+			for (size_t q = 0; q != observed_quantities_.size(); ++q)
+			{
+				observed_quantities_[q]->interpolate(index_i, contact_configuration_, contact_Vol_, ttl_weight);
+			}
+		}
 		//=================================================================================================//
 		CorrectInterpolationKernelWeights::
 			CorrectInterpolationKernelWeights(BaseBodyRelationContact &contact_relation) : 
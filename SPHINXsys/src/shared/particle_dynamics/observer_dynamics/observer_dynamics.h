@@ -144,6 +144,140 @@ namespace SPH
 			};
 		};
 
+		/** expand an observed value into scalar columns for the columnar observation log */
+		inline void appendQuantityColumns(StdVec<Real> &row, const Real &value) { row.push_back(value); };
+		inline void appendQuantityColumns(StdVec<Real> &row, const int &value) { row.push_back(Real(value)); };
+		inline void appendQuantityColumns(StdVec<Real> &row, const Vecd &value)
+		{
+			for (int d = 0; d != value.size(); ++d)
+				row.push_back(value[d]);
+		};
+		inline void appendQuantityColumns(StdVec<Real> &row, const Matd &value)
+		{
+			for (int i = 0; i != Vecd(0).size(); ++i)
+				for (int j = 0; j != Vecd(0).size(); ++j)
+					row.push_back(value(i, j));
+		};
+
+		/**
+		 * @class BaseObservedQuantity
+		 * @brief A single contact body variable registered for batched observation.
+		 */
+		class BaseObservedQuantity
+		{
+		public:
+			explicit BaseObservedQuantity(const std::string &variable_name)
+				: variable_name_(variable_name){};
+			virtual ~BaseObservedQuantity(){};
+
+			std::string variable_name_;
+			/** number of scalar columns this quantity contributes per observe point */
+			virtual size_t ColumnWidth() = 0;
+			virtual void interpolate(size_t index_i, StdVec<ParticleConfiguration *> &contact_configuration,
+									 StdVec<StdLargeVec<Real> *> &contact_Vol, Real ttl_weight) = 0;
+			virtual void appendColumns(size_t index_i, StdVec<Real> &row) = 0;
+		};
+
+		/**
+		 * @class ObservedQuantity
+		 * @brief The typed record of a batched observed variable. As for
+		 * ObservingAQuantity, the interpolated values are registered as an
+		 * observer body variable so that they remain accessible elsewhere.
+		 */
+		template <typename VariableType>
+		class ObservedQuantity : public BaseObservedQuantity
+		{
+		public:
+			ObservedQuantity(const std::string &variable_name,
+							 BaseParticles *observer_particles, StdVec<BaseParticles *> &contact_particles)
+				: BaseObservedQuantity(variable_name)
+			{
+				for (size_t k = 0; k != contact_particles.size(); ++k)
+					contact_data_.push_back(contact_particles[k]->template getVariableByName<VariableType>(variable_name));
+				interpolated_quantities_ = registerObservedQuantity(observer_particles);
+			};
+			virtual ~ObservedQuantity(){};
+
+			virtual size_t ColumnWidth() override
+			{
+				StdVec<Real> columns;
+				appendQuantityColumns(columns, VariableType(0));
+				return columns.size();
+			};
+
+			virtual void interpolate(size_t index_i, StdVec<ParticleConfiguration *> &contact_configuration,
+									 StdVec<StdLargeVec<Real> *> &contact_Vol, Real ttl_weight) override
+			{
+				VariableType observed_quantity(0);
+				for (size_t k = 0; k < contact_configuration.size(); ++k)
+				{
+					StdLargeVec<Real> &Vol_k = *(contact_Vol[k]);
+					StdLargeVec<VariableType> &data_k = *(contact_data_[k]);
+					Neighborhood &contact_neighborhood = (*contact_configuration[k])[index_i];
+					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+					{
+						size_t index_j = contact_neighborhood.j_[n];
+						observed_quantity += contact_neighborhood.W_ij_[n] * Vol_k[index_j] * data_k[index_j];
+					}
+				}
+				(*interpolated_quantities_)[index_i] = observed_quantity / (ttl_weight + TinyReal);
+			};
+
+			virtual void appendColumns(size_t index_i, StdVec<Real> &row) override
+			{
+				appendQuantityColumns(row, (*interpolated_quantities_)[index_i]);
+			};
+
+		protected:
+			StdVec<StdLargeVec<VariableType> *> contact_data_;
+			StdLargeVec<VariableType> observed_quantities_;
+			StdLargeVec<VariableType> *interpolated_quantities_;
+
+			/** Register the observed variable if the variable name is new.
+			 * If the variable is registered already, the registered variable will be returned. */
+			StdLargeVec<VariableType> *registerObservedQuantity(BaseParticles *particles)
+			{
+				constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+				if (particles->all_variable_maps_[type_index].find(variable_name_) == particles->all_variable_maps_[type_index].end())
+				{
+					particles->registerAVariable(observed_quantities_, variable_name_, VariableType(0));
+					return &observed_quantities_;
+				}
+				return particles->getVariableByName<VariableType>(variable_name_);
+			};
+		};
+
+		/**
+		 * @class ObservingQuantities
+		 * @brief Observing all registered variables from contact bodies in a
+		 * single contact-configuration traversal, so that the per-pass
+		 * overhead and the kernel weights are shared between quantities.
+		 */
+		class ObservingQuantities : public InteractionDynamics, public InterpolationContactData
+		{
+		public:
+			explicit ObservingQuantities(BaseBodyRelationContact &contact_relation);
+			virtual ~ObservingQuantities(){};
+
+			/** register a contact body variable for batched observation */
+			template <typename VariableType>
+			BaseObservedQuantity *addObservedQuantity(const std::string &variable_name)
+			{
+				BaseObservedQuantity *observed_quantity =
+					observed_quantity_ptr_keeper_.template createPtr<ObservedQuantity<VariableType>>(
+						variable_name, this->particles_, this->contact_particles_);
+				observed_quantities_.push_back(observed_quantity);
+				return observed_quantity;
+			};
+
+			StdVec<BaseObservedQuantity *> observed_quantities_;
+
+		protected:
+			UniquePtrKeepers<BaseObservedQuantity> observed_quantity_ptr_keeper_;
+			StdVec<StdLargeVec<Real> *> contact_Vol_;
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		* @class CorrectInterpolationKernelWeights
 		* @brief  correct kernel weights for interpolation between general bodies
@@ -5,6 +5,8 @@
 */
 
 #include "particle_dynamics_algorithms.h"
+#include "particle_dynamics_bodypart.h"
+#include "particle_activity_gating.h"
 #include "base_body.h"
 #include "base_particles.h"
 
@@ -14,157 +16,432 @@ namespace SPH
 	//=================================================================================================//
 	void ParticleDynamicsSimple::exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
 		ParticleIterator(total_real_particles, functor_update_, dt);
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	void ParticleDynamicsSimple::parallel_exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		ParticleIterator_parallel(total_real_particles, functor_update_,
+								  keyedLoopTuner(loop_tuner_, "update", total_real_particles), dt);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void InteractionDynamics::gatedIterator(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt)
+	{
+		activity_gating_ != nullptr && !activity_gating_->allParticlesActive()
+			? PartIteratorByParticle(activity_gating_->ActiveParticles(), particle_functor, dt)
+			: ParticleIterator(total_real_particles, particle_functor, dt);
+	}
+	//=================================================================================================//
+	void InteractionDynamics::gatedIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor,
+													 LoopTuner &loop_tuner, Real dt)
+	{
+		activity_gating_ != nullptr && !activity_gating_->allParticlesActive()
+			? PartIteratorByParticle_parallel(activity_gating_->ActiveParticles(), particle_functor, dt)
+			: ParticleIterator_parallel(total_real_particles, particle_functor, loop_tuner, dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamics::exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator(total_real_particles, functor_interaction_, dt);
+		gatedIterator(total_real_particles, functor_interaction_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->exec(dt);
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	void InteractionDynamics::parallel_exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
+		gatedIterator_parallel(total_real_particles, functor_interaction_,
+							   keyedLoopTuner(loop_tuner_, "interaction", total_real_particles), dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->parallel_exec(dt);
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	CombinedInteractionDynamics::
-		CombinedInteractionDynamics(InteractionDynamics &dynamics_a, InteractionDynamics &dynamics_b)
-		: InteractionDynamics(*dynamics_a.sph_body_),
-		  dynamics_a_(dynamics_a), dynamics_b_(dynamics_b)
+		CombinedInteractionDynamics(StdVec<InteractionDynamics *> combined_dynamics)
+		: InteractionDynamics(*combined_dynamics[0]->sph_body_),
+		  combined_dynamics_(combined_dynamics)
 	{
-		if (dynamics_a.sph_body_ != dynamics_b.sph_body_)
+		for (InteractionDynamics *dynamics : combined_dynamics_)
 		{
-			std::cout << "\n Error: CombinedInteractionDynamics does not have the same source body!" << std::endl;
-			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-			exit(1);
-		}
+			if (dynamics->sph_body_ != sph_body_)
+			{
+				std::cout << "\n Error: CombinedInteractionDynamics does not have the same source body!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
 
-		for (size_t k = 0; k < dynamics_a.pre_processes_.size(); ++k)
-			pre_processes_.push_back(dynamics_a.pre_processes_[k]);
-		for (size_t k = 0; k < dynamics_b.pre_processes_.size(); ++k)
-			pre_processes_.push_back(dynamics_b.pre_processes_[k]);
-
-		for (size_t k = 0; k < dynamics_a.post_processes_.size(); ++k)
-			post_processes_.push_back(dynamics_a.post_processes_[k]);
-		for (size_t k = 0; k < dynamics_b.post_processes_.size(); ++k)
-			post_processes_.push_back(dynamics_b.post_processes_[k]);
+			for (size_t k = 0; k < dynamics->pre_processes_.size(); ++k)
+				pre_processes_.push_back(dynamics->pre_processes_[k]);
+			for (size_t k = 0; k < dynamics->post_processes_.size(); ++k)
+				post_processes_.push_back(dynamics->post_processes_[k]);
+		}
 	}
 	//=================================================================================================//
 	void CombinedInteractionDynamics::setupDynamics(Real dt)
 	{
-		dynamics_a_.setupDynamics(dt);
-		dynamics_b_.setupDynamics(dt);
+		for (InteractionDynamics *dynamics : combined_dynamics_)
+			dynamics->setupDynamics(dt);
 	}
 	//=================================================================================================//
 	void CombinedInteractionDynamics::Interaction(size_t index_i, Real dt)
 	{
-		dynamics_a_.Interaction(index_i, dt);
-		dynamics_b_.Interaction(index_i, dt);
+		for (InteractionDynamics *dynamics : combined_dynamics_)
+			dynamics->Interaction(index_i, dt);
+	}
+	//=================================================================================================//
+	void InteractionDynamicsWithUpdate::InteractionAndUpdate(size_t index_i, Real dt)
+	{
+		Interaction(index_i, dt);
+		Update(index_i, dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsWithUpdate::exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator(total_real_particles, functor_interaction_, dt);
-		for (size_t k = 0; k < post_processes_.size(); ++k)
-			post_processes_[k]->exec(dt);
-		ParticleIterator(total_real_particles, functor_update_, dt);
+		if (use_fused_update_ && post_processes_.empty())
+		{
+			gatedIterator(total_real_particles, functor_interaction_and_update_, dt);
+		}
+		else
+		{
+			gatedIterator(total_real_particles, functor_interaction_, dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->exec(dt);
+			gatedIterator(total_real_particles, functor_update_, dt);
+		}
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsWithUpdate::parallel_exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
-		for (size_t k = 0; k < post_processes_.size(); ++k)
-			post_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		if (use_fused_update_ && post_processes_.empty())
+		{
+			gatedIterator_parallel(total_real_particles, functor_interaction_and_update_,
+								   keyedLoopTuner(loop_tuner_, "interaction_and_update", total_real_particles), dt);
+		}
+		else
+		{
+			gatedIterator_parallel(total_real_particles, functor_interaction_,
+								   keyedLoopTuner(loop_tuner_, "interaction", total_real_particles), dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->parallel_exec(dt);
+			gatedIterator_parallel(total_real_particles, functor_update_,
+								   keyedLoopTuner(update_loop_tuner_, "update", total_real_particles), dt);
+		}
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	CombinedInteractionDynamicsWithUpdate::
+		CombinedInteractionDynamicsWithUpdate(StdVec<InteractionDynamicsWithUpdate *> combined_dynamics)
+		: InteractionDynamicsWithUpdate(*combined_dynamics[0]->sph_body_),
+		  combined_dynamics_(combined_dynamics)
+	{
+		for (InteractionDynamicsWithUpdate *dynamics : combined_dynamics_)
+		{
+			if (dynamics->sph_body_ != sph_body_)
+			{
+				std::cout << "\n Error: CombinedInteractionDynamicsWithUpdate does not have the same source body!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			for (size_t k = 0; k < dynamics->pre_processes_.size(); ++k)
+				pre_processes_.push_back(dynamics->pre_processes_[k]);
+			for (size_t k = 0; k < dynamics->post_processes_.size(); ++k)
+				post_processes_.push_back(dynamics->post_processes_[k]);
+		}
+	}
+	//=================================================================================================//
+	void CombinedInteractionDynamicsWithUpdate::setupDynamics(Real dt)
+	{
+		for (InteractionDynamicsWithUpdate *dynamics : combined_dynamics_)
+			dynamics->setupDynamics(dt);
+	}
+	//=================================================================================================//
+	void CombinedInteractionDynamicsWithUpdate::Interaction(size_t index_i, Real dt)
+	{
+		for (InteractionDynamicsWithUpdate *dynamics : combined_dynamics_)
+			dynamics->Interaction(index_i, dt);
+	}
+	//=================================================================================================//
+	void CombinedInteractionDynamicsWithUpdate::Update(size_t index_i, Real dt)
+	{
+		for (InteractionDynamicsWithUpdate *dynamics : combined_dynamics_)
+			dynamics->Update(index_i, dt);
 	}
 	//=================================================================================================//
 	void ParticleDynamics1Level::exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator(total_real_particles, functor_initialization_, dt);
+		gatedIterator(total_real_particles, functor_initialization_, dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->exec(dt);
-		ParticleIterator(total_real_particles, functor_interaction_, dt);
-		for (size_t k = 0; k < post_processes_.size(); ++k)
-			post_processes_[k]->exec(dt);
-		ParticleIterator(total_real_particles, functor_update_, dt);
+		if (use_fused_update_ && post_processes_.empty())
+		{
+			gatedIterator(total_real_particles, functor_interaction_and_update_, dt);
+		}
+		else
+		{
+			gatedIterator(total_real_particles, functor_interaction_, dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->exec(dt);
+			gatedIterator(total_real_particles, functor_update_, dt);
+		}
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	void ParticleDynamics1Level::parallel_exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t total_real_particles = base_particles_->total_real_particles_;
-		ParticleIterator_parallel(total_real_particles, functor_initialization_, dt);
+		gatedIterator_parallel(total_real_particles, functor_initialization_,
+							   keyedLoopTuner(initialization_loop_tuner_, "initialization", total_real_particles), dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_interaction_, dt);
-		for (size_t k = 0; k < post_processes_.size(); ++k)
-			post_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+		if (use_fused_update_ && post_processes_.empty())
+		{
+			gatedIterator_parallel(total_real_particles, functor_interaction_and_update_,
+								   keyedLoopTuner(loop_tuner_, "interaction_and_update", total_real_particles), dt);
+		}
+		else
+		{
+			gatedIterator_parallel(total_real_particles, functor_interaction_,
+								   keyedLoopTuner(loop_tuner_, "interaction", total_real_particles), dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->parallel_exec(dt);
+			gatedIterator_parallel(total_real_particles, functor_update_,
+								   keyedLoopTuner(update_loop_tuner_, "update", total_real_particles), dt);
+		}
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	InteractionDynamicsSplitting::InteractionDynamicsSplitting(SPHBody &sph_body)
 			: InteractionDynamics(sph_body),
-			  split_cell_lists_(sph_body.split_cell_lists_){};
+			  split_cell_lists_(sph_body.split_cell_lists_),
+			  split_cell_index_ranges_(sph_body.split_cell_index_ranges_){};
 	//=================================================================================================//
 	void InteractionDynamicsSplitting::exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->exec(dt);
-		ParticleIteratorSplittingSweep(split_cell_lists_, functor_interaction_, dt);
+		if (split_cell_index_ranges_.Filled())
+		{
+			ParticleIteratorSplittingSweep(split_cell_index_ranges_, functor_interaction_, dt);
+		}
+		else
+		{
+			ParticleIteratorSplittingSweep(split_cell_lists_, functor_interaction_, dt);
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->exec(dt);
+		recordExecutionTiming(start_time);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsSplitting::parallel_exec(Real dt)
 	{
+		tick_count start_time = tick_count::now();
+		setBodyUpdated();
+		setupDynamics(dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->parallel_exec(dt);
+		// the dependency-graph execution needs the cell-pointer lists,
+		// which record the neighbor-level links
+		if (split_cell_index_ranges_.Filled() && !SplitCellGraphExecution::Enabled())
+		{
+			ParticleIteratorSplittingSweep_parallel(split_cell_index_ranges_, functor_interaction_, dt);
+		}
+		else
+		{
+			ParticleIteratorSplittingSweep_parallel(split_cell_lists_, functor_interaction_, dt);
+		}
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->parallel_exec(dt);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void InteractionDynamicsScattering::exec(Real dt)
+	{
+		tick_count start_time = tick_count::now();
+		setBodyUpdated();
+		setupDynamics(dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k)
+			pre_processes_[k]->exec(dt);
+		if (split_cell_index_ranges_.Filled())
+		{
+			ParticleIteratorColoredSweep(split_cell_index_ranges_, functor_interaction_, dt);
+		}
+		else
+		{
+			ParticleIteratorColoredSweep(split_cell_lists_, functor_interaction_, dt);
+		}
+		for (size_t k = 0; k < post_processes_.size(); ++k)
+			post_processes_[k]->exec(dt);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void InteractionDynamicsScattering::parallel_exec(Real dt)
+	{
+		tick_count start_time = tick_count::now();
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k)
 			pre_processes_[k]->parallel_exec(dt);
-		ParticleIteratorSplittingSweep_parallel(split_cell_lists_, functor_interaction_, dt);
+		if (split_cell_index_ranges_.Filled())
+		{
+			ParticleIteratorColoredSweep_parallel(split_cell_index_ranges_, functor_interaction_, dt);
+		}
+		else
+		{
+			ParticleIteratorColoredSweep_parallel(split_cell_lists_, functor_interaction_, dt);
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k)
 			post_processes_[k]->parallel_exec(dt);
+		recordExecutionTiming(start_time);
+	}
+	//=================================================================================================//
+	void ParticleDynamicsTaskGroup::addDynamics(ParticleDynamics<void> *dynamics, SPHBody &sph_body,
+												const StdVec<std::string> &read_variables,
+												const StdVec<std::string> &write_variables)
+	{
+		ScheduledDynamics scheduled_dynamics;
+		scheduled_dynamics.dynamics_ = dynamics;
+		for (const std::string &variable_name : read_variables)
+			scheduled_dynamics.read_variables_.push_back(sph_body.getBodyName() + "/" + variable_name);
+		for (const std::string &variable_name : write_variables)
+			scheduled_dynamics.write_variables_.push_back(sph_body.getBodyName() + "/" + variable_name);
+		scheduled_dynamics_.push_back(scheduled_dynamics);
+		waves_built_ = false;
+	}
+	//=================================================================================================//
+	bool ParticleDynamicsTaskGroup::isConflicting(const ScheduledDynamics &one, const ScheduledDynamics &another)
+	{
+		for (const std::string &written : one.write_variables_)
+		{
+			if (std::find(another.read_variables_.begin(), another.read_variables_.end(), written) != another.read_variables_.end() ||
+				std::find(another.write_variables_.begin(), another.write_variables_.end(), written) != another.write_variables_.end())
+				return true;
+		}
+		for (const std::string &written : another.write_variables_)
+		{
+			if (std::find(one.read_variables_.begin(), one.read_variables_.end(), written) != one.read_variables_.end())
+				return true;
+		}
+		return false;
+	}
+	//=================================================================================================//
+	void ParticleDynamicsTaskGroup::buildConcurrentWaves()
+	{
+		concurrent_waves_.clear();
+		StdVec<size_t> remaining;
+		for (size_t i = 0; i != scheduled_dynamics_.size(); ++i)
+			remaining.push_back(i);
+
+		while (!remaining.empty())
+		{
+			StdVec<size_t> wave;
+			StdVec<size_t> deferred;
+			for (size_t k = 0; k != remaining.size(); ++k)
+			{
+				size_t candidate = remaining[k];
+				// a dynamics joins the wave only when it conflicts neither with the wave
+				// nor with an earlier dynamics which is still waiting
+				bool conflicting = false;
+				for (size_t scheduled : wave)
+				{
+					if (isConflicting(scheduled_dynamics_[candidate], scheduled_dynamics_[scheduled]))
+						conflicting = true;
+				}
+				for (size_t waiting : deferred)
+				{
+					if (isConflicting(scheduled_dynamics_[candidate], scheduled_dynamics_[waiting]))
+						conflicting = true;
+				}
+				if (conflicting)
+				{
+					deferred.push_back(candidate);
+				}
+				else
+				{
+					wave.push_back(candidate);
+				}
+			}
+			concurrent_waves_.push_back(wave);
+			remaining = deferred;
+		}
+		waves_built_ = true;
+	}
+	//=================================================================================================//
+	void ParticleDynamicsTaskGroup::exec(Real dt)
+	{
+		for (ScheduledDynamics &scheduled_dynamics : scheduled_dynamics_)
+			scheduled_dynamics.dynamics_->exec(dt);
+	}
+	//=================================================================================================//
+	void ParticleDynamicsTaskGroup::parallel_exec(Real dt)
+	{
+		if (!waves_built_)
+			buildConcurrentWaves();
+
+		for (StdVec<size_t> &wave : concurrent_waves_)
+		{
+			if (wave.size() == 1)
+			{
+				scheduled_dynamics_[wave[0]].dynamics_->parallel_exec(dt);
+			}
+			else
+			{
+				tbb::task_group task_group;
+				for (size_t scheduled : wave)
+				{
+					ParticleDynamics<void> *dynamics = scheduled_dynamics_[scheduled].dynamics_;
+					task_group.run([dynamics, dt]
+								   { dynamics->parallel_exec(dt); });
+				}
+				task_group.wait();
+			}
+		}
 	}
 	//=============================================================================================//
 }
@@ -77,22 +77,39 @@ namespace SPH
 		ReturnType InitialReference() { return initial_reference_; };
 		std::string QuantityName() { return quantity_name_; };
 
+		/** hooks exposed so that several reductions sharing a body
+		 * can be fused into one particle sweep, see FusedParticleReduce */
+		using ReduceReturnType = ReturnType;
+		void PrepareReduce()
+		{
+			this->setBodyUpdated();
+			SetupReduce();
+		};
+		ReturnType ReduceContribution(size_t index_i, Real dt) { return functor_reduce_function_(index_i, dt); };
+		ReturnType CombineReduced(const ReturnType &x, const ReturnType &y) { return reduce_operation_(x, y); };
+		ReturnType FinishReduce(const ReturnType &reduced_value) { return OutputResult(reduced_value); };
+
 		virtual ReturnType exec(Real dt = 0.0) override
 		{
+			tick_count start_time = tick_count::now();
 			size_t total_real_particles = this->base_particles_->total_real_particles_;
 			this->setBodyUpdated();
 			SetupReduce();
 			ReturnType temp = ReduceIterator(total_real_particles,
 											 initial_reference_, functor_reduce_function_, reduce_operation_, dt);
+			this->recordExecutionTiming(start_time);
 			return OutputResult(temp);
 		};
 		virtual ReturnType parallel_exec(Real dt = 0.0) override
 		{
+			tick_count start_time = tick_count::now();
 			size_t total_real_particles = this->base_particles_->total_real_particles_;
 			this->setBodyUpdated();
 			SetupReduce();
 			ReturnType temp = ReduceIterator_parallel(total_real_particles,
-													  initial_reference_, functor_reduce_function_, reduce_operation_, dt);
+													  initial_reference_, functor_reduce_function_, reduce_operation_,
+													  this->keyedLoopTuner(this->loop_tuner_, "reduce", total_real_particles), dt);
+			this->recordExecutionTiming(start_time);
 			return this->OutputResult(temp);
 		};
 
@@ -108,6 +125,8 @@ namespace SPH
 		ReduceFunctor<ReturnType> functor_reduce_function_;
 	};
 
+	class ParticleActivityGating;
+
 	/**
 	 * @class InteractionDynamics
 	 * @brief This is the class for particle interaction with other particles
@@ -126,29 +145,46 @@ namespace SPH
 		/** post process such as impose constraint */
 		StdVec<ParticleDynamics<void> *> post_processes_;
 
+		/** restrict the particle sweeps, including the initialization and update
+		 * sweeps of derived dynamics, to the particles of currently active cells,
+		 * see ParticleActivityGating */
+		void gateByActivity(ParticleActivityGating &activity_gating) { activity_gating_ = &activity_gating; };
+
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
 
 	protected:
 		friend class CombinedInteractionDynamics;
+		friend class CombinedInteractionDynamicsWithUpdate;
 		virtual void Interaction(size_t index_i, Real dt = 0.0) = 0;
 		ParticleFunctor functor_interaction_;
+		ParticleActivityGating *activity_gating_ = nullptr;
+
+		/** sweep all particles or, when gated, the active particles only */
+		void gatedIterator(size_t total_real_particles, const ParticleFunctor &particle_functor, Real dt);
+		void gatedIterator_parallel(size_t total_real_particles, const ParticleFunctor &particle_functor,
+									LoopTuner &loop_tuner, Real dt);
 	};
 
 	/**
 	 * @class CombinedInteractionDynamics
 	 * @brief This is the class for combining several interactions dynamics,
 	 * which share the particle loop but are independent from each other,
-	 * aiming to increase computing intensity under the data caching environment
+	 * aiming to increase computing intensity under the data caching environment.
+	 * All member interactions of one particle are carried out back to back,
+	 * so that the particle and, for matching relations, neighborhood data
+	 * are streamed from memory only once per particle instead of once per pass.
 	 */
 	class CombinedInteractionDynamics : public InteractionDynamics
 	{
 	public:
-		explicit CombinedInteractionDynamics(InteractionDynamics &dynamics_a, InteractionDynamics &dynamics_b);
+		explicit CombinedInteractionDynamics(StdVec<InteractionDynamics *> combined_dynamics);
+		CombinedInteractionDynamics(InteractionDynamics &dynamics_a, InteractionDynamics &dynamics_b)
+			: CombinedInteractionDynamics(StdVec<InteractionDynamics *>{&dynamics_a, &dynamics_b}){};
 		virtual ~CombinedInteractionDynamics(){};
 
 	protected:
-		InteractionDynamics &dynamics_a_, &dynamics_b_;
+		StdVec<InteractionDynamics *> combined_dynamics_;
 		virtual void setupDynamics(Real dt = 0.0) override;
 		virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 	};
@@ -163,15 +199,61 @@ namespace SPH
 		explicit InteractionDynamicsWithUpdate(SPHBody &sph_body)
 			: InteractionDynamics(sph_body),
 			  functor_update_(std::bind(&InteractionDynamicsWithUpdate::Update,
-										this, _1, _2)) {}
+										this, _1, _2)),
+			  functor_interaction_and_update_(std::bind(&InteractionDynamicsWithUpdate::InteractionAndUpdate,
+														this, _1, _2)),
+			  use_fused_update_(false) {}
 		virtual ~InteractionDynamicsWithUpdate(){};
 
+		/**
+		 * Carry out the update of each particle directly after its interaction,
+		 * fusing the two particle sweeps into a single one and saving a complete
+		 * pass over the updated arrays. Only admissible when the update of a
+		 * particle consumes solely its own interaction result and does not write
+		 * any quantity the interaction of another particle reads. Post processes
+		 * must run between the two steps, so when they are present the sweeps
+		 * stay separate.
+		 */
+		void useFusedUpdate() { use_fused_update_ = true; };
+		bool usingFusedUpdate() { return use_fused_update_; };
+
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
 
 	protected:
+		friend class CombinedInteractionDynamicsWithUpdate;
 		virtual void Update(size_t index_i, Real dt = 0.0) = 0;
+		void InteractionAndUpdate(size_t index_i, Real dt);
 		ParticleFunctor functor_update_;
+		ParticleFunctor functor_interaction_and_update_;
+		bool use_fused_update_; /**< whether interaction and update run in one sweep. */
+		LoopTuner update_loop_tuner_; /**< auto-tuned separately: the update loop is much cheaper than the interaction */
+	};
+
+	/**
+	 * @class CombinedInteractionDynamicsWithUpdate
+	 * @brief The combination of several interaction dynamics with update,
+	 * sharing both the interaction and the update particle loops so that
+	 * particle and neighborhood data are streamed from memory only once.
+	 * The member updates are carried out together in one pass, so one
+	 * member update must not read the values another member update writes
+	 * to neighboring particles.
+	 */
+	class CombinedInteractionDynamicsWithUpdate : public InteractionDynamicsWithUpdate
+	{
+	public:
+		explicit CombinedInteractionDynamicsWithUpdate(StdVec<InteractionDynamicsWithUpdate *> combined_dynamics);
+		CombinedInteractionDynamicsWithUpdate(InteractionDynamicsWithUpdate &dynamics_a,
+											  InteractionDynamicsWithUpdate &dynamics_b)
+			: CombinedInteractionDynamicsWithUpdate(
+				  StdVec<InteractionDynamicsWithUpdate *>{&dynamics_a, &dynamics_b}){};
+		virtual ~CombinedInteractionDynamicsWithUpdate(){};
+
+	protected:
+		StdVec<InteractionDynamicsWithUpdate *> combined_dynamics_;
+		virtual void setupDynamics(Real dt = 0.0) override;
+		virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		virtual void Update(size_t index_i, Real dt = 0.0) override;
 	};
 
 	/**
@@ -193,6 +275,7 @@ namespace SPH
 	protected:
 		virtual void Initialization(size_t index_i, Real dt = 0.0) = 0;
 		ParticleFunctor functor_initialization_;
+		LoopTuner initialization_loop_tuner_;
 	};
 
 	/**
@@ -210,6 +293,83 @@ namespace SPH
 
 	protected:
 		SplitCellLists &split_cell_lists_;
+		/** flat per-level index ranges of the body, preferred for the sweeps
+		 * whenever the cell list rebuild has filled them */
+		SplitCellIndexRanges &split_cell_index_ranges_;
+	};
+
+	/**
+	 * @class InteractionDynamicsSymmetric
+	 * @brief This is for interactions on a half neighbor list, where each
+	 * pair contribution is computed once and scattered to both particles.
+	 * The splitting sweeps keep concurrently processed particles farther
+	 * apart than the kernel support, so the scattered writes are race free.
+	 */
+	class InteractionDynamicsSymmetric : public InteractionDynamicsSplitting
+	{
+	public:
+		explicit InteractionDynamicsSymmetric(SPHBody &sph_body)
+			: InteractionDynamicsSplitting(sph_body){};
+		virtual ~InteractionDynamicsSymmetric(){};
+	};
+
+	/**
+	 * @class InteractionDynamicsScattering
+	 * @brief This is for interactions which scatter writes to their neighbors,
+	 * possibly on another body. Unlike the splitting scheme, a single colored
+	 * sweep over the split cell levels visits each particle once with the full
+	 * time step, while concurrently processed cells of one level stay farther
+	 * apart than the kernel support so the scattered writes are race free.
+	 */
+	class InteractionDynamicsScattering : public InteractionDynamicsSplitting
+	{
+	public:
+		explicit InteractionDynamicsScattering(SPHBody &sph_body)
+			: InteractionDynamicsSplitting(sph_body){};
+		virtual ~InteractionDynamicsScattering(){};
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+	};
+
+	/**
+	 * @class ParticleDynamicsTaskGroup
+	 * @brief This is the class for executing a set of particle dynamics
+	 * with declared read and write variable sets as a task graph,
+	 * so that non-conflicting dynamics, typically on different bodies,
+	 * run concurrently instead of strictly one after the other.
+	 * The variables are qualified by the body name so that
+	 * same-named variables on different bodies do not conflict.
+	 */
+	class ParticleDynamicsTaskGroup
+	{
+	public:
+		ParticleDynamicsTaskGroup() : waves_built_(false){};
+		virtual ~ParticleDynamicsTaskGroup(){};
+
+		/** schedule a dynamics with the body variables it reads and writes */
+		void addDynamics(ParticleDynamics<void> *dynamics, SPHBody &sph_body,
+						 const StdVec<std::string> &read_variables, const StdVec<std::string> &write_variables);
+
+		/** execute the dynamics one after the other in the scheduled order */
+		void exec(Real dt = 0.0);
+		/** execute non-conflicting dynamics concurrently, wave by wave */
+		void parallel_exec(Real dt = 0.0);
+
+	protected:
+		struct ScheduledDynamics
+		{
+			ParticleDynamics<void> *dynamics_;
+			StdVec<std::string> read_variables_;
+			StdVec<std::string> write_variables_;
+		};
+
+		StdVec<ScheduledDynamics> scheduled_dynamics_;
+		StdVec<StdVec<size_t>> concurrent_waves_;
+		bool waves_built_;
+
+		bool isConflicting(const ScheduledDynamics &one, const ScheduledDynamics &another);
+		void buildConcurrentWaves();
 	};
 
 	//----------------------------------------------------------------------
@@ -218,18 +378,40 @@ namespace SPH
 	//		it can be used in different dynamics.
 	//----------------------------------------------------------------------
 
+	template <typename...>
+	using VoidT = void;
+
+	/** whether a local dynamics provides setupDynamics(Real) to be called
+	 * before its particle loop, e.g. for batched precomputations. */
+	template <class LocalDynamicsType, class = void>
+	struct HasSetupDynamics : std::false_type
+	{
+	};
+
+	template <class LocalDynamicsType>
+	struct HasSetupDynamics<LocalDynamicsType,
+							VoidT<decltype(std::declval<LocalDynamicsType &>().setupDynamics(Real(0)))>>
+		: std::true_type
+	{
+	};
+
 	template <class LocalDynamicsType>
 	class SimpleDynamics : public ParticleDynamics<void>
 	{
 		LocalDynamicsType local_dynamics_;
-		ParticleFunctor functor_update_;
+
+		template <class Type = LocalDynamicsType>
+		typename std::enable_if<HasSetupDynamics<Type>::value, void>::type
+		setupLocalDynamics(Real dt) { local_dynamics_.setupDynamics(dt); };
+		template <class Type = LocalDynamicsType>
+		typename std::enable_if<!HasSetupDynamics<Type>::value, void>::type
+		setupLocalDynamics(Real dt){};
 
 	public:
 		template <typename... ConstructorArgs>
 		SimpleDynamics(SPHBody &sph_body, ConstructorArgs &&...args)
 			: ParticleDynamics<void>(sph_body),
-			  local_dynamics_(sph_body, std::forward<ConstructorArgs>(args)...),
-			  functor_update_(std::bind(&LocalDynamicsType::update, &local_dynamics_, _1, _2)){};
+			  local_dynamics_(sph_body, std::forward<ConstructorArgs>(args)...){};
 
 		virtual ~SimpleDynamics(){};
 
@@ -237,18 +419,379 @@ namespace SPH
 
 		virtual void exec(Real dt = 0.0) override
 		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			setupLocalDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ local_dynamics_.update(index_i, dt); },
+				dt);
+			recordExecutionTiming(start_time);
+		};
+
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			setupLocalDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ local_dynamics_.update(index_i, dt); },
+				keyedLoopTuner(loop_tuner_, "update", total_real_particles), dt);
+			recordExecutionTiming(start_time);
+		};
+	};
+
+	//----------------------------------------------------------------------
+	//		Statically dispatched variants of the classic dynamics.
+	//		The derived class passes itself as template argument and
+	//		provides non-virtual update, interaction or initialization
+	//		functions which are inlined into the particle loop.
+	//----------------------------------------------------------------------
+
+	/**
+	 * @class ParticleDynamicsSimpleStatic
+	 * @brief CRTP variant of ParticleDynamicsSimple without per-particle std::function calls.
+	 */
+	template <class DerivedDynamicsType>
+	class ParticleDynamicsSimpleStatic : public ParticleDynamics<void>
+	{
+	public:
+		explicit ParticleDynamicsSimpleStatic(SPHBody &sph_body)
+			: ParticleDynamics<void>(sph_body){};
+		virtual ~ParticleDynamicsSimpleStatic(){};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
 			setBodyUpdated();
 			setupDynamics(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
 			size_t total_real_particles = base_particles_->total_real_particles_;
-			ParticleIterator(total_real_particles, functor_update_, dt);
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->update(index_i, dt); },
+				dt);
+			recordExecutionTiming(start_time);
 		};
 
 		virtual void parallel_exec(Real dt = 0.0) override
 		{
+			tick_count start_time = tick_count::now();
 			setBodyUpdated();
 			setupDynamics(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
 			size_t total_real_particles = base_particles_->total_real_particles_;
-			ParticleIterator_parallel(total_real_particles, functor_update_, dt);
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->update(index_i, dt); },
+				keyedLoopTuner(loop_tuner_, "update", total_real_particles), dt);
+			recordExecutionTiming(start_time);
+		};
+	};
+
+	/**
+	 * @class InteractionDynamicsStatic
+	 * @brief CRTP variant of InteractionDynamics without per-particle std::function calls.
+	 */
+	template <class DerivedDynamicsType>
+	class InteractionDynamicsStatic : public ParticleDynamics<void>
+	{
+	public:
+		explicit InteractionDynamicsStatic(SPHBody &sph_body)
+			: ParticleDynamics<void>(sph_body){};
+		virtual ~InteractionDynamicsStatic(){};
+
+		/** pre process such as update ghost state */
+		StdVec<ParticleDynamics<void> *> pre_processes_;
+		/** post process such as impose constraint */
+		StdVec<ParticleDynamics<void> *> post_processes_;
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			for (size_t k = 0; k < pre_processes_.size(); ++k)
+				pre_processes_[k]->exec(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->interaction(index_i, dt); },
+				dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->exec(dt);
+			recordExecutionTiming(start_time);
+		};
+
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			for (size_t k = 0; k < pre_processes_.size(); ++k)
+				pre_processes_[k]->parallel_exec(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->interaction(index_i, dt); },
+				keyedLoopTuner(loop_tuner_, "interaction", total_real_particles), dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->parallel_exec(dt);
+			recordExecutionTiming(start_time);
+		};
+	};
+
+	/**
+	 * @class ParticleDynamics1LevelStatic
+	 * @brief CRTP variant of ParticleDynamics1Level without per-particle std::function calls.
+	 */
+	template <class DerivedDynamicsType>
+	class ParticleDynamics1LevelStatic : public InteractionDynamicsStatic<DerivedDynamicsType>
+	{
+	public:
+		explicit ParticleDynamics1LevelStatic(SPHBody &sph_body)
+			: InteractionDynamicsStatic<DerivedDynamicsType>(sph_body){};
+		virtual ~ParticleDynamics1LevelStatic(){};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			size_t total_real_particles = this->base_particles_->total_real_particles_;
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->initialization(index_i, dt); },
+				dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k)
+				this->pre_processes_[k]->exec(dt);
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->interaction(index_i, dt); },
+				dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k)
+				this->post_processes_[k]->exec(dt);
+			ParticleIterator(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->update(index_i, dt); },
+				dt);
+			this->recordExecutionTiming(start_time);
+		};
+
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			size_t total_real_particles = this->base_particles_->total_real_particles_;
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->initialization(index_i, dt); },
+				this->keyedLoopTuner(initialization_loop_tuner_, "initialization", total_real_particles), dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k)
+				this->pre_processes_[k]->parallel_exec(dt);
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->interaction(index_i, dt); },
+				this->keyedLoopTuner(this->loop_tuner_, "interaction", total_real_particles), dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k)
+				this->post_processes_[k]->parallel_exec(dt);
+			ParticleIterator_parallel(
+				total_real_particles,
+				[&](size_t index_i, Real dt)
+				{ derived_dynamics->update(index_i, dt); },
+				this->keyedLoopTuner(update_loop_tuner_, "update", total_real_particles), dt);
+			this->recordExecutionTiming(start_time);
+		};
+
+	protected:
+		LoopTuner initialization_loop_tuner_;
+		LoopTuner update_loop_tuner_;
+	};
+
+	/**
+	 * @class ParticleDynamicsReduceStatic
+	 * @brief CRTP variant of ParticleDynamicsReduce without per-particle std::function calls.
+	 * The derived class provides a non-virtual reduce function which is
+	 * inlined into the reduction loop.
+	 */
+	template <class DerivedDynamicsType, class ReturnType, typename ReduceOperation>
+	class ParticleDynamicsReduceStatic : public ParticleDynamics<ReturnType>
+	{
+	public:
+		explicit ParticleDynamicsReduceStatic(SPHBody &sph_body)
+			: ParticleDynamics<ReturnType>(sph_body), quantity_name_("ReducedQuantity"), initial_reference_(){};
+		virtual ~ParticleDynamicsReduceStatic(){};
+
+		ReturnType InitialReference() { return initial_reference_; };
+		std::string QuantityName() { return quantity_name_; };
+
+		virtual ReturnType exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			size_t total_real_particles = this->base_particles_->total_real_particles_;
+			this->setBodyUpdated();
+			SetupReduce();
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			ReturnType temp = ReduceIterator(
+				total_real_particles, initial_reference_,
+				[&](size_t index_i, Real dt)
+				{ return derived_dynamics->reduce(index_i, dt); },
+				reduce_operation_, dt);
+			this->recordExecutionTiming(start_time);
+			return OutputResult(temp);
+		};
+
+		virtual ReturnType parallel_exec(Real dt = 0.0) override
+		{
+			tick_count start_time = tick_count::now();
+			size_t total_real_particles = this->base_particles_->total_real_particles_;
+			this->setBodyUpdated();
+			SetupReduce();
+			DerivedDynamicsType *derived_dynamics = static_cast<DerivedDynamicsType *>(this);
+			ReturnType temp = ReduceIterator_parallel(
+				total_real_particles, initial_reference_,
+				[&](size_t index_i, Real dt)
+				{ return derived_dynamics->reduce(index_i, dt); },
+				reduce_operation_, this->keyedLoopTuner(this->loop_tuner_, "reduce", total_real_particles), dt);
+			this->recordExecutionTiming(start_time);
+			return OutputResult(temp);
+		};
+
+	protected:
+		ReduceOperation reduce_operation_;
+		std::string quantity_name_;
+
+		/** initial or reference value */
+		ReturnType initial_reference_;
+		virtual void SetupReduce(){};
+		virtual ReturnType OutputResult(ReturnType reduced_value) { return reduced_value; };
+	};
+
+	/** compile-time index pack expanding over the fused reduce methods.
+	 * This is the C++14 std::index_sequence reduced to what is needed
+	 * here, since the library is built with -std=c++11. */
+	template <size_t... Is>
+	struct IndexSequence
+	{
+	};
+	template <size_t N, size_t... Is>
+	struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Is...>
+	{
+	};
+	template <size_t... Is>
+	struct MakeIndexSequence<0, Is...>
+	{
+		using type = IndexSequence<Is...>;
+	};
+	template <typename... Types>
+	using IndexSequenceFor = typename MakeIndexSequence<sizeof...(Types)>::type;
+
+	/**
+	 * @class FusedParticleReduce
+	 * @brief Execute several reductions sharing the same body in one particle
+	 * sweep with a tuple accumulator, so that monitoring quantities such as
+	 * the total mechanical energy, the body bounds and the velocity bound
+	 * check read the particle arrays only once per monitoring interval.
+	 */
+	template <typename... ReduceMethodTypes>
+	class FusedParticleReduce
+	{
+		using ReturnTuple = std::tuple<typename ReduceMethodTypes::ReduceReturnType...>;
+		using MethodIndexes = IndexSequenceFor<ReduceMethodTypes...>;
+
+	public:
+		explicit FusedParticleReduce(SPHBody &sph_body, ReduceMethodTypes &...reduce_methods)
+			: sph_body_(&sph_body), reduce_methods_(reduce_methods...){};
+		virtual ~FusedParticleReduce(){};
+
+		ReturnTuple exec(Real dt = 0.0)
+		{
+			size_t total_real_particles = sph_body_->base_particles_->total_real_particles_;
+			prepareReduces(MethodIndexes{});
+			ReturnTuple temp = initialReferences(MethodIndexes{});
+			for (size_t i = 0; i != total_real_particles; ++i)
+				temp = contributeParticle(temp, i, dt, MethodIndexes{});
+			return outputResults(temp, MethodIndexes{});
+		};
+
+		ReturnTuple parallel_exec(Real dt = 0.0)
+		{
+			size_t total_real_particles = sph_body_->base_particles_->total_real_particles_;
+			prepareReduces(MethodIndexes{});
+			ReturnTuple temp = initialReferences(MethodIndexes{});
+			particleExecutionArena().execute(
+				[&]
+				{
+					temp = parallel_reduce(
+						blocked_range<size_t>(0, total_real_particles), temp,
+						[&](const blocked_range<size_t> &r, ReturnTuple temp0) -> ReturnTuple
+						{
+							for (size_t i = r.begin(); i != r.end(); ++i)
+							{
+								temp0 = contributeParticle(temp0, i, dt, MethodIndexes{});
+							}
+							return temp0;
+						},
+						[&](const ReturnTuple &x, const ReturnTuple &y) -> ReturnTuple
+						{ return combineReduced(x, y, MethodIndexes{}); });
+				});
+			return outputResults(temp, MethodIndexes{});
+		};
+
+	protected:
+		SPHBody *sph_body_;
+		std::tuple<ReduceMethodTypes &...> reduce_methods_;
+
+		template <size_t... Is>
+		void prepareReduces(IndexSequence<Is...>)
+		{
+			int expands[] = {(std::get<Is>(reduce_methods_).PrepareReduce(), 0)...};
+			(void)expands;
+		};
+		template <size_t... Is>
+		ReturnTuple initialReferences(IndexSequence<Is...>)
+		{
+			return ReturnTuple(std::get<Is>(reduce_methods_).InitialReference()...);
+		};
+		template <size_t... Is>
+		ReturnTuple contributeParticle(ReturnTuple temp, size_t index_i, Real dt, IndexSequence<Is...>)
+		{
+			int expands[] = {(std::get<Is>(temp) = std::get<Is>(reduce_methods_).CombineReduced(
+								  std::get<Is>(temp), std::get<Is>(reduce_methods_).ReduceContribution(index_i, dt)),
+							  0)...};
+			(void)expands;
+			return temp;
+		};
+		template <size_t... Is>
+		ReturnTuple combineReduced(const ReturnTuple &x, const ReturnTuple &y, IndexSequence<Is...>)
+		{
+			return ReturnTuple(std::get<Is>(reduce_methods_).CombineReduced(std::get<Is>(x), std::get<Is>(y))...);
+		};
+		template <size_t... Is>
+		ReturnTuple outputResults(const ReturnTuple &reduced_values, IndexSequence<Is...>)
+		{
+			return ReturnTuple(std::get<Is>(reduce_methods_).FinishReduce(std::get<Is>(reduced_values))...);
 		};
 	};
 }
@@ -35,9 +35,9 @@ namespace SPH
 	{
 		for (size_t i = 0; i != body_part_cells.size(); ++i)
 		{
-			ListDataVector &list_data = body_part_cells[i]->cell_list_data_;
-			for (size_t num = 0; num < list_data.size(); ++num)
-				particle_functor(list_data[num].first, dt);
+			IndexVector &cell_list_indexes = body_part_cells[i]->cell_list_indexes_;
+			for (size_t num = 0; num < cell_list_indexes.size(); ++num)
+				particle_functor(cell_list_indexes[num], dt);
 		}
 	}
 	//=================================================================================================//
@@ -49,9 +49,9 @@ namespace SPH
 			{
 				for (size_t i = r.begin(); i < r.end(); ++i)
 				{
-					ListDataVector &list_data = body_part_cells[i]->cell_list_data_;
-					for (size_t num = 0; num < list_data.size(); ++num)
-						particle_functor(list_data[num].first, dt);
+					IndexVector &cell_list_indexes = body_part_cells[i]->cell_list_indexes_;
+					for (size_t num = 0; num < cell_list_indexes.size(); ++num)
+						particle_functor(cell_list_indexes[num], dt);
 				}
 			},
 			ap);
@@ -176,10 +176,10 @@ namespace SPH
 			this->SetupReduce();
 			for (size_t i = 0; i != body_part_cells_.size(); ++i)
 			{
-				ListDataVector &list_data = body_part_cells_[i]->cell_list_data_;
-				for (size_t num = 0; num < list_data.size(); ++num)
+				IndexVector &cell_list_indexes = body_part_cells_[i]->cell_list_indexes_;
+				for (size_t num = 0; num < cell_list_indexes.size(); ++num)
 				{
-					temp = reduce_operation_(temp, ReduceFunction(list_data[num].first, dt));
+					temp = reduce_operation_(temp, ReduceFunction(cell_list_indexes[num], dt));
 				}
 			}
 			return OutputResult(temp);
@@ -196,10 +196,10 @@ namespace SPH
 				{
 					for (size_t i = r.begin(); i != r.end(); ++i)
 					{
-						ListDataVector &list_data = body_part_cells_[i]->cell_list_data_;
-						for (size_t num = 0; num < list_data.size(); ++num)
+						IndexVector &cell_list_indexes = body_part_cells_[i]->cell_list_indexes_;
+						for (size_t num = 0; num < cell_list_indexes.size(); ++num)
 						{
-							temp0 = reduce_operation_(temp0, ReduceFunction(list_data[num].first, dt));
+							temp0 = reduce_operation_(temp0, ReduceFunction(cell_list_indexes[num], dt));
 						}
 					}
 					return temp0;
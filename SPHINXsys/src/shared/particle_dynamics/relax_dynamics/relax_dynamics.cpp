@@ -75,6 +75,43 @@ namespace SPH
 			pos_n_[index_i] += dvel_dt_[index_i] * dt_square * 0.5 / sph_adaptation_->SmoothingLengthRatio(index_i);
 		}
 		//=================================================================================================//
+		UpdateParticlePositionWithMomentum::UpdateParticlePositionWithMomentum(SPHBody &sph_body)
+			: ParticleDynamicsSimple(sph_body), RelaxDataDelegateSimple(sph_body),
+			  pos_n_(particles_->pos_n_), dvel_dt_(particles_->dvel_dt_),
+			  momentum_factor_(0.9)
+		{
+			particles_->registerAVariable(momentum_, "RelaxationMomentum");
+		}
+		//=================================================================================================//
+		void UpdateParticlePositionWithMomentum::Update(size_t index_i, Real dt_square)
+		{
+			Vecd increment = dvel_dt_[index_i] * dt_square * 0.5 / sph_adaptation_->SmoothingLengthRatio(index_i);
+			Vecd momentum = momentum_factor_ * momentum_[index_i] + increment;
+			// restart the momentum of a particle when it opposes the acceleration
+			if (SimTK::dot(momentum, dvel_dt_[index_i]) < 0.0)
+				momentum = increment;
+			momentum_[index_i] = momentum;
+			pos_n_[index_i] += momentum;
+		}
+		//=================================================================================================//
+		RelaxationResidue::RelaxationResidue(SPHBody &sph_body)
+			: ParticleDynamicsReduce<Real, ReduceMax>(sph_body),
+			  RelaxDataDelegateSimple(sph_body), dvel_dt_(particles_->dvel_dt_),
+			  h_ref_(sph_body.sph_adaptation_->ReferenceSmoothingLength())
+		{
+			initial_reference_ = 0.0;
+		}
+		//=================================================================================================//
+		Real RelaxationResidue::ReduceFunction(size_t index_i, Real dt)
+		{
+			return dvel_dt_[index_i].norm();
+		}
+		//=================================================================================================//
+		Real RelaxationResidue::OutputResult(Real reduced_value)
+		{
+			return reduced_value * h_ref_;
+		}
+		//=================================================================================================//
 		UpdateSmoothingLengthRatioByBodyShape::UpdateSmoothingLengthRatioByBodyShape(SPHBody &sph_body)
 			: ParticleDynamicsSimple(sph_body), RelaxDataDelegateSimple(sph_body),
 			  h_ratio_(*particles_->getVariableByName<Real>("SmoothingLengthRatio")),
@@ -139,9 +176,28 @@ namespace SPH
 			level_set_shape_ = &near_shape_surface.level_set_shape_;
 		}
 		//=================================================================================================//
+		void ShapeSurfaceBounding::setupDynamics(Real dt)
+		{
+			if (distance_at_last_probe_.size() != particles_->total_real_particles_)
+			{
+				// unreachable cached positions force an exact probe at the first visit
+				distance_at_last_probe_.resize(particles_->total_real_particles_, 0.0);
+				pos_at_last_probe_.resize(particles_->total_real_particles_, Vecd(Infinity));
+			}
+		}
+		//=================================================================================================//
 		void ShapeSurfaceBounding::Update(size_t index_i, Real dt)
 		{
+			//- the signed distance can not have drifted by more than the
+			//- displacement since the last exact probe, so a particle whose
+			//- bound remains below the band needs no probe at all
+			Real displacement = (pos_n_[index_i] - pos_at_last_probe_[index_i]).norm();
+			if (distance_at_last_probe_[index_i] + displacement <= -constrained_distance_)
+				return;
+
 			Real phi = level_set_shape_->findSignedDistance(pos_n_[index_i]);
+			distance_at_last_probe_[index_i] = phi;
+			pos_at_last_probe_[index_i] = pos_n_[index_i];
 
 			if (phi > -constrained_distance_)
 			{
@@ -199,6 +255,65 @@ namespace SPH
 			surface_bounding_.parallel_exec();
 		}
 		//=================================================================================================//
+		AcceleratedRelaxationStepInner::
+			AcceleratedRelaxationStepInner(BaseBodyRelationInner &inner_relation, bool level_set_correction)
+			: RelaxationStepInner(inner_relation, level_set_correction),
+			  update_particle_position_with_momentum_(*real_body_),
+			  relaxation_residue_(*real_body_),
+			  step_scaling_(1.0), previous_residue_(Infinity), residue_(Infinity) {}
+		//=================================================================================================//
+		void AcceleratedRelaxationStepInner::adaptStepScaling()
+		{
+			// grow the step while the residue decays, back off when it rebounds
+			step_scaling_ = residue_ < previous_residue_
+								? SMIN(step_scaling_ * 1.05, 4.0)
+								: SMAX(step_scaling_ * 0.5, 1.0);
+			previous_residue_ = residue_;
+		}
+		//=================================================================================================//
+		void AcceleratedRelaxationStepInner::exec(Real dt)
+		{
+			real_body_->updateCellLinkedList();
+			inner_relation_.updateConfiguration();
+			relaxation_acceleration_inner_->exec();
+			residue_ = relaxation_residue_.exec();
+			adaptStepScaling();
+			Real dt_square = get_time_step_square_.exec();
+			update_particle_position_with_momentum_.exec(step_scaling_ * dt_square);
+			surface_bounding_.exec();
+		}
+		//=================================================================================================//
+		void AcceleratedRelaxationStepInner::parallel_exec(Real dt)
+		{
+			real_body_->updateCellLinkedList();
+			inner_relation_.updateConfiguration();
+			relaxation_acceleration_inner_->parallel_exec();
+			residue_ = relaxation_residue_.parallel_exec();
+			adaptStepScaling();
+			Real dt_square = get_time_step_square_.parallel_exec();
+			update_particle_position_with_momentum_.parallel_exec(step_scaling_ * dt_square);
+			surface_bounding_.parallel_exec();
+		}
+		//=================================================================================================//
+		size_t AcceleratedRelaxationStepInner::
+			relaxUntilConverged(Real relative_tolerance, size_t max_iterations)
+		{
+			Real initial_residue = 0.0;
+			size_t iteration = 0;
+			while (iteration != max_iterations)
+			{
+				parallel_exec();
+				iteration++;
+				if (iteration == 1)
+					initial_residue = residue_;
+				if (residue_ < relative_tolerance * initial_residue + TinyReal)
+					break;
+			}
+			std::cout << "\n Information: particle relaxation reached the residue " << residue_
+					  << " after '" << iteration << "' steps." << std::endl;
+			return iteration;
+		}
+		//=================================================================================================//
 		RelaxationAccelerationComplexWithLevelSetCorrection::
 			RelaxationAccelerationComplexWithLevelSetCorrection(ComplexBodyRelation &body_complex_relation, const std::string &shape_name)
 			: RelaxationAccelerationComplex(body_complex_relation)
@@ -119,6 +119,50 @@ namespace SPH
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class UpdateParticlePositionWithMomentum
+		 * @brief update the particle position with a heavy-ball momentum on the
+		 * displacement increments, so that the slowly decaying long-wave errors
+		 * of the relaxation are traversed in fewer iterations. The momentum of a
+		 * particle is restarted whenever it opposes the driving acceleration,
+		 * which suppresses the overshoot oscillations of plain momentum.
+		 */
+		class UpdateParticlePositionWithMomentum : public ParticleDynamicsSimple,
+												   public RelaxDataDelegateSimple
+		{
+		public:
+			explicit UpdateParticlePositionWithMomentum(SPHBody &sph_body);
+			virtual ~UpdateParticlePositionWithMomentum(){};
+
+			void setMomentumFactor(Real momentum_factor) { momentum_factor_ = momentum_factor; };
+
+		protected:
+			StdLargeVec<Vecd> &pos_n_, &dvel_dt_;
+			StdLargeVec<Vecd> momentum_; /**< accumulated displacement increments. */
+			Real momentum_factor_;
+			virtual void Update(size_t index_i, Real dt = 0.0) override;
+		};
+
+		/**
+		 * @class RelaxationResidue
+		 * @brief the maximum residual acceleration of the relaxation scaled by
+		 * the reference smoothing length, as a resolution-independent measure
+		 * of how far the particle distribution is from the relaxed state.
+		 */
+		class RelaxationResidue : public ParticleDynamicsReduce<Real, ReduceMax>,
+								  public RelaxDataDelegateSimple
+		{
+		public:
+			explicit RelaxationResidue(SPHBody &sph_body);
+			virtual ~RelaxationResidue(){};
+
+		protected:
+			StdLargeVec<Vecd> &dvel_dt_;
+			Real h_ref_;
+			Real ReduceFunction(size_t index_i, Real dt = 0.0) override;
+			Real OutputResult(Real reduced_value) override;
+		};
+
 		/**
 		 * @class UpdateSmoothingLengthRatioByBodyShape
 		 * @brief update the particle smoothing length ratio
@@ -164,7 +208,12 @@ namespace SPH
 		 * @class ShapeSurfaceBounding
 		 * @brief constrain surface particles by
 		 * map contrained particles to geometry face and
-		 * r = r + phi * norm (vector distance to face)
+		 * r = r + phi * norm (vector distance to face).
+		 * The level-set probes are cached per particle: the signed distance
+		 * can not have drifted by more than the particle displacement since
+		 * its last exact probe, so particles provably still below the bounding
+		 * band skip the probe. As the relaxation displacements shrink over the
+		 * iterations, most particles stop probing altogether.
 		 */
 		class ShapeSurfaceBounding : public PartDynamicsByCell,
 									 public RelaxDataDelegateSimple
@@ -177,6 +226,9 @@ namespace SPH
 			StdLargeVec<Vecd> &pos_n_;
 			LevelSetShape *level_set_shape_;
 			Real constrained_distance_;
+			StdLargeVec<Real> distance_at_last_probe_; /**< signed distance at the last exact probe */
+			StdLargeVec<Vecd> pos_at_last_probe_;	   /**< position at the last exact probe */
+			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 		};
 
@@ -225,6 +277,40 @@ namespace SPH
 			virtual void parallel_exec(Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class AcceleratedRelaxationStepInner
+		 * @brief relaxation step with momentum on the position updates and an
+		 * adaptive scaling of the time step square: the step grows while the
+		 * relaxation residue decays and backs off when it rebounds. Together
+		 * with the residue-based early stopping of relaxUntilConverged(), the
+		 * relaxed state is typically reached in a fraction of the iterations
+		 * of the fixed-count plain stepping.
+		 */
+		class AcceleratedRelaxationStepInner : public RelaxationStepInner
+		{
+		public:
+			explicit AcceleratedRelaxationStepInner(BaseBodyRelationInner &inner_relation,
+													bool level_set_correction = false);
+			virtual ~AcceleratedRelaxationStepInner(){};
+
+			UpdateParticlePositionWithMomentum update_particle_position_with_momentum_;
+			RelaxationResidue relaxation_residue_;
+
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+			/** iterate until the residue has dropped below the given fraction of
+			 * its initial value, returns the number of iterations used. */
+			size_t relaxUntilConverged(Real relative_tolerance = 0.01, size_t max_iterations = 2000);
+			Real Residue() { return residue_; };
+
+		protected:
+			Real step_scaling_;		/**< adaptive scaling of the time step square. */
+			Real previous_residue_; /**< residue of the previous iteration. */
+			Real residue_;			/**< residue of the last iteration. */
+
+			void adaptStepScaling();
+		};
+
 		/**
 		 * @class RelaxationAccelerationComplexWithLevelSetCorrection
 		 * @brief compute relaxation acceleration while consider the present of contact bodies
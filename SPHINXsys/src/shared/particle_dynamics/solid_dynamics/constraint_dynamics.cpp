@@ -239,7 +239,9 @@ namespace SPH
 			try
 			{
 				Vecd point = pos_0_[index_i];
-				if (checkIfPointInBoundingBox(point, bbox_))
+				//qualified: in the padded build argument dependent lookup would
+				//also find the SPH level overload of the unpadded vector
+				if (solid_dynamics::checkIfPointInBoundingBox(point, bbox_))
 				{
 					if (GlobalStaticVariables::physical_time_ >= start_time_ && GlobalStaticVariables::physical_time_ <= end_time_)
 					{
@@ -361,6 +363,14 @@ namespace SPH
 			body_->setNewlyUpdated();
 			simbody_state_ = &integ_.getState();
 			MBsystem_.realize(*simbody_state_, Stage::Acceleration);
+			// cache the spatial kinematics of the mobilized body once per exchange,
+			// the constraint pass then only carries out plain vector arithmetic
+			mobod_rotation_ = mobod_.getBodyRotation(*simbody_state_);
+			mobod_origin_location_ = mobod_.getBodyOriginLocation(*simbody_state_);
+			mobod_origin_velocity_ = mobod_.getBodyOriginVelocity(*simbody_state_);
+			mobod_origin_acceleration_ = mobod_.getBodyOriginAcceleration(*simbody_state_);
+			mobod_angular_velocity_ = mobod_.getBodyAngularVelocity(*simbody_state_);
+			mobod_angular_acceleration_ = mobod_.getBodyAngularAcceleration(*simbody_state_);
 		}
 		//=================================================================================================//
 		TotalForceOnSolidBodyPartForSimBody::
@@ -382,7 +392,8 @@ namespace SPH
 		void TotalForceOnSolidBodyPartForSimBody::SetupReduce()
 		{
 			simbody_state_ = &integ_.getState();
-			MBsystem_.realize(*simbody_state_, Stage::Acceleration);
+			// only the configuration is needed for the moment arms of the reduced torque
+			MBsystem_.realize(*simbody_state_, Stage::Position);
 			current_mobod_origin_location_ = mobod_.getBodyOriginLocation(*simbody_state_);
 		}
 		//=================================================================================================//
@@ -294,6 +294,11 @@ namespace SPH
 			SimTK::RungeKuttaMersonIntegrator &integ_;
 			const SimTK::State *simbody_state_;
 			Vec3d initial_mobod_origin_location_;
+			/** mobilized-body spatial kinematics cached once per exchange,
+			 * so that the particle update runs without per-particle SimTK queries */
+			SimTK::Rotation mobod_rotation_;
+			Vec3d mobod_origin_location_, mobod_origin_velocity_, mobod_origin_acceleration_;
+			Vec3d mobod_angular_velocity_, mobod_angular_acceleration_;
 
 			virtual void setupDynamics(Real dt = 0.0) override;
 			void virtual Update(size_t index_i, Real dt = 0.0) override;
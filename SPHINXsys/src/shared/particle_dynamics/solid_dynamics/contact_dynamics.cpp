@@ -90,7 +90,11 @@ namespace SPH
 			  ContactDynamicsData(solid_body_contact_relation), pos_n_(particles_->pos_n_),
 			  contact_density_(particles_->contact_density_),
 			  kernel_(solid_body_contact_relation.sph_body_->sph_adaptation_->getKernel()),
-			  spacing_ref_(solid_body_contact_relation.sph_body_->sph_adaptation_->ReferenceSpacing())
+			  spacing_ref_(solid_body_contact_relation.sph_body_->sph_adaptation_->ReferenceSpacing()),
+			  contact_relation_(&solid_body_contact_relation),
+			  quadrature_weights_built_(false), rebuild_quadrature_weights_(true),
+			  cached_configuration_version_(0),
+			  quadrature_weights_(contact_configuration_.size())
 		{
 			for (size_t k = 0; k != contact_particles_.size(); ++k)
 			{
@@ -98,34 +102,61 @@ namespace SPH
 			}
 		}
 		//=================================================================================================//
-		void ShellContactDensity::Interaction(size_t index_i, Real dt)
+		void ShellContactDensity::setupDynamics(Real dt)
 		{
-			/** shell contact interaction. */
-			Real sigma = 0.0;
 			const int dimension = Vecd(0).size();
 			/** a calibraton factor to avoid particle penetratoin into shell structure */
 			boundary_factor_ = material_->ReferenceDensity() /
 							   (kernel_->SmoothingLength() * kernel_->W0(Vecd(0.)) * Pi * std::pow(kernel_->CutOffRadius(), dimension - 1));
 
+			/** the cached quadrature weights follow the built configuration,
+			 * so they are only recomputed after a configuration update. */
+			rebuild_quadrature_weights_ =
+				!quadrature_weights_built_ ||
+				cached_configuration_version_ != contact_relation_->ConfigurationVersion();
+			if (rebuild_quadrature_weights_)
+			{
+				quadrature_weights_built_ = true;
+				cached_configuration_version_ = contact_relation_->ConfigurationVersion();
+				for (size_t k = 0; k < contact_configuration_.size(); ++k)
+				{
+					quadrature_weights_[k].resize(particles_->real_particles_bound_);
+				}
+			}
+		}
+		//=================================================================================================//
+		void ShellContactDensity::Interaction(size_t index_i, Real dt)
+		{
+			/** shell contact interaction. */
+			Real sigma = 0.0;
 			const Real dp_2 = 0.5 * spacing_ref_;
 
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
-				StdLargeVec<Vecd> &contact_pos_k = *(contact_pos_[k]);
 				Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+				StdVec<Real> &quadrature_weights = quadrature_weights_[k][index_i];
+				if (rebuild_quadrature_weights_)
+				{
+					StdLargeVec<Vecd> &contact_pos_k = *(contact_pos_[k]);
+					quadrature_weights.resize(contact_neighborhood.current_size_);
+					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+					{
+						const Vecd contact_pos_j = contact_pos_k[contact_neighborhood.j_[n]];
+
+						const Vecd dp_2_t_0 = pos_n_[index_i] - Vecd(dp_2 * x_0, dp_2 * x_0) - contact_pos_j;
+						const Vecd dp_2_t_1 = pos_n_[index_i] - Vecd(dp_2 * x_1, dp_2 * x_1) - contact_pos_j;
+						const Vecd dp_2_t_2 = pos_n_[index_i] - Vecd(dp_2 * x_2, dp_2 * x_2) - contact_pos_j;
+
+						const Real W_rij_t_0 = kernel_->W(dp_2_t_0.norm(), dp_2_t_0);
+						const Real W_rij_t_1 = kernel_->W(dp_2_t_1.norm(), dp_2_t_1);
+						const Real W_rij_t_2 = kernel_->W(dp_2_t_2.norm(), dp_2_t_2);
+
+						quadrature_weights[n] = (w_0 * W_rij_t_0 + w_1 * W_rij_t_1 + w_2 * W_rij_t_2) * dp_2;
+					}
+				}
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
-					const Vecd contact_pos_j = contact_pos_k[contact_neighborhood.j_[n]];
-
-					const Vecd dp_2_t_0 = pos_n_[index_i] - Vecd(dp_2 * x_0, dp_2 * x_0) - contact_pos_j;
-					const Vecd dp_2_t_1 = pos_n_[index_i] - Vecd(dp_2 * x_1, dp_2 * x_1) - contact_pos_j;
-					const Vecd dp_2_t_2 = pos_n_[index_i] - Vecd(dp_2 * x_2, dp_2 * x_2) - contact_pos_j;
-
-					const Real W_rij_t_0 = kernel_->W(dp_2_t_0.norm(), dp_2_t_0);
-					const Real W_rij_t_1 = kernel_->W(dp_2_t_1.norm(), dp_2_t_1);
-					const Real W_rij_t_2 = kernel_->W(dp_2_t_2.norm(), dp_2_t_2);
-
-					sigma += (w_0 * W_rij_t_0 + w_1 * W_rij_t_1 + w_2 * W_rij_t_2) * dp_2;
+					sigma += quadrature_weights[n];
 				}
 			}
 			contact_density_[index_i] = sigma * boundary_factor_ * kernel_->SmoothingLength();
@@ -288,6 +319,72 @@ namespace SPH
 			contact_force_[index_i] = force;
 			dvel_dt_prior_[index_i] += force / mass_[index_i];
 		}
+		//=================================================================================================//
+		ContactDensityAndForceFromWall::
+			ContactDensityAndForceFromWall(SolidBodyRelationContact &solid_body_contact_relation)
+			: PartInteractionDynamicsByParticle(*solid_body_contact_relation.sph_body_,
+												*solid_body_contact_relation.body_surface_layer_),
+			  ContactWithWallData(solid_body_contact_relation),
+			  mass_(particles_->mass_), contact_density_(particles_->contact_density_),
+			  Vol_(particles_->Vol_),
+			  dvel_dt_prior_(particles_->dvel_dt_prior_),
+			  contact_force_(particles_->contact_force_),
+			  offset_W_ij_(StdVec<Real>(contact_configuration_.size(), 0.0))
+		{
+			for (size_t k = 0; k != contact_particles_.size(); ++k)
+			{
+				contact_mass_.push_back(&(contact_particles_[k]->mass_));
+				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
+			}
+
+			// the same offset as in ContactDensitySummation, so that exactly
+			// touching bodies produce 0 initial force
+			Real dp_1 = solid_body_contact_relation.sph_body_->sph_adaptation_->ReferenceSpacing();
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				Real dp_2 = solid_body_contact_relation.contact_bodies_[k]->sph_adaptation_->ReferenceSpacing();
+				Real distance = 0.5 * dp_1 + 0.5 * dp_2;
+				offset_W_ij_[k] = solid_body_contact_relation.sph_body_->sph_adaptation_->getKernel()->W(distance, Vecd(0.0));
+			}
+		}
+		//=================================================================================================//
+		void ContactDensityAndForceFromWall::Interaction(size_t index_i, Real dt)
+		{
+			/** first sweep: the contact density of particle i from the wall particles. */
+			Real sigma = 0.0;
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				StdLargeVec<Real> &contact_mass_k = *(contact_mass_[k]);
+				Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+				{
+					Real corrected_W_ij = std::max(contact_neighborhood.W_ij_[n] - offset_W_ij_[k], 0.0);
+					sigma += corrected_W_ij * contact_mass_k[contact_neighborhood.j_[n]];
+				}
+			}
+			contact_density_[index_i] = sigma;
+
+			/** second sweep: the force from the freshly summed density, over the
+			 * still cache-resident neighbor data. */
+			Real Vol_i = Vol_[index_i];
+			Real p_i = sigma * material_->ContactStiffness();
+			Vecd force(0.0);
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				StdLargeVec<Real> &Vol_k = *(contact_Vol_[k]);
+				Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+				{
+					size_t index_j = contact_neighborhood.j_[n];
+					Vecd e_ij = contact_neighborhood.e_ij_[n];
+
+					// force due to pressure
+					force -= 2.0 * p_i * e_ij * Vol_i * Vol_k[index_j] * contact_neighborhood.dW_ij_[n];
+				}
+			}
+			contact_force_[index_i] = force;
+			dvel_dt_prior_[index_i] += force / mass_[index_i];
+		}
 	//=================================================================================================//
 	PairwiseFrictionFromWall::
 		PairwiseFrictionFromWall(BaseBodyRelationContact &contact_relation, Real eta)
@@ -80,6 +80,11 @@ namespace SPH
 		 * @class ShellContactDensity
 		 * @brief Computing the contact density due to shell contact using a
 		 * 		 surface integral being solved by Gauss-Legendre quadrature integration.
+		 * The quadrature kernel evaluations of a pair depend only on the pair
+		 * geometry of the built configuration, so they are summed into cached
+		 * per-pair weights on the first pass after each configuration build,
+		 * and the passes of the following sub-steps reduce to a plain sum
+		 * over the cached weights.
 		 */
 		class ShellContactDensity : public PartInteractionDynamicsByParticle, public ContactDynamicsData
 		{
@@ -96,6 +101,16 @@ namespace SPH
 			Real spacing_ref_, boundary_factor_;
 			SPHBody *sph_body_;
 
+			/** the relation whose configuration version keys the cached weights. */
+			BaseBodyRelationContact *contact_relation_;
+			bool quadrature_weights_built_;
+			bool rebuild_quadrature_weights_;
+			size_t cached_configuration_version_;
+			/** per contact body and particle, the quadrature-summed kernel
+			 * weights of its pairs, valid for one built configuration. */
+			StdVec<StdLargeVec<StdVec<Real>>> quadrature_weights_;
+
+			virtual void setupDynamics(Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 
 			/** Abscissas and weights for Gauss-Legendre quadrature integration with n=3 nodes */
@@ -164,6 +179,32 @@ namespace SPH
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class ContactDensityAndForceFromWall
+		 * @brief Fused contact density summation and contact force with a rigid
+		 * wall, replacing the separate ContactDensitySummation and
+		 * ContactForceFromWall passes. The force from a rigid wall depends only
+		 * on the contact density of the colliding particle itself, so both can
+		 * be computed in one traversal of the contact neighborhoods: a first
+		 * sweep sums the density, and a second sweep over the then cache-resident
+		 * neighbor data forms the force from it, halving the contact-pair memory
+		 * traffic of contact-dominated impact simulations.
+		 */
+		class ContactDensityAndForceFromWall : public PartInteractionDynamicsByParticle, public ContactWithWallData
+		{
+		public:
+			explicit ContactDensityAndForceFromWall(SolidBodyRelationContact &solid_body_contact_relation);
+			virtual ~ContactDensityAndForceFromWall(){};
+
+		protected:
+			StdLargeVec<Real> &mass_, &contact_density_, &Vol_;
+			StdLargeVec<Vecd> &dvel_dt_prior_, &contact_force_;
+			StdVec<StdLargeVec<Real> *> contact_mass_, contact_Vol_;
+			StdVec<Real> offset_W_ij_;
+
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		 * @class PairwiseFrictionFromWall
 		 * @brief Damping to wall by which the wall velocity is not updated
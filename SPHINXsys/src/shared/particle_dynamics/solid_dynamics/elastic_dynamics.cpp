@@ -5,6 +5,8 @@
 
 #include "elastic_dynamics.h"
 #include "general_dynamics.h"
+#include "small_matrix_functions.h"
+#include "complex_solid.hpp"
 
 #include <numeric>
 
@@ -44,11 +46,29 @@ namespace SPH
 		UpdateElasticNormalDirection::
 			UpdateElasticNormalDirection(SolidBody &solid_body)
 			: ParticleDynamicsSimple(solid_body),
-			  ElasticSolidDataSimple(solid_body),
+			  ElasticSolidDataSimple(solid_body), body_surface_(solid_body),
 			  n_(particles_->n_), n_0_(particles_->n_0_), F_(particles_->F_)
 		{
 		}
 		//=================================================================================================//
+		void UpdateElasticNormalDirection::exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			PartIteratorByParticle(body_surface_.body_part_particles_, functor_update_, dt);
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
+		void UpdateElasticNormalDirection::parallel_exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			PartIteratorByParticle_parallel(body_surface_.body_part_particles_, functor_update_, dt);
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
 		DeformationGradientTensorBySummation::
 			DeformationGradientTensorBySummation(BaseBodyRelationInner &inner_relation)
 			: InteractionDynamics(*inner_relation.sph_body_),
@@ -59,20 +79,29 @@ namespace SPH
 		}
 		//=================================================================================================//
 		void DeformationGradientTensorBySummation::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? summationInteraction(index_i, compact_inner_configuration_[index_i])
+				: summationInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void DeformationGradientTensorBySummation::summationInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			Vecd &pos_n_i = pos_n_[index_i];
 
 			Matd deformation(0.0);
-			Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, pos_n_);
+				prefetchGatheredData(inner_neighborhood, n, Vol_);
 
 				Vecd gradw_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
 				deformation -= Vol_[index_j] * SimTK::outer((pos_n_i - pos_n_[index_j]), gradw_ij);
 			}
 
-			F_[index_i] = B_[index_i] * deformation;
+			F_[index_i] = fastMatrixProduct(B_[index_i], deformation);
 		}
 		//=================================================================================================//
 		BaseElasticRelaxation::
@@ -102,17 +131,28 @@ namespace SPH
 			rho_n_[index_i] = rho0_ / det(F_[index_i]);
 			// obtain the first Piola-Kirchhoff stress from the second Piola-Kirchhoff stress
 			// it seems using reproducing correction here increases convergence rate near the free surface
-			stress_PK1_[index_i] = F_[index_i] * material_->ConstitutiveRelation(F_[index_i], index_i) * B_[index_i];
+			stress_PK1_[index_i] = fastMatrixProduct(
+				fastMatrixProduct(F_[index_i], material_->ConstitutiveRelation(F_[index_i], index_i)), B_[index_i]);
 		}
 		//=================================================================================================//
 		void StressRelaxationFirstHalf::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? stressInteraction(index_i, compact_inner_configuration_[index_i])
+				: stressInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void StressRelaxationFirstHalf::stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			// including gravity and force from fluid
 			Vecd acceleration = dvel_dt_prior_[index_i] + force_from_fluid_[index_i] / mass_[index_i];
-			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, pos_n_);
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, stress_PK1_);
 				Vecd e_ij = inner_neighborhood.e_ij_[n];
 				Real r_ij = inner_neighborhood.r_ij_[n];
 				Real dim_r_ij_1 = Dimensions / r_ij;
@@ -122,9 +162,10 @@ namespace SPH
 				Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
 				Matd numerical_stress_ij =
 					0.5 * (F_[index_i] + F_[index_j]) * material_->PairNumericalDamping(strain_rate, smoothing_length_);
-				acceleration += (stress_PK1_[index_i] + stress_PK1_[index_j] +
-								 numerical_dissipation_factor_ * weight * numerical_stress_ij) *
-								inner_neighborhood.dW_ij_[n] * e_ij * Vol_[index_j] * inv_rho0_;
+				acceleration += fastMatrixVectorProduct(stress_PK1_[index_i] + stress_PK1_[index_j] +
+															numerical_dissipation_factor_ * weight * numerical_stress_ij,
+														e_ij) *
+								inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inv_rho0_;
 			}
 
 			dvel_dt_[index_i] = acceleration;
@@ -135,6 +176,76 @@ namespace SPH
 			vel_n_[index_i] += dvel_dt_[index_i] * dt;
 		}
 		//=================================================================================================//
+		template <class MaterialType>
+		StressRelaxationFirstHalfKnownMaterial<MaterialType>::
+			StressRelaxationFirstHalfKnownMaterial(BaseBodyRelationInner &inner_relation)
+			: StressRelaxationFirstHalf(inner_relation),
+			  known_material_(DynamicCast<MaterialType>(this, material_)) {}
+		//=================================================================================================//
+		template <class MaterialType>
+		void StressRelaxationFirstHalfKnownMaterial<MaterialType>::Initialization(size_t index_i, Real dt)
+		{
+			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
+			F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+			rho_n_[index_i] = rho0_ / det(F_[index_i]);
+			// the qualified call on the concrete material type is resolved statically
+			stress_PK1_[index_i] = fastMatrixProduct(
+				fastMatrixProduct(F_[index_i],
+								  known_material_->MaterialType::ConstitutiveRelation(F_[index_i], index_i)),
+				B_[index_i]);
+		}
+		//=================================================================================================//
+		template <class MaterialType>
+		void StressRelaxationFirstHalfKnownMaterial<MaterialType>::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? stressInteraction(index_i, compact_inner_configuration_[index_i])
+				: stressInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class MaterialType>
+		template <class NeighborhoodType>
+		void StressRelaxationFirstHalfKnownMaterial<MaterialType>::
+			stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
+		{
+			// including gravity and force from fluid
+			Vecd acceleration = dvel_dt_prior_[index_i] + force_from_fluid_[index_i] / mass_[index_i];
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, pos_n_);
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, stress_PK1_);
+				Vecd e_ij = inner_neighborhood.e_ij_[n];
+				Real r_ij = inner_neighborhood.r_ij_[n];
+				Real dim_r_ij_1 = Dimensions / r_ij;
+				Vecd pos_jump = pos_n_[index_i] - pos_n_[index_j];
+				Vecd vel_jump = vel_n_[index_i] - vel_n_[index_j];
+				Real strain_rate = SimTK::dot(pos_jump, vel_jump) * dim_r_ij_1 * dim_r_ij_1;
+				Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
+				// the qualified call on the concrete material type is resolved statically
+				Matd numerical_stress_ij =
+					0.5 * (F_[index_i] + F_[index_j]) *
+					known_material_->MaterialType::PairNumericalDamping(strain_rate, smoothing_length_);
+				acceleration += fastMatrixVectorProduct(stress_PK1_[index_i] + stress_PK1_[index_j] +
+															numerical_dissipation_factor_ * weight * numerical_stress_ij,
+														e_ij) *
+								inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inv_rho0_;
+			}
+
+			dvel_dt_[index_i] = acceleration;
+		}
+		//=================================================================================================//
+		template class StressRelaxationFirstHalfKnownMaterial<LinearElasticSolid>;
+		template class StressRelaxationFirstHalfKnownMaterial<NeoHookeanSolid>;
+		template class StressRelaxationFirstHalfKnownMaterial<FeneNeoHookeanSolid>;
+		template class StressRelaxationFirstHalfKnownMaterial<Muscle>;
+		template class StressRelaxationFirstHalfKnownMaterial<LocallyOrthotropicMuscle>;
+		// the qualified call fuses the active contraction term of ActiveMuscle into
+		// the passive constitutive relation within a single pass over the deformation state
+		template class StressRelaxationFirstHalfKnownMaterial<ActiveMuscle<Muscle>>;
+		template class StressRelaxationFirstHalfKnownMaterial<ActiveMuscle<LocallyOrthotropicMuscle>>;
+		//=================================================================================================//
 		KirchhoffParticleStressRelaxationFirstHalf::
 			KirchhoffParticleStressRelaxationFirstHalf(BaseBodyRelationInner &inner_relation)
 			: StressRelaxationFirstHalf(inner_relation){};
@@ -148,15 +259,17 @@ namespace SPH
 			Real one_over_J = 1.0 / J;
 			rho_n_[index_i] = rho0_ * one_over_J;
 			Real J_to_minus_2_over_dimension = pow(one_over_J, 2.0 * one_over_dimensions_);
-			Matd normalized_b = (F_[index_i] * ~F_[index_i]) * J_to_minus_2_over_dimension;
+			Matd normalized_b = fastMatrixProduct(F_[index_i], ~F_[index_i]) * J_to_minus_2_over_dimension;
 			Matd deviatoric_b = normalized_b - Matd(1.0) * normalized_b.trace() * one_over_dimensions_;
-			Matd inverse_F_T = ~SimTK::inverse(F_[index_i]);
+			Matd inverse_F_T = ~fastInverse(F_[index_i]);
 			// obtain the first Piola-Kirchhoff stress from the Kirchhoff stress
 			// it seems using reproducing correction here increases convergence rate
 			// near the free surface however, this correction is not used for the numerical disspation
-			stress_PK1_[index_i] = (Matd(1.0) * material_->VolumetricKirchhoff(J) +
-									material_->DeviatoricKirchhoff(deviatoric_b)) *
-								   inverse_F_T * B_[index_i];
+			stress_PK1_[index_i] = fastMatrixProduct(
+				fastMatrixProduct(Matd(1.0) * material_->VolumetricKirchhoff(J) +
+									  material_->DeviatoricKirchhoff(deviatoric_b),
+								  inverse_F_T),
+				B_[index_i]);
 		}
 		//=================================================================================================//
 		KirchhoffStressRelaxationFirstHalf::
@@ -176,22 +289,31 @@ namespace SPH
 			Real one_over_J = 1.0 / J;
 			rho_n_[index_i] = rho0_ * one_over_J;
 			J_to_minus_2_over_dimension_[index_i] = pow(one_over_J * one_over_J, one_over_dimensions_);
-			inverse_F_T_[index_i] = ~SimTK::inverse(F_[index_i]);
-			stress_on_particle_[index_i] = 
+			inverse_F_T_[index_i] = ~fastInverse(F_[index_i]);
+			stress_on_particle_[index_i] =
 				inverse_F_T_[index_i] * (material_->VolumetricKirchhoff(J) -
-										 correction_factor_ * material_->ShearModulus() * J_to_minus_2_over_dimension_[index_i] * (F_[index_i] * ~F_[index_i]).trace() * one_over_dimensions_) +
-				material_->NumericalDampingLeftCauchy(F_[index_i], dF_dt_[index_i], smoothing_length_, index_i) * inverse_F_T_[index_i];
-			stress_PK1_[index_i] = F_[index_i] * material_->ConstitutiveRelation(F_[index_i], index_i);
+										 correction_factor_ * material_->ShearModulus() * J_to_minus_2_over_dimension_[index_i] * fastMatrixProduct(F_[index_i], ~F_[index_i]).trace() * one_over_dimensions_) +
+				fastMatrixProduct(material_->NumericalDampingLeftCauchy(F_[index_i], dF_dt_[index_i], smoothing_length_, index_i), inverse_F_T_[index_i]);
+			stress_PK1_[index_i] = fastMatrixProduct(F_[index_i], material_->ConstitutiveRelation(F_[index_i], index_i));
 		}
 		//=================================================================================================//
 		void KirchhoffStressRelaxationFirstHalf::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? stressInteraction(index_i, compact_inner_configuration_[index_i])
+				: stressInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void KirchhoffStressRelaxationFirstHalf::stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			// including gravity and force from fluid
 			Vecd acceleration = dvel_dt_prior_[index_i] + force_from_fluid_[index_i] / mass_[index_i];
-			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, pos_n_);
+				prefetchGatheredData(inner_neighborhood, n, stress_on_particle_);
 				Vecd shear_force_ij = correction_factor_ * material_->ShearModulus() *
 									  (J_to_minus_2_over_dimension_[index_i] + J_to_minus_2_over_dimension_[index_j]) *
 									  (pos_n_[index_i] - pos_n_[index_j]) / inner_neighborhood.r_ij_[n];
@@ -207,21 +329,30 @@ namespace SPH
 		}
 		//=================================================================================================//
 		void StressRelaxationSecondHalf::Interaction(size_t index_i, Real dt)
+		{
+			inner_relation_->usingCompactConfiguration()
+				? deformationRateInteraction(index_i, compact_inner_configuration_[index_i])
+				: deformationRateInteraction(index_i, inner_configuration_[index_i]);
+		}
+		//=================================================================================================//
+		template <class NeighborhoodType>
+		void StressRelaxationSecondHalf::deformationRateInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood)
 		{
 			const Vecd &vel_n_i = vel_n_[index_i];
 
 			Matd deformation_gradient_change_rate(0);
-			const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
+				prefetchGatheredData(inner_neighborhood, n, vel_n_);
+				prefetchGatheredData(inner_neighborhood, n, Vol_);
 
 				Vecd gradw_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
 				deformation_gradient_change_rate -=
 					Vol_[index_j] * SimTK::outer((vel_n_i - vel_n_[index_j]), gradw_ij);
 			}
 
-			dF_dt_[index_i] = deformation_gradient_change_rate * B_[index_i];
+			dF_dt_[index_i] = fastMatrixProduct(deformation_gradient_change_rate, B_[index_i]);
 		}
 		//=================================================================================================//
 		void StressRelaxationSecondHalf::Update(size_t index_i, Real dt)
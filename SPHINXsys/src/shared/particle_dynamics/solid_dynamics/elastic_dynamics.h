@@ -72,7 +72,11 @@ namespace SPH
 
 		/**
 		* @class UpdateElasticNormalDirection
-		* @brief update particle normal directions for elastic solid
+		* @brief update particle normal directions for elastic solid.
+		* The normals are only consumed at the body surface, for FSI coupling
+		* and contact, so the update is restricted to the surface particles
+		* and skips the interior ones entirely. The surface particle set is
+		* material and thus tagged once in the reference configuration.
 		*/
 		class UpdateElasticNormalDirection : public ParticleDynamicsSimple, public ElasticSolidDataSimple
 		{
@@ -80,7 +84,11 @@ namespace SPH
 			explicit UpdateElasticNormalDirection(SolidBody &solid_body);
 			virtual ~UpdateElasticNormalDirection(){};
 
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
 		protected:
+			BodySurface body_surface_;
 			StdLargeVec<Vecd> &n_, &n_0_;
 			StdLargeVec<Matd> &F_;
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
@@ -120,6 +128,8 @@ namespace SPH
 			StdLargeVec<Vecd> &pos_n_;
 			StdLargeVec<Matd> &B_, &F_;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void summationInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 
 		/**
@@ -161,9 +171,37 @@ namespace SPH
 
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		* @class StressRelaxationFirstHalfKnownMaterial
+		* @brief the first half stress relaxation with the material law known at compile time.
+		* The constitutive relation and the pair numerical damping are invoked with
+		* qualified calls on the concrete material type, so that they inline into the
+		* particle loops instead of being virtually dispatched per particle and pair,
+		* which allows the compiler to vectorize the entire stress update.
+		* The generic StressRelaxationFirstHalf remains the fallback for materials
+		* without an instantiation here.
+		*/
+		template <class MaterialType>
+		class StressRelaxationFirstHalfKnownMaterial : public StressRelaxationFirstHalf
+		{
+		public:
+			explicit StressRelaxationFirstHalfKnownMaterial(BaseBodyRelationInner &inner_relation);
+			virtual ~StressRelaxationFirstHalfKnownMaterial(){};
+
+		protected:
+			MaterialType *known_material_;
+
+			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
+		};
+
 		/**
 		* @class KirchhoffParticleStressRelaxationFirstHalf
 		*/
@@ -208,6 +246,8 @@ namespace SPH
 
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void stressInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 		};
 
 		/**
@@ -219,12 +259,19 @@ namespace SPH
 		{
 		public:
 			explicit StressRelaxationSecondHalf(BaseBodyRelationInner &inner_relation)
-				: BaseElasticRelaxation(inner_relation){};
+				: BaseElasticRelaxation(inner_relation)
+			{
+				// the update only consumes the own deformation rate,
+				// so it can run in the same particle sweep as the interaction
+				useFusedUpdate();
+			};
 			virtual ~StressRelaxationSecondHalf(){};
 
 		protected:
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			template <class NeighborhoodType>
+			void deformationRateInteraction(size_t index_i, const NeighborhoodType &inner_neighborhood);
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 		};
     }
@@ -136,6 +136,60 @@ namespace SPH
 			viscous_force_from_fluid_[index_i] = force;
 		}
 		//=================================================================================================//
+		SharedViscousForceOnSolid::
+			SharedViscousForceOnSolid(BaseBodyRelationContact &contact_relation)
+			: InteractionDynamicsScattering(*contact_relation.sph_body_),
+			  FSIContactData(contact_relation),
+			  Vol_(particles_->Vol_), vel_ave_(particles_->vel_ave_)
+		{
+			particles_->registerAVariable(viscous_force_from_fluid_, "ViscousForceFromFluid");
+			for (size_t k = 0; k != contact_particles_.size(); ++k)
+			{
+				checkSharedContactPassResolution(body_, contact_bodies_[k]);
+				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
+				contact_rho_n_.push_back(&(contact_particles_[k]->rho_n_));
+				contact_vel_n_.push_back(&(contact_particles_[k]->vel_n_));
+				contact_dvel_dt_prior_.push_back(&(contact_particles_[k]->dvel_dt_prior_));
+
+				mu_.push_back(contact_material_[k]->ReferenceViscosity());
+				smoothing_length_.push_back(contact_bodies_[k]->sph_adaptation_->ReferenceSmoothingLength());
+			}
+		}
+		//=================================================================================================//
+		void SharedViscousForceOnSolid::Interaction(size_t index_i, Real dt)
+		{
+			Real Vol_i = Vol_[index_i];
+			const Vecd &vel_ave_i = vel_ave_[index_i];
+
+			Vecd force(0);
+			/** Contact interaction. */
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				Real mu_k = mu_[k];
+				Real smoothing_length_k = smoothing_length_[k];
+				StdLargeVec<Real> &Vol_k = *(contact_Vol_[k]);
+				StdLargeVec<Real> &rho_n_k = *(contact_rho_n_[k]);
+				StdLargeVec<Vecd> &vel_n_k = *(contact_vel_n_[k]);
+				StdLargeVec<Vecd> &dvel_dt_prior_k = *(contact_dvel_dt_prior_[k]);
+				Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+				{
+					size_t index_j = contact_neighborhood.j_[n];
+
+					Vecd vel_derivative = 2.0 * (vel_ave_i - vel_n_k[index_j]) /
+										  (contact_neighborhood.r_ij_[n] + 0.01 * smoothing_length_k);
+
+					Vecd pair_force = 2.0 * mu_k * vel_derivative *
+									  Vol_i * Vol_k[index_j] * contact_neighborhood.dW_ij_[n];
+					force += pair_force;
+					//the reaction of the pair force accelerates the fluid neighbor
+					dvel_dt_prior_k[index_j] -= pair_force / (rho_n_k[index_j] * Vol_k[index_j]);
+				}
+			}
+
+			viscous_force_from_fluid_[index_i] = force;
+		}
+		//=================================================================================================//
 		TotalViscousForceOnSolid ::TotalViscousForceOnSolid(SolidBody &solid_body)
 			: ParticleDynamicsReduce<Vecd, ReduceSum<Vecd>>(solid_body),
 			  SolidDataSimple(solid_body),
@@ -164,6 +218,42 @@ namespace SPH
 			return force_from_fluid_[index_i];
 		}
 		//=================================================================================================//
+		SubcycledFluidForceOnSolid::SubcycledFluidForceOnSolid(SolidBody &solid_body)
+			: ParticleDynamicsSimple(solid_body), SolidDataSimple(solid_body),
+			  force_from_fluid_(particles_->force_from_fluid_),
+			  window_size_(0), window_time_(0), window_initialized_(false)
+		{
+			solid_body.base_particles_->registerAVariable(window_begin_force_, "SubcycleWindowBeginForce");
+			solid_body.base_particles_->registerAVariable(window_end_force_, "SubcycleWindowEndForce");
+		}
+		//=================================================================================================//
+		void SubcycledFluidForceOnSolid::beginSubcycleWindow(Real window_size)
+		{
+			window_size_ = window_size;
+			window_time_ = 0.0;
+			parallel_for(
+				blocked_range<size_t>(0, particles_->total_real_particles_),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						// on the first window, there is no previous computation to blend from
+						window_begin_force_[i] =
+							window_initialized_ ? window_end_force_[i] : force_from_fluid_[i];
+						window_end_force_[i] = force_from_fluid_[i];
+					}
+				},
+				ap);
+			window_initialized_ = true;
+		}
+		//=================================================================================================//
+		void SubcycledFluidForceOnSolid::Update(size_t index_i, Real dt)
+		{
+			Real window_fraction = SMIN(window_time_ / (window_size_ + Eps), Real(1));
+			force_from_fluid_[index_i] = (1.0 - window_fraction) * window_begin_force_[index_i] +
+										 window_fraction * window_end_force_[index_i];
+		}
+		//=================================================================================================//
 		InitializeDisplacement::
 			InitializeDisplacement(SolidBody &solid_body, StdLargeVec<Vecd> &pos_temp)
 			: ParticleDynamicsSimple(solid_body), SolidDataSimple(solid_body),
@@ -287,6 +287,132 @@ namespace SPH
 		using FluidForceOnSolidUpdateRiemannWithLimiterInEuler =
 			BaseFluidForceOnSolidUpdate<FluidPressureForceOnSolidHLLCWithLimiterRiemannInEuler, FluidViscousForceOnSolidInEuler>;
 
+		/** The shared contact passes below scatter writes to the fluid neighbors
+		 * within the colored sweep over the structure, which is race free only
+		 * when the contact cutoff does not exceed the cell spacing of the structure. */
+		inline void checkSharedContactPassResolution(SPHBody *solid_body, SPHBody *fluid_body)
+		{
+			if (fluid_body->sph_adaptation_->ReferenceSmoothingLength() >
+				solid_body->sph_adaptation_->ReferenceSmoothingLength())
+			{
+				std::cout << "\n Error: the shared fluid-structure contact pass requires the fluid "
+						  << "resolution to be not coarser than that of the structure!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+		};
+
+		/**
+		* @class SharedViscousForceOnSolid
+		* @brief The shared contact pass of the viscous coupling. Each fluid-solid
+		* pair term is computed only once, giving the viscous force on the structure
+		* and, as its scattered reaction, the wall viscous acceleration of the fluid
+		* neighbors. It replaces the pair of FluidViscousForceOnSolid and the wall
+		* contribution of the fluid viscous acceleration, which is then taken in its
+		* inner form. The reaction joins dvel_dt_prior_ as for the wall scheme.
+		*/
+		class SharedViscousForceOnSolid : public InteractionDynamicsScattering, public FSIContactData
+		{
+		public:
+			explicit SharedViscousForceOnSolid(BaseBodyRelationContact &contact_relation);
+			virtual ~SharedViscousForceOnSolid(){};
+
+		protected:
+			StdLargeVec<Real> &Vol_;
+			StdLargeVec<Vecd> &vel_ave_;
+			StdVec<StdLargeVec<Real> *> contact_Vol_, contact_rho_n_;
+			StdVec<StdLargeVec<Vecd> *> contact_vel_n_, contact_dvel_dt_prior_;
+			StdVec<Real> mu_;
+			StdVec<Real> smoothing_length_;
+			StdLargeVec<Vecd> viscous_force_from_fluid_;
+
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
+		/**
+		* @class BaseSharedPressureForceOnSolid
+		* @brief The shared contact pass of the pressure coupling. Each fluid-solid
+		* pair term is computed only once, giving the pressure force on the structure
+		* and, as its scattered reaction, the wall pressure acceleration of the fluid
+		* neighbors. It replaces the pair of BaseFluidPressureForceOnSolid and the
+		* wall contribution of the pressure relaxation, which is then taken in its
+		* inner form. The reaction joins dvel_dt_prior_, from where the inner pressure
+		* relaxation picks it up, so this pass runs right before the latter.
+		*/
+		template <class RiemannSolverType>
+		class BaseSharedPressureForceOnSolid : public InteractionDynamicsScattering, public FSIContactData
+		{
+		public:
+			explicit BaseSharedPressureForceOnSolid(BaseBodyRelationContact &contact_relation)
+				: InteractionDynamicsScattering(*contact_relation.sph_body_),
+				  FSIContactData(contact_relation),
+				  Vol_(particles_->Vol_), vel_ave_(particles_->vel_ave_),
+				  force_from_fluid_(particles_->force_from_fluid_),
+				  dvel_dt_ave_(particles_->dvel_dt_ave_), n_(particles_->n_)
+			{
+				for (size_t k = 0; k != contact_particles_.size(); ++k)
+				{
+					checkSharedContactPassResolution(body_, contact_bodies_[k]);
+					contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
+					contact_rho_n_.push_back(&(contact_particles_[k]->rho_n_));
+					contact_vel_n_.push_back(&(contact_particles_[k]->vel_n_));
+					contact_p_.push_back(&(contact_particles_[k]->p_));
+					contact_dvel_dt_prior_.push_back(&(contact_particles_[k]->dvel_dt_prior_));
+					riemann_solvers_.push_back(RiemannSolverType(*contact_material_[k], *contact_material_[k]));
+				}
+			};
+			virtual ~BaseSharedPressureForceOnSolid(){};
+
+		protected:
+			StdLargeVec<Real> &Vol_;
+			StdLargeVec<Vecd> &vel_ave_, &force_from_fluid_, &dvel_dt_ave_, &n_;
+			StdVec<StdLargeVec<Real> *> contact_Vol_, contact_rho_n_, contact_p_;
+			StdVec<StdLargeVec<Vecd> *> contact_vel_n_, contact_dvel_dt_prior_;
+			StdVec<RiemannSolverType> riemann_solvers_;
+
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override
+			{
+				const Vecd &dvel_dt_ave_i = dvel_dt_ave_[index_i];
+				Real Vol_i = Vol_[index_i];
+				const Vecd &vel_ave_i = vel_ave_[index_i];
+				const Vecd &n_i = n_[index_i];
+
+				Vecd force(0);
+				for (size_t k = 0; k < contact_configuration_.size(); ++k)
+				{
+					StdLargeVec<Real> &Vol_k = *(contact_Vol_[k]);
+					StdLargeVec<Real> &rho_n_k = *(contact_rho_n_[k]);
+					StdLargeVec<Real> &p_k = *(contact_p_[k]);
+					StdLargeVec<Vecd> &vel_n_k = *(contact_vel_n_[k]);
+					StdLargeVec<Vecd> &dvel_dt_prior_k = *(contact_dvel_dt_prior_[k]);
+					Fluid *fluid_k = contact_material_[k];
+					RiemannSolverType &riemann_solver_k = riemann_solvers_[k];
+					Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+					{
+						size_t index_j = contact_neighborhood.j_[n];
+						Vecd e_ij = contact_neighborhood.e_ij_[n];
+						Real r_ij = contact_neighborhood.r_ij_[n];
+						Real face_wall_external_acceleration = dot((dvel_dt_prior_k[index_j] - dvel_dt_ave_i), e_ij);
+						Real p_in_wall = p_k[index_j] + rho_n_k[index_j] * r_ij * SMAX(0.0, face_wall_external_acceleration);
+						Real rho_in_wall = fluid_k->DensityFromPressure(p_in_wall);
+						Vecd vel_in_wall = 2.0 * vel_ave_i - vel_n_k[index_j];
+
+						FluidState state_l(rho_n_k[index_j], vel_n_k[index_j], p_k[index_j]);
+						FluidState state_r(rho_in_wall, vel_in_wall, p_in_wall);
+						Real p_star = riemann_solver_k.getPStar(state_l, state_r, n_i);
+						Vecd pair_force = -2.0 * p_star * e_ij * Vol_i * Vol_k[index_j] * contact_neighborhood.dW_ij_[n];
+						force += pair_force;
+						//the reaction of the pair force accelerates the fluid neighbor
+						dvel_dt_prior_k[index_j] -= pair_force / (rho_n_k[index_j] * Vol_k[index_j]);
+					}
+				}
+				force_from_fluid_[index_i] = force;
+			};
+		};
+		using SharedPressureForceOnSolid = BaseSharedPressureForceOnSolid<NoRiemannSolver>;
+		using SharedPressureForceOnSolidRiemann = BaseSharedPressureForceOnSolid<AcousticRiemannSolver>;
+
 
 		/**
 		* @class TotalViscousForceOnSolid
@@ -318,6 +444,38 @@ namespace SPH
 			Vecd ReduceFunction(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		* @class SubcycledFluidForceOnSolid
+		* @brief Drives the solid substeps of a subcycled FSI coupling with
+		* forces time-interpolated over the fluid step. The fluid-side force
+		* dynamics compute once per fluid step only; each solid substep then
+		* blends the combined (pressure plus viscous) forces of the previous
+		* and the fresh computation instead of holding them piecewise constant.
+		* The averaged velocity in vel_ave_ keeps being updated once per fluid
+		* step as before, so the fluid side sees the same coupling data.
+		*/
+		class SubcycledFluidForceOnSolid : public ParticleDynamicsSimple, public SolidDataSimple
+		{
+		public:
+			explicit SubcycledFluidForceOnSolid(SolidBody &solid_body);
+			virtual ~SubcycledFluidForceOnSolid(){};
+
+			/** open the interpolation window of a new fluid step, called once
+			 * right after the fluid-side force computation */
+			void beginSubcycleWindow(Real window_size);
+			/** advance the window time by a solid substep; exec or
+			 * parallel_exec then writes the interpolated forces */
+			void advanceSubcycleStep(Real dt) { window_time_ += dt; };
+
+		protected:
+			StdLargeVec<Vecd> &force_from_fluid_;
+			StdLargeVec<Vecd> window_begin_force_, window_end_force_;
+			Real window_size_, window_time_;
+			bool window_initialized_;
+
+			virtual void Update(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		* @class InitializeDisplacement
 		* @brief initialize the displacement for computing average velocity.
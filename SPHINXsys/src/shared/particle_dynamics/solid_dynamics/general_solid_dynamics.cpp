@@ -19,7 +19,30 @@ namespace SPH
 			CorrectConfiguration(BaseBodyRelationInner &inner_relation)
 			: InteractionDynamics(*inner_relation.sph_body_),
 			  SolidDataInner(inner_relation),
-			  Vol_(particles_->Vol_), B_(particles_->B_) {}
+			  Vol_(particles_->Vol_), B_(particles_->B_),
+			  use_cached_correction_(false), computed_configuration_version_(MaxSize_t) {}
+		//=================================================================================================//
+		bool CorrectConfiguration::cacheIsValid()
+		{
+			return use_cached_correction_ &&
+				   computed_configuration_version_ == inner_relation_->ConfigurationVersion();
+		}
+		//=================================================================================================//
+		void CorrectConfiguration::exec(Real dt)
+		{
+			if (cacheIsValid())
+				return;
+			InteractionDynamics::exec(dt);
+			computed_configuration_version_ = inner_relation_->ConfigurationVersion();
+		}
+		//=================================================================================================//
+		void CorrectConfiguration::parallel_exec(Real dt)
+		{
+			if (cacheIsValid())
+				return;
+			InteractionDynamics::parallel_exec(dt);
+			computed_configuration_version_ = inner_relation_->ConfigurationVersion();
+		}
 		//=================================================================================================//
 		void CorrectConfiguration::Interaction(size_t index_i, Real dt)
 		{
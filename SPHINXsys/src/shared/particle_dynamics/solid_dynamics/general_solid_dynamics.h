@@ -72,10 +72,18 @@ namespace SPH
 		public:
 			explicit CorrectConfiguration(BaseBodyRelationInner &inner_relation);
 			virtual ~CorrectConfiguration(){};
+			/** cache the correction matrices and recompute them only after
+			 * the inner configuration has been rebuilt or the particles sorted. */
+			void useCachedCorrection() { use_cached_correction_ = true; };
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
 
 		protected:
 			StdLargeVec<Real> &Vol_;
 			StdLargeVec<Matd> &B_;
+			bool use_cached_correction_;
+			size_t computed_configuration_version_;
+			bool cacheIsValid();
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
 
@@ -29,5 +29,25 @@ namespace SPH
 			stress_PK1_[index_i] = plastic_solid_->PlasticConstitutiveRelation(F_[index_i], index_i, dt);
 		}
 		//=================================================================================================//
+		template <class MaterialType>
+		PlasticStressRelaxationFirstHalfKnownMaterial<MaterialType>::
+			PlasticStressRelaxationFirstHalfKnownMaterial(BaseBodyRelationInner &inner_relation)
+			: PlasticStressRelaxationFirstHalf(inner_relation),
+			  known_plastic_solid_(DynamicCast<MaterialType>(this, material_)) {}
+		//=================================================================================================//
+		template <class MaterialType>
+		void PlasticStressRelaxationFirstHalfKnownMaterial<MaterialType>::Initialization(size_t index_i, Real dt)
+		{
+			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
+			F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+			rho_n_[index_i] = rho0_ / SimTK::det(F_[index_i]);
+			// the qualified call on the concrete material type is resolved statically
+			stress_PK1_[index_i] =
+				known_plastic_solid_->MaterialType::PlasticConstitutiveRelation(F_[index_i], index_i, dt);
+		}
+		//=================================================================================================//
+		template class PlasticStressRelaxationFirstHalfKnownMaterial<HardeningPlasticSolid>;
+		template class PlasticStressRelaxationFirstHalfKnownMaterial<BranchlessHardeningPlasticSolid>;
+		//=================================================================================================//
 	}
 }
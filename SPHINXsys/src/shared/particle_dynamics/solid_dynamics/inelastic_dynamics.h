@@ -52,5 +52,27 @@ namespace SPH
 
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 		};
+
+		/**
+		 * @class PlasticStressRelaxationFirstHalfKnownMaterial
+		 * @brief the plastic stress relaxation with the material law known at
+		 * compile time, so that the return mapping inlines into the particle
+		 * loop instead of being virtually dispatched per particle.
+		 * PlasticStressRelaxationFirstHalf remains the fallback for plastic
+		 * materials without an instantiation here.
+		 */
+		template <class MaterialType>
+		class PlasticStressRelaxationFirstHalfKnownMaterial
+			: public PlasticStressRelaxationFirstHalf
+		{
+		public:
+			explicit PlasticStressRelaxationFirstHalfKnownMaterial(BaseBodyRelationInner &inner_relation);
+			virtual ~PlasticStressRelaxationFirstHalfKnownMaterial(){};
+
+		protected:
+			MaterialType *known_plastic_solid_;
+
+			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
+		};
 	}
 }
@@ -121,10 +121,42 @@ namespace SPH
 			  dpseudo_n_dt_(particles_->dpseudo_n_dt_), dpseudo_n_d2t_(particles_->dpseudo_n_d2t_),
 			  rotation_(particles_->rotation_), angular_vel_(particles_->angular_vel_),
 			  dangular_vel_dt_(particles_->dangular_vel_dt_),
+			  rotation_sine_(particles_->rotation_sine_),
+			  rotation_cosine_(particles_->rotation_cosine_),
 			  B_(particles_->B_), F_(particles_->F_), dF_dt_(particles_->dF_dt_),
 			  F_bending_(particles_->F_bending_), dF_bending_dt_(particles_->dF_bending_dt_),
 			  transformation_matrix_(particles_->transformation_matrix_) {}
 		//=================================================================================================//
+		void BaseShellRelaxation::updateRotationCache(Real increment_factor, Real dt)
+		{
+			size_t total_real_particles = particles_->total_real_particles_;
+			for (size_t i = 0; i != total_real_particles; ++i)
+				for (int k = 0; k != Dimensions; ++k)
+				{
+					Real rotation_angle = rotation_[i][k] + increment_factor * angular_vel_[i][k] * dt;
+					rotation_sine_[i][k] = sin(rotation_angle);
+					rotation_cosine_[i][k] = cos(rotation_angle);
+				}
+		}
+		//=================================================================================================//
+		void BaseShellRelaxation::updateRotationCache_parallel(Real increment_factor, Real dt)
+		{
+			size_t total_real_particles = particles_->total_real_particles_;
+			parallel_for(
+				blocked_range<size_t>(0, total_real_particles),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						for (int k = 0; k != Dimensions; ++k)
+						{
+							Real rotation_angle = rotation_[i][k] + increment_factor * angular_vel_[i][k] * dt;
+							rotation_sine_[i][k] = sin(rotation_angle);
+							rotation_cosine_[i][k] = cos(rotation_angle);
+						}
+				},
+				ap);
+		}
+		//=================================================================================================//
 		ShellStressRelaxationFirstHalf::
 			ShellStressRelaxationFirstHalf(BaseBodyRelationInner &inner_relation,
 				int number_of_gaussian_points, bool hourglass_control)
@@ -165,6 +197,45 @@ namespace SPH
 			}
 		}
 		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			gatedIterator(total_real_particles, functor_initialization_, dt);
+			for (size_t k = 0; k < pre_processes_.size(); ++k)
+				pre_processes_[k]->exec(dt);
+			/** the rotation angles are final here, so the trigonometric functions
+			 * consumed pairwise in the interaction sweep are evaluated in batch */
+			updateRotationCache(0.0, dt);
+			gatedIterator(total_real_particles, functor_interaction_, dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->exec(dt);
+			gatedIterator(total_real_particles, functor_update_, dt);
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationFirstHalf::parallel_exec(Real dt)
+		{
+			tick_count start_time = tick_count::now();
+			setBodyUpdated();
+			setupDynamics(dt);
+			size_t total_real_particles = base_particles_->total_real_particles_;
+			gatedIterator_parallel(total_real_particles, functor_initialization_,
+								   keyedLoopTuner(initialization_loop_tuner_, "initialization", total_real_particles), dt);
+			for (size_t k = 0; k < pre_processes_.size(); ++k)
+				pre_processes_[k]->parallel_exec(dt);
+			updateRotationCache_parallel(0.0, dt);
+			gatedIterator_parallel(total_real_particles, functor_interaction_,
+								   keyedLoopTuner(loop_tuner_, "interaction", total_real_particles), dt);
+			for (size_t k = 0; k < post_processes_.size(); ++k)
+				post_processes_[k]->parallel_exec(dt);
+			gatedIterator_parallel(total_real_particles, functor_update_,
+								   keyedLoopTuner(update_loop_tuner_, "update", total_real_particles), dt);
+			recordExecutionTiming(start_time);
+		}
+		//=================================================================================================//
 		void ShellStressRelaxationFirstHalf::Initialization(size_t index_i, Real dt)
 		{
 			// Note that F_[index_i], F_bending_[index_i], dF_dt_[index_i], dF_bending_dt_[index_i]
@@ -182,6 +253,9 @@ namespace SPH
 			n_[index_i] = (~transformation_matrix_[index_i]) * getNormalFromDeformationGradientTensor(F_[index_i]);
 			/** Get transformation matrix from global coordinates to current local coordinates. */
 			Matd current_transformation_matrix = getTransformationMatrix(n_[index_i]);
+			/** The frame change from the initial to the current local coordinates
+			 * is invariant over the Gaussian points. */
+			Matd frame_change = current_transformation_matrix * (~transformation_matrix_[index_i]);
 
 			/** Initialize the local stress to 0. */
 			Matd resultant_stress(0);
@@ -192,25 +266,25 @@ namespace SPH
 				Matd F_gaussian_point = F_[index_i] + gaussian_point_[i] * F_bending_[index_i] * thickness_[index_i] * 0.5;
 				Matd dF_gaussian_point_dt = dF_dt_[index_i] + gaussian_point_[i] * dF_bending_dt_[index_i] * thickness_[index_i] * 0.5;
 				Matd inverse_F_gaussian_point = SimTK::inverse(F_gaussian_point);
-				Matd current_local_almansi_strain = current_transformation_matrix * (~transformation_matrix_[index_i])
+				Real det_F_gaussian_point = det(F_gaussian_point);
+				Matd current_local_almansi_strain = frame_change
 											* 0.5 * (Matd(1.0) - ~inverse_F_gaussian_point * inverse_F_gaussian_point)
-											* transformation_matrix_[index_i] * (~current_transformation_matrix);
+											* (~frame_change);
 				/** correct Almansi strain tensor according to plane stress problem. */
 				current_local_almansi_strain = getCorrectedAlmansiStrain(current_local_almansi_strain, nu_);
 				Matd cauchy_stress = material_->EulerianConstitutiveRelation(current_local_almansi_strain, F_gaussian_point, index_i)
-					+ current_transformation_matrix * (~transformation_matrix_[index_i]) * F_gaussian_point
+					+ frame_change * F_gaussian_point
 					* material_->NumericalDampingRightCauchy(F_gaussian_point, dF_gaussian_point_dt, smoothing_length_, index_i)
-					* (~F_gaussian_point) * transformation_matrix_[index_i] * (~current_transformation_matrix) / det(F_gaussian_point);
+					* (~F_gaussian_point) * (~frame_change) / det_F_gaussian_point;
 
 				/** Impose modeling assumptions. */
 				cauchy_stress.col(Dimensions - 1) *= shear_correction_factor_;
 				cauchy_stress.row(Dimensions - 1) *= shear_correction_factor_;
 				cauchy_stress[Dimensions - 1][Dimensions - 1] = 0.0;
 
-				Matd stress_PK2_gaussian_point = det(F_gaussian_point) * SimTK::inverse(F_gaussian_point)
-					* transformation_matrix_[index_i] * (~current_transformation_matrix) * cauchy_stress
-					* current_transformation_matrix * (~transformation_matrix_[index_i])
-					* (~SimTK::inverse(F_gaussian_point));
+				Matd stress_PK2_gaussian_point = det_F_gaussian_point * inverse_F_gaussian_point
+					* (~frame_change) * cauchy_stress * frame_change
+					* (~inverse_F_gaussian_point);
 
 				/** Get the mid-surface stress to output the von-Mises equivalent stress. */
 				if (i == 0) stress_PK1_[index_i] = F_gaussian_point * stress_PK2_gaussian_point;
@@ -280,10 +354,12 @@ namespace SPH
 			dpseudo_n_d2t_[index_i] = pseudo_normal_acceleration * inv_rho0_
 				* 12.0 / powerN(thickness_[index_i], 3);
 
-			/** the relation between pseudo-normal and rotations */
+			/** the relation between pseudo-normal and rotations,
+			 * with the cached trigonometric functions of the rotation angles */
 			Vecd local_dpseudo_n_d2t = transformation_matrix_[index_i] * dpseudo_n_d2t_[index_i];
 			dangular_vel_dt_[index_i] = getRotationFromPseudoNormalForFiniteDeformation
-										(local_dpseudo_n_d2t, rotation_[index_i], angular_vel_[index_i], dt);
+										(local_dpseudo_n_d2t, rotation_sine_[index_i], rotation_cosine_[index_i],
+										 angular_vel_[index_i], dt);
 		}
 		//=================================================================================================//
 		void ShellStressRelaxationFirstHalf::Update(size_t index_i, Real dt)
@@ -292,12 +368,27 @@ namespace SPH
 			angular_vel_[index_i] += dangular_vel_dt_[index_i] * dt;
 		}
 		//=================================================================================================//
+		void ShellStressRelaxationSecondHalf::exec(Real dt)
+		{
+			/** the trigonometric functions of the half-step advanced rotation angles
+			 * consumed in the initialization sweep are evaluated in batch */
+			updateRotationCache(0.5, dt);
+			ParticleDynamics1Level::exec(dt);
+		}
+		//=================================================================================================//
+		void ShellStressRelaxationSecondHalf::parallel_exec(Real dt)
+		{
+			updateRotationCache_parallel(0.5, dt);
+			ParticleDynamics1Level::parallel_exec(dt);
+		}
+		//=================================================================================================//
 		void ShellStressRelaxationSecondHalf::Initialization(size_t index_i, Real dt)
 		{
 			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
 			rotation_[index_i] += angular_vel_[index_i] * dt * 0.5;
 			dpseudo_n_dt_[index_i] = (~transformation_matrix_[index_i]) *
-									 getVectorChangeRateAfterThinStructureRotation(local_pseudo_n_0, rotation_[index_i], angular_vel_[index_i]);
+									 getVectorChangeRateAfterThinStructureRotation(local_pseudo_n_0,
+										 rotation_sine_[index_i], rotation_cosine_[index_i], angular_vel_[index_i]);
 			pseudo_n_[index_i] += dpseudo_n_dt_[index_i] * dt * 0.5;
 		}
 		//=================================================================================================//
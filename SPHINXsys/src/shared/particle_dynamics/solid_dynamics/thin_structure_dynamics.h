@@ -130,8 +130,15 @@ namespace SPH
 			StdLargeVec<Vecd> &pos_n_, &vel_n_, &dvel_dt_, &dvel_dt_prior_, &force_from_fluid_;
 			StdLargeVec<Vecd> &n_0_, &pseudo_n_, &dpseudo_n_dt_, &dpseudo_n_d2t_, &rotation_,
 				&angular_vel_, dangular_vel_dt_;
+			StdLargeVec<Vecd> &rotation_sine_, &rotation_cosine_;
 			StdLargeVec<Matd> &B_, &F_, &dF_dt_, &F_bending_, &dF_bending_dt_;
 			StdLargeVec<Matd> &transformation_matrix_;
+
+			/** refresh the cached trigonometric functions of the rotation angles,
+			 * advanced by increment_factor * angular velocity * dt, in a flat loop
+			 * over components so that the compiler can vectorize the evaluation */
+			void updateRotationCache(Real increment_factor, Real dt);
+			void updateRotationCache_parallel(Real increment_factor, Real dt);
 		};
 
 		/**
@@ -146,6 +153,11 @@ namespace SPH
 				int number_of_gaussian_points = 3, bool hourglass_control = false);
 			virtual ~ShellStressRelaxationFirstHalf() {};
 
+			/** the rotation cache is refreshed in batch between
+			 * the initialization and the interaction sweeps */
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
 		protected:
 			Real rho0_, inv_rho0_;
 			StdLargeVec<Matd> &stress_PK1_, &global_stress_, &global_moment_;
@@ -183,6 +195,11 @@ namespace SPH
 				: BaseShellRelaxation(inner_relation){};
 			virtual ~ShellStressRelaxationSecondHalf(){};
 
+			/** the rotation cache is refreshed in batch, with the half-step
+			 * angular increment applied, before the initialization sweep */
+			virtual void exec(Real dt = 0.0) override;
+			virtual void parallel_exec(Real dt = 0.0) override;
+
 		protected:
 			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
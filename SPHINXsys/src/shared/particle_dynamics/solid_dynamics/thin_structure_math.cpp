@@ -5,6 +5,7 @@
  */
 
 #include "thin_structure_math.h"
+#include "small_matrix_functions.h"
 
 using namespace SimTK;
 
@@ -22,7 +23,7 @@ namespace SPH
 			rotation_matrix[1][0] = -rotation_matrix[0][1];
 			rotation_matrix[1][1] = rotation_matrix[0][0];
 
-			return rotation_matrix * initial_vector;
+			return fastMatrixVectorProduct(rotation_matrix, initial_vector);
 		}
 		//=================================================================================================//
 		Vec3d getVectorAfterThinStructureRotation(const Vec3d &initial_vector, const Vec3d &rotation_angles)
@@ -42,7 +43,7 @@ namespace SPH
 			rotation_matrix_y[2][0] = -rotation_matrix_y[0][2];
 			rotation_matrix_y[2][2] = rotation_matrix_y[0][0];
 
-			return rotation_matrix_y * rotation_matrix_x * initial_vector;
+			return fastMatrixVectorProduct(rotation_matrix_y, fastMatrixVectorProduct(rotation_matrix_x, initial_vector));
 		}
 		//=================================================================================================//
 		Vec2d getVectorChangeRateAfterThinStructureRotation(const Vec2d &initial_vector, const Vec2d &rotation_angles, const Vec2d &angular_vel)
@@ -54,7 +55,7 @@ namespace SPH
 			drotation_matrix_dt[1][0] = -drotation_matrix_dt[0][1];
 			drotation_matrix_dt[1][1] = drotation_matrix_dt[0][0];
 
-			return drotation_matrix_dt * initial_vector;
+			return fastMatrixVectorProduct(drotation_matrix_dt, initial_vector);
 		}
 		//=================================================================================================//
 		Vec3d getVectorChangeRateAfterThinStructureRotation(const Vec3d &initial_vector, const Vec3d &rotation_angles, const Vec3d &angular_vel)
@@ -87,7 +88,58 @@ namespace SPH
 			drotation_matrix_y_dt[2][0] = -drotation_matrix_y_dt[0][2];
 			drotation_matrix_y_dt[2][2] = drotation_matrix_y_dt[0][0];
 
-			return (drotation_matrix_y_dt * rotation_matrix_x + rotation_matrix_y * drotation_matrix_x_dt)* initial_vector;
+			return fastMatrixVectorProduct(fastMatrixProduct(drotation_matrix_y_dt, rotation_matrix_x) +
+											   fastMatrixProduct(rotation_matrix_y, drotation_matrix_x_dt),
+										   initial_vector);
+		}
+		//=================================================================================================//
+		Vec2d getVectorChangeRateAfterThinStructureRotation(const Vec2d &initial_vector,
+			const Vec2d &sin_rotation, const Vec2d &cos_rotation, const Vec2d &angular_vel)
+		{
+			/**The derivative of the rotation matrix. */
+			Mat2d drotation_matrix_dt(0.0);
+			drotation_matrix_dt[0][0] = -sin_rotation[0] * angular_vel[0];
+			drotation_matrix_dt[0][1] = cos_rotation[0] * angular_vel[0];
+			drotation_matrix_dt[1][0] = -drotation_matrix_dt[0][1];
+			drotation_matrix_dt[1][1] = drotation_matrix_dt[0][0];
+
+			return fastMatrixVectorProduct(drotation_matrix_dt, initial_vector);
+		}
+		//=================================================================================================//
+		Vec3d getVectorChangeRateAfterThinStructureRotation(const Vec3d &initial_vector,
+			const Vec3d &sin_rotation, const Vec3d &cos_rotation, const Vec3d &angular_vel)
+		{
+			/**The rotation matrix about the X-axis. */
+			Mat3d rotation_matrix_x(0.0);
+			rotation_matrix_x[0][0] = 1.0;
+			rotation_matrix_x[1][1] = cos_rotation[0];
+			rotation_matrix_x[1][2] = -sin_rotation[0];
+			rotation_matrix_x[2][1] = -rotation_matrix_x[1][2];
+			rotation_matrix_x[2][2] = rotation_matrix_x[1][1];
+			/**The rotation matrix about the Y-axis. */
+			Mat3d rotation_matrix_y(0.0);
+			rotation_matrix_y[0][0] = cos_rotation[1];
+			rotation_matrix_y[0][2] = sin_rotation[1];
+			rotation_matrix_y[1][1] = 1.0;
+			rotation_matrix_y[2][0] = -rotation_matrix_y[0][2];
+			rotation_matrix_y[2][2] = rotation_matrix_y[0][0];
+
+			/**The derivative of the rotation matrix of the X-axis. */
+			Mat3d drotation_matrix_x_dt(0.0);
+			drotation_matrix_x_dt[1][1] = -sin_rotation[0] * angular_vel[0];
+			drotation_matrix_x_dt[1][2] = -cos_rotation[0] * angular_vel[0];
+			drotation_matrix_x_dt[2][1] = -drotation_matrix_x_dt[1][2];
+			drotation_matrix_x_dt[2][2] = drotation_matrix_x_dt[1][1];
+			/**The derivative of the rotation matrix of the Y-axis. */
+			Mat3d drotation_matrix_y_dt(0.0);
+			drotation_matrix_y_dt[0][0] = -sin_rotation[1] * angular_vel[1];
+			drotation_matrix_y_dt[0][2] = cos_rotation[1] * angular_vel[1];
+			drotation_matrix_y_dt[2][0] = -drotation_matrix_y_dt[0][2];
+			drotation_matrix_y_dt[2][2] = drotation_matrix_y_dt[0][0];
+
+			return fastMatrixVectorProduct(fastMatrixProduct(drotation_matrix_y_dt, rotation_matrix_x) +
+											   fastMatrixProduct(rotation_matrix_y, drotation_matrix_x_dt),
+										   initial_vector);
 		}
 		//=================================================================================================//
 		Vec2d getRotationFromPseudoNormalForFiniteDeformation(const Vec2d &dpseudo_n_d2t, const Vec2d &rotation, const Vec2d &angular_vel, Real dt)
@@ -115,6 +167,33 @@ namespace SPH
 			return dangular_vel_dt;
 		}
 		//=================================================================================================//
+		Vec2d getRotationFromPseudoNormalForFiniteDeformation(const Vec2d &dpseudo_n_d2t,
+			const Vec2d &sin_rotation, const Vec2d &cos_rotation, const Vec2d &angular_vel, Real dt)
+		{
+			Vec2d dangular_vel_dt(0.0);
+			dangular_vel_dt[0] = -(dpseudo_n_d2t[0] + sin_rotation[0] * powerN(angular_vel[0], 2))
+								 / (2 * sin_rotation[0] * angular_vel[0] * dt - cos_rotation[0]);
+			return dangular_vel_dt;
+		}
+		//=================================================================================================//
+		Vec3d getRotationFromPseudoNormalForFiniteDeformation(const Vec3d &dpseudo_n_d2t,
+			const Vec3d &sin_rotation, const Vec3d &cos_rotation, const Vec3d &angular_vel, Real dt)
+		{
+			Vec3d dangular_vel_dt(0.0);
+			dangular_vel_dt[0] = (dpseudo_n_d2t[1] - sin_rotation[0] * powerN(angular_vel[0], 2))
+								 / (2 * sin_rotation[0] * angular_vel[0] * dt - cos_rotation[0]);
+			dangular_vel_dt[1] = (dpseudo_n_d2t[0] + cos_rotation[0] * sin_rotation[1]
+								  * (powerN(angular_vel[0], 2) + powerN(angular_vel[1], 2))
+								  + 2 * sin_rotation[0] * cos_rotation[1] * angular_vel[0] * angular_vel[1]
+								  + (2 * cos_rotation[0] * sin_rotation[1] * angular_vel[0] * dt
+								  + 2 * sin_rotation[0] * cos_rotation[1] * angular_vel[1] * dt
+								  + sin_rotation[0] * cos_rotation[1]) * dangular_vel_dt[0])
+								 / (-2 * sin_rotation[0] * cos_rotation[1] * angular_vel[0] * dt
+									- 2 * cos_rotation[0] * sin_rotation[1] * angular_vel[1] * dt
+									+ cos_rotation[0] * cos_rotation[1]);
+			return dangular_vel_dt;
+		}
+		//=================================================================================================//
 		Vec2d getRotationFromPseudoNormalForSmallDeformation(const Vec2d &dpseudo_n_d2t, const Vec2d &rotation, const Vec2d &angular_vel, Real dt)
 		{
 			Vec2d dangular_vel_dt(0.0);
@@ -53,10 +53,23 @@ namespace SPH
 		Vec2d getVectorChangeRateAfterThinStructureRotation(const Vec2d &initial_vector, const Vec2d &rotation_angles, const Vec2d &angular_vel);
 		Vec3d getVectorChangeRateAfterThinStructureRotation(const Vec3d &initial_vector, const Vec3d &rotation_angles, const Vec3d &angular_vel);
 
+		/** Vector change rate after rotation with the trigonometric functions of the
+		 * rotation angles taken from a cache refreshed in batch once per substep. */
+		Vec2d getVectorChangeRateAfterThinStructureRotation(const Vec2d &initial_vector,
+			const Vec2d &sin_rotation, const Vec2d &cos_rotation, const Vec2d &angular_vel);
+		Vec3d getVectorChangeRateAfterThinStructureRotation(const Vec3d &initial_vector,
+			const Vec3d &sin_rotation, const Vec3d &cos_rotation, const Vec3d &angular_vel);
+
 		/** get the rotation from pseudo-normal for finite deformation. */
 		Vec2d getRotationFromPseudoNormalForFiniteDeformation(const Vec2d &dpseudo_n_d2t, const Vec2d &rotation, const Vec2d &angular_vel, Real dt);
 		Vec3d getRotationFromPseudoNormalForFiniteDeformation(const Vec3d &dpseudo_n_d2t, const Vec3d &rotation, const Vec3d &angular_vel, Real dt);
 
+		/** the same rotation update with cached trigonometric functions of the rotation angles. */
+		Vec2d getRotationFromPseudoNormalForFiniteDeformation(const Vec2d &dpseudo_n_d2t,
+			const Vec2d &sin_rotation, const Vec2d &cos_rotation, const Vec2d &angular_vel, Real dt);
+		Vec3d getRotationFromPseudoNormalForFiniteDeformation(const Vec3d &dpseudo_n_d2t,
+			const Vec3d &sin_rotation, const Vec3d &cos_rotation, const Vec3d &angular_vel, Real dt);
+
 		/** get the rotation from pseudo-normal for small deformation. */
 		Vec2d getRotationFromPseudoNormalForSmallDeformation(const Vec2d &dpseudo_n_d2t, const Vec2d &rotation, const Vec2d &angular_vel, Real dt);
 		Vec3d getRotationFromPseudoNormalForSmallDeformation(const Vec3d &dpseudo_n_d2t, const Vec3d &rotation, const Vec3d &angular_vel, Real dt);
@@ -74,10 +74,18 @@ namespace SPH
 		}
 
 		file_path_ = in_output.reload_folder_ + "/" + reload_body_name + "_rld.xml";
+		binary_file_path_ = in_output.reload_folder_ + "/" + reload_body_name + "_rld.bin";
 	}
 	//=================================================================================================//
 	void ParticleGeneratorReload::initializeGeometricVariables()
 	{
+		// the binary reload file is preferred as XML parsing
+		// dominates the startup time for large particle numbers
+		if (fs::exists(binary_file_path_))
+		{
+			base_particles_->readFromBinaryForReloadParticle(binary_file_path_);
+			return;
+		}
 		base_particles_->readFromXmlForReloadParticle(file_path_);
 	}
 	//=================================================================================================//
@@ -121,6 +121,7 @@ namespace SPH
 	class ParticleGeneratorReload : public ParticleGenerator
 	{
 		std::string file_path_;
+		std::string binary_file_path_;
 
 	public:
 		ParticleGeneratorReload(SPHBody &sph_body, InOutput &in_output, const std::string &reload_body_name);
@@ -9,8 +9,40 @@
 #include "base_body_part.h"
 #include "base_material.h"
 #include "base_particle_generator.h"
+#include "buffer_compression.h"
 #include "xml_engine.h"
 
+#include <cstdio>
+#include <streambuf>
+
+namespace
+{
+	/** read-only stream buffer over an in-memory checkpoint without copying it */
+	class InMemoryStreamBuffer : public std::streambuf
+	{
+	public:
+		explicit InMemoryStreamBuffer(std::string &buffer)
+		{
+			setg(&buffer[0], &buffer[0], &buffer[0] + buffer.size());
+		};
+	};
+
+	/** bulk-load a binary checkpoint file and decompress it transparently
+	 * when it carries the compressed-container magic */
+	std::string loadCheckpointFile(const std::string &filefullpath)
+	{
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+		in_file.seekg(0, std::ios::end);
+		std::string buffer((size_t)in_file.tellg(), '\0');
+		in_file.seekg(0, std::ios::beg);
+		in_file.read(&buffer[0], buffer.size());
+		in_file.close();
+		if (SPH::buffer_compression::isCompressed(buffer))
+			buffer = SPH::buffer_compression::decompress(buffer);
+		return buffer;
+	}
+}
+
 namespace SPH
 {
 	//=================================================================================================//
@@ -69,6 +101,42 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	ParticleVariableList BaseParticles::allRegisteredVariables()
+	{
+		ParticleVariableList variable_list;
+		for (int type_index = 0; type_index != 4; ++type_index)
+		{
+			for (auto &name_and_index : all_variable_maps_[type_index])
+				variable_list[type_index].push_back(name_and_index);
+		}
+		return variable_list;
+	}
+	//=================================================================================================//
+	ParticleVariableList BaseParticles::findVariablesByName(const StdVec<std::string> &variable_names)
+	{
+		ParticleVariableList variable_list;
+		for (const std::string &variable_name : variable_names)
+		{
+			bool is_found = false;
+			for (int type_index = 0; type_index != 4; ++type_index)
+			{
+				if (all_variable_maps_[type_index].find(variable_name) != all_variable_maps_[type_index].end())
+				{
+					size_t variable_index = all_variable_maps_[type_index][variable_name];
+					variable_list[type_index].push_back(make_pair(variable_name, variable_index));
+					is_found = true;
+				}
+			}
+			if (!is_found)
+			{
+				std::cout << "\n Error: the variable '" << variable_name << "' is not registered!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+		}
+		return variable_list;
+	}
+	//=================================================================================================//
 	void BaseParticles::addAParticleEntry()
 	{
 		unsorted_id_.push_back(sequence_.size());
@@ -78,8 +146,18 @@ namespace SPH
 		add_a_particle_value_(all_particle_data_);
 	}
 	//=================================================================================================//
+	void BaseParticles::reserveParticleCapacity(size_t reserved_bound)
+	{
+		unsorted_id_.reserve(reserved_bound);
+		sorted_id_.reserve(reserved_bound);
+		sequence_.reserve(reserved_bound);
+
+		reserve_particle_data_(all_particle_data_, reserved_bound);
+	}
+	//=================================================================================================//
 	void BaseParticles::addBufferParticles(size_t buffer_size)
 	{
+		reserveParticleCapacity(pos_n_.size() + buffer_size);
 		for (size_t i = 0; i != buffer_size; ++i)
 		{
 			addAParticleEntry();
@@ -118,6 +196,29 @@ namespace SPH
 		return expected_particle_index;
 	}
 	//=================================================================================================//
+	size_t BaseParticles::claimGhostParticles(size_t number_of_ghosts)
+	{
+		size_t first_slot = real_particles_bound_ + total_ghost_particles_;
+		total_ghost_particles_ += number_of_ghosts;
+		size_t required_size = real_particles_bound_ + total_ghost_particles_;
+		if (pos_n_.size() < required_size)
+		{
+			reserveParticleCapacity(required_size);
+			while (pos_n_.size() < required_size)
+				addAParticleEntry();
+		}
+		else if (required_size + required_size / 2 + 128 < pos_n_.size())
+		{
+			/* trim the pooled slots only on a substantial shrinkage, so that a
+			   fluctuating ghost population does not churn the particle data */
+			unsorted_id_.resize(required_size);
+			sorted_id_.resize(required_size);
+			sequence_.resize(required_size);
+			resize_particle_data_(all_particle_data_, required_size);
+		}
+		return first_slot;
+	}
+	//=================================================================================================//
 	void BaseParticles::switchToBufferParticle(size_t index_i)
 	{
 		size_t last_real_particle_index = total_real_particles_ - 1;
@@ -131,6 +232,85 @@ namespace SPH
 		total_real_particles_ -= 1;
 	}
 	//=================================================================================================//
+	void BaseParticles::recycleAParticle(size_t index_i)
+	{
+		size_t unsorted_id = unsorted_id_[index_i];
+		// a departed particle stays at the boundary until its slot is resolved
+		// and may be checked again, so guard against recording it twice
+		if (std::find(recycled_particle_ids_.begin(), recycled_particle_ids_.end(), unsorted_id) ==
+			recycled_particle_ids_.end())
+			recycled_particle_ids_.push_back(unsorted_id);
+	}
+	//=================================================================================================//
+	void BaseParticles::dropReusedRecycledSlots(size_t reused_slots)
+	{
+		recycled_particle_ids_.erase(recycled_particle_ids_.begin(),
+									 recycled_particle_ids_.begin() + reused_slots);
+	}
+	//=================================================================================================//
+	void BaseParticles::compactRecycledParticleSlots()
+	{
+		// treating the highest slots first, a slot filled from the tail of the
+		// real particles is never itself a hole, so that each live particle
+		// moves at most once and holes at the tail are resolved without a copy
+		IndexVector hole_indexes;
+		for (size_t n = 0; n != recycled_particle_ids_.size(); ++n)
+			hole_indexes.push_back(sorted_id_[recycled_particle_ids_[n]]);
+		std::sort(hole_indexes.begin(), hole_indexes.end(), std::greater<size_t>());
+		for (size_t n = 0; n != hole_indexes.size(); ++n)
+			switchToBufferParticle(hole_indexes[n]);
+		recycled_particle_ids_.clear();
+	}
+	//=================================================================================================//
+	size_t BaseParticles::ParticleDataMemoryFootprint()
+	{
+		size_t footprint_in_bytes = 0;
+		ParticleDataOperation<sumParticleDataFootprint> sum_footprint;
+		sum_footprint(all_particle_data_, &footprint_in_bytes);
+		footprint_in_bytes += (unsorted_id_.capacity() + sorted_id_.capacity() + sequence_.capacity()) * sizeof(size_t);
+		footprint_in_bytes += scratch_buffers_.MemoryFootprint();
+		return footprint_in_bytes;
+	}
+	//=================================================================================================//
+	void BaseParticles::registerSortableVariables(const ParticleVariableList &variable_names)
+	{
+		for (size_t l = 0; l != variable_names[0].size(); ++l)
+			registerASortableVariable<Real>(variable_names[0][l].first);
+		for (size_t l = 0; l != variable_names[1].size(); ++l)
+			registerASortableVariable<Vecd>(variable_names[1][l].first);
+		for (size_t l = 0; l != variable_names[2].size(); ++l)
+			registerASortableVariable<Matd>(variable_names[2][l].first);
+		for (size_t l = 0; l != variable_names[3].size(); ++l)
+			registerASortableVariable<int>(variable_names[3][l].first);
+	}
+	//=================================================================================================//
+	StdVec<std::string> BaseParticles::unsortedVariablesReport()
+	{
+		StdVec<std::string> report;
+		for (size_t type_index = 0; type_index != all_variable_maps_.size(); ++type_index)
+		{
+			for (const auto &name_and_index : all_variable_maps_[type_index])
+			{
+				if (sortable_variable_maps_[type_index].find(name_and_index.first) ==
+					sortable_variable_maps_[type_index].end())
+					report.push_back(name_and_index.first);
+			}
+		}
+		return report;
+	}
+	//=================================================================================================//
+	StdVec<std::pair<std::string, size_t>> BaseParticles::untouchedVariablesReport()
+	{
+		StdVec<std::pair<std::string, size_t>> report;
+		for (size_t type_index = 0; type_index != lazy_variable_records_.size(); ++type_index)
+		{
+			for (const auto &name_and_record : lazy_variable_records_[type_index])
+				report.push_back(make_pair(
+					name_and_record.first, name_and_record.second.bytes_per_particle_ * real_particles_bound_));
+		}
+		return report;
+	}
+	//=================================================================================================//
 	void BaseParticles::writePltFileHeader(std::ofstream &output_file)
 	{
 		output_file << " VARIABLES = \"x\",\"y\",\"z\",\"ID\"";
@@ -185,22 +365,91 @@ namespace SPH
 		};
 	}
 	//=================================================================================================//
+	void BaseParticles::computeDerivedVariables(const ParticleVariableList &variables_to_write)
+	{
+		// only the derived variables selected by the active recorder are evaluated
+		for (size_t n = 0; n != derived_variables_.size(); ++n)
+		{
+			bool is_selected = false;
+			for (size_t type_index = 0; type_index != variables_to_write.size(); ++type_index)
+			{
+				for (const std::pair<std::string, size_t> &name_index : variables_to_write[type_index])
+				{
+					if (name_index.first == derived_variable_names_[n])
+						is_selected = true;
+				}
+			}
+			if (is_selected)
+				derived_variables_[n]->parallel_exec();
+		}
+	}
+	//=================================================================================================//
 	void BaseParticles::writeParticlesToPltFile(std::ofstream &output_file)
 	{
 		writePltFileHeader(output_file);
 		output_file << "\n";
 
 		//compute derived particle variables
-		for (ParticleDynamics<void> *derived_variable : derived_variables_)
-		{
-			derived_variable->parallel_exec();
-		}
+		computeDerivedVariables(variables_to_write_);
 
+		// the particle lines are formatted in parallel into per-block strings
+		// and then flushed with one bulk write each, instead of one stream
+		// insertion per value
 		size_t total_real_particles = total_real_particles_;
-		for (size_t i = 0; i != total_real_particles; ++i)
+		size_t block_size = 10000;
+		size_t total_blocks = (total_real_particles + block_size - 1) / block_size;
+		StdVec<std::string> formatted_blocks(total_blocks);
+		parallel_for(
+			blocked_range<size_t>(0, total_blocks),
+			[&](const blocked_range<size_t> &r)
+			{
+				char formatted_value[64];
+				for (size_t block = r.begin(); block != r.end(); ++block)
+				{
+					std::string &formatted_block = formatted_blocks[block];
+					size_t block_end = SMIN((block + 1) * block_size, total_real_particles);
+					for (size_t i = block * block_size; i != block_end; ++i)
+					{
+						Vec3d particle_position = upgradeToVector3D(pos_n_[i]);
+						formatted_block.append(
+							formatted_value,
+							std::snprintf(formatted_value, sizeof(formatted_value), "%g %g %g %zu ",
+										  particle_position[0], particle_position[1], particle_position[2], i));
+
+						for (std::pair<std::string, size_t> &name_index : variables_to_write_[3])
+						{
+							StdLargeVec<int> &variable = *(std::get<3>(all_particle_data_)[name_index.second]);
+							formatted_block.append(
+								formatted_value,
+								std::snprintf(formatted_value, sizeof(formatted_value), "%d ", variable[i]));
+						};
+
+						for (std::pair<std::string, size_t> &name_index : variables_to_write_[1])
+						{
+							StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data_)[name_index.second]);
+							Vec3d vector_value = upgradeToVector3D(variable[i]);
+							formatted_block.append(
+								formatted_value,
+								std::snprintf(formatted_value, sizeof(formatted_value), "%g %g %g ",
+											  vector_value[0], vector_value[1], vector_value[2]));
+						};
+
+						for (std::pair<std::string, size_t> &name_index : variables_to_write_[0])
+						{
+							StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data_)[name_index.second]);
+							formatted_block.append(
+								formatted_value,
+								std::snprintf(formatted_value, sizeof(formatted_value), "%g ", variable[i]));
+						};
+						formatted_block += '\n';
+					}
+				}
+			},
+			ap);
+
+		for (size_t block = 0; block != total_blocks; ++block)
 		{
-			writePltFileParticleData(output_file, i);
-			output_file << "\n";
+			output_file.write(formatted_blocks[block].data(), formatted_blocks[block].size());
 		};
 	}
 	//=================================================================================================//
@@ -346,6 +595,102 @@ namespace SPH
 		loop_variable_namelist(all_particle_data_, variables_to_restart_, read_variable_from_xml);
 	}
 	//=================================================================================================//
+	void BaseParticles::writeParticlesToBinaryForRestart(std::string &filefullpath)
+	{
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+		uint64_t total_real_particles = total_real_particles_;
+		out_file.write(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		WriteAParticleVariableToBinary write_variable_to_binary(out_file, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_restart_, write_variable_to_binary);
+		out_file.close();
+	}
+	//=================================================================================================//
+	void BaseParticles::readParticlesFromBinaryForRestart(std::string &filefullpath)
+	{
+		std::string buffer = loadCheckpointFile(filefullpath);
+		InMemoryStreamBuffer stream_buffer(buffer);
+		std::istream in_file(&stream_buffer);
+		uint64_t total_real_particles = 0;
+		in_file.read(reinterpret_cast<char *>(&total_real_particles), sizeof(total_real_particles));
+		if (total_real_particles != total_real_particles_)
+		{
+			std::cout << "\n Error: the restart file:" << filefullpath
+					  << " is written for " << total_real_particles << " particles" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		ReadAParticleVariableFromBinary read_variable_from_binary(in_file, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_restart_, read_variable_from_binary);
+	}
+	//=================================================================================================//
+	void BaseParticles::writeParticlesToBufferForRestart(std::string &buffer)
+	{
+		buffer.clear();
+		uint64_t total_real_particles = total_real_particles_;
+		buffer.append(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		SnapshotAParticleVariableToBuffer snapshot_variable_to_buffer(buffer, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_restart_, snapshot_variable_to_buffer);
+	}
+	//=================================================================================================//
+	void BaseParticles::writeParticleDeltaToBufferForRestart(std::string &buffer, const std::string &full_snapshot)
+	{
+		buffer.clear();
+		uint64_t total_real_particles = total_real_particles_;
+		buffer.append(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		SnapshotAParticleVariableDeltaToBuffer snapshot_delta_to_buffer(buffer, full_snapshot, total_real_particles_);
+		snapshot_delta_to_buffer.offset_ = sizeof(total_real_particles); // skip the particle count header
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_restart_, snapshot_delta_to_buffer);
+	}
+	//=================================================================================================//
+	void BaseParticles::readParticlesFromDeltaBinaryForRestart(std::string &full_filefullpath, std::string &delta_filefullpath)
+	{
+		readParticlesFromBinaryForRestart(full_filefullpath);
+
+		std::string buffer = loadCheckpointFile(delta_filefullpath);
+		InMemoryStreamBuffer stream_buffer(buffer);
+		std::istream in_file(&stream_buffer);
+		uint64_t total_real_particles = 0;
+		in_file.read(reinterpret_cast<char *>(&total_real_particles), sizeof(total_real_particles));
+		if (total_real_particles != total_real_particles_)
+		{
+			std::cout << "\n Error: the delta restart file:" << delta_filefullpath
+					  << " is written for " << total_real_particles << " particles" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		ReadAParticleVariableDeltaFromBinary read_delta_from_binary(in_file, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_restart_, read_delta_from_binary);
+	}
+	//=================================================================================================//
+	void BaseParticles::snapshotAllParticleData(std::string &buffer)
+	{
+		buffer.clear();
+		uint64_t total_real_particles = total_real_particles_;
+		buffer.append(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		SnapshotAParticleVariableToBuffer snapshot_variable_to_buffer(buffer, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		ParticleVariableList all_variables = allRegisteredVariables();
+		loop_variable_namelist(all_particle_data_, all_variables, snapshot_variable_to_buffer);
+	}
+	//=================================================================================================//
+	void BaseParticles::restoreAllParticleData(std::string &buffer)
+	{
+		InMemoryStreamBuffer stream_buffer(buffer);
+		std::istream in_file(&stream_buffer);
+		uint64_t total_real_particles = 0;
+		in_file.read(reinterpret_cast<char *>(&total_real_particles), sizeof(total_real_particles));
+		total_real_particles_ = total_real_particles;
+		ReadAParticleVariableFromBinary read_variable_from_binary(in_file, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		ParticleVariableList all_variables = allRegisteredVariables();
+		loop_variable_namelist(all_particle_data_, all_variables, read_variable_from_binary);
+	}
+	//=================================================================================================//
 	void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
 	{
 		resizeXmlDocForParticles(reload_xml_engine_);
@@ -369,4 +714,62 @@ namespace SPH
 		loop_variable_namelist(all_particle_data_, variables_to_reload_, read_variable_from_xml);
 	}
 	//=================================================================================================//
+	void BaseParticles::writeToBinaryForReloadParticle(std::string &filefullpath)
+	{
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+		uint64_t total_real_particles = total_real_particles_;
+		out_file.write(reinterpret_cast<const char *>(&total_real_particles), sizeof(total_real_particles));
+		WriteAParticleVariableToBinary write_variable_to_binary(out_file, total_real_particles_);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_reload_, write_variable_to_binary);
+		out_file.close();
+	}
+	//=================================================================================================//
+	void BaseParticles::readFromBinaryForReloadParticle(std::string &filefullpath)
+	{
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+		uint64_t total_real_particles = 0;
+		in_file.read(reinterpret_cast<char *>(&total_real_particles), sizeof(total_real_particles));
+		total_real_particles_ = total_real_particles;
+
+		//first phase: pre-size all particle arrays before any value is loaded
+		unsorted_id_.resize(total_real_particles_, 0);
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles_),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					unsorted_id_[i] = i;
+				}
+			},
+			ap);
+		resize_particle_data_(all_particle_data_, total_real_particles_);
+
+		//second phase: bulk-load the variable payload in one read and
+		//copy the values into the pre-sized arrays in parallel per variable
+		in_file.seekg(0, std::ios::end);
+		size_t buffer_size = (size_t)in_file.tellg() - sizeof(total_real_particles);
+		in_file.seekg(sizeof(total_real_particles), std::ios::beg);
+		StdVec<char> buffer(buffer_size);
+		in_file.read(buffer.data(), buffer_size);
+		in_file.close();
+
+		StdVec<std::function<void()>> bulk_copies;
+		CopyAParticleVariableFromBuffer copy_variable_from_buffer(buffer.data(), buffer_size,
+																  total_real_particles_, bulk_copies);
+		ParticleDataOperation<loopVariableNameList> loop_variable_namelist;
+		loop_variable_namelist(all_particle_data_, variables_to_reload_, copy_variable_from_buffer);
+		parallel_for(
+			blocked_range<size_t>(0, bulk_copies.size()),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					bulk_copies[i]();
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
 }
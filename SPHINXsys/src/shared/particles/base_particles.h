@@ -37,6 +37,8 @@
 #include "xml_engine.h"
 
 #include <fstream>
+#include <cstdint>
+#include <functional>
 
 namespace SPH
 {
@@ -113,8 +115,22 @@ namespace SPH
 		//----------------------------------------------------------------------
 		ParticleData all_particle_data_;
 		ParticleDataMap all_variable_maps_;
+		/** record of a lazily registered variable awaiting its first access:
+		 * the materializer allocates the variable and enters it into the
+		 * generalized particle data as an eager registration would */
+		struct LazyVariableRecord
+		{
+			std::function<void()> materializer_;
+			size_t bytes_per_particle_; /**< allocation avoided while untouched */
+		};
+		/** pending lazy variables by name within each data type */
+		std::array<std::map<std::string, LazyVariableRecord>, 4> lazy_variable_records_;
 		StdVec<ParticleDynamics<void> *> derived_variables_;
+		/** variable names aligned with derived_variables_ for selective evaluation */
+		StdVec<std::string> derived_variable_names_;
 		ParticleVariableList variables_to_write_;
+		/** named reusable scratch buffers for non-persistent intermediate data */
+		ScratchBufferRegistry scratch_buffers_;
 
 		/** register a variable defined in a class (can be non-particle class) */
 		template <typename VariableType>
@@ -126,6 +142,25 @@ namespace SPH
 		void registerAVariable(StdLargeVec<VariableType> &variable_addrs,
 							   const std::string &new_variable_name, const std::string &old_variable_name);
 
+		/** register a variable whose allocation is deferred until the first
+		 * access by name: only a materializer is recorded, so that a variable
+		 * which no dynamics, recorder or sorter ever touches never allocates.
+		 * The given reference stays empty until then, thus only variables
+		 * accessed through getVariableByName or the variable lists may be
+		 * registered lazily. */
+		template <typename VariableType>
+		void registerALazyVariable(StdLargeVec<VariableType> &variable_addrs,
+								   const std::string &variable_name, VariableType initial_value = VariableType(0));
+
+		/** materialize a lazily registered variable on its first access by name,
+		 * returns whether the variable was pending */
+		template <typename VariableType>
+		bool materializeLazyVariable(const std::string &variable_name);
+
+		/** names and so-far avoided allocation bytes of the lazily registered
+		 * variables which have never been touched, for auditing the variable set */
+		StdVec<std::pair<std::string, size_t>> untouchedVariablesReport();
+
 		/** get a registered variable from particles by its name. return by pointer so that return nullptr if fail. */
 		template <typename VariableType>
 		StdLargeVec<VariableType> *getVariableByName(const std::string &variable_name);
@@ -142,6 +177,10 @@ namespace SPH
 		template <class DerivedVariableMethod>
 		void addDerivedVariableToWrite();
 
+		/** evaluate, in parallel, only the derived variables selected by the
+		 * given recorder variable list, called at output time */
+		void computeDerivedVariables(const ParticleVariableList &variables_to_write);
+
 		/** add a variable into the list for restart */
 		template <typename VariableType>
 		void addAVariableToRestart(const std::string &variable_name);
@@ -155,6 +194,7 @@ namespace SPH
 		//----------------------------------------------------------------------
 		StdLargeVec<size_t> unsorted_id_; /**< the ids assigned just after particle generated. */
 		StdLargeVec<size_t> sorted_id_;	/**< the sorted particle ids of particles from unsorted ids. */
+		IndexVector recycled_particle_ids_; /**< unsorted ids of departed particles awaiting reuse. */
 		StdLargeVec<size_t> sequence_;	/**< the sequence referred for sorting. */
 		ParticleData sortable_data_;
 		ParticleDataMap sortable_variable_maps_;
@@ -163,18 +203,72 @@ namespace SPH
 		template <typename VariableType>
 		void registerASortableVariable(const std::string &variable_name);
 
+		/** register every variable of a given name list as sortable,
+		 * e.g. the local parameters of a material in one call */
+		void registerSortableVariables(const ParticleVariableList &variable_names);
+
+		/** names of the registered variables which are not sortable and whose
+		 * access pattern thus decorrelates from the particle memory order after
+		 * sorting, for auditing per-particle data such as material properties */
+		StdVec<std::string> unsortedVariablesReport();
+
 		SPHBody *getSPHBody() { return sph_body_; };
 		/** initialize other variables  based one geometric variables and material */
 		virtual void initializeOtherVariables();
+		/** pre-allocate head room for all registered variables, so that adding
+		 * buffer or ghost particles up to the reserved bound never reallocates
+		 * the particle data mid-run. */
+		void reserveParticleCapacity(size_t reserved_bound);
 		void addBufferParticles(size_t buffer_size);
 		void copyFromAnotherParticle(size_t this_index, size_t another_index);
 		void updateFromAnotherParticle(size_t this_index, size_t another_index);
 		size_t insertAGhostParticle(size_t index_i);
+		/** claim a contiguous range of ghost slots starting from the current ghost bound.
+		 * The particle data only grows when the pooled slots are exhausted and is only
+		 * trimmed when the claimed number shrinks substantially below them, so that
+		 * a ghost population recreated every step reuses stable slots in place.
+		 * returns the first claimed slot index. */
+		size_t claimGhostParticles(size_t number_of_ghosts);
 		void switchToBufferParticle(size_t index_i);
 
+		/** record a departed particle as a recyclable slot. The slot keeps its
+		 * last state and remains among the real particles until it is either
+		 * reused by an injection or resolved by compactRecycledParticleSlots(),
+		 * so that no live particle is moved on departure. The slot is recorded
+		 * by its unsorted id and thereby survives particle sorting.
+		 * Recording the same particle again has no effect. */
+		void recycleAParticle(size_t index_i);
+		size_t NumberOfRecycledSlots() { return recycled_particle_ids_.size(); };
+		/** current slot index of the n-th recycled particle */
+		size_t RecycledParticleSlot(size_t n) { return sorted_id_[recycled_particle_ids_[n]]; };
+		/** remove the first reused_slots entries from the free list
+		 * after an injection has filled them with new particles */
+		void dropReusedRecycledSlots(size_t reused_slots);
+		/** resolve all remaining recycled slots by filling them from the tail
+		 * of the real particles, each live particle moving at most once */
+		void compactRecycledParticleSlots();
+
+		/** allocated bytes of all registered particle variables, the particle
+		 * ids and the scratch buffers, for memory accounting. */
+		size_t ParticleDataMemoryFootprint();
+
+		/** build a variable list by resolving the given names against all registered
+		 * variables, so that a recorder can write a subset of the variables to write */
+		ParticleVariableList findVariablesByName(const StdVec<std::string> &variable_names);
+
+		/** the list of all registered variables of all types */
+		ParticleVariableList allRegisteredVariables();
+
 		/** Write particle data in Vtk format for Paraview. */
 		template <typename OutStreamType>
 		void writeParticlesToVtk(OutStreamType &output_stream);
+		/** Write a given list of particle variables in Vtk format for Paraview. */
+		template <typename OutStreamType>
+		void writeParticlesToVtk(OutStreamType &output_stream, const ParticleVariableList &variables_to_write);
+		/** Write a given list of particle variables for a subset of the particles in Vtk format for Paraview. */
+		template <typename OutStreamType>
+		void writeParticlesToVtk(OutStreamType &output_stream, const ParticleVariableList &variables_to_write,
+								 const IndexVector &subset_particles);
 		/** Write particle data in PLT format for Tecplot. */
 		void writeParticlesToPltFile(std::ofstream &output_file);
 		/** Write only surface particle data in VTU format for Paraview. TODO: this should be generalized for body part by particles */
@@ -183,9 +277,31 @@ namespace SPH
 		void resizeXmlDocForParticles(XmlEngine &xml_engine);
 		void writeParticlesToXmlForRestart(std::string &filefullpath);
 		void readParticleFromXmlForRestart(std::string &filefullpath);
+		/** restart in binary format: the restart variables are serialized
+		 * as raw buffers together with a variable manifest */
+		void writeParticlesToBinaryForRestart(std::string &filefullpath);
+		void readParticlesFromBinaryForRestart(std::string &filefullpath);
+		/** serialize the restart variables into an in-memory snapshot buffer
+		 * with the binary restart layout, so that the file writing can
+		 * happen off the simulation thread */
+		void writeParticlesToBufferForRestart(std::string &buffer);
+		/** serialize a delta checkpoint holding only the variables which
+		 * changed against the given full snapshot buffer */
+		void writeParticleDeltaToBufferForRestart(std::string &buffer, const std::string &full_snapshot);
+		/** restore from a full checkpoint and apply the given delta checkpoint */
+		void readParticlesFromDeltaBinaryForRestart(std::string &full_filefullpath, std::string &delta_filefullpath);
+		/** snapshot all registered variables into an in-memory buffer with the
+		 * binary restart layout, and restore the state from it again, used to
+		 * reset a body between in-process parameter-sweep variants */
+		void snapshotAllParticleData(std::string &buffer);
+		void restoreAllParticleData(std::string &buffer);
 		XmlEngine *getReloadXmlEngine() { return &reload_xml_engine_; };
 		void writeToXmlForReloadParticle(std::string &filefullpath);
 		void readFromXmlForReloadParticle(std::string &filefullpath);
+		/** particle reload in binary format: the reload variables are
+		 * serialized as raw buffers for fast production startups */
+		void writeToBinaryForReloadParticle(std::string &filefullpath);
+		void readFromBinaryForReloadParticle(std::string &filefullpath);
 
 		virtual BaseParticles *ThisObjectPtr() { return this; };
 
@@ -217,6 +333,13 @@ namespace SPH
 			void operator()(ParticleData &particle_data, size_t new_size) const;
 		};
 
+		/** Reserve capacity for a particle data without changing its size. */
+		template <typename VariableType>
+		struct reserveParticleData
+		{
+			void operator()(ParticleData &particle_data, size_t reserved_size) const;
+		};
+
 		/** Fill a particle variable with default data. */
 		template <typename VariableType>
 		struct addAParticleDataValue
@@ -232,6 +355,7 @@ namespace SPH
 		};
 
 		ParticleDataOperation<resizeParticleData> resize_particle_data_;
+		ParticleDataOperation<reserveParticleData> reserve_particle_data_;
 		ParticleDataOperation<addAParticleDataValue> add_a_particle_value_;
 		ParticleDataOperation<copyAParticleDataValue> copy_a_particle_value_;
 	};
@@ -258,6 +382,90 @@ namespace SPH
 		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
 	};
 
+	struct WriteAParticleVariableToBinary
+	{
+		std::ofstream &out_file_;
+		size_t &total_real_particles_;
+		WriteAParticleVariableToBinary(std::ofstream &out_file, size_t &total_real_particles)
+			: out_file_(out_file), total_real_particles_(total_real_particles){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
+	struct ReadAParticleVariableFromBinary
+	{
+		std::istream &in_file_;
+		size_t &total_real_particles_;
+		ReadAParticleVariableFromBinary(std::istream &in_file, size_t &total_real_particles)
+			: in_file_(in_file), total_real_particles_(total_real_particles){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
+	/** Copy a particle variable from a bulk-loaded binary buffer.
+	 * The manifest entries are validated in file order while the value
+	 * copies are only collected, so that they can run in parallel afterwards. */
+	struct CopyAParticleVariableFromBuffer
+	{
+		const char *buffer_;
+		size_t buffer_size_;
+		size_t &total_real_particles_;
+		mutable size_t offset_;
+		StdVec<std::function<void()>> &bulk_copies_;
+		CopyAParticleVariableFromBuffer(const char *buffer, size_t buffer_size,
+										size_t &total_real_particles, StdVec<std::function<void()>> &bulk_copies)
+			: buffer_(buffer), buffer_size_(buffer_size),
+			  total_real_particles_(total_real_particles), offset_(0), bulk_copies_(bulk_copies){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
+	/** Serialize a particle variable into an in-memory snapshot buffer,
+	 * using the same manifest layout as the binary restart files. */
+	struct SnapshotAParticleVariableToBuffer
+	{
+		std::string &buffer_;
+		size_t &total_real_particles_;
+		SnapshotAParticleVariableToBuffer(std::string &buffer, size_t &total_real_particles)
+			: buffer_(buffer), total_real_particles_(total_real_particles){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
+	/** Serialize only the particle variables which changed against the full
+	 * snapshot. The unchanged ones keep a manifest entry with an absent-payload
+	 * flag, so that the reader walks the variables in the same order. */
+	struct SnapshotAParticleVariableDeltaToBuffer
+	{
+		std::string &buffer_;
+		const std::string &full_snapshot_;
+		size_t &total_real_particles_;
+		mutable size_t offset_; /**< read position within the full snapshot. */
+		SnapshotAParticleVariableDeltaToBuffer(std::string &buffer, const std::string &full_snapshot,
+											   size_t &total_real_particles)
+			: buffer_(buffer), full_snapshot_(full_snapshot),
+			  total_real_particles_(total_real_particles), offset_(0){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
+	/** Apply a delta checkpoint on top of the restored full checkpoint state. */
+	struct ReadAParticleVariableDeltaFromBinary
+	{
+		std::istream &in_file_;
+		size_t &total_real_particles_;
+		ReadAParticleVariableDeltaFromBinary(std::istream &in_file, size_t &total_real_particles)
+			: in_file_(in_file), total_real_particles_(total_real_particles){};
+
+		template <typename VariableType>
+		void operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const;
+	};
+
 	/**
 	 * @class BaseDerivedVariable
 	 * @brief computing displacement from current and initial particle position
@@ -42,7 +42,8 @@ namespace SPH
     {
         constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
 
-        if (all_variable_maps_[type_index].find(variable_name) == all_variable_maps_[type_index].end())
+        if (all_variable_maps_[type_index].find(variable_name) == all_variable_maps_[type_index].end() &&
+            lazy_variable_records_[type_index].find(variable_name) == lazy_variable_records_[type_index].end())
         {
             variable_addrs.resize(real_particles_bound_, initial_value);
             std::get<type_index>(all_particle_data_).push_back(&variable_addrs);
@@ -63,6 +64,7 @@ namespace SPH
     {
         constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
 
+        materializeLazyVariable<VariableType>(old_variable_name);
         if (all_variable_maps_[type_index].find(old_variable_name) != all_variable_maps_[type_index].end())
         {
             registerAVariable(variable_addrs, new_variable_name);
@@ -80,10 +82,49 @@ namespace SPH
     }
     //=================================================================================================//
     template <typename VariableType>
+    void BaseParticles::
+        registerALazyVariable(StdLargeVec<VariableType> &variable_addrs,
+                              const std::string &variable_name, VariableType initial_value)
+    {
+        constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+
+        if (all_variable_maps_[type_index].find(variable_name) != all_variable_maps_[type_index].end() ||
+            lazy_variable_records_[type_index].find(variable_name) != lazy_variable_records_[type_index].end())
+        {
+            std::cout << "\n Error: the variable '" << variable_name << "' has already been registered!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+        LazyVariableRecord record;
+        record.materializer_ = [this, &variable_addrs, variable_name, initial_value]()
+        { registerAVariable(variable_addrs, variable_name, initial_value); };
+        record.bytes_per_particle_ = sizeof(VariableType);
+        lazy_variable_records_[type_index].insert(make_pair(variable_name, record));
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    bool BaseParticles::materializeLazyVariable(const std::string &variable_name)
+    {
+        constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+
+        auto record = lazy_variable_records_[type_index].find(variable_name);
+        if (record == lazy_variable_records_[type_index].end())
+            return false;
+        // erase the record before materializing, so that the eager
+        // registration within the materializer passes the duplicate check
+        std::function<void()> materializer = record->second.materializer_;
+        lazy_variable_records_[type_index].erase(record);
+        materializer();
+        return true;
+    }
+    //=================================================================================================//
+    template <typename VariableType>
     StdLargeVec<VariableType> *BaseParticles::getVariableByName(const std::string &variable_name)
     {
         constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
 
+        materializeLazyVariable<VariableType>(variable_name);
         if (all_variable_maps_[type_index].find(variable_name) != all_variable_maps_[type_index].end())
             return std::get<type_index>(all_particle_data_)[all_variable_maps_[type_index][variable_name]];
 
@@ -99,6 +140,8 @@ namespace SPH
     {
         constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
 
+        // a listed variable will be read by the output or restart files
+        materializeLazyVariable<VariableType>(variable_name);
         if (all_variable_maps_[type_index].find(variable_name) != all_variable_maps_[type_index].end())
         {
             bool is_to_add = true;
@@ -132,6 +175,7 @@ namespace SPH
     {
         SimpleDynamics<DerivedVariableMethod> *derived_data = derived_particle_data_.createPtr<SimpleDynamics<DerivedVariableMethod>>(*sph_body_);
         derived_variables_.push_back(derived_data);
+        derived_variable_names_.push_back(derived_data->LocalDynamics().variable_name_);
         using DerivedVariableType = typename DerivedVariableMethod::DerivedVariableType;
         addAVariableNameToList<DerivedVariableType>(variables_to_write_, derived_data->LocalDynamics().variable_name_);
     }
@@ -153,6 +197,7 @@ namespace SPH
     {
         constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
 
+        materializeLazyVariable<VariableType>(variable_name);
         if (sortable_variable_maps_[type_index].find(variable_name) == sortable_variable_maps_[type_index].end())
         {
             if (all_variable_maps_[type_index].find(variable_name) != all_variable_maps_[type_index].end())
@@ -187,6 +232,16 @@ namespace SPH
     }
     //=================================================================================================//
     template <typename VariableType>
+    void BaseParticles::reserveParticleData<VariableType>::
+    operator()(ParticleData &particle_data, size_t reserved_size) const
+    {
+        constexpr int type_index = ParticleDataTypeIndex<VariableType>::value;
+
+        for (size_t i = 0; i != std::get<type_index>(particle_data).size(); ++i)
+            std::get<type_index>(particle_data)[i]->reserve(reserved_size);
+    }
+    //=================================================================================================//
+    template <typename VariableType>
     void BaseParticles::addAParticleDataValue<VariableType>::
     operator()(ParticleData &particle_data) const
     {
@@ -209,6 +264,12 @@ namespace SPH
     //=================================================================================================//
     template <typename StreamType>
     void BaseParticles::writeParticlesToVtk(StreamType &output_stream)
+    {
+        writeParticlesToVtk(output_stream, variables_to_write_);
+    }
+    //=================================================================================================//
+    template <typename StreamType>
+    void BaseParticles::writeParticlesToVtk(StreamType &output_stream, const ParticleVariableList &variables_to_write)
     {
         size_t total_real_particles = total_real_particles_;
 
@@ -248,14 +309,11 @@ namespace SPH
         output_stream << std::endl;
         output_stream << "    </DataArray>\n";
 
-        // compute derived particle variables
-        for (ParticleDynamics<void> *derived_variable : derived_variables_)
-        {
-            derived_variable->parallel_exec();
-        }
+        // compute the derived particle variables selected for writing
+        computeDerivedVariables(variables_to_write);
 
         // write matrices
-        for (std::pair<std::string, size_t> &name_index : variables_to_write_[2])
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[2])
         {
             std::string variable_name = name_index.first;
             StdLargeVec<Matd> &variable = *(std::get<2>(all_particle_data_)[name_index.second]);
@@ -275,7 +333,7 @@ namespace SPH
         }
 
         // write vectors
-        for (std::pair<std::string, size_t> &name_index : variables_to_write_[1])
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[1])
         {
             std::string variable_name = name_index.first;
             StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data_)[name_index.second]);
@@ -291,7 +349,7 @@ namespace SPH
         }
 
         // write scalars
-        for (std::pair<std::string, size_t> &name_index : variables_to_write_[0])
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[0])
         {
             std::string variable_name = name_index.first;
             StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data_)[name_index.second]);
@@ -306,7 +364,7 @@ namespace SPH
         }
 
         // write integers
-        for (std::pair<std::string, size_t> &name_index : variables_to_write_[3])
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[3])
         {
             std::string variable_name = name_index.first;
             StdLargeVec<int> &variable = *(std::get<3>(all_particle_data_)[name_index.second]);
@@ -321,6 +379,118 @@ namespace SPH
         }
     }
     //=================================================================================================//
+    template <typename StreamType>
+    void BaseParticles::writeParticlesToVtk(StreamType &output_stream, const ParticleVariableList &variables_to_write,
+                                            const IndexVector &subset_particles)
+    {
+        size_t total_subset_particles = subset_particles.size();
+
+        // write current/final particle positions first
+        output_stream << "   <Points>\n";
+        output_stream << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_subset_particles; ++i)
+        {
+            Vec3d particle_position = upgradeToVector3D(pos_n_[subset_particles[i]]);
+            output_stream << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+        output_stream << "   </Points>\n";
+
+        // write header of particles data
+        output_stream << "   <PointData  Vectors=\"vector\">\n";
+
+        // write sorted particles ID
+        output_stream << "    <DataArray Name=\"SortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_subset_particles; ++i)
+        {
+            output_stream << subset_particles[i] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+
+        // write unsorted particles ID
+        output_stream << "    <DataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_subset_particles; ++i)
+        {
+            output_stream << unsorted_id_[subset_particles[i]] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+
+        // compute the derived particle variables selected for writing
+        computeDerivedVariables(variables_to_write);
+
+        // write matrices
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[2])
+        {
+            std::string variable_name = name_index.first;
+            StdLargeVec<Matd> &variable = *(std::get<2>(all_particle_data_)[name_index.second]);
+            output_stream << "    <DataArray Name=\"" << variable_name << "\" type=\"Float32\"  NumberOfComponents=\"9\" Format=\"ascii\">\n";
+            output_stream << "    ";
+            for (size_t i = 0; i != total_subset_particles; ++i)
+            {
+                Mat3d matrix_value = upgradeToMatrix3D(variable[subset_particles[i]]);
+                for (int k = 0; k != 3; ++k)
+                {
+                    Vec3d col_vector = matrix_value.col(k);
+                    output_stream << std::fixed << std::setprecision(9) << col_vector[0] << " " << col_vector[1] << " " << col_vector[2] << " ";
+                }
+            }
+            output_stream << std::endl;
+            output_stream << "    </DataArray>\n";
+        }
+
+        // write vectors
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[1])
+        {
+            std::string variable_name = name_index.first;
+            StdLargeVec<Vecd> &variable = *(std::get<1>(all_particle_data_)[name_index.second]);
+            output_stream << "    <DataArray Name=\"" << variable_name << "\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+            output_stream << "    ";
+            for (size_t i = 0; i != total_subset_particles; ++i)
+            {
+                Vec3d vector_value = upgradeToVector3D(variable[subset_particles[i]]);
+                output_stream << std::fixed << std::setprecision(9) << vector_value[0] << " " << vector_value[1] << " " << vector_value[2] << " ";
+            }
+            output_stream << std::endl;
+            output_stream << "    </DataArray>\n";
+        }
+
+        // write scalars
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[0])
+        {
+            std::string variable_name = name_index.first;
+            StdLargeVec<Real> &variable = *(std::get<0>(all_particle_data_)[name_index.second]);
+            output_stream << "    <DataArray Name=\"" << variable_name << "\" type=\"Float32\" Format=\"ascii\">\n";
+            output_stream << "    ";
+            for (size_t i = 0; i != total_subset_particles; ++i)
+            {
+                output_stream << std::fixed << std::setprecision(9) << variable[subset_particles[i]] << " ";
+            }
+            output_stream << std::endl;
+            output_stream << "    </DataArray>\n";
+        }
+
+        // write integers
+        for (const std::pair<std::string, size_t> &name_index : variables_to_write[3])
+        {
+            std::string variable_name = name_index.first;
+            StdLargeVec<int> &variable = *(std::get<3>(all_particle_data_)[name_index.second]);
+            output_stream << "    <DataArray Name=\"" << variable_name << "\" type=\"Int32\" Format=\"ascii\">\n";
+            output_stream << "    ";
+            for (size_t i = 0; i != total_subset_particles; ++i)
+            {
+                output_stream << std::fixed << std::setprecision(9) << variable[subset_particles[i]] << " ";
+            }
+            output_stream << std::endl;
+            output_stream << "    </DataArray>\n";
+        }
+    }
+    //=================================================================================================//
     template <typename VariableType>
     void WriteAParticleVariableToXml::
     operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
@@ -346,6 +516,128 @@ namespace SPH
     }
     //=================================================================================================//
     template <typename VariableType>
+    void WriteAParticleVariableToBinary::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        // manifest entry: variable name and value size, checked when reading back
+        uint32_t name_size = (uint32_t)variable_name.size();
+        out_file_.write(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+        out_file_.write(variable_name.data(), name_size);
+        uint32_t value_size = (uint32_t)sizeof(VariableType);
+        out_file_.write(reinterpret_cast<const char *>(&value_size), sizeof(value_size));
+        out_file_.write(reinterpret_cast<const char *>(variable.data()), total_real_particles_ * sizeof(VariableType));
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    void ReadAParticleVariableFromBinary::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        uint32_t name_size = 0;
+        in_file_.read(reinterpret_cast<char *>(&name_size), sizeof(name_size));
+        std::string stored_name(name_size, '\0');
+        in_file_.read(&stored_name[0], name_size);
+        uint32_t value_size = 0;
+        in_file_.read(reinterpret_cast<char *>(&value_size), sizeof(value_size));
+        if (stored_name != variable_name || value_size != sizeof(VariableType))
+        {
+            std::cout << "\n Error: the restart file variable '" << stored_name
+                      << "' does not match the registered variable '" << variable_name << "'!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        in_file_.read(reinterpret_cast<char *>(variable.data()), total_real_particles_ * sizeof(VariableType));
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    void CopyAParticleVariableFromBuffer::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        uint32_t name_size = 0;
+        std::memcpy(&name_size, buffer_ + offset_, sizeof(name_size));
+        offset_ += sizeof(name_size);
+        std::string stored_name(buffer_ + offset_, name_size);
+        offset_ += name_size;
+        uint32_t value_size = 0;
+        std::memcpy(&value_size, buffer_ + offset_, sizeof(value_size));
+        offset_ += sizeof(value_size);
+        size_t payload_size = total_real_particles_ * sizeof(VariableType);
+        if (stored_name != variable_name || value_size != sizeof(VariableType) ||
+            offset_ + payload_size > buffer_size_)
+        {
+            std::cout << "\n Error: the reload file variable '" << stored_name
+                      << "' does not match the registered variable '" << variable_name << "'!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        const char *source = buffer_ + offset_;
+        VariableType *destination = variable.data();
+        bulk_copies_.push_back(
+            [source, destination, payload_size]()
+            { std::memcpy(destination, source, payload_size); });
+        offset_ += payload_size;
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    void SnapshotAParticleVariableToBuffer::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        uint32_t name_size = (uint32_t)variable_name.size();
+        buffer_.append(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+        buffer_.append(variable_name.data(), name_size);
+        uint32_t value_size = (uint32_t)sizeof(VariableType);
+        buffer_.append(reinterpret_cast<const char *>(&value_size), sizeof(value_size));
+        buffer_.append(reinterpret_cast<const char *>(variable.data()), total_real_particles_ * sizeof(VariableType));
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    void SnapshotAParticleVariableDeltaToBuffer::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        // walk the matching manifest entry of the full snapshot
+        uint32_t name_size = 0;
+        std::memcpy(&name_size, full_snapshot_.data() + offset_, sizeof(name_size));
+        offset_ += sizeof(name_size) + name_size;
+        offset_ += sizeof(uint32_t); // the value size of the entry
+        size_t payload_size = total_real_particles_ * sizeof(VariableType);
+        const char *reference_payload = full_snapshot_.data() + offset_;
+        offset_ += payload_size;
+
+        name_size = (uint32_t)variable_name.size();
+        buffer_.append(reinterpret_cast<const char *>(&name_size), sizeof(name_size));
+        buffer_.append(variable_name.data(), name_size);
+        uint32_t value_size = (uint32_t)sizeof(VariableType);
+        buffer_.append(reinterpret_cast<const char *>(&value_size), sizeof(value_size));
+        uint8_t payload_present =
+            std::memcmp(variable.data(), reference_payload, payload_size) != 0 ? 1 : 0;
+        buffer_.append(reinterpret_cast<const char *>(&payload_present), sizeof(payload_present));
+        if (payload_present)
+            buffer_.append(reinterpret_cast<const char *>(variable.data()), payload_size);
+    }
+    //=================================================================================================//
+    template <typename VariableType>
+    void ReadAParticleVariableDeltaFromBinary::
+    operator()(std::string &variable_name, StdLargeVec<VariableType> &variable) const
+    {
+        uint32_t name_size = 0;
+        in_file_.read(reinterpret_cast<char *>(&name_size), sizeof(name_size));
+        std::string stored_name(name_size, '\0');
+        in_file_.read(&stored_name[0], name_size);
+        uint32_t value_size = 0;
+        in_file_.read(reinterpret_cast<char *>(&value_size), sizeof(value_size));
+        if (stored_name != variable_name || value_size != sizeof(VariableType))
+        {
+            std::cout << "\n Error: the delta restart file variable '" << stored_name
+                      << "' does not match the registered variable '" << variable_name << "'!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        uint8_t payload_present = 0;
+        in_file_.read(reinterpret_cast<char *>(&payload_present), sizeof(payload_present));
+        if (payload_present)
+            in_file_.read(reinterpret_cast<char *>(variable.data()), total_real_particles_ * sizeof(VariableType));
+    }
+    //=================================================================================================//
+    template <typename VariableType>
     BaseDerivedVariable<VariableType>::
         BaseDerivedVariable(const SPHBody &sph_body, const std::string &variable_name)
         : variable_name_(variable_name)
@@ -48,10 +48,17 @@ namespace SPH
 		size_t number_of_species_;			 /**< Total number of diffusion and reaction species . */
 		size_t number_of_diffusion_species_; /**< Total number of diffusion species . */
 		std::map<std::string, size_t> species_indexes_map_;
+		bool use_blocked_species_layout_; /**< whether the species are mirrored in the blocked layout */
 
 	public:
 		StdVec<StdLargeVec<Real>> species_n_;	 /**< array of diffusion/reaction scalars */
 		StdVec<StdLargeVec<Real>> diffusion_dt_; /**< array of the time derivative of diffusion species */
+		/** species mirrored in cache-line-sized particle blocks (AoSoA), so that all
+		 * species of a particle are adjacent in memory when a sweep touching every
+		 * species per particle gathers them through the neighbor indexes */
+		StdLargeVec<Real> species_blocked_;
+		/** particles per block, one cache line of Real values */
+		static const size_t species_block_size_ = 8;
 
 		template <class BaseMaterialType>
 		DiffusionReactionParticles(SPHBody &sph_body,
@@ -59,7 +66,8 @@ namespace SPH
 			: BaseParticlesType(sph_body, diffusion_reaction_material),
 			  number_of_species_(diffusion_reaction_material->NumberOfSpecies()),
 			  number_of_diffusion_species_(diffusion_reaction_material->NumberOfSpeciesDiffusion()),
-			  species_indexes_map_(diffusion_reaction_material->SpeciesIndexMap())
+			  species_indexes_map_(diffusion_reaction_material->SpeciesIndexMap()),
+			  use_blocked_species_layout_(false)
 		{
 			species_n_.resize(number_of_species_);
 			diffusion_dt_.resize(number_of_diffusion_species_);
@@ -68,6 +76,47 @@ namespace SPH
 
 		std::map<std::string, size_t> SpeciesIndexMap() { return species_indexes_map_; };
 
+		/** mirror the species in the blocked layout. The registered per-species
+		 * arrays stay authoritative for sorting, restart and output; the mirror
+		 * is refreshed by the diffusion relaxation before each interaction sweep. */
+		void useBlockedSpeciesLayout() { use_blocked_species_layout_ = true; };
+		bool usingBlockedSpeciesLayout() { return use_blocked_species_layout_; };
+		/** entry of a species value in the blocked layout */
+		size_t BlockedSpeciesEntry(size_t species_k, size_t index_i)
+		{
+			return (index_i / species_block_size_) * species_block_size_ * number_of_species_ +
+				   species_k * species_block_size_ + index_i % species_block_size_;
+		};
+		Real BlockedSpeciesValue(size_t species_k, size_t index_i)
+		{
+			return species_blocked_[BlockedSpeciesEntry(species_k, index_i)];
+		};
+		/** gather the registered species arrays into the blocked mirror,
+		 * including the buffer and ghost entries which can be referenced
+		 * as neighbors */
+		void gatherBlockedSpecies()
+		{
+			size_t total_entries = species_n_[0].size();
+			size_t number_of_blocks = (total_entries + species_block_size_ - 1) / species_block_size_;
+			species_blocked_.resize(number_of_blocks * species_block_size_ * number_of_species_);
+			parallel_for(
+				blocked_range<size_t>(0, number_of_blocks),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t b = r.begin(); b != r.end(); ++b)
+					{
+						size_t block_first = b * species_block_size_;
+						size_t block_entry = block_first * number_of_species_;
+						size_t entries_in_block = SMIN(species_block_size_, total_entries - block_first);
+						for (size_t k = 0; k != number_of_species_; ++k)
+							for (size_t n = 0; n != entries_in_block; ++n)
+								species_blocked_[block_entry + k * species_block_size_ + n] =
+									species_n_[k][block_first + n];
+					}
+				},
+				ap);
+		};
+
 		virtual void initializeOtherVariables() override
 		{
 			BaseParticlesType::initializeOtherVariables();
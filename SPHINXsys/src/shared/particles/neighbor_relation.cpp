@@ -11,6 +11,74 @@
 
 namespace SPH
 {
+	//=================================================================================================//
+	size_t NeighborPrefetch::prefetch_distance_ = 0;
+	//=================================================================================================//
+	NeighborhoodArena::~NeighborhoodArena()
+	{
+		for (ThreadChunks &local_chunks : thread_chunks_)
+		{
+			for (size_t k = 0; k != local_chunks.chunks_.size(); ++k)
+				delete[] local_chunks.chunks_[k].first;
+		}
+	}
+	//=================================================================================================//
+	void *NeighborhoodArena::allocate(size_t bytes)
+	{
+		// keep subsequent allocations cache line aligned
+		bytes = (bytes + 63) & ~size_t(63);
+
+		ThreadChunks &local_chunks = thread_chunks_.local();
+		while (local_chunks.current_chunk_ != local_chunks.chunks_.size() &&
+			   local_chunks.allocated_in_chunk_ + bytes >
+				   local_chunks.chunks_[local_chunks.current_chunk_].second)
+		{
+			++local_chunks.current_chunk_;
+			local_chunks.allocated_in_chunk_ = 0;
+		}
+		if (local_chunks.current_chunk_ == local_chunks.chunks_.size())
+		{
+			size_t new_chunk_size = SMAX(chunk_size_, bytes);
+			local_chunks.chunks_.push_back(std::make_pair(new char[new_chunk_size], new_chunk_size));
+		}
+
+		void *address = local_chunks.chunks_[local_chunks.current_chunk_].first +
+						local_chunks.allocated_in_chunk_;
+		local_chunks.allocated_in_chunk_ += bytes;
+		return address;
+	}
+	//=================================================================================================//
+	void NeighborhoodArena::reset()
+	{
+		for (ThreadChunks &local_chunks : thread_chunks_)
+		{
+			local_chunks.current_chunk_ = 0;
+			local_chunks.allocated_in_chunk_ = 0;
+		}
+	}
+	//=================================================================================================//
+	void NeighborhoodArena::release()
+	{
+		for (ThreadChunks &local_chunks : thread_chunks_)
+		{
+			for (size_t k = 0; k != local_chunks.chunks_.size(); ++k)
+				delete[] local_chunks.chunks_[k].first;
+			local_chunks.chunks_.clear();
+			local_chunks.current_chunk_ = 0;
+			local_chunks.allocated_in_chunk_ = 0;
+		}
+	}
+	//=================================================================================================//
+	size_t NeighborhoodArena::MemoryFootprint()
+	{
+		size_t footprint_in_bytes = 0;
+		for (ThreadChunks &local_chunks : thread_chunks_)
+		{
+			for (size_t k = 0; k != local_chunks.chunks_.size(); ++k)
+				footprint_in_bytes += local_chunks.chunks_[k].second;
+		}
+		return footprint_in_bytes;
+	}
 	//=================================================================================================//
 	void Neighborhood::removeANeighbor(size_t neighbor_n)
 	{
@@ -18,8 +86,207 @@ namespace SPH
 		j_[neighbor_n] = j_[current_size_];
 		W_ij_[neighbor_n] = W_ij_[current_size_];
 		dW_ij_[neighbor_n] = dW_ij_[current_size_];
-		r_ij_[neighbor_n] = r_ij_[current_size_];
-		e_ij_[neighbor_n] = e_ij_[current_size_];
+		if (r_ij_.size() != 0)
+		{
+			r_ij_[neighbor_n] = r_ij_[current_size_];
+			e_ij_[neighbor_n] = e_ij_[current_size_];
+		}
+		if (dW_ij_e_ij_.size() != 0)
+		{
+			dW_ij_e_ij_[neighbor_n] = dW_ij_e_ij_[current_size_];
+		}
+	}
+	//=================================================================================================//
+	void Neighborhood::reserveStorage(size_t forecast_size, bool store_pair_geometry,
+									  bool store_kernel_gradient)
+	{
+		j_.resize(forecast_size, 0);
+		W_ij_.resize(forecast_size, 0.0);
+		dW_ij_.resize(forecast_size, 0.0);
+		if (store_pair_geometry)
+		{
+			r_ij_.resize(forecast_size, 0.0);
+			e_ij_.resize(forecast_size, Vecd(0));
+		}
+		if (store_kernel_gradient)
+		{
+			dW_ij_e_ij_.resize(forecast_size, Vecd(0));
+		}
+		allocated_size_ = forecast_size;
+	}
+	//=================================================================================================//
+	void Neighborhood::shrinkStorage(size_t forecast_size, bool store_pair_geometry,
+									 bool store_kernel_gradient)
+	{
+		NeighborhoodVec<size_t>(forecast_size, 0, j_.get_allocator()).swap(j_);
+		NeighborhoodVec<Real>(forecast_size, 0.0, W_ij_.get_allocator()).swap(W_ij_);
+		NeighborhoodVec<Real>(forecast_size, 0.0, dW_ij_.get_allocator()).swap(dW_ij_);
+		size_t pair_geometry_size = store_pair_geometry ? forecast_size : 0;
+		NeighborhoodVec<Real>(pair_geometry_size, 0.0, r_ij_.get_allocator()).swap(r_ij_);
+		NeighborhoodVec<Vecd>(pair_geometry_size, Vecd(0), e_ij_.get_allocator()).swap(e_ij_);
+		size_t kernel_gradient_size = store_kernel_gradient ? forecast_size : 0;
+		NeighborhoodVec<Vecd>(kernel_gradient_size, Vecd(0), dW_ij_e_ij_.get_allocator()).swap(dW_ij_e_ij_);
+		allocated_size_ = forecast_size;
+		current_size_ = 0;
+	}
+	//=================================================================================================//
+	void Neighborhood::releaseStorage()
+	{
+		NeighborhoodVec<size_t>(j_.get_allocator()).swap(j_);
+		NeighborhoodVec<Real>(W_ij_.get_allocator()).swap(W_ij_);
+		NeighborhoodVec<Real>(dW_ij_.get_allocator()).swap(dW_ij_);
+		NeighborhoodVec<Real>(r_ij_.get_allocator()).swap(r_ij_);
+		NeighborhoodVec<Vecd>(e_ij_.get_allocator()).swap(e_ij_);
+		NeighborhoodVec<Vecd>(dW_ij_e_ij_.get_allocator()).swap(dW_ij_e_ij_);
+		allocated_size_ = 0;
+		current_size_ = 0;
+	}
+	//=================================================================================================//
+	void CompactNeighborList::packConfiguration(const ParticleConfiguration &particle_configuration,
+												size_t total_real_particles,
+												CompactParticleConfiguration &compact_configuration)
+	{
+		offsets_.resize(total_real_particles + 1);
+		offsets_[0] = 0;
+		for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+		{
+			offsets_[index_i + 1] = offsets_[index_i] + particle_configuration[index_i].current_size_;
+		}
+
+		fixed_stride_ = 0;
+		if (use_fixed_stride_ && total_real_particles != 0)
+		{
+			size_t max_neighbors = 0;
+			for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+				max_neighbors = SMAX(max_neighbors, particle_configuration[index_i].current_size_);
+			size_t stride = ((max_neighbors + 7) / 8) * 8;
+			size_t padded_entries = stride * total_real_particles;
+			Real padding_waste = Real(padded_entries - offsets_[total_real_particles]) / Real(padded_entries + TinyReal);
+			if (padding_waste <= padding_waste_limit_)
+			{
+				fixed_stride_ = stride;
+				packConfigurationFixedStride(particle_configuration, total_real_particles, compact_configuration);
+				return;
+			}
+		}
+
+		size_t total_neighbors = offsets_[total_real_particles];
+		j_.resize(total_neighbors);
+		W_ij_.resize(total_neighbors);
+		dW_ij_.resize(total_neighbors);
+		size_t pair_geometry_size = pack_pair_geometry_ ? total_neighbors : 0;
+		r_ij_.resize(pair_geometry_size);
+		e_ij_.resize(pair_geometry_size);
+		size_t kernel_gradient_size = pack_kernel_gradient_ ? total_neighbors : 0;
+		dW_ij_e_ij_.resize(kernel_gradient_size);
+		compact_configuration.resize(total_real_particles, CompactNeighborhood());
+
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					const Neighborhood &neighborhood = particle_configuration[index_i];
+					size_t offset = offsets_[index_i];
+					for (size_t n = 0; n != neighborhood.current_size_; ++n)
+					{
+						j_[offset + n] = neighborhood.j_[n];
+						W_ij_[offset + n] = neighborhood.W_ij_[n];
+						dW_ij_[offset + n] = neighborhood.dW_ij_[n];
+						if (pack_pair_geometry_)
+						{
+							r_ij_[offset + n] = neighborhood.r_ij_[n];
+							e_ij_[offset + n] = neighborhood.e_ij_[n];
+						}
+						if (pack_kernel_gradient_)
+						{
+							dW_ij_e_ij_[offset + n] = neighborhood.dW_ij_e_ij_[n];
+						}
+					}
+
+					CompactNeighborhood &compact_neighborhood = compact_configuration[index_i];
+					compact_neighborhood.current_size_ = neighborhood.current_size_;
+					compact_neighborhood.j_ = j_.data() + offset;
+					compact_neighborhood.W_ij_ = W_ij_.data() + offset;
+					compact_neighborhood.dW_ij_ = dW_ij_.data() + offset;
+					compact_neighborhood.r_ij_ = pack_pair_geometry_ ? r_ij_.data() + offset : nullptr;
+					compact_neighborhood.e_ij_ = pack_pair_geometry_ ? e_ij_.data() + offset : nullptr;
+					compact_neighborhood.dW_ij_e_ij_ = pack_kernel_gradient_ ? dW_ij_e_ij_.data() + offset : nullptr;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
+	void CompactNeighborList::packConfigurationFixedStride(const ParticleConfiguration &particle_configuration,
+														   size_t total_real_particles,
+														   CompactParticleConfiguration &compact_configuration)
+	{
+		size_t padded_entries = fixed_stride_ * total_real_particles;
+		j_.resize(padded_entries);
+		W_ij_.resize(padded_entries);
+		dW_ij_.resize(padded_entries);
+		size_t pair_geometry_size = pack_pair_geometry_ ? padded_entries : 0;
+		r_ij_.resize(pair_geometry_size);
+		e_ij_.resize(pair_geometry_size);
+		size_t kernel_gradient_size = pack_kernel_gradient_ ? padded_entries : 0;
+		dW_ij_e_ij_.resize(kernel_gradient_size);
+		compact_configuration.resize(total_real_particles, CompactNeighborhood());
+
+		parallel_for(
+			blocked_range<size_t>(0, total_real_particles),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+				{
+					const Neighborhood &neighborhood = particle_configuration[index_i];
+					size_t offset = fixed_stride_ * index_i;
+					for (size_t n = 0; n != neighborhood.current_size_; ++n)
+					{
+						j_[offset + n] = neighborhood.j_[n];
+						W_ij_[offset + n] = neighborhood.W_ij_[n];
+						dW_ij_[offset + n] = neighborhood.dW_ij_[n];
+						if (pack_pair_geometry_)
+						{
+							r_ij_[offset + n] = neighborhood.r_ij_[n];
+							e_ij_[offset + n] = neighborhood.e_ij_[n];
+						}
+						if (pack_kernel_gradient_)
+						{
+							dW_ij_e_ij_[offset + n] = neighborhood.dW_ij_e_ij_[n];
+						}
+					}
+					// the padded entries are zero-weight self pairs, so that the
+					// interaction loops sweep the full stride without a remainder
+					// and the padding contributes nothing
+					for (size_t n = neighborhood.current_size_; n != fixed_stride_; ++n)
+					{
+						j_[offset + n] = index_i;
+						W_ij_[offset + n] = 0.0;
+						dW_ij_[offset + n] = 0.0;
+						if (pack_pair_geometry_)
+						{
+							// a unit distance keeps denominators regularized by r_ij_ finite
+							r_ij_[offset + n] = 1.0;
+							e_ij_[offset + n] = Vecd(0);
+						}
+						if (pack_kernel_gradient_)
+						{
+							dW_ij_e_ij_[offset + n] = Vecd(0);
+						}
+					}
+
+					CompactNeighborhood &compact_neighborhood = compact_configuration[index_i];
+					compact_neighborhood.current_size_ = fixed_stride_;
+					compact_neighborhood.j_ = j_.data() + offset;
+					compact_neighborhood.W_ij_ = W_ij_.data() + offset;
+					compact_neighborhood.dW_ij_ = dW_ij_.data() + offset;
+					compact_neighborhood.r_ij_ = pack_pair_geometry_ ? r_ij_.data() + offset : nullptr;
+					compact_neighborhood.e_ij_ = pack_pair_geometry_ ? e_ij_.data() + offset : nullptr;
+					compact_neighborhood.dW_ij_e_ij_ = pack_kernel_gradient_ ? dW_ij_e_ij_.data() + offset : nullptr;
+				}
+			},
+			ap);
 	}
 	//=================================================================================================//
 	void NeighborRelation::createRelation(Neighborhood &neighborhood,
@@ -27,9 +294,15 @@ namespace SPH
 	{
 		neighborhood.j_.push_back(j_index);
 		neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-		neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
-		neighborhood.r_ij_.push_back(distance);
-		neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+		Real dW_ij = kernel_->dW(distance, displacement);
+		neighborhood.dW_ij_.push_back(dW_ij);
+		if (store_pair_geometry_)
+		{
+			neighborhood.r_ij_.push_back(distance);
+			neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+		}
+		if (store_kernel_gradient_)
+			neighborhood.dW_ij_e_ij_.push_back(displacement * (dW_ij / (distance + TinyReal)));
 		neighborhood.allocated_size_++;
 	}
 	//=================================================================================================//
@@ -39,9 +312,15 @@ namespace SPH
 		size_t current_size = neighborhood.current_size_;
 		neighborhood.j_[current_size] = j_index;
 		neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-		neighborhood.dW_ij_[current_size] = kernel_->dW(distance, displacement);
-		neighborhood.r_ij_[current_size] = distance;
-		neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+		Real dW_ij = kernel_->dW(distance, displacement);
+		neighborhood.dW_ij_[current_size] = dW_ij;
+		if (store_pair_geometry_)
+		{
+			neighborhood.r_ij_[current_size] = distance;
+			neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+		}
+		if (store_kernel_gradient_)
+			neighborhood.dW_ij_e_ij_[current_size] = displacement * (dW_ij / (distance + TinyReal));
 	}
 	//=================================================================================================//
 	void NeighborRelation::createRelation(Neighborhood &neighborhood, Real &distance,
@@ -50,9 +329,12 @@ namespace SPH
 		neighborhood.j_.push_back(j_index);
 		Real weight = distance < kernel_->CutOffRadius(i_h_ratio) ? kernel_->W(i_h_ratio, distance, displacement) : 0.0;
 		neighborhood.W_ij_.push_back(weight);
-		neighborhood.dW_ij_.push_back(kernel_->dW(h_ratio_min, distance, displacement));
+		Real dW_ij = kernel_->dW(h_ratio_min, distance, displacement);
+		neighborhood.dW_ij_.push_back(dW_ij);
 		neighborhood.r_ij_.push_back(distance);
 		neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+		if (store_kernel_gradient_)
+			neighborhood.dW_ij_e_ij_.push_back(displacement * (dW_ij / (distance + TinyReal)));
 		neighborhood.allocated_size_++;
 	}
 	//=================================================================================================//
@@ -65,9 +347,12 @@ namespace SPH
 		neighborhood.W_ij_[current_size] = distance < kernel_->CutOffRadius(i_h_ratio)
 											   ? kernel_->W(i_h_ratio, distance, displacement)
 											   : 0.0;
-		neighborhood.dW_ij_[current_size] = kernel_->dW(h_ratio_min, distance, displacement);
+		Real dW_ij = kernel_->dW(h_ratio_min, distance, displacement);
+		neighborhood.dW_ij_[current_size] = dW_ij;
 		neighborhood.r_ij_[current_size] = distance;
 		neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+		if (store_kernel_gradient_)
+			neighborhood.dW_ij_e_ij_[current_size] = displacement * (dW_ij / (distance + TinyReal));
 	}
 	//=================================================================================================//
 	NeighborRelationInner::NeighborRelationInner(SPHBody *body) : NeighborRelation()
@@ -78,12 +363,56 @@ namespace SPH
 	void NeighborRelationInner::operator()(Neighborhood &neighborhood,
 										   Vecd &displacement, size_t i_index, size_t j_index) const
 	{
-		Real distance = displacement.norm();
-		if (distance < kernel_->CutOffRadius() && i_index != j_index)
+		// filter candidates by the squared distance, the square root is only
+		// taken for the accepted pairs
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < kernel_->CutOffRadiusSqr() && i_index != j_index)
+		{
+			Real distance = std::sqrt(distance_sqr);
+			neighborhood.current_size_ >= neighborhood.allocated_size_
+				? createRelation(neighborhood, distance, displacement, j_index)
+				: initializeRelation(neighborhood, distance, displacement, j_index);
+			neighborhood.current_size_++;
+		}
+	};
+	//=================================================================================================//
+	void NeighborRelationInnerHalf::operator()(Neighborhood &neighborhood,
+											   Vecd &displacement, size_t i_index, size_t j_index) const
+	{
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < kernel_->CutOffRadiusSqr() && j_index < i_index)
+		{
+			Real distance = std::sqrt(distance_sqr);
+			neighborhood.current_size_ >= neighborhood.allocated_size_
+				? createRelation(neighborhood, distance, displacement, j_index)
+				: initializeRelation(neighborhood, distance, displacement, j_index);
+			neighborhood.current_size_++;
+		}
+	};
+	//=================================================================================================//
+	NeighborRelationInnerWithSkin::
+		NeighborRelationInnerWithSkin(SPHBody *body, Real skin_distance)
+		: NeighborRelationInner(body),
+		  cutoff_radius_with_skin_(kernel_->CutOffRadius() + skin_distance),
+		  cutoff_radius_with_skin_sqr_(cutoff_radius_with_skin_ * cutoff_radius_with_skin_) {}
+	//=================================================================================================//
+	void NeighborRelationInnerWithSkin::operator()(Neighborhood &neighborhood,
+												   Vecd &displacement, size_t i_index, size_t j_index) const
+	{
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < cutoff_radius_with_skin_sqr_ && i_index != j_index)
 		{
+			Real distance = std::sqrt(distance_sqr);
 			neighborhood.current_size_ >= neighborhood.allocated_size_
 				? createRelation(neighborhood, distance, displacement, j_index)
 				: initializeRelation(neighborhood, distance, displacement, j_index);
+			if (distance >= kernel_->CutOffRadius())
+			{
+				neighborhood.W_ij_[neighborhood.current_size_] = 0.0;
+				neighborhood.dW_ij_[neighborhood.current_size_] = 0.0;
+				if (store_kernel_gradient_)
+					neighborhood.dW_ij_e_ij_[neighborhood.current_size_] = Vecd(0);
+			}
 			neighborhood.current_size_++;
 		}
 	};
@@ -101,10 +430,10 @@ namespace SPH
 	{
 		Real i_h_ratio = h_ratio_[i_index];
 		Real h_ratio_min = SMIN(i_h_ratio, h_ratio_[j_index]);
-		Real cutoff_radius = kernel_->CutOffRadius(h_ratio_min);
-		Real distance = displacement.norm();
-		if (distance < cutoff_radius && i_index != j_index)
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < kernel_->CutOffRadiusSqr(h_ratio_min) && i_index != j_index)
 		{
+			Real distance = std::sqrt(distance_sqr);
 			neighborhood.current_size_ >= neighborhood.allocated_size_
 				? createRelation(neighborhood, distance, displacement, j_index, i_h_ratio, h_ratio_min)
 				: initializeRelation(neighborhood, distance, displacement, j_index, i_h_ratio, h_ratio_min);
@@ -123,10 +452,11 @@ namespace SPH
 	void NeighborRelationSelfContact::operator()(Neighborhood &neighborhood,
 												 Vecd &displacement, size_t i_index, size_t j_index) const
 	{
-		Real distance0 = (pos_0_[i_index] - pos_0_[j_index]).norm();
-		Real distance = displacement.norm();
-		if (distance < kernel_->CutOffRadius() && distance0 > kernel_->CutOffRadius())
+		Real distance0_sqr = (pos_0_[i_index] - pos_0_[j_index]).normSqr();
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < kernel_->CutOffRadiusSqr() && distance0_sqr > kernel_->CutOffRadiusSqr())
 		{
+			Real distance = std::sqrt(distance_sqr);
 			neighborhood.current_size_ >= neighborhood.allocated_size_
 				? createRelation(neighborhood, distance, displacement, j_index)
 				: initializeRelation(neighborhood, distance, displacement, j_index);
@@ -140,14 +470,16 @@ namespace SPH
 		Kernel *source_kernel = body->sph_adaptation_->getKernel();
 		Kernel *target_kernel = contact_body->sph_adaptation_->getKernel();
 		kernel_ = source_kernel->SmoothingLength() > target_kernel->SmoothingLength() ? source_kernel : target_kernel;
+		cutoff_radius_sqr_ = kernel_->CutOffRadiusSqr();
 	}
 	//=================================================================================================//
 	void NeighborRelationContact::operator()(Neighborhood &neighborhood,
 											 Vecd &displacement, size_t i_index, size_t j_index) const
 	{
-		Real distance = displacement.norm();
-		if (distance < kernel_->CutOffRadius())
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < cutoff_radius_sqr_)
 		{
+			Real distance = std::sqrt(distance_sqr);
 			neighborhood.current_size_ >= neighborhood.allocated_size_
 				? createRelation(neighborhood, distance, displacement, j_index)
 				: initializeRelation(neighborhood, distance, displacement, j_index);
@@ -161,6 +493,7 @@ namespace SPH
 		Real source_smoothing_length = body->sph_adaptation_->ReferenceSmoothingLength();
 		Real target_smoothing_length = contact_body->sph_adaptation_->ReferenceSmoothingLength();
 		kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(0.5 * (source_smoothing_length + target_smoothing_length));
+		cutoff_radius_sqr_ = kernel_->CutOffRadiusSqr();
 	}
 	//=================================================================================================//
 	NeighborRelationContactBodyPart::
@@ -183,9 +516,10 @@ namespace SPH
 	void NeighborRelationContactBodyPart::operator()(Neighborhood &neighborhood,
 													 Vecd &displacement, size_t i_index, size_t j_index) const
 	{
-		Real distance = displacement.norm();
-		if (distance < kernel_->CutOffRadius() && part_indicator_[j_index] == 1)
+		Real distance_sqr = displacement.normSqr();
+		if (distance_sqr < kernel_->CutOffRadiusSqr() && part_indicator_[j_index] == 1)
 		{
+			Real distance = std::sqrt(distance_sqr);
 			neighborhood.current_size_ >= neighborhood.allocated_size_
 				? createRelation(neighborhood, distance, displacement, j_index)
 				: initializeRelation(neighborhood, distance, displacement, j_index);
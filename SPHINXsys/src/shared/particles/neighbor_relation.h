@@ -34,12 +34,93 @@
 #include "base_data_package.h"
 #include "all_kernels.h"
 
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+
 namespace SPH
 {
 
 	class SPHBody;
 	class BodyPart;
 
+	/**
+	 * @class NeighborhoodArena
+	 * @brief A chunked memory arena for neighborhood storage.
+	 * Allocations bump a per-thread offset within large chunks, so that
+	 * growing the neighbor vectors of millions of neighborhoods does not
+	 * go through the global allocator during the parallel configuration
+	 * build. Individual deallocations are ignored, releasing is a bulk
+	 * reset which retains the chunks for the next build.
+	 */
+	class NeighborhoodArena
+	{
+	public:
+		NeighborhoodArena(){};
+		~NeighborhoodArena();
+
+		void *allocate(size_t bytes);
+		/** relinquish all memory handed out so far at once,
+		 * while the chunks are retained for reuse. */
+		void reset();
+		/** return all chunks to the system, when the neighbor data
+		 * has been packed elsewhere and no further build will follow. */
+		void release();
+		/** allocated bytes of all chunks, for memory accounting. */
+		size_t MemoryFootprint();
+
+	protected:
+		static constexpr size_t chunk_size_ = 1 << 22;
+		/** bump allocation state of one thread, chunks saved with their sizes */
+		struct ThreadChunks
+		{
+			size_t current_chunk_;
+			size_t allocated_in_chunk_;
+			StdVec<std::pair<char *, size_t>> chunks_;
+
+			ThreadChunks() : current_chunk_(0), allocated_in_chunk_(0){};
+		};
+		tbb::enumerable_thread_specific<ThreadChunks> thread_chunks_;
+	};
+
+	/**
+	 * @class NeighborhoodArenaAllocator
+	 * @brief An allocator placing neighbor vectors into a NeighborhoodArena,
+	 * and falling back on the heap when not bound to one.
+	 */
+	template <typename DataType>
+	class NeighborhoodArenaAllocator
+	{
+	public:
+		using value_type = DataType;
+		NeighborhoodArena *arena_;
+
+		NeighborhoodArenaAllocator() : arena_(nullptr){};
+		explicit NeighborhoodArenaAllocator(NeighborhoodArena *arena) : arena_(arena){};
+		template <typename OtherDataType>
+		NeighborhoodArenaAllocator(const NeighborhoodArenaAllocator<OtherDataType> &other)
+			: arena_(other.arena_){};
+
+		DataType *allocate(size_t n)
+		{
+			return arena_ != nullptr
+					   ? static_cast<DataType *>(arena_->allocate(n * sizeof(DataType)))
+					   : static_cast<DataType *>(::operator new(n * sizeof(DataType)));
+		};
+		void deallocate(DataType *p, size_t n)
+		{
+			// arena memory is relinquished by the bulk reset only
+			if (arena_ == nullptr)
+				::operator delete(p);
+		};
+		bool operator==(const NeighborhoodArenaAllocator &other) const { return arena_ == other.arena_; };
+		bool operator!=(const NeighborhoodArenaAllocator &other) const { return arena_ != other.arena_; };
+	};
+
+	/** neighbor data vector allocating from the arena when bound to one */
+	template <typename DataType>
+	using NeighborhoodVec = std::vector<DataType, NeighborhoodArenaAllocator<DataType>>;
+
 	/**
 	 * @class Neighborhood
 	 * @brief A neighborhood around particle i.
@@ -50,16 +131,49 @@ namespace SPH
 		size_t current_size_;	/**< the current number of neighors */
 		size_t allocated_size_; /**< the limit of neighors does not require memory allocation  */
 
-		StdLargeVec<size_t> j_;	  /**< index of the neighbor particle. */
-		StdLargeVec<Real> W_ij_;  /**< kernel value or particle volume contribution */
-		StdLargeVec<Real> dW_ij_; /**< derivative of kernel function or inter-particle surface contribution */
-		StdLargeVec<Real> r_ij_;  /**< distance between j and i. */
-		StdLargeVec<Vecd> e_ij_;  /**< unit vector pointing from j to i or inter-particle surface direction */
+		NeighborhoodVec<size_t> j_;	  /**< index of the neighbor particle. */
+		NeighborhoodVec<Real> W_ij_;  /**< kernel value or particle volume contribution */
+		NeighborhoodVec<Real> dW_ij_; /**< derivative of kernel function or inter-particle surface contribution */
+		NeighborhoodVec<Real> r_ij_;  /**< distance between j and i. */
+		NeighborhoodVec<Vecd> e_ij_;  /**< unit vector pointing from j to i or inter-particle surface direction */
+		/** kernel gradient vector dW_ij * e_ij, precomputed at the configuration
+		 * build on request, so that the interaction passes consuming the built
+		 * configuration read it instead of forming the product per pair. */
+		NeighborhoodVec<Vecd> dW_ij_e_ij_;
 
 		Neighborhood() : current_size_(0), allocated_size_(0){};
+		explicit Neighborhood(NeighborhoodArena *arena)
+			: current_size_(0), allocated_size_(0),
+			  j_(NeighborhoodArenaAllocator<size_t>(arena)),
+			  W_ij_(NeighborhoodArenaAllocator<Real>(arena)),
+			  dW_ij_(NeighborhoodArenaAllocator<Real>(arena)),
+			  r_ij_(NeighborhoodArenaAllocator<Real>(arena)),
+			  e_ij_(NeighborhoodArenaAllocator<Vecd>(arena)),
+			  dW_ij_e_ij_(NeighborhoodArenaAllocator<Vecd>(arena)){};
 		~Neighborhood(){};
 
 		void removeANeighbor(size_t neighbor_n);
+		/** grow the neighbor storage ahead of a configuration build,
+		 * so that the build itself does not allocate. */
+		void reserveStorage(size_t forecast_size, bool store_pair_geometry = true,
+							bool store_kernel_gradient = false);
+		/** release the storage beyond the forecast size in one pass.
+		 * The neighbor data is discarded, so this is only admissible
+		 * when the configuration is invalid anyway. */
+		void shrinkStorage(size_t forecast_size, bool store_pair_geometry = true,
+						   bool store_kernel_gradient = false);
+		/** release the neighbor storage entirely, after the neighbor data
+		 * has been packed into a sealed compressed-sparse-row arena. */
+		void releaseStorage();
+		/** allocated bytes of the neighbor storage, for memory accounting.
+		 * When the vectors are bound to an arena, their bytes are part of
+		 * the arena chunks and are accounted there instead. */
+		size_t MemoryFootprint() const
+		{
+			return j_.capacity() * sizeof(size_t) +
+				   (W_ij_.capacity() + dW_ij_.capacity() + r_ij_.capacity()) * sizeof(Real) +
+				   (e_ij_.capacity() + dW_ij_e_ij_.capacity()) * sizeof(Vecd);
+		};
 	};
 
 	/** Inner neighborhoods for all particles in a body for a inner body relation. */
@@ -67,6 +181,217 @@ namespace SPH
 	/** All contact neighborhoods for all particles in a body for a contact body relation. */
 	using ContactParticleConfiguration = StdVec<ParticleConfiguration>;
 
+	/**
+	 * @class CompactNeighborhood
+	 * @brief A neighborhood view into the flat arena of a CompactNeighborList.
+	 * It mirrors the member names and indexing of Neighborhood so that
+	 * interaction loops read neighbor data in the same way.
+	 */
+	class CompactNeighborhood
+	{
+	public:
+		size_t current_size_; /**< the current number of neighbors */
+
+		size_t *j_;			/**< index of the neighbor particle. */
+		Real *W_ij_;		/**< kernel value or particle volume contribution */
+		Real *dW_ij_;		/**< derivative of kernel function or inter-particle surface contribution */
+		Real *r_ij_;		/**< distance between j and i. */
+		Vecd *e_ij_;		/**< unit vector pointing from j to i or inter-particle surface direction */
+		Vecd *dW_ij_e_ij_;	/**< precomputed kernel gradient vector dW_ij * e_ij */
+
+		CompactNeighborhood()
+			: current_size_(0), j_(nullptr), W_ij_(nullptr),
+			  dW_ij_(nullptr), r_ij_(nullptr), e_ij_(nullptr),
+			  dW_ij_e_ij_(nullptr){};
+		~CompactNeighborhood(){};
+	};
+
+	/** Compact inner neighborhoods for all particles in a body for a inner body relation. */
+	using CompactParticleConfiguration = StdLargeVec<CompactNeighborhood>;
+
+	/**
+	 * @class CompactNeighborList
+	 * @brief Compressed-sparse-row storage for all neighborhoods of a body relation.
+	 * All neighbor entries live in contiguous arrays together with an offsets array,
+	 * so that neighbor traversal is a linear sweep without per-particle pointer chasing.
+	 */
+	class CompactNeighborList
+	{
+	public:
+		StdLargeVec<size_t> offsets_; /**< offset of the first neighbor of each particle, size is particle number plus one. */
+
+		StdLargeVec<size_t> j_;
+		StdLargeVec<Real> W_ij_;
+		StdLargeVec<Real> dW_ij_;
+		StdLargeVec<Real> r_ij_;
+		StdLargeVec<Vecd> e_ij_;
+		StdLargeVec<Vecd> dW_ij_e_ij_;
+
+		CompactNeighborList()
+			: pack_pair_geometry_(true), pack_kernel_gradient_(false),
+			  use_fixed_stride_(false), padding_waste_limit_(0.2), fixed_stride_(0){};
+		~CompactNeighborList(){};
+
+		/** leave the pair distance and direction out of the flat arena,
+		 * for relations recomputing them in the interaction loops. */
+		void skipPairGeometry() { pack_pair_geometry_ = false; };
+		/** switch on the fixed-stride (ELLPACK) packing mode: every particle
+		 * row is padded to one common stride, rounded up to a multiple of
+		 * eight, with zero-weight self pairs. The rows are then equally long
+		 * and equally spaced, which lets the compiler vectorize across the
+		 * pair dimension of the interaction loops. Worthwhile for bodies
+		 * with near-uniform neighbor counts, e.g. lattice-relaxed
+		 * total-Lagrangian solids; the packing falls back to the
+		 * compressed-sparse-row layout when the padded fraction of the
+		 * entries would exceed the given limit. */
+		void useFixedStride(Real padding_waste_limit = 0.2)
+		{
+			use_fixed_stride_ = true;
+			padding_waste_limit_ = padding_waste_limit;
+		};
+		/** the common row stride of the fixed-stride layout,
+		 * zero when the compressed-sparse-row layout is in use. */
+		size_t FixedStride() { return fixed_stride_; };
+		/** pack the precomputed kernel gradient vectors into the flat arena,
+		 * for relations built with the stored kernel gradient. */
+		void packKernelGradient() { pack_kernel_gradient_ = true; };
+		/** gather the scattered neighborhoods into the flat arena
+		 * and rebuild the per-particle views. */
+		void packConfiguration(const ParticleConfiguration &particle_configuration,
+							   size_t total_real_particles,
+							   CompactParticleConfiguration &compact_configuration);
+		/** allocated bytes of the flat arrays, for memory accounting. */
+		size_t MemoryFootprint() const
+		{
+			return (offsets_.capacity() + j_.capacity()) * sizeof(size_t) +
+				   (W_ij_.capacity() + dW_ij_.capacity() + r_ij_.capacity()) * sizeof(Real) +
+				   (e_ij_.capacity() + dW_ij_e_ij_.capacity()) * sizeof(Vecd);
+		};
+
+	protected:
+		bool pack_pair_geometry_;	/**< whether r_ij_ and e_ij_ are packed. */
+		bool pack_kernel_gradient_; /**< whether dW_ij_e_ij_ is packed. */
+		bool use_fixed_stride_;		/**< whether the fixed-stride layout is requested. */
+		Real padding_waste_limit_;	/**< padded entry fraction above which the packing falls back. */
+		size_t fixed_stride_;		/**< the chosen row stride, zero for compressed-sparse-row. */
+
+		/** pack the neighborhoods into equally long rows of the common stride,
+		 * padding short rows with zero-weight self pairs. */
+		void packConfigurationFixedStride(const ParticleConfiguration &particle_configuration,
+										  size_t total_real_particles,
+										  CompactParticleConfiguration &compact_configuration);
+	};
+
+	/**
+	 * @class RecomputedPairDistance
+	 * @brief A proxy indexed like the r_ij_ vector of a neighborhood,
+	 * computing the pair distance from the particle positions instead
+	 * of reading it from storage.
+	 */
+	template <class NeighborhoodType>
+	class RecomputedPairDistance
+	{
+		const NeighborhoodType &neighborhood_;
+		const StdLargeVec<Vecd> &pos_n_;
+		const Vecd &pos_i_;
+
+	public:
+		RecomputedPairDistance(const NeighborhoodType &neighborhood,
+							   const StdLargeVec<Vecd> &pos_n, const Vecd &pos_i)
+			: neighborhood_(neighborhood), pos_n_(pos_n), pos_i_(pos_i){};
+		Real operator[](size_t n) const
+		{
+			return (pos_i_ - pos_n_[neighborhood_.j_[n]]).norm();
+		};
+	};
+
+	/**
+	 * @class RecomputedPairDirection
+	 * @brief A proxy indexed like the e_ij_ vector of a neighborhood,
+	 * computing the unit vector pointing from j to i from the particle
+	 * positions instead of reading it from storage.
+	 */
+	template <class NeighborhoodType>
+	class RecomputedPairDirection
+	{
+		const NeighborhoodType &neighborhood_;
+		const StdLargeVec<Vecd> &pos_n_;
+		const Vecd &pos_i_;
+
+	public:
+		RecomputedPairDirection(const NeighborhoodType &neighborhood,
+								const StdLargeVec<Vecd> &pos_n, const Vecd &pos_i)
+			: neighborhood_(neighborhood), pos_n_(pos_n), pos_i_(pos_i){};
+		Vecd operator[](size_t n) const
+		{
+			Vecd displacement = pos_i_ - pos_n_[neighborhood_.j_[n]];
+			return displacement / (displacement.norm() + TinyReal);
+		};
+	};
+
+	/**
+	 * @class RecomputingNeighborhood
+	 * @brief A neighborhood view recomputing the pair distance and direction
+	 * from the particle positions on the fly. It mirrors the member names and
+	 * indexing of Neighborhood, so that interaction loops templated over the
+	 * neighborhood type work unchanged on a relation built without stored
+	 * pair geometry, trading a few operations per pair for about 40% less
+	 * neighbor memory traffic.
+	 */
+	template <class NeighborhoodType>
+	class RecomputingNeighborhood
+	{
+	public:
+		size_t current_size_; /**< the current number of neighbors */
+
+		const decltype(NeighborhoodType::j_) &j_;
+		const decltype(NeighborhoodType::W_ij_) &W_ij_;
+		const decltype(NeighborhoodType::dW_ij_) &dW_ij_;
+		RecomputedPairDistance<NeighborhoodType> r_ij_;
+		RecomputedPairDirection<NeighborhoodType> e_ij_;
+
+		RecomputingNeighborhood(const NeighborhoodType &neighborhood,
+								const StdLargeVec<Vecd> &pos_n, const Vecd &pos_i)
+			: current_size_(neighborhood.current_size_),
+			  j_(neighborhood.j_), W_ij_(neighborhood.W_ij_), dW_ij_(neighborhood.dW_ij_),
+			  r_ij_(neighborhood, pos_n, pos_i), e_ij_(neighborhood, pos_n, pos_i){};
+	};
+
+	/**
+	 * @class NeighborPrefetch
+	 * @brief Tunable distance for the software prefetch of gathered particle
+	 * data inside the interaction loops. The hardware prefetcher cannot
+	 * follow the indirection through the neighbor indices j_, so the loops
+	 * request the cache lines of upcoming neighbors a few iterations ahead.
+	 * Switched off by default with distance zero; a typical distance is
+	 * obtained from the micro-benchmarks.
+	 */
+	class NeighborPrefetch
+	{
+	public:
+		static void setDistance(size_t prefetch_distance) { prefetch_distance_ = prefetch_distance; };
+		static size_t Distance() { return prefetch_distance_; };
+
+	private:
+		static size_t prefetch_distance_;
+	};
+
+	/** request the cache line of a gathered value the tunable number of
+	 * neighbors ahead of the current position in the interaction loop */
+	template <class NeighborhoodType, class DataType>
+	inline void prefetchGatheredData(const NeighborhoodType &neighborhood, size_t n, const StdLargeVec<DataType> &data)
+	{
+		size_t ahead = n + NeighborPrefetch::Distance();
+		if (NeighborPrefetch::Distance() != 0 && ahead < neighborhood.current_size_)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(&data[neighborhood.j_[ahead]], 0, 1);
+#elif defined(_MSC_VER)
+			_mm_prefetch(reinterpret_cast<const char *>(&data[neighborhood.j_[ahead]]), _MM_HINT_T2);
+#endif
+		}
+	}
+
 	/**
 	 * @class NeighborRelation
 	 * @brief Base neighbor relation between particles i and j.
@@ -75,6 +400,8 @@ namespace SPH
 	{
 	protected:
 		Kernel *kernel_;
+		bool store_pair_geometry_;	 /**< whether r_ij_ and e_ij_ are stored per pair. */
+		bool store_kernel_gradient_; /**< whether dW_ij_e_ij_ is stored per pair. */
 		//----------------------------------------------------------------------
 		//	Below are for constant smoothing length.
 		//----------------------------------------------------------------------
@@ -91,8 +418,17 @@ namespace SPH
 								Vecd &displacement, size_t j_index, Real i_h_ratio, Real h_ratio_min) const;
 
 	public:
-		NeighborRelation() : kernel_(nullptr){};
+		NeighborRelation() : kernel_(nullptr), store_pair_geometry_(true),
+							 store_kernel_gradient_(false){};
 		virtual ~NeighborRelation(){};
+
+		/** build the relation without the pair distance and direction,
+		 * to be recomputed from the particle positions when interacting. */
+		void skipPairGeometry() { store_pair_geometry_ = false; };
+		/** build the relation with the precomputed kernel gradient vector,
+		 * paying the product dW_ij * e_ij once at the build instead of in
+		 * every interaction pass consuming the configuration. */
+		void storeKernelGradient() { store_kernel_gradient_ = true; };
 	};
 
 	/**
@@ -107,6 +443,96 @@ namespace SPH
 						Vecd &displacement, size_t i_index, size_t j_index) const;
 	};
 
+	/**
+	 * @class NeighborRelationInnerHalf
+	 * @brief An inner neighbor relation functor building a half list,
+	 * where each pair is stored only once, in the neighborhood of the
+	 * larger particle index. Symmetric interactions then compute each
+	 * kernel contribution once and scatter it to both particles.
+	 */
+	class NeighborRelationInnerHalf : public NeighborRelationInner
+	{
+	public:
+		explicit NeighborRelationInnerHalf(SPHBody *body) : NeighborRelationInner(body){};
+		void operator()(Neighborhood &neighborhood,
+						Vecd &displacement, size_t i_index, size_t j_index) const;
+	};
+
+	/**
+	 * @class NeighborRelationInnerWithSkin
+	 * @brief An inner neighbor relation functor with an enlarged cutoff radius.
+	 * Neighbors within the skin but outside the kernel support are stored
+	 * with zero weights so that they only become active, without a rebuild,
+	 * when the configuration is refreshed.
+	 */
+	class NeighborRelationInnerWithSkin : public NeighborRelationInner
+	{
+	public:
+		NeighborRelationInnerWithSkin(SPHBody *body, Real skin_distance);
+		void operator()(Neighborhood &neighborhood,
+						Vecd &displacement, size_t i_index, size_t j_index) const;
+
+	protected:
+		Real cutoff_radius_with_skin_;
+		Real cutoff_radius_with_skin_sqr_;
+	};
+
+	/**
+	 * @class NeighborRelationInnerKnownKernel
+	 * @brief An inner neighbor relation functor with the concrete kernel type
+	 * known at compile time. The kernel calls go through a typed pointer to a
+	 * final kernel class, so they are resolved statically and inlined into
+	 * the relation building instead of being dispatched per pair.
+	 */
+	template <class KernelType>
+	class NeighborRelationInnerKnownKernel : public NeighborRelationInner
+	{
+		KernelType *typed_kernel_;
+
+	public:
+		explicit NeighborRelationInnerKnownKernel(SPHBody *body)
+			: NeighborRelationInner(body),
+			  typed_kernel_(DynamicCast<KernelType>(this, kernel_)){};
+		void operator()(Neighborhood &neighborhood,
+						Vecd &displacement, size_t i_index, size_t j_index) const
+		{
+			Real distance = displacement.norm();
+			if (distance < typed_kernel_->CutOffRadius() && i_index != j_index)
+			{
+				Real dW_ij = typed_kernel_->dW(distance, displacement);
+				if (neighborhood.current_size_ >= neighborhood.allocated_size_)
+				{
+					neighborhood.j_.push_back(j_index);
+					neighborhood.W_ij_.push_back(typed_kernel_->W(distance, displacement));
+					neighborhood.dW_ij_.push_back(dW_ij);
+					if (store_pair_geometry_)
+					{
+						neighborhood.r_ij_.push_back(distance);
+						neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+					}
+					if (store_kernel_gradient_)
+						neighborhood.dW_ij_e_ij_.push_back(displacement * (dW_ij / (distance + TinyReal)));
+					neighborhood.allocated_size_++;
+				}
+				else
+				{
+					size_t current_size = neighborhood.current_size_;
+					neighborhood.j_[current_size] = j_index;
+					neighborhood.W_ij_[current_size] = typed_kernel_->W(distance, displacement);
+					neighborhood.dW_ij_[current_size] = dW_ij;
+					if (store_pair_geometry_)
+					{
+						neighborhood.r_ij_[current_size] = distance;
+						neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+					}
+					if (store_kernel_gradient_)
+						neighborhood.dW_ij_e_ij_[current_size] = displacement * (dW_ij / (distance + TinyReal));
+				}
+				neighborhood.current_size_++;
+			}
+		};
+	};
+
 	/**
 	 * @class NeighborRelationInnerVariableSmoothingLength
 	 * @brief A inner neighbor relation functor between particles i and j.
@@ -141,6 +567,9 @@ namespace SPH
 	/**
 	 * @class NeighborRelationContact
 	 * @brief A contact neighbor relation functor between particles i and j.
+	 * The kernel of the contact pair is resolved once at construction, to the
+	 * coarser one of the two bodies, and its cutoff radius is cached so that
+	 * the pair filtering does not go through the kernel per candidate.
 	 */
 	class NeighborRelationContact : public NeighborRelation
 	{
@@ -149,6 +578,68 @@ namespace SPH
 		virtual ~NeighborRelationContact(){};
 		void operator()(Neighborhood &neighborhood,
 						Vecd &displacement, size_t i_index, size_t j_index) const;
+
+	protected:
+		Real cutoff_radius_sqr_; /**< cached squared cutoff radius of the resolved kernel. */
+	};
+
+	/**
+	 * @class NeighborRelationContactKnownKernel
+	 * @brief A contact neighbor relation functor with the concrete type of the
+	 * resolved kernel known at compile time. As for the inner counterpart, the
+	 * kernel calls go through a typed pointer to a final kernel class, so the
+	 * kernel values of a pair are computed inline instead of being dispatched
+	 * virtually, which matters most for mixed-resolution contacts rebuilt
+	 * every step.
+	 */
+	template <class KernelType>
+	class NeighborRelationContactKnownKernel : public NeighborRelationContact
+	{
+		KernelType *typed_kernel_;
+
+	public:
+		NeighborRelationContactKnownKernel(SPHBody *body, SPHBody *contact_body)
+			: NeighborRelationContact(body, contact_body),
+			  typed_kernel_(DynamicCast<KernelType>(this, kernel_)){};
+		void operator()(Neighborhood &neighborhood,
+						Vecd &displacement, size_t i_index, size_t j_index) const
+		{
+			Real distance_sqr = displacement.normSqr();
+			if (distance_sqr < cutoff_radius_sqr_)
+			{
+				Real distance = std::sqrt(distance_sqr);
+				Real dW_ij = typed_kernel_->dW(distance, displacement);
+				if (neighborhood.current_size_ >= neighborhood.allocated_size_)
+				{
+					neighborhood.j_.push_back(j_index);
+					neighborhood.W_ij_.push_back(typed_kernel_->W(distance, displacement));
+					neighborhood.dW_ij_.push_back(dW_ij);
+					if (store_pair_geometry_)
+					{
+						neighborhood.r_ij_.push_back(distance);
+						neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+					}
+					if (store_kernel_gradient_)
+						neighborhood.dW_ij_e_ij_.push_back(displacement * (dW_ij / (distance + TinyReal)));
+					neighborhood.allocated_size_++;
+				}
+				else
+				{
+					size_t current_size = neighborhood.current_size_;
+					neighborhood.j_[current_size] = j_index;
+					neighborhood.W_ij_[current_size] = typed_kernel_->W(distance, displacement);
+					neighborhood.dW_ij_[current_size] = dW_ij;
+					if (store_pair_geometry_)
+					{
+						neighborhood.r_ij_[current_size] = distance;
+						neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+					}
+					if (store_kernel_gradient_)
+						neighborhood.dW_ij_e_ij_[current_size] = displacement * (dW_ij / (distance + TinyReal));
+				}
+				neighborhood.current_size_++;
+			}
+		};
 	};
 
 	/**
@@ -14,29 +14,214 @@ namespace SPH
 {
 	//=================================================================================================//
 	SwapSortableParticleData::SwapSortableParticleData(BaseParticles *base_particles)
-		: sequence_(base_particles->sequence_),
+		: base_particles_(base_particles),
+		  sequence_(base_particles->sequence_),
 		  unsorted_id_(base_particles->unsorted_id_),
 		  sortable_data_(base_particles->sortable_data_) {}
 	//=================================================================================================//
+	void SwapSortableParticleData::prepareSequenceSwaps(size_t size)
+	{
+		order_.resize(size);
+		order_buffer_.resize(size);
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					order_[i] = i;
+				}
+			},
+			ap);
+	}
+	//=================================================================================================//
 	void SwapSortableParticleData::operator()(size_t *a, size_t *b)
 	{
 		std::swap(*a, *b);
 
 		size_t index_a = a - sequence_.data();
 		size_t index_b = b - sequence_.data();
-		std::swap(unsorted_id_[index_a], unsorted_id_[index_b]);
-		swap_particle_data_value_(sortable_data_, index_a, index_b);
+		std::swap(order_[index_a], order_[index_b]);
+	}
+	//=================================================================================================//
+	void SwapSortableParticleData::applyPermutation(size_t size)
+	{
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					order_buffer_[i] = unsorted_id_[order_[i]];
+				}
+			},
+			ap);
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					unsorted_id_[i] = order_buffer_[i];
+				}
+			},
+			ap);
+		gather_particle_data_value_(sortable_data_, order_, size, base_particles_->scratch_buffers_);
+	}
+	//=================================================================================================//
+	MortonRadixSort::MortonRadixSort(BaseParticles *base_particles)
+		: base_particles_(base_particles) {}
+	//=================================================================================================//
+	void MortonRadixSort::sortKeys(size_t size)
+	{
+		size_t max_key = parallel_reduce(
+			blocked_range<size_t>(0, size), size_t(0),
+			[&](const blocked_range<size_t> &r, size_t temp) -> size_t
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					temp = SMAX(temp, keys_[i]);
+				}
+				return temp;
+			},
+			[](size_t x, size_t y) -> size_t
+			{ return SMAX(x, y); });
+
+		size_t chunks = (size + chunk_size_ - 1) / chunk_size_;
+		histograms_.resize(chunks * buckets_);
+		for (size_t shift = 0; max_key >> shift != 0; shift += radix_bits_)
+		{
+			std::fill(histograms_.begin(), histograms_.end(), 0);
+			parallel_for(
+				blocked_range<size_t>(0, chunks, 1),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t c = r.begin(); c != r.end(); ++c)
+					{
+						size_t *histogram = histograms_.data() + c * buckets_;
+						size_t chunk_end = SMIN((c + 1) * chunk_size_, size);
+						for (size_t i = c * chunk_size_; i != chunk_end; ++i)
+						{
+							++histogram[(keys_[i] >> shift) & (buckets_ - 1)];
+						}
+					}
+				});
+
+			// exclusive prefix sum in digit-major order gives each chunk its write offsets
+			size_t sum = 0;
+			for (size_t digit = 0; digit != buckets_; ++digit)
+			{
+				for (size_t c = 0; c != chunks; ++c)
+				{
+					size_t count = histograms_[c * buckets_ + digit];
+					histograms_[c * buckets_ + digit] = sum;
+					sum += count;
+				}
+			}
+
+			parallel_for(
+				blocked_range<size_t>(0, chunks, 1),
+				[&](const blocked_range<size_t> &r)
+				{
+					for (size_t c = r.begin(); c != r.end(); ++c)
+					{
+						size_t *offsets = histograms_.data() + c * buckets_;
+						size_t chunk_end = SMIN((c + 1) * chunk_size_, size);
+						for (size_t i = c * chunk_size_; i != chunk_end; ++i)
+						{
+							size_t position = offsets[(keys_[i] >> shift) & (buckets_ - 1)]++;
+							keys_buffer_[position] = keys_[i];
+							order_buffer_[position] = order_[i];
+						}
+					}
+				});
+
+			keys_.swap(keys_buffer_);
+			order_.swap(order_buffer_);
+		}
+	}
+	//=================================================================================================//
+	void MortonRadixSort::applyPermutation(size_t *begin, size_t size)
+	{
+		StdLargeVec<size_t> &unsorted_id = base_particles_->unsorted_id_;
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					begin[i] = keys_[i];
+					order_buffer_[i] = unsorted_id[order_[i]];
+				}
+			},
+			ap);
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					unsorted_id[i] = order_buffer_[i];
+				}
+			},
+			ap);
+		gather_particle_data_value_(base_particles_->sortable_data_, order_, size, base_particles_->scratch_buffers_);
+	}
+	//=================================================================================================//
+	void MortonRadixSort::sort(size_t *begin, size_t size)
+	{
+		keys_.resize(size);
+		keys_buffer_.resize(size);
+		order_.resize(size);
+		order_buffer_.resize(size);
+		parallel_for(
+			blocked_range<size_t>(0, size),
+			[&](const blocked_range<size_t> &r)
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					keys_[i] = begin[i];
+					order_[i] = i;
+				}
+			},
+			ap);
+
+		sortKeys(size);
+		applyPermutation(begin, size);
 	}
 	//=================================================================================================//
 	ParticleSorting::ParticleSorting(RealBody *real_body)
-		: base_particles_(nullptr), swap_sortable_particle_data_(nullptr), compare_(),
+		: base_particles_(nullptr), use_radix_sort_(true), audit_unsorted_variables_(false),
+		  morton_radix_sort_(nullptr),
+		  swap_sortable_particle_data_(nullptr), compare_(),
 		  quick_sort_particle_range_(nullptr), quick_sort_particle_body_() {}
 	//=================================================================================================//
 	void ParticleSorting::sortingParticleData(size_t *begin, size_t size)
 	{
-		quick_sort_particle_range_->begin_ = begin;
-		quick_sort_particle_range_->size_ = size;
-		parallel_for(*quick_sort_particle_range_, quick_sort_particle_body_, ap);
+		if (audit_unsorted_variables_)
+		{
+			audit_unsorted_variables_ = false;
+			StdVec<std::string> unsorted_variables = base_particles_->unsortedVariablesReport();
+			for (size_t l = 0; l != unsorted_variables.size(); ++l)
+			{
+				std::cout << "\n Warning: the variable '" << unsorted_variables[l]
+						  << "' is not sortable and decorrelates from the particle memory order after sorting."
+						  << std::endl;
+			}
+		}
+
+		if (use_radix_sort_)
+		{
+			morton_radix_sort_->sort(begin, size);
+		}
+		else
+		{
+			swap_sortable_particle_data_->prepareSequenceSwaps(size);
+			quick_sort_particle_range_->begin_ = begin;
+			quick_sort_particle_range_->size_ = size;
+			parallel_for(*quick_sort_particle_range_, quick_sort_particle_body_, ap);
+			swap_sortable_particle_data_->applyPermutation(size);
+		}
 		updateSortedId();
 	}
 	//=================================================================================================//
@@ -60,6 +245,7 @@ namespace SPH
 	void ParticleSorting::assignBaseParticles(BaseParticles *base_particles)
 	{
 		base_particles_ = base_particles;
+		morton_radix_sort_ = morton_radix_sort_ptr_keeper_.createPtr<MortonRadixSort>(base_particles);
 		swap_sortable_particle_data_ = swap_particle_ptr_keeper_.createPtr<SwapSortableParticleData>(base_particles);
 		size_t *begin = base_particles_->sequence_.data();
 		quick_sort_particle_range_ =
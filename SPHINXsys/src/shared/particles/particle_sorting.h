@@ -222,24 +222,66 @@ namespace SPH
 
 	/**
 	 * @class SwapSortableParticleData
-	 * @brief swap sortable particle data according to a sequence
+	 * @brief swap sortable particle data according to a sequence.
+	 * The data movement is decoupled from the sort: each comparison-sort swap
+	 * only exchanges the sequence key and an entry of the permutation under
+	 * construction, and the permutation is applied to the sortable variables
+	 * afterwards with one streaming gather pass per variable, so that the sort
+	 * itself costs the same regardless of the number of sortable variables.
 	 */
 	class SwapSortableParticleData
 	{
 	protected:
+		BaseParticles *base_particles_;
 		StdLargeVec<size_t> &sequence_;
 		StdLargeVec<size_t> &unsorted_id_;
 		ParticleData &sortable_data_;
-		ParticleDataOperation<swapParticleDataValue> swap_particle_data_value_;
+		StdLargeVec<size_t> order_, order_buffer_; /**< permutation under construction, sorted position to original position. */
+		ParticleDataOperation<gatherParticleDataValue> gather_particle_data_value_;
 
 	public:
 		explicit SwapSortableParticleData(BaseParticles *base_particles);
 		~SwapSortableParticleData(){};
 
+		/** reset the permutation to identity before a sort. */
+		void prepareSequenceSwaps(size_t size);
 		/** the operater overload for swapping particle data.
 		 *  the arguments are the same with std::iter_swap
 		 */
 		void operator()(size_t *a, size_t *b);
+		/** rearrange the sortable variables according to the sorted permutation. */
+		void applyPermutation(size_t size);
+	};
+
+	/**
+	 * @class MortonRadixSort
+	 * @brief Parallel least-significant-digit radix sort on the Morton-code sequence.
+	 * The keys are sorted into a permutation with per-chunk digit histograms,
+	 * and the permutation is then applied to every sortable particle variable
+	 * with one cache-streaming gather pass per variable.
+	 */
+	class MortonRadixSort
+	{
+	protected:
+		static const size_t radix_bits_ = 8;
+		static const size_t buckets_ = size_t(1) << radix_bits_;
+		static const size_t chunk_size_ = size_t(1) << 16;
+
+		BaseParticles *base_particles_;
+		StdLargeVec<size_t> keys_, keys_buffer_;   /**< Morton keys during the digit passes. */
+		StdLargeVec<size_t> order_, order_buffer_; /**< permutation under construction, sorted position to original position. */
+		StdLargeVec<size_t> histograms_;		   /**< per-chunk digit histograms. */
+		ParticleDataOperation<gatherParticleDataValue> gather_particle_data_value_;
+
+		void sortKeys(size_t size);
+		void applyPermutation(size_t *begin, size_t size);
+
+	public:
+		explicit MortonRadixSort(BaseParticles *base_particles);
+		~MortonRadixSort(){};
+
+		/** sorting the sequence array and rearranging the particle data accordingly */
+		void sort(size_t *begin, size_t size);
 	};
 
 	/**
@@ -253,9 +295,14 @@ namespace SPH
 		UniquePtrKeeper<
 			tbb::interafce9::internal::QuickSortParticleRange<size_t *, CompareParticleSequence, SwapSortableParticleData>>
 			quick_sort_particle_range_ptr_keeper_;
+		UniquePtrKeeper<MortonRadixSort> morton_radix_sort_ptr_keeper_;
 
 	protected:
 		BaseParticles *base_particles_;
+		bool use_radix_sort_; /**< sorting with the radix sort instead of the comparison sort. */
+		bool audit_unsorted_variables_; /**< whether the first sort reports the non-sortable variables. */
+		/** using pointer because it is constructed after particles. */
+		MortonRadixSort *morton_radix_sort_;
 
 		/** using pointer because it is constructed after particles. */
 		SwapSortableParticleData *swap_sortable_particle_data_;
@@ -272,6 +319,10 @@ namespace SPH
 		virtual ~ParticleSorting(){};
 
 		void assignBaseParticles(BaseParticles *base_particles);
+		/** falling back to the comparison sort, e.g. for nearly sorted sequences */
+		void useQuickSort() { use_radix_sort_ = false; };
+		/** report once, at the next sort, the registered variables which are not sortable */
+		void useUnsortedVariablesAudit() { audit_unsorted_variables_ = true; };
 		/** sorting particle data according to the cell location of particles */
 		virtual void sortingParticleData(size_t *begin, size_t size);
 		/** update the reference of sorted data from unsorted data */
@@ -226,6 +226,8 @@ namespace SPH
 		registerAVariable(rotation_, "Rotation");
 		registerAVariable(angular_vel_, "AngularVelocity");
 		registerAVariable(dangular_vel_dt_, "AngularAcceleration");
+		registerAVariable(rotation_sine_, "RotationSine");
+		registerAVariable(rotation_cosine_, "RotationCosine", Vecd(1.0));
 		registerAVariable(F_bending_, "BendingDeformationGradient");
 		registerAVariable(dF_bending_dt_, "BendingDeformationGradientChangeRate");
 		registerAVariable(global_shear_stress_, "GlobalShearStress");
@@ -165,6 +165,8 @@ namespace SPH
 		StdLargeVec<Vecd> rotation_;		/**< rotation angle of the initial normal respective to each axis */
 		StdLargeVec<Vecd> angular_vel_;		/**< angular velocity respective to each axis */
 		StdLargeVec<Vecd> dangular_vel_dt_; /**< angular accelration of respective to each axis*/
+		StdLargeVec<Vecd> rotation_sine_;	/**< cached sine of the rotation angles, refreshed in batch per substep */
+		StdLargeVec<Vecd> rotation_cosine_; /**< cached cosine of the rotation angles, refreshed in batch per substep */
 		//----------------------------------------------------------------------
 		//	extra deformation and deformation rate in local coordinate
 		//----------------------------------------------------------------------
@@ -43,11 +43,26 @@ namespace SPH
     NormalDirectionFromBodyShape::
         NormalDirectionFromBodyShape(SPHBody &sph_body)
         : SolidDataSimple(sph_body), body_shape_(*sph_body.body_shape_),
+          level_set_shape_(dynamic_cast<LevelSetShape *>(sph_body.body_shape_)),
           pos_n_(particles_->pos_n_), n_(particles_->n_), n_0_(particles_->n_0_) {}
     //=============================================================================================//
+    void NormalDirectionFromBodyShape::setupDynamics(Real dt)
+    {
+        if (level_set_shape_ == nullptr)
+            return;
+
+        size_t total_real_particles = particles_->total_real_particles_;
+        probe_positions_.resize(total_real_particles);
+        for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+            probe_positions_[index_i] = pos_n_[index_i];
+        level_set_shape_->findNormalDirections(probe_positions_, probed_normals_);
+    }
+    //=============================================================================================//
     void NormalDirectionFromBodyShape::update(size_t index_i, Real dt)
     {
-        Vecd normal_direction = body_shape_.findNormalDirection(pos_n_[index_i]);
+        Vecd normal_direction = level_set_shape_ != nullptr
+                                    ? probed_normals_[index_i]
+                                    : body_shape_.findNormalDirection(pos_n_[index_i]);
         n_[index_i] = normal_direction;
         n_0_[index_i] = normal_direction;
     }
@@ -57,12 +72,27 @@ namespace SPH
         : SolidDataSimple(sph_body),
           shape_and_op_(DynamicCast<ComplexShape>(this, sph_body.body_shape_)->getShapeAndOpByName(shape_name)),
           shape_(shape_and_op_->first),
+          level_set_shape_(dynamic_cast<LevelSetShape *>(shape_and_op_->first)),
           switch_sign_(shape_and_op_->second == ShapeBooleanOps::add ? 1.0 : -1.0),
           pos_n_(particles_->pos_n_), n_(particles_->n_), n_0_(particles_->n_0_) {}
     //=============================================================================================//
+    void NormalDirectionFromShapeAndOp::setupDynamics(Real dt)
+    {
+        if (level_set_shape_ == nullptr)
+            return;
+
+        size_t total_real_particles = particles_->total_real_particles_;
+        probe_positions_.resize(total_real_particles);
+        for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+            probe_positions_[index_i] = pos_n_[index_i];
+        level_set_shape_->findNormalDirections(probe_positions_, probed_normals_);
+    }
+    //=============================================================================================//
     void NormalDirectionFromShapeAndOp::update(size_t index_i, Real dt)
     {
-        Vecd normal_direction = switch_sign_ * shape_->findNormalDirection(pos_n_[index_i]);
+        Vecd normal_direction = level_set_shape_ != nullptr
+                                    ? switch_sign_ * probed_normals_[index_i]
+                                    : switch_sign_ * shape_->findNormalDirection(pos_n_[index_i]);
         n_[index_i] = normal_direction;
         n_0_[index_i] = normal_direction;
     }
@@ -32,6 +32,7 @@
 
 #include "particle_dynamics_algorithms.h"
 #include "body_relation.h"
+#include "level_set_shape.h"
 #include "solid_body.h"
 #include "solid_particles.h"
 
@@ -91,36 +92,45 @@ namespace SPH
 
 	/**
 	 * @class NormalDirectionFromBodyShape
-	 * @brief normal direction at particles
+	 * @brief normal direction at particles.
+	 * Against a level-set shape the normals are answered by the batched
+	 * probe in the setup, so the per-particle update is a plain copy
+	 * instead of an independent mesh walk for each particle.
 	 */
 	class NormalDirectionFromBodyShape : public SolidDataSimple
 	{
 	public:
 		explicit NormalDirectionFromBodyShape(SPHBody &sph_body);
 		virtual ~NormalDirectionFromBodyShape(){};
+		void setupDynamics(Real dt = 0.0);
 		void update(size_t index_i, Real dt = 0.0);
 
 	protected:
 		Shape &body_shape_;
+		LevelSetShape *level_set_shape_; /**< non-null if the body shape answers batched probes. */
 		StdLargeVec<Vecd> &pos_n_, &n_, &n_0_;
+		StdLargeVec<Vecd> probe_positions_, probed_normals_;
 	};
 	
 	/**
-	 * @class NormalDirectionFromBodyShape
-	 * @brief normal direction at particles
+	 * @class NormalDirectionFromShapeAndOp
+	 * @brief normal direction at particles, batched as above.
 	 */
 	class NormalDirectionFromShapeAndOp : public SolidDataSimple
 	{
 	public:
 		explicit NormalDirectionFromShapeAndOp(SPHBody &sph_body, const std::string &shape_name);
 		virtual ~NormalDirectionFromShapeAndOp(){};
+		void setupDynamics(Real dt = 0.0);
 		void update(size_t index_i, Real dt = 0.0);
 
 	protected:
 		ShapeAndOp *shape_and_op_;
 		Shape *shape_;
+		LevelSetShape *level_set_shape_; /**< non-null if the shape answers batched probes. */
 		const Real switch_sign_;
 		StdLargeVec<Vecd> &pos_n_, &n_, &n_0_;
+		StdLargeVec<Vecd> probe_positions_, probed_normals_;
 	};
 
 	//----------------------------------------------------------------------
@@ -36,32 +36,56 @@ namespace SPH
 	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
+	Real RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateLocalDTWDistance
+	(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b)
+	{
+		int window_size_ = dtw_band_width_;
+		int a_length = series_a.size();
+		int b_length = series_b.size();
+		/** create a 2D vector with [a_length, b_length] to contain the local DTW distance value. */
+		DoubleVec<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
+		local_dtw_distance[0][0] = calculatePNorm(series_a[0], series_b[0]);
+		for (int index_i = 1; index_i < a_length; ++index_i)
+			local_dtw_distance[index_i][0] = local_dtw_distance[index_i - 1][0] + calculatePNorm(series_a[index_i], series_b[0]);
+		for (int index_j = 1; index_j < b_length; ++index_j)
+			local_dtw_distance[0][index_j] = local_dtw_distance[0][index_j - 1] + calculatePNorm(series_a[0], series_b[index_j]);
+
+		/** add locality constraint */
+		window_size_ = SMAX(window_size_, ABS(a_length - b_length));
+		for (int index_i = 1; index_i != a_length; ++index_i)
+			for (int index_j = SMAX(1, index_i - window_size_); index_j != SMIN(b_length, index_i + window_size_); ++index_j)
+				local_dtw_distance[index_i][index_j] = calculatePNorm(series_a[index_i], series_b[index_j]) +
+					SMIN(local_dtw_distance[index_i - 1][index_j], local_dtw_distance[index_i][index_j - 1], local_dtw_distance[index_i - 1][index_j - 1]);
+		return local_dtw_distance[a_length - 1][b_length - 1];
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	Real RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateDiagonalUpperBound
+	(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b)
+	{
+		/* the diagonal path extended along the last sample of the shorter series
+		   is a valid banded warping path, so its cost bounds the dtw distance from above. */
+		int a_length = series_a.size();
+		int b_length = series_b.size();
+		int shared_length = SMIN(a_length, b_length);
+		Real upper_bound_distance = 0;
+		for (int index = 0; index != shared_length; ++index)
+			upper_bound_distance += calculatePNorm(series_a[index], series_b[index]);
+		for (int index = shared_length; index < a_length; ++index)
+			upper_bound_distance += calculatePNorm(series_a[index], series_b[b_length - 1]);
+		for (int index = shared_length; index < b_length; ++index)
+			upper_bound_distance += calculatePNorm(series_a[a_length - 1], series_b[index]);
+		return upper_bound_distance;
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
 	StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateDTWDistance
 	(DoubleVec<VariableType> dataset_a_, DoubleVec<VariableType> dataset_b_)
 	{
 		/* define the container to hold the dtw distance.*/
 		StdVec<Real> dtw_distance;
 		for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
-		{
-			int window_size_ = 5;
-			int a_length = dataset_a_[observation_index].size();
-			int b_length = dataset_b_[observation_index].size();
-			/** create a 2D vector with [a_length, b_length] to contain the local DTW distance value. */
-			DoubleVec<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
-			local_dtw_distance[0][0] = calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][0]);
-			for (int index_i = 1; index_i < a_length; ++index_i)
-				local_dtw_distance[index_i][0] = local_dtw_distance[index_i - 1][0] + calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][0]);
-			for (int index_j = 1; index_j < b_length; ++index_j)
-				local_dtw_distance[0][index_j] = local_dtw_distance[0][index_j - 1] + calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][index_j]);
-
-			/** add locality constraint */
-			window_size_ = SMAX(window_size_, ABS(a_length - b_length));
-			for (int index_i = 1; index_i != a_length; ++index_i)
-				for (int index_j = SMAX(1, index_i - window_size_); index_j != SMIN(b_length, index_i + window_size_); ++index_j)
-					local_dtw_distance[index_i][index_j] = calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][index_j]) +
-						SMIN(local_dtw_distance[index_i - 1][index_j], local_dtw_distance[index_i][index_j - 1], local_dtw_distance[index_i - 1][index_j - 1]);
-			dtw_distance.push_back(local_dtw_distance[a_length - 1][b_length - 1]);
-		}
+			dtw_distance.push_back(calculateLocalDTWDistance(dataset_a_[observation_index], dataset_b_[observation_index]));
 		return dtw_distance;
 	};
 	//=================================================================================================//
@@ -105,12 +129,16 @@ namespace SPH
 	{
 		if (this->number_of_run_ > 1)
 		{
-			StdVec<Real> dtw_distance_local_(this->observation_, 0);
-			dtw_distance_local_ = calculateDTWDistance(this->current_result_trans_, this->result_in_);
 			for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
 			{
-				dtw_distance_new_[observation_index] = SMAX(dtw_distance_local_[observation_index], dtw_distance_[observation_index], dtw_distance_new_[observation_index]);
-			}	
+				Real dtw_distance_obtained_ = SMAX(dtw_distance_[observation_index], dtw_distance_new_[observation_index]);
+				if (use_bounded_dtw_pruning_ &&
+					calculateDiagonalUpperBound(this->current_result_trans_[observation_index],
+						this->result_in_[observation_index]) <= dtw_distance_obtained_)
+					continue; /* this pair cannot raise the recorded maximum distance. */
+				dtw_distance_new_[observation_index] = SMAX(dtw_distance_obtained_,
+					calculateLocalDTWDistance(this->current_result_trans_[observation_index], this->result_in_[observation_index]));
+			}
 			this->result_in_.clear();
 		}
 	};
@@ -175,10 +203,26 @@ namespace SPH
 	void RegressionTestDynamicTimeWarping<ObserveMethodType>::resultTest()
 	{
 		int test_wrong = 0;
-		StdVec<Real> dtw_distance_current_;
-		dtw_distance_current_ = calculateDTWDistance(this->result_in_, this->current_result_trans_);
+		StdVec<Real> dtw_distance_current_(this->observation_, 0);
 		for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
 		{
+			if (use_bounded_dtw_pruning_)
+			{
+				/* the stored value is a bound rather than the exact distance when the bound
+				   alone already decides the comparison against the recorded maximum. Only
+				   the upper bound may decide: it majorizes the exact distance, so a pass is
+				   safe, while a lower bound cannot soundly declare failure against the
+				   band-restricted recurrence. */
+				Real upper_bound_ = calculateDiagonalUpperBound(this->result_in_[observation_index], this->current_result_trans_[observation_index]);
+				dtw_distance_current_[observation_index] = upper_bound_ <= 1.01 * dtw_distance_[observation_index]
+					? upper_bound_
+					: calculateLocalDTWDistance(this->result_in_[observation_index], this->current_result_trans_[observation_index]);
+			}
+			else
+			{
+				dtw_distance_current_[observation_index] =
+					calculateLocalDTWDistance(this->result_in_[observation_index], this->current_result_trans_[observation_index]);
+			}
 			if (dtw_distance_current_[observation_index] > 1.01 * dtw_distance_[observation_index])
 			{
 				std::cout << "The maximum distance of " << this->quantity_name_ << "[" << observation_index << "] is " << dtw_distance_[observation_index] 
@@ -51,11 +51,19 @@ namespace SPH
 
 		StdVec<Real> dtw_distance_, dtw_distance_new_;             /* the container of DTW distance between each pairs. */
 
+		int dtw_band_width_;                                       /* the half width of the Sakoe-Chiba band. */
+		bool use_bounded_dtw_pruning_;                             /* if true, a cheap upper bound skips the exact DTW when conclusive. */
+
 		/** the method used for calculating the p_norm. (calculateDTWDistance) */
 		Real calculatePNorm(Real variable_a, Real variable_b);
 		Real calculatePNorm(Vecd variable_a, Vecd variable_b);
 		Real calculatePNorm(Matd variable_a, Matd variable_b);
 
+		/** the banded dtw distance between two single-observation histories. */
+		Real calculateLocalDTWDistance(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b);
+		/** the upper bound of the banded dtw distance given by the diagonal warping path. */
+		Real calculateDiagonalUpperBound(const StdVec<VariableType> &series_a, const StdVec<VariableType> &series_b);
+
 		/** the local constrained method used for calculating the dtw distance between two lines. */
 		StdVec<Real> calculateDTWDistance(DoubleVec<VariableType> dataset_a_, DoubleVec<VariableType> dataset_b_);
 
@@ -64,13 +72,20 @@ namespace SPH
 		explicit RegressionTestDynamicTimeWarping(ConstructorArgs &&...args) :
 			RegressionTestTimeAveraged<ObserveMethodType>(std::forward<ConstructorArgs>(args)...),
 			dtw_distance_xml_engine_in_("dtw_distance_xml_engine_in", "dtw_distance"),
-			dtw_distance_xml_engine_out_("dtw_distance_xml_engine_out", "dtw_distance")
+			dtw_distance_xml_engine_out_("dtw_distance_xml_engine_out", "dtw_distance"),
+			dtw_band_width_(5), use_bounded_dtw_pruning_(false)
 		{
 			dtw_distance_filefullpath_ = this->input_folder_path_ + "/" + this->body_name_ + "_"
 				+ this->quantity_name_ + "_dtwdistance.xml";
 		};
 		virtual ~RegressionTestDynamicTimeWarping() {};
 
+		/** set the half width of the Sakoe-Chiba band constraining the warping path. */
+		void setDTWBandWidth(int band_width) { dtw_band_width_ = band_width; };
+		/** decide each comparison by the diagonal-path upper bound when possible, and
+		 * fall back to the exact banded dtw only when the bound is inconclusive. */
+		void useBoundedDTWPruning() { use_bounded_dtw_pruning_ = true; };
+
 		void settingupTheTest(); /** setup the test and defined basic variables. */
 		void readDTWDistanceFromXml(); /** read the old DTW distance from the .xml file. */
 		void updateDTWDistance(); /** update the maximum DTWDistance with the new result. */
@@ -117,7 +132,8 @@ namespace SPH
 			for (int n = 0; n != this->number_of_run_; ++n)
 			{
 				this->result_filefullpath_ = this->input_folder_path_ + "/" + this->body_name_
-					+ "_" + this->quantity_name_ + "_Run_" + std::to_string(n) + "_result.xml";
+					+ "_" + this->quantity_name_ + "_Run_" + std::to_string(n)
+					+ (this->use_binary_result_format_ ? "_result.bin" : "_result.xml");
 				if (!fs::exists(this->result_filefullpath_))
 				{
 					std::cout << "This result has not been preserved and will not be compared." << endl;
@@ -48,7 +48,18 @@ namespace SPH
 	protected:
 		DoubleVec<VariableType> meanvalue_, meanvalue_new_;  /* the container of (new) meanvalue. [different from time-averaged]*/
 		DoubleVec<VariableType> variance_, variance_new_;    /* the container of (new) variance. [different from time-averaged]*/
-		
+		DoubleVec<VariableType> second_moment_, second_moment_new_; /* the container of the (new) second moment of the running
+															statistics, i.e. the summed squared deviation from the meanvalue.
+															[incremental statistics only]*/
+
+		bool use_incremental_statistics_;  /* if true, the meanvalue and variance are updated from the running
+											  moments and the new run only, without reloading the result history. */
+
+		/** the method used for updating the running moments and the variance from the new run only. */
+		void updateMomentsIncremental(DoubleVec<Real> &current_result, DoubleVec<Real> &meanvalue_new, DoubleVec<Real> &second_moment_new, DoubleVec<Real> &variance_new);
+		void updateMomentsIncremental(DoubleVec<Vecd> &current_result, DoubleVec<Vecd> &meanvalue_new, DoubleVec<Vecd> &second_moment_new, DoubleVec<Vecd> &variance_new);
+		void updateMomentsIncremental(DoubleVec<Matd> &current_result, DoubleVec<Matd> &meanvalue_new, DoubleVec<Matd> &second_moment_new, DoubleVec<Matd> &variance_new);
+
 		/** the method used for calculating the new variance. */
 		void calculateNewVariance(TripleVec<Real> &result, DoubleVec<Real> &meanvalue_new, DoubleVec<Real> &variance, DoubleVec<Real> &variance_new);
 		void calculateNewVariance(TripleVec<Vecd> &result, DoubleVec<Vecd> &meanvalue_new, DoubleVec<Vecd> &variance, DoubleVec<Vecd> &variance_new);
@@ -69,11 +80,19 @@ namespace SPH
 		explicit RegressionTestEnsembleAveraged(ConstructorArgs &&...args) :
 			RegressionTestTimeAveraged<ObserveMethodType>(std::forward<ConstructorArgs>(args)...)
 		{
-			this->mean_variance_filefullpath_ = this->input_folder_path_ + "/" + this->body_name_ 
+			this->mean_variance_filefullpath_ = this->input_folder_path_ + "/" + this->body_name_
 				+ "_" + this->quantity_name_ + "_ensemble_averaged_mean_variance.xml";
+			use_incremental_statistics_ = false;
 		};
 		virtual ~RegressionTestEnsembleAveraged() {};
 
+		/** update the meanvalue and variance from the running moments and the new run only.
+		 * The run count, the meanvalue and the second moment are stored in the mean and variance
+		 * file as running moments, so the update cost is independent of the ensemble size and the
+		 * result history of the previous runs is neither reloaded nor rewritten.
+		 * The mode is to be selected before the first run generating the database. */
+		void useIncrementalStatistics() { use_incremental_statistics_ = true; };
+
 		void settingupAndCorrection(); /** setup and correct the number of old and new result. */
 		void readMeanVarianceFromXml(); /** read the meanvalue and variance from the .xml file. */
 		void updateMeanVariance(); /** update the meanvalue and variance from new result. */
@@ -90,12 +109,14 @@ namespace SPH
 			if (this->converged == "false")
 			{
 				settingupAndCorrection();
-				this->readResultFromXml();
+				if (!use_incremental_statistics_)
+					this->readResultFromXml();
 				if (filter == "true")
 					this->filterExtremeValues();
 				readMeanVarianceFromXml();
 				updateMeanVariance();
-				this->writeResultToXml();
+				if (!use_incremental_statistics_)
+					this->writeResultToXml();
 				writeMeanVarianceToXml();
 				compareMeanVariance();
 			};
@@ -8,6 +8,57 @@
  //=================================================================================================//
 namespace SPH
 {
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestEnsembleAveraged<ObserveMethodType>::updateMomentsIncremental(DoubleVec<Real> &current_result,
+		DoubleVec<Real> &meanvalue_new, DoubleVec<Real> &second_moment_new, DoubleVec<Real> &variance_new)
+	{
+		for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+			for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+			{
+				Real deviation_old_ = current_result[snapshot_index][observation_index] - meanvalue_[snapshot_index][observation_index];
+				meanvalue_new[snapshot_index][observation_index] = meanvalue_[snapshot_index][observation_index] + deviation_old_ / this->number_of_run_;
+				Real deviation_new_ = current_result[snapshot_index][observation_index] - meanvalue_new[snapshot_index][observation_index];
+				second_moment_new[snapshot_index][observation_index] = second_moment_[snapshot_index][observation_index] + deviation_old_ * deviation_new_;
+				variance_new[snapshot_index][observation_index] = SMAX(variance_[snapshot_index][observation_index],
+					std::pow(deviation_new_, 2), std::pow(meanvalue_new[snapshot_index][observation_index] * 1.0e-2, 2));
+			}
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestEnsembleAveraged<ObserveMethodType>::updateMomentsIncremental(DoubleVec<Vecd> &current_result,
+		DoubleVec<Vecd> &meanvalue_new, DoubleVec<Vecd> &second_moment_new, DoubleVec<Vecd> &variance_new)
+	{
+		for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+			for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+				for (int dimension_index = 0; dimension_index != meanvalue_new[0][0].size(); ++dimension_index)
+				{
+					Real deviation_old_ = current_result[snapshot_index][observation_index][dimension_index] - meanvalue_[snapshot_index][observation_index][dimension_index];
+					meanvalue_new[snapshot_index][observation_index][dimension_index] = meanvalue_[snapshot_index][observation_index][dimension_index] + deviation_old_ / this->number_of_run_;
+					Real deviation_new_ = current_result[snapshot_index][observation_index][dimension_index] - meanvalue_new[snapshot_index][observation_index][dimension_index];
+					second_moment_new[snapshot_index][observation_index][dimension_index] = second_moment_[snapshot_index][observation_index][dimension_index] + deviation_old_ * deviation_new_;
+					variance_new[snapshot_index][observation_index][dimension_index] = SMAX(variance_[snapshot_index][observation_index][dimension_index],
+						std::pow(deviation_new_, 2), std::pow(meanvalue_new[snapshot_index][observation_index][dimension_index] * 1.0e-2, 2));
+				}
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestEnsembleAveraged<ObserveMethodType>::updateMomentsIncremental(DoubleVec<Matd> &current_result,
+		DoubleVec<Matd> &meanvalue_new, DoubleVec<Matd> &second_moment_new, DoubleVec<Matd> &variance_new)
+	{
+		for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+			for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+				for (size_t dimension_index_i = 0; dimension_index_i != meanvalue_new[0][0].size(); ++dimension_index_i)
+					for (size_t dimension_index_j = 0; dimension_index_j != meanvalue_new[0][0].size(); ++dimension_index_j)
+					{
+						Real deviation_old_ = current_result[snapshot_index][observation_index][dimension_index_i][dimension_index_j] - meanvalue_[snapshot_index][observation_index][dimension_index_i][dimension_index_j];
+						meanvalue_new[snapshot_index][observation_index][dimension_index_i][dimension_index_j] = meanvalue_[snapshot_index][observation_index][dimension_index_i][dimension_index_j] + deviation_old_ / this->number_of_run_;
+						Real deviation_new_ = current_result[snapshot_index][observation_index][dimension_index_i][dimension_index_j] - meanvalue_new[snapshot_index][observation_index][dimension_index_i][dimension_index_j];
+						second_moment_new[snapshot_index][observation_index][dimension_index_i][dimension_index_j] = second_moment_[snapshot_index][observation_index][dimension_index_i][dimension_index_j] + deviation_old_ * deviation_new_;
+						variance_new[snapshot_index][observation_index][dimension_index_i][dimension_index_j] = SMAX(variance_[snapshot_index][observation_index][dimension_index_i][dimension_index_j],
+							std::pow(deviation_new_, 2), std::pow(meanvalue_new[snapshot_index][observation_index][dimension_index_i][dimension_index_j] * 1.0e-2, 2));
+					}
+	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
 	void RegressionTestEnsembleAveraged<ObserveMethodType>::calculateNewVariance(TripleVec<Real> &result,
@@ -189,7 +240,9 @@ namespace SPH
 
 		if (this->number_of_run_ > 1)
 		{
-			if (this->converged == "false" ) /*< To identify the database generation or new result testing. */
+			/*< To identify the database generation or new result testing. The incremental
+			    statistics are complete by themselves and do not reload the result history. */
+			if (this->converged == "false" && !use_incremental_statistics_)
 			{
 				if (!fs::exists(this->result_filefullpath_))
 				{
@@ -216,6 +269,7 @@ namespace SPH
 				DoubleVec<VariableType> temp(SMAX(this->snapshot_, this->number_of_snapshot_old_), StdVec<VariableType>(this->observation_));
 				meanvalue_ = temp;
 				variance_ = temp;
+				second_moment_ = temp;
 
 				/** Unify the length of current result and previous result. */
 				if (this->number_of_snapshot_old_ < this->snapshot_)
@@ -237,6 +291,7 @@ namespace SPH
 			this->result_.push_back(this->current_result_);
 			meanvalue_ = temp;
 			variance_ = temp;
+			second_moment_ = temp;
 		}
 	};
 	//=================================================================================================//
@@ -254,6 +309,21 @@ namespace SPH
 				this->xmlmemory_io_.readDataFromXmlMemory(this->mean_variance_xml_engine_in_,
 					variance_element_, observation_index, this->variance_, this->quantity_name_);
 			}
+
+			if (use_incremental_statistics_)
+			{
+				SimTK::Xml::Element second_moment_element_ = this->mean_variance_xml_engine_in_.getChildElement("SecondMoment_Element");
+				if (!second_moment_element_.isValid())
+				{
+					std::cout << "\n Error: the input file:" << this->mean_variance_filefullpath_ << " is written without the running moments" << std::endl;
+					std::cout << "\n Please regenerate the database with the incremental statistics selected." << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+				for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+					this->xmlmemory_io_.readDataFromXmlMemory(this->mean_variance_xml_engine_in_,
+						second_moment_element_, observation_index, this->second_moment_, this->quantity_name_);
+			}
 		}
 	};
 	//=================================================================================================//
@@ -265,13 +335,23 @@ namespace SPH
 		{
 			for (int delete_ = 0; delete_ != this->difference_; ++delete_)
 			{
-				meanvalue_.pop_back(); 
+				meanvalue_.pop_back();
 				variance_.pop_back();
+				second_moment_.pop_back();
 			}
 		}
 		meanvalue_new_ = meanvalue_;
 		variance_new_ = variance_;
 
+		/** update the running moments and the variance from the new run only,
+		    with the cost independent of the ensemble size. */
+		if (use_incremental_statistics_)
+		{
+			second_moment_new_ = second_moment_;
+			updateMomentsIncremental(this->current_result_, meanvalue_new_, second_moment_new_, variance_new_);
+			return;
+		}
+
 		/** update the meanvalue of the result. */
 		for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
 			for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
@@ -291,6 +371,13 @@ namespace SPH
 		SimTK::Xml::Element variance_element_ = this->mean_variance_xml_engine_out_.getChildElement("Variance_Element");
 		this->xmlmemory_io_.writeDataToXmlMemory(this->mean_variance_xml_engine_out_, variance_element_, this->variance_new_,
 			SMIN(this->snapshot_, this->number_of_snapshot_old_), this->observation_, this->quantity_name_, this->element_tag_);
+		if (use_incremental_statistics_)
+		{
+			this->mean_variance_xml_engine_out_.addElementToXmlDoc("SecondMoment_Element");
+			SimTK::Xml::Element second_moment_element_ = this->mean_variance_xml_engine_out_.getChildElement("SecondMoment_Element");
+			this->xmlmemory_io_.writeDataToXmlMemory(this->mean_variance_xml_engine_out_, second_moment_element_, this->second_moment_new_,
+				SMIN(this->snapshot_, this->number_of_snapshot_old_), this->observation_, this->quantity_name_, this->element_tag_);
+		}
 		this->mean_variance_xml_engine_out_.writeToXmlFile(this->mean_variance_filefullpath_);
 	};
 	//=================================================================================================//
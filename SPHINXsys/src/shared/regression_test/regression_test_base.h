@@ -71,20 +71,33 @@ namespace SPH
 														or observations * snapshot (reading specified result for TA and DTW method.) */
 		 TripleVec<VariableType> result_;            /* the container of results in all runs (run * snapshot * observation) */
 
+		 bool use_binary_result_format_;             /* if true, the result of each run is stored in a compact
+														columnar binary file (.bin) instead of a .xml file,
+														which avoids the attribute-wise parsing for long histories. */
+
 		 int snapshot_, observation_;                /* the size of each layer of current result vector. */
 		 int difference_;                            /* the length difference of snapshot between old and new result, 
 													    which is used to trim each new run result to be a unified length. */
 		 int number_of_run_;                         /* the times of run. */
 		 int label_for_repeat_;                      /* the label used stable convergence (several convergence). */
 		 int number_of_snapshot_old_;                /* the snapshot size of last trimmed result. */
-		 
+
+		 /* value-wise binary in_output, overloaded on the observed variable type. */
+		 void writeAValueToBinary(std::ofstream &out_file, const Real &value);
+		 void writeAValueToBinary(std::ofstream &out_file, const Vecd &value);
+		 void writeAValueToBinary(std::ofstream &out_file, const Matd &value);
+		 void readAValueFromBinary(std::ifstream &in_file, Real &value);
+		 void readAValueFromBinary(std::ifstream &in_file, Vecd &value);
+		 void readAValueFromBinary(std::ifstream &in_file, Matd &value);
+
 	 public:
 		 template<typename... ConstructorArgs>
 		 explicit RegressionTestBase(ConstructorArgs &&...args) :
 			 ObserveMethodType(std::forward<ConstructorArgs>(args)...), xmlmemory_io_(),
 			 observe_xml_engine_("xml_observe_reduce", this->quantity_name_),
 			 result_xml_engine_in_("result_xml_engine_in", "result"),
-			 result_xml_engine_out_("result_xml_engine_out", "result")
+			 result_xml_engine_out_("result_xml_engine_out", "result"),
+			 use_binary_result_format_(false)
 		 {
 			 input_folder_path_ = this->in_output_.input_folder_;
 			 in_output_filefullpath_ = input_folder_path_ + "/" + this->body_name_ 
@@ -125,6 +138,12 @@ namespace SPH
 		 void readResultFromXml(int index_of_run_); /* read the result from the .xml file with the specified index. (DTW method, TA method) */
 		 void writeResultToXml(int index_of_run_); /* write the result to the .xml file with the specified index. (DTW method, TA method) */
 
+		 /** store the per-run result in a columnar binary file, so that long signal histories
+		  * are read back by streaming one observation column at a time instead of parsing xml. */
+		 void useBinaryResultFormat() { use_binary_result_format_ = true; };
+		 void readResultFromBinary(int index_of_run_); /* read the result from the .bin file with the specified index. */
+		 void writeResultToBinary(int index_of_run_); /* write the result to the .bin file with the specified index. */
+
 		 /** the interface to write observed quantity into xml memory. */
 		 void writeToFile(size_t iteration = 0) override
 		 {
@@ -125,6 +125,12 @@ namespace SPH
 	template<class ObserveMethodType>
 	void RegressionTestBase<ObserveMethodType>::readResultFromXml(int index_of_run_)
 	{
+		if (use_binary_result_format_)
+		{
+			readResultFromBinary(index_of_run_);
+			return;
+		}
+
 		if (number_of_run_ > 1) /*only read the result from the 2nd run, because the 1st run doesn't have previous results. */
 		{
 			result_filefullpath_ = input_folder_path_ + "/" + this->body_name_ + "_" + this->quantity_name_ +
@@ -167,7 +173,13 @@ namespace SPH
 	template<class ObserveMethodType>
 	void RegressionTestBase<ObserveMethodType>::writeResultToXml(int index_of_run_)
 	{
-		/** write result to .xml (with different data structure to Base), here is 
+		if (use_binary_result_format_)
+		{
+			writeResultToBinary(index_of_run_);
+			return;
+		}
+
+		/** write result to .xml (with different data structure to Base), here is
 		    observation * snapshot, which can be used for TA and DTW methods. */
 		int total_snapshot_ = current_result_trans_[0].size();
 		result_filefullpath_ = input_folder_path_ + "/" + this->body_name_ + "_" + this->quantity_name_ +
@@ -195,6 +207,108 @@ namespace SPH
 	};
 	//=================================================================================================//
 	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::writeAValueToBinary(std::ofstream &out_file, const Real &value)
+	{
+		out_file.write(reinterpret_cast<const char *>(&value), sizeof(Real));
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::writeAValueToBinary(std::ofstream &out_file, const Vecd &value)
+	{
+		for (int dimension_index = 0; dimension_index != Dimensions; ++dimension_index)
+			writeAValueToBinary(out_file, value[dimension_index]);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::writeAValueToBinary(std::ofstream &out_file, const Matd &value)
+	{
+		for (int dimension_index_i = 0; dimension_index_i != Dimensions; ++dimension_index_i)
+			for (int dimension_index_j = 0; dimension_index_j != Dimensions; ++dimension_index_j)
+				writeAValueToBinary(out_file, value[dimension_index_i][dimension_index_j]);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::readAValueFromBinary(std::ifstream &in_file, Real &value)
+	{
+		in_file.read(reinterpret_cast<char *>(&value), sizeof(Real));
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::readAValueFromBinary(std::ifstream &in_file, Vecd &value)
+	{
+		for (int dimension_index = 0; dimension_index != Dimensions; ++dimension_index)
+			readAValueFromBinary(in_file, value[dimension_index]);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::readAValueFromBinary(std::ifstream &in_file, Matd &value)
+	{
+		for (int dimension_index_i = 0; dimension_index_i != Dimensions; ++dimension_index_i)
+			for (int dimension_index_j = 0; dimension_index_j != Dimensions; ++dimension_index_j)
+				readAValueFromBinary(in_file, value[dimension_index_i][dimension_index_j]);
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::readResultFromBinary(int index_of_run_)
+	{
+		if (number_of_run_ > 1) /*only read the result from the 2nd run, because the 1st run doesn't have previous results. */
+		{
+			result_filefullpath_ = input_folder_path_ + "/" + this->body_name_ + "_" + this->quantity_name_ +
+				"_Run_" + std::to_string(index_of_run_) + "_result.bin";
+
+			/* To identify the database generation or new result test. */
+			if (converged == "false")
+			{
+				if (!fs::exists(result_filefullpath_))
+				{
+					std::cout << "\n Error: the input file:" << result_filefullpath_ << " is not exists" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+			}
+
+			/* the header records the size of the result, and the values follow column by column. */
+			std::ifstream in_file(result_filefullpath_.c_str(), std::ios::binary);
+			int file_observation_ = 0;
+			in_file.read(reinterpret_cast<char *>(&file_observation_), sizeof(int));
+			in_file.read(reinterpret_cast<char *>(&snapshot_), sizeof(int));
+			if (file_observation_ != observation_)
+			{
+				std::cout << "\n Error: the input file:" << result_filefullpath_
+					<< " has " << file_observation_ << " observations instead of " << observation_ << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			DoubleVec<VariableType> result_temp_(observation_, StdVec<VariableType>(snapshot_));
+			result_in_ = result_temp_;
+			/* each observation column is contiguous, so the history streams in
+			   one pass per column without any parsing. */
+			for (int observation_index = 0; observation_index != observation_; ++observation_index)
+				for (int snapshot_index = 0; snapshot_index != snapshot_; ++snapshot_index)
+					readAValueFromBinary(in_file, result_in_[observation_index][snapshot_index]);
+			in_file.close();
+		}
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
+	void RegressionTestBase<ObserveMethodType>::writeResultToBinary(int index_of_run_)
+	{
+		/** write result to .bin with the same observation * snapshot layout
+		    as the run-wise .xml output used for TA and DTW methods. */
+		int total_snapshot_ = current_result_trans_[0].size();
+		result_filefullpath_ = input_folder_path_ + "/" + this->body_name_ + "_" + this->quantity_name_ +
+			"_Run_" + std::to_string(index_of_run_) + "_result.bin";
+		std::ofstream out_file(result_filefullpath_.c_str(), std::ios::binary);
+		out_file.write(reinterpret_cast<const char *>(&observation_), sizeof(int));
+		out_file.write(reinterpret_cast<const char *>(&total_snapshot_), sizeof(int));
+		for (int observation_index = 0; observation_index != observation_; ++observation_index)
+			for (int snapshot_index = 0; snapshot_index != total_snapshot_; ++snapshot_index)
+				writeAValueToBinary(out_file, current_result_trans_[observation_index][snapshot_index]);
+		out_file.close();
+	};
+	//=================================================================================================//
+	template<class ObserveMethodType>
 	RegressionTestBase<ObserveMethodType>::~RegressionTestBase()
 	{
 		if (converged == "false")
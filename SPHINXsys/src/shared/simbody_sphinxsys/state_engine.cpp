@@ -6,6 +6,8 @@
 
 #include "state_engine.h"
 
+#include <fstream>
+
 namespace SPH {
     //===============================================================//
     StateEngine::
@@ -328,6 +330,71 @@ namespace SPH {
         system_.realizeModel(state_);
         return state_;
     }
+    //===============================================================//
+    void StateEngine::writeStateInfoToBinary(int ite_rst_, const SimTK::State& state_)
+    {
+        std::string filefullpath = restart_folder_ + "/Simbody_Rst_" + std::to_string(ite_rst_) + ".bin";
+        std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+        const SimTK::SimbodyMatterSubsystem& matter_ = getMultibodySystem().getMatterSubsystem();
+        uint64_t num_bodies = matter_.getNumBodies();
+        out_file.write(reinterpret_cast<const char*>(&num_bodies), sizeof(num_bodies));
+
+        const SimTK::Vector& q_ = state_.getQ();
+        const SimTK::Vector& u_ = state_.getU();
+        uint64_t num_q_ = q_.size();
+        uint64_t num_u_ = u_.size();
+        out_file.write(reinterpret_cast<const char*>(&num_q_), sizeof(num_q_));
+        out_file.write(reinterpret_cast<const char*>(&num_u_), sizeof(num_u_));
+        /** the state vectors are staged contiguously and written in one block each. */
+        StdVec<Real> q_values(q_.size());
+        for (int i = 0; i < q_.size(); ++i) q_values[i] = q_[i];
+        out_file.write(reinterpret_cast<const char*>(q_values.data()), q_values.size() * sizeof(Real));
+        StdVec<Real> u_values(u_.size());
+        for (int i = 0; i < u_.size(); ++i) u_values[i] = u_[i];
+        out_file.write(reinterpret_cast<const char*>(u_values.data()), u_values.size() * sizeof(Real));
+        out_file.close();
+    }
+    //===============================================================//
+    SimTK::State StateEngine::readAndSetStateInfoFromBinary(int ite_rst_, SimTK::MultibodySystem& system_)
+    {
+        std::string filefullpath = restart_folder_ + "/Simbody_Rst_" + std::to_string(ite_rst_) + ".bin";
+        const SimTK::SimbodyMatterSubsystem& matter_ = system_.getMatterSubsystem();
+        SimTK::State state_ = system_.getDefaultState();
+        if (!fs::exists(filefullpath))
+        {
+            std::cout << "\n Error: the input file:" << filefullpath << " is not valid" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+        std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+        uint64_t num_bodies = 0;
+        uint64_t num_q_ = 0;
+        uint64_t num_u_ = 0;
+        in_file.read(reinterpret_cast<char*>(&num_bodies), sizeof(num_bodies));
+        in_file.read(reinterpret_cast<char*>(&num_q_), sizeof(num_q_));
+        in_file.read(reinterpret_cast<char*>(&num_u_), sizeof(num_u_));
+        if (num_bodies != uint64_t(matter_.getNumBodies()) ||
+            num_q_ != uint64_t(state_.getNQ()) || num_u_ != uint64_t(state_.getNU()))
+        {
+            std::cout << "\n Error: the input file:" << filefullpath
+                      << " is written for another matter system" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+        StdVec<Real> q_values(num_q_);
+        in_file.read(reinterpret_cast<char*>(q_values.data()), q_values.size() * sizeof(Real));
+        SimTK::Vector& q_ = state_.updQ();
+        for (int i = 0; i < q_.size(); ++i) q_[i] = q_values[i];
+        StdVec<Real> u_values(num_u_);
+        in_file.read(reinterpret_cast<char*>(u_values.data()), u_values.size() * sizeof(Real));
+        SimTK::Vector& u_ = state_.updU();
+        for (int i = 0; i < u_.size(); ++i) u_[i] = u_values[i];
+
+        system_.realizeModel(state_);
+        return state_;
+    }
     //------------------------------------------------------------------------------
     //          REALIZE THE SYSTEM TO THE REQUIRED COMPUTATIONAL STAGE
     //------------------------------------------------------------------------------
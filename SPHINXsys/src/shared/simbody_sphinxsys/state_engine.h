@@ -340,6 +340,20 @@ namespace SPH {
          * the restart file
         */
         SimTK::State readAndSetStateInfoFromXml(int ite_rst_, SimTK::MultibodySystem& system_);
+        /**
+         * Write the state data to a binary restart file, aligned with the
+         * binary restart files of the particle data.
+         * The generalized coordinates and generalized velocities of the whole
+         * matter system are written in bulk, avoiding the per-element string
+         * conversion of the xml path, which is retained for debugging.
+         */
+        void writeStateInfoToBinary(int ite_rst_, const SimTK::State& state_);
+        /**
+         * read state info from a binary restart file and set it to state.
+         * The file layout is validated against the present matter system
+         * before the state vectors are read in bulk.
+        */
+        SimTK::State readAndSetStateInfoFromBinary(int ite_rst_, SimTK::MultibodySystem& system_);
         /**@name  Realize the Simbody System and State to Computational Stage.
                 Methods in this section enable advanced and scripting users access to
                 realize the Simbody MultibodySystem and the provided state to a desired
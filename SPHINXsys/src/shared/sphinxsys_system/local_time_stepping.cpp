@@ -0,0 +1,90 @@
+/**
+ * @file 	local_time_stepping.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#include "local_time_stepping.h"
+
+#include "base_particle_dynamics.h"
+
+#include <iostream>
+
+namespace SPH
+{
+	//=================================================================================================//
+	LocalTimeStepping::LocalTimeStepping(SPHSystem &sph_system, size_t maximum_step_ratio)
+		: sph_system_(sph_system), maximum_step_ratio_(maximum_step_ratio) {}
+	//=================================================================================================//
+	size_t LocalTimeStepping::addBodyGroup(const SteppingCriterion &time_step_criterion)
+	{
+		group_criteria_.push_back(time_step_criterion);
+		group_actions_.push_back(StdVec<SteppingAction>());
+		group_step_ratios_.push_back(1);
+		return group_criteria_.size() - 1;
+	}
+	//=================================================================================================//
+	void LocalTimeStepping::runDuringBodyStep(size_t group, const SteppingAction &action)
+	{
+		group_actions_[group].push_back(action);
+	}
+	//=================================================================================================//
+	void LocalTimeStepping::runAtSynchronization(const SteppingAction &action)
+	{
+		synchronization_actions_.push_back(action);
+	}
+	//=================================================================================================//
+	Real LocalTimeStepping::advanceOneMacroStep()
+	{
+		if (group_criteria_.empty())
+		{
+			std::cout << "\n Error: no body group is registered for local time stepping!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << ": in function " << __func__ << "\n";
+			exit(1);
+		}
+
+		StdVec<Real> admissible_steps(group_criteria_.size());
+		Real smallest_step = DBL_MAX;
+		for (size_t k = 0; k != group_criteria_.size(); ++k)
+		{
+			admissible_steps[k] = group_criteria_[k]();
+			smallest_step = SMIN(smallest_step, admissible_steps[k]);
+		}
+
+		/** power-of-two local steps nest within the macro step,
+		 * so all groups land exactly on its boundary */
+		size_t largest_ratio = 1;
+		for (size_t k = 0; k != group_criteria_.size(); ++k)
+		{
+			size_t ratio = 1;
+			while (ratio * 2 <= maximum_step_ratio_ &&
+				   smallest_step * Real(ratio * 2) <= admissible_steps[k])
+			{
+				ratio *= 2;
+			}
+			group_step_ratios_[k] = ratio;
+			largest_ratio = SMAX(largest_ratio, ratio);
+		}
+
+		for (size_t s = 0; s != largest_ratio; ++s)
+		{
+			for (size_t k = 0; k != group_actions_.size(); ++k)
+			{
+				if (s % group_step_ratios_[k] == 0)
+				{
+					Real local_step = smallest_step * Real(group_step_ratios_[k]);
+					for (size_t n = 0; n != group_actions_[k].size(); ++n)
+						group_actions_[k][n](local_step);
+				}
+			}
+		}
+
+		Real macro_step = smallest_step * Real(largest_ratio);
+		for (size_t n = 0; n != synchronization_actions_.size(); ++n)
+			synchronization_actions_[n](macro_step);
+		GlobalStaticVariables::physical_time_ += macro_step;
+
+		return macro_step;
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
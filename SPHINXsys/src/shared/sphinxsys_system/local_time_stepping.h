@@ -0,0 +1,83 @@
+/* -------------------------------------------------------------------------*
+ *								SPHinXsys									*
+ * --------------------------------------------------------------------------*
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+ * (smoothed particle hydrodynamics), a meshless computational method using	*
+ * particle discretization.													*
+ *																			*
+ * SPHinXsys is partially funded by German Research Foundation				*
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+ * and HU1527/12-1.															*
+ *                                                                           *
+ * Portions copyright (c) 2017-2020 Technical University of Munich and		*
+ * the authors' affiliations.												*
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * --------------------------------------------------------------------------*/
+/**
+ * @file 	local_time_stepping.h
+ * @brief 	Hierarchical per-body local time stepping.
+ * @details	Each body group advances with its own admissible time step size,
+ *			rounded down to a power-of-two multiple of the smallest one, so
+ *			that all groups meet exactly at the end of a common macro step
+ *			where the coupling dynamics are synchronized.
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#ifndef LOCAL_TIME_STEPPING_H
+#define LOCAL_TIME_STEPPING_H
+
+#include "time_stepping_driver.h"
+
+namespace SPH
+{
+	/**
+	 * @class LocalTimeStepping
+	 * @brief advance several body groups with hierarchical local time steps.
+	 * The local step of each group is the largest power-of-two multiple of the
+	 * smallest admissible step which stays below the group's own criterion,
+	 * capped by a maximum ratio. Because the ratios nest, every group lands
+	 * exactly on the macro step boundary, where the registered coupling
+	 * dynamics, e.g. FSI force exchange on contact relations, execute with
+	 * synchronized states and no interpolation is needed. Between its substeps
+	 * the state of a slower body is held constant, the usual conservative
+	 * choice for the interface terms of the faster bodies.
+	 */
+	class LocalTimeStepping
+	{
+	public:
+		explicit LocalTimeStepping(SPHSystem &sph_system, size_t maximum_step_ratio = 8);
+		virtual ~LocalTimeStepping(){};
+
+		/** register a body group with its own time step criterion
+		 * and return the group index for registering its actions */
+		size_t addBodyGroup(const SteppingCriterion &time_step_criterion);
+		/** one substep of the given group, invoked with the group's local step size */
+		void runDuringBodyStep(size_t group, const SteppingAction &action);
+		/** coupling dynamics executed at the macro step boundaries,
+		 * invoked with the macro step size */
+		void runAtSynchronization(const SteppingAction &action);
+
+		/** advance all groups by one common macro step,
+		 * update the physical time and return the macro step size */
+		Real advanceOneMacroStep();
+
+		/** the local-to-smallest step ratio of a group in the last macro step */
+		size_t GroupStepRatio(size_t group) { return group_step_ratios_[group]; };
+
+	protected:
+		SPHSystem &sph_system_;
+		size_t maximum_step_ratio_;
+		StdVec<SteppingCriterion> group_criteria_;
+		StdVec<StdVec<SteppingAction>> group_actions_;
+		StdVec<size_t> group_step_ratios_;
+		StdVec<SteppingAction> synchronization_actions_;
+	};
+}
+#endif // LOCAL_TIME_STEPPING_H
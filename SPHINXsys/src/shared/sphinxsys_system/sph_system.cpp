@@ -10,6 +10,11 @@
 #include "body_relation.h"
 #include "elastic_dynamics.h"
 
+#include "tbb/task_group.h"
+
+#include <mutex>
+#include <condition_variable>
+
 namespace SPH
 {
 	//=================================================================================================//
@@ -22,20 +27,145 @@ namespace SPH
 	//=================================================================================================//
 	void SPHSystem::initializeSystemCellLinkedLists()
 	{
+		// the cell linked lists of different bodies are independent
+		tbb::task_group initialization_tasks;
 		for (auto &body : real_bodies_)
 		{
-			DynamicCast<RealBody>(this, body)->updateCellLinkedList();
+			RealBody *real_body = DynamicCast<RealBody>(this, body);
+			initialization_tasks.run([real_body]
+									 { real_body->updateCellLinkedList(); });
 		}
+		initialization_tasks.wait();
 	}
 	//=================================================================================================//
 	void SPHSystem::initializeSystemConfigurations()
 	{
+		// updating a configuration only writes the neighborhoods of its own
+		// body and reads the already built cell linked lists of the contact
+		// bodies, so the bodies initialize concurrently while the relations
+		// of each body keep their registration order
+		tbb::task_group initialization_tasks;
 		for (auto &body : sph_bodies_)
 		{
-			for (size_t i = 0; i < body->body_relations_.size(); i++)
+			SPHBody *sph_body = body;
+			initialization_tasks.run(
+				[sph_body]
+				{
+					for (size_t i = 0; i < sph_body->body_relations_.size(); i++)
+					{
+						sph_body->body_relations_[i]->updateConfiguration();
+					}
+				});
+		}
+		initialization_tasks.wait();
+	}
+	//=================================================================================================//
+	void SPHSystem::scheduleStartupTask(const std::string &task_name, const std::function<void()> &task,
+										const StdVec<std::string> &depends_on)
+	{
+		startup_tasks_.push_back(StartupTask{task_name, task, depends_on});
+	}
+	//=================================================================================================//
+	void SPHSystem::runStartupTasks()
+	{
+		size_t number_of_tasks = startup_tasks_.size();
+
+		// resolve the dependency names once, complaining about unknown tasks
+		StdVec<IndexVector> dependency_indexes(number_of_tasks);
+		for (size_t n = 0; n != number_of_tasks; ++n)
+		{
+			for (const std::string &depends_on : startup_tasks_[n].depends_on_)
+			{
+				size_t found = number_of_tasks;
+				for (size_t k = 0; k != number_of_tasks; ++k)
+				{
+					if (startup_tasks_[k].name_ == depends_on)
+						found = k;
+				}
+				if (found == number_of_tasks)
+				{
+					std::cout << "\n Error: the startup task '" << startup_tasks_[n].name_
+							  << "' depends on the unknown task '" << depends_on << "'!" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << ": required from here." << std::endl;
+					exit(1);
+				}
+				dependency_indexes[n].push_back(found);
+			}
+		}
+
+		// every task is spawned as soon as all its dependencies have finished
+		std::mutex mutex;
+		std::condition_variable task_finished;
+		StdVec<int> task_states(number_of_tasks, 0); // 0: pending, 1: running, 2: finished
+		size_t finished_tasks = 0;
+		tbb::task_group startup_pipeline;
+
+		std::unique_lock<std::mutex> lock(mutex);
+		while (finished_tasks != number_of_tasks)
+		{
+			bool any_running = false;
+			for (size_t n = 0; n != number_of_tasks; ++n)
+			{
+				if (task_states[n] != 0)
+				{
+					any_running |= task_states[n] == 1;
+					continue;
+				}
+
+				bool dependencies_finished = true;
+				for (size_t k = 0; k != dependency_indexes[n].size(); ++k)
+					dependencies_finished &= task_states[dependency_indexes[n][k]] == 2;
+				if (!dependencies_finished)
+					continue;
+
+				task_states[n] = 1;
+				any_running = true;
+				const std::function<void()> &task = startup_tasks_[n].task_;
+				startup_pipeline.run(
+					[&, n]
+					{
+						task();
+						std::lock_guard<std::mutex> finish_lock(mutex);
+						task_states[n] = 2;
+						finished_tasks++;
+						task_finished.notify_one();
+					});
+			}
+
+			if (finished_tasks == number_of_tasks)
+				break;
+			if (!any_running)
+			{
+				std::cout << "\n Error: the startup tasks contain a dependency cycle!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << ": required from here." << std::endl;
+				exit(1);
+			}
+			task_finished.wait(lock);
+		}
+		lock.unlock();
+
+		startup_pipeline.wait();
+		startup_tasks_.clear();
+	}
+	//=================================================================================================//
+	void SPHSystem::runParameterVariants(size_t number_of_variants, const std::function<void(size_t)> &run_variant)
+	{
+		StdVec<std::string> initial_states(sph_bodies_.size());
+		for (size_t i = 0; i != sph_bodies_.size(); ++i)
+			sph_bodies_[i]->base_particles_->snapshotAllParticleData(initial_states[i]);
+		Real initial_physical_time = GlobalStaticVariables::physical_time_;
+
+		for (size_t variant = 0; variant != number_of_variants; ++variant)
+		{
+			if (variant != 0)
 			{
-				body->body_relations_[i]->updateConfiguration();
+				for (size_t i = 0; i != sph_bodies_.size(); ++i)
+					sph_bodies_[i]->base_particles_->restoreAllParticleData(initial_states[i]);
+				GlobalStaticVariables::physical_time_ = initial_physical_time;
+				initializeSystemCellLinkedLists();
+				initializeSystemConfigurations();
 			}
+			run_variant(variant);
 		}
 	}
 	//=================================================================================================//
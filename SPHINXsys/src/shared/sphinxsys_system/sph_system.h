@@ -22,6 +22,7 @@ namespace po = boost::program_options;
 
 #include <thread>
 #include <fstream>
+#include <functional>
 /** Macro for APPLE compilers*/
 #ifdef __APPLE__
 #include <boost/filesystem.hpp>
@@ -67,10 +68,43 @@ namespace SPH
 
 		void initializeSystemCellLinkedLists();
 		void initializeSystemConfigurations();
+		/** schedule a named startup task, e.g. a geometry loading, level-set
+		 * construction or particle generation closure, together with the names
+		 * of the tasks it depends on. The tasks only run in runStartupTasks(). */
+		void scheduleStartupTask(const std::string &task_name, const std::function<void()> &task,
+								 const StdVec<std::string> &depends_on = StdVec<std::string>());
+		/** run the scheduled startup tasks as a pipeline: every task starts as
+		 * soon as all its dependencies have finished, so that independent
+		 * stages of different bodies overlap and the setup of a multi-body
+		 * case approaches the cost of its longest dependency chain rather
+		 * than the sum of all stages. Tasks touching shared system state,
+		 * e.g. constructing bodies into the same system, must be serialized
+		 * by declaring dependencies between them. Returns after all tasks
+		 * have finished and clears the schedule. */
+		void runStartupTasks();
+		/** run successive parameter variants of the case in one process:
+		 * the particle states of all bodies and the physical time are
+		 * snapshotted before the first variant and restored, and the cell
+		 * linked lists and configurations rebuilt, before each following
+		 * one, so that geometry loading, level-set construction, particle
+		 * relaxation and the thread arenas are paid once for the whole
+		 * sweep. The callback receives the variant count and applies the
+		 * per-variant values, e.g. through the parameterization classes,
+		 * before running the case. */
+		void runParameterVariants(size_t number_of_variants, const std::function<void(size_t)> &run_variant);
 		Real getSmallestTimeStepAmongSolidBodies(Real CFL = 0.6);
 #ifdef BOOST_AVAILABLE
 		void handleCommandlineOptions(int ac, char *av[]);
 #endif
+
+	protected:
+		struct StartupTask
+		{
+			std::string name_;
+			std::function<void()> task_;
+			StdVec<std::string> depends_on_;
+		};
+		StdVec<StartupTask> startup_tasks_; /**< scheduled but not yet executed startup tasks. */
 	};
 }
 #endif // SPH_SYSTEM_H
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**
+ * @file 	time_stepping_driver.cpp
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#include "time_stepping_driver.h"
+
+#include "base_particle_dynamics.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace SPH
+{
+	//=================================================================================================//
+	TimeSteppingDriver::TimeSteppingDriver(SPHSystem &sph_system, Real end_time, Real output_interval)
+		: sph_system_(sph_system), end_time_(end_time), output_interval_(output_interval),
+		  screen_output_interval_(100), number_of_iterations_(0), dt_(0.0) {}
+	//=================================================================================================//
+	void TimeSteppingDriver::runDuringAdvectionStep(const SteppingAction &action)
+	{
+		advection_actions_.push_back(action);
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::setAdvectionTimeStepCriterion(const SteppingCriterion &criterion)
+	{
+		advection_time_step_ = criterion;
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::runDuringAcousticStep(const SteppingAction &action)
+	{
+		acoustic_actions_.push_back(action);
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::setAcousticTimeStepCriterion(const SteppingCriterion &criterion)
+	{
+		acoustic_time_step_ = criterion;
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::updateCellLinkedList(RealBody &real_body)
+	{
+		cell_linked_list_bodies_.push_back(&real_body);
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::updateConfiguration(SPHBodyRelation &body_relation)
+	{
+		configuration_relations_.push_back(&body_relation);
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::updateCellLinkedListWhenDue(RealBody &real_body, BodyRelationInnerVerlet &verlet_relation)
+	{
+		verlet_cell_linked_list_pairs_.push_back(std::make_pair(&real_body, &verlet_relation));
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::runAtObservation(const SteppingAction &action, int interval_in_steps)
+	{
+		observation_actions_.push_back(std::make_pair(action, interval_in_steps));
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::runAtOutput(const SteppingAction &action)
+	{
+		output_actions_.push_back(action);
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::executeOutputActions()
+	{
+		tick_count t_start = tick_count::now();
+		for (size_t k = 0; k != output_actions_.size(); ++k)
+			output_actions_[k](dt_);
+		interval_output_ += tick_count::now() - t_start;
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::updateCellLinkedListsAndConfigurations()
+	{
+		tick_count t_start = tick_count::now();
+		for (size_t k = 0; k != cell_linked_list_bodies_.size(); ++k)
+			cell_linked_list_bodies_[k]->updateCellLinkedList();
+		for (size_t k = 0; k != verlet_cell_linked_list_pairs_.size(); ++k)
+		{
+			if (verlet_cell_linked_list_pairs_[k].second->rebuildDue())
+			{
+				verlet_cell_linked_list_pairs_[k].first->updateCellLinkedList();
+			}
+			verlet_cell_linked_list_pairs_[k].second->updateConfiguration();
+		}
+		for (size_t k = 0; k != configuration_relations_.size(); ++k)
+			configuration_relations_[k]->updateConfiguration();
+		interval_configuration_ += tick_count::now() - t_start;
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::run()
+	{
+		if (!advection_time_step_ || !acoustic_time_step_)
+		{
+			std::cout << "\n Error: the time step criteria of the stepping driver are not all set!" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << ": in function " << __func__ << "\n";
+			exit(1);
+		}
+
+		executeOutputActions();
+
+		while (GlobalStaticVariables::physical_time_ < end_time_)
+		{
+			Real integration_time = 0.0;
+			while (integration_time < output_interval_)
+			{
+				/** the advection phase with the outer time step criterion. */
+				tick_count t_advection_start = tick_count::now();
+				Real Dt = advection_time_step_();
+				for (size_t k = 0; k != advection_actions_.size(); ++k)
+					advection_actions_[k](Dt);
+				interval_advection_ += tick_count::now() - t_advection_start;
+
+				/** the acoustic phase repeated until the advection step is filled.
+				 * The acoustic time step of the previous inner step is reused first. */
+				tick_count t_acoustic_start = tick_count::now();
+				Real relaxation_time = 0.0;
+				while (relaxation_time < Dt)
+				{
+					for (size_t k = 0; k != acoustic_actions_.size(); ++k)
+						acoustic_actions_[k](dt_);
+					relaxation_time += dt_;
+					integration_time += dt_;
+					GlobalStaticVariables::physical_time_ += dt_;
+					dt_ = acoustic_time_step_();
+				}
+				interval_acoustic_ += tick_count::now() - t_acoustic_start;
+
+				if (number_of_iterations_ % screen_output_interval_ == 0)
+				{
+					std::cout << std::fixed << std::setprecision(9)
+							  << "N=" << number_of_iterations_
+							  << "	Time = " << GlobalStaticVariables::physical_time_
+							  << "	Dt = " << Dt << "	dt = " << dt_ << "\n";
+				}
+				for (size_t k = 0; k != observation_actions_.size(); ++k)
+				{
+					if (number_of_iterations_ % observation_actions_[k].second == 0)
+						observation_actions_[k].first(dt_);
+				}
+				number_of_iterations_++;
+
+				updateCellLinkedListsAndConfigurations();
+			}
+			executeOutputActions();
+		}
+	}
+	//=================================================================================================//
+	void TimeSteppingDriver::writePhaseTimingToScreen()
+	{
+		std::cout << std::fixed << std::setprecision(9)
+				  << "Time for the advection phase: " << interval_advection_.seconds() << " seconds.\n"
+				  << "Time for the acoustic phase: " << interval_acoustic_.seconds() << " seconds.\n"
+				  << "Time for updating configurations: " << interval_configuration_.seconds() << " seconds.\n"
+				  << "Time for writing outputs: " << interval_output_.seconds() << " seconds." << std::endl;
+	}
+	//=================================================================================================//
+}
+//=================================================================================================//
@@ -0,0 +1,133 @@
+/* -------------------------------------------------------------------------*
+ *								SPHinXsys									*
+ * --------------------------------------------------------------------------*
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+ * (smoothed particle hydrodynamics), a meshless computational method using	*
+ * particle discretization.													*
+ *																			*
+ * SPHinXsys is partially funded by German Research Foundation				*
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+ * and HU1527/12-1.															*
+ *                                                                           *
+ * Portions copyright (c) 2017-2020 Technical University of Munich and		*
+ * the authors' affiliations.												*
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * --------------------------------------------------------------------------*/
+/**
+ * @file 	time_stepping_driver.h
+ * @brief 	A reusable driver owning the dual-criteria time stepping loop.
+ * @details	The dynamics of one step are registered in declared phases and the
+ *			driver invokes them in order, manages the output cadences, skips
+ *			configuration updates which are provably unnecessary and
+ *			accumulates per-phase wall-clock timing.
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#ifndef TIME_STEPPING_DRIVER_H
+#define TIME_STEPPING_DRIVER_H
+
+#include "sph_system.h"
+#include "base_body.h"
+#include "body_relation.h"
+
+#include <functional>
+
+namespace SPH
+{
+	/** an action executed within a stepping phase, given the step size of its phase */
+	typedef std::function<void(Real)> SteppingAction;
+	/** a criterion returning the admissible time step size of a phase */
+	typedef std::function<Real()> SteppingCriterion;
+
+	/**
+	 * @class TimeSteppingDriver
+	 * @brief owns the dual-criteria time stepping loop which the example mains
+	 * otherwise hand-write: the advection phase, the inner acoustic loop, the
+	 * cell linked list and configuration updates and the output cadences.
+	 * The registered dynamics are invoked in the order of registration within
+	 * their phase. A cell linked list update paired with a Verlet relation is
+	 * skipped while no particle has moved beyond half of the skin distance,
+	 * and the accumulated wall-clock time of each phase is available after
+	 * the run.
+	 */
+	class TimeSteppingDriver
+	{
+	public:
+		TimeSteppingDriver(SPHSystem &sph_system, Real end_time, Real output_interval);
+		virtual ~TimeSteppingDriver(){};
+
+		/** the advection phase at the beginning of each outer step, e.g. time
+		 * step initialization, density summation and viscous acceleration */
+		void runDuringAdvectionStep(const SteppingAction &action);
+		/** the criterion for the advection (outer) time step size */
+		void setAdvectionTimeStepCriterion(const SteppingCriterion &criterion);
+		/** the acoustic phase executed repeatedly until the advection step is
+		 * filled, e.g. pressure and density relaxation */
+		void runDuringAcousticStep(const SteppingAction &action);
+		/** the criterion for the acoustic (inner) time step size */
+		void setAcousticTimeStepCriterion(const SteppingCriterion &criterion);
+
+		/** cell linked list and configuration updates after each outer step,
+		 * executed in the order of registration */
+		void updateCellLinkedList(RealBody &real_body);
+		void updateConfiguration(SPHBodyRelation &body_relation);
+		/** pair the cell linked list update of a body with its Verlet relation:
+		 * the cell linked list is only updated when the relation is due to
+		 * rebuild its neighborhoods. Only valid when the cell linked list has
+		 * no consumer other than the paired relation. */
+		void updateCellLinkedListWhenDue(RealBody &real_body, BodyRelationInnerVerlet &verlet_relation);
+
+		/** observation or restart output every given number of outer steps */
+		void runAtObservation(const SteppingAction &action, int interval_in_steps);
+		/** body states output every output_interval of physical time,
+		 * also executed once before the loop starts */
+		void runAtOutput(const SteppingAction &action);
+
+		void setScreenOutputInterval(int interval) { screen_output_interval_ = interval; };
+
+		/** run the loop from the current physical time to the end time */
+		void run();
+
+		/** accumulated wall-clock time of the phases */
+		tick_count::interval_t getAdvectionInterval() { return interval_advection_; };
+		tick_count::interval_t getAcousticInterval() { return interval_acoustic_; };
+		tick_count::interval_t getConfigurationInterval() { return interval_configuration_; };
+		tick_count::interval_t getOutputInterval() { return interval_output_; };
+		/** print the accumulated per-phase timing to the screen */
+		void writePhaseTimingToScreen();
+
+	protected:
+		SPHSystem &sph_system_;
+		Real end_time_;
+		Real output_interval_;
+		int screen_output_interval_;
+		size_t number_of_iterations_;
+		Real dt_; /**< acoustic time step size, reused from the previous inner step */
+
+		StdVec<SteppingAction> advection_actions_;
+		StdVec<SteppingAction> acoustic_actions_;
+		SteppingCriterion advection_time_step_;
+		SteppingCriterion acoustic_time_step_;
+		StdVec<RealBody *> cell_linked_list_bodies_;
+		StdVec<std::pair<RealBody *, BodyRelationInnerVerlet *>> verlet_cell_linked_list_pairs_;
+		StdVec<SPHBodyRelation *> configuration_relations_;
+		StdVec<std::pair<SteppingAction, int>> observation_actions_;
+		StdVec<SteppingAction> output_actions_;
+
+		tick_count::interval_t interval_advection_;
+		tick_count::interval_t interval_acoustic_;
+		tick_count::interval_t interval_configuration_;
+		tick_count::interval_t interval_output_;
+
+		void executeOutputActions();
+		void updateCellLinkedListsAndConfigurations();
+	};
+}
+#endif // TIME_STEPPING_DRIVER_H
@@ -0,0 +1,99 @@
+/* ---------------------------------------------------------------------------*
+*            SPHinXsys: micro-benchmarks for core solver primitives           *
+* ----------------------------------------------------------------------------*
+* Timed harnesses for the primitives dominating a typical weakly compressible *
+* simulation step: cell-linked-list build, inner configuration update,        *
+* pair-loop throughput, particle sorting and time-step reduction. Particles   *
+* are generated on a synthetic lattice of parameterizable size so that runs   *
+* are comparable across machines and releases.                                *
+*                                                                             *
+* Usage: benchmark_core_primitives [particles_per_side = 50] [repeats = 20]   *
+* ---------------------------------------------------------------------------*/
+
+#include "sphinxsys.h" // SPHinXsys Library.
+
+#include <functional>
+#include <iomanip>
+
+using namespace SPH;
+
+//for geometry: a unit cube of fluid filling the whole domain
+Real cube_length = 1.0;
+
+//for material properties of the fluid
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+//	define the fluid body shape
+class WaterCube : public ComplexShape
+{
+public:
+	explicit WaterCube(const std::string &shape_name) : ComplexShape(shape_name)
+	{
+		Vecd halfsize_cube(0.5 * cube_length, 0.5 * cube_length, 0.5 * cube_length);
+		SimTK::Transform translation_cube(halfsize_cube);
+		add<TransformShape<GeometricShapeBox>>(translation_cube, halfsize_cube);
+	}
+};
+
+//the main program
+int main(int ac, char *av[])
+{
+	size_t particles_per_side = ac > 1 ? std::stoul(av[1]) : 50;
+	int repeats = ac > 2 ? std::stoi(av[2]) : 20;
+	Real resolution_ref = cube_length / Real(particles_per_side);
+
+	//build up context -- a SPHSystem
+	BoundingBox system_domain_bounds(Vecd(0), Vecd(cube_length));
+	SPHSystem system(system_domain_bounds, resolution_ref);
+	GlobalStaticVariables::physical_time_ = 0.0;
+
+	//the water cube
+	FluidBody water_cube(system, makeShared<WaterCube>("WaterCube"));
+	water_cube.defineParticlesAndMaterial<FluidParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+	water_cube.generateParticles<ParticleGeneratorLattice>();
+
+	/** topology */
+	BodyRelationInner water_cube_inner(water_cube);
+
+	/** the benchmarked methods */
+	fluid_dynamics::DensitySummationInner update_density_by_summation(water_cube_inner);
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_cube);
+
+	/** a consistent initial state for all harnesses */
+	water_cube.updateCellLinkedList();
+	water_cube_inner.updateConfiguration();
+
+	size_t total_real_particles = water_cube.base_particles_->total_real_particles_;
+	std::cout << "benchmark_core_primitives: " << total_real_particles << " particles, "
+			  << repeats << " repeats" << "\n\n";
+	std::cout << std::setw(32) << std::left << "primitive"
+			  << std::setw(16) << "seconds/call"
+			  << std::setw(16) << "particles/s" << "\n";
+
+	std::function<void(const std::string &, std::function<void()>)> report =
+		[&](const std::string &name, std::function<void()> operation)
+	{
+		operation(); //warm-up, excluded from the timing
+		tick_count start_time = tick_count::now();
+		for (int i = 0; i != repeats; ++i)
+			operation();
+		Real seconds_per_call = (tick_count::now() - start_time).seconds() / Real(repeats);
+		std::cout << std::setw(32) << std::left << name
+				  << std::setw(16) << seconds_per_call
+				  << std::setw(16) << Real(total_real_particles) / seconds_per_call << "\n";
+	};
+
+	report("cell-linked-list build",
+		   [&]() { water_cube.updateCellLinkedList(); });
+	report("inner configuration update",
+		   [&]() { water_cube_inner.updateConfiguration(); });
+	report("density summation pair loop",
+		   [&]() { update_density_by_summation.parallel_exec(); });
+	report("particle sorting",
+		   [&]() { water_cube.sortParticleWithCellLinkedList(); });
+	report("acoustic time-step reduction",
+		   [&]() { get_fluid_time_step_size.parallel_exec(); });
+
+	return 0;
+}
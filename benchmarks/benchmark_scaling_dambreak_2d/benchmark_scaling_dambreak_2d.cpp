@@ -0,0 +1,166 @@
+/**
+ * @file 	benchmark_scaling_dambreak_2d.cpp
+ * @brief 	Scaling benchmark of the 2D dambreak case.
+ * @details The physics follows tests/2d_examples/test_2d_dambreak but the
+ * 			reference spacing and the thread count are taken from the common
+ * 			benchmark command line, the state and regression output is
+ * 			dropped, and the per-phase timings are reported through the
+ * 			scaling benchmark harness for the nightly comparison against
+ * 			the stored baselines.
+ */
+#include "../scaling_benchmark_harness.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real DL = 5.366;					/**< Tank length. */
+Real DH = 5.366;					/**< Tank height. */
+Real LL = 2.0;						/**< Liquid column length. */
+Real LH = 1.0;						/**< Liquid column height. */
+Real particle_spacing_ref = 0.025;	/**< Initial reference particle spacing, divided by the resolution factor. */
+Real BW = particle_spacing_ref * 4; /**< Extending width for boundary conditions. */
+BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+//----------------------------------------------------------------------
+//	Material properties of the fluid.
+//----------------------------------------------------------------------
+Real rho0_f = 1.0;						 /**< Reference density of fluid. */
+Real gravity_g = 1.0;					 /**< Gravity force of fluid. */
+Real U_max = 2.0 * sqrt(gravity_g * LH); /**< Characteristic velocity. */
+Real c_f = 10.0 * U_max;				 /**< Reference sound speed. */
+//----------------------------------------------------------------------
+//	Geometric shapes used in this case.
+//	The wall shapes are created after the command line is parsed,
+//	as the boundary width follows the chosen spacing.
+//----------------------------------------------------------------------
+StdVec<Vecd> createWaterBlockShape()
+{
+	return {Vecd(0.0, 0.0), Vecd(0.0, LH), Vecd(LL, LH), Vecd(LL, 0.0), Vecd(0.0, 0.0)};
+}
+StdVec<Vecd> createOuterWallShape()
+{
+	return {Vecd(-BW, -BW), Vecd(-BW, DH + BW), Vecd(DL + BW, DH + BW), Vecd(DL + BW, -BW), Vecd(-BW, -BW)};
+}
+StdVec<Vecd> createInnerWallShape()
+{
+	return {Vecd(0.0, 0.0), Vecd(0.0, DH), Vecd(DL, DH), Vecd(DL, 0.0), Vecd(0.0, 0.0)};
+}
+//----------------------------------------------------------------------
+//	Case-dependent geometries
+//----------------------------------------------------------------------
+class WaterBlock : public MultiPolygonShape
+{
+public:
+	explicit WaterBlock(const std::string &shape_name) : MultiPolygonShape(shape_name)
+	{
+		multi_polygon_.addAPolygon(createWaterBlockShape(), ShapeBooleanOps::add);
+	}
+};
+class WallBoundary : public MultiPolygonShape
+{
+public:
+	explicit WallBoundary(const std::string &shape_name) : MultiPolygonShape(shape_name)
+	{
+		multi_polygon_.addAPolygon(createOuterWallShape(), ShapeBooleanOps::add);
+		multi_polygon_.addAPolygon(createInnerWallShape(), ShapeBooleanOps::sub);
+	}
+};
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+	//----------------------------------------------------------------------
+	//	Parse the common benchmark command line and rescale the
+	//	spacing-dependent parameters before any body is created.
+	//----------------------------------------------------------------------
+	ScalingBenchmarkHarness harness("benchmark_scaling_dambreak_2d", ac, av);
+	particle_spacing_ref /= harness.ResolutionFactor();
+	BW = particle_spacing_ref * 4;
+	system_domain_bounds = BoundingBox(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+	//----------------------------------------------------------------------
+	//	Build up the environment of a SPHSystem.
+	//----------------------------------------------------------------------
+	SPHSystem sph_system(system_domain_bounds, particle_spacing_ref, harness.NumberOfThreads());
+	//----------------------------------------------------------------------
+	//	Creating bodies with corresponding materials and particles.
+	//----------------------------------------------------------------------
+	FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+	water_block.defineParticlesAndMaterial<FluidParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+	water_block.generateParticles<ParticleGeneratorLattice>();
+
+	SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary"));
+	wall_boundary.defineParticlesAndMaterial<SolidParticles, Solid>();
+	wall_boundary.generateParticles<ParticleGeneratorLattice>();
+	//----------------------------------------------------------------------
+	//	Define body relation map.
+	//----------------------------------------------------------------------
+	ComplexBodyRelation water_block_complex(water_block, {&wall_boundary});
+	//----------------------------------------------------------------------
+	//	Define the main numerical methods used in the simulation.
+	//----------------------------------------------------------------------
+	Gravity gravity(Vecd(0.0, -gravity_g));
+	SimpleDynamics<NormalDirectionFromBodyShape> wall_boundary_normal_direction(wall_boundary);
+	TimeStepInitialization fluid_step_initialization(water_block, gravity);
+	fluid_dynamics::DensitySummationFreeSurfaceComplex fluid_density_by_summation(water_block_complex);
+	fluid_dynamics::AdvectionTimeStepSize fluid_advection_time_step(water_block, U_max);
+	fluid_dynamics::AcousticTimeStepSize fluid_acoustic_time_step(water_block);
+	fluid_dynamics::PressureRelaxationRiemannWithWall fluid_pressure_relaxation(water_block_complex);
+	fluid_dynamics::DensityRelaxationRiemannWithWall fluid_density_relaxation(water_block_complex);
+	//----------------------------------------------------------------------
+	//	Prepare the simulation with cell linked list and configuration.
+	//----------------------------------------------------------------------
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+	wall_boundary_normal_direction.parallel_exec();
+	//----------------------------------------------------------------------
+	//	Setup for time-stepping control
+	//----------------------------------------------------------------------
+	size_t number_of_iterations = 0;
+	int screen_output_interval = 100;
+	Real End_Time = 2.0; /**< End time of the benchmark window. */
+	Real dt = 0.0;		 /**< Default acoustic time step sizes. */
+	//----------------------------------------------------------------------
+	//	Statistics for CPU time
+	//----------------------------------------------------------------------
+	tick_count t1 = tick_count::now();
+	//----------------------------------------------------------------------
+	//	Main loop starts here.
+	//----------------------------------------------------------------------
+	while (GlobalStaticVariables::physical_time_ < End_Time)
+	{
+		/** outer loop for dual-time criteria time-stepping. */
+		fluid_step_initialization.parallel_exec();
+		Real Dt = fluid_advection_time_step.parallel_exec();
+		fluid_density_by_summation.parallel_exec();
+
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			/** inner loop for dual-time criteria time-stepping.  */
+			fluid_pressure_relaxation.parallel_exec(dt);
+			fluid_density_relaxation.parallel_exec(dt);
+			dt = fluid_acoustic_time_step.parallel_exec();
+			relaxation_time += dt;
+			GlobalStaticVariables::physical_time_ += dt;
+		}
+
+		if (number_of_iterations % screen_output_interval == 0)
+		{
+			std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations << "	Time = "
+					  << GlobalStaticVariables::physical_time_
+					  << "	Dt = " << Dt << "	dt = " << dt << "\n";
+		}
+		number_of_iterations++;
+
+		/** Update cell linked list and configuration. */
+		water_block.updateCellLinkedList();
+		water_block_complex.updateConfiguration();
+	}
+	tick_count t2 = tick_count::now();
+	//----------------------------------------------------------------------
+	//	Report the per-phase timings and compare against the baseline.
+	//----------------------------------------------------------------------
+	size_t total_real_particles = water_block.base_particles_->total_real_particles_ +
+								  wall_boundary.base_particles_->total_real_particles_;
+	return harness.finish(total_real_particles, (t2 - t1).seconds());
+};
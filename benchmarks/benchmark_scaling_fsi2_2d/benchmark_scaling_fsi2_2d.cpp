@@ -0,0 +1,376 @@
+/**
+ * @file 	benchmark_scaling_fsi2_2d.cpp
+ * @brief 	Scaling benchmark of the flow-induced vibration of an elastic
+ * 			beam behind a cylinder.
+ * @details The physics follows tests/2d_examples/test_2d_fsi2 but the
+ * 			reference resolution and the thread count are taken from the
+ * 			common benchmark command line, the particles are generated on
+ * 			the lattice without a reload database, the state and regression
+ * 			output is dropped, and the per-phase timings are reported
+ * 			through the scaling benchmark harness for the nightly
+ * 			comparison against the stored baselines.
+ */
+#include "../scaling_benchmark_harness.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Basic geometry parameters and numerical setup.
+//----------------------------------------------------------------------
+Real DL = 11.0;							/**< Channel length. */
+Real DH = 4.1;							/**< Channel height. */
+Real resolution_ref = 0.1;				/**< Global reference resolution, divided by the resolution factor. */
+Real DL_sponge = resolution_ref * 20.0; /**< Sponge region to impose inflow condition. */
+Real BW = resolution_ref * 4.0;			/**< Boundary width, determined by specific layer of boundary particles. */
+Vec2d insert_circle_center(2.0, 2.0);	/**< Location of the cylinder center. */
+Real insert_circle_radius = 0.5;		/**< Radius of the cylinder. */
+/** Beam related parameters. */
+Real bh = 0.4 * insert_circle_radius; /**< Height of the beam. */
+Real bl = 7.0 * insert_circle_radius; /**< Length of the beam. */
+/** Domain bounds of the system. */
+BoundingBox system_domain_bounds(Vec2d(-DL_sponge - BW, -BW), Vec2d(DL + BW, DH + BW));
+//----------------------------------------------------------------------
+//	Global parameters on the fluid properties
+//----------------------------------------------------------------------
+Real rho0_f = 1.0;											  /**< Density. */
+Real U_f = 1.0;												  /**< Characteristic velocity. */
+Real c_f = 10.0 * U_f;										  /**< Speed of sound. */
+Real Re = 100.0;											  /**< Reynolds number. */
+Real mu_f = rho0_f * U_f * (2.0 * insert_circle_radius) / Re; /**< Dynamics viscosity. */
+//----------------------------------------------------------------------
+//	Global parameters on the solid properties
+//----------------------------------------------------------------------
+Real rho0_s = 10.0; /**< Reference density.*/
+Real poisson = 0.4; /**< Poisson ratio.*/
+Real Ae = 1.4e3;	/**< Normalized Youngs Modulus. */
+Real Youngs_modulus = Ae * rho0_f * U_f * U_f;
+//----------------------------------------------------------------------
+//	define geometry of SPH bodies
+//	The shapes are created after the command line is parsed, as the
+//	sponge length and the boundary width follow the chosen resolution.
+//----------------------------------------------------------------------
+/** create a water block shape */
+std::vector<Vecd> createWaterBlockShape()
+{
+	std::vector<Vecd> water_block_shape;
+	water_block_shape.push_back(Vecd(-DL_sponge, 0.0));
+	water_block_shape.push_back(Vecd(-DL_sponge, DH));
+	water_block_shape.push_back(Vecd(DL, DH));
+	water_block_shape.push_back(Vecd(DL, 0.0));
+	water_block_shape.push_back(Vecd(-DL_sponge, 0.0));
+
+	return water_block_shape;
+}
+/** create a beam shape */
+Real hbh = bh / 2.0;
+Vec2d BLB(insert_circle_center[0], insert_circle_center[1] - hbh);
+Vec2d BLT(insert_circle_center[0], insert_circle_center[1] + hbh);
+Vec2d BRB(insert_circle_center[0] + insert_circle_radius + bl, insert_circle_center[1] - hbh);
+Vec2d BRT(insert_circle_center[0] + insert_circle_radius + bl, insert_circle_center[1] + hbh);
+std::vector<Vecd> createBeamShape()
+{
+	std::vector<Vecd> beam_shape;
+	beam_shape.push_back(BLB);
+	beam_shape.push_back(BLT);
+	beam_shape.push_back(BRT);
+	beam_shape.push_back(BRB);
+	beam_shape.push_back(BLB);
+
+	return beam_shape;
+}
+/** create outer wall shape */
+std::vector<Vecd> createOuterWallShape()
+{
+	std::vector<Vecd> outer_wall_shape;
+	outer_wall_shape.push_back(Vecd(-DL_sponge - BW, -BW));
+	outer_wall_shape.push_back(Vecd(-DL_sponge - BW, DH + BW));
+	outer_wall_shape.push_back(Vecd(DL + BW, DH + BW));
+	outer_wall_shape.push_back(Vecd(DL + BW, -BW));
+	outer_wall_shape.push_back(Vecd(-DL_sponge - BW, -BW));
+
+	return outer_wall_shape;
+}
+/** create inner wall shape */
+std::vector<Vecd> createInnerWallShape()
+{
+	std::vector<Vecd> inner_wall_shape;
+	inner_wall_shape.push_back(Vecd(-DL_sponge - 2.0 * BW, 0.0));
+	inner_wall_shape.push_back(Vecd(-DL_sponge - 2.0 * BW, DH));
+	inner_wall_shape.push_back(Vecd(DL + 2.0 * BW, DH));
+	inner_wall_shape.push_back(Vecd(DL + 2.0 * BW, 0.0));
+	inner_wall_shape.push_back(Vecd(-DL_sponge - 2.0 * BW, 0.0));
+
+	return inner_wall_shape;
+}
+//----------------------------------------------------------------------
+//	Define case dependent geometrices
+//----------------------------------------------------------------------
+class WaterBlock : public MultiPolygonShape
+{
+public:
+	explicit WaterBlock(const std::string &shape_name) : MultiPolygonShape(shape_name)
+	{
+		multi_polygon_.addAPolygon(createWaterBlockShape(), ShapeBooleanOps::add);
+		multi_polygon_.addACircle(insert_circle_center, insert_circle_radius, 100, ShapeBooleanOps::sub);
+		multi_polygon_.addAPolygon(createBeamShape(), ShapeBooleanOps::sub);
+	}
+};
+class WallBoundary : public MultiPolygonShape
+{
+public:
+	explicit WallBoundary(const std::string &shape_name) : MultiPolygonShape(shape_name)
+	{
+		multi_polygon_.addAPolygon(createOuterWallShape(), ShapeBooleanOps::add);
+		multi_polygon_.addAPolygon(createInnerWallShape(), ShapeBooleanOps::sub);
+	}
+};
+class Insert : public MultiPolygonShape
+{
+public:
+	explicit Insert(const std::string &shape_name) : MultiPolygonShape(shape_name)
+	{
+		multi_polygon_.addACircle(insert_circle_center, insert_circle_radius, 100, ShapeBooleanOps::add);
+		multi_polygon_.addAPolygon(createBeamShape(), ShapeBooleanOps::add);
+	}
+};
+/** create the beam base as constrain shape. */
+MultiPolygon createBeamBaseShape()
+{
+	MultiPolygon multi_polygon;
+	multi_polygon.addACircle(insert_circle_center, insert_circle_radius, 100, ShapeBooleanOps::add);
+	multi_polygon.addAPolygon(createBeamShape(), ShapeBooleanOps::sub);
+	return multi_polygon;
+}
+/** create a inflow buffer shape. */
+MultiPolygon createInflowBufferShape()
+{
+	std::vector<Vecd> inflow_buffer_shape;
+	inflow_buffer_shape.push_back(Vecd(-DL_sponge, 0.0));
+	inflow_buffer_shape.push_back(Vecd(-DL_sponge, DH));
+	inflow_buffer_shape.push_back(Vecd(0.0, DH));
+	inflow_buffer_shape.push_back(Vecd(0.0, 0.0));
+	inflow_buffer_shape.push_back(Vecd(-DL_sponge, 0.0));
+
+	MultiPolygon multi_polygon;
+	multi_polygon.addAPolygon(inflow_buffer_shape, ShapeBooleanOps::add);
+	return multi_polygon;
+}
+/** Case dependent inflow boundary condition. */
+class ParabolicInflow : public fluid_dynamics::InflowBoundaryCondition
+{
+	Real u_ave_, u_ref_, t_ref;
+
+public:
+	ParabolicInflow(FluidBody &fluid_body, BodyPartByCell &constrained_region)
+		: InflowBoundaryCondition(fluid_body, constrained_region),
+		  u_ave_(0), u_ref_(1.0), t_ref(2.0) {}
+	Vecd getTargetVelocity(Vecd &position, Vecd &velocity) override
+	{
+		Real u = velocity[0];
+		Real v = velocity[1];
+		if (position[0] < 0.0)
+		{
+			u = 6.0 * u_ave_ * position[1] * (DH - position[1]) / DH / DH;
+			v = 0.0;
+		}
+		return Vecd(u, v);
+	}
+	void setupDynamics(Real dt = 0.0) override
+	{
+		Real run_time = GlobalStaticVariables::physical_time_;
+		u_ave_ = run_time < t_ref ? 0.5 * u_ref_ * (1.0 - cos(Pi * run_time / t_ref)) : u_ref_;
+	}
+};
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+	//----------------------------------------------------------------------
+	//	Parse the common benchmark command line and rescale the
+	//	resolution-dependent parameters before any body is created.
+	//----------------------------------------------------------------------
+	ScalingBenchmarkHarness harness("benchmark_scaling_fsi2_2d", ac, av);
+	resolution_ref /= harness.ResolutionFactor();
+	DL_sponge = resolution_ref * 20.0;
+	BW = resolution_ref * 4.0;
+	system_domain_bounds = BoundingBox(Vec2d(-DL_sponge - BW, -BW), Vec2d(DL + BW, DH + BW));
+	//----------------------------------------------------------------------
+	//	Build up the environment of a SPHSystem with global controls.
+	//----------------------------------------------------------------------
+	SPHSystem sph_system(system_domain_bounds, resolution_ref, harness.NumberOfThreads());
+	//----------------------------------------------------------------------
+	//	Creating body, materials and particles.
+	//----------------------------------------------------------------------
+	FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+	water_block.defineParticlesAndMaterial<FluidParticles, WeaklyCompressibleFluid>(rho0_f, c_f, mu_f);
+	water_block.generateParticles<ParticleGeneratorLattice>();
+
+	SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("Wall"));
+	wall_boundary.defineParticlesAndMaterial<SolidParticles, Solid>();
+	wall_boundary.generateParticles<ParticleGeneratorLattice>();
+
+	SolidBody insert_body(sph_system, makeShared<Insert>("InsertedBody"));
+	insert_body.sph_adaptation_->resetAdaptationRatios(1.15, 2.0);
+	insert_body.defineBodyLevelSetShape();
+	insert_body.defineParticlesAndMaterial<ElasticSolidParticles, LinearElasticSolid>(rho0_s, Youngs_modulus, poisson);
+	insert_body.generateParticles<ParticleGeneratorLattice>();
+	//----------------------------------------------------------------------
+	//	Define body relation map.
+	//	The contact map gives the topological connections between the bodies.
+	//	Basically the the range of bodies to build neighbor particle lists.
+	//----------------------------------------------------------------------
+	BodyRelationInner insert_body_inner(insert_body);
+	ComplexBodyRelation water_block_complex(water_block, RealBodyVector{&wall_boundary, &insert_body});
+	BodyRelationContact insert_body_contact(insert_body, {&water_block});
+	//----------------------------------------------------------------------
+	//	Define the main numerical methods used in the simulation.
+	//	Note that there may be data dependence on the constructors of these methods.
+	//----------------------------------------------------------------------
+	/** Initialize particle acceleration. */
+	TimeStepInitialization initialize_a_fluid_step(water_block);
+	/** Evaluation of density by summation approach. */
+	fluid_dynamics::DensitySummationComplex update_density_by_summation(water_block_complex);
+	/** Time step size without considering sound wave speed. */
+	fluid_dynamics::AdvectionTimeStepSize get_fluid_advection_time_step_size(water_block, U_f);
+	/** Time step size with considering sound wave speed. */
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_block);
+	/** Pressure relaxation using verlet time stepping. */
+	/** Here, we do not use Riemann solver for pressure as the flow is viscous. */
+	fluid_dynamics::PressureRelaxationWithWall pressure_relaxation(water_block_complex);
+	fluid_dynamics::DensityRelaxationRiemannWithWall density_relaxation(water_block_complex);
+	/** Computing viscous acceleration. */
+	fluid_dynamics::ViscousAccelerationWithWall viscous_acceleration(water_block_complex);
+	/** Impose transport velocity. */
+	fluid_dynamics::TransportVelocityCorrectionComplex transport_velocity_correction(water_block_complex);
+	/** viscous acceleration and transport velocity correction can be combined because they are independent dynamics. */
+	CombinedInteractionDynamics viscous_acceleration_and_transport_correction(viscous_acceleration, transport_velocity_correction);
+	/** Inflow boundary condition. */
+	BodyRegionByCell inflow_buffer(water_block, makeShared<MultiPolygonShape>(createInflowBufferShape()));
+	ParabolicInflow parabolic_inflow(water_block, inflow_buffer);
+	/** Periodic BCs in x direction. */
+	PeriodicConditionInAxisDirectionUsingCellLinkedList periodic_condition(water_block, xAxis);
+	//----------------------------------------------------------------------
+	//	Algorithms of FSI.
+	//----------------------------------------------------------------------
+	SimpleDynamics<NormalDirectionFromBodyShape> wall_boundary_normal_direction(wall_boundary);
+	SimpleDynamics<NormalDirectionFromBodyShape> insert_body_normal_direction(insert_body);
+	/** Corrected configuration for the elastic  insertbody. */
+	solid_dynamics::CorrectConfiguration insert_body_corrected_configuration(insert_body_inner);
+	/** Compute the force exerted on solid body due to fluid pressure and viscosity. */
+	solid_dynamics::FluidForceOnSolidUpdate fluid_force_on_solid_update(insert_body_contact);
+	/** Compute the average velocity of the insert body. */
+	solid_dynamics::AverageVelocityAndAcceleration average_velocity_and_acceleration(insert_body);
+	//----------------------------------------------------------------------
+	//	Algorithms of solid dynamics.
+	//----------------------------------------------------------------------
+	/** Compute time step size of elastic solid. */
+	solid_dynamics::AcousticTimeStepSize insert_body_computing_time_step_size(insert_body);
+	/** Stress relaxation for the inserted body. */
+	solid_dynamics::StressRelaxationFirstHalf insert_body_stress_relaxation_first_half(insert_body_inner);
+	solid_dynamics::StressRelaxationSecondHalf insert_body_stress_relaxation_second_half(insert_body_inner);
+	/** Constrain region of the inserted body. */
+	BodyRegionByParticle beam_base(insert_body, makeShared<MultiPolygonShape>(createBeamBaseShape()));
+	solid_dynamics::ConstrainSolidBodyRegion constrain_beam_base(insert_body, beam_base);
+	/** Update norm .*/
+	solid_dynamics::UpdateElasticNormalDirection insert_body_update_normal(insert_body);
+	//----------------------------------------------------------------------
+	//	Prepare the simulation with cell linked list, configuration
+	//	and case specified initial condition if necessary.
+	//----------------------------------------------------------------------
+	/** initialize cell linked lists for all bodies. */
+	sph_system.initializeSystemCellLinkedLists();
+	/** periodic condition applied after the mesh cell linked list build up
+	 * but before the configuration build up. */
+	periodic_condition.update_cell_linked_list_.parallel_exec();
+	/** initialize configurations for all bodies. */
+	sph_system.initializeSystemConfigurations();
+	/** computing surface normal direction for the wall. */
+	wall_boundary_normal_direction.parallel_exec();
+	/** computing surface normal direction for the insert body. */
+	insert_body_normal_direction.parallel_exec();
+	/** computing linear reproducing configuration for the insert body. */
+	insert_body_corrected_configuration.parallel_exec();
+	//----------------------------------------------------------------------
+	//	Setup computing and initial conditions.
+	//----------------------------------------------------------------------
+	size_t number_of_iterations = 0;
+	int screen_output_interval = 100;
+	Real End_Time = 5.0; /**< End time of the benchmark window. */
+	//----------------------------------------------------------------------
+	//	Statistics for CPU time
+	//----------------------------------------------------------------------
+	tick_count t1 = tick_count::now();
+	//----------------------------------------------------------------------
+	//	Main loop starts here.
+	//----------------------------------------------------------------------
+	while (GlobalStaticVariables::physical_time_ < End_Time)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		Real Dt = get_fluid_advection_time_step_size.parallel_exec();
+		update_density_by_summation.parallel_exec();
+		viscous_acceleration_and_transport_correction.parallel_exec(Dt);
+
+		/** FSI for viscous force. */
+		fluid_force_on_solid_update.viscous_force_.parallel_exec();
+		/** Update normal direction on elastic body.*/
+		insert_body_update_normal.parallel_exec();
+		size_t inner_ite_dt = 0;
+		size_t inner_ite_dt_s = 0;
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			Real dt = SMIN(get_fluid_time_step_size.parallel_exec(), Dt);
+			/** Fluid pressure relaxation */
+			pressure_relaxation.parallel_exec(dt);
+			/** FSI for pressure force. */
+			fluid_force_on_solid_update.parallel_exec();
+			/** Fluid density relaxation */
+			density_relaxation.parallel_exec(dt);
+
+			/** Solid dynamics. */
+			inner_ite_dt_s = 0;
+			Real dt_s_sum = 0.0;
+			average_velocity_and_acceleration.initialize_displacement_.parallel_exec();
+			while (dt_s_sum < dt)
+			{
+				Real dt_s = SMIN(insert_body_computing_time_step_size.parallel_exec(), dt - dt_s_sum);
+				insert_body_stress_relaxation_first_half.parallel_exec(dt_s);
+				constrain_beam_base.parallel_exec();
+				insert_body_stress_relaxation_second_half.parallel_exec(dt_s);
+				dt_s_sum += dt_s;
+				inner_ite_dt_s++;
+			}
+			average_velocity_and_acceleration.update_averages_.parallel_exec(dt);
+
+			relaxation_time += dt;
+			GlobalStaticVariables::physical_time_ += dt;
+			parabolic_inflow.parallel_exec();
+			inner_ite_dt++;
+		}
+
+		if (number_of_iterations % screen_output_interval == 0)
+		{
+			std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations << "	Time = "
+					  << GlobalStaticVariables::physical_time_
+					  << "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "	dt / dt_s = " << inner_ite_dt_s << "\n";
+		}
+		number_of_iterations++;
+
+		/** Water block configuration and periodic condition. */
+		periodic_condition.bounding_.parallel_exec();
+
+		water_block.updateCellLinkedList();
+		periodic_condition.update_cell_linked_list_.parallel_exec();
+		water_block_complex.updateConfiguration();
+		/** one need update configuration after periodic condition. */
+		insert_body.updateCellLinkedList();
+		insert_body_contact.updateConfiguration();
+	}
+	tick_count t2 = tick_count::now();
+	//----------------------------------------------------------------------
+	//	Report the per-phase timings and compare against the baseline.
+	//----------------------------------------------------------------------
+	size_t total_real_particles = water_block.base_particles_->total_real_particles_ +
+								  wall_boundary.base_particles_->total_real_particles_ +
+								  insert_body.base_particles_->total_real_particles_;
+	return harness.finish(total_real_particles, (t2 - t1).seconds());
+}
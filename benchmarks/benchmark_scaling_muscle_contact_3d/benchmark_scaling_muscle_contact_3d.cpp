@@ -0,0 +1,210 @@
+/**
+ * @file 	benchmark_scaling_muscle_contact_3d.cpp
+ * @brief 	Scaling benchmark of the 3D muscle compression with solid contact.
+ * @details The physics follows tests/3d_examples/test_3d_muscle_solid_contact
+ * 			but the reference resolution and the thread count are taken from
+ * 			the common benchmark command line, the state output is dropped,
+ * 			and the per-phase timings are reported through the scaling
+ * 			benchmark harness for the nightly comparison against the stored
+ * 			baselines.
+ */
+#include "../scaling_benchmark_harness.h"
+using namespace SPH;
+/** Geometry parameters. */
+Real L = 0.04;
+Real PL = 0.1;
+Real resolution_ref = L / 12.0; /**< Reference resolution, divided by the resolution factor. */
+Real BW = resolution_ref * 4;
+Vecd halfsize_myocardium(0.5 * L, 0.5 * L, 0.5 * L);
+Vecd translation_myocardium(0.5 * L, 0.0, 0.0);
+Vecd halfsize_stationary_plate(0.5 * BW, 0.5 * L + BW, 0.5 * L + BW);
+Vecd translation_stationary_plate(-0.5 * BW, 0.0, 0.0);
+Vecd halfsize_moving_plate(0.5 * BW, 0.5 * PL, 0.5 * PL);
+Vecd translation_moving_plate(L + BW, 0.0, 0.0);
+
+/** Domain bounds of the system. */
+BoundingBox system_domain_bounds(Vecd(-BW, -0.5 * PL, -0.5 * PL),
+								 Vecd(2.0 * L + BW, 0.5 * PL, 0.5 * PL));
+
+/** For material properties of the solid. */
+Real rho0_s = 1265.0;
+Real poisson = 0.45;
+Real Youngs_modulus = 5e4;
+Real physical_viscosity = 200.0;
+
+/** Define the myocardium body shape. */
+class Myocardium : public ComplexShape
+{
+public:
+	explicit Myocardium(const std::string &shape_name) : ComplexShape(shape_name)
+	{
+		add<TransformShape<GeometricShapeBox>>(translation_myocardium, halfsize_myocardium);
+		add<TransformShape<GeometricShapeBox>>(translation_stationary_plate, halfsize_stationary_plate);
+	}
+};
+/**
+* @brief define the moving plate shape
+*/
+class MovingPlate : public ComplexShape
+{
+public:
+	explicit MovingPlate(const std::string &shape_name) : ComplexShape(shape_name)
+	{
+		add<TransformShape<GeometricShapeBox>>(translation_moving_plate, halfsize_moving_plate);
+	}
+};
+/**
+ *  The main program
+ */
+int main(int ac, char *av[])
+{
+	/** Parse the common benchmark command line and rescale the
+	 * resolution-dependent parameters before any body is created. */
+	ScalingBenchmarkHarness harness("benchmark_scaling_muscle_contact_3d", ac, av);
+	resolution_ref = L / 12.0 / harness.ResolutionFactor();
+	BW = resolution_ref * 4;
+	halfsize_stationary_plate = Vecd(0.5 * BW, 0.5 * L + BW, 0.5 * L + BW);
+	translation_stationary_plate = Vecd(-0.5 * BW, 0.0, 0.0);
+	halfsize_moving_plate = Vecd(0.5 * BW, 0.5 * PL, 0.5 * PL);
+	translation_moving_plate = Vecd(L + BW, 0.0, 0.0);
+	system_domain_bounds = BoundingBox(Vecd(-BW, -0.5 * PL, -0.5 * PL),
+									   Vecd(2.0 * L + BW, 0.5 * PL, 0.5 * PL));
+	/** Setup the system. Please the make sure the global domain bounds are correctly defined. */
+	SPHSystem system(system_domain_bounds, resolution_ref, harness.NumberOfThreads());
+	/** Creat a Myocardium body, corresponding material, particles and reaction model. */
+	SolidBody myocardium_body(system, makeShared<Myocardium>("MyocardiumBody"));
+	myocardium_body.defineParticlesAndMaterial<ElasticSolidParticles, NeoHookeanSolid>(rho0_s, Youngs_modulus, poisson);
+	myocardium_body.generateParticles<ParticleGeneratorLattice>();
+	/** Plate. */
+	SolidBody moving_plate(system, makeShared<MovingPlate>("MovingPlate"));
+	moving_plate.defineParticlesAndMaterial<SolidParticles, LinearElasticSolid>(rho0_s, Youngs_modulus, poisson);
+	moving_plate.generateParticles<ParticleGeneratorLattice>();
+	/** topology */
+	BodyRelationInner myocardium_body_inner(myocardium_body);
+	SolidBodyRelationContact myocardium_plate_contact(myocardium_body, {&moving_plate});
+	SolidBodyRelationContact plate_myocardium_contact(moving_plate, {&myocardium_body});
+	/**
+	 * This section define all numerical methods will be used in this case.
+	 */
+	/** initialize a time step */
+	TimeStepInitialization myocardium_initialize_gravity(myocardium_body);
+	/** Corrected configuration. */
+	solid_dynamics::CorrectConfiguration corrected_configuration(myocardium_body_inner);
+	/** Time step size calculation. */
+	solid_dynamics::AcousticTimeStepSize computing_time_step_size(myocardium_body);
+	/** active and passive stress relaxation. */
+	solid_dynamics::StressRelaxationFirstHalf stress_relaxation_first_half(myocardium_body_inner);
+	solid_dynamics::StressRelaxationSecondHalf stress_relaxation_second_half(myocardium_body_inner);
+	/** Algorithms for solid-solid contact. */
+	solid_dynamics::ContactDensitySummation myocardium_update_contact_density(myocardium_plate_contact);
+	solid_dynamics::ContactForce myocardium_compute_solid_contact_forces(myocardium_plate_contact);
+	/** Algorithms for solid-solid contact. */
+	solid_dynamics::ContactDensitySummation plate_update_contact_density(plate_myocardium_contact);
+	solid_dynamics::ContactForce plate_compute_solid_contact_forces(plate_myocardium_contact);
+	/** Constrain the holder. */
+	BodyRegionByParticle holder(myocardium_body,
+		makeShared<TransformShape<GeometricShapeBox>>(translation_stationary_plate, halfsize_stationary_plate, "Holder"));
+	solid_dynamics::ConstrainSolidBodyRegion	constrain_holder(myocardium_body, holder);
+	/** Damping with the solid body*/
+	DampingWithRandomChoice<DampingPairwiseInner<Vec3d>>
+		muscle_damping(0.1, myocardium_body_inner, "Velocity", physical_viscosity);
+	/** Simbody interface. */
+	/**
+	* The multi body system from simbody.
+	*/
+	SimTK::MultibodySystem MBsystem;
+	/** The bodies or matter of the MBsystem. */
+	SimTK::SimbodyMatterSubsystem matter(MBsystem);
+	/** The forces of the MBsystem.*/
+	SimTK::GeneralForceSubsystem forces(MBsystem);
+	SimTK::CableTrackerSubsystem cables(MBsystem);
+	/** mass proeprties of the fixed spot. */
+	SolidBodyPartForSimbody plate_multibody(moving_plate,
+		makeShared<TransformShape<GeometricShapeBox>>(translation_moving_plate, halfsize_moving_plate, "Plate"));
+	/** Mass properties of the consrained spot.
+	 * SimTK::MassProperties(mass, center of mass, inertia)
+	 */
+	SimTK::Body::Rigid rigid_info(*plate_multibody.body_part_mass_properties_);
+	SimTK::MobilizedBody::Slider
+		plateMBody(matter.Ground(), SimTK::Transform(SimTK::Vec3(0)), rigid_info, SimTK::Transform(SimTK::Vec3(0)));
+	/** Gravity. */
+	SimTK::Force::UniformGravity sim_gravity(forces, matter, SimTK::Vec3(Real(-100.0), 0.0, 0.0));
+	/** discrete forces acting on the bodies. */
+	SimTK::Force::DiscreteForces force_on_bodies(forces, matter);
+	/** Damper. */
+	SimTK::Force::MobilityLinearDamper linear_damper(forces, plateMBody, SimTK::MobilizerUIndex(0), 20.0);
+	/** Time steping method for multibody system.*/
+	SimTK::State state = MBsystem.realizeTopology();
+	SimTK::RungeKuttaMersonIntegrator integ(MBsystem);
+	integ.setAccuracy(1e-3);
+	integ.setAllowInterpolation(false);
+	integ.initialize(state);
+	/** Coupling between SimBody and SPH.*/
+	solid_dynamics::TotalForceOnSolidBodyPartForSimBody
+		force_on_plate(moving_plate, plate_multibody, MBsystem, plateMBody, force_on_bodies, integ);
+	solid_dynamics::ConstrainSolidBodyPartBySimBody
+		constraint_plate(moving_plate, plate_multibody, MBsystem, plateMBody, force_on_bodies, integ);
+	/**
+	 * From here the time stepping begines.
+	 * Set the starting time.
+	 */
+	GlobalStaticVariables::physical_time_ = 0.0;
+	system.initializeSystemCellLinkedLists();
+	system.initializeSystemConfigurations();
+	/** apply initial condition */
+	corrected_configuration.parallel_exec();
+	/** Setup physical parameters. */
+	int ite = 0;
+	Real end_time = 0.05; /**< End time of the benchmark window. */
+	Real dt = 0.0;
+	/** Statistics for computing time. */
+	tick_count t1 = tick_count::now();
+	/**
+	 * Main loop
+	 */
+	while (GlobalStaticVariables::physical_time_ < end_time)
+	{
+		if (ite % 100 == 0)
+		{
+			std::cout << "N=" << ite << " Time: "
+					  << GlobalStaticVariables::physical_time_ << "	dt: "
+					  << dt << "\n";
+		}
+		/** Gravity. */
+		myocardium_initialize_gravity.parallel_exec();
+		/** Contact model for myocardium. */
+		myocardium_update_contact_density.parallel_exec();
+		myocardium_compute_solid_contact_forces.parallel_exec();
+		/** Contact model for plate. */
+		plate_update_contact_density.parallel_exec();
+		plate_compute_solid_contact_forces.parallel_exec();
+		{
+			SimTK::State &state_for_update = integ.updAdvancedState();
+			force_on_bodies.clearAllBodyForces(state_for_update);
+			force_on_bodies.setOneBodyForce(state_for_update, plateMBody, force_on_plate.parallel_exec());
+			integ.stepBy(dt);
+			constraint_plate.parallel_exec();
+		}
+		/** Stress relaxation and damping. */
+		stress_relaxation_first_half.parallel_exec(dt);
+		constrain_holder.parallel_exec(dt);
+		muscle_damping.parallel_exec(dt);
+		constrain_holder.parallel_exec(dt);
+		stress_relaxation_second_half.parallel_exec(dt);
+
+		ite++;
+		dt = computing_time_step_size.parallel_exec();
+		GlobalStaticVariables::physical_time_ += dt;
+
+		myocardium_body.updateCellLinkedList();
+		moving_plate.updateCellLinkedList();
+
+		myocardium_plate_contact.updateConfiguration();
+		plate_myocardium_contact.updateConfiguration();
+	}
+	tick_count t2 = tick_count::now();
+	/** Report the per-phase timings and compare against the baseline. */
+	size_t total_real_particles = myocardium_body.base_particles_->total_real_particles_ +
+								  moving_plate.base_particles_->total_real_particles_;
+	return harness.finish(total_real_particles, (t2 - t1).seconds());
+}
@@ -0,0 +1,105 @@
+# !/usr/bin/env python3
+"""
+Nightly driver of the whole-simulation scaling benchmarks.
+
+The driver sweeps the scaling benchmark executables over a matrix of
+resolution factors and thread counts, collects the per-phase timing reports
+written by the scaling benchmark harness and compares them against the
+stored baselines with the configurable regression threshold. The exit code
+is the total number of regressed phases over the whole sweep, so the
+nightly job fails when any phase slows down beyond the threshold.
+
+Usage:
+    run_scaling_benchmarks.py --build-dir <build> [--baseline-dir <dir>]
+        [--report-dir <dir>] [--resolution-factors 1.0 2.0]
+        [--thread-counts 1 4] [--threshold 0.1] [--update-baselines]
+
+With --update-baselines the fresh reports are copied over the stored
+baselines instead of being compared, which is how a new baseline set is
+recorded after an intended performance change.
+
+The benchmarks are built with the BUILD_SPHINXSYS_BENCHMARKS option and the
+executables are located under <build>/benchmarks/<benchmark>/bin/.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+BENCHMARKS = [
+    "benchmark_scaling_dambreak_2d",
+    "benchmark_scaling_fsi2_2d",
+    "benchmark_scaling_muscle_contact_3d",
+]
+
+
+def sweep_point_tag(resolution_factor, thread_count):
+    return "res_%s_threads_%d" % (str(resolution_factor).replace(".", "p"), thread_count)
+
+
+def locate_executable(build_dir, benchmark):
+    executable = os.path.join(build_dir, "benchmarks", benchmark, "bin", benchmark)
+    if os.name == "nt":
+        executable += ".exe"
+    if not os.path.isfile(executable):
+        print("Error: the benchmark executable %s is not found," % executable)
+        print("please configure the build with BUILD_SPHINXSYS_BENCHMARKS=ON.")
+        sys.exit(1)
+    return executable
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the scaling benchmark sweep.")
+    parser.add_argument("--build-dir", required=True, help="the cmake build directory")
+    parser.add_argument("--baseline-dir", default=os.path.join(os.path.dirname(__file__), "scaling_baselines"),
+                        help="the directory of the stored baseline reports")
+    parser.add_argument("--report-dir", default="scaling_reports",
+                        help="the directory receiving the fresh reports")
+    parser.add_argument("--resolution-factors", nargs="+", type=float, default=[1.0, 2.0],
+                        help="the resolution factors of the sweep")
+    parser.add_argument("--thread-counts", nargs="+", type=int, default=[1, 4],
+                        help="the thread counts of the sweep")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="the relative regression threshold of the comparison")
+    parser.add_argument("--update-baselines", action="store_true",
+                        help="record the fresh reports as the new baselines")
+    args = parser.parse_args()
+
+    os.makedirs(args.report_dir, exist_ok=True)
+    if args.update_baselines:
+        os.makedirs(args.baseline_dir, exist_ok=True)
+
+    total_regressed_phases = 0
+    for benchmark in BENCHMARKS:
+        executable = locate_executable(args.build_dir, benchmark)
+        for resolution_factor in args.resolution_factors:
+            for thread_count in args.thread_counts:
+                tag = sweep_point_tag(resolution_factor, thread_count)
+                report_file = os.path.join(args.report_dir, "%s_%s.tsv" % (benchmark, tag))
+                baseline_file = os.path.join(args.baseline_dir, "%s_%s.tsv" % (benchmark, tag))
+                command = [executable, str(resolution_factor), str(thread_count), report_file]
+                compared = not args.update_baselines and os.path.isfile(baseline_file)
+                if compared:
+                    command += [baseline_file, str(args.threshold)]
+                print("Running %s at the sweep point %s ..." % (benchmark, tag))
+                completed = subprocess.run(command, cwd=os.path.dirname(executable))
+                if compared:
+                    total_regressed_phases += completed.returncode
+                elif completed.returncode != 0:
+                    print("Error: %s failed with the exit code %d." % (benchmark, completed.returncode))
+                    sys.exit(1)
+                if args.update_baselines:
+                    shutil.copyfile(report_file, baseline_file)
+                    print("Baseline %s updated." % baseline_file)
+
+    if total_regressed_phases == 0:
+        print("The scaling benchmark sweep finished without regressions.")
+    else:
+        print("The scaling benchmark sweep found %d regressed phases." % total_regressed_phases)
+    sys.exit(total_regressed_phases)
+
+
+if __name__ == "__main__":
+    main()
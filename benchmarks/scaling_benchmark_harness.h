@@ -0,0 +1,160 @@
+/* ---------------------------------------------------------------------------*
+*        SPHinXsys: shared harness of the whole-simulation scaling            *
+*                             benchmarks                                      *
+* ----------------------------------------------------------------------------*
+* The scaling benchmarks run standardized cases at parameterized particle     *
+* and thread counts. This harness parses their common command line, switches  *
+* on the particle dynamics timing surface, writes the accumulated per-phase   *
+* timings as a machine-readable tab-separated report and compares the report  *
+* against a stored baseline with a configurable regression threshold, so      *
+* that a nightly run fails when a phase slows down beyond the threshold.      *
+*                                                                             *
+* Common usage of the benchmarks:                                             *
+*   <benchmark> [resolution_factor = 1.0] [number_of_threads = hardware]      *
+*               [report_file = <benchmark>_report.tsv]                        *
+*               [baseline_file = none] [regression_threshold = 0.1]           *
+* The exit code is the number of regressed phases when a baseline is given.   *
+* ---------------------------------------------------------------------------*/
+
+#ifndef SCALING_BENCHMARK_HARNESS_H
+#define SCALING_BENCHMARK_HARNESS_H
+
+#include "sphinxsys.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace SPH
+{
+	/**
+	 * @class ScalingBenchmarkHarness
+	 * @brief Command line, report and baseline comparison shared by the
+	 * whole-simulation scaling benchmarks.
+	 */
+	class ScalingBenchmarkHarness
+	{
+	public:
+		ScalingBenchmarkHarness(const std::string &benchmark_name, int ac, char *av[])
+			: benchmark_name_(benchmark_name),
+			  resolution_factor_(ac > 1 ? std::stod(av[1]) : 1.0),
+			  number_of_threads_(ac > 2 ? std::stoul(av[2]) : std::thread::hardware_concurrency()),
+			  report_file_(ac > 3 ? av[3] : benchmark_name + "_report.tsv"),
+			  baseline_file_(ac > 4 ? av[4] : ""),
+			  regression_threshold_(ac > 5 ? std::stod(av[5]) : 0.1)
+		{
+			/** the per-phase wall clocks accumulate in the global timing registry. */
+			ParticleDynamicsTiming::switchOn();
+			std::cout << benchmark_name_ << ": resolution factor " << resolution_factor_
+					  << ", " << number_of_threads_ << " threads" << "\n";
+		};
+
+		Real ResolutionFactor() { return resolution_factor_; };
+		size_t NumberOfThreads() { return number_of_threads_; };
+
+		/** write the report and, when a baseline is stored, the comparison;
+		 * the return value is the number of regressed phases, to be used as
+		 * the process exit code. */
+		int finish(size_t total_real_particles, Real total_wall_seconds)
+		{
+			std::cout << benchmark_name_ << ": " << total_real_particles << " particles, "
+					  << total_wall_seconds << " seconds total wall time" << "\n";
+			writeReport(total_real_particles, total_wall_seconds);
+			return baseline_file_.empty()
+					   ? 0
+					   : compareWithBaseline(total_wall_seconds);
+		};
+
+	protected:
+		std::string benchmark_name_;
+		Real resolution_factor_;
+		size_t number_of_threads_;
+		std::string report_file_;
+		std::string baseline_file_;
+		Real regression_threshold_;
+
+		/** one tab-separated row per phase; the phase names are the demangled
+		 * dynamics type names of the timing registry, plus the total. */
+		void writeReport(size_t total_real_particles, Real total_wall_seconds)
+		{
+			std::ofstream out_file(report_file_.c_str(), std::ios::trunc);
+			out_file << "benchmark\tresolution_factor\tthreads\tparticles\tphase\tcalls\tseconds\n";
+			out_file << benchmark_name_ << '\t' << resolution_factor_ << '\t' << number_of_threads_
+					 << '\t' << total_real_particles << '\t' << "total" << '\t' << 1
+					 << '\t' << total_wall_seconds << "\n";
+			StdVec<ParticleDynamicsTiming *> &timings = ParticleDynamicsTiming::RegisteredTimings();
+			for (size_t k = 0; k != timings.size(); ++k)
+			{
+				out_file << benchmark_name_ << '\t' << resolution_factor_ << '\t' << number_of_threads_
+						 << '\t' << total_real_particles << '\t' << timings[k]->name_
+						 << '\t' << timings[k]->call_count_ << '\t' << timings[k]->accumulated_seconds_ << "\n";
+			}
+			out_file.close();
+			std::cout << benchmark_name_ << ": report written to " << report_file_ << "\n";
+		};
+
+		/** the baseline is a report of an earlier run at the same sweep point. */
+		int compareWithBaseline(Real total_wall_seconds)
+		{
+			if (!fs::exists(baseline_file_))
+			{
+				std::cout << "\n Error: the baseline file:" << baseline_file_ << " is not exists" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+
+			std::ifstream in_file(baseline_file_.c_str());
+			std::string line;
+			std::getline(in_file, line); /**< the header line. */
+			std::map<std::string, Real> baseline_seconds;
+			while (std::getline(in_file, line))
+			{
+				std::istringstream line_stream(line);
+				StdVec<std::string> fields;
+				std::string field;
+				while (std::getline(line_stream, field, '\t'))
+					fields.push_back(field);
+				if (fields.size() < 7)
+					continue;
+
+				if (std::stod(fields[1]) != resolution_factor_ ||
+					std::stoul(fields[2]) != number_of_threads_)
+				{
+					std::cout << "\n Error: the baseline file:" << baseline_file_
+							  << " is recorded at another sweep point" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+				baseline_seconds[fields[4]] = std::stod(fields[6]);
+			}
+			in_file.close();
+
+			int regressed_phases = 0;
+			auto checkPhase = [&](const std::string &phase, Real seconds)
+			{
+				std::map<std::string, Real>::iterator located = baseline_seconds.find(phase);
+				if (located == baseline_seconds.end())
+					return; /**< new phases have no baseline yet. */
+				if (seconds > located->second * (1.0 + regression_threshold_))
+				{
+					std::cout << " Regression: " << phase << " takes " << seconds
+							  << " seconds against the baseline of " << located->second << " seconds." << "\n";
+					regressed_phases++;
+				}
+			};
+			checkPhase("total", total_wall_seconds);
+			StdVec<ParticleDynamicsTiming *> &timings = ParticleDynamicsTiming::RegisteredTimings();
+			for (size_t k = 0; k != timings.size(); ++k)
+				checkPhase(timings[k]->name_, timings[k]->accumulated_seconds_);
+
+			if (regressed_phases == 0)
+				std::cout << benchmark_name_ << ": no phase regressed beyond the threshold of "
+						  << regression_threshold_ << "." << "\n";
+			else
+				std::cout << benchmark_name_ << ": " << regressed_phases
+						  << " phases regressed beyond the threshold of " << regression_threshold_ << "." << "\n";
+			return regressed_phases;
+		};
+	};
+}
+#endif // SCALING_BENCHMARK_HARNESS_H
@@ -8,6 +8,10 @@
 
 #include "structural_simulation_class.h"
 
+#include "tbb/task_group.h"
+
+#include <mutex>
+
 ////////////////////////////////////////////////////
 /* global functions in StructuralSimulation  */
 ////////////////////////////////////////////////////
@@ -64,6 +68,18 @@ void expandBoundingBox(BoundingBox *original, BoundingBox *additional)
 	}
 }
 
+bool boundingBoxesOverlap(const BoundingBox &first, const BoundingBox &second, Real inflation)
+{
+	for (int i = 0; i < first.first.size(); i++)
+	{
+		if (first.second[i] + inflation < second.first[i] || second.second[i] + inflation < first.first[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void relaxParticlesSingleResolution(InOutput &in_output,
 									bool write_particle_relaxation_data,
 									SolidBody &solid_body_from_mesh,
@@ -123,9 +139,16 @@ std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>> generateAndRelaxParticlesFromMe
 
 	if (particle_relaxation)
 	{
-		InOutput in_output(system);
+		// the InOutput constructor cleans and recreates the shared output folders,
+		// which must not happen concurrently when several bodies are relaxed in parallel
+		static std::mutex in_output_creation_mutex;
+		std::unique_ptr<InOutput> in_output;
+		{
+			std::lock_guard<std::mutex> lock(in_output_creation_mutex);
+			in_output = std::unique_ptr<InOutput>(new InOutput(system));
+		}
 		BodyRelationInner inner_relation(model);
-		relaxParticlesSingleResolution(in_output, write_particle_relaxation_data, model, inner_relation);
+		relaxParticlesSingleResolution(*in_output, write_particle_relaxation_data, model, inner_relation);
 	}
 
 	return std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>>(model.base_particles_->pos_n_, model.base_particles_->Vol_);
@@ -312,38 +335,59 @@ void StructuralSimulation::calculateSystemBoundaries()
 void StructuralSimulation::createBodyMeshList()
 {
 	body_mesh_list_ = {};
+	body_mesh_list_.resize(imported_stl_list_.size());
+	// the stl files are imported independently of each other
+	tbb::task_group import_tasks;
 	for (size_t i = 0; i < imported_stl_list_.size(); i++)
 	{
-		string relative_input_path_copy = relative_input_path_;
+		import_tasks.run([this, i]
+						 {
+							 string relative_input_path_copy = relative_input_path_;
 #ifdef __EMSCRIPTEN__
-		body_mesh_list_.push_back(make_shared<TriangleMeshShapeSTL>(reinterpret_cast<const uint8_t *>(imported_stl_list_[i].ptr), translation_list_[i], scale_stl_, imported_stl_list_[i].name));
+							 body_mesh_list_[i] = make_shared<TriangleMeshShapeSTL>(reinterpret_cast<const uint8_t *>(imported_stl_list_[i].ptr), translation_list_[i], scale_stl_, imported_stl_list_[i].name);
 #else
-		body_mesh_list_.push_back(make_shared<TriangleMeshShapeSTL>(relative_input_path_copy.append(imported_stl_list_[i]), translation_list_[i], scale_stl_, imported_stl_list_[i]));
+							 body_mesh_list_[i] = make_shared<TriangleMeshShapeSTL>(relative_input_path_copy.append(imported_stl_list_[i]), translation_list_[i], scale_stl_, imported_stl_list_[i]);
 #endif
+						 });
 	}
+	import_tasks.wait();
 }
 
 void StructuralSimulation::initializeElasticSolidBodies()
 {
 	solid_body_list_ = {};
 	particle_normal_update_ = {};
+	// create the initial particles from the triangle mesh shapes with particle relaxation option;
+	// each body works on its own private SPHSystem, so the bodies are generated and
+	// relaxed independently of each other
+	vector<std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>>> particles_list(body_mesh_list_.size());
+	if (!write_particle_relaxation_data_)
+	{
+		tbb::task_group generation_tasks;
+		for (size_t i = 0; i < body_mesh_list_.size(); i++)
+		{
+			generation_tasks.run([this, i, &particles_list]
+								 { particles_list[i] = generateAndRelaxParticlesFromMesh(
+									   body_mesh_list_[i], resolution_list_[i], particle_relaxation_list_[i], false); });
+		}
+		generation_tasks.wait();
+	}
+	else
+	{
+		// keep the relaxation output deterministic when it is written to disk
+		for (size_t i = 0; i < body_mesh_list_.size(); i++)
+		{
+			particles_list[i] = generateAndRelaxParticlesFromMesh(
+				body_mesh_list_[i], resolution_list_[i], particle_relaxation_list_[i], true);
+		}
+	}
+	// register the bodies into the shared system in the input order,
+	// which defines the body indexes used by the body index based input
 	for (size_t i = 0; i < body_mesh_list_.size(); i++)
 	{
-		string temp_name = "";
-#ifdef __EMSCRIPTEN__
-		temp_name.append(imported_stl_list_[i].name);
-#else  // __EMSCRIPTEN__
-		temp_name.append(imported_stl_list_[i]);
-#endif // __EMSCRIPTEN__
-	   // we delete the .stl ending
-		temp_name.erase(temp_name.size() - 4);
-		// create the initial particles from the triangle mesh shape with particle relaxation option
-		std::tuple<StdLargeVec<Vecd>, StdLargeVec<Real>> particles = 
-			generateAndRelaxParticlesFromMesh(body_mesh_list_[i], resolution_list_[i], particle_relaxation_list_[i], write_particle_relaxation_data_);
-
 		// get the particles' initial position and their volume
-		StdLargeVec<Vecd> &pos_0 = std::get<0>(particles);
-		StdLargeVec<Real> &volume = std::get<1>(particles);
+		StdLargeVec<Vecd> &pos_0 = std::get<0>(particles_list[i]);
+		StdLargeVec<Real> &volume = std::get<1>(particles_list[i]);
 
 		// create the SolidBodyForSimulation
 		solid_body_list_.emplace_back(make_shared<SolidBodyForSimulation>(
@@ -370,11 +414,24 @@ void StructuralSimulation::initializeContactBetweenTwoBodies(int first, int seco
 	contact_force_list_.push_back(make_shared<solid_dynamics::ContactForce>(*contact_list_[last]));
 }
 
+Real StructuralSimulation::contactAABBInflation(int first, int second)
+{
+	// the cutoff of the contact interaction is about 3 body resolutions
+	// (2.6 smoothing lengths with a smoothing length ratio of 1.15);
+	// one extra resolution gives headroom so that a deferred pair is
+	// activated before the bodies actually touch
+	return 4.0 * SMAX(resolution_list_[first], resolution_list_[second]);
+}
+
 void StructuralSimulation::initializeAllContacts()
 {
 	contact_list_ = {};
 	contact_density_list_ = {};
 	contact_force_list_ = {};
+	deferred_contact_pairs_ = {};
+	deferred_contact_list_ = {};
+	deferred_contact_density_list_ = {};
+	deferred_contact_force_list_ = {};
 	// first place all the regular contacts into the lists
 	for (size_t i = 0; i < contacting_body_pairs_list_.size(); i++)
 	{
@@ -383,7 +440,18 @@ void StructuralSimulation::initializeAllContacts()
 
 		for (size_t target_i : contacting_body_pairs_list_[i])
 		{
-			target_list.emplace_back(solid_body_list_[target_i]->getSolidBodyFromMesh());
+			// defer the targets that are not close to the contact body at setup;
+			// their pair dynamics are only built on first actual proximity
+			BoundingBox contact_bounds = body_mesh_list_[i]->findBounds();
+			BoundingBox target_bounds = body_mesh_list_[target_i]->findBounds();
+			if (boundingBoxesOverlap(contact_bounds, target_bounds, contactAABBInflation(i, target_i)))
+			{
+				target_list.emplace_back(solid_body_list_[target_i]->getSolidBodyFromMesh());
+			}
+			else
+			{
+				deferred_contact_pairs_.push_back({int(i), int(target_i)});
+			}
 		}
 
 		contact_list_.emplace_back(make_shared<SolidBodyRelationContact>(*contact_body, target_list));
@@ -608,18 +676,26 @@ void StructuralSimulation::initializeTranslateSolidBodyPart()
 
 void StructuralSimulation::executeInitialNormalDirection()
 {
+	// the initial normal directions of the bodies are independent
+	tbb::task_group body_tasks;
 	for (size_t i = 0; i < solid_body_list_.size(); i++)
 	{
-		solid_body_list_[i]->getInitialNormalDirection()->parallel_exec();
+		body_tasks.run([this, i]
+					   { solid_body_list_[i]->getInitialNormalDirection()->parallel_exec(); });
 	}
+	body_tasks.wait();
 }
 
 void StructuralSimulation::executeCorrectConfiguration()
 {
+	// the correction matrices only use the inner configuration of their own body
+	tbb::task_group body_tasks;
 	for (size_t i = 0; i < solid_body_list_.size(); i++)
 	{
-		solid_body_list_[i]->getCorrectConfiguration()->parallel_exec();
+		body_tasks.run([this, i]
+					   { solid_body_list_[i]->getCorrectConfiguration()->parallel_exec(); });
 	}
+	body_tasks.wait();
 }
 
 void StructuralSimulation::executeUpdateElasticNormalDirection()
@@ -701,6 +777,11 @@ void StructuralSimulation::executeContactDensitySummation()
 			}
 		}
 	}
+	// contacts that were deferred at setup and have become active
+	for (size_t i = 0; i < deferred_contact_density_list_.size(); i++)
+	{
+		deferred_contact_density_list_[i]->parallel_exec();
+	}
 }
 
 void StructuralSimulation::executeContactForce()
@@ -726,6 +807,11 @@ void StructuralSimulation::executeContactForce()
 			}
 		}
 	}
+	// contacts that were deferred at setup and have become active
+	for (size_t i = 0; i < deferred_contact_force_list_.size(); i++)
+	{
+		deferred_contact_force_list_[i]->parallel_exec();
+	}
 }
 
 void StructuralSimulation::executeStressRelaxationFirstHalf(Real dt)
@@ -810,6 +896,9 @@ void StructuralSimulation::executeUpdateCellLinkedList()
 
 void StructuralSimulation::executeContactUpdateConfiguration()
 {
+	// the relations active in this step; the shared broadphase then rasterizes
+	// their bodies once and runs the narrowphase of the overlapping pairs only
+	StdVec<SolidBodyRelationContact *> active_contact_relations;
 	// number of contacts that are not time dependent: contact pairs * 2
 	size_t number_of_general_contacts = contacting_body_pairs_list_.size();
 	for (size_t i = 0; i < contact_list_.size(); i++)
@@ -817,7 +906,7 @@ void StructuralSimulation::executeContactUpdateConfiguration()
 		// general contacts = contacting_bodies * 2
 		if (i < number_of_general_contacts)
 		{
-			contact_list_[i]->updateConfiguration();
+			active_contact_relations.push_back(contact_list_[i].get());
 		}
 		// time dependent contacts = time dep. contacting_bodies * 2
 		else
@@ -829,10 +918,61 @@ void StructuralSimulation::executeContactUpdateConfiguration()
 			Real end_time = time_dep_contacting_body_pairs_list_[index].second[1];
 			if (GlobalStaticVariables::physical_time_ >= start_time && GlobalStaticVariables::physical_time_ <= end_time)
 			{
-				contact_list_[i]->updateConfiguration();
+				active_contact_relations.push_back(contact_list_[i].get());
+			}
+		}
+	}
+	// contacts that were deferred at setup and have become active
+	for (size_t i = 0; i < deferred_contact_list_.size(); i++)
+	{
+		active_contact_relations.push_back(deferred_contact_list_[i].get());
+	}
+	contact_broadphase_.updateConfigurations(active_contact_relations);
+}
+
+void StructuralSimulation::updateDeferredContacts()
+{
+	if (deferred_contact_pairs_.empty())
+		return;
+
+	// current AABBs of the bodies taking part in at least one deferred pair
+	std::map<int, BoundingBox> body_bounds;
+	for (size_t n = 0; n < deferred_contact_pairs_.size(); n++)
+	{
+		for (int body_index : deferred_contact_pairs_[n])
+		{
+			if (body_bounds.count(body_index) == 0)
+			{
+				SolidBodyFromMesh *body = solid_body_list_[body_index]->getSolidBodyFromMesh();
+				Vecd lower_bound = BodyLowerBound(*body).parallel_exec();
+				Vecd upper_bound = BodyUpperBound(*body).parallel_exec();
+				body_bounds[body_index] = BoundingBox(lower_bound, upper_bound);
 			}
 		}
 	}
+
+	size_t n = 0;
+	while (n < deferred_contact_pairs_.size())
+	{
+		int first = deferred_contact_pairs_[n][0];
+		int second = deferred_contact_pairs_[n][1];
+		if (boundingBoxesOverlap(body_bounds[first], body_bounds[second], contactAABBInflation(first, second)))
+		{
+			// the bodies are close for the first time: build the pair dynamics now;
+			// the configuration is built by executeContactUpdateConfiguration
+			SolidBodyFromMesh *first_body = solid_body_list_[first]->getSolidBodyFromMesh();
+			SolidBodyFromMesh *second_body = solid_body_list_[second]->getSolidBodyFromMesh();
+			deferred_contact_list_.emplace_back(make_shared<SolidBodyRelationContact>(*first_body, RealBodyVector({second_body})));
+			int last = deferred_contact_list_.size() - 1;
+			deferred_contact_density_list_.emplace_back(make_shared<solid_dynamics::ContactDensitySummation>(*deferred_contact_list_[last]));
+			deferred_contact_force_list_.emplace_back(make_shared<solid_dynamics::ContactForce>(*deferred_contact_list_[last]));
+			deferred_contact_pairs_.erase(deferred_contact_pairs_.begin() + n);
+		}
+		else
+		{
+			n++;
+		}
+	}
 }
 
 void StructuralSimulation::initializeSimulation()
@@ -899,6 +1039,9 @@ void StructuralSimulation::runSimulationStep(Real &dt, Real &integration_time)
 	/** UPDATE BODIES CELL LINKED LISTS */
 	executeUpdateCellLinkedList();
 
+	/** ACTIVATE THE CONTACTS DEFERRED AT SETUP ON FIRST PROXIMITY */
+	updateDeferredContacts();
+
 	/** UPDATE CONTACT CONFIGURATION */
 	executeContactUpdateConfiguration();
 }
@@ -96,6 +96,8 @@ public:
 
 void expandBoundingBox(BoundingBox *original, BoundingBox *additional);
 
+bool boundingBoxesOverlap(const BoundingBox &first, const BoundingBox &second, Real inflation);
+
 void relaxParticlesSingleResolution(InOutput &in_output,
 									bool write_particles_to_file,
 									SolidBodyFromMesh &solid_body_from_mesh,
@@ -189,6 +191,16 @@ protected:
 	vector<shared_ptr<SolidBodyRelationContact>> contact_list_;
 	vector<shared_ptr<solid_dynamics::ContactDensitySummation>> contact_density_list_;
 	vector<shared_ptr<solid_dynamics::ContactForce>> contact_force_list_;
+	// shared broadphase over all contact-enabled bodies, feeding only the
+	// actually overlapping pairs to the per-pair configuration updates
+	SolidContactBroadphase contact_broadphase_;
+
+	// contact pairs whose inflated AABBs do not overlap at setup;
+	// their relations and dynamics are only built on first actual proximity
+	vector<array<int, 2>> deferred_contact_pairs_;
+	vector<shared_ptr<SolidBodyRelationContact>> deferred_contact_list_;
+	vector<shared_ptr<solid_dynamics::ContactDensitySummation>> deferred_contact_density_list_;
+	vector<shared_ptr<solid_dynamics::ContactForce>> deferred_contact_force_list_;
 
 	// for initializeATimeStep
 	vector<shared_ptr<TimeStepInitialization>> initialize_gravity_;
@@ -245,6 +257,8 @@ protected:
 	void initializeElasticSolidBodies();
 	void initializeContactBetweenTwoBodies(int first, int second);
 	void initializeAllContacts();
+	Real contactAABBInflation(int first, int second);
+	void updateDeferredContacts();
 
 	// for initializeBoundaryConditions
 	void initializeGravity();
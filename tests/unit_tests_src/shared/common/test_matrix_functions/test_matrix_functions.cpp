@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "small_matrix_functions.h"
+
+#include <cmath>
+
+using namespace SPH;
+
+namespace
+{
+	const Real tolerance = 1.0e-9;
+
+	void expectNearIdentity(const Mat2d &matrix)
+	{
+		for (int i = 0; i != 2; ++i)
+			for (int j = 0; j != 2; ++j)
+				EXPECT_NEAR(i == j ? 1.0 : 0.0, matrix[i][j], tolerance);
+	}
+
+	void expectNearIdentity(const Mat3d &matrix)
+	{
+		for (int i = 0; i != 3; ++i)
+			for (int j = 0; j != 3; ++j)
+				EXPECT_NEAR(i == j ? 1.0 : 0.0, matrix[i][j], tolerance);
+	}
+}
+
+TEST(small_matrix_functions, fastInverse2d)
+{
+	Mat2d matrix(0.0);
+	matrix[0][0] = 2.0;
+	matrix[0][1] = 1.0;
+	matrix[1][0] = -1.0;
+	matrix[1][1] = 3.0;
+
+	expectNearIdentity(fastMatrixProduct(matrix, fastInverse(matrix)));
+	expectNearIdentity(fastMatrixProduct(fastInverse(matrix), matrix));
+}
+
+TEST(small_matrix_functions, fastInverse3d)
+{
+	Mat3d matrix(0.0);
+	matrix[0][0] = 2.0;
+	matrix[0][1] = -1.0;
+	matrix[0][2] = 0.5;
+	matrix[1][0] = 1.0;
+	matrix[1][1] = 3.0;
+	matrix[1][2] = -0.25;
+	matrix[2][0] = -0.5;
+	matrix[2][1] = 0.75;
+	matrix[2][2] = 1.5;
+
+	expectNearIdentity(fastMatrixProduct(matrix, fastInverse(matrix)));
+	expectNearIdentity(fastMatrixProduct(fastInverse(matrix), matrix));
+}
+
+TEST(small_matrix_functions, fastPolarRotation2d)
+{
+	/** the rotation factor of F = R U is recovered from the composition
+	 * of a known rotation with a symmetric positive definite stretch. */
+	Real angle = 0.3;
+	Mat2d rotation(0.0);
+	rotation[0][0] = std::cos(angle);
+	rotation[0][1] = -std::sin(angle);
+	rotation[1][0] = std::sin(angle);
+	rotation[1][1] = std::cos(angle);
+
+	Mat2d stretch(0.0);
+	stretch[0][0] = 2.0;
+	stretch[0][1] = 0.3;
+	stretch[1][0] = 0.3;
+	stretch[1][1] = 1.2;
+
+	Mat2d recovered_rotation = fastPolarRotation(fastMatrixProduct(rotation, stretch));
+	expectNearIdentity(fastMatrixProduct(~recovered_rotation, recovered_rotation));
+	for (int i = 0; i != 2; ++i)
+		for (int j = 0; j != 2; ++j)
+			EXPECT_NEAR(rotation[i][j], recovered_rotation[i][j], tolerance);
+}
+
+TEST(small_matrix_functions, fastPolarRotation3d)
+{
+	Real angle = 0.4;
+	Mat3d rotation(0.0);
+	rotation[0][0] = std::cos(angle);
+	rotation[0][1] = -std::sin(angle);
+	rotation[1][0] = std::sin(angle);
+	rotation[1][1] = std::cos(angle);
+	rotation[2][2] = 1.0;
+
+	Mat3d stretch(0.0);
+	stretch[0][0] = 1.5;
+	stretch[0][1] = 0.2;
+	stretch[1][0] = 0.2;
+	stretch[1][1] = 1.1;
+	stretch[1][2] = 0.1;
+	stretch[2][1] = 0.1;
+	stretch[2][2] = 0.9;
+
+	Mat3d recovered_rotation = fastPolarRotation(fastMatrixProduct(rotation, stretch));
+	expectNearIdentity(fastMatrixProduct(~recovered_rotation, recovered_rotation));
+	for (int i = 0; i != 3; ++i)
+		for (int j = 0; j != 3; ++j)
+			EXPECT_NEAR(rotation[i][j], recovered_rotation[i][j], tolerance);
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "buffer_compression.h"
+
+#include <random>
+
+using namespace SPH;
+
+TEST(buffer_compression, roundTripRepetitiveBuffer)
+{
+	std::string raw_buffer;
+	for (size_t i = 0; i != 10000; ++i)
+		raw_buffer += "particle data block ";
+
+	std::string compressed_buffer = buffer_compression::compress(raw_buffer, 5);
+	EXPECT_TRUE(buffer_compression::isCompressed(compressed_buffer));
+	EXPECT_LT(compressed_buffer.size(), raw_buffer.size());
+	EXPECT_EQ(raw_buffer, buffer_compression::decompress(compressed_buffer));
+}
+
+TEST(buffer_compression, roundTripIncompressibleBuffer)
+{
+	/** pseudo-random bytes do not shrink, so the chunks are stored verbatim
+	 * and the container must still restore them exactly. */
+	std::minstd_rand random_engine(42);
+	std::string raw_buffer(64 * 1024, '\0');
+	for (size_t i = 0; i != raw_buffer.size(); ++i)
+		raw_buffer[i] = char(random_engine() & 0xff);
+
+	std::string compressed_buffer = buffer_compression::compress(raw_buffer, 5);
+	EXPECT_TRUE(buffer_compression::isCompressed(compressed_buffer));
+	EXPECT_EQ(raw_buffer, buffer_compression::decompress(compressed_buffer));
+}
+
+TEST(buffer_compression, roundTripMultiChunkBuffer)
+{
+	/** larger than two 1 MiB chunks with an odd remainder,
+	 * so the per-chunk framing is exercised. */
+	std::minstd_rand random_engine(7);
+	std::string raw_buffer;
+	raw_buffer.reserve((2 << 20) + 12345);
+	while (raw_buffer.size() < (2 << 20) + 12345)
+	{
+		char filler = char('a' + random_engine() % 4);
+		raw_buffer.append(100, filler);
+	}
+	raw_buffer.resize((2 << 20) + 12345);
+
+	std::string compressed_buffer = buffer_compression::compress(raw_buffer, 9);
+	EXPECT_LT(compressed_buffer.size(), raw_buffer.size());
+	EXPECT_EQ(raw_buffer, buffer_compression::decompress(compressed_buffer));
+}
+
+TEST(buffer_compression, roundTripShortAndEmptyBuffers)
+{
+	std::string short_buffer = "tiny";
+	std::string compressed_short = buffer_compression::compress(short_buffer, 5);
+	EXPECT_TRUE(buffer_compression::isCompressed(compressed_short));
+	EXPECT_EQ(short_buffer, buffer_compression::decompress(compressed_short));
+
+	std::string empty_buffer;
+	std::string compressed_empty = buffer_compression::compress(empty_buffer, 5);
+	EXPECT_TRUE(buffer_compression::isCompressed(compressed_empty));
+	EXPECT_EQ(empty_buffer, buffer_compression::decompress(compressed_empty));
+}
+
+TEST(buffer_compression, isCompressedRejectsPlainBuffers)
+{
+	EXPECT_FALSE(buffer_compression::isCompressed(""));
+	EXPECT_FALSE(buffer_compression::isCompressed("<?xml version=\"1.0\"?>"));
+	EXPECT_FALSE(buffer_compression::isCompressed(std::string(64, '\0')));
+}
+
+TEST(buffer_compressionDeathTest, decompressRejectsPlainBuffer)
+{
+	EXPECT_EXIT(buffer_compression::decompress("this is not a compressed container"),
+				::testing::ExitedWithCode(1), "");
+}
+
+TEST(buffer_compressionDeathTest, decompressRejectsTruncatedContainer)
+{
+	std::string raw_buffer(4096, 'x');
+	std::string compressed_buffer = buffer_compression::compress(raw_buffer, 5);
+	std::string truncated_buffer = compressed_buffer.substr(0, compressed_buffer.size() - 10);
+	EXPECT_EXIT(buffer_compression::decompress(truncated_buffer),
+				::testing::ExitedWithCode(1), "");
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "neighbor_relation.h"
+
+using namespace SPH;
+
+namespace
+{
+	/** append one neighbor entry with deterministic values derived from (i, n). */
+	void addNeighborEntry(Neighborhood &neighborhood, size_t index_i, size_t n)
+	{
+		neighborhood.j_.push_back(10 * index_i + n);
+		neighborhood.W_ij_.push_back(Real(index_i) + 0.1 * Real(n));
+		neighborhood.dW_ij_.push_back(-Real(index_i) - 0.01 * Real(n));
+		neighborhood.r_ij_.push_back(0.5 * Real(n + 1));
+		neighborhood.e_ij_.push_back(Vecd(Real(index_i), Real(n), 1.0));
+		neighborhood.dW_ij_e_ij_.push_back(Vecd(Real(index_i), -Real(n), 2.0));
+		neighborhood.current_size_++;
+	}
+
+	ParticleConfiguration buildConfiguration(const StdVec<size_t> &neighbor_counts)
+	{
+		ParticleConfiguration particle_configuration(neighbor_counts.size());
+		for (size_t index_i = 0; index_i != neighbor_counts.size(); ++index_i)
+			for (size_t n = 0; n != neighbor_counts[index_i]; ++n)
+				addNeighborEntry(particle_configuration[index_i], index_i, n);
+		return particle_configuration;
+	}
+}
+
+TEST(CompactNeighborList, packConfigurationCompressedSparseRow)
+{
+	ParticleConfiguration particle_configuration = buildConfiguration({2, 0, 3});
+	CompactNeighborList compact_neighbor_list;
+	compact_neighbor_list.packKernelGradient();
+	CompactParticleConfiguration compact_configuration;
+	compact_neighbor_list.packConfiguration(particle_configuration, 3, compact_configuration);
+
+	EXPECT_EQ(0, compact_neighbor_list.FixedStride());
+	ASSERT_EQ(4, compact_neighbor_list.offsets_.size());
+	EXPECT_EQ(0, compact_neighbor_list.offsets_[0]);
+	EXPECT_EQ(2, compact_neighbor_list.offsets_[1]);
+	EXPECT_EQ(2, compact_neighbor_list.offsets_[2]);
+	EXPECT_EQ(5, compact_neighbor_list.offsets_[3]);
+	ASSERT_EQ(5, compact_neighbor_list.j_.size());
+
+	for (size_t index_i = 0; index_i != 3; ++index_i)
+	{
+		const Neighborhood &neighborhood = particle_configuration[index_i];
+		const CompactNeighborhood &compact_neighborhood = compact_configuration[index_i];
+		ASSERT_EQ(neighborhood.current_size_, compact_neighborhood.current_size_);
+		for (size_t n = 0; n != neighborhood.current_size_; ++n)
+		{
+			EXPECT_EQ(neighborhood.j_[n], compact_neighborhood.j_[n]);
+			EXPECT_EQ(neighborhood.W_ij_[n], compact_neighborhood.W_ij_[n]);
+			EXPECT_EQ(neighborhood.dW_ij_[n], compact_neighborhood.dW_ij_[n]);
+			EXPECT_EQ(neighborhood.r_ij_[n], compact_neighborhood.r_ij_[n]);
+			EXPECT_EQ(neighborhood.e_ij_[n], compact_neighborhood.e_ij_[n]);
+			EXPECT_EQ(neighborhood.dW_ij_e_ij_[n], compact_neighborhood.dW_ij_e_ij_[n]);
+		}
+	}
+}
+
+TEST(CompactNeighborList, packConfigurationFixedStride)
+{
+	/** 7 and 8 neighbors pad to the common stride 8 with a padded
+	 * fraction of 1/16, well below the default limit. */
+	ParticleConfiguration particle_configuration = buildConfiguration({7, 8});
+	CompactNeighborList compact_neighbor_list;
+	compact_neighbor_list.useFixedStride();
+	CompactParticleConfiguration compact_configuration;
+	compact_neighbor_list.packConfiguration(particle_configuration, 2, compact_configuration);
+
+	EXPECT_EQ(8, compact_neighbor_list.FixedStride());
+	ASSERT_EQ(16, compact_neighbor_list.j_.size());
+
+	for (size_t index_i = 0; index_i != 2; ++index_i)
+	{
+		const Neighborhood &neighborhood = particle_configuration[index_i];
+		const CompactNeighborhood &compact_neighborhood = compact_configuration[index_i];
+		ASSERT_EQ(8, compact_neighborhood.current_size_);
+		for (size_t n = 0; n != neighborhood.current_size_; ++n)
+		{
+			EXPECT_EQ(neighborhood.j_[n], compact_neighborhood.j_[n]);
+			EXPECT_EQ(neighborhood.W_ij_[n], compact_neighborhood.W_ij_[n]);
+			EXPECT_EQ(neighborhood.dW_ij_[n], compact_neighborhood.dW_ij_[n]);
+		}
+		/** the padding entries are zero-weight self pairs with a unit distance. */
+		for (size_t n = neighborhood.current_size_; n != 8; ++n)
+		{
+			EXPECT_EQ(index_i, compact_neighborhood.j_[n]);
+			EXPECT_EQ(0.0, compact_neighborhood.W_ij_[n]);
+			EXPECT_EQ(0.0, compact_neighborhood.dW_ij_[n]);
+			EXPECT_EQ(1.0, compact_neighborhood.r_ij_[n]);
+			EXPECT_EQ(Vecd(0), compact_neighborhood.e_ij_[n]);
+		}
+	}
+}
+
+TEST(CompactNeighborList, fixedStrideFallsBackOnPaddingWaste)
+{
+	/** 1 and 8 neighbors would pad 7 of 16 entries, beyond the limit,
+	 * so the packing falls back to the compressed-sparse-row layout. */
+	ParticleConfiguration particle_configuration = buildConfiguration({1, 8});
+	CompactNeighborList compact_neighbor_list;
+	compact_neighbor_list.useFixedStride(0.2);
+	CompactParticleConfiguration compact_configuration;
+	compact_neighbor_list.packConfiguration(particle_configuration, 2, compact_configuration);
+
+	EXPECT_EQ(0, compact_neighbor_list.FixedStride());
+	ASSERT_EQ(9, compact_neighbor_list.j_.size());
+	EXPECT_EQ(1, compact_configuration[0].current_size_);
+	EXPECT_EQ(8, compact_configuration[1].current_size_);
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "sphinxsys.h"
+
+using namespace SPH;
+
+/** sort a small fluid particle set through the default radix-sort path
+ * and check that the keys, the sortable data and the id bookkeeping
+ * are permuted consistently. */
+TEST(ParticleSorting, sortingParticleDataDefaultPath)
+{
+	Real resolution_ref = 0.25;
+	BoundingBox system_domain_bounds(Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 1.0, 1.0));
+	SPHSystem system(system_domain_bounds, resolution_ref);
+
+	Vec3d halfsize_water(0.5, 0.5, 0.5);
+	SimTK::Transform translation_water(halfsize_water);
+	FluidBody water_block(system,
+						  makeShared<TransformShape<GeometricShapeBox>>(translation_water, halfsize_water, "WaterBody"));
+	water_block.defineParticlesAndMaterial<FluidParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+	water_block.generateParticles<ParticleGeneratorLattice>();
+
+	BaseParticles &particles = *water_block.base_particles_;
+	size_t total_real_particles = particles.total_real_particles_;
+	ASSERT_GT(total_real_particles, 1);
+
+	StdLargeVec<Vecd> unsorted_pos = particles.pos_n_;
+	/** assign the keys in reversed order so that every particle moves. */
+	for (size_t i = 0; i != total_real_particles; ++i)
+		particles.sequence_[i] = total_real_particles - 1 - i;
+
+	water_block.particle_sorting_.sortingParticleData(particles.sequence_.data(), total_real_particles);
+
+	for (size_t i = 0; i != total_real_particles; ++i)
+	{
+		EXPECT_EQ(i, particles.sequence_[i]);
+		EXPECT_EQ(total_real_particles - 1 - i, particles.unsorted_id_[i]);
+		EXPECT_EQ(i, particles.sorted_id_[particles.unsorted_id_[i]]);
+		EXPECT_EQ(unsorted_pos[particles.unsorted_id_[i]], particles.pos_n_[i]);
+	}
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}